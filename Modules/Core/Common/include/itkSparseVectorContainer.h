@@ -0,0 +1,473 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSparseVectorContainer_h
+#define itkSparseVectorContainer_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <iterator>
+#include <vector>
+
+namespace itk
+{
+/** \class SparseVectorContainer
+ * \brief A container indexed by integers whose elements are stored
+ * contiguously, and may be deleted.
+ *
+ * SparseVectorContainer has the semantics of MapContainer: an identifier
+ * exists only after an element was set at it, DeleteIndex() removes it,
+ * Size() is the number of existing elements, and the iterators visit the
+ * existing elements only, in increasing order of their identifiers. The
+ * elements are however stored in a std::vector indexed by their identifiers,
+ * along with a flag telling which identifiers exist, so that accessing an
+ * element neither searches a tree nor follows pointers, and inserting an
+ * element does not allocate memory once the vector is large enough.
+ *
+ * The identifiers should be dense: the memory used grows with the largest
+ * identifier, not with the number of elements. The slots of the deleted
+ * elements are kept until an element is set at the same identifier again,
+ * except at the end of the vector, which always holds an existing element,
+ * so that the last element is found in constant time.
+ *
+ * \tparam TElementIdentifier An unsigned integral type used to index the
+ * container.
+ *
+ * \tparam TElement The element type stored in the container.
+ *
+ * \sa MapContainer
+ * \sa VectorContainer
+ * \ingroup DataRepresentation
+ * \ingroup ITKCommon
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT SparseVectorContainer : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SparseVectorContainer);
+
+  /** Standard class type aliases. */
+  using Self = SparseVectorContainer;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Standard part of every itk Object. */
+  itkTypeMacro(SparseVectorContainer, Object);
+
+  /** Save the template parameters. */
+  using ElementIdentifier = TElementIdentifier;
+  using Element = TElement;
+
+  /** Declare iterators to container. */
+  class Iterator;
+  class ConstIterator;
+  friend class Iterator;
+  friend class ConstIterator;
+
+  /** \class Iterator
+   * \brief The non-const iterator type for the container.
+   * \ingroup ITKCommon
+   */
+  class Iterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Element;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Element *;
+    using reference = Element &;
+
+    Iterator() = default;
+    Iterator(Self * container, ElementIdentifier id)
+      : m_Container(container)
+      , m_Id(id)
+    {}
+
+    Iterator & operator*() { return *this; }
+    Iterator * operator->() { return this; }
+    Iterator &
+    operator++()
+    {
+      m_Id = m_Container->NextIndex(m_Id);
+      return *this;
+    }
+    Iterator
+    operator++(int)
+    {
+      Iterator temp(*this);
+      ++(*this);
+      return temp;
+    }
+    Iterator &
+    operator--()
+    {
+      m_Id = m_Container->PreviousIndex(m_Id);
+      return *this;
+    }
+    Iterator
+    operator--(int)
+    {
+      Iterator temp(*this);
+      --(*this);
+      return temp;
+    }
+
+    bool
+    operator==(const Iterator & r) const
+    {
+      return m_Id == r.m_Id;
+    }
+    bool
+    operator!=(const Iterator & r) const
+    {
+      return m_Id != r.m_Id;
+    }
+    bool
+    operator==(const ConstIterator & r) const
+    {
+      return m_Id == r.m_Id;
+    }
+    bool
+    operator!=(const ConstIterator & r) const
+    {
+      return m_Id != r.m_Id;
+    }
+
+    /** Get the index into the SparseVectorContainer associated with this iterator.   */
+    ElementIdentifier
+    Index() const
+    {
+      return m_Id;
+    }
+
+    /** Get the value at this iterator's location in the SparseVectorContainer.   */
+    Element &
+    Value()
+    {
+      return m_Container->m_Elements[m_Id];
+    }
+
+  private:
+    Self *            m_Container{ nullptr };
+    ElementIdentifier m_Id{};
+    friend class ConstIterator;
+  };
+
+  /** \class ConstIterator
+   * \brief The const iterator type for the container.
+   * \ingroup ITKCommon
+   */
+  class ConstIterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Element;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Element *;
+    using reference = const Element &;
+
+    ConstIterator() = default;
+    ConstIterator(const Self * container, ElementIdentifier id)
+      : m_Container(container)
+      , m_Id(id)
+    {}
+    ConstIterator(const Iterator & r)
+      : m_Container(r.m_Container)
+      , m_Id(r.m_Id)
+    {}
+
+    ConstIterator & operator*() { return *this; }
+    ConstIterator * operator->() { return this; }
+    ConstIterator &
+    operator++()
+    {
+      m_Id = m_Container->NextIndex(m_Id);
+      return *this;
+    }
+    ConstIterator
+    operator++(int)
+    {
+      ConstIterator temp(*this);
+      ++(*this);
+      return temp;
+    }
+    ConstIterator &
+    operator--()
+    {
+      m_Id = m_Container->PreviousIndex(m_Id);
+      return *this;
+    }
+    ConstIterator
+    operator--(int)
+    {
+      ConstIterator temp(*this);
+      --(*this);
+      return temp;
+    }
+
+    bool
+    operator==(const Iterator & r) const
+    {
+      return m_Id == r.m_Id;
+    }
+    bool
+    operator!=(const Iterator & r) const
+    {
+      return m_Id != r.m_Id;
+    }
+    bool
+    operator==(const ConstIterator & r) const
+    {
+      return m_Id == r.m_Id;
+    }
+    bool
+    operator!=(const ConstIterator & r) const
+    {
+      return m_Id != r.m_Id;
+    }
+
+    /** Get the index into the SparseVectorContainer associated with this iterator.   */
+    ElementIdentifier
+    Index() const
+    {
+      return m_Id;
+    }
+
+    /** Get the value at this iterator's location in the SparseVectorContainer.   */
+    const Element &
+    Value() const
+    {
+      return m_Container->m_Elements[m_Id];
+    }
+
+  private:
+    const Self *      m_Container{ nullptr };
+    ElementIdentifier m_Id{};
+    friend class Iterator;
+  };
+
+  /* Declare the public interface routines. */
+
+  /**
+   * Get a reference to the element at the given index.
+   * If the index does not exist, it is created automatically.
+   *
+   * It is assumed that the value of the element is modified through the
+   * reference.
+   */
+  Element & ElementAt(ElementIdentifier);
+
+  /**
+   * Get a reference to the element at the given index.
+   * There is no check for existence performed.
+   */
+  const Element & ElementAt(ElementIdentifier) const;
+
+  /**
+   * Get a reference to the element at the given index.
+   * If the index does not exist, it is created automatically.
+   *
+   * It is assumed that the value of the element is modified through the
+   * reference.
+   */
+  Element & CreateElementAt(ElementIdentifier);
+
+  /**
+   * Get the element at the specified index.  There is no check for
+   * existence performed.
+   */
+  Element GetElement(ElementIdentifier) const;
+
+  /**
+   * Set the given index value to the given element.  If the index doesn't
+   * exist, it is automatically created.
+   */
+  void SetElement(ElementIdentifier, Element);
+
+  /**
+   * Set the given index value to the given element.  If the index doesn't
+   * exist, it is automatically created.
+   */
+  void InsertElement(ElementIdentifier, Element);
+
+  /**
+   * Check if an element exists at the given index.
+   */
+  bool
+  IndexExists(ElementIdentifier id) const
+  {
+    return id < m_Exists.size() && m_Exists[id];
+  }
+
+  /**
+   * If the given index doesn't exist in the container, return false.
+   * Otherwise, set the element through the pointer (if it isn't null), and
+   * return true.
+   */
+  bool
+  GetElementIfIndexExists(ElementIdentifier, Element *) const;
+
+  /**
+   * Create an entry for a given index, whether or not it exists, and assign
+   * it the default element.
+   */
+  void CreateIndex(ElementIdentifier);
+
+  /**
+   * Delete the entry corresponding to the given identifier.
+   * If the entry does not exist, nothing happens.
+   */
+  void DeleteIndex(ElementIdentifier);
+
+  /**
+   * Get a begin const iterator for the container.
+   */
+  ConstIterator
+  Begin() const
+  {
+    return ConstIterator(this, m_FirstIndex);
+  }
+
+  /**
+   * Get an end const iterator for the container.
+   */
+  ConstIterator
+  End() const
+  {
+    return ConstIterator(this, static_cast<ElementIdentifier>(m_Elements.size()));
+  }
+
+  /**
+   * Get a begin iterator for the container.
+   */
+  Iterator
+  Begin()
+  {
+    return Iterator(this, m_FirstIndex);
+  }
+
+  /**
+   * Get an end iterator for the container.
+   */
+  Iterator
+  End()
+  {
+    return Iterator(this, static_cast<ElementIdentifier>(m_Elements.size()));
+  }
+
+  /**
+   * Get the number of elements currently stored in the container.
+   */
+  ElementIdentifier
+  Size() const
+  {
+    return m_NumberOfElements;
+  }
+
+  /**
+   * Create the elements which don't exist among the identifiers lower than
+   * the size given, as VectorContainer does, and as MapContainer does when
+   * its identifiers are consecutive.
+   */
+  void Reserve(ElementIdentifier);
+
+  /**
+   * Tell the container to try to minimize its memory usage for storage of
+   * the current number of elements.  This is NOT guaranteed to decrease
+   * memory usage.
+   */
+  void
+  Squeeze();
+
+  /**
+   * Tell the container to release any memory it may have allocated and
+   * return itself to its initial state.
+   */
+  void
+  Initialize();
+
+  /** STL-like names of Size() and Initialize(), for the code written for
+   * MapContainer which uses them. */
+  size_t
+  size() const
+  {
+    return m_NumberOfElements;
+  }
+
+  bool
+  empty() const
+  {
+    return m_NumberOfElements == 0;
+  }
+
+  void
+  clear()
+  {
+    this->Initialize();
+  }
+
+protected:
+  SparseVectorContainer() = default;
+  ~SparseVectorContainer() override = default;
+
+private:
+  /** Return the identifier of the next existing element after id, or the end. */
+  ElementIdentifier
+  NextIndex(ElementIdentifier id) const
+  {
+    const auto end = static_cast<ElementIdentifier>(m_Exists.size());
+    do
+    {
+      ++id;
+    } while (id < end && !m_Exists[id]);
+    return id;
+  }
+
+  /** Return the identifier of the previous existing element before id. */
+  ElementIdentifier
+  PreviousIndex(ElementIdentifier id) const
+  {
+    do
+    {
+      --id;
+    } while (!m_Exists[id]);
+    return id;
+  }
+
+  /** Make the element at id exist, without changing its value when it did. */
+  Element &
+  CreateSlot(ElementIdentifier id);
+
+  std::vector<Element> m_Elements;
+  std::vector<bool>    m_Exists;
+  ElementIdentifier    m_NumberOfElements{ 0 };
+
+  /** The identifier of the first existing element, or 0 when there is none. */
+  ElementIdentifier m_FirstIndex{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSparseVectorContainer.hxx"
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSparseVectorContainer_hxx
+#define itkSparseVectorContainer_hxx
+
+#include "itkSparseVectorContainer.h"
+
+namespace itk
+{
+template <typename TElementIdentifier, typename TElement>
+typename SparseVectorContainer<TElementIdentifier, TElement>::Element &
+SparseVectorContainer<TElementIdentifier, TElement>::CreateSlot(ElementIdentifier id)
+{
+  if (id >= m_Elements.size())
+  {
+    m_Elements.resize(id + 1);
+    m_Exists.resize(id + 1, false);
+  }
+  if (!m_Exists[id])
+  {
+    m_FirstIndex = (m_NumberOfElements == 0 || id < m_FirstIndex) ? id : m_FirstIndex;
+    m_Exists[id] = true;
+    ++m_NumberOfElements;
+  }
+  return m_Elements[id];
+}
+
+template <typename TElementIdentifier, typename TElement>
+typename SparseVectorContainer<TElementIdentifier, TElement>::Element &
+SparseVectorContainer<TElementIdentifier, TElement>::ElementAt(ElementIdentifier id)
+{
+  this->Modified();
+  return this->CreateSlot(id);
+}
+
+template <typename TElementIdentifier, typename TElement>
+const typename SparseVectorContainer<TElementIdentifier, TElement>::Element &
+SparseVectorContainer<TElementIdentifier, TElement>::ElementAt(ElementIdentifier id) const
+{
+  return m_Elements[id];
+}
+
+template <typename TElementIdentifier, typename TElement>
+typename SparseVectorContainer<TElementIdentifier, TElement>::Element &
+SparseVectorContainer<TElementIdentifier, TElement>::CreateElementAt(ElementIdentifier id)
+{
+  this->Modified();
+  return this->CreateSlot(id);
+}
+
+template <typename TElementIdentifier, typename TElement>
+typename SparseVectorContainer<TElementIdentifier, TElement>::Element
+SparseVectorContainer<TElementIdentifier, TElement>::GetElement(ElementIdentifier id) const
+{
+  return m_Elements[id];
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+SparseVectorContainer<TElementIdentifier, TElement>::SetElement(ElementIdentifier id, Element element)
+{
+  this->CreateSlot(id) = element;
+  this->Modified();
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+SparseVectorContainer<TElementIdentifier, TElement>::InsertElement(ElementIdentifier id, Element element)
+{
+  this->CreateSlot(id) = element;
+  this->Modified();
+}
+
+template <typename TElementIdentifier, typename TElement>
+bool
+SparseVectorContainer<TElementIdentifier, TElement>::GetElementIfIndexExists(ElementIdentifier id,
+                                                                             Element *         element) const
+{
+  if (this->IndexExists(id))
+  {
+    if (element)
+    {
+      *element = m_Elements[id];
+    }
+    return true;
+  }
+  return false;
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+SparseVectorContainer<TElementIdentifier, TElement>::CreateIndex(ElementIdentifier id)
+{
+  this->CreateSlot(id) = Element();
+  this->Modified();
+}
+
+/**
+ * The slot of the element is reset to the default element, so that the
+ * resources the element holds are released. The slots at the end of the
+ * vector which don't hold any element are removed.
+ */
+template <typename TElementIdentifier, typename TElement>
+void
+SparseVectorContainer<TElementIdentifier, TElement>::DeleteIndex(ElementIdentifier id)
+{
+  if (this->IndexExists(id))
+  {
+    m_Elements[id] = Element();
+    m_Exists[id] = false;
+    --m_NumberOfElements;
+
+    if (m_NumberOfElements == 0)
+    {
+      m_Elements.clear();
+      m_Exists.clear();
+      m_FirstIndex = 0;
+    }
+    else
+    {
+      auto newSize = static_cast<ElementIdentifier>(m_Exists.size());
+      while (!m_Exists[newSize - 1])
+      {
+        --newSize;
+      }
+      m_Elements.resize(newSize);
+      m_Exists.resize(newSize);
+      if (id == m_FirstIndex)
+      {
+        m_FirstIndex = this->NextIndex(id);
+      }
+    }
+  }
+  this->Modified();
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+SparseVectorContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier sz)
+{
+  for (ElementIdentifier id = 0; id < sz; ++id)
+  {
+    this->CreateSlot(id);
+  }
+  this->Modified();
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+SparseVectorContainer<TElementIdentifier, TElement>::Squeeze()
+{
+  m_Elements.shrink_to_fit();
+  m_Exists.shrink_to_fit();
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+SparseVectorContainer<TElementIdentifier, TElement>::Initialize()
+{
+  m_Elements.clear();
+  m_Exists.clear();
+  m_NumberOfElements = 0;
+  m_FirstIndex = 0;
+}
+} // end namespace itk
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkImageRegionSplitterBase.h"
+#include <vector>
 
 namespace itk
 {
@@ -86,6 +87,13 @@ public:
    * will be executed this many times. */
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Get the time, in seconds, spent updating the upstream pipeline for
+   * each piece during the last update. It includes the reading and the
+   * processing of the upstream filters; the time a reader which reads
+   * ahead still waits for its reads is reported by the reader, for
+   * instance by ImageFileReader::GetPrefetchWaitTime(). */
+  itkGetConstReferenceMacro(PieceUpdateTimes, std::vector<double>);
+
   /** Get/Set the helper class for dividing the input into chunks. */
   itkSetObjectMacro(RegionSplitter, SplitterType);
   itkGetModifiableObjectMacro(RegionSplitter, SplitterType);
@@ -121,6 +129,7 @@ protected:
 private:
   unsigned int          m_NumberOfStreamDivisions;
   RegionSplitterPointer m_RegionSplitter;
+  std::vector<double>   m_PieceUpdateTimes;
 };
 } // end namespace itk
 
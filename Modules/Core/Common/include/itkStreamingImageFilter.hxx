@@ -21,6 +21,7 @@
 #include "itkCommand.h"
 #include "itkImageAlgorithm.h"
 #include "itkImageRegionSplitterSlowDimension.h"
+#include <chrono>
 
 namespace itk
 {
@@ -166,15 +167,18 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
    * Loop over the number of pieces, execute the upstream pipeline on each
    * piece, and copy the results into the output image.
    */
+  m_PieceUpdateTimes.clear();
   unsigned int piece = 0;
   for (; piece < numDivisions && !this->GetAbortGenerateData(); piece++)
   {
     InputImageRegionType streamRegion = outputRegion;
     m_RegionSplitter->GetSplit(piece, numDivisions, streamRegion);
 
+    const auto start = std::chrono::steady_clock::now();
     inputPtr->SetRequestedRegion(streamRegion);
     inputPtr->PropagateRequestedRegion();
     inputPtr->UpdateOutputData();
+    m_PieceUpdateTimes.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
 
     // copy the result to the proper place in the output. the input
     // requested region determined by the RegionSplitter (as opposed
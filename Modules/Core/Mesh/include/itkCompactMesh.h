@@ -0,0 +1,296 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactMesh_h
+#define itkCompactMesh_h
+
+#include "itkPointSet.h"
+
+#include "itkCellInterface.h"
+#include "itkCommonEnums.h"
+#include "itkLineCell.h"
+#include "itkTetrahedronCell.h"
+#include "itkTriangleCell.h"
+#include "itkVectorContainer.h"
+#include <type_traits>
+
+namespace itk
+{
+/** \class CompactMesh
+ * \brief A mesh whose cells are all simplices of the same type, stored in one index buffer.
+ *
+ * Mesh stores every cell as a separately allocated polymorphic object, so each
+ * triangle of a surface carries a virtual table pointer and its own array of
+ * point identifiers, and iterating over the cells chases one pointer per cell.
+ * CompactMesh only represents meshes made of a single type of simplex, lines,
+ * triangles or tetrahedra depending on VNumberOfCellPoints, and stores the
+ * point identifiers of all its cells in a single contiguous CellIndexContainer:
+ * the identifiers of cell i are the NumberOfCellPoints elements starting at
+ * i * NumberOfCellPoints. The cell identifiers are therefore always 0 to
+ * GetNumberOfCells() - 1.
+ *
+ * The points and the point data are held by the containers of PointSet, as in
+ * Mesh. ImportMesh() and ExportMesh() convert from and to a Mesh sharing these
+ * containers, and the cell data container, when the two meshes have the same
+ * container types. GetCell() and SetCell(CellIdentifier, CellAutoPointer &)
+ * convert single cells for the algorithms written for the cells of Mesh.
+ *
+ * MeshFileReader, MeshFileWriter, TransformMeshFilter, WarpMeshFilter and
+ * TriangleMeshToBinaryImageFilter accept a CompactMesh in place of a Mesh.
+ *
+ * \ingroup MeshObjects
+ * \ingroup ITKMesh
+ */
+template <typename TPixelType,
+          unsigned int VDimension = 3,
+          unsigned int VNumberOfCellPoints = 3,
+          typename TMeshTraits = DefaultStaticMeshTraits<TPixelType, VDimension, VDimension>>
+class ITK_TEMPLATE_EXPORT CompactMesh : public PointSet<TPixelType, VDimension, TMeshTraits>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CompactMesh);
+
+  /** Standard type alias. */
+  using Self = CompactMesh;
+  using Superclass = PointSet<TPixelType, VDimension, TMeshTraits>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using RegionType = typename Superclass::RegionType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Standard part of every itk Object. */
+  itkTypeMacro(CompactMesh, PointSet);
+
+  static_assert(VNumberOfCellPoints >= 2 && VNumberOfCellPoints <= 4,
+                "CompactMesh only supports lines, triangles and tetrahedra");
+
+  /** Hold on to the type information specified by the template parameters. */
+  using MeshTraits = TMeshTraits;
+  using PixelType = typename MeshTraits::PixelType;
+  using CellPixelType = typename MeshTraits::CellPixelType;
+
+  /** Convenient constants obtained from the template parameters. */
+  static constexpr unsigned int PointDimension = TMeshTraits::PointDimension;
+  static constexpr unsigned int NumberOfCellPoints = VNumberOfCellPoints;
+  static constexpr unsigned int MaxTopologicalDimension = VNumberOfCellPoints - 1;
+  static constexpr CellGeometryEnum CellGeometry =
+    VNumberOfCellPoints == 2 ? CellGeometryEnum::LINE_CELL
+                             : (VNumberOfCellPoints == 3 ? CellGeometryEnum::TRIANGLE_CELL
+                                                         : CellGeometryEnum::TETRAHEDRON_CELL);
+
+  /** Convenient type alias obtained from TMeshTraits template parameter. */
+  using CoordRepType = typename MeshTraits::CoordRepType;
+  using PointIdentifier = typename MeshTraits::PointIdentifier;
+  using CellIdentifier = typename MeshTraits::CellIdentifier;
+  using PointType = typename MeshTraits::PointType;
+  using PointsContainer = typename MeshTraits::PointsContainer;
+  using PointDataContainer = typename MeshTraits::PointDataContainer;
+  using CellTraits = typename MeshTraits::CellTraits;
+  using CellDataContainer = typename MeshTraits::CellDataContainer;
+
+  /** The point identifiers of all the cells, NumberOfCellPoints per cell. */
+  using CellIndexContainer = VectorContainer<CellIdentifier, PointIdentifier>;
+
+  /** Create types that are pointers to each of the container types. */
+  using CellIndexContainerPointer = typename CellIndexContainer::Pointer;
+  using CellIndexContainerConstPointer = typename CellIndexContainer::ConstPointer;
+  using CellDataContainerPointer = typename CellDataContainer::Pointer;
+  using CellDataContainerConstPointer = typename CellDataContainer::ConstPointer;
+
+  /** The cell types of Mesh, used to exchange single cells with the
+   * algorithms written for Mesh. */
+  using CellType = CellInterface<CellPixelType, CellTraits>;
+  using CellAutoPointer = typename CellType::CellAutoPointer;
+
+  /** The simplex cell type of Mesh with NumberOfCellPoints points, for a
+   * given cell interface. */
+  template <typename TCellInterface>
+  using SimplexCell = typename std::conditional<
+    VNumberOfCellPoints == 2,
+    LineCell<TCellInterface>,
+    typename std::conditional<VNumberOfCellPoints == 3, TriangleCell<TCellInterface>, TetrahedronCell<TCellInterface>>::
+      type>::type;
+  using SimplexCellType = SimplexCell<CellType>;
+
+  /** Restore the mesh to its initial state. */
+  void
+  Initialize() override;
+
+  /** Get the number of cells in the index buffer. */
+  CellIdentifier
+  GetNumberOfCells() const;
+
+  /** Define Set/Get access routines for the cell containers. */
+  void
+  SetCellIndices(CellIndexContainer *);
+
+  CellIndexContainer *
+  GetCellIndices();
+
+  const CellIndexContainer *
+  GetCellIndices() const;
+
+  void
+  SetCellData(CellDataContainer *);
+
+  CellDataContainer *
+  GetCellData();
+
+  const CellDataContainer *
+  GetCellData() const;
+
+  /** Set the NumberOfCellPoints point identifiers of a cell. The index buffer
+   * grows when cellId is past its last cell. */
+  void
+  SetCell(CellIdentifier cellId, const PointIdentifier * pointIds);
+
+  /** Copy the point identifiers of a cell of Mesh. An exception is thrown
+   * when the cell doesn't have NumberOfCellPoints points. Unlike Mesh, the
+   * mesh does not take the ownership of the cell. */
+  void
+  SetCell(CellIdentifier cellId, CellAutoPointer & cell);
+
+  /** Return the NumberOfCellPoints point identifiers of a cell, or nullptr
+   * when the mesh has no cells. */
+  const PointIdentifier *
+  GetCellPointIds(CellIdentifier cellId) const
+  {
+    if (!m_CellIndexContainer)
+    {
+      return nullptr;
+    }
+    return m_CellIndexContainer->CastToSTLConstContainer().data() + cellId * NumberOfCellPoints;
+  }
+
+  /** Create a SimplexCellType cell holding the point identifiers of a cell.
+   * Return false when there is no such cell. */
+  bool
+  GetCell(CellIdentifier cellId, CellAutoPointer & cell) const;
+
+  /** Access routines to fill the CellData container, and get information
+   * from it. */
+  void SetCellData(CellIdentifier, CellPixelType);
+  bool
+  GetCellData(CellIdentifier, CellPixelType *) const;
+
+  /** Copy a Mesh whose cells all have NumberOfCellPoints points. The points,
+   * the point data and the cell data are shared with mesh when their
+   * containers have the same types as those of this mesh, and copied
+   * otherwise. The cell identifiers of mesh must be 0 to
+   * GetNumberOfCells() - 1. */
+  template <typename TMesh>
+  void
+  ImportMesh(const TMesh * mesh);
+
+  /** Fill a Mesh with SimplexCell cells. The points, the point data and the
+   * cell data are shared with mesh when their containers have the same types
+   * as those of this mesh, and copied otherwise. */
+  template <typename TMesh>
+  void
+  ExportMesh(TMesh * mesh) const;
+
+  void
+  Graft(const DataObject * data) override;
+
+protected:
+  CompactMesh() = default;
+  ~CompactMesh() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Return container itself when it has the type TOutputContainer, and a
+   * copy of it otherwise. */
+  template <typename TOutputContainer>
+  static typename TOutputContainer::Pointer
+  ShareOrCopyContainer(const TOutputContainer * container, std::true_type);
+
+  template <typename TOutputContainer, typename TInputContainer>
+  static typename TOutputContainer::Pointer
+  ShareOrCopyContainer(const TInputContainer * container, std::false_type);
+
+  template <typename TOutputContainer, typename TInputContainer>
+  static typename TOutputContainer::Pointer
+  ShareOrCopyContainer(const TInputContainer * container)
+  {
+    return ShareOrCopyContainer<TOutputContainer>(container, std::is_same<TOutputContainer, TInputContainer>());
+  }
+
+  CellIndexContainerPointer m_CellIndexContainer;
+  CellDataContainerPointer  m_CellDataContainer;
+};
+
+/** \class IsCompactMesh
+ * \brief Tell whether a mesh type is a CompactMesh.
+ *
+ * Used by the algorithms which access the cells of a CompactMesh through its
+ * index buffer instead of the cells container of Mesh.
+ *
+ * \ingroup ITKMesh
+ */
+template <typename TMesh>
+struct IsCompactMesh : std::false_type
+{};
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+struct IsCompactMesh<CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>> : std::true_type
+{};
+
+/** \class CompactMeshNumberOfCellPoints
+ * \brief The number of points of the cells of a CompactMesh, zero for the
+ * other mesh types.
+ *
+ * \ingroup ITKMesh
+ */
+template <typename TMesh>
+struct CompactMeshNumberOfCellPoints : std::integral_constant<unsigned int, 0>
+{};
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+struct CompactMeshNumberOfCellPoints<CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>>
+  : std::integral_constant<unsigned int, VNumberOfCellPoints>
+{};
+
+/** \class MeshCellsContainerTypes
+ * \brief The types of the container of the cells of a mesh: the
+ * CellsContainer of Mesh, or the CellIndexContainer of CompactMesh.
+ *
+ * \ingroup ITKMesh
+ */
+template <typename TMesh, bool VIsCompactMesh = IsCompactMesh<TMesh>::value>
+struct MeshCellsContainerTypes
+{
+  using Pointer = typename TMesh::CellsContainerPointer;
+  using Iterator = typename TMesh::CellsContainerIterator;
+};
+
+template <typename TMesh>
+struct MeshCellsContainerTypes<TMesh, true>
+{
+  using Pointer = typename TMesh::CellIndexContainerPointer;
+  using Iterator = typename TMesh::CellIndexContainer::Iterator;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCompactMesh.hxx"
+#endif
+
+#endif
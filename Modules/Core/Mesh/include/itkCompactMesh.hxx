@@ -0,0 +1,308 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactMesh_hxx
+#define itkCompactMesh_hxx
+
+#include "itkCompactMesh.h"
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::Initialize()
+{
+  Superclass::Initialize();
+
+  m_CellIndexContainer = nullptr;
+  m_CellDataContainer = nullptr;
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+auto
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::GetNumberOfCells() const -> CellIdentifier
+{
+  if (!m_CellIndexContainer)
+  {
+    return 0;
+  }
+  return m_CellIndexContainer->Size() / NumberOfCellPoints;
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::SetCellIndices(
+  CellIndexContainer * cellIndices)
+{
+  itkDebugMacro("setting CellIndices container to " << cellIndices);
+  if (m_CellIndexContainer != cellIndices)
+  {
+    m_CellIndexContainer = cellIndices;
+    this->Modified();
+  }
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+auto
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::GetCellIndices() -> CellIndexContainer *
+{
+  itkDebugMacro("returning CellIndices container of " << m_CellIndexContainer);
+  return m_CellIndexContainer;
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+auto
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::GetCellIndices() const
+  -> const CellIndexContainer *
+{
+  itkDebugMacro("returning CellIndices container of " << m_CellIndexContainer);
+  return m_CellIndexContainer.GetPointer();
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::SetCellData(CellDataContainer * cellData)
+{
+  itkDebugMacro("setting CellData container to " << cellData);
+  if (m_CellDataContainer != cellData)
+  {
+    m_CellDataContainer = cellData;
+    this->Modified();
+  }
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+auto
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::GetCellData() -> CellDataContainer *
+{
+  itkDebugMacro("returning CellData container of " << m_CellDataContainer);
+  return m_CellDataContainer;
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+auto
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::GetCellData() const
+  -> const CellDataContainer *
+{
+  itkDebugMacro("returning CellData container of " << m_CellDataContainer);
+  return m_CellDataContainer.GetPointer();
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::SetCell(CellIdentifier          cellId,
+                                                                               const PointIdentifier * pointIds)
+{
+  if (!m_CellIndexContainer)
+  {
+    this->SetCellIndices(CellIndexContainer::New());
+  }
+
+  std::vector<PointIdentifier> & indices = m_CellIndexContainer->CastToSTLContainer();
+  if (indices.size() < (cellId + 1) * NumberOfCellPoints)
+  {
+    indices.resize((cellId + 1) * NumberOfCellPoints);
+  }
+  std::copy(pointIds, pointIds + NumberOfCellPoints, indices.begin() + cellId * NumberOfCellPoints);
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::SetCell(CellIdentifier    cellId,
+                                                                               CellAutoPointer & cell)
+{
+  if (cell->GetNumberOfPoints() != NumberOfCellPoints)
+  {
+    itkExceptionMacro(<< "Cell " << cellId << " has " << cell->GetNumberOfPoints() << " points instead of "
+                      << NumberOfCellPoints);
+  }
+  this->SetCell(cellId, cell->GetPointIds());
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+bool
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::GetCell(CellIdentifier    cellId,
+                                                                               CellAutoPointer & cell) const
+{
+  if (cellId >= this->GetNumberOfCells())
+  {
+    cell.Reset();
+    return false;
+  }
+
+  auto * simplex = new SimplexCellType;
+  simplex->SetPointIds(this->GetCellPointIds(cellId));
+  cell.TakeOwnership(simplex);
+  return true;
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::SetCellData(CellIdentifier cellId,
+                                                                                   CellPixelType  data)
+{
+  if (!m_CellDataContainer)
+  {
+    this->SetCellData(CellDataContainer::New());
+  }
+  m_CellDataContainer->InsertElement(cellId, data);
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+bool
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::GetCellData(CellIdentifier  cellId,
+                                                                                   CellPixelType * data) const
+{
+  if (!m_CellDataContainer)
+  {
+    return false;
+  }
+  return m_CellDataContainer->GetElementIfIndexExists(cellId, data);
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+template <typename TMesh>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::ImportMesh(const TMesh * mesh)
+{
+  this->Initialize();
+  this->SetPoints(ShareOrCopyContainer<PointsContainer>(mesh->GetPoints()));
+  this->SetPointData(ShareOrCopyContainer<PointDataContainer>(mesh->GetPointData()));
+  this->SetCellData(ShareOrCopyContainer<CellDataContainer>(mesh->GetCellData()));
+
+  const CellIdentifier numberOfCells = mesh->GetNumberOfCells();
+  auto                 cellIndices = CellIndexContainer::New();
+  cellIndices->CastToSTLContainer().resize(numberOfCells * NumberOfCellPoints);
+  if (numberOfCells > 0)
+  {
+    PointIdentifier * indices = cellIndices->CastToSTLContainer().data();
+    for (auto it = mesh->GetCells()->Begin(); it != mesh->GetCells()->End(); ++it)
+    {
+      const auto * cell = it.Value();
+      if (it.Index() >= numberOfCells || cell->GetNumberOfPoints() != NumberOfCellPoints)
+      {
+        itkExceptionMacro(<< "Cell " << it.Index() << " with " << cell->GetNumberOfPoints()
+                          << " points can't be stored in a mesh of " << numberOfCells << " cells with "
+                          << NumberOfCellPoints << " points");
+      }
+      std::copy(cell->PointIdsBegin(), cell->PointIdsEnd(), indices + it.Index() * NumberOfCellPoints);
+    }
+  }
+  this->SetCellIndices(cellIndices);
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+template <typename TMesh>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::ExportMesh(TMesh * mesh) const
+{
+  using OutputCellType = SimplexCell<typename TMesh::CellType>;
+
+  mesh->Initialize();
+  mesh->SetPoints(ShareOrCopyContainer<typename TMesh::PointsContainer>(this->GetPoints()));
+  mesh->SetPointData(ShareOrCopyContainer<typename TMesh::PointDataContainer>(this->GetPointData()));
+  mesh->SetCellData(ShareOrCopyContainer<typename TMesh::CellDataContainer>(this->GetCellData()));
+
+  const CellIdentifier numberOfCells = this->GetNumberOfCells();
+  if (numberOfCells == 0)
+  {
+    return;
+  }
+
+  // The cells container of Mesh holds cells allocated one by one
+  auto cells = TMesh::CellsContainer::New();
+  cells->Reserve(numberOfCells);
+  for (CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    auto *                  cell = new OutputCellType;
+    const PointIdentifier * pointIds = this->GetCellPointIds(cellId);
+    for (unsigned int ii = 0; ii < NumberOfCellPoints; ++ii)
+    {
+      cell->SetPointId(ii, static_cast<typename TMesh::PointIdentifier>(pointIds[ii]));
+    }
+    cells->SetElement(cellId, cell);
+  }
+  mesh->SetCellsAllocationMethod(MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell);
+  mesh->SetCells(cells);
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::Graft(const DataObject * data)
+{
+  this->Superclass::Graft(data);
+
+  const auto * mesh = dynamic_cast<const Self *>(data);
+
+  if (!mesh)
+  {
+    // pointer could not be cast back down
+    itkExceptionMacro(<< "itk::CompactMesh::Graft() cannot cast " << typeid(data).name() << " to "
+                      << typeid(Self *).name());
+  }
+
+  this->SetCellIndices(mesh->m_CellIndexContainer);
+  this->SetCellData(mesh->m_CellDataContainer);
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+void
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::PrintSelf(std::ostream & os,
+                                                                                 Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfCellPoints: " << NumberOfCellPoints << std::endl;
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << std::endl;
+  os << indent << "Cell Index Container: " << m_CellIndexContainer.GetPointer() << std::endl;
+  os << indent << "Cell Data Container: " << m_CellDataContainer.GetPointer() << std::endl;
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+template <typename TOutputContainer>
+auto
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::ShareOrCopyContainer(
+  const TOutputContainer * container,
+  std::true_type) -> typename TOutputContainer::Pointer
+{
+  return const_cast<TOutputContainer *>(container);
+}
+
+template <typename TPixelType, unsigned int VDimension, unsigned int VNumberOfCellPoints, typename TMeshTraits>
+template <typename TOutputContainer, typename TInputContainer>
+auto
+CompactMesh<TPixelType, VDimension, VNumberOfCellPoints, TMeshTraits>::ShareOrCopyContainer(
+  const TInputContainer * container,
+  std::false_type) -> typename TOutputContainer::Pointer
+{
+  if (!container)
+  {
+    return nullptr;
+  }
+
+  auto copy = TOutputContainer::New();
+  for (auto it = container->Begin(); it != container->End(); ++it)
+  {
+    copy->InsertElement(it.Index(), it.Value());
+  }
+  return copy;
+}
+} // end namespace itk
+
+#endif
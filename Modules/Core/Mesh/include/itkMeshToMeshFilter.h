@@ -29,6 +29,7 @@
 #define itkMeshToMeshFilter_h
 
 #include "itkMeshSource.h"
+#include "itkCompactMesh.h"
 
 namespace itk
 {
@@ -97,6 +98,25 @@ protected:
 
   void
   CopyInputMeshToOutputMeshCellData();
+
+  void
+  CopyInputMeshToOutputMeshBoundaryAssignments();
+
+private:
+  /** The cells of a CompactMesh are copied through its index buffer. */
+  void CopyInputMeshToOutputMeshCellLinks(std::false_type);
+  void CopyInputMeshToOutputMeshCellLinks(std::true_type);
+
+  void CopyInputMeshToOutputMeshCells(std::false_type);
+  void CopyInputMeshToOutputMeshCells(std::true_type);
+
+  /** Copy the index buffer of a CompactMesh input with the cell type of the
+   * output, only instantiated for such an input. */
+  void CopyInputMeshToOutputMeshCellIndices(std::false_type);
+  void CopyInputMeshToOutputMeshCellIndices(std::true_type);
+
+  void CopyInputMeshToOutputMeshBoundaryAssignments(std::false_type);
+  void CopyInputMeshToOutputMeshBoundaryAssignments(std::true_type);
 };
 } // end namespace itk
 
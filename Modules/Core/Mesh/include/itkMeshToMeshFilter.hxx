@@ -143,6 +143,13 @@ MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshPointData()
 template <typename TInputMesh, typename TOutputMesh>
 void
 MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellLinks()
+{
+  this->CopyInputMeshToOutputMeshCellLinks(IsCompactMesh<TOutputMesh>());
+}
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellLinks(std::false_type)
 {
   const InputMeshType * inputMesh = this->GetInput();
   OutputMeshPointer     outputMesh = this->GetOutput();
@@ -176,6 +183,13 @@ MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellLinks()
 template <typename TInputMesh, typename TOutputMesh>
 void
 MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCells()
+{
+  this->CopyInputMeshToOutputMeshCells(IsCompactMesh<TOutputMesh>());
+}
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCells(std::false_type)
 {
   const InputMeshType * inputMesh = this->GetInput();
   OutputMeshPointer     outputMesh = this->GetOutput();
@@ -216,6 +230,48 @@ MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCells()
   }
 }
 
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellLinks(std::true_type)
+{
+  // A CompactMesh has no cell links
+}
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCells(std::true_type)
+{
+  constexpr bool sameCells = CompactMeshNumberOfCellPoints<TInputMesh>::value == TOutputMesh::NumberOfCellPoints;
+  static_assert(sameCells, "The cells of a CompactMesh are copied from a CompactMesh with the same cell type");
+
+  this->CopyInputMeshToOutputMeshCellIndices(std::integral_constant<bool, sameCells>());
+}
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellIndices(std::false_type)
+{}
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellIndices(std::true_type)
+{
+  const InputMeshType * inputMesh = this->GetInput();
+  OutputMeshPointer     outputMesh = this->GetOutput();
+
+  using OutputCellIndexContainer = typename TOutputMesh::CellIndexContainer;
+
+  const auto * inputCellIndices = inputMesh->GetCellIndices();
+
+  if (inputCellIndices)
+  {
+    typename OutputCellIndexContainer::Pointer outputCellIndices = OutputCellIndexContainer::New();
+    outputCellIndices->CastToSTLContainer().assign(inputCellIndices->CastToSTLConstContainer().begin(),
+                                                   inputCellIndices->CastToSTLConstContainer().end());
+    outputMesh->SetCellIndices(outputCellIndices);
+  }
+}
+
 template <typename TInputMesh, typename TOutputMesh>
 void
 MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellData()
@@ -248,6 +304,35 @@ MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellData()
     outputMesh->SetCellData(outputCellData);
   }
 }
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshBoundaryAssignments()
+{
+  this->CopyInputMeshToOutputMeshBoundaryAssignments(IsCompactMesh<TOutputMesh>());
+}
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshBoundaryAssignments(std::false_type)
+{
+  const InputMeshType * inputMesh = this->GetInput();
+  OutputMeshPointer     outputMesh = this->GetOutput();
+
+  unsigned int maxDimension = TInputMesh::MaxTopologicalDimension;
+
+  for (unsigned int dim = 0; dim < maxDimension; dim++)
+  {
+    outputMesh->SetBoundaryAssignments(dim, inputMesh->GetBoundaryAssignments(dim));
+  }
+}
+
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshBoundaryAssignments(std::true_type)
+{
+  // A CompactMesh has no boundary assignments
+}
 } // end namespace itk
 
 #endif
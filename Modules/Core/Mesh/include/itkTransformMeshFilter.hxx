@@ -107,12 +107,7 @@ TransformMeshFilter<TInputMesh, TOutputMesh, TTransform>::GenerateData()
   // FIXME: DELETEME outputMesh->SetCells(  inputMesh->GetCells() );
   // FIXME: DELETEME outputMesh->SetCellData(  inputMesh->GetCellData() );
 
-  unsigned int maxDimension = TInputMesh::MaxTopologicalDimension;
-
-  for (unsigned int dim = 0; dim < maxDimension; dim++)
-  {
-    outputMesh->SetBoundaryAssignments(dim, inputMesh->GetBoundaryAssignments(dim));
-  }
+  this->CopyInputMeshToOutputMeshBoundaryAssignments();
 }
 } // end namespace itk
 
@@ -24,6 +24,7 @@
 #include "itkMapContainer.h"
 #include "itkVectorContainer.h"
 #include "itkAutomaticTopologyMeshSource.h"
+#include "itkCompactMesh.h"
 #include "itkPointSet.h"
 
 #include <vector>
@@ -105,8 +106,8 @@ public:
   using InputPixelType = typename InputMeshType::PixelType;
   using InputCellTraitsType = typename InputMeshType::MeshTraits::CellTraits;
   using CellType = typename InputMeshType::CellType;
-  using CellsContainerPointer = typename InputMeshType::CellsContainerPointer;
-  using CellsContainerIterator = typename InputMeshType::CellsContainerIterator;
+  using CellsContainerPointer = typename MeshCellsContainerTypes<InputMeshType>::Pointer;
+  using CellsContainerIterator = typename MeshCellsContainerTypes<InputMeshType>::Iterator;
 
   using InputPointsContainer = typename InputMeshType::PointsContainer;
   using InputPointsContainerPointer = typename InputPointsContainer::Pointer;
@@ -256,6 +257,14 @@ private:
 
   static bool
   ComparePoints1D(Point1D a, Point1D b);
+
+  /** Add the polygons of the cells of the input, whose points are in index
+   * coordinates in pointSet, to zymatrix. The triangles of a CompactMesh are
+   * read from its index buffer. */
+  void
+  RasterizeCells(const PointSetType * pointSet, Point1DArray & zymatrix, int extent[6], std::false_type);
+  void
+  RasterizeCells(const PointSetType * pointSet, Point1DArray & zymatrix, int extent[6], std::true_type);
 };
 } // end namespace itk
 
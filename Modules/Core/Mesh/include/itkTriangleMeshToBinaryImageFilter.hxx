@@ -398,7 +398,6 @@ TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeTriangles()
   // need to transform points from physical to index coordinates
   PointsContainer::Pointer NewPoints = PointsContainer::New();
   PointSetType::Pointer    NewPointSet = PointSetType::New();
-  PointSetType::PointType  newpoint;
 
   // the index value type must match the point value type
   ContinuousIndex<PointType::ValueType, 3> ind;
@@ -420,45 +419,8 @@ TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeTriangles()
   int          zInc = extent[3] - extent[2] + 1;
   int          zSize = extent[5] - extent[4] + 1;
   Point1DArray zymatrix(zInc * zSize);
-  PointVector  coords;
 
-  CellsContainerPointer  cells = input->GetCells();
-  CellsContainerIterator cellIt = cells->Begin();
-
-  while (cellIt != cells->End())
-  {
-    CellType *                         nextCell = cellIt->Value();
-    typename CellType::PointIdIterator pointIt = nextCell->PointIdsBegin();
-    PointType                          p;
-
-    switch (nextCell->GetType())
-    {
-      case CellGeometryEnum::VERTEX_CELL:
-      case CellGeometryEnum::LINE_CELL:
-        break;
-      case CellGeometryEnum::TRIANGLE_CELL:
-      case CellGeometryEnum::POLYGON_CELL:
-      {
-        coords.clear();
-        while (pointIt != nextCell->PointIdsEnd())
-        {
-          if (!NewPointSet->GetPoint(*pointIt++, &newpoint))
-          {
-            itkExceptionMacro("Point with id " << *pointIt - 1 << " does not exist in the new pointset");
-          }
-          p[0] = newpoint[0];
-          p[1] = newpoint[1];
-          p[2] = newpoint[2];
-          coords.push_back(p);
-        }
-        this->PolygonToImageRaster(coords, zymatrix, extent);
-      }
-      break;
-      default:
-        itkExceptionMacro(<< "Need Triangle or Polygon cells ONLY");
-    }
-    ++cellIt;
-  }
+  this->RasterizeCells(NewPointSet, zymatrix, extent, IsCompactMesh<TInputMesh>());
 
   // create the equivalent of vtkStencilData from our zymatrix
   m_StencilIndex.clear(); // prevent corruption of the filter in later updates
@@ -542,6 +504,87 @@ TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeTriangles()
   }
 }
 
+template <typename TInputMesh, typename TOutputImage>
+void
+TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeCells(const PointSetType * pointSet,
+                                                                          Point1DArray &       zymatrix,
+                                                                          int                  extent[6],
+                                                                          std::false_type)
+{
+  InputMeshPointer        input = this->GetInput(0);
+  PointSetType::PointType newpoint;
+  PointVector             coords;
+
+  auto cells = input->GetCells();
+  auto cellIt = cells->Begin();
+
+  while (cellIt != cells->End())
+  {
+    CellType *                         nextCell = cellIt->Value();
+    typename CellType::PointIdIterator pointIt = nextCell->PointIdsBegin();
+    PointType                          p;
+
+    switch (nextCell->GetType())
+    {
+      case CellGeometryEnum::VERTEX_CELL:
+      case CellGeometryEnum::LINE_CELL:
+        break;
+      case CellGeometryEnum::TRIANGLE_CELL:
+      case CellGeometryEnum::POLYGON_CELL:
+      {
+        coords.clear();
+        while (pointIt != nextCell->PointIdsEnd())
+        {
+          if (!pointSet->GetPoint(*pointIt++, &newpoint))
+          {
+            itkExceptionMacro("Point with id " << *pointIt - 1 << " does not exist in the new pointset");
+          }
+          p[0] = newpoint[0];
+          p[1] = newpoint[1];
+          p[2] = newpoint[2];
+          coords.push_back(p);
+        }
+        this->PolygonToImageRaster(coords, zymatrix, extent);
+      }
+      break;
+      default:
+        itkExceptionMacro(<< "Need Triangle or Polygon cells ONLY");
+    }
+    ++cellIt;
+  }
+}
+
+template <typename TInputMesh, typename TOutputImage>
+void
+TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeCells(const PointSetType * pointSet,
+                                                                          Point1DArray &       zymatrix,
+                                                                          int                  extent[6],
+                                                                          std::true_type)
+{
+  static_assert(TInputMesh::NumberOfCellPoints == 3, "Need a CompactMesh of triangles");
+
+  InputMeshPointer        input = this->GetInput(0);
+  PointSetType::PointType newpoint;
+  PointVector             coords(3);
+
+  const typename TInputMesh::CellIdentifier numberOfCells = input->GetNumberOfCells();
+  for (typename TInputMesh::CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    const typename TInputMesh::PointIdentifier * pointIds = input->GetCellPointIds(cellId);
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      if (!pointSet->GetPoint(pointIds[ii], &newpoint))
+      {
+        itkExceptionMacro("Point with id " << pointIds[ii] << " does not exist in the new pointset");
+      }
+      coords[ii][0] = newpoint[0];
+      coords[ii][1] = newpoint[1];
+      coords[ii][2] = newpoint[2];
+    }
+    this->PolygonToImageRaster(coords, zymatrix, extent);
+  }
+}
+
 template <typename TInputMesh, typename TOutputImage>
 void
 TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -132,12 +132,7 @@ WarpMeshFilter<TInputMesh, TOutputMesh, TDisplacementField>::GenerateData()
   this->CopyInputMeshToOutputMeshCellLinks();
   this->CopyInputMeshToOutputMeshCellData();
 
-  unsigned int maxDimension = TInputMesh::MaxTopologicalDimension;
-
-  for (unsigned int dim = 0; dim < maxDimension; dim++)
-  {
-    outputMesh->SetBoundaryAssignments(dim, inputMesh->GetBoundaryAssignments(dim));
-  }
+  this->CopyInputMeshToOutputMeshBoundaryAssignments();
 }
 } // end namespace itk
 
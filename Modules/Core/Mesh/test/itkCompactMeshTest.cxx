@@ -0,0 +1,293 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCompactMesh.h"
+#include "itkImageRegionIterator.h"
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkQuadrilateralCell.h"
+#include "itkRegularSphereMeshSource.h"
+#include "itkTransformMeshFilter.h"
+#include "itkTranslationTransform.h"
+#include "itkTriangleMeshToBinaryImageFilter.h"
+#include "itkVTKPolyDataMeshIO.h"
+#include "itkWarpMeshFilter.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using MeshType = itk::Mesh<float, Dimension>;
+using CompactMeshType = itk::CompactMesh<float, Dimension, 3>;
+
+// Check that the points and the triangles of a compact mesh are those of a mesh
+template <typename TMesh>
+bool
+HasSameGeometry(const CompactMeshType * compactMesh, const TMesh * mesh)
+{
+  if (compactMesh->GetNumberOfPoints() != mesh->GetNumberOfPoints() ||
+      compactMesh->GetNumberOfCells() != mesh->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of points or cells" << std::endl;
+    return false;
+  }
+  for (CompactMeshType::PointIdentifier id = 0; id < compactMesh->GetNumberOfPoints(); ++id)
+  {
+    if (compactMesh->GetPoint(id) != mesh->GetPoint(id))
+    {
+      std::cerr << "Wrong point " << id << std::endl;
+      return false;
+    }
+  }
+  for (CompactMeshType::CellIdentifier id = 0; id < compactMesh->GetNumberOfCells(); ++id)
+  {
+    typename TMesh::CellAutoPointer cell;
+    mesh->GetCell(id, cell);
+    if (cell->GetNumberOfPoints() != 3 ||
+        !std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), compactMesh->GetCellPointIds(id)))
+    {
+      std::cerr << "Wrong cell " << id << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TImage>
+bool
+HasSamePixels(const TImage * image1, const TImage * image2)
+{
+  itk::ImageRegionConstIterator<TImage> it1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<TImage> it2(image2, image2->GetLargestPossibleRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      std::cerr << "Wrong pixel at " << it1.GetIndex() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkCompactMeshTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputFileName" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A mesh without cells
+  auto emptyMesh = CompactMeshType::New();
+  ITK_TEST_EXPECT_EQUAL(emptyMesh->GetNumberOfCells(), 0);
+  ITK_TEST_EXPECT_TRUE(emptyMesh->GetCellPointIds(0) == nullptr);
+
+  // A closed triangulated sphere
+  using SphereMeshSourceType = itk::RegularSphereMeshSource<MeshType>;
+  SphereMeshSourceType::PointType center;
+  center.Fill(25.0);
+  SphereMeshSourceType::VectorType scale;
+  scale.Fill(15.0);
+
+  auto sphereSource = SphereMeshSourceType::New();
+  sphereSource->SetCenter(center);
+  sphereSource->SetScale(scale);
+  sphereSource->SetResolution(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(sphereSource->Update());
+  MeshType::Pointer mesh = sphereSource->GetOutput();
+  for (MeshType::CellIdentifier id = 0; id < mesh->GetNumberOfCells(); ++id)
+  {
+    mesh->SetCellData(id, static_cast<float>(id % 7));
+  }
+
+  auto compactMesh = CompactMeshType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(compactMesh, CompactMesh, PointSet);
+
+  // Import and export share the points and the data
+  ITK_TRY_EXPECT_NO_EXCEPTION(compactMesh->ImportMesh(mesh.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(HasSameGeometry(compactMesh.GetPointer(), mesh.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(compactMesh->GetPoints() == mesh->GetPoints());
+  ITK_TEST_EXPECT_TRUE(compactMesh->GetCellData() == mesh->GetCellData());
+  ITK_TEST_EXPECT_EQUAL(compactMesh->GetCellIndices()->Size(), 3 * mesh->GetNumberOfCells());
+
+  CompactMeshType::CellAutoPointer cell;
+  ITK_TEST_EXPECT_TRUE(compactMesh->GetCell(5, cell));
+  ITK_TEST_EXPECT_TRUE(cell->GetType() == itk::CellGeometryEnum::TRIANGLE_CELL);
+  ITK_TEST_EXPECT_TRUE(std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), compactMesh->GetCellPointIds(5)));
+  ITK_TEST_EXPECT_TRUE(!compactMesh->GetCell(compactMesh->GetNumberOfCells(), cell));
+
+  auto exportedMesh = MeshType::New();
+  compactMesh->ExportMesh(exportedMesh.GetPointer());
+  ITK_TEST_EXPECT_TRUE(HasSameGeometry(compactMesh.GetPointer(), exportedMesh.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(exportedMesh->GetPoints() == mesh->GetPoints());
+
+  // Cells are added one by one, from identifiers or from cells of Mesh
+  auto builtMesh = CompactMeshType::New();
+  builtMesh->SetPoints(mesh->GetPoints());
+  for (MeshType::CellIdentifier id = 0; id < mesh->GetNumberOfCells(); ++id)
+  {
+    MeshType::CellAutoPointer meshCell;
+    mesh->GetCell(id, meshCell);
+    CompactMeshType::CellAutoPointer triangle;
+    meshCell->MakeCopy(triangle);
+    if (id % 2)
+    {
+      builtMesh->SetCell(id, triangle);
+    }
+    else
+    {
+      builtMesh->SetCell(id, triangle->GetPointIds());
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(HasSameGeometry(builtMesh.GetPointer(), mesh.GetPointer()));
+
+  // A mesh with a cell which is not a triangle can't be imported
+  auto quadMesh = MeshType::New();
+  quadMesh->SetPoints(mesh->GetPoints());
+  MeshType::CellAutoPointer quad;
+  quad.TakeOwnership(new itk::QuadrilateralCell<MeshType::CellType>);
+  for (unsigned int ii = 0; ii < 4; ++ii)
+  {
+    quad->SetPointId(ii, ii);
+  }
+  quadMesh->SetCell(0, quad);
+  ITK_TRY_EXPECT_EXCEPTION(compactMesh->ImportMesh(quadMesh.GetPointer()));
+  ITK_TRY_EXPECT_EXCEPTION(builtMesh->SetCell(0, quad));
+  compactMesh->ImportMesh(mesh.GetPointer());
+
+  // Transform the points of both kinds of meshes
+  using TranslationType = itk::TranslationTransform<double, Dimension>;
+  TranslationType::OutputVectorType offset;
+  offset.Fill(1.5);
+  auto translation = TranslationType::New();
+  translation->Translate(offset);
+
+  auto transformFilter = itk::TransformMeshFilter<MeshType, MeshType, itk::Transform<double, Dimension>>::New();
+  transformFilter->SetInput(mesh);
+  transformFilter->SetTransform(translation);
+  ITK_TRY_EXPECT_NO_EXCEPTION(transformFilter->Update());
+
+  auto compactTransformFilter =
+    itk::TransformMeshFilter<CompactMeshType, CompactMeshType, itk::Transform<double, Dimension>>::New();
+  compactTransformFilter->SetInput(compactMesh);
+  compactTransformFilter->SetTransform(translation);
+  ITK_TRY_EXPECT_NO_EXCEPTION(compactTransformFilter->Update());
+  ITK_TEST_EXPECT_TRUE(HasSameGeometry(compactTransformFilter->GetOutput(), transformFilter->GetOutput()));
+  ITK_TEST_EXPECT_TRUE(compactTransformFilter->GetOutput()->GetCellIndices() != compactMesh->GetCellIndices());
+  ITK_TEST_EXPECT_EQUAL(compactTransformFilter->GetOutput()->GetCellData()->Size(), mesh->GetNumberOfCells());
+
+  // Warp them with a displacement field
+  using DisplacementFieldType = itk::Image<itk::Vector<double, Dimension>, Dimension>;
+  auto field = DisplacementFieldType::New();
+  field->SetRegions(DisplacementFieldType::SizeType{ { 50, 50, 50 } });
+  field->Allocate();
+  for (itk::ImageRegionIterator<DisplacementFieldType> it(field, field->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    DisplacementFieldType::PixelType displacement;
+    displacement[0] = 0.1 * it.GetIndex()[1];
+    displacement[1] = -0.2;
+    displacement[2] = 0.05 * it.GetIndex()[0];
+    it.Set(displacement);
+  }
+
+  auto warpFilter = itk::WarpMeshFilter<MeshType, MeshType, DisplacementFieldType>::New();
+  warpFilter->SetInput(mesh);
+  warpFilter->SetDisplacementField(field);
+  ITK_TRY_EXPECT_NO_EXCEPTION(warpFilter->Update());
+
+  auto compactWarpFilter = itk::WarpMeshFilter<CompactMeshType, CompactMeshType, DisplacementFieldType>::New();
+  compactWarpFilter->SetInput(compactMesh);
+  compactWarpFilter->SetDisplacementField(field);
+  ITK_TRY_EXPECT_NO_EXCEPTION(compactWarpFilter->Update());
+  ITK_TEST_EXPECT_TRUE(HasSameGeometry(compactWarpFilter->GetOutput(), warpFilter->GetOutput()));
+
+  // Rasterize them
+  using ImageType = itk::Image<unsigned char, Dimension>;
+  ImageType::SizeType size;
+  size.Fill(50);
+
+  auto rasterizer = itk::TriangleMeshToBinaryImageFilter<MeshType, ImageType>::New();
+  rasterizer->SetInput(mesh);
+  rasterizer->SetSize(size);
+  ITK_TRY_EXPECT_NO_EXCEPTION(rasterizer->Update());
+
+  using CompactRasterizerType = itk::TriangleMeshToBinaryImageFilter<CompactMeshType, ImageType>;
+  static_assert(std::is_same<itk::TriangleMeshToBinaryImageFilter<MeshType, ImageType>::CellsContainerPointer,
+                             MeshType::CellsContainerPointer>::value,
+                "The cells container of a Mesh input");
+  static_assert(
+    std::is_same<CompactRasterizerType::CellsContainerPointer, CompactMeshType::CellIndexContainerPointer>::value,
+    "The cells container of a CompactMesh input");
+
+  auto compactRasterizer = CompactRasterizerType::New();
+  compactRasterizer->SetInput(compactMesh);
+  compactRasterizer->SetSize(size);
+  ITK_TRY_EXPECT_NO_EXCEPTION(compactRasterizer->Update());
+  ITK_TEST_EXPECT_TRUE(HasSamePixels(compactRasterizer->GetOutput(), rasterizer->GetOutput()));
+  ITK_TEST_EXPECT_EQUAL(compactRasterizer->GetOutput()->GetPixel({ { 25, 25, 25 } }), 1);
+
+  // Write a compact mesh and read it back into both kinds of meshes
+  auto writer = itk::MeshFileWriter<CompactMeshType>::New();
+  writer->SetInput(compactMesh);
+  writer->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  writer->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto compactReader = itk::MeshFileReader<CompactMeshType>::New();
+  compactReader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  compactReader->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(compactReader->Update());
+  const CompactMeshType * readCompactMesh = compactReader->GetOutput();
+
+  auto reader = itk::MeshFileReader<MeshType>::New();
+  reader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  reader->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  ITK_TEST_EXPECT_TRUE(HasSameGeometry(readCompactMesh, mesh.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(HasSameGeometry(readCompactMesh, reader->GetOutput()));
+  ITK_TEST_EXPECT_EQUAL(readCompactMesh->GetCellData()->Size(), mesh->GetNumberOfCells());
+  for (CompactMeshType::CellIdentifier id = 0; id < readCompactMesh->GetNumberOfCells(); ++id)
+  {
+    float value = -1.0f;
+    if (!readCompactMesh->GetCellData(id, &value) || value != static_cast<float>(id % 7))
+    {
+      std::cerr << "Wrong cell data " << id << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A file with cells which are not triangles can't be read into a compact mesh of triangles
+  auto quadWriter = itk::MeshFileWriter<MeshType>::New();
+  quadWriter->SetInput(quadMesh);
+  quadWriter->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+  quadWriter->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(quadWriter->Update());
+  compactReader->Modified();
+  ITK_TRY_EXPECT_EXCEPTION(compactReader->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkQuadEdgeMeshVectorTraits_h
+#define itkQuadEdgeMeshVectorTraits_h
+
+#include <set>
+#include "itkCellInterface.h"
+#include "itkQuadEdgeCellTraitsInfo.h"
+#include "itkSparseVectorContainer.h"
+
+namespace itk
+{
+/**
+ *\class QuadEdgeMeshVectorTraits
+ *  \brief Traits of a QuadEdgeMesh storing its points, cells and data
+ *  contiguously.
+ *
+ *  This class is a variant of QuadEdgeMeshTraits whose containers are
+ *  SparseVectorContainer instead of MapContainer: the points, the pointers
+ *  to the cells and the data are stored in vectors indexed by their
+ *  identifiers, which makes accessing them much cheaper than searching the
+ *  nodes of a std::map, and inserting them does not allocate memory once the
+ *  vectors are large enough. The identifiers of the deleted points and faces
+ *  are reused by the free lists of QuadEdgeMesh, and so are their slots.
+ *
+ *  QuadEdgeMesh, its Euler operators and the QuadEdgeMeshToQuadEdgeMeshFilter
+ *  filters work identically with both traits.
+ *
+ *  \sa QuadEdgeMeshTraits
+ *  \sa SparseVectorContainer
+ * \ingroup ITKQuadEdgeMesh
+ */
+template <typename TPixel,
+          unsigned int VPointDimension,
+          typename TPData,
+          typename TDData,
+          typename TCoordRep = float,
+          typename TInterpolationWeight = float>
+class QuadEdgeMeshVectorTraits
+{
+public:
+  /** Basic types for a mesh trait class. */
+  using Self = QuadEdgeMeshVectorTraits;
+  using PixelType = TPixel;
+  using CellPixelType = TPixel;
+  using CoordRepType = TCoordRep;
+  using InterpolationWeightType = TInterpolationWeight;
+
+  static constexpr unsigned int PointDimension = VPointDimension;
+  static constexpr unsigned int MaxTopologicalDimension = VPointDimension;
+
+  using PointIdentifier = ::itk::IdentifierType;
+  using CellIdentifier = ::itk::IdentifierType;
+
+  using CellFeatureIdentifier = unsigned char; // made small in purpose
+
+  using UsingCellsContainer = std::set<CellIdentifier>;
+  using PointCellLinksContainer = std::set<CellIdentifier>;
+
+  /** Quad edge type alias. */
+  using PrimalDataType = TPData;
+  using DualDataType = TDData;
+  using QEPrimal = GeometricalQuadEdge<PointIdentifier, CellIdentifier, PrimalDataType, DualDataType>;
+  using QEDual = typename QEPrimal::DualType;
+  using VertexRefType = typename QEPrimal::OriginRefType;
+  using FaceRefType = typename QEPrimal::DualOriginRefType;
+
+  /** The type of point used for hashing.  This should never change from
+   * this setting, regardless of the mesh type. */
+  using PointHashType = Point<CoordRepType, VPointDimension>;
+
+  /** Points have an entry in the Onext ring */
+  using PointType = QuadEdgeMeshPoint<CoordRepType, VPointDimension, QEPrimal>;
+  using PointsContainer = SparseVectorContainer<PointIdentifier, PointType>;
+
+  /** Standard cell interface. */
+  using CellTraits = QuadEdgeMeshCellTraitsInfo<VPointDimension,
+                                                CoordRepType,
+                                                InterpolationWeightType,
+                                                PointIdentifier,
+                                                CellIdentifier,
+                                                CellFeatureIdentifier,
+                                                PointType,
+                                                PointsContainer,
+                                                UsingCellsContainer,
+                                                QEPrimal>;
+
+  using CellType = CellInterface<CellPixelType, CellTraits>;
+  using CellAutoPointer = typename CellType::CellAutoPointer;
+
+  /** Containers types. */
+  using CellLinksContainer = SparseVectorContainer<PointIdentifier, PointCellLinksContainer>;
+  using CellsContainer = SparseVectorContainer<CellIdentifier, CellType *>;
+  using PointDataContainer = SparseVectorContainer<PointIdentifier, PixelType>;
+  using CellDataContainer = SparseVectorContainer<CellIdentifier, CellPixelType>;
+
+  /** Other useful types. */
+  using VectorType = typename PointType::VectorType;
+};
+} // namespace itk
+
+#endif
@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkQuadEdgeMesh.h"
+#include "itkQuadEdgeMeshEulerOperatorCreateCenterVertexFunction.h"
+#include "itkQuadEdgeMeshEulerOperatorDeleteCenterVertexFunction.h"
+#include "itkQuadEdgeMeshEulerOperatorFlipEdgeFunction.h"
+#include "itkQuadEdgeMeshEulerOperatorJoinVertexFunction.h"
+#include "itkQuadEdgeMeshEulerOperatorSplitFacetFunction.h"
+#include "itkQuadEdgeMeshEulerOperatorsTestHelper.h"
+#include "itkQuadEdgeMeshToQuadEdgeMeshFilter.h"
+#include "itkQuadEdgeMeshVectorTraits.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+
+// Apply the same Euler operators to a QuadEdgeMesh with the default traits
+// and to one with QuadEdgeMeshVectorTraits, and check that they stay identical.
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using MapMeshType = itk::QuadEdgeMesh<double, Dimension>;
+using VectorTraits = itk::QuadEdgeMeshVectorTraits<double, Dimension, bool, bool>;
+using VectorMeshType = itk::QuadEdgeMesh<double, Dimension, VectorTraits>;
+
+// Check that two meshes have the same points, edges and faces, with the same identifiers
+template <typename TMesh1, typename TMesh2>
+bool
+HaveSameTopology(const TMesh1 * mesh1, const TMesh2 * mesh2)
+{
+  if (mesh1->GetNumberOfPoints() != mesh2->GetNumberOfPoints() ||
+      mesh1->GetNumberOfEdges() != mesh2->GetNumberOfEdges() ||
+      mesh1->GetNumberOfFaces() != mesh2->GetNumberOfFaces() || mesh1->GetNumberOfCells() != mesh2->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of points, edges or faces" << std::endl;
+    return false;
+  }
+
+  for (auto it = mesh1->GetPoints()->Begin(); it != mesh1->GetPoints()->End(); ++it)
+  {
+    if (!mesh2->GetPoints()->IndexExists(it.Index()) ||
+        it.Value().GetVectorFromOrigin() != mesh2->GetPoint(it.Index()).GetVectorFromOrigin() ||
+        (it.Value().GetEdge() == nullptr) != (mesh2->GetPoint(it.Index()).GetEdge() == nullptr))
+    {
+      std::cerr << "Wrong point " << it.Index() << std::endl;
+      return false;
+    }
+  }
+
+  for (auto it = mesh1->GetEdgeCells()->Begin(); it != mesh1->GetEdgeCells()->End(); ++it)
+  {
+    auto * edge = dynamic_cast<typename TMesh1::EdgeCellType *>(it.Value());
+    if (mesh2->FindEdge(edge->GetQEGeom()->GetOrigin(), edge->GetQEGeom()->GetDestination()) == nullptr)
+    {
+      std::cerr << "Missing edge " << edge->GetQEGeom()->GetOrigin() << " " << edge->GetQEGeom()->GetDestination()
+                << std::endl;
+      return false;
+    }
+  }
+
+  for (auto it = mesh1->GetCells()->Begin(); it != mesh1->GetCells()->End(); ++it)
+  {
+    // PointIdsBegin() computes the point identifiers of a QuadEdgeMeshPolygonCell, and must precede PointIdsEnd()
+    typename TMesh2::CellType * cell2 = nullptr;
+    if (!mesh2->GetCells()->GetElementIfIndexExists(it.Index(), &cell2) ||
+        it.Value()->GetNumberOfPoints() != cell2->GetNumberOfPoints())
+    {
+      std::cerr << "Wrong face " << it.Index() << std::endl;
+      return false;
+    }
+    const auto pointIds1 = it.Value()->PointIdsBegin();
+    if (!std::equal(pointIds1, it.Value()->PointIdsEnd(), cell2->PointIdsBegin()))
+    {
+      std::cerr << "Wrong face " << it.Index() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TMesh>
+typename TMesh::QEType *
+JoinVertex(TMesh * mesh, typename TMesh::PointIdentifier pointId)
+{
+  auto joinVertex = itk::QuadEdgeMeshEulerOperatorJoinVertexFunction<TMesh, typename TMesh::QEType>::New();
+  joinVertex->SetInput(mesh);
+  typename TMesh::QEType * edge = mesh->FindEdge(pointId);
+  return edge ? joinVertex->Evaluate(edge) : nullptr;
+}
+
+template <typename TMesh>
+typename TMesh::QEType *
+FlipEdge(TMesh * mesh, typename TMesh::PointIdentifier org, typename TMesh::PointIdentifier dest)
+{
+  auto flipEdge = itk::QuadEdgeMeshEulerOperatorFlipEdgeFunction<TMesh, typename TMesh::QEType>::New();
+  flipEdge->SetInput(mesh);
+  return flipEdge->Evaluate(mesh->FindEdge(org, dest));
+}
+
+template <typename TMesh>
+typename TMesh::QEType *
+CreateAndDeleteCenterVertex(TMesh * mesh, typename TMesh::PointIdentifier org, typename TMesh::PointIdentifier dest)
+{
+  auto createCenterVertex =
+    itk::QuadEdgeMeshEulerOperatorCreateCenterVertexFunction<TMesh, typename TMesh::QEType>::New();
+  createCenterVertex->SetInput(mesh);
+  auto deleteCenterVertex =
+    itk::QuadEdgeMeshEulerOperatorDeleteCenterVertexFunction<TMesh, typename TMesh::QEType>::New();
+  deleteCenterVertex->SetInput(mesh);
+  return deleteCenterVertex->Evaluate(createCenterVertex->Evaluate(mesh->FindEdge(org, dest)));
+}
+
+template <typename TMesh>
+typename TMesh::QEType *
+SplitFacet(TMesh * mesh, typename TMesh::PointIdentifier org, typename TMesh::PointIdentifier dest)
+{
+  auto splitFacet = itk::QuadEdgeMeshEulerOperatorSplitFacetFunction<TMesh, typename TMesh::QEType>::New();
+  splitFacet->SetInput(mesh);
+  typename TMesh::QEType * edge = mesh->FindEdge(org, dest);
+  return edge ? splitFacet->Evaluate(edge, edge->GetLnext()->GetLnext()) : nullptr;
+}
+} // namespace
+
+int
+itkQuadEdgeMeshVectorTraitsTest(int, char *[])
+{
+  // The container keeps the semantics of MapContainer
+  using ContainerType = itk::SparseVectorContainer<itk::IdentifierType, double>;
+  auto container = ContainerType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(container, SparseVectorContainer, Object);
+
+  container->InsertElement(3, 3.0);
+  container->InsertElement(7, 7.0);
+  container->InsertElement(5, 5.0);
+  ITK_TEST_EXPECT_EQUAL(container->Size(), 3);
+  ITK_TEST_EXPECT_TRUE(!container->IndexExists(4) && !container->IndexExists(8));
+  container->DeleteIndex(7);
+  container->DeleteIndex(3);
+  ITK_TEST_EXPECT_EQUAL(container->Size(), 1);
+  ITK_TEST_EXPECT_EQUAL(container->Begin().Index(), 5);
+  ITK_TEST_EXPECT_EQUAL((--container->End()).Index(), 5);
+  container->InsertElement(1, 1.0);
+  itk::IdentifierType sum = 0;
+  for (auto it = container->Begin(); it != container->End(); ++it)
+  {
+    ITK_TEST_EXPECT_EQUAL(it.Value(), static_cast<double>(it.Index()));
+    sum += it.Index();
+  }
+  ITK_TEST_EXPECT_EQUAL(sum, 6);
+  container->Reserve(3);
+  ITK_TEST_EXPECT_EQUAL(container->Size(), 4);
+  ITK_TEST_EXPECT_EQUAL(container->GetElement(1), 1.0);
+  container->Initialize();
+  ITK_TEST_EXPECT_TRUE(container->empty() && container->Begin() == container->End());
+
+  // The same square made of triangles in both meshes
+  MapMeshType::Pointer    mapMesh = MapMeshType::New();
+  VectorMeshType::Pointer vectorMesh = VectorMeshType::New();
+  CreateSquareTriangularMesh<MapMeshType>(mapMesh);
+  CreateSquareTriangularMesh<VectorMeshType>(vectorMesh);
+  ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapMesh.GetPointer(), vectorMesh.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(AssertTopologicalInvariants<VectorMeshType>(vectorMesh, 25, 56, 32, 1, 0));
+
+  // Operators which add and delete points, edges and faces
+  ITK_TEST_EXPECT_TRUE(FlipEdge(mapMesh.GetPointer(), 12, 6) != nullptr);
+  ITK_TEST_EXPECT_TRUE(FlipEdge(vectorMesh.GetPointer(), 12, 6) != nullptr);
+  ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapMesh.GetPointer(), vectorMesh.GetPointer()));
+
+  ITK_TEST_EXPECT_TRUE(CreateAndDeleteCenterVertex(mapMesh.GetPointer(), 0, 1) != nullptr);
+  ITK_TEST_EXPECT_TRUE(CreateAndDeleteCenterVertex(vectorMesh.GetPointer(), 0, 1) != nullptr);
+  ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapMesh.GetPointer(), vectorMesh.GetPointer()));
+
+  // Collapse the edges around a vertex until it is not possible anymore
+  for (unsigned int ii = 0; ii < 10; ++ii)
+  {
+    const bool joined = (JoinVertex(mapMesh.GetPointer(), 12) != nullptr);
+    ITK_TEST_EXPECT_EQUAL(joined, JoinVertex(vectorMesh.GetPointer(), 12) != nullptr);
+    ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapMesh.GetPointer(), vectorMesh.GetPointer()));
+  }
+
+  ITK_TEST_EXPECT_EQUAL(SplitFacet(mapMesh.GetPointer(), 20, 15) != nullptr,
+                        SplitFacet(vectorMesh.GetPointer(), 20, 15) != nullptr);
+  ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapMesh.GetPointer(), vectorMesh.GetPointer()));
+
+  // The identifiers of the deleted points are reused, and so are their slots
+  mapMesh->SqueezePointsIds();
+  vectorMesh->SqueezePointsIds();
+  ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapMesh.GetPointer(), vectorMesh.GetPointer()));
+  ITK_TEST_EXPECT_EQUAL((--vectorMesh->GetPoints()->End()).Index() + 1, vectorMesh->GetNumberOfPoints());
+
+  // Copy both ways, as the QuadEdgeMeshToQuadEdgeMeshFilter filters do. The
+  // copies number the faces in the order they are visited.
+  MapMeshType::Pointer    mapCopy = MapMeshType::New();
+  VectorMeshType::Pointer vectorCopy = VectorMeshType::New();
+  itk::CopyMeshToMesh(mapMesh.GetPointer(), mapCopy.GetPointer());
+  itk::CopyMeshToMesh(mapMesh.GetPointer(), vectorCopy.GetPointer());
+  ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapCopy.GetPointer(), vectorCopy.GetPointer()));
+
+  mapCopy = MapMeshType::New();
+  vectorCopy = VectorMeshType::New();
+  itk::CopyMeshToMesh(vectorMesh.GetPointer(), mapCopy.GetPointer());
+  itk::CopyMeshToMesh(vectorMesh.GetPointer(), vectorCopy.GetPointer());
+  ITK_TEST_EXPECT_TRUE(HaveSameTopology(mapCopy.GetPointer(), vectorCopy.GetPointer()));
+  ITK_TEST_EXPECT_EQUAL(vectorCopy->GetNumberOfFaces(), mapMesh->GetNumberOfFaces());
+
+  // Clear deletes all the edges and the faces
+  vectorMesh->Clear();
+  ITK_TEST_EXPECT_EQUAL(vectorMesh->GetNumberOfPoints(), 0);
+  ITK_TEST_EXPECT_EQUAL(vectorMesh->GetNumberOfCells(), 0);
+  ITK_TEST_EXPECT_TRUE(vectorMesh->GetEdgeCells()->empty());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -40,6 +40,12 @@ template <typename TInputImage, typename TOutputImage, typename TKernel>
 void
 BinaryDilateImageFilter<TInputImage, TOutputImage, TKernel>::GenerateData()
 {
+  if (this->GetRunLengthEncoding())
+  {
+    this->RunLengthEncodedGenerateData(true);
+    return;
+  }
+
   this->AllocateOutputs();
 
   unsigned int i, j;
@@ -40,6 +40,12 @@ template <typename TInputImage, typename TOutputImage, typename TKernel>
 void
 BinaryErodeImageFilter<TInputImage, TOutputImage, TKernel>::GenerateData()
 {
+  if (this->GetRunLengthEncoding())
+  {
+    this->RunLengthEncodedGenerateData(false);
+    return;
+  }
+
   this->AllocateOutputs();
 
   unsigned int i, j;
@@ -99,6 +99,13 @@ public:
   itkGetConstReferenceMacro(SafeBorder, bool);
   itkBooleanMacro(SafeBorder);
 
+  /** Get/Set whether the internal erosion and dilation use the run-length
+   * encoded implementation. See BinaryMorphologyImageFilter. Defaults to
+   * false. */
+  itkSetMacro(RunLengthEncoding, bool);
+  itkGetConstReferenceMacro(RunLengthEncoding, bool);
+  itkBooleanMacro(RunLengthEncoding);
+
 protected:
   BinaryMorphologicalClosingImageFilter();
   ~BinaryMorphologicalClosingImageFilter() override = default;
@@ -114,6 +121,8 @@ private:
   InputPixelType m_ForegroundValue;
 
   bool m_SafeBorder;
+
+  bool m_RunLengthEncoding{ false };
 }; // end of class
 } // end namespace itk
 
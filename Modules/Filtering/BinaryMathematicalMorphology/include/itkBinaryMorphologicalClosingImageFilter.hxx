@@ -78,6 +78,8 @@ BinaryMorphologicalClosingImageFilter<TInputImage, TOutputImage, TKernel>::Gener
   erode->ReleaseDataFlagOn();
   erode->SetForegroundValue(m_ForegroundValue); // Intensity value to erode
   erode->SetBackgroundValue(backgroundValue);   // Replacement value for eroded voxel
+  dilate->SetRunLengthEncoding(m_RunLengthEncoding);
+  erode->SetRunLengthEncoding(m_RunLengthEncoding);
   erode->SetInput(dilate->GetOutput());
 
   // now we have 2 cases:
@@ -170,6 +172,7 @@ BinaryMorphologicalClosingImageFilter<TInputImage, TOutputImage, TKernel>::Print
      << "ForegroundValue: " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(m_ForegroundValue)
      << std::endl;
   os << indent << "SafeBorder: " << m_SafeBorder << std::endl;
+  os << indent << "RunLengthEncoding: " << m_RunLengthEncoding << std::endl;
 }
 } // end namespace itk
 #endif
@@ -98,6 +98,13 @@ public:
   /** Set the value in eroded part of the image. Defaults to zero */
   itkGetConstMacro(BackgroundValue, PixelType);
 
+  /** Get/Set whether the internal erosion and dilation use the run-length
+   * encoded implementation. See BinaryMorphologyImageFilter. Defaults to
+   * false. */
+  itkSetMacro(RunLengthEncoding, bool);
+  itkGetConstReferenceMacro(RunLengthEncoding, bool);
+  itkBooleanMacro(RunLengthEncoding);
+
 protected:
   BinaryMorphologicalOpeningImageFilter();
   ~BinaryMorphologicalOpeningImageFilter() override = default;
@@ -113,6 +120,8 @@ private:
   PixelType m_ForegroundValue;
 
   PixelType m_BackgroundValue;
+
+  bool m_RunLengthEncoding{ false };
 }; // end of class
 } // end namespace itk
 
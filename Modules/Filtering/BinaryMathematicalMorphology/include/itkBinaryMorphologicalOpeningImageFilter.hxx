@@ -62,6 +62,8 @@ BinaryMorphologicalOpeningImageFilter<TInputImage, TOutputImage, TKernel>::Gener
   dilate->SetForegroundValue(m_ForegroundValue); // Intensity value to dilate
   erode->SetForegroundValue(m_ForegroundValue);  // Intensity value to erode
   erode->SetBackgroundValue(m_BackgroundValue);  // Replacement value for eroded voxels
+  dilate->SetRunLengthEncoding(m_RunLengthEncoding);
+  erode->SetRunLengthEncoding(m_RunLengthEncoding);
 
   /** set up the minipipeline */
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
@@ -91,6 +93,7 @@ BinaryMorphologicalOpeningImageFilter<TInputImage, TOutputImage, TKernel>::Print
      << std::endl;
   os << indent << "BackgroundValue: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_BackgroundValue)
      << std::endl;
+  os << indent << "RunLengthEncoding: " << m_RunLengthEncoding << std::endl;
 }
 } // end namespace itk
 #endif
@@ -96,6 +96,11 @@ namespace itk
  * portions of these two implementations were then placed in this
  * superclass.
  *
+ * With RunLengthEncodingOn(), the dilations and erosions are instead
+ * computed on a run-length encoded copy of the image, see
+ * RunLengthEncodedBinaryImage. This is much faster for large structuring
+ * elements and produces the same output.
+ *
  * \sa ImageToImageFilter BinaryErodeImageFilter BinaryDilateImageFilter
  * \ingroup ITKBinaryMathematicalMorphology
  */
@@ -177,6 +182,15 @@ public:
   itkGetConstReferenceMacro(BoundaryToForeground, bool);
   itkBooleanMacro(BoundaryToForeground);
 
+  /** Get/Set whether the operation is computed on a run-length encoded
+   * representation of the image rather than by following the surface of the
+   * objects. The run-length encoded implementation is multithreaded, and its
+   * cost depends on the number of runs in the image instead of the number of
+   * pixels in the structuring element. Defaults to false. */
+  itkSetMacro(RunLengthEncoding, bool);
+  itkGetConstReferenceMacro(RunLengthEncoding, bool);
+  itkBooleanMacro(RunLengthEncoding);
+
   /** Set kernel (structuring element). */
   void
   SetKernel(const KernelType & kernel) override;
@@ -192,6 +206,12 @@ protected:
   void
   AnalyzeKernel();
 
+  /** Generate the output with the run-length encoded implementation. The
+   * dilation computes the dilation of the foreground, the erosion the
+   * dilation of the background. */
+  void
+  RunLengthEncodedGenerateData(bool dilateForeground);
+
   /** Type definition of container of neighbourhood index */
   using NeighborIndexContainer = std::vector<OffsetType>;
 
@@ -231,6 +251,8 @@ protected:
   bool m_BoundaryToForeground;
 
 private:
+  bool m_RunLengthEncoding{ false };
+
   /** Pixel value to dilate */
   InputPixelType m_ForegroundValue;
 
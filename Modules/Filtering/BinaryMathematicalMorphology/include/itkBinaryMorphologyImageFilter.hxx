@@ -26,6 +26,9 @@
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
 #include "itkBinaryMorphologyImageFilter.h"
+#include "itkRunLengthEncodedBinaryImage.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressTransformer.h"
 
 namespace itk
 {
@@ -320,6 +323,98 @@ BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::AnalyzeKernel()
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+void
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::RunLengthEncodedGenerateData(bool dilateForeground)
+{
+  this->AllocateOutputs();
+
+  using RunLengthImageType = RunLengthEncodedBinaryImage<InputImageDimension>;
+
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const InputPixelType  foregroundValue = m_ForegroundValue;
+  const OutputPixelType backgroundValue = m_BackgroundValue;
+
+  const OutputImageRegionType outputRegion = output->GetRequestedRegion();
+
+  // the input pixels which may reach the output
+  InputImageRegionType inputRegion = outputRegion;
+  inputRegion.PadByRadius(this->GetKernel().GetRadius());
+  inputRegion.Crop(input->GetBufferedRegion());
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // for erosions, the background is dilated: it is the complement of the
+  // foreground, and the boundary is part of it when it isn't foreground
+  ProgressTransformer progress1(0.0f, 0.2f, this);
+  RunLengthImageType  inputRuns;
+  inputRuns.SetRegion(inputRegion);
+  inputRuns.Encode(input, foregroundValue, multiThreader);
+  if (!dilateForeground)
+  {
+    inputRuns.Complement();
+  }
+  progress1.GetProcessObject()->UpdateProgress(1.0f);
+
+  ProgressTransformer progress2(0.2f, 0.7f, this);
+  RunLengthImageType  dilatedRuns;
+  dilatedRuns.SetRegion(outputRegion);
+  dilatedRuns.Dilate(inputRuns,
+                     RunLengthImageType::ComputeKernelLines(this->GetKernel()),
+                     dilateForeground == m_BoundaryToForeground,
+                     multiThreader);
+  inputRuns = RunLengthImageType();
+  progress2.GetProcessObject()->UpdateProgress(1.0f);
+
+  // paint the output: the dilated set is foreground for dilations and
+  // background for erosions. The background pixels of the input which are
+  // background in the output are left unchanged.
+  ProgressTransformer progress3(0.7f, 1.0f, this);
+  multiThreader->template ParallelizeImageRegionRestrictDirection<OutputImageDimension>(
+    0,
+    outputRegion,
+    [&](const OutputImageRegionType & region) {
+      ImageScanlineConstIterator<InputImageType> inIt(input, region);
+      ImageScanlineIterator<OutputImageType>     outIt(output, region);
+      while (!outIt.IsAtEnd())
+      {
+        const auto &   runs = dilatedRuns.GetLine(dilatedRuns.ComputeLineId(outIt.GetIndex()));
+        auto           runIt = runs.begin();
+        IndexValueType x = region.GetIndex(0);
+        while (!outIt.IsAtEndOfLine())
+        {
+          while (runIt != runs.end() && runIt->second < x)
+          {
+            ++runIt;
+          }
+          const bool           inDilatedSet = runIt != runs.end() && runIt->first <= x;
+          const InputPixelType value = inIt.Get();
+          if (inDilatedSet == dilateForeground)
+          {
+            outIt.Set(static_cast<OutputPixelType>(foregroundValue));
+          }
+          else if (Math::ExactlyEquals(value, foregroundValue))
+          {
+            outIt.Set(backgroundValue);
+          }
+          else
+          {
+            outIt.Set(static_cast<OutputPixelType>(value));
+          }
+          ++inIt;
+          ++outIt;
+          ++x;
+        }
+        inIt.NextLine();
+        outIt.NextLine();
+      }
+    },
+    progress3.GetProcessObject());
+}
+
 /**
  * Standard "PrintSelf" method
  */
@@ -335,6 +430,7 @@ BinaryMorphologyImageFilter<TInputImage, TOutput, TKernel>::PrintSelf(std::ostre
      << "Background Value: " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_BackgroundValue)
      << std::endl;
   os << indent << "BoundaryToForeground: " << m_BoundaryToForeground << std::endl;
+  os << indent << "RunLengthEncoding: " << m_RunLengthEncoding << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthEncodedBinaryImage_h
+#define itkRunLengthEncodedBinaryImage_h
+
+#include <utility>
+#include <vector>
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+
+namespace itk
+{
+/**
+ * \class RunLengthEncodedBinaryImage
+ * \brief Run-length encoded set of pixels, used by the binary morphology filters.
+ *
+ * The set is stored as runs along the dimension 0, as in LabelObjectLine,
+ * but grouped by line: each line of the region holds the sorted, disjoint
+ * runs of pixels of the set, given by the indices of their first and last
+ * pixel. Lines are stored in the same order as the pixels of an image
+ * with the same region, so the encoding and decoding are simple scanline
+ * traversals.
+ *
+ * Dilate() computes the Minkowski sum of a set with a structuring element
+ * directly on the runs. Each run of the input is extended by each run of
+ * the structuring element, and the extended runs reaching an output line are
+ * merged. Its cost depends on the number of runs rather than on the number
+ * of pixels, which makes it much faster than pixel based approaches for
+ * large structuring elements. Erosions are computed as the dilation of the
+ * complement.
+ *
+ * Lines are processed in groups, in parallel.
+ *
+ * \sa BinaryDilateImageFilter BinaryErodeImageFilter LabelObjectLine
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <unsigned int VImageDimension>
+class ITK_TEMPLATE_EXPORT RunLengthEncodedBinaryImage
+{
+public:
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  using Self = RunLengthEncodedBinaryImage;
+  using IndexType = Index<VImageDimension>;
+  using OffsetType = Offset<VImageDimension>;
+  using RegionType = ImageRegion<VImageDimension>;
+
+  /** A run of pixels along the dimension 0, from its first to its last index. */
+  using RunType = std::pair<IndexValueType, IndexValueType>;
+  using RunLineType = std::vector<RunType>;
+
+  /** The runs of a structuring element in one of its lines. The runs are
+   * offsets along the dimension 0, and Offset gives the position of the line
+   * in the other dimensions. */
+  struct KernelLineType
+  {
+    OffsetType  Offset;
+    RunLineType Runs;
+  };
+  using KernelLinesType = std::vector<KernelLineType>;
+
+  /** Set the region covered by the set. All the lines are cleared. */
+  void
+  SetRegion(const RegionType & region);
+
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+  SizeValueType
+  GetNumberOfLines() const
+  {
+    return static_cast<SizeValueType>(m_Lines.size());
+  }
+
+  /** Get the total number of runs in the set. */
+  SizeValueType
+  GetNumberOfRuns() const;
+
+  /** Get the id of the line holding an index. The index in the dimension 0
+   * is ignored. The index must be inside the region in the other
+   * dimensions. */
+  SizeValueType
+  ComputeLineId(const IndexType & index) const;
+
+  RunLineType &
+  GetLine(SizeValueType lineId)
+  {
+    return m_Lines[lineId];
+  }
+
+  const RunLineType &
+  GetLine(SizeValueType lineId) const
+  {
+    return m_Lines[lineId];
+  }
+
+  /** Encode the pixels of an image equal to a value. The image buffer must
+   * contain the region of the set. */
+  template <typename TImage>
+  void
+  Encode(const TImage * image, const typename TImage::PixelType & value, MultiThreaderBase * multiThreader);
+
+  /** Replace the set by its complement in the region. */
+  void
+  Complement();
+
+  /** Compute the runs of a structuring element. The elements of the kernel
+   * which are not zero are part of the structuring element. */
+  template <typename TKernel>
+  static KernelLinesType
+  ComputeKernelLines(const TKernel & kernel);
+
+  /** Set this set, over its region, to the dilation of another set by a
+   * structuring element, the union of the input translated by all the offsets
+   * of the structuring element. If boundaryInSet is true, the pixels outside
+   * the region of the input are considered to be part of the input. The
+   * region of the input must contain the region of this set padded by the
+   * radius of the structuring element, cropped to the image. */
+  void
+  Dilate(const Self & input, const KernelLinesType & kernelLines, bool boundaryInSet, MultiThreaderBase * multiThreader);
+
+private:
+  /** Merge a list of possibly overlapping runs and crop it to [begin, end]. */
+  static void
+  MergeRuns(RunLineType & runs, IndexValueType begin, IndexValueType end, RunLineType & merged);
+
+  RegionType               m_Region;
+  std::vector<RunLineType> m_Lines;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRunLengthEncodedBinaryImage.hxx"
+#endif
+
+#endif
@@ -0,0 +1,310 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthEncodedBinaryImage_hxx
+#define itkRunLengthEncodedBinaryImage_hxx
+
+#include "itkRunLengthEncodedBinaryImage.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkMath.h"
+#include <algorithm>
+
+namespace itk
+{
+template <unsigned int VImageDimension>
+void
+RunLengthEncodedBinaryImage<VImageDimension>::SetRegion(const RegionType & region)
+{
+  m_Region = region;
+
+  SizeValueType numberOfLines = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
+  {
+    numberOfLines *= m_Region.GetSize(d);
+  }
+  m_Lines.clear();
+  m_Lines.resize(numberOfLines);
+}
+
+template <unsigned int VImageDimension>
+SizeValueType
+RunLengthEncodedBinaryImage<VImageDimension>::GetNumberOfRuns() const
+{
+  SizeValueType numberOfRuns = 0;
+  for (const auto & line : m_Lines)
+  {
+    numberOfRuns += line.size();
+  }
+  return numberOfRuns;
+}
+
+template <unsigned int VImageDimension>
+SizeValueType
+RunLengthEncodedBinaryImage<VImageDimension>::ComputeLineId(const IndexType & index) const
+{
+  SizeValueType lineId = 0;
+  SizeValueType stride = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
+  {
+    lineId += static_cast<SizeValueType>(index[d] - m_Region.GetIndex(d)) * stride;
+    stride *= m_Region.GetSize(d);
+  }
+  return lineId;
+}
+
+template <unsigned int VImageDimension>
+template <typename TImage>
+void
+RunLengthEncodedBinaryImage<VImageDimension>::Encode(const TImage *                     image,
+                                                     const typename TImage::PixelType & value,
+                                                     MultiThreaderBase *                multiThreader)
+{
+  for (auto & line : m_Lines)
+  {
+    line.clear();
+  }
+  if (m_Region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  multiThreader->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+    0,
+    m_Region,
+    [this, image, &value](const RegionType & region) {
+      ImageScanlineConstIterator<TImage> it(image, region);
+      while (!it.IsAtEnd())
+      {
+        RunLineType &  line = m_Lines[this->ComputeLineId(it.GetIndex())];
+        IndexValueType x = region.GetIndex(0);
+        bool           inRun = false;
+        while (!it.IsAtEndOfLine())
+        {
+          if (Math::ExactlyEquals(it.Get(), value))
+          {
+            if (inRun)
+            {
+              line.back().second = x;
+            }
+            else
+            {
+              line.emplace_back(x, x);
+              inRun = true;
+            }
+          }
+          else
+          {
+            inRun = false;
+          }
+          ++it;
+          ++x;
+        }
+        it.NextLine();
+      }
+    },
+    nullptr);
+}
+
+template <unsigned int VImageDimension>
+void
+RunLengthEncodedBinaryImage<VImageDimension>::Complement()
+{
+  const IndexValueType begin = m_Region.GetIndex(0);
+  const IndexValueType end = begin + static_cast<IndexValueType>(m_Region.GetSize(0)) - 1;
+
+  RunLineType complement;
+  for (auto & line : m_Lines)
+  {
+    complement.clear();
+    IndexValueType next = begin;
+    for (const auto & run : line)
+    {
+      if (run.first > next)
+      {
+        complement.emplace_back(next, run.first - 1);
+      }
+      next = run.second + 1;
+    }
+    if (next <= end)
+    {
+      complement.emplace_back(next, end);
+    }
+    line.swap(complement);
+  }
+}
+
+template <unsigned int VImageDimension>
+template <typename TKernel>
+auto
+RunLengthEncodedBinaryImage<VImageDimension>::ComputeKernelLines(const TKernel & kernel) -> KernelLinesType
+{
+  // the elements of a neighborhood are ordered with the dimension 0 varying
+  // the fastest, so the runs of a line are found one after the other
+  KernelLinesType kernelLines;
+
+  typename TKernel::NeighborIndexType i = 0;
+  for (auto kernelIt = kernel.Begin(); kernelIt != kernel.End(); ++kernelIt, ++i)
+  {
+    if (!*kernelIt)
+    {
+      continue;
+    }
+    OffsetType           offset = kernel.GetOffset(i);
+    const IndexValueType x = offset[0];
+    offset[0] = 0;
+
+    if (kernelLines.empty() || kernelLines.back().Offset != offset)
+    {
+      kernelLines.push_back(KernelLineType{ offset, RunLineType() });
+    }
+    RunLineType & runs = kernelLines.back().Runs;
+    if (!runs.empty() && runs.back().second + 1 == x)
+    {
+      runs.back().second = x;
+    }
+    else
+    {
+      runs.emplace_back(x, x);
+    }
+  }
+  return kernelLines;
+}
+
+template <unsigned int VImageDimension>
+void
+RunLengthEncodedBinaryImage<VImageDimension>::Dilate(const Self &            input,
+                                                     const KernelLinesType & kernelLines,
+                                                     bool                    boundaryInSet,
+                                                     MultiThreaderBase *     multiThreader)
+{
+  for (auto & line : m_Lines)
+  {
+    line.clear();
+  }
+  if (m_Region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  const RegionType &   inputRegion = input.GetRegion();
+  const IndexValueType inputBegin = inputRegion.GetIndex(0);
+  const IndexValueType inputEnd = inputBegin + static_cast<IndexValueType>(inputRegion.GetSize(0)) - 1;
+  const IndexValueType begin = m_Region.GetIndex(0);
+  const IndexValueType end = begin + static_cast<IndexValueType>(m_Region.GetSize(0)) - 1;
+
+  multiThreader->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+    0,
+    m_Region,
+    [&](const RegionType & region) {
+      SizeValueType numberOfLines = 1;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        numberOfLines *= region.GetSize(d);
+      }
+
+      RunLineType candidates;
+      IndexType   index = region.GetIndex();
+      for (SizeValueType n = 0; n < numberOfLines; ++n)
+      {
+        SizeValueType remainder = n;
+        for (unsigned int d = 1; d < ImageDimension; ++d)
+        {
+          index[d] = region.GetIndex(d) + static_cast<IndexValueType>(remainder % region.GetSize(d));
+          remainder /= region.GetSize(d);
+        }
+
+        // gather the runs of the input lines reaching this line, extended by
+        // the runs of the structuring element
+        candidates.clear();
+        bool fullLine = false;
+        for (const auto & kernelLine : kernelLines)
+        {
+          IndexType source = index - kernelLine.Offset;
+          source[0] = inputBegin;
+          if (!inputRegion.IsInside(source))
+          {
+            if (boundaryInSet)
+            {
+              fullLine = true;
+              break;
+            }
+            continue;
+          }
+
+          for (const auto & run : input.GetLine(input.ComputeLineId(source)))
+          {
+            for (const auto & kernelRun : kernelLine.Runs)
+            {
+              candidates.emplace_back(run.first + kernelRun.first, run.second + kernelRun.second);
+            }
+          }
+          if (boundaryInSet)
+          {
+            // the pixels before and after the input line
+            for (const auto & kernelRun : kernelLine.Runs)
+            {
+              candidates.emplace_back(begin, inputBegin - 1 + kernelRun.second);
+              candidates.emplace_back(inputEnd + 1 + kernelRun.first, end);
+            }
+          }
+        }
+
+        RunLineType & line = m_Lines[this->ComputeLineId(index)];
+        if (fullLine)
+        {
+          line.emplace_back(begin, end);
+        }
+        else
+        {
+          MergeRuns(candidates, begin, end, line);
+        }
+      }
+    },
+    nullptr);
+}
+
+template <unsigned int VImageDimension>
+void
+RunLengthEncodedBinaryImage<VImageDimension>::MergeRuns(RunLineType &  runs,
+                                                        IndexValueType begin,
+                                                        IndexValueType end,
+                                                        RunLineType &  merged)
+{
+  std::sort(runs.begin(), runs.end());
+
+  merged.clear();
+  for (const auto & run : runs)
+  {
+    const IndexValueType first = std::max(run.first, begin);
+    const IndexValueType last = std::min(run.second, end);
+    if (first > last)
+    {
+      continue;
+    }
+    if (!merged.empty() && first <= merged.back().second + 1)
+    {
+      merged.back().second = std::max(merged.back().second, last);
+    }
+    else
+    {
+      merged.emplace_back(first, last);
+    }
+  }
+}
+} // end namespace itk
+
+#endif
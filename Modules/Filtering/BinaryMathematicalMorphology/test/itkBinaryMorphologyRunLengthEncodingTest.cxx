@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryErodeImageFilter.h"
+#include "itkBinaryMorphologicalClosingImageFilter.h"
+#include "itkBinaryMorphologicalOpeningImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+// Check that the run-length encoded implementation of the binary morphology
+// filters produces the same output as the default implementation.
+
+namespace
+{
+
+template <typename TImage>
+bool
+ImagesAreEqual(const TImage * image1, const TImage * image2, const std::string & description)
+{
+  itk::ImageRegionConstIterator<TImage> it1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<TImage> it2(image2, image2->GetLargestPossibleRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      std::cerr << description << ": mismatch at " << it1.GetIndex() << ": " << static_cast<int>(it1.Get())
+                << " != " << static_cast<int>(it2.Get()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TFilter>
+bool
+CompareErodeDilate(const typename TFilter::InputImageType * image,
+                   const typename TFilter::KernelType &     kernel,
+                   bool                                    boundaryToForeground,
+                   const std::string &                     description)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetKernel(kernel);
+  filter->SetForegroundValue(2);
+  filter->SetBackgroundValue(5);
+  filter->SetBoundaryToForeground(boundaryToForeground);
+  filter->Update();
+
+  auto runLengthFilter = TFilter::New();
+  runLengthFilter->SetInput(image);
+  runLengthFilter->SetKernel(kernel);
+  runLengthFilter->SetForegroundValue(2);
+  runLengthFilter->SetBackgroundValue(5);
+  runLengthFilter->SetBoundaryToForeground(boundaryToForeground);
+  runLengthFilter->RunLengthEncodingOn();
+  runLengthFilter->Update();
+
+  return ImagesAreEqual(filter->GetOutput(), runLengthFilter->GetOutput(), description);
+}
+
+template <typename TFilter>
+bool
+CompareOpeningClosing(const typename TFilter::InputImageType * image,
+                      const typename TFilter::KernelType &     kernel,
+                      const std::string &                      description)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetKernel(kernel);
+  filter->SetForegroundValue(2);
+  filter->Update();
+
+  auto runLengthFilter = TFilter::New();
+  runLengthFilter->SetInput(image);
+  runLengthFilter->SetKernel(kernel);
+  runLengthFilter->SetForegroundValue(2);
+  runLengthFilter->RunLengthEncodingOn();
+  runLengthFilter->Update();
+
+  return ImagesAreEqual(filter->GetOutput(), runLengthFilter->GetOutput(), description);
+}
+
+template <unsigned int VDimension>
+bool
+TestRunLengthEncoding(const typename itk::Image<unsigned char, VDimension>::SizeType & size)
+{
+  using ImageType = itk::Image<unsigned char, VDimension>;
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+
+  // sparse blobs of foreground (2) over a background made of two values
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  auto generator = GeneratorType::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double value = generator->GetVariate();
+    it.Set(value < 0.08 ? 2 : (value < 0.5 ? 0 : 1));
+  }
+
+  bool success = true;
+
+  typename KernelType::RadiusType radius;
+  for (unsigned int r = 1; r <= 7; r += 3)
+  {
+    radius.Fill(r);
+    radius[0] = r + 1;
+
+    std::vector<std::pair<KernelType, std::string>> kernels;
+    kernels.emplace_back(KernelType::Ball(radius), "ball");
+    kernels.emplace_back(KernelType::Box(radius), "box");
+    kernels.emplace_back(KernelType::Cross(radius), "cross");
+    kernels.emplace_back(KernelType::Annulus(radius, 1, false), "annulus");
+
+    for (const auto & kernel : kernels)
+    {
+      std::ostringstream description;
+      description << VDimension << "D " << kernel.second << " of radius " << radius;
+
+      for (bool boundaryToForeground : { false, true })
+      {
+        success &= CompareErodeDilate<itk::BinaryDilateImageFilter<ImageType, ImageType, KernelType>>(
+          image, kernel.first, boundaryToForeground, "dilation with " + description.str());
+        success &= CompareErodeDilate<itk::BinaryErodeImageFilter<ImageType, ImageType, KernelType>>(
+          image, kernel.first, boundaryToForeground, "erosion with " + description.str());
+      }
+      success &= CompareOpeningClosing<itk::BinaryMorphologicalOpeningImageFilter<ImageType, ImageType, KernelType>>(
+        image, kernel.first, "opening with " + description.str());
+      success &= CompareOpeningClosing<itk::BinaryMorphologicalClosingImageFilter<ImageType, ImageType, KernelType>>(
+        image, kernel.first, "closing with " + description.str());
+    }
+  }
+  return success;
+}
+
+} // namespace
+
+int
+itkBinaryMorphologyRunLengthEncodingTest(int, char *[])
+{
+  using FilterType =
+    itk::BinaryDilateImageFilter<itk::Image<unsigned char, 2>, itk::Image<unsigned char, 2>, itk::FlatStructuringElement<2>>;
+  auto filter = FilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN(filter, RunLengthEncoding, false);
+
+  bool success = true;
+
+  itk::Size<2> size2D = { { 67, 59 } };
+  success &= TestRunLengthEncoding<2>(size2D);
+
+  itk::Size<3> size3D = { { 25, 19, 14 } };
+  success &= TestRunLengthEncoding<3>(size3D);
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
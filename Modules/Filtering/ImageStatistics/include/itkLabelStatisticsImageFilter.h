@@ -44,7 +44,11 @@ namespace itk
  * object. If histograms are enabled, a median intensity value can
  * also be computed, although its accuracy is limited to the bin width
  * of the histogram. If histograms are not enabled, the median returns
- * zero.
+ * zero. While the filter runs, each thread counts the bins of the labels
+ * it meets in plain arrays, and the arrays of the threads are summed label
+ * by label, in parallel and without locking, after each streamed region.
+ * The histograms of the labels are only built once all the regions are
+ * merged.
  *
  * This filter is automatically multi-threaded and can stream its
  * input when NumberOfStreamDivisions is set to more than
@@ -110,6 +114,9 @@ public:
   using HistogramType = itk::Statistics::Histogram<RealType>;
   using HistogramPointer = typename HistogramType::Pointer;
 
+  /** Bin frequencies of a label, accumulated while the filter runs. */
+  using HistogramBinFrequenciesType = std::vector<typename HistogramType::AbsoluteFrequencyType>;
+
   /** \class LabelStatistics
    * \brief Statistics stored per label
    * \ingroup ITKImageStatistics
@@ -197,6 +204,7 @@ public:
       m_Variance = l.m_Variance;
       m_BoundingBox = l.m_BoundingBox;
       m_Histogram = l.m_Histogram;
+      m_BinFrequencies = l.m_BinFrequencies;
     }
 
     LabelStatistics(LabelStatistics &&) = default;
@@ -217,6 +225,7 @@ public:
         m_Variance = l.m_Variance;
         m_BoundingBox = l.m_BoundingBox;
         m_Histogram = l.m_Histogram;
+        m_BinFrequencies = l.m_BinFrequencies;
       }
       return *this;
     }
@@ -231,6 +240,7 @@ public:
     RealType                        m_Variance;
     BoundingBoxType                 m_BoundingBox;
     typename HistogramType::Pointer m_Histogram;
+    HistogramBinFrequenciesType     m_BinFrequencies;
   };
 
   /** Type of the map used to store data per label */
@@ -357,17 +367,18 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   void
-  BeforeStreamedGenerateData() override
-  {
-    this->AllocateOutputs();
-    m_LabelStatistics.clear();
-  }
+  BeforeStreamedGenerateData() override;
 
   /** Do final mean and variance computation from data accumulated in threads.
    */
   void
   AfterStreamedGenerateData() override;
 
+  /** Merge the statistics of the threads once a streamed region is
+   * processed. */
+  void
+  StreamedGenerateData(unsigned int inputRequestedRegionNumber) override;
+
   void
   ThreadedStreamedGenerateData(const RegionType &) override;
 
@@ -375,6 +386,11 @@ private:
   void
   MergeMap(MapType &, MapType &) const;
 
+  /** Merge m_ThreadStatistics into m_LabelStatistics. The bin frequencies
+   * are summed in parallel, each work unit adding those of its labels. */
+  void
+  MergeThreadStatistics();
+
   MapType                       m_LabelStatistics;
   ValidLabelValuesContainerType m_ValidLabelValues;
 
@@ -385,6 +401,13 @@ private:
   RealType m_LowerBound;
   RealType m_UpperBound;
 
+  /** Histogram only used to map intensities to bins while threading, the
+   * per label histograms are built once all the frequencies are merged. */
+  HistogramPointer m_BinningHistogram;
+
+  /** Statistics of the regions of the threads, waiting to be merged. */
+  std::vector<MapType> m_ThreadStatistics;
+
   std::mutex m_Mutex;
 
 }; // end of class
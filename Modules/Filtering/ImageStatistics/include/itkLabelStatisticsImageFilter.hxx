@@ -51,6 +51,28 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::SetHistogramParameters(con
 }
 
 
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::BeforeStreamedGenerateData()
+{
+  this->AllocateOutputs();
+  m_LabelStatistics.clear();
+  m_ThreadStatistics.clear();
+
+  m_BinningHistogram = nullptr;
+  if (m_UseHistograms)
+  {
+    typename HistogramType::MeasurementVectorType lb(1);
+    typename HistogramType::MeasurementVectorType ub(1);
+    lb[0] = m_LowerBound;
+    ub[0] = m_UpperBound;
+
+    m_BinningHistogram = HistogramType::New();
+    m_BinningHistogram->SetMeasurementVectorSize(1);
+    m_BinningHistogram->Initialize(m_NumBins, lb, ub);
+  }
+}
+
 template <typename TInputImage, typename TLabelImage>
 void
 LabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeMap(MapType & m1, MapType & m2) const
@@ -62,7 +84,7 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeMap(MapType & m1, Map
     auto m1It = m1.find(m2_value.first);
     if (m1It == m1.end())
     {
-      // move m2 entry into m1, this reuses the histogram if needed.
+      // move m2 entry into m1, this reuses the bin frequencies if needed.
       m1.emplace(m2_value.first, std::move(m2_value.second));
     }
     else
@@ -98,19 +120,63 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeMap(MapType & m1, Map
         }
       }
 
-      // if enabled, update the histogram for this label
-      if (m_UseHistograms)
-      {
-        typename HistogramType::IndexType index;
-        index.SetSize(1);
-        for (unsigned int bin = 0; bin < m_NumBins[0]; bin++)
+      // the bin frequencies are summed by MergeThreadStatistics()
+    }
+  }
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::StreamedGenerateData(unsigned int inputRequestedRegionNumber)
+{
+  Superclass::StreamedGenerateData(inputRequestedRegionNumber);
+
+  this->MergeThreadStatistics();
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeThreadStatistics()
+{
+  // the entries of the labels new to m_LabelStatistics are moved with their
+  // bin frequencies, the other entries keep theirs in m_ThreadStatistics
+  for (auto & threadStatistics : m_ThreadStatistics)
+  {
+    MergeMap(m_LabelStatistics, threadStatistics);
+  }
+
+  if (m_UseHistograms)
+  {
+    std::vector<typename MapType::value_type *> labels;
+    labels.reserve(m_LabelStatistics.size());
+    for (auto & mapValue : m_LabelStatistics)
+    {
+      labels.push_back(&mapValue);
+    }
+
+    // each label is only written by one work unit
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      labels.size(),
+      [this, &labels](SizeValueType i) {
+        HistogramBinFrequenciesType & binFrequencies = labels[i]->second.m_BinFrequencies;
+        for (const auto & threadStatistics : m_ThreadStatistics)
         {
-          index[0] = bin;
-          labelStats.m_Histogram->IncreaseFrequency(bin, m2_value.second.m_Histogram->GetFrequency(bin));
+          const auto threadIt = threadStatistics.find(labels[i]->first);
+          if (threadIt != threadStatistics.end() && !threadIt->second.m_BinFrequencies.empty())
+          {
+            const HistogramBinFrequenciesType & threadBinFrequencies = threadIt->second.m_BinFrequencies;
+            for (size_t bin = 0; bin < binFrequencies.size(); ++bin)
+            {
+              binFrequencies[bin] += threadBinFrequencies[bin];
+            }
+          }
         }
-      }
-    }
+      },
+      nullptr);
   }
+
+  m_ThreadStatistics.clear();
 }
 
 template <typename TInputImage, typename TLabelImage>
@@ -119,6 +185,11 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterStreamedGenerateData(
 {
   Superclass::AfterStreamedGenerateData();
 
+  typename HistogramType::MeasurementVectorType lb(1);
+  typename HistogramType::MeasurementVectorType ub(1);
+  lb[0] = m_LowerBound;
+  ub[0] = m_UpperBound;
+
   // compute the remainder of the statistics
   for (auto & mapValue : m_LabelStatistics)
   {
@@ -147,6 +218,20 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterStreamedGenerateData(
     {
       labelStats.m_Sigma = std::sqrt(labelStats.m_Variance);
     }
+
+    // build the histogram from the merged bin frequencies
+    if (m_UseHistograms)
+    {
+      labelStats.m_Histogram = HistogramType::New();
+      labelStats.m_Histogram->SetMeasurementVectorSize(1);
+      labelStats.m_Histogram->Initialize(m_NumBins, lb, ub);
+      for (size_t bin = 0; bin < labelStats.m_BinFrequencies.size(); ++bin)
+      {
+        labelStats.m_Histogram->SetFrequency(static_cast<typename HistogramType::InstanceIdentifier>(bin),
+                                             labelStats.m_BinFrequencies[bin]);
+      }
+      HistogramBinFrequenciesType().swap(labelStats.m_BinFrequencies);
+    }
   }
 
   {
@@ -192,18 +277,20 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateDa
 
       const LabelPixelType & label = labelIt.Get();
 
-      // is the label already in this thread?
-      mapIt = localStatistics.find(label);
-      if (mapIt == localStatistics.end())
+      // neighboring pixels usually share their label, only look the map up
+      // when the label changes
+      if (mapIt == localStatistics.end() || mapIt->first != label)
       {
-        // create a new statistics object
-        if (m_UseHistograms)
-        {
-          mapIt = localStatistics.emplace(label, LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound)).first;
-        }
-        else
+        // is the label already in this thread?
+        mapIt = localStatistics.find(label);
+        if (mapIt == localStatistics.end())
         {
+          // create a new statistics object
           mapIt = localStatistics.emplace(label, LabelStatistics()).first;
+          if (m_UseHistograms)
+          {
+            mapIt->second.m_BinFrequencies.resize(m_NumBins[0], 0);
+          }
         }
       }
 
@@ -241,8 +328,10 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateDa
       if (m_UseHistograms)
       {
         histogramMeasurement[0] = value;
-        labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
-        labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        if (m_BinningHistogram->GetIndex(histogramMeasurement, histogramIndex))
+        {
+          ++labelStats.m_BinFrequencies[histogramIndex[0]];
+        }
       }
 
 
@@ -254,33 +343,9 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateDa
   }
 
 
-  // Merge localStatistics and m_LabelStatistics concurrently safe in a
-  // local copy, this thread may do multiple merges.
-  while (true)
-  {
-
-    {
-      std::unique_lock<std::mutex> lock(m_Mutex);
-
-      if (m_LabelStatistics.empty())
-      {
-        swap(m_LabelStatistics, localStatistics);
-        break;
-      }
-      else
-      {
-        // copy the output map to thread local storage
-        MapType tomerge;
-        swap(m_LabelStatistics, tomerge);
-
-        // allow other threads to merge data
-        lock.unlock();
-
-        // Merge tomerge into localStatistics, locally
-        MergeMap(localStatistics, tomerge);
-      }
-    } // release lock
-  }
+  // hand the statistics of this region over to MergeThreadStatistics()
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_ThreadStatistics.push_back(std::move(localStatistics));
 }
 
 template <typename TInputImage, typename TLabelImage>
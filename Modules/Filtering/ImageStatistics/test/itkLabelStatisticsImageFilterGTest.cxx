@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLabelStatisticsImageFilter.h"
+
+#include <map>
+#include <vector>
+
+namespace
+{
+
+class LabelStatisticsFixture : public ::testing::Test
+{
+public:
+  LabelStatisticsFixture() = default;
+  ~LabelStatisticsFixture() override = default;
+
+protected:
+  static const unsigned int Dimension = 2;
+  using ImageType = itk::Image<unsigned char, Dimension>;
+  using LabelImageType = itk::Image<unsigned short, Dimension>;
+  using FilterType = itk::LabelStatisticsImageFilter<ImageType, LabelImageType>;
+
+  void
+  SetUp() override
+  {
+    ImageType::SizeType size;
+    size.Fill(m_ImageSize);
+    const ImageType::RegionType region(size);
+
+    m_Image = ImageType::New();
+    m_Image->SetRegions(region);
+    m_Image->Allocate();
+
+    m_LabelImage = LabelImageType::New();
+    m_LabelImage->SetRegions(region);
+    m_LabelImage->Allocate();
+
+    // Labels are vertical bands four pixels wide, intensities ramp along the
+    // second axis so that every label spans many bins.
+    itk::ImageRegionIteratorWithIndex<ImageType> it(m_Image, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const ImageType::IndexType & index = it.GetIndex();
+      it.Set(static_cast<unsigned char>((3 * index[1] + index[0]) % 256));
+      m_LabelImage->SetPixel(index, static_cast<unsigned short>(index[0] / 4));
+    }
+  }
+
+  // Expected frequencies for bins of width 16 over [32, 224], the upper
+  // bound being in the last bin as in Histogram::GetIndex
+  std::map<unsigned short, std::vector<double>>
+  ComputeExpectedFrequencies() const
+  {
+    std::map<unsigned short, std::vector<double>> frequencies;
+
+    itk::ImageRegionConstIteratorWithIndex<ImageType> it(m_Image, m_Image->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      std::vector<double> & labelFrequencies = frequencies[m_LabelImage->GetPixel(it.GetIndex())];
+      labelFrequencies.resize(m_NumberOfBins, 0.0);
+      const int value = it.Get();
+      if (value >= 32 && value < 224)
+      {
+        labelFrequencies[(value - 32) / 16] += 1.0;
+      }
+      else if (value == 224)
+      {
+        labelFrequencies[m_NumberOfBins - 1] += 1.0;
+      }
+    }
+    return frequencies;
+  }
+
+  void
+  CheckHistograms(FilterType * filter) const
+  {
+    const auto         expected = ComputeExpectedFrequencies();
+    const unsigned int numberOfBins = m_NumberOfBins;
+
+    EXPECT_EQ(filter->GetNumberOfLabels(), expected.size());
+    for (const auto & labelFrequencies : expected)
+    {
+      ASSERT_TRUE(filter->HasLabel(labelFrequencies.first));
+      FilterType::HistogramPointer histogram = filter->GetHistogram(labelFrequencies.first);
+      ASSERT_NE(histogram.GetPointer(), nullptr);
+      ASSERT_EQ(histogram->GetSize(0), numberOfBins);
+
+      double total = 0.0;
+      for (unsigned int bin = 0; bin < numberOfBins; ++bin)
+      {
+        EXPECT_EQ(histogram->GetFrequency(bin), labelFrequencies.second[bin])
+          << "label " << labelFrequencies.first << " bin " << bin;
+        total += labelFrequencies.second[bin];
+      }
+      EXPECT_EQ(histogram->GetTotalFrequency(), total);
+    }
+  }
+
+  ImageType::Pointer      m_Image;
+  LabelImageType::Pointer m_LabelImage;
+
+  static const itk::SizeValueType m_ImageSize{ 64 };
+  static const unsigned int       m_NumberOfBins{ 12 };
+};
+
+} // namespace
+
+
+TEST_F(LabelStatisticsFixture, Histograms)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(m_Image);
+  filter->SetLabelInput(m_LabelImage);
+  filter->SetHistogramParameters(m_NumberOfBins, 32, 224);
+  filter->Update();
+
+  CheckHistograms(filter);
+}
+
+
+TEST_F(LabelStatisticsFixture, StreamedHistograms)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(m_Image);
+  filter->SetLabelInput(m_LabelImage);
+  filter->SetHistogramParameters(m_NumberOfBins, 32, 224);
+  filter->SetNumberOfStreamDivisions(7);
+  filter->Update();
+
+  CheckHistograms(filter);
+}
+
+
+TEST_F(LabelStatisticsFixture, NoHistograms)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(m_Image);
+  filter->SetLabelInput(m_LabelImage);
+  filter->Update();
+
+  EXPECT_EQ(filter->GetNumberOfLabels(), m_ImageSize / 4);
+  for (unsigned short label = 0; label < m_ImageSize / 4; ++label)
+  {
+    EXPECT_EQ(filter->GetCount(label), 4 * m_ImageSize);
+    EXPECT_EQ(filter->GetHistogram(label).GetPointer(), nullptr);
+    EXPECT_EQ(filter->GetMedian(label), 0.0);
+  }
+}
+
+
+TEST_F(LabelStatisticsFixture, LabelStatisticsWithHistogram)
+{
+  const unsigned int                numberOfBins = m_NumberOfBins;
+  const FilterType::LabelStatistics statistics(numberOfBins, 32, 224);
+
+  ASSERT_NE(statistics.m_Histogram.GetPointer(), nullptr);
+  EXPECT_EQ(statistics.m_Histogram->GetSize(0), numberOfBins);
+  EXPECT_EQ(statistics.m_Histogram->GetBinMin(0, 0), 32);
+  EXPECT_EQ(statistics.m_Histogram->GetBinMax(0, numberOfBins - 1), 224);
+  EXPECT_EQ(statistics.m_Count, 0u);
+}
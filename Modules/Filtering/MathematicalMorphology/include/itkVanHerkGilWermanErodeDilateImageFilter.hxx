@@ -102,10 +102,31 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
       ++SELength;
     }
 
-    InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
+    // lines along an image axis don't need the Bresenham walk and can be
+    // processed several at a time
+    unsigned int lineAxis = 0;
+    unsigned int nonZeroComponents = 0;
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      if (Math::NotExactlyEquals(ThisLine[d], 0))
+      {
+        lineAxis = d;
+        ++nonZeroComponents;
+      }
+    }
 
-    DoFace<TImage, BresType, TFunction1, KernelLType>(
-      input, output, m_Boundary, ThisLine, TheseOffsets, SELength, buffer, forward, reverse, IReg, BigFace);
+    if (nonZeroComponents == 1)
+    {
+      DoAxisAlignedLines<TImage, TFunction1>(
+        input.GetPointer(), output.GetPointer(), m_Boundary, lineAxis, SELength, IReg);
+    }
+    else
+    {
+      InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
+
+      DoFace<TImage, BresType, TFunction1, KernelLType>(
+        input, output, m_Boundary, ThisLine, TheseOffsets, SELength, buffer, forward, reverse, IReg, BigFace);
+    }
 
     // after the first pass the input will be taken from the output
     input = internalbuffer;
@@ -58,6 +58,20 @@ DoFace(typename TImage::ConstPointer             input,
        std::vector<typename TImage::PixelType> & rExtBuffer,
        const typename TImage::RegionType         AllImage,
        const typename TImage::RegionType         face);
+
+/** Process all the lines of the region that run along an image axis. The
+ * lines are handled in groups, laid out in contiguous buffers where each
+ * line is a lane, so that the inner loops run over many lines at once and
+ * can be vectorized. Lines along the first axis are transposed into the
+ * group buffers. */
+template <typename TImage, typename TFunction>
+void
+DoAxisAlignedLines(const TImage *                    input,
+                   TImage *                          output,
+                   typename TImage::PixelType        border,
+                   const unsigned int                axis,
+                   const unsigned int                KernLen,
+                   const typename TImage::RegionType AllImage);
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
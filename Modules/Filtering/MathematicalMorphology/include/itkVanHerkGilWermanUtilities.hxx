@@ -22,6 +22,8 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
+#include <algorithm>
+#include <memory>
 
 namespace itk
 {
@@ -216,6 +218,155 @@ DoFace(typename TImage::ConstPointer             input,
   }
 }
 
+template <typename TImage, typename TFunction>
+void
+DoAxisAlignedLines(const TImage *                    input,
+                   TImage *                          output,
+                   typename TImage::PixelType        border,
+                   const unsigned int                axis,
+                   const unsigned int                KernLen,
+                   const typename TImage::RegionType AllImage)
+{
+  using PixelType = typename TImage::PixelType;
+  using IndexType = typename TImage::IndexType;
+  using RegionType = typename TImage::RegionType;
+
+  constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  // maximum number of lines processed together
+  constexpr SizeValueType MaximumNumberOfLanes = 64;
+
+  // the lines of a group are consecutive along another axis, the first one
+  // when possible so that loading and storing them is contiguous
+  unsigned int  laneAxis = axis;
+  SizeValueType numberOfLanes = 1;
+  if (ImageDimension > 1)
+  {
+    laneAxis = (axis == 0) ? 1 : 0;
+    numberOfLanes = std::min(AllImage.GetSize(laneAxis), MaximumNumberOfLanes);
+  }
+
+  // each line is padded with a border pixel at both ends, as in DoFace
+  const SizeValueType lineLength = AllImage.GetSize(axis);
+  const SizeValueType size = lineLength + 2;
+  const SizeValueType halfKernLen = KernLen / 2;
+
+  // plain arrays rather than std::vector, which isn't contiguous for bool
+  const std::unique_ptr<PixelType[]> pixbuffer(new PixelType[size * numberOfLanes]);
+  const std::unique_ptr<PixelType[]> fExtBuffer(new PixelType[size * numberOfLanes]);
+  const std::unique_ptr<PixelType[]> rExtBuffer(new PixelType[size * numberOfLanes]);
+
+  const OffsetValueType inAxisStride = input->GetOffsetTable()[axis];
+  const OffsetValueType inLaneStride = input->GetOffsetTable()[laneAxis];
+  const OffsetValueType outAxisStride = output->GetOffsetTable()[axis];
+  const OffsetValueType outLaneStride = output->GetOffsetTable()[laneAxis];
+
+  // region holding the first pixel of each group of lines
+  RegionType groups = AllImage;
+  groups.SetSize(axis, 1);
+  if (laneAxis != axis)
+  {
+    groups.SetSize(laneAxis, (AllImage.GetSize(laneAxis) + numberOfLanes - 1) / numberOfLanes);
+  }
+
+  typename TImage::Pointer dumbImg = TImage::New();
+  dumbImg->SetRegions(groups);
+
+  TFunction m_TF;
+  for (SizeValueType it = 0; it < groups.GetNumberOfPixels(); ++it)
+  {
+    IndexType     start = dumbImg->ComputeIndex(it);
+    SizeValueType lanes = 1;
+    if (laneAxis != axis)
+    {
+      start[laneAxis] = AllImage.GetIndex(laneAxis) + (start[laneAxis] - groups.GetIndex(laneAxis)) * numberOfLanes;
+      lanes = std::min(numberOfLanes, AllImage.GetIndex(laneAxis) + AllImage.GetSize(laneAxis) - start[laneAxis]);
+    }
+
+    // load the lines, one lane per line
+    const PixelType * inLine = input->GetBufferPointer() + input->ComputeOffset(start);
+    for (SizeValueType l = 0; l < lanes; ++l)
+    {
+      pixbuffer[l] = border;
+      pixbuffer[(size - 1) * numberOfLanes + l] = border;
+    }
+    for (SizeValueType j = 0; j < lineLength; ++j)
+    {
+      PixelType *       row = &pixbuffer[(j + 1) * numberOfLanes];
+      const PixelType * in = inLine + j * inAxisStride;
+      for (SizeValueType l = 0; l < lanes; ++l)
+      {
+        row[l] = in[l * inLaneStride];
+      }
+    }
+
+    // forward and reverse extremes over blocks of KernLen pixels
+    for (SizeValueType j = 0; j < size; ++j)
+    {
+      const PixelType * row = &pixbuffer[j * numberOfLanes];
+      PixelType *       fExt = &fExtBuffer[j * numberOfLanes];
+      if (j % KernLen == 0)
+      {
+        std::copy(row, row + lanes, fExt);
+      }
+      else
+      {
+        const PixelType * previous = fExt - numberOfLanes;
+        for (SizeValueType l = 0; l < lanes; ++l)
+        {
+          fExt[l] = m_TF(row[l], previous[l]);
+        }
+      }
+    }
+    for (SizeValueType j = size; j-- > 0;)
+    {
+      const PixelType * row = &pixbuffer[j * numberOfLanes];
+      PixelType *       rExt = &rExtBuffer[j * numberOfLanes];
+      if (j == size - 1 || (j + 1) % KernLen == 0)
+      {
+        std::copy(row, row + lanes, rExt);
+      }
+      else
+      {
+        const PixelType * next = rExt + numberOfLanes;
+        for (SizeValueType l = 0; l < lanes; ++l)
+        {
+          rExt[l] = m_TF(row[l], next[l]);
+        }
+      }
+    }
+
+    // the extreme over [j - KernLen / 2, j + KernLen / 2], clipped to the
+    // padded line, spans at most two blocks
+    PixelType * outLine = output->GetBufferPointer() + output->ComputeOffset(start);
+    for (SizeValueType j = 1; j <= lineLength; ++j)
+    {
+      const SizeValueType first = (j > halfKernLen) ? j - halfKernLen : 0;
+      const SizeValueType last = std::min(size - 1, j + halfKernLen);
+      const PixelType *   fExt = &fExtBuffer[last * numberOfLanes];
+      const PixelType *   rExt = &rExtBuffer[first * numberOfLanes];
+      PixelType *         out = outLine + (j - 1) * outAxisStride;
+
+      if (first / KernLen != last / KernLen)
+      {
+        for (SizeValueType l = 0; l < lanes; ++l)
+        {
+          out[l * outLaneStride] = m_TF(fExt[l], rExt[l]);
+        }
+      }
+      else
+      {
+        // the window is clipped and fits in a single block
+        const PixelType * extreme = (first % KernLen == 0) ? fExt : rExt;
+        for (SizeValueType l = 0; l < lanes; ++l)
+        {
+          out[l * outLaneStride] = extreme[l];
+        }
+      }
+    }
+  }
+}
+
 } // namespace itk
 
 #endif
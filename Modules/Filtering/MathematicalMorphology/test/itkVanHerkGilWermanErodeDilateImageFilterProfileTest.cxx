@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTimeProbesCollectorBase.h"
+#include "itkTestingMacros.h"
+
+#include <sstream>
+#include <string>
+
+// Times the grayscale dilation of boxes across radii with the van
+// Herk/Gil-Werman algorithm, whose axis aligned lines are processed in groups,
+// and with the anchor and basic algorithms for comparison. The van
+// Herk/Gil-Werman and anchor outputs must be the same. The images are small
+// by default; the sizes given as arguments profile larger ones.
+
+namespace
+{
+
+template <unsigned int VDimension>
+int
+ProfileVanHerkGilWerman(const typename itk::Image<unsigned char, VDimension>::SizeType & size,
+                        unsigned int                                                     maximumBasicRadius,
+                        itk::TimeProbesCollectorBase &                                   chronometer)
+{
+  using ImageType = itk::Image<unsigned char, VDimension>;
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+  using FilterType = itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  auto generator = GeneratorType::New();
+  generator->Initialize(2021);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<unsigned char>(generator->GetIntegerVariate(255)));
+  }
+
+  int testStatus = EXIT_SUCCESS;
+
+  const unsigned int radii[] = { 1, 2, 4, 8, 16, 32 };
+  for (unsigned int r : radii)
+  {
+    typename KernelType::RadiusType radius;
+    radius.Fill(r);
+    const KernelType box = KernelType::Box(radius);
+
+    auto vhgw = FilterType::New();
+    vhgw->SetInput(image);
+    vhgw->SetKernel(box);
+    vhgw->SetAlgorithm(FilterType::AlgorithmEnum::VHGW);
+
+    auto anchor = FilterType::New();
+    anchor->SetInput(image);
+    anchor->SetKernel(box);
+    anchor->SetAlgorithm(FilterType::AlgorithmEnum::ANCHOR);
+
+    std::ostringstream suffix;
+    suffix << VDimension << "D r=" << r;
+
+    chronometer.Start(("VHGW " + suffix.str()).c_str());
+    vhgw->Update();
+    chronometer.Stop(("VHGW " + suffix.str()).c_str());
+
+    chronometer.Start(("ANCHOR " + suffix.str()).c_str());
+    anchor->Update();
+    chronometer.Stop(("ANCHOR " + suffix.str()).c_str());
+
+    if (r <= maximumBasicRadius)
+    {
+      auto basic = FilterType::New();
+      basic->SetInput(image);
+      basic->SetKernel(box);
+      basic->SetAlgorithm(FilterType::AlgorithmEnum::BASIC);
+
+      chronometer.Start(("BASIC " + suffix.str()).c_str());
+      basic->Update();
+      chronometer.Stop(("BASIC " + suffix.str()).c_str());
+    }
+
+    itk::ImageRegionConstIterator<ImageType> it1(vhgw->GetOutput(), image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> it2(anchor->GetOutput(), image->GetLargestPossibleRegion());
+    for (; !it1.IsAtEnd(); ++it1, ++it2)
+    {
+      if (it1.Get() != it2.Get())
+      {
+        std::cerr << "Mismatch for radius " << r << " at " << it1.GetIndex() << ": " << static_cast<int>(it1.Get())
+                  << " != " << static_cast<int>(it2.Get()) << std::endl;
+        testStatus = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  return testStatus;
+}
+
+} // namespace
+
+int
+itkVanHerkGilWermanErodeDilateImageFilterProfileTest(int argc, char * argv[])
+{
+  if (argc != 1 && argc != 3)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " [size2D size3D]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const itk::SizeValueType size2DValue = argc == 3 ? std::stoul(argv[1]) : 128;
+  const itk::SizeValueType size3DValue = argc == 3 ? std::stoul(argv[2]) : 32;
+
+  itk::TimeProbesCollectorBase chronometer;
+
+  int testStatus = EXIT_SUCCESS;
+
+  const auto size2D = itk::Size<2>::Filled(size2DValue);
+  if (ProfileVanHerkGilWerman<2>(size2D, 4, chronometer) == EXIT_FAILURE)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+
+  const auto size3D = itk::Size<3>::Filled(size3DValue);
+  if (ProfileVanHerkGilWerman<3>(size3D, 2, chronometer) == EXIT_FAILURE)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+
+  chronometer.Report(std::cout);
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+template <typename TImage>
+bool
+ImagesAreEqual(const TImage * image1, const TImage * image2)
+{
+  itk::ImageRegionConstIteratorWithIndex<TImage> it1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIteratorWithIndex<TImage> it2(image2, image2->GetLargestPossibleRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      std::cerr << "Mismatch at " << it1.GetIndex() << ": " << static_cast<int>(it1.Get())
+                << " != " << static_cast<int>(it2.Get()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compare the van Herk/Gil-Werman result against another algorithm
+template <typename TFilter>
+bool
+CompareWith(const typename TFilter::InputImageType * input,
+            const typename TFilter::KernelType &     kernel,
+            typename TFilter::AlgorithmEnum          algorithm)
+{
+  auto reference = TFilter::New();
+  reference->SetInput(input);
+  reference->SetKernel(kernel);
+  reference->SetAlgorithm(algorithm);
+  reference->Update();
+
+  auto vhgw = TFilter::New();
+  vhgw->SetInput(input);
+  vhgw->SetKernel(kernel);
+  vhgw->SetAlgorithm(TFilter::AlgorithmEnum::VHGW);
+  vhgw->Update();
+
+  return ImagesAreEqual(reference->GetOutput(), vhgw->GetOutput());
+}
+
+template <unsigned int VDimension>
+int
+TestVanHerkGilWerman(const typename itk::Image<unsigned char, VDimension>::SizeType & size)
+{
+  using ImageType = itk::Image<unsigned char, VDimension>;
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+  using DilateType = itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>;
+  using ErodeType = itk::GrayscaleErodeImageFilter<ImageType, ImageType, KernelType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  auto generator = GeneratorType::New();
+  generator->Initialize(2021);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<unsigned char>(generator->GetIntegerVariate(255)));
+  }
+
+  int testStatus = EXIT_SUCCESS;
+
+  // boxes are decomposed in lines along the image axes; the last radius is
+  // larger than the image
+  const unsigned int radii[] = { 1, 2, 5, 14 };
+  for (unsigned int r : radii)
+  {
+    typename KernelType::RadiusType radius;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      radius[d] = r + d;
+    }
+    const KernelType box = KernelType::Box(radius);
+    if (!CompareWith<DilateType>(image, box, DilateType::AlgorithmEnum::BASIC) ||
+        !CompareWith<ErodeType>(image, box, ErodeType::AlgorithmEnum::BASIC))
+    {
+      std::cerr << "Test failed for box of radius " << radius << std::endl;
+      testStatus = EXIT_FAILURE;
+    }
+  }
+
+  // polygons mix axis aligned and oblique lines; the decomposition only
+  // approximates the polygon, so the reference is the anchor algorithm which
+  // uses the same lines
+  if (VDimension == 2 || VDimension == 3)
+  {
+    typename KernelType::RadiusType radius;
+    radius.Fill(4);
+    const KernelType polygon = KernelType::Polygon(radius, VDimension == 2 ? 3 : 6);
+    if (!CompareWith<DilateType>(image, polygon, DilateType::AlgorithmEnum::ANCHOR) ||
+        !CompareWith<ErodeType>(image, polygon, ErodeType::AlgorithmEnum::ANCHOR))
+    {
+      std::cerr << "Test failed for polygon of radius " << radius << std::endl;
+      testStatus = EXIT_FAILURE;
+    }
+  }
+
+  return testStatus;
+}
+
+} // namespace
+
+int
+itkVanHerkGilWermanErodeDilateImageFilterTest(int, char *[])
+{
+  int testStatus = EXIT_SUCCESS;
+
+  itk::Size<1> size1D = { { 27 } };
+  if (TestVanHerkGilWerman<1>(size1D) == EXIT_FAILURE)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+
+  itk::Size<2> size2D = { { 71, 23 } };
+  if (TestVanHerkGilWerman<2>(size2D) == EXIT_FAILURE)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+
+  itk::Size<3> size3D = { { 23, 9, 70 } };
+  if (TestVanHerkGilWerman<3>(size3D) == EXIT_FAILURE)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
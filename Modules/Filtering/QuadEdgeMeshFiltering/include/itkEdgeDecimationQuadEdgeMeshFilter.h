@@ -21,11 +21,14 @@
 #include <list>
 #include <map>
 #include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 #include "itkQuadEdgeMeshEulerOperatorJoinVertexFunction.h"
 #include "itkQuadEdgeMeshPolygonCell.h"
 
 #include "itkDecimationQuadEdgeMeshFilter.h"
+#include "itkMultiThreaderBase.h"
 #include "itkPriorityQueueContainer.h"
 #include "itkTriangleHelper.h"
 
@@ -34,6 +37,30 @@ namespace itk
 /**
  * \class EdgeDecimationQuadEdgeMeshFilter
  * \brief
+ *
+ * By default the edges are collapsed one at a time, in the order given by a
+ * priority queue which is updated after each collapse. When
+ * ParallelDecimation is on, the edges are instead collapsed in rounds: the
+ * measures and the new locations of the edges whose points were modified by
+ * the previous round are computed in parallel, then among the edges of
+ * lowest measure (a fraction CandidateFraction of all the edges) a maximal
+ * set of independent edges is selected in increasing order of measure, and
+ * these edges are collapsed. Two edges are independent when none of the
+ * vertices of one is a vertex or a neighbor of a vertex of the other, so that
+ * collapsing one of them does not change the faces, the measure or the new
+ * location of the other. The rounds are repeated until the criterion is
+ * satisfied, or until no edge can be collapsed. In this mode, MeasureEdge()
+ * and Relocate() are called concurrently, and must not modify the filter.
+ *
+ * ParallelDecimation trades the quality of the output for speed: the edges
+ * collapsed in a round are not measured again after the previous collapses of
+ * the round, so the output is not the one of the priority queue, and usually
+ * approximates the input surface less closely. For instance, when the quadric
+ * decimation reduces a regular sphere of 2048 faces to 500 faces, the mean
+ * distance of the output points to the sphere is about 3.5 times larger than
+ * with the priority queue. Use the default mode when the quality of the
+ * approximation matters more than the time.
+ *
  * \ingroup ITKQuadEdgeMeshFiltering
  */
 template <typename TInput, typename TOutput, typename TCriterion>
@@ -86,6 +113,20 @@ public:
   using OperatorType = QuadEdgeMeshEulerOperatorJoinVertexFunction<OutputMeshType, OutputQEType>;
   using OperatorPointer = typename OperatorType::Pointer;
 
+  /** Collapse independent edges in rounds, computing the measures and the
+   * new locations of the edges in parallel. Off by default. */
+  itkSetMacro(ParallelDecimation, bool);
+  itkGetConstMacro(ParallelDecimation, bool);
+  itkBooleanMacro(ParallelDecimation);
+
+  /** Fraction of the edges, of lowest measure, among which the edges
+   * collapsed in a round of parallel decimation are selected, not counting
+   * the edges which cannot be collapsed without changing the topology of the
+   * mesh. Lower values mean more rounds, but they do not make the output much
+   * closer to the one of the priority queue. Default is 0.25. */
+  itkSetClampMacro(CandidateFraction, double, 0.0, 1.0);
+  itkGetConstMacro(CandidateFraction, double);
+
 protected:
   EdgeDecimationQuadEdgeMeshFilter();
   ~EdgeDecimationQuadEdgeMeshFilter() override;
@@ -93,6 +134,18 @@ protected:
   bool m_Relocate{ true };
   bool m_CheckOrientation{ false };
 
+  bool   m_ParallelDecimation{ false };
+  double m_CandidateFraction{ 0.25 };
+
+  /** Measure and new location of an edge, kept between the rounds of
+   * parallel decimation until the points of the edge are modified. */
+  struct EdgeCollapseType
+  {
+    MeasureType     m_Measure{};
+    OutputPointType m_Location{};
+  };
+  std::unordered_map<OutputQEType *, EdgeCollapseType> m_EdgeCollapses;
+
   PriorityQueuePointer m_PriorityQueue;
   QueueMapType         m_QueueMapper;
   OutputQEType *       m_Element;
@@ -107,6 +160,16 @@ protected:
   virtual MeasureType
   MeasureEdge(OutputQEType * iEdge) = 0;
 
+  void
+  GenerateData() override;
+
+  /**
+   * \brief Collapse a maximal set of independent edges of lowest measure
+   * \return true if edges were collapsed and the criterion is not satisfied
+   */
+  bool
+  CollapseIndependentEdges();
+
   /**
    * \brief Fill the priority queue
    */
@@ -308,6 +371,9 @@ protected:
    */
   bool
   IsCriterionSatisfied() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
 };
 } // namespace itk
 
@@ -20,6 +20,9 @@
 
 #include "itkEdgeDecimationQuadEdgeMeshFilter.h"
 
+#include <cmath>
+#include <numeric>
+
 namespace itk
 {
 template <typename TInput, typename TOutput, typename TCriterion>
@@ -48,6 +51,222 @@ EdgeDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::~EdgeDecimationQu
   }
 }
 
+template <typename TInput, typename TOutput, typename TCriterion>
+void
+EdgeDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::GenerateData()
+{
+  if (!m_ParallelDecimation)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  this->CopyInputMeshToOutputMesh();
+
+  this->Initialize();
+  this->m_OutputMesh = this->GetOutput();
+  m_JoinVertexFunction->SetInput(this->m_OutputMesh);
+  this->m_Iteration = 0;
+
+  while (this->CollapseIndependentEdges())
+  {
+  }
+  m_EdgeCollapses.clear();
+
+  this->GetOutput()->SqueezePointsIds();
+  this->GetOutput()->DeleteUnusedCellData();
+}
+
+template <typename TInput, typename TOutput, typename TCriterion>
+bool
+EdgeDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::CollapseIndependentEdges()
+{
+  OutputMeshType * output = this->m_OutputMesh;
+
+  // Gather the edges, oriented from their lowest point identifier as in
+  // PushElement(), and their points, which are checked before the edges,
+  // that the collapses may have deleted, are accessed.
+  using EdgePointsType = std::pair<OutputPointIdentifier, OutputPointIdentifier>;
+
+  std::vector<OutputQEType *> edges;
+  std::vector<EdgePointsType> edgePoints;
+  std::vector<OutputQEType *> outdated;
+  edges.reserve(output->GetNumberOfEdges());
+  edgePoints.reserve(output->GetNumberOfEdges());
+  OutputPointIdentifier maxId = 0;
+
+  OutputCellsContainerIterator it = output->GetEdgeCells()->Begin();
+  OutputCellsContainerIterator end = output->GetEdgeCells()->End();
+
+  while (it != end)
+  {
+    auto * edge = dynamic_cast<OutputEdgeCellType *>(it.Value());
+    if (edge)
+    {
+      OutputQEType * qe = edge->GetQEGeom();
+      if (qe->GetOrigin() > qe->GetDestination())
+      {
+        qe = qe->GetSym();
+      }
+      edges.push_back(qe);
+      edgePoints.emplace_back(qe->GetOrigin(), qe->GetDestination());
+      maxId = std::max(maxId, qe->GetDestination());
+
+      if (m_EdgeCollapses.find(qe) == m_EdgeCollapses.end())
+      {
+        outdated.push_back(qe);
+      }
+    }
+    ++it;
+  }
+
+  const auto numberOfEdges = static_cast<SizeValueType>(edges.size());
+  if (numberOfEdges == 0)
+  {
+    return false;
+  }
+
+  // Only the edges whose points were modified by the previous round are
+  // measured again.
+  std::vector<EdgeCollapseType> collapses(outdated.size());
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->ParallelizeArray(
+    0,
+    static_cast<SizeValueType>(outdated.size()),
+    [this, &outdated, &collapses](SizeValueType i) {
+      collapses[i].m_Measure = this->MeasureEdge(outdated[i]);
+      if (m_Relocate)
+      {
+        collapses[i].m_Location = this->Relocate(outdated[i]);
+      }
+    },
+    nullptr);
+
+  for (size_t i = 0; i < outdated.size(); ++i)
+  {
+    m_EdgeCollapses[outdated[i]] = collapses[i];
+  }
+
+  std::vector<MeasureType> measures(numberOfEdges);
+  for (SizeValueType i = 0; i < numberOfEdges; ++i)
+  {
+    measures[i] = m_EdgeCollapses[edges[i]].m_Measure;
+  }
+
+  // Sort the candidates, the edges of lowest measure. Ties are broken by the
+  // order of the edges, so that the result does not depend on the threads.
+  std::vector<SizeValueType> order(numberOfEdges);
+  std::iota(order.begin(), order.end(), SizeValueType{ 0 });
+
+  const auto lowerMeasure = [&measures](SizeValueType a, SizeValueType b) {
+    return (measures[a] < measures[b]) || (!(measures[b] < measures[a]) && a < b);
+  };
+
+  const auto numberOfCandidates = std::min(
+    numberOfEdges,
+    std::max(SizeValueType{ 1 }, static_cast<SizeValueType>(std::ceil(m_CandidateFraction * numberOfEdges))));
+  auto lastCandidate = order.begin() + numberOfCandidates;
+
+  std::nth_element(order.begin(), lastCandidate, order.end(), lowerMeasure);
+  std::sort(order.begin(), lastCandidate, lowerMeasure);
+
+  // Greedy maximal independent set among the candidates: collapsing an edge
+  // locks its points and their neighbors, whose edges are not collapsed in
+  // this round. When none of the candidates can be collapsed, the other edges
+  // are considered too.
+  std::vector<bool>                  locked(maxId + 1, false);
+  std::vector<OutputQEType *>        ring;
+  std::vector<OutputPointIdentifier> neighbors;
+  bool                               collapsed = false;
+
+  for (auto c = order.begin(); c != lastCandidate; ++c)
+  {
+    const OutputPointIdentifier id_org = edgePoints[*c].first;
+    const OutputPointIdentifier id_dest = edgePoints[*c].second;
+
+    if (locked[id_org] || locked[id_dest])
+    {
+      continue;
+    }
+
+    OutputQEType * qe = edges[*c];
+
+    ring.clear();
+    neighbors.clear();
+    for (OutputQEType * start : { qe, qe->GetSym() })
+    {
+      OutputQEType * qe_it = start;
+      do
+      {
+        ring.push_back(qe_it);
+        ring.push_back(qe_it->GetSym());
+        neighbors.push_back(qe_it->GetDestination());
+        qe_it = qe_it->GetOnext();
+      } while (qe_it != start);
+    }
+
+    const EdgeCollapseType collapse = m_EdgeCollapses[qe];
+
+    if (!m_JoinVertexFunction->Evaluate(qe))
+    {
+      std::cerr << "PF " << id_org << " " << id_dest << " " << collapse.m_Measure << " st " << (int)m_JoinVertexFunction->GetEdgeStatus() << std::endl;
+      if (!collapsed && c + 1 == lastCandidate && lastCandidate != order.end())
+      {
+        std::sort(lastCandidate, order.end(), lowerMeasure);
+        lastCandidate = order.end();
+      }
+      continue;
+    }
+
+    for (const OutputPointIdentifier id : neighbors)
+    {
+      locked[id] = true;
+    }
+
+    // The edges around the two points are deleted, or get new measures.
+    for (OutputQEType * e : ring)
+    {
+      m_EdgeCollapses.erase(e);
+    }
+
+    OutputPointIdentifier old_id = m_JoinVertexFunction->GetOldPointID();
+    OutputPointIdentifier new_id = (old_id == id_dest) ? id_org : id_dest;
+    DeletePoint(old_id, new_id);
+
+    OutputQEType * edge = output->FindEdge(new_id);
+    if (edge != nullptr)
+    {
+      OutputQEType * qe_it = edge;
+      do
+      {
+        m_EdgeCollapses.erase(qe_it);
+        m_EdgeCollapses.erase(qe_it->GetSym());
+        qe_it = qe_it->GetOnext();
+      } while (qe_it != edge);
+
+      if (m_Relocate)
+      {
+        OutputPointType pt = collapse.m_Location;
+        pt.SetEdge(edge);
+        output->SetPoint(new_id, pt);
+      }
+    }
+
+    collapsed = true;
+    if (true) std::cerr << "P " << id_org << " " << id_dest << " " << collapse.m_Measure << " " << collapse.m_Location << std::endl;
+    ++this->m_Iteration;
+
+    if (this->m_Criterion->is_satisfied(output, 0, collapse.m_Measure))
+    {
+      return false;
+    }
+  }
+
+  return collapsed;
+}
+
 template <typename TInput, typename TOutput, typename TCriterion>
 void
 EdgeDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::FillPriorityQueue()
@@ -345,11 +564,13 @@ EdgeDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::ProcessWithoutAny
       ++it;
     }
 
+    std::cerr << "SF " << id_org << " " << id_dest << " " << m_Priority.second << " st " << (int)m_JoinVertexFunction->GetEdgeStatus() << std::endl;
     JoinVertexFailed();
   }
   else
   {
     OutputPointIdentifier old_id = m_JoinVertexFunction->GetOldPointID();
+    if (true) std::cerr << "S " << id_org << " " << id_dest << " " << m_Priority.second << " " << pt << std::endl;
 
     OutputPointIdentifier new_id = (old_id == id_dest) ? id_org : id_dest;
     DeletePoint(old_id, new_id);
@@ -573,5 +794,15 @@ EdgeDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::IsCriterionSatisf
     return this->m_Criterion->is_satisfied(this->GetOutput(), 0, m_Priority.second);
   }
 }
+
+template <typename TInput, typename TOutput, typename TCriterion>
+void
+EdgeDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ParallelDecimation: " << (m_ParallelDecimation ? "On" : "Off") << std::endl;
+  os << indent << "CandidateFraction: " << m_CandidateFraction << std::endl;
+}
 } // namespace itk
 #endif
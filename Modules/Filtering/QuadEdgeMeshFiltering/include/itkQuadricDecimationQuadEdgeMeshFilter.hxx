@@ -30,26 +30,44 @@ QuadricDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::Initialize()
   OutputMeshPointer             output = this->GetOutput();
   OutputPointsContainerPointer  points = output->GetPoints();
   OutputPointsContainerIterator it = points->Begin();
-  OutputPointIdentifier         p_id;
-  OutputQEType *                qe;
-  OutputQEType *                qe_it;
 
-  OutputMeshType * outputMesh = this->GetOutput();
+  // The quadrics of the points are independent: they are computed in
+  // parallel, then stored in the map.
+  std::vector<OutputQEType *> rings;
+  rings.reserve(points->Size());
+
   while (it != points->End())
   {
-    p_id = it->Index();
-
-    qe = output->FindEdge(p_id);
+    OutputQEType * qe = output->FindEdge(it->Index());
     if (qe != nullptr)
     {
-      qe_it = qe;
+      rings.push_back(qe);
+    }
+    ++it;
+  }
+
+  OutputMeshType *                outputMesh = output.GetPointer();
+  std::vector<QuadricElementType> quadrics(rings.size());
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->ParallelizeArray(
+    0,
+    static_cast<SizeValueType>(rings.size()),
+    [this, &rings, &quadrics, outputMesh](SizeValueType i) {
+      OutputQEType * qe = rings[i];
+      OutputQEType * qe_it = qe;
       do
       {
-        QuadricAtOrigin(qe_it, m_Quadric[p_id], outputMesh);
+        QuadricAtOrigin(qe_it, quadrics[i], outputMesh);
         qe_it = qe_it->GetOnext();
       } while (qe_it != qe);
-    }
-    ++it;
+    },
+    nullptr);
+
+  for (size_t i = 0; i < rings.size(); ++i)
+  {
+    m_Quadric[rings[i]->GetOrigin()] += quadrics[i];
   }
 }
 
@@ -72,12 +90,10 @@ QuadricDecimationQuadEdgeMeshFilter<TInput, TOutput, TCriterion>::Relocate(Outpu
 {
   OutputPointIdentifier id_org = iEdge->GetOrigin();
   OutputPointIdentifier id_dest = iEdge->GetDestination();
-  QuadricElementType    Q = m_Quadric[id_org] + m_Quadric[id_dest];
-
-  OutputMeshPointer output = this->GetOutput();
+  QuadricElementType    Q = m_Quadric.find(id_org)->second + m_Quadric.find(id_dest)->second;
 
-  OutputPointType org = output->GetPoint(id_org);
-  OutputPointType dest = output->GetPoint(id_dest);
+  OutputPointType org = this->m_OutputMesh->GetPoint(id_org);
+  OutputPointType dest = this->m_OutputMesh->GetPoint(id_dest);
 
   OutputPointType mid;
 
@@ -20,6 +20,7 @@
 
 #include "itkDelaunayConformingQuadEdgeMeshFilter.h"
 #include "itkQuadEdgeMeshParamMatrixCoefficients.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -37,7 +38,14 @@ namespace itk
  * }{ \sum_j w_{ij} } \f]
  *
  * where \f$ w_{ij} \f$ is computed by the means of the set functor
- * CoefficientsComputation
+ * CoefficientsComputation.
+ *
+ * By default, after the first iteration the vertices are moved in place, one
+ * after the other, so that the location of a vertex depends on the ones
+ * already computed at the same iteration. When ParallelUpdate is on, all the
+ * vertices are moved from their locations at the previous iteration, so the
+ * new locations are computed in parallel, and the functor must be thread
+ * safe. Both give smooth meshes, but not the same ones.
  *
  * This process is then repeated for m_NumberOfIterations (the more iterations,
  * the smoother the output mesh will be).
@@ -108,6 +116,12 @@ public:
   itkSetMacro(RelaxationFactor, OutputCoordType);
   itkGetConstMacro(RelaxationFactor, OutputCoordType);
 
+  /** Set/Get if all the vertices are moved from their locations at the
+   * previous iteration, in parallel. Off by default. */
+  itkBooleanMacro(ParallelUpdate);
+  itkSetMacro(ParallelUpdate, bool);
+  itkGetConstMacro(ParallelUpdate, bool);
+
 protected:
   SmoothingQuadEdgeMeshFilter();
   ~SmoothingQuadEdgeMeshFilter() override;
@@ -132,6 +146,8 @@ protected:
 
   OutputCoordType m_RelaxationFactor;
 
+  bool m_ParallelUpdate;
+
   void
   GenerateData() override;
 };
@@ -30,6 +30,7 @@ SmoothingQuadEdgeMeshFilter<TInputMesh, TOutputMesh>::SmoothingQuadEdgeMeshFilte
   this->m_DelaunayConforming = false;
   this->m_NumberOfIterations = 1;
   this->m_RelaxationFactor = static_cast<OutputCoordType>(1.0);
+  this->m_ParallelUpdate = false;
 
   this->m_InputDelaunayFilter = InputOutputDelaunayConformingType::New();
   this->m_OutputDelaunayFilter = OutputDelaunayConformingType::New();
@@ -52,7 +53,7 @@ SmoothingQuadEdgeMeshFilter<TInputMesh, TOutputMesh>::GenerateData()
 {
   OutputPointIdentifier numberOfPoints = this->GetInput()->GetNumberOfPoints();
 
-  ProgressReporter progress(this, 0, m_NumberOfIterations * (numberOfPoints + 1), 100);
+  ProgressReporter progress(this, 0, m_NumberOfIterations, 100);
 
   OutputMeshPointer mesh = OutputMeshType::New();
 
@@ -62,18 +63,6 @@ SmoothingQuadEdgeMeshFilter<TInputMesh, TOutputMesh>::GenerateData()
   OutputPointsContainerPointer  points;
   OutputPointsContainerIterator it;
 
-  OutputPointType  p;
-  OutputPointType  q;
-  OutputPointType  r;
-  OutputVectorType v;
-
-  OutputCoordType coeff;
-  OutputCoordType sum_coeff;
-  OutputCoordType den;
-
-  OutputQEType * qe;
-  OutputQEType * qe_it;
-
   if (this->m_DelaunayConforming)
   {
     m_InputDelaunayFilter->SetInput(this->GetInput());
@@ -101,44 +90,83 @@ SmoothingQuadEdgeMeshFilter<TInputMesh, TOutputMesh>::GenerateData()
     }
   }
 
+  // The new location of a point, from the locations of its neighbors in the
+  // given mesh
+  const auto smoothPoint = [this](const OutputMeshType * iMesh, const OutputPointType & p) -> OutputPointType {
+    OutputQEType * qe = p.GetEdge();
+    if (qe == nullptr)
+    {
+      return p;
+    }
+
+    OutputPointType  r = p;
+    OutputVectorType v;
+    v.Fill(0.0);
+    OutputQEType *  qe_it = qe;
+    OutputCoordType sum_coeff = 0.;
+    do
+    {
+      OutputPointType q = iMesh->GetPoint(qe_it->GetDestination());
+
+      OutputCoordType coeff = (*m_CoefficientsMethod)(iMesh, qe_it);
+      sum_coeff += coeff;
+
+      v += coeff * (q - p);
+      qe_it = qe_it->GetOnext();
+    } while (qe_it != qe);
+
+    OutputCoordType den = 1.0 / static_cast<OutputCoordType>(sum_coeff);
+    v *= den;
+
+    r += m_RelaxationFactor * v;
+    r.SetEdge(qe);
+    return r;
+  };
+
+  std::vector<OutputPointIdentifier> ids;
+  std::vector<OutputPointType>       smoothed;
+
   for (unsigned int iter = 0; iter < m_NumberOfIterations; ++iter)
   {
     points = mesh->GetPoints();
 
-    for (it = points->Begin(); it != points->End(); ++it)
+    if (m_ParallelUpdate)
     {
-      p = it.Value();
-      qe = p.GetEdge();
-      if (qe != nullptr)
+      // The new locations only depend on the locations of the previous
+      // iteration, and are computed in parallel.
+      ids.clear();
+      ids.reserve(points->Size());
+      for (it = points->Begin(); it != points->End(); ++it)
       {
-        r = p;
-        v.Fill(0.0);
-        qe_it = qe;
-        sum_coeff = 0.;
-        do
-        {
-          q = mesh->GetPoint(qe_it->GetDestination());
-
-          coeff = (*m_CoefficientsMethod)(mesh, qe_it);
-          sum_coeff += coeff;
-
-          v += coeff * (q - p);
-          qe_it = qe_it->GetOnext();
-        } while (qe_it != qe);
-
-        den = 1.0 / static_cast<OutputCoordType>(sum_coeff);
-        v *= den;
-
-        r += m_RelaxationFactor * v;
-        r.SetEdge(qe);
-        temp->SetElement(it.Index(), r);
+        ids.push_back(it.Index());
       }
-      else
+      smoothed.resize(ids.size());
+
+      const OutputMeshType * previous = mesh.GetPointer();
+
+      MultiThreaderBase * multiThreader = this->GetMultiThreader();
+      multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      multiThreader->ParallelizeArray(
+        0,
+        static_cast<SizeValueType>(ids.size()),
+        [&ids, &smoothed, &smoothPoint, previous](SizeValueType i) {
+          smoothed[i] = smoothPoint(previous, previous->GetPoint(ids[i]));
+        },
+        nullptr);
+
+      for (size_t i = 0; i < ids.size(); ++i)
       {
-        temp->SetElement(it.Index(), p);
+        temp->SetElement(ids[i], smoothed[i]);
+      }
+    }
+    else
+    {
+      // After the first iteration, temp is the points container of the mesh,
+      // whose points are then moved in place.
+      for (it = points->Begin(); it != points->End(); ++it)
+      {
+        temp->SetElement(it.Index(), smoothPoint(mesh, it.Value()));
       }
-
-      progress.CompletedPixel();
     }
 
     mesh->SetPoints(temp);
@@ -179,6 +207,7 @@ SmoothingQuadEdgeMeshFilter<TInputMesh, TOutputMesh>::PrintSelf(std::ostream & o
   os << indent << "DelaunayConforming: " << (m_DelaunayConforming ? "On" : "Off") << std::endl;
   os << indent << "NumberOfIterations: " << m_NumberOfIterations << std::endl;
   os << indent << "RelaxationFactor: " << m_RelaxationFactor << std::endl;
+  os << indent << "ParallelUpdate: " << (m_ParallelUpdate ? "On" : "Off") << std::endl;
 }
 } // namespace itk
 
@@ -0,0 +1,126 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkQuadEdgeMesh.h"
+#include "itkRegularSphereMeshSource.h"
+#include "itkQuadEdgeMeshDecimationCriteria.h"
+#include "itkQuadricDecimationQuadEdgeMeshFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Mean distance of the points of the mesh to the unit sphere it approximates.
+template <typename TMesh>
+double
+MeanDistanceToUnitSphere(const TMesh * mesh)
+{
+  double sum = 0.;
+  for (auto it = mesh->GetPoints()->Begin(); it != mesh->GetPoints()->End(); ++it)
+  {
+    sum += std::abs(it.Value().GetVectorFromOrigin().GetNorm() - 1.);
+  }
+  return sum / static_cast<double>(mesh->GetNumberOfPoints());
+}
+} // namespace
+
+int
+itkQuadricDecimationQuadEdgeMeshFilterParallelTest(int, char *[])
+{
+  using CoordType = double;
+  constexpr unsigned int Dimension = 3;
+
+  using MeshType = itk::QuadEdgeMesh<CoordType, Dimension>;
+  using SphereSourceType = itk::RegularSphereMeshSource<MeshType>;
+  using CriterionType = itk::NumberOfFacesCriterion<MeshType>;
+  using DecimationType = itk::QuadricDecimationQuadEdgeMeshFilter<MeshType, MeshType, CriterionType>;
+
+  const auto sphere = SphereSourceType::New();
+  sphere->SetResolution(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(sphere->Update());
+
+  const MeshType::Pointer mesh = sphere->GetOutput();
+  for (auto it = mesh->GetCells()->Begin(); it != mesh->GetCells()->End(); ++it)
+  {
+    mesh->SetCellData(it.Index(), 25);
+  }
+  std::cout << "Input: " << mesh->GetNumberOfFaces() << " faces" << std::endl;
+
+  constexpr unsigned int numberOfFaces = 500;
+
+  for (double f : { 1e-9, 0.01, 0.05, 0.25, 1.0 })
+  {
+    const auto criterion = CriterionType::New();
+    criterion->SetNumberOfElements(numberOfFaces);
+    auto filter = DecimationType::New();
+    filter->SetInput(mesh);
+    filter->SetCriterion(criterion);
+    filter->SetParallelDecimation(true);
+    filter->SetCandidateFraction(f);
+    filter->Update();
+    std::cout << "XX " << f << " " << MeanDistanceToUnitSphere(filter->GetOutput()) << std::endl;
+  }
+  const auto decimate = [&mesh](bool parallel, itk::ThreadIdType numberOfWorkUnits) {
+    const auto criterion = CriterionType::New();
+    criterion->SetNumberOfElements(numberOfFaces);
+
+    auto filter = DecimationType::New();
+    filter->SetInput(mesh);
+    filter->SetCriterion(criterion);
+    filter->SetParallelDecimation(parallel);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Update();
+    return filter;
+  };
+
+  const auto serial = decimate(false, 4);
+  const auto parallel = decimate(true, 4);
+
+  ITK_TEST_SET_GET_BOOLEAN(parallel, ParallelDecimation, true);
+  ITK_TEST_SET_GET_VALUE(0.25, parallel->GetCandidateFraction());
+  parallel->SetCandidateFraction(2.);
+  ITK_TEST_SET_GET_VALUE(1., parallel->GetCandidateFraction());
+
+  const MeshType * serialOutput = serial->GetOutput();
+  const MeshType * parallelOutput = parallel->GetOutput();
+
+  ITK_TEST_EXPECT_EQUAL(serialOutput->GetNumberOfFaces(), numberOfFaces);
+  ITK_TEST_EXPECT_EQUAL(parallelOutput->GetNumberOfFaces(), numberOfFaces);
+  ITK_TEST_EXPECT_EQUAL(serialOutput->GetNumberOfCells(), serialOutput->GetCellData()->Size());
+  ITK_TEST_EXPECT_EQUAL(parallelOutput->GetNumberOfCells(), parallelOutput->GetCellData()->Size());
+
+  // The parallel rounds approximate the surface less closely than the priority
+  // queue, about 3.5 times further from the sphere on average. The bound
+  // catches a regression of the quality, not only a broken mesh.
+  const double serialDistance = MeanDistanceToUnitSphere(serialOutput);
+  const double parallelDistance = MeanDistanceToUnitSphere(parallelOutput);
+  std::cout << "Mean distance to the sphere: serial " << serialDistance << ", parallel " << parallelDistance
+            << std::endl;
+  ITK_TEST_EXPECT_TRUE(parallelDistance <= 4. * serialDistance);
+
+  // The result does not depend on the number of work units.
+  const auto singleThreaded = decimate(true, 1);
+
+  const MeshType * singleThreadedOutput = singleThreaded->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(singleThreadedOutput->GetNumberOfPoints(), parallelOutput->GetNumberOfPoints());
+  for (auto it = parallelOutput->GetPoints()->Begin(); it != parallelOutput->GetPoints()->End(); ++it)
+  {
+    ITK_TEST_EXPECT_TRUE(it.Value() == singleThreadedOutput->GetPoint(it.Index()));
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -26,14 +26,15 @@ int
 itkSmoothingQuadEdgeMeshFilterTest(int argc, char * argv[])
 {
   // ** ERROR MESSAGE AND HELP ** //
-  if (argc < 4)
+  if (argc < 6)
   {
-    std::cout << "Requires 3 argument: " << std::endl;
+    std::cout << "Requires at least 5 arguments: " << std::endl;
     std::cout << "1-Input file name " << std::endl;
     std::cout << "2-Number Of Iterations " << std::endl;
     std::cout << "3-Relaxation Factor" << std::endl;
     std::cout << "4-Use Delaunay Conforming filter" << std::endl;
     std::cout << "5-Output file name " << std::endl;
+    std::cout << "6-Use the parallel update (optional)" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -62,6 +63,13 @@ itkSmoothingQuadEdgeMeshFilterTest(int argc, char * argv[])
   std::stringstream ssout3(argv[4]);
   ssout3 >> del_conf;
 
+  bool parallel_update = false;
+  if (argc > 6)
+  {
+    std::stringstream ssout4(argv[6]);
+    ssout4 >> parallel_update;
+  }
+
   const auto mesh = reader->GetOutput();
 
   itk::OnesMatrixCoefficients<MeshType> coeff0;
@@ -78,9 +86,33 @@ itkSmoothingQuadEdgeMeshFilterTest(int argc, char * argv[])
   ITK_TEST_EXPECT_TRUE(itk::Math::AlmostEquals(relaxation_factor, filter->GetRelaxationFactor()));
   filter->SetDelaunayConforming(del_conf);
   ITK_TEST_SET_GET_BOOLEAN(filter, DelaunayConforming, del_conf);
+  filter->SetParallelUpdate(parallel_update);
+  ITK_TEST_SET_GET_BOOLEAN(filter, ParallelUpdate, parallel_update);
   filter->SetCoefficientsMethod(&coeff0);
   ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
 
+  if (parallel_update)
+  {
+    // The parallel update does not depend on the number of work units
+    const auto serialFilter = SmoothingType::New();
+    serialFilter->SetInput(mesh);
+    serialFilter->SetNumberOfIterations(nb_iter);
+    serialFilter->SetRelaxationFactor(relaxation_factor);
+    serialFilter->SetDelaunayConforming(del_conf);
+    serialFilter->SetParallelUpdate(true);
+    serialFilter->SetNumberOfWorkUnits(1);
+    serialFilter->SetCoefficientsMethod(&coeff0);
+    ITK_TRY_EXPECT_NO_EXCEPTION(serialFilter->Update());
+
+    const MeshType * output = filter->GetOutput();
+    const MeshType * serialOutput = serialFilter->GetOutput();
+    ITK_TEST_EXPECT_EQUAL(output->GetNumberOfPoints(), serialOutput->GetNumberOfPoints());
+    for (auto it = output->GetPoints()->Begin(); it != output->GetPoints()->End(); ++it)
+    {
+      ITK_TEST_EXPECT_TRUE(it.Value() == serialOutput->GetPoint(it.Index()));
+    }
+  }
+
   // ** WRITE OUTPUT **
   const auto writer = WriterType::New();
   writer->SetInput(filter->GetOutput());
@@ -359,6 +359,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the settings of the reading and writing of DICOM files, so that
+   * the clones read the slices of a series concurrently as this one would. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
@@ -24,12 +24,6 @@
 #include <vector>
 #include "ITKIOGDCMExport.h"
 
-// forward declaration, to remove compile dependency on GDCM library
-namespace gdcm
-{
-class SerieHelper;
-}
-
 namespace itk
 {
 /**
@@ -51,6 +45,12 @@ namespace itk
  *    DICOM objects, you may want to try calling SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ *  With ParallelScanningOn(), the headers of the files are read
+ *    concurrently, and the parsing of each file stops at the Pixel Data
+ *    element. Setting an IndexCacheFileName additionally keeps the headers
+ *    in an on-disk index, so that scanning the same directory again only
+ *    parses the files that were added or modified since.
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -185,6 +185,30 @@ public:
   itkGetConstMacro(LoadPrivateTags, bool);
   itkBooleanMacro(LoadPrivateTags);
 
+  /** Read the headers of the files concurrently, up to the Pixel Data
+   * element only. Defaults to false, which reads the files one after the
+   * other, including their pixel data. The series and the ordering of the
+   * files are the same in both modes.
+   * Must be set before the call to SetInputDirectory(). */
+  itkSetMacro(ParallelScanning, bool);
+  itkGetConstMacro(ParallelScanning, bool);
+  itkBooleanMacro(ParallelScanning);
+
+  /** File used to cache the headers of the scanned files when
+   * ParallelScanning is on. A file whose path, modification time and size
+   * match an entry of the cache is parsed from the cached header instead of
+   * being read. The cache is updated after each scan that read a file. It
+   * is a binary file in the byte order of the machine that wrote it, and may
+   * be shared by several directories. Empty by default, which disables the
+   * cache.
+   * Must be set before the call to SetInputDirectory(). */
+  itkSetStringMacro(IndexCacheFileName);
+  itkGetStringMacro(IndexCacheFileName);
+
+  /** Number of files whose header was taken from the index cache in the
+   * last scan. */
+  itkGetConstMacro(NumberOfCachedHeaders, SizeValueType);
+
 protected:
   GDCMSeriesFileNames();
   ~GDCMSeriesFileNames() override;
@@ -192,6 +216,14 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Gives access to the protected members of gdcm::SerieHelper. */
+  class SerieHelper;
+
+  /** Add the DICOM images of the input directory to the serie helper,
+   * reading their headers concurrently. */
+  void
+  ScanInputDirectory(const std::string & name);
+
   /** Contains the input directory where the DICOM serie is found */
   std::string m_InputDirectory = "";
 
@@ -203,7 +235,7 @@ private:
   FileNamesContainerType m_OutputFileNames;
 
   /** Internal structure to order serie from one directory */
-  std::unique_ptr<gdcm::SerieHelper> m_SerieHelper;
+  std::unique_ptr<SerieHelper> m_SerieHelper;
 
   /** Internal structure to keep the list of series UIDs */
   SeriesUIDContainerType m_SeriesUIDs;
@@ -212,6 +244,10 @@ private:
   bool m_Recursive = false;
   bool m_LoadSequences = false;
   bool m_LoadPrivateTags = false;
+  bool m_ParallelScanning = false;
+
+  std::string   m_IndexCacheFileName;
+  SizeValueType m_NumberOfCachedHeaders = 0;
 };
 } // namespace itk
 
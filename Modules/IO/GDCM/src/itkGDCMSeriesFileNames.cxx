@@ -19,14 +19,210 @@
 #include "itkGDCMSeriesFileNames.h"
 #include "itksys/SystemTools.hxx"
 #include "itkProgressReporter.h"
+#include "itkMultiThreaderBase.h"
 #include "gdcmSerieHelper.h"
+#include "gdcmDirectory.h"
+#include "gdcmReader.h"
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
 
 namespace itk
 {
+class GDCMSeriesFileNames::SerieHelper : public gdcm::SerieHelper
+{
+public:
+  using gdcm::SerieHelper::AddFile;
+  using gdcm::SerieHelper::AddFileName;
+};
+
+namespace
+{
+const char IndexCacheHeader[] = "ITK GDCM series index 1\n";
+
+/** The header of a file, as it was when it was scanned. An empty header
+ * means that the file is not a DICOM image. */
+struct IndexCacheEntry
+{
+  std::int64_t ModifiedTime{ 0 };
+  std::int64_t Size{ 0 };
+  std::string  Header;
+};
+using IndexCacheType = std::map<std::string, IndexCacheEntry>;
+
+bool
+GetFileStatus(const std::string & fileName, std::int64_t & modifiedTime, std::int64_t & size)
+{
+  itksys::SystemTools::Stat_t status;
+  if (itksys::SystemTools::Stat(fileName, &status) != 0)
+  {
+    return false;
+  }
+  modifiedTime = static_cast<std::int64_t>(status.st_mtime);
+  size = static_cast<std::int64_t>(status.st_size);
+  return true;
+}
+
+template <typename T>
+bool
+ReadValue(std::istream & is, T & value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+template <typename T>
+void
+WriteValue(std::ostream & os, const T & value)
+{
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+bool
+ReadString(std::istream & is, std::string & value)
+{
+  std::uint64_t length = 0;
+  if (!ReadValue(is, length))
+  {
+    return false;
+  }
+  value.resize(static_cast<size_t>(length));
+  return length == 0 || static_cast<bool>(is.read(&value[0], static_cast<std::streamsize>(length)));
+}
+
+void
+WriteString(std::ostream & os, const std::string & value)
+{
+  WriteValue(os, static_cast<std::uint64_t>(value.size()));
+  os.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+/** Read the entries of an index cache. A missing or corrupted cache gives
+ * the entries read before the error. */
+void
+ReadIndexCache(const std::string & cacheFileName, IndexCacheType & cache)
+{
+  std::ifstream file(cacheFileName.c_str(), std::ios::binary);
+  std::string   header(sizeof(IndexCacheHeader) - 1, '\0');
+  if (!file.is_open() || !file.read(&header[0], static_cast<std::streamsize>(header.size())) ||
+      header != IndexCacheHeader)
+  {
+    return;
+  }
+  std::string     fileName;
+  IndexCacheEntry entry;
+  while (ReadString(file, fileName) && ReadValue(file, entry.ModifiedTime) && ReadValue(file, entry.Size) &&
+         ReadString(file, entry.Header))
+  {
+    cache[fileName] = entry;
+  }
+}
 
+bool
+WriteIndexCache(const std::string & cacheFileName, const IndexCacheType & cache)
+{
+  std::ofstream file(cacheFileName.c_str(), std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    return false;
+  }
+  file.write(IndexCacheHeader, sizeof(IndexCacheHeader) - 1);
+  for (const auto & entry : cache)
+  {
+    WriteString(file, entry.first);
+    WriteValue(file, entry.second.ModifiedTime);
+    WriteValue(file, entry.second.Size);
+    WriteString(file, entry.second.Header);
+  }
+  return static_cast<bool>(file);
+}
+
+/** The result of the scan of a file. */
+struct ScannedFile
+{
+  gdcm::SmartPointer<gdcm::FileWithName> Header;
+  IndexCacheEntry                        Entry;
+  bool                                   Cached{ false };
+  bool                                   Cacheable{ false };
+  bool                                   ReadFully{ false };
+};
+
+/** Read the header of a file, up to its Pixel Data element, from the disk
+ * or from its cached header. */
+void
+ScanFile(const std::string & fileName, const IndexCacheType & cache, bool keepHeader, ScannedFile & scanned)
+{
+  if (!GetFileStatus(fileName, scanned.Entry.ModifiedTime, scanned.Entry.Size))
+  {
+    return;
+  }
+
+  const gdcm::Tag           pixelDataTag(0x7fe0, 0x0010);
+  const std::set<gdcm::Tag> skipTags{ pixelDataTag };
+  gdcm::Reader              reader;
+  std::istringstream        cachedHeader;
+
+  const auto cacheIt = cache.find(fileName);
+  if (cacheIt != cache.end() && cacheIt->second.ModifiedTime == scanned.Entry.ModifiedTime &&
+      cacheIt->second.Size == scanned.Entry.Size)
+  {
+    scanned.Cached = true;
+    if (cacheIt->second.Header.empty())
+    {
+      return;
+    }
+    cachedHeader.str(cacheIt->second.Header);
+    reader.SetStream(cachedHeader);
+  }
+  else
+  {
+    reader.SetFileName(fileName.c_str());
+  }
+
+  if (!reader.ReadUpToTag(pixelDataTag, skipTags))
+  {
+    // not a DICOM file
+    scanned.Cacheable = !scanned.Cached;
+    return;
+  }
+  if (reader.GetFile().GetHeader().GetDataSetTransferSyntax() == gdcm::TransferSyntax::DeflatedExplicitVRLittleEndian)
+  {
+    // the position in a deflated data set can't be mapped back to the file
+    scanned.Cached = false;
+    scanned.ReadFully = true;
+    return;
+  }
+
+  if (!scanned.Cached)
+  {
+    // the parsing stops right after the header of the Pixel Data element,
+    // or at the end of a file which does not have one
+    const std::streamoff position = static_cast<std::streamoff>(reader.GetStreamCurrentPosition());
+    scanned.Cacheable = true;
+    if (position <= 0 || position >= static_cast<std::streamoff>(scanned.Entry.Size))
+    {
+      return;
+    }
+    if (keepHeader)
+    {
+      std::ifstream file(fileName.c_str(), std::ios::binary);
+      scanned.Entry.Header.resize(static_cast<size_t>(position));
+      if (!file.read(&scanned.Entry.Header[0], position))
+      {
+        scanned.Entry.Header.clear();
+        scanned.Cacheable = false;
+      }
+    }
+  }
+
+  scanned.Header = new gdcm::FileWithName(reader.GetFile());
+  scanned.Header->filename = fileName;
+}
+} // namespace
 
 GDCMSeriesFileNames::GDCMSeriesFileNames()
-  : m_SerieHelper{ new gdcm::SerieHelper() }
+  : m_SerieHelper{ new SerieHelper() }
 {}
 
 GDCMSeriesFileNames::~GDCMSeriesFileNames() = default;
@@ -71,11 +267,82 @@ GDCMSeriesFileNames::SetInputDirectory(std::string const & name)
   m_SerieHelper->Clear();
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode((m_LoadSequences ? 0 : gdcm::LD_NOSEQ) | (m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW));
-  m_SerieHelper->SetDirectory(name, m_Recursive);
+  if (m_ParallelScanning)
+  {
+    this->ScanInputDirectory(name);
+  }
+  else
+  {
+    m_SerieHelper->SetDirectory(name, m_Recursive);
+  }
   // as a side effect it also execute
   this->Modified();
 }
 
+void
+GDCMSeriesFileNames::ScanInputDirectory(const std::string & name)
+{
+  gdcm::Directory directory;
+  directory.Load(name, m_Recursive);
+  const gdcm::Directory::FilenamesType & fileNames = directory.GetFilenames();
+
+  IndexCacheType cache;
+  const bool     useCache = !m_IndexCacheFileName.empty();
+  if (useCache)
+  {
+    ReadIndexCache(m_IndexCacheFileName, cache);
+  }
+
+  std::vector<ScannedFile> scannedFiles(fileNames.size());
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    static_cast<SizeValueType>(fileNames.size()),
+    [&](SizeValueType i) {
+      try
+      {
+        ScanFile(fileNames[i], cache, useCache, scannedFiles[i]);
+      }
+      catch (...)
+      {
+        // skipped, as the files gdcm::SerieHelper can't read
+        scannedFiles[i] = ScannedFile();
+      }
+    },
+    nullptr);
+
+  // the files are added in the order of the directory listing, as
+  // gdcm::SerieHelper::SetDirectory() does
+  m_NumberOfCachedHeaders = 0;
+  bool cacheModified = false;
+  for (size_t i = 0; i < fileNames.size(); ++i)
+  {
+    ScannedFile & scanned = scannedFiles[i];
+    if (scanned.ReadFully)
+    {
+      m_SerieHelper->AddFileName(fileNames[i]);
+      continue;
+    }
+    if (scanned.Header)
+    {
+      m_SerieHelper->AddFile(*scanned.Header);
+    }
+    if (scanned.Cached)
+    {
+      ++m_NumberOfCachedHeaders;
+    }
+    else if (useCache && scanned.Cacheable)
+    {
+      cache[fileNames[i]] = std::move(scanned.Entry);
+      cacheModified = true;
+    }
+  }
+
+  if (cacheModified && !WriteIndexCache(m_IndexCacheFileName, cache))
+  {
+    itkWarningMacro(<< "Could not write the index cache " << m_IndexCacheFileName);
+  }
+}
+
 const GDCMSeriesFileNames::SeriesUIDContainerType &
 GDCMSeriesFileNames::GetSeriesUIDs()
 {
@@ -270,6 +537,9 @@ GDCMSeriesFileNames::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "InputDirectory: " << m_InputDirectory << std::endl;
   os << indent << "LoadSequences:" << m_LoadSequences << std::endl;
   os << indent << "LoadPrivateTags:" << m_LoadPrivateTags << std::endl;
+  os << indent << "ParallelScanning: " << m_ParallelScanning << std::endl;
+  os << indent << "IndexCacheFileName: " << m_IndexCacheFileName << std::endl;
+  os << indent << "NumberOfCachedHeaders: " << m_NumberOfCachedHeaders << std::endl;
   if (m_Recursive)
   {
     os << indent << "Recursive: True" << std::endl;
@@ -0,0 +1,237 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkImageFileWriter.h"
+#include "itkImageSeriesReader.h"
+#include "itkMetaDataObject.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace
+{
+using SeriesType = std::map<std::string, itk::GDCMSeriesFileNames::FileNamesContainerType>;
+
+SeriesType
+GetSeries(itk::GDCMSeriesFileNames * seriesFileNames)
+{
+  SeriesType series;
+  for (const auto & uid : seriesFileNames->GetSeriesUIDs())
+  {
+    series[uid] = seriesFileNames->GetFileNames(uid);
+  }
+  return series;
+}
+
+SeriesType
+ScanDirectory(const std::string & directory, bool parallelScanning, const std::string & cacheFileName)
+{
+  itk::GDCMSeriesFileNames::Pointer seriesFileNames = itk::GDCMSeriesFileNames::New();
+  seriesFileNames->SetParallelScanning(parallelScanning);
+  seriesFileNames->SetIndexCacheFileName(cacheFileName);
+  seriesFileNames->SetInputDirectory(directory);
+  return GetSeries(seriesFileNames);
+}
+} // namespace
+
+int
+itkGDCMSeriesParallelScanTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputTestDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using Image2DType = itk::Image<short, 2>;
+  using Image3DType = itk::Image<short, 3>;
+
+  const std::string directory = std::string(argv[1]) + "/itkGDCMSeriesParallelScanTest";
+  const std::string cacheFileName = std::string(argv[1]) + "/itkGDCMSeriesParallelScanTest.index";
+  itksys::SystemTools::RemoveADirectory(directory);
+  itksys::SystemTools::MakeDirectory(directory);
+  itksys::SystemTools::RemoveFile(cacheFileName);
+
+  // Two series of slices whose positions are not in the order of their file names
+  constexpr unsigned int numberOfSeries = 2;
+  constexpr unsigned int numberOfSlices = 5;
+  const unsigned int     slicePositions[numberOfSlices] = { 3, 0, 4, 1, 2 };
+
+  Image2DType::SizeType size;
+  size.Fill(16);
+
+  for (unsigned int series = 0; series < numberOfSeries; ++series)
+  {
+    for (unsigned int slice = 0; slice < numberOfSlices; ++slice)
+    {
+      auto source = itk::RandomImageSource<Image2DType>::New();
+      source->SetMin(0);
+      source->SetMax(1000);
+      source->SetSize(size);
+      source->Update();
+
+      itk::MetaDataDictionary dictionary;
+      std::ostringstream      value;
+      itk::EncapsulateMetaData<std::string>(dictionary, "0008|0060", "CT");
+      itk::EncapsulateMetaData<std::string>(dictionary, "0020|000d", "1.2.826.0.1.3680043.2.1125.1.1");
+      value << "1.2.826.0.1.3680043.2.1125.1.2." << series;
+      itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", value.str());
+      value.str("");
+      value << "1.2.826.0.1.3680043.2.1125.1.3." << series << '.' << slice;
+      itk::EncapsulateMetaData<std::string>(dictionary, "0008|0018", value.str());
+      value.str("");
+      value << series + 1;
+      itk::EncapsulateMetaData<std::string>(dictionary, "0020|0011", value.str());
+      value.str("");
+      value << slicePositions[slice] + 1;
+      itk::EncapsulateMetaData<std::string>(dictionary, "0020|0013", value.str());
+      value.str("");
+      value << "0\\0\\" << 2.5 * slicePositions[slice];
+      itk::EncapsulateMetaData<std::string>(dictionary, "0020|0032", value.str());
+      source->GetOutput()->SetMetaDataDictionary(dictionary);
+
+      auto imageIO = itk::GDCMImageIO::New();
+      imageIO->KeepOriginalUIDOn();
+
+      std::ostringstream fileName;
+      fileName << directory << "/slice" << series << slice << ".dcm";
+      auto writer = itk::ImageFileWriter<Image2DType>::New();
+      writer->SetInput(source->GetOutput());
+      writer->SetImageIO(imageIO);
+      writer->SetFileName(fileName.str());
+      ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+    }
+  }
+
+  // A file which is not a DICOM image is skipped in both modes
+  {
+    std::ofstream text((directory + "/notes.txt").c_str());
+    text << "not a DICOM file" << std::endl;
+  }
+
+  itk::GDCMSeriesFileNames::Pointer seriesFileNames = itk::GDCMSeriesFileNames::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(seriesFileNames, GDCMSeriesFileNames, ProcessObject);
+
+  ITK_TEST_SET_GET_BOOLEAN(seriesFileNames, ParallelScanning, true);
+  seriesFileNames->SetIndexCacheFileName(cacheFileName);
+  ITK_TEST_SET_GET_VALUE(cacheFileName, std::string(seriesFileNames->GetIndexCacheFileName()));
+
+  const SeriesType expected = ScanDirectory(directory, false, "");
+  ITK_TEST_EXPECT_EQUAL(expected.size(), numberOfSeries);
+  for (const auto & series : expected)
+  {
+    ITK_TEST_EXPECT_EQUAL(series.second.size(), numberOfSlices);
+  }
+
+  // The slices are ordered by their position
+  const itk::GDCMSeriesFileNames::FileNamesContainerType & firstSeries = expected.begin()->second;
+  for (unsigned int slice = 0; slice < numberOfSlices; ++slice)
+  {
+    std::ostringstream fileName;
+    fileName << "slice0" << slice << ".dcm";
+    ITK_TEST_EXPECT_EQUAL(itksys::SystemTools::GetFilenameName(firstSeries[slicePositions[slice]]), fileName.str());
+  }
+
+  ITK_TEST_EXPECT_TRUE(ScanDirectory(directory, true, "") == expected);
+
+  // The first scan fills the index cache, the second one only reads the cache
+  seriesFileNames->ParallelScanningOn();
+  seriesFileNames->SetInputDirectory(directory);
+  ITK_TEST_EXPECT_TRUE(GetSeries(seriesFileNames) == expected);
+  ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetNumberOfCachedHeaders(), 0u);
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(cacheFileName, true));
+
+  itk::GDCMSeriesFileNames::Pointer cachedSeriesFileNames = itk::GDCMSeriesFileNames::New();
+  cachedSeriesFileNames->ParallelScanningOn();
+  cachedSeriesFileNames->SetIndexCacheFileName(cacheFileName);
+  cachedSeriesFileNames->SetInputDirectory(directory);
+  ITK_TEST_EXPECT_TRUE(GetSeries(cachedSeriesFileNames) == expected);
+  ITK_TEST_EXPECT_EQUAL(cachedSeriesFileNames->GetNumberOfCachedHeaders(), numberOfSeries * numberOfSlices + 1);
+
+  // The slices of the series are decoded concurrently by the series reader,
+  // each work unit with a clone of the GDCMImageIO which is set
+  using SeriesReaderType = itk::ImageSeriesReader<Image3DType>;
+  auto serialImageIO = itk::GDCMImageIO::New();
+  serialImageIO->LoadPrivateTagsOn();
+  serialImageIO->ReadYBRtoRGBOff();
+  auto serialReader = SeriesReaderType::New();
+  serialReader->SetImageIO(serialImageIO);
+  serialReader->SetFileNames(firstSeries);
+  ITK_TRY_EXPECT_NO_EXCEPTION(serialReader->Update());
+
+  auto parallelImageIO = itk::GDCMImageIO::New();
+  parallelImageIO->LoadPrivateTagsOn();
+  parallelImageIO->ReadYBRtoRGBOff();
+  auto parallelReader = SeriesReaderType::New();
+  parallelReader->SetImageIO(parallelImageIO);
+  parallelReader->SetFileNames(firstSeries);
+  parallelReader->ParallelReadOn();
+  parallelReader->SetNumberOfWorkUnits(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelReader->UpdateOutputInformation());
+  parallelImageIO->SetFileName("");
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelReader->Update());
+
+  // the GDCMImageIO which is set only read the information of the series
+  ITK_TEST_EXPECT_TRUE(std::string(parallelImageIO->GetFileName()).empty());
+
+  const Image3DType * serialImage = serialReader->GetOutput();
+  const Image3DType * parallelImage = parallelReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(parallelImage->GetLargestPossibleRegion(), serialImage->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_TRUE(parallelImage->GetOrigin() == serialImage->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(std::equal(serialImage->GetBufferPointer(),
+                                  serialImage->GetBufferPointer() + serialImage->GetPixelContainer()->Size(),
+                                  parallelImage->GetBufferPointer()));
+
+  // the meta data of every slice is read as by the serial reader
+  const SeriesReaderType::DictionaryArrayType * serialDictionaries = serialReader->GetMetaDataDictionaryArray();
+  const SeriesReaderType::DictionaryArrayType * parallelDictionaries = parallelReader->GetMetaDataDictionaryArray();
+  ITK_TEST_EXPECT_EQUAL(parallelDictionaries->size(), numberOfSlices);
+  ITK_TEST_EXPECT_EQUAL(parallelDictionaries->size(), serialDictionaries->size());
+  for (unsigned int slice = 0; slice < parallelDictionaries->size(); ++slice)
+  {
+    const itk::MetaDataDictionary & serialDictionary = *(*serialDictionaries)[slice];
+    const itk::MetaDataDictionary & parallelDictionary = *(*parallelDictionaries)[slice];
+    ITK_TEST_EXPECT_TRUE(parallelDictionary.GetKeys() == serialDictionary.GetKeys());
+    for (const auto & key : serialDictionary.GetKeys())
+    {
+      std::string serialValue;
+      std::string parallelValue;
+      itk::ExposeMetaData(serialDictionary, key, serialValue);
+      itk::ExposeMetaData(parallelDictionary, key, parallelValue);
+      ITK_TEST_EXPECT_EQUAL(parallelValue, serialValue);
+    }
+  }
+
+  // the clones have the settings of the GDCMImageIO
+  parallelImageIO->SetUIDPrefix("1.2.3");
+  itk::GDCMImageIO::Pointer clone = dynamic_cast<itk::GDCMImageIO *>(parallelImageIO->Clone().GetPointer());
+  ITK_TEST_EXPECT_TRUE(clone.IsNotNull());
+  ITK_TEST_EXPECT_TRUE(clone != parallelImageIO);
+  ITK_TEST_EXPECT_TRUE(clone->GetLoadPrivateTags());
+  ITK_TEST_EXPECT_TRUE(!clone->GetReadYBRtoRGB());
+  ITK_TEST_EXPECT_EQUAL(std::string(clone->GetUIDPrefix()), std::string("1.2.3"));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
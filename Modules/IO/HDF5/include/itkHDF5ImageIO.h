@@ -77,8 +77,19 @@ namespace itk
  * \li \/ITKImage\/\<name\>\/MetaData\/\<item-name\>
  *                             Dataset containing data for item-name
  *                             in the MetaDataDictionary
+ * \li \/ITKImage\/\<name\>\/Pyramid\/\<level\>
+ *                             multi-dim array of voxel data of the
+ *                             levels of the multi-resolution pyramid,
+ *                             if any
  * re-arrangement.
  *
+ * The voxel data is chunked and compressed. By default, the chunks are the
+ * slices along the last dimension; SetChunkSize gives them any N-D shape,
+ * so that streamed reads and writes of small regions touch as little data
+ * as possible. The level k of the pyramid keeps one pixel out of 2^k along
+ * each dimension, without low-pass filtering, so fine details alias in the
+ * coarse levels. The levels are written along with the image, including
+ * when streaming, and SetPyramidLevel selects the level to read.
  *
  */
 
@@ -137,6 +148,41 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Set/Get the shape of the chunks of the voxel data, in pixels, with the
+   * dimension 0 first. The chunks are extended over the whole image in the
+   * dimensions without a value or with a zero value. The chunks always hold
+   * all the components of their pixels. By default, the chunks are the slices
+   * along the last dimension. */
+  void
+  SetChunkSize(const std::vector<SizeValueType> & chunkSize)
+  {
+    if (this->m_ChunkSize != chunkSize)
+    {
+      this->m_ChunkSize = chunkSize;
+      this->Modified();
+    }
+  }
+  itkGetConstReferenceMacro(ChunkSize, std::vector<SizeValueType>);
+
+  /** Set/Get the size in bytes of the cache of decompressed chunks of each
+   * dataset. Streamed reads and writes are much faster when all the chunks a
+   * region crosses fit in the cache. The default, 0, keeps the default of the
+   * HDF5 library, 1 MiB. */
+  itkSetMacro(ChunkCacheSize, SizeValueType);
+  itkGetConstMacro(ChunkCacheSize, SizeValueType);
+
+  /** Set/Get the number of levels of the multi-resolution pyramid, including
+   * the image itself. ReadImageInformation sets it to the number of levels of
+   * the file. The default, 1, writes no other level. */
+  itkSetClampMacro(NumberOfPyramidLevels, unsigned int, 1, 32);
+  itkGetConstMacro(NumberOfPyramidLevels, unsigned int);
+
+  /** Set/Get the level of the pyramid to read. The dimensions and spacing of
+   * the image are those of the level. The default, 0, reads the image
+   * itself. */
+  itkSetMacro(PyramidLevel, unsigned int);
+  itkGetConstMacro(PyramidLevel, unsigned int);
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -202,6 +248,13 @@ private:
                 unsigned long        numElements);
   void
   SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
+  void
+  SetupStreaming(const ImageIORegion & region, H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
+
+  /** Write the pixels of the written region which belong to the levels of
+   * the pyramid. */
+  void
+  WritePyramidLevels(const void * buffer);
 
   void
   CloseH5File();
@@ -211,6 +264,11 @@ private:
   H5::H5File *  m_H5File{ nullptr };
   H5::DataSet * m_VoxelDataSet{ nullptr };
   bool          m_ImageInformationWritten{ false };
+
+  std::vector<SizeValueType> m_ChunkSize;
+  SizeValueType              m_ChunkCacheSize{ 0 };
+  unsigned int               m_NumberOfPyramidLevels{ 1 };
+  unsigned int               m_PyramidLevel{ 0 };
 };
 } // end namespace itk
 
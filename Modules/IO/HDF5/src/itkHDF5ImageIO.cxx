@@ -17,6 +17,7 @@
  *=========================================================================*/
 #include "itkVersion.h"
 #include "itkHDF5ImageIO.h"
+#include "itkImageIOPyramidHelper.h"
 #include "itkMetaDataObject.h"
 #include "itkArray.h"
 #include "itksys/SystemTools.hxx"
@@ -55,6 +56,15 @@ HDF5ImageIO ::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << this->m_H5File << std::endl;
+  os << indent << "ChunkSize: [";
+  for (size_t i = 0; i < m_ChunkSize.size(); ++i)
+  {
+    os << (i > 0 ? ", " : "") << m_ChunkSize[i];
+  }
+  os << "]" << std::endl;
+  os << indent << "ChunkCacheSize: " << m_ChunkCacheSize << std::endl;
+  os << indent << "NumberOfPyramidLevels: " << m_NumberOfPyramidLevels << std::endl;
+  os << indent << "PyramidLevel: " << m_PyramidLevel << std::endl;
 }
 
 //
@@ -71,6 +81,80 @@ const std::string Dimensions("/Dimension");
 const std::string VoxelType("/VoxelType");
 const std::string VoxelData("/VoxelData");
 const std::string MetaDataName("/MetaData");
+const std::string PyramidName("/Pyramid");
+
+std::string
+PyramidLevelName(unsigned int level)
+{
+  return ImageGroup + "/0" + PyramidName + "/" + std::to_string(level);
+}
+
+bool
+PathExists(const H5::H5File & h5file, const std::string & path)
+{
+#if (H5_VERS_MAJOR == 1) && (H5_VERS_MINOR < 10)
+  return H5Lexists(h5file.getId(), path.c_str(), H5P_DEFAULT) > 0;
+#else
+  return h5file.exists(path);
+#endif
+}
+
+// Get the dimensions of the chunks of a dataset, in the HDF5 order: the last
+// dimension of the image first, and the components last.
+std::vector<hsize_t>
+ChunkDimensions(const std::vector<hsize_t> & dims, unsigned int numDims, const std::vector<SizeValueType> & chunkSize)
+{
+  std::vector<hsize_t> chunk(dims);
+  if (chunkSize.empty())
+  {
+    // the slices along the last dimension
+    chunk[0] = 1;
+    return chunk;
+  }
+  for (unsigned int i = 0; i < numDims && i < chunkSize.size(); ++i)
+  {
+    const unsigned int j = numDims - 1 - i;
+    if (chunkSize[i] > 0)
+    {
+      chunk[j] = std::min(static_cast<hsize_t>(chunkSize[i]), dims[j]);
+    }
+  }
+  return chunk;
+}
+
+// Set the size of the chunk cache, with a prime number of hash table slots
+// about a hundred times the number of 64 KiB chunks the cache holds, as
+// recommended by the HDF5 documentation.
+void
+SetFileChunkCacheSize(H5::FileAccPropList & fapl, SizeValueType cacheSize)
+{
+  if (cacheSize == 0)
+  {
+    return;
+  }
+  int    mdcNumberOfElements;
+  size_t numberOfSlots;
+  size_t numberOfBytes;
+  double preemption;
+  fapl.getCache(mdcNumberOfElements, numberOfSlots, numberOfBytes, preemption);
+
+  numberOfSlots = std::max(numberOfSlots, static_cast<size_t>(cacheSize / 65536 * 100)) | 1;
+  const auto isPrime = [](size_t n) {
+    for (size_t d = 3; d * d <= n; d += 2)
+    {
+      if (n % d == 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  while (!isPrime(numberOfSlots))
+  {
+    numberOfSlots += 2;
+  }
+  fapl.setCache(mdcNumberOfElements, numberOfSlots, static_cast<size_t>(cacheSize), preemption);
+}
 
 template <typename TScalar>
 H5::PredType
@@ -613,13 +697,8 @@ HDF5ImageIO ::CanReadFile(const char * FileNameToRead)
 
     H5::H5File h5file(FileNameToRead, H5F_ACC_RDONLY);
 
-#if (H5_VERS_MAJOR == 1) && (H5_VERS_MINOR < 10)
     // check the file has the ITK ImageGroup
-    htri_t exists = H5Lexists(h5file.getId(), ImageGroup.c_str(), H5P_DEFAULT);
-    if (exists <= 0)
-#else
-    if (!h5file.exists(ImageGroup))
-#endif
+    if (!PathExists(h5file, ImageGroup))
     {
       rval = false;
     }
@@ -661,7 +740,9 @@ HDF5ImageIO ::ReadImageInformation()
   {
     this->CloseH5File();
     this->CloseDataSet();
-    this->m_H5File = new H5::H5File(this->GetFileName(), H5F_ACC_RDONLY);
+    H5::FileAccPropList fapl;
+    SetFileChunkCacheSize(fapl, m_ChunkCacheSize);
+    this->m_H5File = new H5::H5File(this->GetFileName(), H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, fapl);
     this->m_VoxelDataSet = new H5::DataSet();
 
     // not sure what to do with this initially
@@ -710,8 +791,34 @@ HDF5ImageIO ::ReadImageInformation()
       }
     }
 
+    // the levels of the pyramid
+    m_NumberOfPyramidLevels = 1;
+    if (PathExists(*this->m_H5File, groupName + PyramidName))
+    {
+      while (PathExists(*this->m_H5File, PyramidLevelName(m_NumberOfPyramidLevels)))
+      {
+        ++m_NumberOfPyramidLevels;
+      }
+    }
+
     std::string VoxelDataName(groupName);
     VoxelDataName += VoxelData;
+    if (m_PyramidLevel > 0)
+    {
+      if (m_PyramidLevel >= m_NumberOfPyramidLevels)
+      {
+        itkExceptionMacro(<< "Cannot read the pyramid level " << m_PyramidLevel << " of " << this->GetFileName()
+                          << ", which has " << m_NumberOfPyramidLevels << " levels");
+      }
+      const std::vector<SizeValueType> levelDimensions = ImageIOPyramidHelper::GetLevelDimensions(this, m_PyramidLevel);
+      const double                     factor = static_cast<double>(SizeValueType{ 1 } << m_PyramidLevel);
+      for (int i = 0; i < numDims; i++)
+      {
+        this->SetDimensions(i, levelDimensions[i]);
+        this->SetSpacing(i, this->GetSpacing(i) * factor);
+      }
+      VoxelDataName = PyramidLevelName(m_PyramidLevel);
+    }
     *(this->m_VoxelDataSet) = this->m_H5File->openDataSet(VoxelDataName);
     H5::DataSet   imageSet = *(this->m_VoxelDataSet);
     H5::DataSpace imageSpace = imageSet.getSpace();
@@ -908,7 +1015,12 @@ HDF5ImageIO ::ReadImageInformation()
 void
 HDF5ImageIO ::SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace)
 {
-  ImageIORegion            regionToRead = this->GetIORegion();
+  this->SetupStreaming(this->GetIORegion(), imageSpace, slabSpace);
+}
+
+void
+HDF5ImageIO ::SetupStreaming(const ImageIORegion & regionToRead, H5::DataSpace * imageSpace, H5::DataSpace * slabSpace)
+{
   ImageIORegion::SizeType  size = regionToRead.GetSize();
   ImageIORegion::IndexType start = regionToRead.GetIndex();
   //
@@ -1024,6 +1136,7 @@ HDF5ImageIO ::WriteImageInformation()
 #  error The selected version of HDF5 library does not support setting backwards compatibility at run-time.\
   Please use a different version of HDF5, e.g. the one bundled with ITK (by setting ITK_USE_SYSTEM_HDF5 to OFF).
 #endif
+    SetFileChunkCacheSize(fapl, m_ChunkCacheSize);
     this->m_H5File = new H5::H5File(this->GetFileName(), H5F_ACC_TRUNC, H5::FileCreatPropList::DEFAULT, fapl);
     this->m_VoxelDataSet = new H5::DataSet();
 
@@ -1053,11 +1166,12 @@ HDF5ImageIO ::WriteImageInformation()
     std::string typeVal(ComponentToString(this->GetComponentType()));
     this->WriteString(VoxelTypeName, typeVal);
 
-    int numComponents = this->GetNumberOfComponents();
-    int numDims = this->GetNumberOfDimensions();
+    int       numComponents = this->GetNumberOfComponents();
+    const int imageDims = this->GetNumberOfDimensions();
+    int       numDims = imageDims;
     // HDF5 dimensions listed slowest moving first, ITK are fastest
     // moving first.
-    std::unique_ptr<hsize_t[]> dims(new hsize_t[numDims + (numComponents == 1 ? 0 : 1)]);
+    std::vector<hsize_t> dims(numDims + (numComponents == 1 ? 0 : 1));
 
     for (int i(0), j(numDims - 1); i < numDims; i++, j--)
     {
@@ -1068,25 +1182,43 @@ HDF5ImageIO ::WriteImageInformation()
       dims[numDims] = numComponents;
       numDims++;
     }
-    H5::DataSpace imageSpace(numDims, dims.get());
+    H5::DataSpace imageSpace(numDims, dims.data());
     H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
+    // by default, the chunks are the N-1 dimension slices
     H5::DSetCreatPropList plist;
 
     // we have implicit compression enabled here?
     plist.setDeflate(this->GetCompressionLevel());
 
-    dims[0] = 1;
-    plist.setChunk(numDims, dims.get());
-    dims.reset();
+    std::vector<hsize_t> chunk = ChunkDimensions(dims, imageDims, m_ChunkSize);
+    plist.setChunk(numDims, chunk.data());
 
     std::string VoxelDataName(ImageGroup);
     VoxelDataName += "/0";
     VoxelDataName += VoxelData;
     *(this->m_VoxelDataSet) = this->m_H5File->createDataSet(VoxelDataName, dataType, imageSpace, plist);
+
+    // the levels of the pyramid, chunked like the image
+    if (m_NumberOfPyramidLevels > 1)
+    {
+      this->m_H5File->createGroup(groupName + PyramidName);
+      for (unsigned int level = 1; level < m_NumberOfPyramidLevels; ++level)
+      {
+        const std::vector<SizeValueType> levelDimensions = ImageIOPyramidHelper::GetLevelDimensions(this, level);
+        for (int i(0), j(imageDims - 1); i < imageDims; i++, j--)
+        {
+          dims[j] = levelDimensions[i];
+        }
+        H5::DataSpace         levelSpace(numDims, dims.data());
+        H5::DSetCreatPropList levelPlist;
+        levelPlist.setDeflate(this->GetCompressionLevel());
+        chunk = ChunkDimensions(dims, imageDims, m_ChunkSize);
+        levelPlist.setChunk(numDims, chunk.data());
+        this->m_H5File->createDataSet(PyramidLevelName(level), dataType, levelSpace, levelPlist);
+      }
+    }
     std::string MetaDataGroupName(groupName);
     MetaDataGroupName += MetaDataName;
     this->m_H5File->createGroup(MetaDataGroupName);
@@ -1280,6 +1412,8 @@ HDF5ImageIO ::Write(const void * buffer)
     H5::DataSpace dspace;
     this->SetupStreaming(&imageSpace, &dspace);
     this->m_VoxelDataSet->write(buffer, dataType, dspace, imageSpace);
+
+    this->WritePyramidLevels(buffer);
   }
   // catch failure caused by the H5File operations
   catch (H5::FileIException & error)
@@ -1303,6 +1437,28 @@ HDF5ImageIO ::Write(const void * buffer)
   }
 }
 
+void
+HDF5ImageIO ::WritePyramidLevels(const void * buffer)
+{
+  const H5::PredType dataType = ComponentToPredType(this->GetComponentType());
+  std::vector<char>  levelBuffer;
+  for (unsigned int level = 1; level < m_NumberOfPyramidLevels; ++level)
+  {
+    const ImageIORegion levelRegion = ImageIOPyramidHelper::DecimateLevel(this, buffer, level, levelBuffer);
+    if (levelBuffer.empty())
+    {
+      continue;
+    }
+
+    H5::DataSet   levelSet = this->m_H5File->openDataSet(PyramidLevelName(level));
+    H5::DataSpace levelSpace = levelSet.getSpace();
+    H5::DataSpace slabSpace;
+    this->SetupStreaming(levelRegion, &levelSpace, &slabSpace);
+    levelSet.write(levelBuffer.data(), dataType, slabSpace, levelSpace);
+    levelSet.close();
+  }
+}
+
 //
 // GetHeaderSize -- return 0
 ImageIOBase::SizeType
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHDF5ImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Write an image with N-D chunks and a pyramid, streaming, and read it back
+// entirely, by streamed regions, and level by level.
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+short
+PixelValue(const ImageType::IndexType & index)
+{
+  return static_cast<short>(index[2] * 1000 + index[1] * 37 + index[0]);
+}
+
+bool
+CheckImage(const ImageType * image, const ImageType::RegionType & region, itk::IndexValueType factor)
+{
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    ImageType::IndexType index = it.GetIndex();
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      index[d] *= factor;
+    }
+    if (it.Get() != PixelValue(index))
+    {
+      std::cerr << "Pixel mismatch at " << it.GetIndex() << " with factor " << factor << ": expected "
+                << PixelValue(index) << ", got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkHDF5ImageIOChunkedPyramidTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkHDF5ImageIOChunkedPyramidTest.hdf5";
+
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 29;
+  size[2] = 23;
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.75;
+  spacing[2] = 2.0;
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->SetSpacing(spacing);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(PixelValue(it.GetIndex()));
+  }
+
+  auto writerIO = itk::HDF5ImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(writerIO, HDF5ImageIO, StreamingImageIOBase);
+
+  const std::vector<itk::SizeValueType> chunkSize{ 8, 8, 4 };
+  writerIO->SetChunkSize(chunkSize);
+  ITK_TEST_EXPECT_TRUE(writerIO->GetChunkSize() == chunkSize);
+  writerIO->SetChunkCacheSize(4 * 1024 * 1024);
+  ITK_TEST_SET_GET_VALUE(4 * 1024 * 1024, writerIO->GetChunkCacheSize());
+  writerIO->SetNumberOfPyramidLevels(3);
+  ITK_TEST_SET_GET_VALUE(3, writerIO->GetNumberOfPyramidLevels());
+
+  // the streamed regions are not aligned with the levels of the pyramid
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetFileName(fileName);
+  writer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  writer = nullptr;
+  writerIO = nullptr;
+
+  // full resolution
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto readerIO = itk::HDF5ImageIO::New();
+  readerIO->SetChunkCacheSize(4 * 1024 * 1024);
+  auto reader = ReaderType::New();
+  reader->SetImageIO(readerIO);
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetNumberOfPyramidLevels(), 3u);
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetLargestPossibleRegion().GetSize(), size);
+  if (!CheckImage(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion(), 1))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // a streamed region crossing several chunks
+  ImageType::RegionType region;
+  region.SetIndex(0, 5);
+  region.SetIndex(1, 3);
+  region.SetIndex(2, 7);
+  region.SetSize(0, 20);
+  region.SetSize(1, 11);
+  region.SetSize(2, 9);
+  auto streamingReader = ReaderType::New();
+  streamingReader->SetImageIO(itk::HDF5ImageIO::New());
+  streamingReader->SetFileName(fileName);
+  streamingReader->SetUseStreaming(true);
+  streamingReader->UpdateOutputInformation();
+  streamingReader->GetOutput()->SetRequestedRegion(region);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+  ITK_TEST_EXPECT_EQUAL(streamingReader->GetOutput()->GetBufferedRegion(), region);
+  if (!CheckImage(streamingReader->GetOutput(), region, 1))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the levels of the pyramid
+  for (unsigned int level = 1; level < 3; ++level)
+  {
+    const itk::IndexValueType factor = itk::IndexValueType{ 1 } << level;
+
+    auto levelIO = itk::HDF5ImageIO::New();
+    levelIO->SetPyramidLevel(level);
+    ITK_TEST_SET_GET_VALUE(level, levelIO->GetPyramidLevel());
+    auto levelReader = ReaderType::New();
+    levelReader->SetImageIO(levelIO);
+    levelReader->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(levelReader->Update());
+
+    const ImageType * levelImage = levelReader->GetOutput();
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      ITK_TEST_EXPECT_EQUAL(levelImage->GetLargestPossibleRegion().GetSize(d),
+                            (size[d] + factor - 1) / static_cast<itk::SizeValueType>(factor));
+      ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(levelImage->GetSpacing()[d], spacing[d] * factor));
+    }
+    if (!CheckImage(levelImage, levelImage->GetLargestPossibleRegion(), factor))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a level which does not exist
+  auto missingLevelIO = itk::HDF5ImageIO::New();
+  missingLevelIO->SetPyramidLevel(3);
+  missingLevelIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_EXCEPTION(missingLevelIO->ReadImageInformation());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFileInformationReader_h
+#define itkImageFileInformationReader_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkImageIOBase.h"
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageFileInformationReader
+ * \brief Read the information of many image files, without their pixels.
+ *
+ * For each file, the size, spacing, origin, direction and pixel type are
+ * read with ReadImageInformation() of the ImageIO able to read it. Finding
+ * that ImageIO through ImageIOFactory::CreateImageIO() asks every registered
+ * ImageIO in turn, each one possibly opening the file. Here the ImageIOs are
+ * tried in the order of likelihood instead: first the one recognized from
+ * the signature at the beginning of the file, when it is a well known
+ * format, then those supporting the extension of the file, then the others.
+ * The ImageIO recognized from the signature reads the file whatever its
+ * extension, so that a MetaImage named "volume.dat" is read by MetaImageIO
+ * although its CanReadFile() only accepts the ".mha" and ".mhd" extensions.
+ *
+ * The files are read in parallel. A file which can not be read does not
+ * stop the others: its information is marked as not valid, with an error
+ * message.
+ *
+ * If a cache file name is set, the information of the files is kept in that
+ * file, and read from it instead of the image files for the files whose
+ * path, modification time and size did not change. The modification time
+ * has a resolution of a second.
+ *
+ * \code
+ * auto informationReader = itk::ImageFileInformationReader::New();
+ * informationReader->SetFileNames(fileNames);
+ * informationReader->SetCacheFileName("information.cache");
+ * informationReader->Update();
+ * for (const auto & information : informationReader->GetInformation())
+ * ...
+ * \endcode
+ *
+ * \sa ImageIOFactory ImageFileReader
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ImageFileInformationReader : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageFileInformationReader);
+
+  /** Standard class type aliases. */
+  using Self = ImageFileInformationReader;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageFileInformationReader, Object);
+
+  /** The information of an image file. */
+  struct InformationType
+  {
+    std::string FileName;
+    /** False if the file could not be read, ErrorMessage telling why. */
+    bool        Valid{ false };
+    std::string ErrorMessage;
+    /** The name of the class of the ImageIO which read the file. */
+    std::string                      ImageIOName;
+    unsigned int                     NumberOfDimensions{ 0 };
+    std::vector<SizeValueType>       Dimensions;
+    std::vector<double>              Spacing;
+    std::vector<double>              Origin;
+    /** The direction of each axis, as given by ImageIOBase::GetDirection(). */
+    std::vector<std::vector<double>> Direction;
+    IOPixelEnum                      PixelType{ IOPixelEnum::UNKNOWNPIXELTYPE };
+    IOComponentEnum                  ComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+    unsigned int                     NumberOfComponents{ 0 };
+  };
+  using InformationContainer = std::vector<InformationType>;
+  using FileNamesContainer = std::vector<std::string>;
+
+  /** Set/Get the files to read. */
+  void
+  SetFileNames(const FileNamesContainer & fileNames);
+  itkGetConstReferenceMacro(FileNames, FileNamesContainer);
+
+  /** Set/Get the cache file. No cache is used if it is empty, the default. */
+  itkSetStringMacro(CacheFileName);
+  itkGetStringMacro(CacheFileName);
+
+  /** Read the information of the files, and update the cache file. */
+  void
+  Update();
+
+  /** Get the information of the files, in the order of the file names. */
+  itkGetConstReferenceMacro(Information, InformationContainer);
+
+  /** Get the number of files whose information was found in the cache by
+   * the last Update(). */
+  itkGetConstMacro(NumberOfCachedFiles, SizeValueType);
+
+  /** Read the information of one file. */
+  static InformationType
+  ReadInformation(const std::string & fileName);
+
+protected:
+  ImageFileInformationReader() = default;
+  ~ImageFileInformationReader() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  FileNamesContainer   m_FileNames;
+  std::string          m_CacheFileName;
+  InformationContainer m_Information;
+  SizeValueType        m_NumberOfCachedFiles{ 0 };
+};
+} // end namespace itk
+
+#endif
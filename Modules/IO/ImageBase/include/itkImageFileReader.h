@@ -27,6 +27,10 @@
 #include "itkImageRegion.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace itk
 {
@@ -55,6 +59,10 @@ namespace itk
  * raw binary format) have no accepted suffix, so you will have to
  * manually create the ImageIO instance of the write type.
  *
+ * When the output is streamed, PrefetchOn() reads the region that is
+ * likely to be requested next in the background, while the downstream
+ * pipeline processes the current region.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -118,9 +126,34 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get whether the next streamed region is read ahead. When on and
+   * the ImageIO reads only a part of the file, the region that will be
+   * requested next is predicted from the last requested regions, assuming
+   * they are slabs visited in order, as requested by StreamingImageFilter
+   * and ImageFileWriter. A second ImageIO reads that region in a separate
+   * thread while the downstream pipeline processes the current one, and
+   * the next read is served from it when it contains the IO region. The
+   * second ImageIO is created with CreateAnother(), so a user specified
+   * ImageIO, whose settings would be lost, is never read ahead. One
+   * background thread serves all the regions read ahead, from the first
+   * one until the output information is generated again. Off by default. */
+  itkSetMacro(Prefetch, bool);
+  itkGetConstReferenceMacro(Prefetch, bool);
+  itkBooleanMacro(Prefetch);
+
+  /** Get the number of reads served by a prefetched region since the output
+   * information was last generated. */
+  itkGetConstMacro(NumberOfPrefetchedReads, SizeValueType);
+
+  /** Get the time, in seconds, spent waiting for the background reads to
+   * complete since the output information was last generated. It is the
+   * part of the reading that the prefetch did not hide behind the
+   * processing of the downstream pipeline. */
+  itkGetConstMacro(PrefetchWaitTime, double);
+
 protected:
   ImageFileReader();
-  ~ImageFileReader() override = default;
+  ~ImageFileReader() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
@@ -163,9 +196,57 @@ protected:
 private:
   std::string m_ExceptionMessage;
 
+  /** Read m_ActualIORegion into a buffer, from the prefetched region when
+   * it contains it. */
+  void
+  ReadActualIORegion(void * buffer);
+
+  /** Predict the region requested after the current one, and start reading
+   * it in the background. */
+  void
+  StartPrefetch();
+
+  /** Read the prefetched regions, one after the other, in the background
+   * thread. */
+  void
+  PrefetchThreadLoop();
+
+  /** Wait for the background read of the prefetched region. */
+  void
+  WaitForPrefetch();
+
+  /** Wait for the background read, stop the background thread and drop the
+   * prefetched region. */
+  void
+  ResetPrefetch();
+
+  /** Copy the pixels of a region from a buffer holding a larger region. */
+  static void
+  CopyIORegion(const char *          inputBuffer,
+               const ImageIORegion & inputRegion,
+               char *                outputBuffer,
+               const ImageIORegion & outputRegion,
+               SizeValueType         pixelSize);
+
   // The region that the ImageIO class will return when we ask to
   // produce the requested region.
   ImageIORegion m_ActualIORegion;
+
+  bool                    m_Prefetch{ false };
+  ImageRegionType         m_RequestedRegion;
+  ImageRegionType         m_PreviousRequestedRegion;
+  ImageIOBase::Pointer    m_PrefetchImageIO;
+  std::thread             m_PrefetchThread;
+  std::mutex              m_PrefetchMutex;
+  std::condition_variable m_PrefetchCondition;
+  bool                    m_PrefetchPending{ false };
+  bool                    m_StopPrefetchThread{ false };
+  ImageIORegion           m_PrefetchIORegion;
+  std::unique_ptr<char[]> m_PrefetchBuffer;
+  SizeValueType           m_PrefetchBufferSize{ 0 };
+  bool                    m_PrefetchSucceeded{ false };
+  SizeValueType           m_NumberOfPrefetchedReads{ 0 };
+  double                  m_PrefetchWaitTime{ 0.0 };
 };
 } // namespace itk
 
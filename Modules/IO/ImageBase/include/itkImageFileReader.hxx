@@ -29,6 +29,8 @@
 #include "itksys/SystemTools.hxx"
 #include <memory> // For unique_ptr
 #include <fstream>
+#include <algorithm>
+#include <chrono>
 
 namespace itk
 {
@@ -41,6 +43,12 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::ImageFileReader()
   m_UseStreaming = true;
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+ImageFileReader<TOutputImage, ConvertPixelTraits>::~ImageFileReader()
+{
+  this->ResetPrefetch();
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os, Indent indent) const
@@ -51,6 +59,9 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   os << indent << "UserSpecifiedImageIO flag: " << m_UserSpecifiedImageIO << "\n";
   os << indent << "m_UseStreaming: " << m_UseStreaming << "\n";
+  os << indent << "Prefetch: " << m_Prefetch << "\n";
+  os << indent << "NumberOfPrefetchedReads: " << m_NumberOfPrefetchedReads << "\n";
+  os << indent << "PrefetchWaitTime: " << m_PrefetchWaitTime << "\n";
 }
 
 template <typename TOutputImage, typename ConvertPixelTraits>
@@ -74,6 +85,13 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
 
   itkDebugMacro(<< "Reading file for GenerateOutputInformation()" << this->GetFileName());
 
+  // the ImageIO may be replaced, and the file may have changed
+  this->ResetPrefetch();
+  m_PrefetchImageIO = nullptr;
+  m_PreviousRequestedRegion = ImageRegionType();
+  m_NumberOfPrefetchedReads = 0;
+  m_PrefetchWaitTime = 0.0;
+
   // Check to see if we can read the file given the name or prefix
   //
   if (this->GetFileName().empty())
@@ -305,6 +323,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::EnlargeOutputRequestedRegion(
   using ImageIOAdaptor = ImageIORegionAdaptor<TOutputImage::ImageDimension>;
 
   ImageIOAdaptor::Convert(imageRequestedRegion, ioRequestedRegion, largestRegion.GetIndex());
+  m_RequestedRegion = imageRequestedRegion;
 
   // Tell the IO if we should use streaming while reading
   m_ImageIO->SetUseStreamedReading(m_UseStreaming);
@@ -404,7 +423,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                   << m_ImageIO->GetNumberOfComponents());
 
     const std::unique_ptr<char[]> loadBuffer(new char[sizeOfActualIORegion]);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    this->ReadActualIORegion(static_cast<void *>(loadBuffer.get()));
 
     // See note below as to why the buffered region is needed and
     // not actualIOregion
@@ -422,7 +441,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     OutputImagePixelType * outputBuffer = output->GetPixelContainer()->GetBufferPointer();
 
     const std::unique_ptr<char[]> loadBuffer(new char[sizeOfActualIORegion]);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    this->ReadActualIORegion(static_cast<void *>(loadBuffer.get()));
 
     // we use std::copy_n here as it should be optimized to memcpy for
     // plain old data, but still is oop
@@ -435,12 +454,266 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     itkDebugMacro(<< "No buffer conversion required.");
 
     OutputImagePixelType * outputBuffer = output->GetPixelContainer()->GetBufferPointer();
-    m_ImageIO->Read(outputBuffer);
+    this->ReadActualIORegion(outputBuffer);
+  }
+
+  if (m_Prefetch)
+  {
+    this->StartPrefetch();
   }
 
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::ReadActualIORegion(void * buffer)
+{
+  this->WaitForPrefetch();
+
+  if (m_PrefetchSucceeded && m_PrefetchIORegion.GetImageDimension() == m_ActualIORegion.GetImageDimension() &&
+      m_PrefetchIORegion.IsInside(m_ActualIORegion))
+  {
+    itkDebugMacro(<< "Reading " << m_ActualIORegion << " from the prefetched region " << m_PrefetchIORegion);
+    const SizeValueType pixelSize = m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+    CopyIORegion(m_PrefetchBuffer.get(), m_PrefetchIORegion, static_cast<char *>(buffer), m_ActualIORegion, pixelSize);
+    ++m_NumberOfPrefetchedReads;
+  }
+  else
+  {
+    m_ImageIO->Read(buffer);
+  }
+  m_PrefetchSucceeded = false;
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::StartPrefetch()
+{
+  const ImageRegionType largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+  const ImageRegionType currentRegion = m_RequestedRegion;
+  const ImageRegionType previousRegion = m_PreviousRequestedRegion;
+  m_PreviousRequestedRegion = currentRegion;
+
+  // nothing to read ahead if the whole file was read
+  if (m_UserSpecifiedImageIO || !m_UseStreaming || !m_ImageIO->CanStreamRead())
+  {
+    return;
+  }
+  SizeValueType numberOfPixelsInFile = 1;
+  for (unsigned int i = 0; i < m_ImageIO->GetNumberOfDimensions(); ++i)
+  {
+    numberOfPixelsInFile *= m_ImageIO->GetDimensions(i);
+  }
+  if (m_ActualIORegion.GetNumberOfPixels() >= numberOfPixelsInFile || currentRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // the regions are assumed to be slabs along one dimension, visited in
+  // order. The step and the overlap of the next slab are the ones of the
+  // last two slabs, or the slab follows the current one along the slowest
+  // dimension which is not requested entirely
+  int dimension = -1;
+  for (unsigned int i = 0; i < TOutputImage::ImageDimension && previousRegion.GetNumberOfPixels() > 0; ++i)
+  {
+    if (previousRegion.GetIndex(i) == currentRegion.GetIndex(i) &&
+        previousRegion.GetSize(i) == currentRegion.GetSize(i))
+    {
+      continue;
+    }
+    if (dimension >= 0 || previousRegion.GetIndex(i) >= currentRegion.GetIndex(i))
+    {
+      dimension = -1;
+      break;
+    }
+    dimension = static_cast<int>(i);
+  }
+  IndexValueType overlap = 0;
+  SizeValueType  size = 0;
+  if (dimension >= 0)
+  {
+    overlap = previousRegion.GetUpperIndex()[dimension] + 1 - currentRegion.GetIndex(dimension);
+    size = std::max(previousRegion.GetSize(dimension), currentRegion.GetSize(dimension));
+  }
+  else
+  {
+    for (int i = TOutputImage::ImageDimension - 1; i >= 0 && dimension < 0; --i)
+    {
+      if (currentRegion.GetSize(i) < largestRegion.GetSize(i))
+      {
+        dimension = i;
+      }
+    }
+    if (dimension < 0)
+    {
+      return;
+    }
+    size = currentRegion.GetSize(dimension);
+  }
+
+  ImageRegionType      nextRegion = currentRegion;
+  const IndexValueType nextIndex = currentRegion.GetUpperIndex()[dimension] + 1 - overlap;
+  const IndexValueType largestEnd = largestRegion.GetUpperIndex()[dimension] + 1;
+  if (nextIndex < largestRegion.GetIndex(dimension) || nextIndex >= largestEnd)
+  {
+    return;
+  }
+  nextRegion.SetIndex(dimension, nextIndex);
+  nextRegion.SetSize(dimension, std::min(size, static_cast<SizeValueType>(largestEnd - nextIndex)));
+
+  try
+  {
+    if (m_PrefetchImageIO.IsNull())
+    {
+      LightObject::Pointer another = m_ImageIO->CreateAnother();
+      m_PrefetchImageIO = dynamic_cast<ImageIOBase *>(another.GetPointer());
+      if (m_PrefetchImageIO.IsNull())
+      {
+        return;
+      }
+      m_PrefetchImageIO->SetFileName(this->GetFileName().c_str());
+      m_PrefetchImageIO->ReadImageInformation();
+      m_PrefetchImageIO->SetUseStreamedReading(true);
+    }
+
+    ImageIORegion ioRequestedRegion(TOutputImage::ImageDimension);
+    ImageIORegionAdaptor<TOutputImage::ImageDimension>::Convert(
+      nextRegion, ioRequestedRegion, largestRegion.GetIndex());
+    m_PrefetchIORegion = m_PrefetchImageIO->GenerateStreamableReadRegionFromRequestedRegion(ioRequestedRegion);
+    m_PrefetchImageIO->SetIORegion(m_PrefetchIORegion);
+  }
+  catch (const ExceptionObject & err)
+  {
+    itkDebugMacro(<< "Could not prefetch " << nextRegion << ": " << err.GetDescription());
+    m_PrefetchImageIO = nullptr;
+    return;
+  }
+
+  const SizeValueType bufferSize = m_PrefetchIORegion.GetNumberOfPixels() * m_PrefetchImageIO->GetComponentSize() *
+                                   m_PrefetchImageIO->GetNumberOfComponents();
+  if (bufferSize != m_PrefetchBufferSize)
+  {
+    m_PrefetchBuffer.reset(new char[bufferSize]);
+    m_PrefetchBufferSize = bufferSize;
+  }
+
+  itkDebugMacro(<< "Prefetching " << m_PrefetchIORegion);
+  if (!m_PrefetchThread.joinable())
+  {
+    m_PrefetchThread = std::thread([this] { this->PrefetchThreadLoop(); });
+  }
+  {
+    const std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    m_PrefetchPending = true;
+  }
+  m_PrefetchCondition.notify_all();
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::PrefetchThreadLoop()
+{
+  std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+  while (true)
+  {
+    m_PrefetchCondition.wait(lock, [this] { return m_PrefetchPending || m_StopPrefetchThread; });
+    if (!m_PrefetchPending)
+    {
+      return;
+    }
+
+    lock.unlock();
+    bool succeeded = false;
+    try
+    {
+      m_PrefetchImageIO->Read(m_PrefetchBuffer.get());
+      succeeded = true;
+    }
+    catch (...)
+    {
+      // the region is read again when it is requested, which reports the error
+    }
+    lock.lock();
+
+    m_PrefetchSucceeded = succeeded;
+    m_PrefetchPending = false;
+    m_PrefetchCondition.notify_all();
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::WaitForPrefetch()
+{
+  std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+  if (m_PrefetchPending)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    m_PrefetchCondition.wait(lock, [this] { return !m_PrefetchPending; });
+    m_PrefetchWaitTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::ResetPrefetch()
+{
+  if (m_PrefetchThread.joinable())
+  {
+    {
+      const std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+      m_StopPrefetchThread = true;
+    }
+    m_PrefetchCondition.notify_all();
+    m_PrefetchThread.join();
+    m_StopPrefetchThread = false;
+  }
+  m_PrefetchPending = false;
+  m_PrefetchSucceeded = false;
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::CopyIORegion(const char *          inputBuffer,
+                                                                const ImageIORegion & inputRegion,
+                                                                char *                outputBuffer,
+                                                                const ImageIORegion & outputRegion,
+                                                                SizeValueType         pixelSize)
+{
+  const unsigned int         dimension = outputRegion.GetImageDimension();
+  std::vector<SizeValueType> inputStrides(dimension);
+  SizeValueType              stride = pixelSize;
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    inputStrides[i] = stride;
+    stride *= inputRegion.GetSize(i);
+  }
+
+  // copy the lines of the output region one after the other
+  const SizeValueType      lineSize = outputRegion.GetSize(0) * pixelSize;
+  const SizeValueType      numberOfLines = outputRegion.GetNumberOfPixels() / outputRegion.GetSize(0);
+  ImageIORegion::IndexType index(outputRegion.GetIndex());
+  for (SizeValueType line = 0; line < numberOfLines; ++line)
+  {
+    SizeValueType offset = 0;
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      offset += static_cast<SizeValueType>(index[i] - inputRegion.GetIndex(i)) * inputStrides[i];
+    }
+    std::copy_n(inputBuffer + offset, lineSize, outputBuffer + line * lineSize);
+
+    for (unsigned int i = 1; i < dimension; ++i)
+    {
+      if (++index[i] < outputRegion.GetIndex(i) + static_cast<IndexValueType>(outputRegion.GetSize(i)))
+      {
+        break;
+      }
+      index[i] = outputRegion.GetIndex(i);
+    }
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void * inputData, size_t numberOfPixels)
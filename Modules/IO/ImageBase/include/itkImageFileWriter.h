@@ -23,6 +23,13 @@
 #include "itkImageIOBase.h"
 #include "itkMacro.h"
 #include "itkMetaProgrammingLibrary.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace itk
 {
@@ -73,6 +80,10 @@ public:
  * with a suitable suffix (".png", ".jpg", etc) and setting the input
  * to the writer is enough to get the writer to work properly.
  *
+ * When the input is written in several pieces, NumberOfWriteBehindBuffers
+ * lets the upstream pipeline compute the next pieces while the previous
+ * ones are written by a separate I/O thread.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -170,6 +181,17 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the number of pieces which can be held for writing while the
+   * upstream pipeline computes the next piece. When it is not zero and the
+   * ImageIO writes the input in several pieces, each piece is copied to a
+   * buffer and written by a separate I/O thread, in order. The writer waits
+   * for a buffer to be free before queuing a new piece, so 1 gives double
+   * buffering and 2 triple buffering. Defaults to 0, which writes each piece
+   * before computing the next one. GenerateData() is not called for the
+   * pieces written behind. */
+  itkSetMacro(NumberOfWriteBehindBuffers, unsigned int);
+  itkGetConstReferenceMacro(NumberOfWriteBehindBuffers, unsigned int);
+
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   void
@@ -222,6 +244,33 @@ protected:
   GenerateData() override;
 
 private:
+  /** The pieces held for the I/O thread of the write-behind mode. */
+  struct WriteBehindQueueType
+  {
+    std::mutex                                              Mutex;
+    std::condition_variable                                 Condition;
+    std::deque<std::pair<ImageIORegion, InputImagePointer>> Pieces;
+    std::vector<InputImagePointer>                          FreeBuffers;
+    unsigned int                                            NumberOfHeldPieces{ 0 };
+    bool                                                    Done{ false };
+    std::exception_ptr                                      Exception;
+    std::thread                                             Thread;
+  };
+
+  /** Copy the current piece of the input and queue it for writing, once a
+   * buffer is free. The I/O thread is started with the first piece. */
+  void
+  QueuePieceForWriting(WriteBehindQueueType & queue, const ImageIORegion & streamIORegion);
+
+  /** Wait for the I/O thread to write the queued pieces, and rethrow the
+   * exception it may have thrown. */
+  void
+  FinishWritingBehind(WriteBehindQueueType & queue);
+
+  /** Body of the I/O thread. */
+  void
+  WritePiecesBehind(WriteBehindQueueType & queue);
+
   std::string m_FileName;
 
   ImageIOBase::Pointer m_ImageIO;
@@ -229,6 +278,7 @@ private:
 
   ImageIORegion m_PasteIORegion{ TInputImage::ImageDimension };
   unsigned int  m_NumberOfStreamDivisions{ 1 };
+  unsigned int  m_NumberOfWriteBehindBuffers{ 0 };
   bool          m_UserSpecifiedIORegion{ false };
 
   bool m_FactorySpecifiedImageIO{ false }; // did factory mechanism set the ImageIO?
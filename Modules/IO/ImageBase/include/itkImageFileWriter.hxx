@@ -268,60 +268,90 @@ ImageFileWriter<TInputImage>::Write()
    */
   unsigned int piece;
 
-  for (piece = 0; piece < numDivisions && !this->GetAbortGenerateData(); piece++)
+  WriteBehindQueueType queue;
+  try
   {
-    // get the actual piece to write
-    ImageIORegion streamIORegion =
-      m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion);
-
-    // Check whether the paste region is fully contained inside the
-    // largest region or not.
-    if (!pasteIORegion.IsInside(streamIORegion))
+    for (piece = 0; piece < numDivisions && !this->GetAbortGenerateData(); piece++)
     {
-      itkExceptionMacro(<< "ImageIO returns streamable region that is not fully contain in paste IO region"
-                        << "Paste IO region: " << pasteIORegion << "Streamable region: " << streamIORegion);
-    }
+      // get the actual piece to write
+      ImageIORegion streamIORegion =
+        m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion);
 
-    InputImageRegionType streamRegion;
-    ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(streamIORegion, streamRegion, largestRegion.GetIndex());
+      // Check whether the paste region is fully contained inside the
+      // largest region or not.
+      if (!pasteIORegion.IsInside(streamIORegion))
+      {
+        itkExceptionMacro(<< "ImageIO returns streamable region that is not fully contain in paste IO region"
+                          << "Paste IO region: " << pasteIORegion << "Streamable region: " << streamIORegion);
+      }
 
-    // execute the the upstream pipeline with the requested
-    // region for streaming
-    nonConstInput->SetRequestedRegion(streamRegion);
-    nonConstInput->PropagateRequestedRegion();
-    nonConstInput->UpdateOutputData();
+      InputImageRegionType streamRegion;
+      ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(
+        streamIORegion, streamRegion, largestRegion.GetIndex());
 
-    if (piece == 0)
-    {
-      // initialize the progress here to mimic the progress behavior of the non
-      // streaming filters, where the progress changes only when the other filters
-      // are done.
-      this->UpdateProgress(0.0f);
-    }
+      // execute the the upstream pipeline with the requested
+      // region for streaming
+      nonConstInput->SetRequestedRegion(streamRegion);
+      nonConstInput->PropagateRequestedRegion();
+      nonConstInput->UpdateOutputData();
 
-    // check to see if we tried to stream but got the largest possible region
-    if (piece == 0 && streamRegion != largestRegion)
-    {
-      InputImageRegionType bufferedRegion = input->GetBufferedRegion();
-      if (bufferedRegion == largestRegion)
+      if (piece == 0)
       {
-        // if so, then just write the entire image
-        itkDebugMacro("Requested stream region  matches largest region input filter may not support streaming well.");
-        itkDebugMacro("Writer is not streaming now!");
-        numDivisions = 1;
-        streamRegion = largestRegion;
-        ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(
-          streamRegion, streamIORegion, largestRegion.GetIndex());
+        // initialize the progress here to mimic the progress behavior of the non
+        // streaming filters, where the progress changes only when the other filters
+        // are done.
+        this->UpdateProgress(0.0f);
       }
-    }
 
-    m_ImageIO->SetIORegion(streamIORegion);
+      // check to see if we tried to stream but got the largest possible region
+      if (piece == 0 && streamRegion != largestRegion)
+      {
+        InputImageRegionType bufferedRegion = input->GetBufferedRegion();
+        if (bufferedRegion == largestRegion)
+        {
+          // if so, then just write the entire image
+          itkDebugMacro(
+            "Requested stream region  matches largest region input filter may not support streaming well.");
+          itkDebugMacro("Writer is not streaming now!");
+          numDivisions = 1;
+          streamRegion = largestRegion;
+          ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(
+            streamRegion, streamIORegion, largestRegion.GetIndex());
+        }
+      }
 
-    // write the data
-    this->GenerateData();
+      if (m_NumberOfWriteBehindBuffers > 0 && numDivisions > 1)
+      {
+        // the piece is written by the I/O thread while the next one is computed
+        this->QueuePieceForWriting(queue, streamIORegion);
+      }
+      else
+      {
+        m_ImageIO->SetIORegion(streamIORegion);
 
-    this->UpdateProgress(static_cast<float>(piece + 1) / static_cast<float>(numDivisions));
+        // write the data
+        this->GenerateData();
+      }
+
+      this->UpdateProgress(static_cast<float>(piece + 1) / static_cast<float>(numDivisions));
+    }
   }
+  catch (...)
+  {
+    // the I/O thread must not outlive the queue
+    {
+      const std::lock_guard<std::mutex> lock(queue.Mutex);
+      queue.Done = true;
+      queue.Pieces.clear();
+    }
+    queue.Condition.notify_all();
+    if (queue.Thread.joinable())
+    {
+      queue.Thread.join();
+    }
+    throw;
+  }
+  this->FinishWritingBehind(queue);
 
   // Notify end event observers
   this->InvokeEvent(EndEvent());
@@ -386,6 +416,124 @@ ImageFileWriter<TInputImage>::GenerateData()
   m_ImageIO->Write(dataPtr);
 }
 
+//---------------------------------------------------------
+template <typename TInputImage>
+void
+ImageFileWriter<TInputImage>::QueuePieceForWriting(WriteBehindQueueType & queue, const ImageIORegion & streamIORegion)
+{
+  const InputImageType * input = this->GetInput();
+  InputImageRegionType   largestRegion = input->GetLargestPossibleRegion();
+  InputImageRegionType   streamRegion;
+  ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(streamIORegion, streamRegion, largestRegion.GetIndex());
+
+  // wait for a free buffer
+  InputImagePointer buffer;
+  {
+    std::unique_lock<std::mutex> lock(queue.Mutex);
+    queue.Condition.wait(lock, [this, &queue] {
+      return queue.NumberOfHeldPieces < m_NumberOfWriteBehindBuffers || queue.Exception;
+    });
+    if (queue.Exception)
+    {
+      std::rethrow_exception(queue.Exception);
+    }
+    ++queue.NumberOfHeldPieces;
+    if (!queue.FreeBuffers.empty())
+    {
+      buffer = queue.FreeBuffers.back();
+      queue.FreeBuffers.pop_back();
+    }
+  }
+
+  // the upstream pipeline reuses the input buffer for the next piece
+  if (buffer.IsNull())
+  {
+    buffer = InputImageType::New();
+  }
+  buffer->CopyInformation(input);
+  buffer->SetBufferedRegion(streamRegion);
+  buffer->Allocate();
+  ImageAlgorithm::Copy(input, buffer.GetPointer(), streamRegion, streamRegion);
+
+  {
+    const std::lock_guard<std::mutex> lock(queue.Mutex);
+    queue.Pieces.emplace_back(streamIORegion, buffer);
+  }
+  queue.Condition.notify_all();
+
+  if (!queue.Thread.joinable())
+  {
+    queue.Thread = std::thread([this, &queue] { this->WritePiecesBehind(queue); });
+  }
+}
+
+//---------------------------------------------------------
+template <typename TInputImage>
+void
+ImageFileWriter<TInputImage>::WritePiecesBehind(WriteBehindQueueType & queue)
+{
+  while (true)
+  {
+    std::pair<ImageIORegion, InputImagePointer> piece;
+    {
+      std::unique_lock<std::mutex> lock(queue.Mutex);
+      queue.Condition.wait(lock, [&queue] { return !queue.Pieces.empty() || queue.Done; });
+      if (queue.Pieces.empty())
+      {
+        return;
+      }
+      piece = std::move(queue.Pieces.front());
+      queue.Pieces.pop_front();
+    }
+
+    try
+    {
+      itkDebugMacro(<< "Writing file: " << m_FileName << " region: " << piece.first);
+      m_ImageIO->SetIORegion(piece.first);
+      m_ImageIO->Write(piece.second->GetBufferPointer());
+    }
+    catch (...)
+    {
+      {
+        const std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Exception = std::current_exception();
+        queue.Pieces.clear();
+      }
+      queue.Condition.notify_all();
+      return;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(queue.Mutex);
+      queue.FreeBuffers.push_back(piece.second);
+      --queue.NumberOfHeldPieces;
+    }
+    queue.Condition.notify_all();
+  }
+}
+
+//---------------------------------------------------------
+template <typename TInputImage>
+void
+ImageFileWriter<TInputImage>::FinishWritingBehind(WriteBehindQueueType & queue)
+{
+  if (!queue.Thread.joinable())
+  {
+    return;
+  }
+  {
+    const std::lock_guard<std::mutex> lock(queue.Mutex);
+    queue.Done = true;
+  }
+  queue.Condition.notify_all();
+  queue.Thread.join();
+
+  if (queue.Exception)
+  {
+    std::rethrow_exception(queue.Exception);
+  }
+}
+
 //---------------------------------------------------------
 template <typename TInputImage>
 void
@@ -407,6 +555,7 @@ ImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "IO Region: " << m_PasteIORegion << "\n";
   os << indent << "Number of Stream Divisions: " << m_NumberOfStreamDivisions << "\n";
+  os << indent << "Number of Write Behind Buffers: " << m_NumberOfWriteBehindBuffers << "\n";
   os << indent << "CompressionLevel: " << m_CompressionLevel << "\n";
 
   if (m_UseCompression)
@@ -661,6 +661,12 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create a new ImageIO of the same type, with the settings of this one,
+   * so that several files can be read concurrently with the same
+   * configuration. Subclasses with their own settings extend it to copy them. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
 
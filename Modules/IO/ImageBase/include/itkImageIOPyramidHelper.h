@@ -0,0 +1,60 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageIOPyramidHelper_h
+#define itkImageIOPyramidHelper_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkImageIOBase.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ *\class ImageIOPyramidHelper
+ * \brief Decimate the pixels written by an ImageIO into the levels of a
+ * resolution pyramid.
+ *
+ * The level k of the pyramid keeps the pixels of the image at the indices
+ * multiple of 2^k, so that each level can be written from any streamed
+ * region of the image. The levels are nearest-sample decimations: they are
+ * not low-pass filtered, and fine details alias in the coarse levels.
+ *
+ * This helper is meant for the ImageIOs writing pyramids, such as
+ * HDF5ImageIO and ZarrImageIO, and is not part of the ImageIOBase API.
+ *
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ImageIOPyramidHelper
+{
+public:
+  /** Get the dimensions of the level \a level of the pyramid of the image of
+   * \a imageIO. */
+  static std::vector<SizeValueType>
+  GetLevelDimensions(const ImageIOBase * imageIO, unsigned int level);
+
+  /** Copy the pixels of the IORegion of \a imageIO in \a buffer which belong
+   * to the level \a level of the pyramid to \a levelBuffer, and return their
+   * region in the level. The region is empty when the IORegion holds no
+   * pixel of the level. */
+  static ImageIORegion
+  DecimateLevel(const ImageIOBase * imageIO, const void * buffer, unsigned int level, std::vector<char> & levelBuffer);
+};
+} // end namespace itk
+
+#endif // itkImageIOPyramidHelper_h
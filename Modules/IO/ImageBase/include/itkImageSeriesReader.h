@@ -173,6 +173,18 @@ public:
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
 
+  /** Set/Get whether the files are read concurrently. The slices are read
+   * on the multi-threader of the reader, at most NumberOfWorkUnits at a
+   * time, directly into their place in the output buffer. When an ImageIO
+   * is set, every work unit reads its files with a clone of it, made with
+   * LightObject::Clone(). ImageIOBase::InternalClone() copies the settings
+   * of ImageIOBase, and ImageIOs with their own settings must extend it to
+   * copy them. If the ImageIO can't be cloned, a warning is issued and the
+   * files are read serially. Off by default. */
+  itkSetMacro(ParallelRead, bool);
+  itkGetConstMacro(ParallelRead, bool);
+  itkBooleanMacro(ParallelRead);
+
 protected:
   ImageSeriesReader()
     : m_ImageIO(nullptr)
@@ -215,12 +227,29 @@ protected:
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
 
+  bool m_ParallelRead{ false };
+
 private:
   using ReaderType = ImageFileReader<TOutputImage>;
 
+  /** Return a clone of the ImageIO set by the user, or nullptr if it can't be cloned. */
+  ImageIOBase::Pointer
+  CloneImageIO() const;
+
   int
   ComputeMovingDimensionIndex(ReaderType * reader);
 
+  /** Read the file of the slice i. When readPixels is true, the pixels of
+   * the slice are read into the output buffer, otherwise only the
+   * information of the file is read. */
+  typename ReaderType::Pointer
+  ReadSlice(int                     i,
+            const IndexType &       sliceStartIndex,
+            const ImageRegionType & sliceRegionToRequest,
+            const SizeType &        validSize,
+            bool                    readPixels,
+            ImageIOBase *           imageIO);
+
   /** Modified time of the MetaDataDictionaryArray */
   TimeStamp m_MetaDataDictionaryArrayMTime;
 
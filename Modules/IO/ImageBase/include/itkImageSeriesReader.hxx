@@ -27,6 +27,7 @@
 #include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
 #include <iomanip>
+#include <exception>
 
 namespace itk
 {
@@ -55,6 +56,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "ParallelRead: " << m_ParallelRead << std::endl;
 
   itkPrintSelfObjectMacro(ImageIO);
 
@@ -293,15 +295,98 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   bool needToUpdateMetaDataDictionaryArray =
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
-  typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-  const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
+  IndexType  sliceStartIndex = requestedRegion.GetIndex();
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
 
   typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
   typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
   double                             maxSpacingDeviation = 0.0;
   bool                               prevSliceIsValid = false;
 
+  // with parallel reads, the slices are read first and their origin and meta
+  // data are kept for the checks below, which need the slices in order. An
+  // ImageIO set by the user is cloned for each work unit, since an ImageIO
+  // can't be shared between threads.
+  bool parallelRead = m_ParallelRead;
+  if (parallelRead && m_ImageIO.IsNotNull() && this->CloneImageIO().IsNull())
+  {
+    itkWarningMacro(<< "The " << m_ImageIO->GetNameOfClass()
+                    << " can't be cloned for each thread, the files are read serially.");
+    parallelRead = false;
+  }
+  std::vector<char>                             sliceRead;
+  std::vector<typename TOutputImage::PointType> sliceOrigins;
+  std::vector<DictionaryType>                   sliceDictionaries;
+  if (parallelRead)
+  {
+    sliceRead.assign(numberOfFiles, 0);
+    sliceOrigins.resize(numberOfFiles);
+    sliceDictionaries.resize(numberOfFiles);
+    std::vector<std::exception_ptr> sliceExceptions(numberOfFiles);
+
+    const bool readAllInformation = needToUpdateMetaDataDictionaryArray;
+
+    // every work unit reads a contiguous range of files with its own ImageIO
+    MultiThreaderBase * multiThreader = this->GetMultiThreader();
+    multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    const auto numberOfWorkUnits =
+      std::min(static_cast<SizeValueType>(numberOfFiles), static_cast<SizeValueType>(this->GetNumberOfWorkUnits()));
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfWorkUnits,
+      [&](SizeValueType workUnit) {
+        const auto first = static_cast<int>(workUnit * numberOfFiles / numberOfWorkUnits);
+        const auto last = static_cast<int>((workUnit + 1) * numberOfFiles / numberOfWorkUnits);
+
+        // without an ImageIO set, each reader creates its own
+        ImageIOBase::Pointer imageIO;
+        if (m_ImageIO.IsNotNull())
+        {
+          imageIO = this->CloneImageIO();
+        }
+
+        for (int i = first; i < last; ++i)
+        {
+          IndexType startIndex = sliceStartIndex;
+          if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+          {
+            startIndex[this->m_NumberOfDimensionsInImage] = i;
+          }
+          const bool insideRequestedRegion = requestedRegion.IsInside(startIndex);
+          if (!insideRequestedRegion && !readAllInformation)
+          {
+            continue;
+          }
+
+          try
+          {
+            typename ReaderType::Pointer reader =
+              this->ReadSlice(i, startIndex, sliceRegionToRequest, validSize, insideRequestedRegion, imageIO);
+
+            sliceOrigins[i] = reader->GetOutput()->GetOrigin();
+            if (reader->GetImageIO() && m_MetaDataDictionaryArrayUpdate)
+            {
+              sliceDictionaries[i] = reader->GetImageIO()->GetMetaDataDictionary();
+            }
+            sliceRead[i] = 1;
+          }
+          catch (...)
+          {
+            sliceExceptions[i] = std::current_exception();
+          }
+        }
+      },
+      this);
+
+    for (const auto & sliceException : sliceExceptions)
+    {
+      if (sliceException)
+      {
+        std::rethrow_exception(sliceException);
+      }
+    }
+  }
+
   for (int i = 0; i != numberOfFiles; ++i)
   {
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
@@ -310,7 +395,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     }
 
     const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
     bool       nonUniformSampling = false;
     double     spacingDeviation = 0.0;
 
@@ -320,110 +404,35 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       continue;
     }
 
-    // configure reader
-    typename ReaderType::Pointer reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
-
-    TOutputImage * readerOutput = reader->GetOutput();
-
-    if (m_ImageIO)
-    {
-      reader->SetImageIO(m_ImageIO);
-    }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
-
-    // update the data or info
-    if (!insideRequestedRegion)
+    typename ReaderType::Pointer     reader;
+    typename TOutputImage::PointType sliceOrigin;
+    const DictionaryType *           sliceDictionary = nullptr;
+    if (parallelRead)
     {
-      reader->UpdateOutputInformation();
+      if (!sliceRead[i])
+      {
+        continue;
+      }
+      sliceOrigin = sliceOrigins[i];
+      sliceDictionary = &sliceDictionaries[i];
     }
     else
     {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
-
-      // propagate the requested region to determin what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
-
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+      reader = this->ReadSlice(i, sliceStartIndex, sliceRegionToRequest, validSize, insideRequestedRegion, m_ImageIO);
+      sliceOrigin = reader->GetOutput()->GetOrigin();
+      if (reader->GetImageIO())
       {
-        itkExceptionMacro(<< "Size mismatch! The size of  " << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
-      }
-
-      // get the size of the region to be read
-      SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
-
-      if (readSize == sliceRegionToRequest.GetSize())
-      {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
-
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
-
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
-
-
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
-
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
-
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
-
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
-        }
-        else
-        {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
-        }
-        readerOutput->UpdateOutputData();
-      }
-      else
-      {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
-
-        reader->Update();
-
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
-
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
-
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+        sliceDictionary = &reader->GetImageIO()->GetMetaDataDictionary();
       }
+    }
 
+    if (insideRequestedRegion)
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -450,19 +459,22 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = sliceOrigin;
         prevSliceIsValid = true;
       }
 
-      // report progress for read slices
-      progress.CompletedPixel();
+      // report progress for read slices, parallel reads report their own
+      if (!parallelRead)
+      {
+        progress.CompletedPixel();
+      }
     } // end !insidedRequestedRegion
 
     // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    if (sliceDictionary && needToUpdateMetaDataDictionaryArray)
     {
       auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      *newDictionary = *sliceDictionary;
       if (nonUniformSampling)
       {
         // slice-specific information
@@ -494,6 +506,134 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   }
 }
 
+template <typename TOutputImage>
+ImageIOBase::Pointer
+ImageSeriesReader<TOutputImage>::CloneImageIO() const
+{
+  try
+  {
+    return dynamic_cast<ImageIOBase *>(m_ImageIO->Clone().GetPointer());
+  }
+  catch (const ExceptionObject &)
+  {
+    return nullptr;
+  }
+}
+
+template <typename TOutputImage>
+auto
+ImageSeriesReader<TOutputImage>::ReadSlice(int                     i,
+                                           const IndexType &       sliceStartIndex,
+                                           const ImageRegionType & sliceRegionToRequest,
+                                           const SizeType &        validSize,
+                                           bool                    readPixels,
+                                           ImageIOBase *           imageIO) -> typename ReaderType::Pointer
+{
+  TOutputImage *        output = this->GetOutput();
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
+  const auto            numberOfFiles = static_cast<int>(m_FileNames.size());
+  const int             iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
+
+  // configure reader
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(m_FileNames[iFileName].c_str());
+
+  TOutputImage * readerOutput = reader->GetOutput();
+
+  if (imageIO)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  reader->SetUseStreaming(m_UseStreaming);
+  readerOutput->SetRequestedRegion(sliceRegionToRequest);
+
+  // update the data or info
+  if (!readPixels)
+  {
+    reader->UpdateOutputInformation();
+    return reader;
+  }
+
+  // read the meta data information
+  readerOutput->UpdateOutputInformation();
+
+  // propagate the requested region to determin what the region
+  // will actually be read
+  readerOutput->PropagateRequestedRegion();
+
+  // check that the size of each slice is the same
+  if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+  {
+    itkExceptionMacro(<< "Size mismatch! The size of  " << m_FileNames[iFileName].c_str() << " is "
+                      << readerOutput->GetLargestPossibleRegion().GetSize() << " and does not match the required size "
+                      << validSize << " from file " << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+  }
+
+  // get the size of the region to be read
+  SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+
+  if (readSize == sliceRegionToRequest.GetSize())
+  {
+    // if the buffer of the ImageReader is going to match that of
+    // ourselves, then set the ImageReader's buffer to a section
+    // of ours
+
+    const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+    using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+    const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+
+    const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                    ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                    : 0;
+
+    const ptrdiff_t numberOfPixelComponentsUpToSlice =
+      numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+    const bool bufferDelete = false;
+
+    typename TOutputImage::InternalPixelType * outputSliceBuffer =
+      output->GetBufferPointer() + numberOfPixelComponentsUpToSlice;
+
+    if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+    {
+      // if the input image type is a vector image then the number
+      // of components needs to be set for the size
+      readerOutput->GetPixelContainer()->SetImportPointer(
+        outputSliceBuffer,
+        static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+        bufferDelete);
+    }
+    else
+    {
+      // otherwise the actual number of pixels needs to be passed
+      readerOutput->GetPixelContainer()->SetImportPointer(
+        outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+    }
+    readerOutput->UpdateOutputData();
+  }
+  else
+  {
+    // the read region isn't going to match exactly what we need
+    // to update to buffer created by the reader, then copy
+
+    reader->Update();
+
+    // output of buffer copy
+    ImageRegionType outRegion = requestedRegion;
+    outRegion.SetIndex(sliceStartIndex);
+
+    // set the moving dimension to a size of 1
+    if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+    {
+      outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+    }
+
+    ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+  }
+  return reader;
+}
+
 template <typename TOutputImage>
 typename ImageSeriesReader<TOutputImage>::DictionaryArrayRawPointer
 ImageSeriesReader<TOutputImage>::GetMetaDataDictionaryArray() const
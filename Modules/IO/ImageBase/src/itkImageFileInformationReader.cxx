@@ -0,0 +1,488 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileInformationReader.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumberToString.h"
+#include "itksys/SystemTools.hxx"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace itk
+{
+namespace
+{
+using InformationType = ImageFileInformationReader::InformationType;
+using ImageIOContainer = std::vector<ImageIOBase::Pointer>;
+
+const char * const CacheHeader = "# ITK image file information 1";
+
+ImageIOContainer
+CreateImageIOs()
+{
+  static std::mutex           createImageIOsLock;
+  std::lock_guard<std::mutex> mutexHolder(createImageIOsLock);
+
+  ImageIOContainer imageIOs;
+  for (auto & allobject : ObjectFactoryBase::CreateAllInstance("itkImageIOBase"))
+  {
+    auto * io = dynamic_cast<ImageIOBase *>(allobject.GetPointer());
+    if (io)
+    {
+      imageIOs.emplace_back(io);
+    }
+  }
+  return imageIOs;
+}
+
+/** The name of the ImageIO reading the format recognized from the first
+ * bytes of a file, or an empty string. */
+std::string
+GuessImageIOName(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    return std::string();
+  }
+  char header[352] = {};
+  file.read(header, sizeof(header));
+  const auto size = static_cast<size_t>(file.gcount());
+
+  const auto startsWith = [&](size_t offset, const char * signature, size_t length) {
+    return size >= offset + length && std::memcmp(header + offset, signature, length) == 0;
+  };
+  if (startsWith(0, "\x89PNG", 4))
+  {
+    return "PNGImageIO";
+  }
+  if (startsWith(0, "\xFF\xD8\xFF", 3))
+  {
+    return "JPEGImageIO";
+  }
+  if (startsWith(0, "II*\0", 4) || startsWith(0, "MM\0*", 4) || startsWith(0, "II+\0", 4) ||
+      startsWith(0, "MM\0+", 4))
+  {
+    return "TIFFImageIO";
+  }
+  if (startsWith(0, "\x89HDF\r\n\x1A\n", 8))
+  {
+    return "HDF5ImageIO";
+  }
+  if (startsWith(0, "NRRD", 4))
+  {
+    return "NrrdImageIO";
+  }
+  if (startsWith(0, "ObjectType", 10) || startsWith(0, "NDims", 5))
+  {
+    return "MetaImageIO";
+  }
+  if (startsWith(0, "# vtk DataFile", 14))
+  {
+    return "VTKImageIO";
+  }
+  if (startsWith(128, "DICM", 4))
+  {
+    return "GDCMImageIO";
+  }
+  if (startsWith(344, "n+1\0", 4) || startsWith(344, "ni1\0", 4) || startsWith(4, "n+2\0", 4) ||
+      startsWith(4, "ni2\0", 4))
+  {
+    return "NiftiImageIO";
+  }
+  if (startsWith(0, "BM", 2))
+  {
+    return "BMPImageIO";
+  }
+  return std::string();
+}
+
+/** Order the ImageIOs by likelihood of reading a file: the one named
+ * guessedName first, then those supporting the extension of the file. */
+std::vector<ImageIOBase *>
+OrderImageIOs(const std::string & fileName, const std::string & guessedName, const ImageIOContainer & imageIOs)
+{
+  const std::string lowerFileName = itksys::SystemTools::LowerCase(fileName);
+
+  std::vector<ImageIOBase *> guessed;
+  std::vector<ImageIOBase *> extension;
+  std::vector<ImageIOBase *> others;
+  for (const auto & io : imageIOs)
+  {
+    if (!guessedName.empty() && guessedName == io->GetNameOfClass())
+    {
+      guessed.push_back(io);
+      continue;
+    }
+    bool supported = false;
+    for (const auto & ext : io->GetSupportedReadExtensions())
+    {
+      const std::string lowerExt = itksys::SystemTools::LowerCase(ext);
+      supported = supported || (!lowerExt.empty() && lowerFileName.size() > lowerExt.size() &&
+                                lowerFileName.compare(lowerFileName.size() - lowerExt.size(), lowerExt.size(),
+                                                      lowerExt) == 0);
+    }
+    (supported ? extension : others).push_back(io);
+  }
+  guessed.insert(guessed.end(), extension.begin(), extension.end());
+  guessed.insert(guessed.end(), others.begin(), others.end());
+  return guessed;
+}
+
+/** Read the information of a file with a new instance of candidate. */
+void
+ReadInformationWithImageIO(ImageIOBase * candidate, InformationType & information)
+{
+  // a new ImageIO reads each file, as ImageFileReader does
+  ImageIOBase::Pointer io = dynamic_cast<ImageIOBase *>(candidate->CreateAnother().GetPointer());
+  if (io.IsNull())
+  {
+    io = candidate;
+  }
+  io->SetFileName(information.FileName);
+  io->ReadImageInformation();
+
+  const unsigned int numberOfDimensions = io->GetNumberOfDimensions();
+  information.ImageIOName = io->GetNameOfClass();
+  information.NumberOfDimensions = numberOfDimensions;
+  information.Dimensions.resize(numberOfDimensions);
+  information.Spacing.resize(numberOfDimensions);
+  information.Origin.resize(numberOfDimensions);
+  information.Direction.resize(numberOfDimensions);
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    information.Dimensions[d] = io->GetDimensions(d);
+    information.Spacing[d] = io->GetSpacing(d);
+    information.Origin[d] = io->GetOrigin(d);
+    information.Direction[d] = io->GetDirection(d);
+  }
+  information.PixelType = io->GetPixelType();
+  information.ComponentType = io->GetComponentType();
+  information.NumberOfComponents = io->GetNumberOfComponents();
+  information.Valid = true;
+}
+
+void
+ReadInformationWithImageIOs(const ImageIOContainer & imageIOs, InformationType & information)
+{
+  information.Valid = false;
+  information.ErrorMessage.clear();
+
+  // The ImageIO recognized from the signature reads the file even when its
+  // CanReadFile() would reject the extension of the file. If it fails, the
+  // file is offered to the ImageIOs as ImageIOFactory would do.
+  const std::string                guessedName = GuessImageIOName(information.FileName);
+  const std::vector<ImageIOBase *> candidates = OrderImageIOs(information.FileName, guessedName, imageIOs);
+  auto                             candidate = candidates.begin();
+  if (candidate != candidates.end() && !guessedName.empty() && guessedName == (*candidate)->GetNameOfClass())
+  {
+    try
+    {
+      ReadInformationWithImageIO(*candidate, information);
+      return;
+    }
+    catch (const std::exception &)
+    {
+      information.Valid = false;
+    }
+    ++candidate;
+  }
+
+  try
+  {
+    for (; candidate != candidates.end(); ++candidate)
+    {
+      if ((*candidate)->CanReadFile(information.FileName.c_str()))
+      {
+        ReadInformationWithImageIO(*candidate, information);
+        return;
+      }
+    }
+    information.ErrorMessage = "Could not create IO object for reading file " + information.FileName;
+  }
+  catch (const std::exception & e)
+  {
+    information.ErrorMessage = e.what();
+  }
+}
+
+/** A file as it was when its information was read. */
+struct CacheEntry
+{
+  long long       ModifiedTime{ 0 };
+  long long       Size{ 0 };
+  InformationType Information;
+};
+using CacheType = std::map<std::string, CacheEntry>;
+
+bool
+GetFileStatus(const std::string & fileName, long long & modifiedTime, long long & size)
+{
+  itksys::SystemTools::Stat_t status;
+  if (itksys::SystemTools::Stat(fileName, &status) != 0)
+  {
+    return false;
+  }
+  modifiedTime = static_cast<long long>(status.st_mtime);
+  size = static_cast<long long>(status.st_size);
+  return true;
+}
+
+void
+ReadCache(const std::string & cacheFileName, CacheType & cache)
+{
+  std::ifstream file(cacheFileName.c_str());
+  std::string   line;
+  if (!file.is_open() || !std::getline(file, line) || line != CacheHeader)
+  {
+    return;
+  }
+
+  // path, modification time, size, ImageIO, pixel type, component type,
+  // number of components, number of dimensions, then the dimensions,
+  // spacing, origin and direction
+  while (std::getline(file, line))
+  {
+    std::vector<std::string> fields;
+    std::istringstream       fieldStream(line);
+    std::string              field;
+    while (std::getline(fieldStream, field, '\t'))
+    {
+      fields.push_back(field);
+    }
+
+    try
+    {
+      if (fields.size() < 8)
+      {
+        continue;
+      }
+      CacheEntry entry;
+      entry.ModifiedTime = std::stoll(fields[1]);
+      entry.Size = std::stoll(fields[2]);
+      InformationType & information = entry.Information;
+      information.FileName = fields[0];
+      information.ImageIOName = fields[3];
+      information.PixelType = ImageIOBase::GetPixelTypeFromString(fields[4]);
+      information.ComponentType = ImageIOBase::GetComponentTypeFromString(fields[5]);
+      information.NumberOfComponents = static_cast<unsigned int>(std::stoul(fields[6]));
+      const unsigned int n = information.NumberOfDimensions = static_cast<unsigned int>(std::stoul(fields[7]));
+      if (fields.size() != 8 + 3 * n + n * n)
+      {
+        continue;
+      }
+      size_t f = 8;
+      for (unsigned int d = 0; d < n; ++d)
+      {
+        information.Dimensions.push_back(static_cast<SizeValueType>(std::stoull(fields[f++])));
+      }
+      for (unsigned int d = 0; d < n; ++d)
+      {
+        information.Spacing.push_back(std::stod(fields[f++]));
+      }
+      for (unsigned int d = 0; d < n; ++d)
+      {
+        information.Origin.push_back(std::stod(fields[f++]));
+      }
+      information.Direction.resize(n);
+      for (unsigned int d = 0; d < n; ++d)
+      {
+        for (unsigned int e = 0; e < n; ++e)
+        {
+          information.Direction[d].push_back(std::stod(fields[f++]));
+        }
+      }
+      information.Valid = true;
+      cache[information.FileName] = entry;
+    }
+    catch (const std::exception &)
+    {
+      // a corrupted line is ignored, the file will be read again
+    }
+  }
+}
+
+void
+WriteCache(const std::string & cacheFileName, const CacheType & cache)
+{
+  std::ofstream file(cacheFileName.c_str(), std::ios::out | std::ios::trunc);
+  if (!file.is_open())
+  {
+    itkGenericExceptionMacro(<< "Cannot write the cache file " << cacheFileName);
+  }
+
+  NumberToString<double> toString;
+  file << CacheHeader << '\n';
+  for (const auto & item : cache)
+  {
+    const InformationType & information = item.second.Information;
+    if (information.FileName.find_first_of("\t\n") != std::string::npos)
+    {
+      continue;
+    }
+    file << information.FileName << '\t' << item.second.ModifiedTime << '\t' << item.second.Size << '\t'
+         << information.ImageIOName << '\t' << ImageIOBase::GetPixelTypeAsString(information.PixelType) << '\t'
+         << ImageIOBase::GetComponentTypeAsString(information.ComponentType) << '\t'
+         << information.NumberOfComponents << '\t' << information.NumberOfDimensions;
+    for (const auto dimension : information.Dimensions)
+    {
+      file << '\t' << dimension;
+    }
+    for (const auto spacing : information.Spacing)
+    {
+      file << '\t' << toString(spacing);
+    }
+    for (const auto origin : information.Origin)
+    {
+      file << '\t' << toString(origin);
+    }
+    for (const auto & axis : information.Direction)
+    {
+      for (const auto value : axis)
+      {
+        file << '\t' << toString(value);
+      }
+    }
+    file << '\n';
+  }
+  if (file.fail())
+  {
+    itkGenericExceptionMacro(<< "Failed writing the cache file " << cacheFileName);
+  }
+}
+} // namespace
+
+void
+ImageFileInformationReader::SetFileNames(const FileNamesContainer & fileNames)
+{
+  if (m_FileNames != fileNames)
+  {
+    m_FileNames = fileNames;
+    this->Modified();
+  }
+}
+
+ImageFileInformationReader::InformationType
+ImageFileInformationReader::ReadInformation(const std::string & fileName)
+{
+  InformationType information;
+  information.FileName = fileName;
+  ReadInformationWithImageIOs(CreateImageIOs(), information);
+  return information;
+}
+
+void
+ImageFileInformationReader::Update()
+{
+  const SizeValueType numberOfFiles = m_FileNames.size();
+  m_Information.assign(numberOfFiles, InformationType());
+  m_NumberOfCachedFiles = 0;
+
+  // the files are identified in the cache by their full path
+  CacheType                cache;
+  std::vector<std::string> fullPaths(numberOfFiles);
+  std::vector<CacheEntry>  entries(numberOfFiles);
+  std::vector<bool>        toRead(numberOfFiles, true);
+  const bool               useCache = !m_CacheFileName.empty();
+  if (useCache)
+  {
+    ReadCache(m_CacheFileName, cache);
+  }
+  for (SizeValueType i = 0; i < numberOfFiles; ++i)
+  {
+    m_Information[i].FileName = m_FileNames[i];
+    if (!useCache)
+    {
+      continue;
+    }
+    if (!GetFileStatus(m_FileNames[i], entries[i].ModifiedTime, entries[i].Size))
+    {
+      continue;
+    }
+    fullPaths[i] = itksys::SystemTools::CollapseFullPath(m_FileNames[i]);
+    const auto cached = cache.find(fullPaths[i]);
+    if (cached != cache.end() && cached->second.ModifiedTime == entries[i].ModifiedTime &&
+        cached->second.Size == entries[i].Size)
+    {
+      m_Information[i] = cached->second.Information;
+      m_Information[i].FileName = m_FileNames[i];
+      toRead[i] = false;
+      ++m_NumberOfCachedFiles;
+    }
+  }
+
+  std::vector<SizeValueType> filesToRead;
+  for (SizeValueType i = 0; i < numberOfFiles; ++i)
+  {
+    if (toRead[i])
+    {
+      filesToRead.push_back(i);
+    }
+  }
+
+  // each work unit has its own ImageIOs
+  if (!filesToRead.empty())
+  {
+    MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+    const SizeValueType        numberOfWorkUnits =
+      std::min(static_cast<SizeValueType>(filesToRead.size()),
+               static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()));
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfWorkUnits,
+      [&](SizeValueType workUnit) {
+        const ImageIOContainer imageIOs = CreateImageIOs();
+        const SizeValueType    first = workUnit * filesToRead.size() / numberOfWorkUnits;
+        const SizeValueType    last = (workUnit + 1) * filesToRead.size() / numberOfWorkUnits;
+        for (SizeValueType f = first; f < last; ++f)
+        {
+          ReadInformationWithImageIOs(imageIOs, m_Information[filesToRead[f]]);
+        }
+      },
+      nullptr);
+  }
+
+  if (useCache)
+  {
+    for (const SizeValueType i : filesToRead)
+    {
+      if (m_Information[i].Valid && !fullPaths[i].empty())
+      {
+        CacheEntry & entry = cache[fullPaths[i]];
+        entry.ModifiedTime = entries[i].ModifiedTime;
+        entry.Size = entries[i].Size;
+        entry.Information = m_Information[i];
+        entry.Information.FileName = fullPaths[i];
+      }
+    }
+    WriteCache(m_CacheFileName, cache);
+  }
+}
+
+void
+ImageFileInformationReader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfFileNames: " << m_FileNames.size() << std::endl;
+  os << indent << "CacheFileName: " << m_CacheFileName << std::endl;
+  os << indent << "NumberOfCachedFiles: " << m_NumberOfCachedFiles << std::endl;
+}
+} // end namespace itk
@@ -1152,6 +1152,43 @@ ImageIOBase::GetDefaultDirection(unsigned int k) const
   return axis;
 }
 
+LightObject::Pointer
+ImageIOBase::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+  auto *               rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+
+  rval->SetFileName(m_FileName);
+  rval->m_PixelType = m_PixelType;
+  rval->m_ComponentType = m_ComponentType;
+  rval->m_ByteOrder = m_ByteOrder;
+  rval->m_FileType = m_FileType;
+  rval->m_NumberOfComponents = m_NumberOfComponents;
+  rval->m_NumberOfDimensions = m_NumberOfDimensions;
+  rval->m_Dimensions = m_Dimensions;
+  rval->m_Spacing = m_Spacing;
+  rval->m_Origin = m_Origin;
+  rval->m_Direction = m_Direction;
+  rval->m_Strides = m_Strides;
+  rval->m_IORegion = m_IORegion;
+  rval->m_UseCompression = m_UseCompression;
+  rval->m_CompressionLevel = std::min(m_CompressionLevel, rval->m_MaximumCompressionLevel);
+  if (rval->m_Compressor != m_Compressor)
+  {
+    rval->SetCompressor(m_Compressor);
+  }
+  rval->m_UseStreamedReading = m_UseStreamedReading;
+  rval->m_UseStreamedWriting = m_UseStreamedWriting;
+  rval->m_ExpandRGBPalette = m_ExpandRGBPalette;
+  rval->m_WritePalette = m_WritePalette;
+
+  return loPtr;
+}
+
 void
 ImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
 {
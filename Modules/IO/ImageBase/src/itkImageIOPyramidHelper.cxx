@@ -0,0 +1,100 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageIOPyramidHelper.h"
+
+#include <algorithm>
+
+namespace itk
+{
+std::vector<SizeValueType>
+ImageIOPyramidHelper::GetLevelDimensions(const ImageIOBase * imageIO, unsigned int level)
+{
+  const SizeValueType        factor = SizeValueType{ 1 } << level;
+  std::vector<SizeValueType> levelDimensions(imageIO->GetNumberOfDimensions());
+  for (unsigned int i = 0; i < levelDimensions.size(); ++i)
+  {
+    levelDimensions[i] = (imageIO->GetDimensions(i) + factor - 1) / factor;
+  }
+  return levelDimensions;
+}
+
+ImageIORegion
+ImageIOPyramidHelper::DecimateLevel(const ImageIOBase * imageIO,
+                                    const void *        buffer,
+                                    unsigned int        level,
+                                    std::vector<char> & levelBuffer)
+{
+  const ImageIORegion & region = imageIO->GetIORegion();
+  const unsigned int    numberOfDimensions = imageIO->GetNumberOfDimensions();
+  const SizeValueType   pixelSize = imageIO->GetComponentSize() * imageIO->GetNumberOfComponents();
+  const auto *          in = static_cast<const char *>(buffer);
+
+  // offsets of the pixels of the region in the buffer
+  std::vector<IndexValueType> regionIndex(numberOfDimensions, 0);
+  std::vector<SizeValueType>  strides(numberOfDimensions);
+  SizeValueType               stride = pixelSize;
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    const bool inRegion = d < region.GetImageDimension();
+    regionIndex[d] = inRegion ? region.GetIndex(d) : 0;
+    strides[d] = stride;
+    stride *= inRegion ? region.GetSize(d) : 1;
+  }
+
+  // the pixels of the level are those with indices multiple of the factor
+  const SizeValueType factor = SizeValueType{ 1 } << level;
+  ImageIORegion       levelRegion(numberOfDimensions);
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    const SizeValueType size = d < region.GetImageDimension() ? region.GetSize(d) : 1;
+    const auto          start = static_cast<SizeValueType>(regionIndex[d]);
+    const SizeValueType levelStart = (start + factor - 1) / factor;
+    const SizeValueType levelEnd = (start + size + factor - 1) / factor;
+    levelRegion.SetIndex(d, static_cast<IndexValueType>(levelStart));
+    levelRegion.SetSize(d, levelEnd > levelStart ? levelEnd - levelStart : 0);
+  }
+
+  levelBuffer.resize(levelRegion.GetNumberOfPixels() * pixelSize);
+  if (levelBuffer.empty())
+  {
+    return levelRegion;
+  }
+
+  std::vector<IndexValueType> levelIndex(levelRegion.GetIndex());
+  for (char * out = levelBuffer.data(); out != levelBuffer.data() + levelBuffer.size(); out += pixelSize)
+  {
+    SizeValueType offset = 0;
+    for (unsigned int d = 0; d < numberOfDimensions; ++d)
+    {
+      offset += static_cast<SizeValueType>(levelIndex[d] * static_cast<IndexValueType>(factor) - regionIndex[d]) *
+                strides[d];
+    }
+    std::copy_n(in + offset, pixelSize, out);
+
+    for (unsigned int d = 0; d < numberOfDimensions; ++d)
+    {
+      if (++levelIndex[d] < levelRegion.GetIndex(d) + static_cast<IndexValueType>(levelRegion.GetSize(d)))
+      {
+        break;
+      }
+      levelIndex[d] = levelRegion.GetIndex(d);
+    }
+  }
+  return levelRegion;
+}
+} // end namespace itk
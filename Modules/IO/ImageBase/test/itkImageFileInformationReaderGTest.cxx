@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileInformationReader.h"
+#include "itkImageFileWriter.h"
+#include "itkRGBPixel.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredIOFactories.h"
+
+#include <fstream>
+
+#define ITK_STRINGIFY_HELPER(s) #s
+#define ITK_STRINGIFY(s) ITK_STRINGIFY_HELPER(s)
+
+namespace
+{
+
+class ImageFileInformationReaderFixture : public ::testing::Test
+{
+public:
+  using VolumeType = itk::Image<short, 3>;
+  using FloatImageType = itk::Image<float, 2>;
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 2>;
+  using InformationType = itk::ImageFileInformationReader::InformationType;
+
+protected:
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(ITK_STRINGIFY(ITK_TEST_OUTPUT_DIR));
+  }
+
+  static void
+  WriteVolume(const std::string & fileName)
+  {
+    auto image = VolumeType::New();
+    image->SetRegions(VolumeType::SizeType{ { 7, 5, 3 } });
+    const double spacing[] = { 0.5, 0.75, 2.5 };
+    const double origin[] = { -3.0, 4.0, 12.0 };
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    VolumeType::DirectionType direction;
+    direction.Fill(0.0);
+    direction[0][1] = 1.0;
+    direction[1][0] = -1.0;
+    direction[2][2] = 1.0;
+    image->SetDirection(direction);
+    image->Allocate(true);
+    itk::WriteImage(image, fileName);
+  }
+
+  static void
+  WriteFloatImage(const std::string & fileName, itk::SizeValueType size)
+  {
+    auto image = FloatImageType::New();
+    image->SetRegions(FloatImageType::SizeType{ { size, size + 1 } });
+    image->Allocate(true);
+    itk::WriteImage(image, fileName);
+  }
+
+  static void
+  WriteRGBImage(const std::string & fileName)
+  {
+    auto image = RGBImageType::New();
+    image->SetRegions(RGBImageType::SizeType{ { 9, 4 } });
+    image->Allocate(true);
+    itk::WriteImage(image, fileName);
+  }
+
+  static void
+  ExpectVolumeInformation(const InformationType & information)
+  {
+    ASSERT_TRUE(information.Valid) << information.ErrorMessage;
+    EXPECT_EQ(information.ImageIOName, "MetaImageIO");
+    ASSERT_EQ(information.NumberOfDimensions, 3u);
+    EXPECT_EQ(information.Dimensions, (std::vector<itk::SizeValueType>{ 7, 5, 3 }));
+    EXPECT_EQ(information.Spacing, (std::vector<double>{ 0.5, 0.75, 2.5 }));
+    EXPECT_EQ(information.Origin, (std::vector<double>{ -3.0, 4.0, 12.0 }));
+    EXPECT_EQ(information.Direction[0], (std::vector<double>{ 0.0, -1.0, 0.0 }));
+    EXPECT_EQ(information.Direction[1], (std::vector<double>{ 1.0, 0.0, 0.0 }));
+    EXPECT_EQ(information.Direction[2], (std::vector<double>{ 0.0, 0.0, 1.0 }));
+    EXPECT_EQ(information.PixelType, itk::IOPixelEnum::SCALAR);
+    EXPECT_EQ(information.ComponentType, itk::IOComponentEnum::SHORT);
+    EXPECT_EQ(information.NumberOfComponents, 1u);
+  }
+
+  // Files of several formats, one with an unknown extension, one which is
+  // not an image and one which does not exist
+  static std::vector<std::string>
+  WriteFiles(const std::string & prefix)
+  {
+    WriteVolume(prefix + "volume.mha");
+    WriteFloatImage(prefix + "float.nrrd", 6);
+    WriteRGBImage(prefix + "rgb.png");
+    itksys::SystemTools::CopyAFile(prefix + "volume.mha", prefix + "volume.dat");
+    std::ofstream text(prefix + "text.txt");
+    text << "not an image" << std::endl;
+    text.close();
+    itksys::SystemTools::RemoveFile(prefix + "missing.mha");
+
+    return { prefix + "volume.mha", prefix + "float.nrrd", prefix + "rgb.png",
+             prefix + "volume.dat", prefix + "text.txt",   prefix + "missing.mha" };
+  }
+
+  static void
+  ExpectInformation(const itk::ImageFileInformationReader::InformationContainer & information,
+                    itk::SizeValueType                                          floatImageSize)
+  {
+    ASSERT_EQ(information.size(), 6u);
+
+    ExpectVolumeInformation(information[0]);
+
+    ASSERT_TRUE(information[1].Valid) << information[1].ErrorMessage;
+    EXPECT_EQ(information[1].ImageIOName, "NrrdImageIO");
+    EXPECT_EQ(information[1].Dimensions, (std::vector<itk::SizeValueType>{ floatImageSize, floatImageSize + 1 }));
+    EXPECT_EQ(information[1].ComponentType, itk::IOComponentEnum::FLOAT);
+
+    ASSERT_TRUE(information[2].Valid) << information[2].ErrorMessage;
+    EXPECT_EQ(information[2].ImageIOName, "PNGImageIO");
+    EXPECT_EQ(information[2].Dimensions, (std::vector<itk::SizeValueType>{ 9, 4 }));
+    EXPECT_EQ(information[2].PixelType, itk::IOPixelEnum::RGB);
+    EXPECT_EQ(information[2].NumberOfComponents, 3u);
+
+    // found from the signature of the file
+    ExpectVolumeInformation(information[3]);
+
+    EXPECT_FALSE(information[4].Valid);
+    EXPECT_FALSE(information[4].ErrorMessage.empty());
+    EXPECT_FALSE(information[5].Valid);
+    EXPECT_FALSE(information[5].ErrorMessage.empty());
+  }
+};
+
+} // namespace
+
+
+TEST_F(ImageFileInformationReaderFixture, ReadInformation)
+{
+  const std::vector<std::string> fileNames = WriteFiles("itkImageFileInformationReaderGTest_");
+
+  auto informationReader = itk::ImageFileInformationReader::New();
+  informationReader->SetFileNames(fileNames);
+  EXPECT_EQ(informationReader->GetFileNames(), fileNames);
+  informationReader->Update();
+  EXPECT_EQ(informationReader->GetNumberOfCachedFiles(), 0u);
+  ExpectInformation(informationReader->GetInformation(), 6);
+  for (unsigned int i = 0; i < fileNames.size(); ++i)
+  {
+    EXPECT_EQ(informationReader->GetInformation()[i].FileName, fileNames[i]);
+  }
+
+  ExpectVolumeInformation(itk::ImageFileInformationReader::ReadInformation(fileNames[0]));
+}
+
+
+TEST_F(ImageFileInformationReaderFixture, Cache)
+{
+  const std::vector<std::string> fileNames = WriteFiles("itkImageFileInformationReaderGTestCache_");
+  const std::string              cacheFileName = "itkImageFileInformationReaderGTest.cache";
+  itksys::SystemTools::RemoveFile(cacheFileName);
+
+  auto informationReader = itk::ImageFileInformationReader::New();
+  informationReader->SetFileNames(fileNames);
+  informationReader->SetCacheFileName(cacheFileName);
+  EXPECT_EQ(informationReader->GetCacheFileName(), cacheFileName);
+  informationReader->Update();
+  EXPECT_EQ(informationReader->GetNumberOfCachedFiles(), 0u);
+  ExpectInformation(informationReader->GetInformation(), 6);
+  EXPECT_TRUE(itksys::SystemTools::FileExists(cacheFileName, true));
+
+  // the files which could be read are now in the cache
+  auto cachedReader = itk::ImageFileInformationReader::New();
+  cachedReader->SetFileNames(fileNames);
+  cachedReader->SetCacheFileName(cacheFileName);
+  cachedReader->Update();
+  EXPECT_EQ(cachedReader->GetNumberOfCachedFiles(), 4u);
+  ExpectInformation(cachedReader->GetInformation(), 6);
+  for (unsigned int i = 0; i < fileNames.size(); ++i)
+  {
+    EXPECT_EQ(cachedReader->GetInformation()[i].FileName, fileNames[i]);
+  }
+
+  // a file which changed is read again
+  WriteFloatImage(fileNames[1], 11);
+  cachedReader->Update();
+  EXPECT_EQ(cachedReader->GetNumberOfCachedFiles(), 3u);
+  ExpectInformation(cachedReader->GetInformation(), 11);
+}
@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkStreamingImageFilter.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredIOFactories.h"
+
+#define ITK_STRINGIFY_HELPER(s) #s
+#define ITK_STRINGIFY(s) ITK_STRINGIFY_HELPER(s)
+
+namespace
+{
+
+class ImageFileReaderPrefetchFixture : public ::testing::Test
+{
+public:
+  using ImageType = itk::Image<short, 3>;
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+
+protected:
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(ITK_STRINGIFY(ITK_TEST_OUTPUT_DIR));
+
+    m_Image = ImageType::New();
+    m_Image->SetRegions(ImageType::SizeType{ { 31, 17, 20 } });
+    m_Image->Allocate();
+    short value = 0;
+    for (itk::ImageRegionIterator<ImageType> it(m_Image, m_Image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(value);
+      value = static_cast<short>((value + 13) % 2000);
+    }
+    itk::WriteImage(m_Image, m_FileName);
+  }
+
+  void
+  ExpectEqualToInput(const ImageType * image)
+  {
+    ASSERT_EQ(image->GetBufferedRegion(), m_Image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> it1(m_Image, m_Image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> it2(image, image->GetBufferedRegion());
+    for (; !it1.IsAtEnd(); ++it1, ++it2)
+    {
+      ASSERT_EQ(it1.Get(), it2.Get()) << "at index " << it1.GetIndex();
+    }
+  }
+
+  ImageType::Pointer m_Image;
+  const std::string  m_FileName{ "itkImageFileReaderPrefetchGTest.mha" };
+};
+
+} // namespace
+
+
+TEST_F(ImageFileReaderPrefetchFixture, StreamedPieces)
+{
+  for (bool prefetch : { false, true })
+  {
+    auto reader = ReaderType::New();
+    reader->SetFileName(m_FileName);
+    reader->SetPrefetch(prefetch);
+    EXPECT_EQ(reader->GetPrefetch(), prefetch);
+
+    auto streamer = StreamerType::New();
+    streamer->SetInput(reader->GetOutput());
+    streamer->SetNumberOfStreamDivisions(5);
+    streamer->Update();
+
+    this->ExpectEqualToInput(streamer->GetOutput());
+    EXPECT_EQ(streamer->GetPieceUpdateTimes().size(), 5u);
+
+    // the slabs after the first one are read ahead
+    EXPECT_EQ(reader->GetNumberOfPrefetchedReads(), prefetch ? 4u : 0u);
+    if (!prefetch)
+    {
+      EXPECT_EQ(reader->GetPrefetchWaitTime(), 0.0);
+    }
+    EXPECT_GE(reader->GetPrefetchWaitTime(), 0.0);
+
+    // a new pass predicts and reads ahead its slabs again
+    reader->Modified();
+    streamer->Update();
+    this->ExpectEqualToInput(streamer->GetOutput());
+    EXPECT_EQ(reader->GetNumberOfPrefetchedReads(), prefetch ? 4u : 0u);
+  }
+}
+
+
+TEST_F(ImageFileReaderPrefetchFixture, UnevenPieces)
+{
+  auto reader = ReaderType::New();
+  reader->SetFileName(m_FileName);
+  reader->PrefetchOn();
+
+  auto streamer = StreamerType::New();
+  streamer->SetInput(reader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(7);
+  streamer->Update();
+
+  this->ExpectEqualToInput(streamer->GetOutput());
+  EXPECT_GT(reader->GetNumberOfPrefetchedReads(), 0u);
+
+  // a new update starts a new sequence of slabs
+  streamer->Modified();
+  streamer->Update();
+  this->ExpectEqualToInput(streamer->GetOutput());
+}
+
+
+TEST_F(ImageFileReaderPrefetchFixture, UnpredictedRegion)
+{
+  auto reader = ReaderType::New();
+  reader->SetFileName(m_FileName);
+  reader->PrefetchOn();
+  reader->UpdateOutputInformation();
+
+  // the region following the first one is read ahead, but another is requested
+  ImageType::RegionType first({ { 0, 0, 0 } }, { { 31, 17, 4 } });
+  ImageType::RegionType other({ { 0, 0, 12 } }, { { 31, 17, 3 } });
+  for (const auto & region : { first, other })
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Update();
+
+    itk::ImageRegionConstIterator<ImageType> it(reader->GetOutput(), region);
+    for (; !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(it.Get(), m_Image->GetPixel(it.GetIndex())) << "at index " << it.GetIndex();
+    }
+  }
+  EXPECT_EQ(reader->GetNumberOfPrefetchedReads(), 0u);
+}
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredIOFactories.h"
+
+#include <sstream>
+
+#define ITK_STRINGIFY_HELPER(s) #s
+#define ITK_STRINGIFY(s) ITK_STRINGIFY_HELPER(s)
+
+namespace
+{
+
+class ImageFileWriterWriteBehindFixture : public ::testing::Test
+{
+public:
+  using ImageType = itk::Image<short, 3>;
+  using ShiftScaleType = itk::ShiftScaleImageFilter<ImageType, ImageType>;
+  using MonitorType = itk::PipelineMonitorImageFilter<ImageType>;
+  using WriterType = itk::ImageFileWriter<ImageType>;
+
+protected:
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(ITK_STRINGIFY(ITK_TEST_OUTPUT_DIR));
+
+    m_Image = ImageType::New();
+    m_Image->SetRegions(ImageType::SizeType{ { 37, 29, 23 } });
+    m_Image->Allocate();
+    short value = 0;
+    for (itk::ImageRegionIterator<ImageType> it(m_Image, m_Image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(value);
+      value = static_cast<short>((value + 7) % 1000);
+    }
+
+    m_ShiftScale = ShiftScaleType::New();
+    m_ShiftScale->SetInput(m_Image);
+    m_ShiftScale->SetShift(11);
+
+    m_Monitor = MonitorType::New();
+    m_Monitor->SetInput(m_ShiftScale->GetOutput());
+  }
+
+  static ImageType::Pointer
+  ReadImage(const std::string & fileName)
+  {
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName(fileName);
+    reader->Update();
+    return reader->GetOutput();
+  }
+
+  // Check that a file holds the shifted input image
+  void
+  ExpectWrittenImage(const std::string & fileName)
+  {
+    const ImageType::Pointer written = ReadImage(fileName);
+    ASSERT_EQ(written->GetBufferedRegion(), m_Image->GetLargestPossibleRegion());
+
+    itk::ImageRegionConstIterator<ImageType> it1(m_Image, m_Image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> it2(written, written->GetBufferedRegion());
+    for (; !it1.IsAtEnd(); ++it1, ++it2)
+    {
+      ASSERT_EQ(it1.Get() + 11, it2.Get()) << "at index " << it1.GetIndex();
+    }
+  }
+
+  ImageType::Pointer      m_Image;
+  ShiftScaleType::Pointer m_ShiftScale;
+  MonitorType::Pointer    m_Monitor;
+};
+
+} // namespace
+
+
+TEST_F(ImageFileWriterWriteBehindFixture, MatchesSynchronousWrite)
+{
+  for (unsigned int numberOfBuffers : { 0, 1, 2, 3 })
+  {
+    std::ostringstream fileName;
+    fileName << "itkImageFileWriterWriteBehindGTest_" << numberOfBuffers << ".mha";
+
+    auto writer = WriterType::New();
+    writer->SetInput(m_Monitor->GetOutput());
+    writer->SetFileName(fileName.str());
+    writer->SetNumberOfStreamDivisions(5);
+    writer->SetNumberOfWriteBehindBuffers(numberOfBuffers);
+    EXPECT_EQ(writer->GetNumberOfWriteBehindBuffers(), numberOfBuffers);
+    m_ShiftScale->Modified();
+    m_Monitor->ClearPipelineSavedInformation();
+    writer->Update();
+
+    EXPECT_EQ(m_Monitor->GetNumberOfUpdates(), 5u);
+    EXPECT_TRUE(m_Monitor->VerifyAllInputCanStream(5));
+    this->ExpectWrittenImage(fileName.str());
+  }
+}
+
+
+TEST_F(ImageFileWriterWriteBehindFixture, PasteRegion)
+{
+  const std::string fileName = "itkImageFileWriterWriteBehindGTest_Paste.mha";
+  itk::WriteImage(m_Image, fileName);
+
+  // overwrite a region of the file, in pieces written behind
+  itk::ImageIORegion ioRegion(3);
+  ioRegion.SetIndex({ 3, 2, 4 });
+  ioRegion.SetSize({ 20, 21, 12 });
+
+  auto writer = WriterType::New();
+  writer->SetInput(m_Monitor->GetOutput());
+  writer->SetFileName(fileName);
+  writer->SetIORegion(ioRegion);
+  writer->SetNumberOfStreamDivisions(4);
+  writer->SetNumberOfWriteBehindBuffers(2);
+  writer->Update();
+
+  const ImageType::Pointer written = ReadImage(fileName);
+  ImageType::RegionType    pasteRegion({ { 3, 2, 4 } }, { { 20, 21, 12 } });
+  for (itk::ImageRegionConstIterator<ImageType> it(m_Image, m_Image->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const short expected = static_cast<short>(it.Get() + (pasteRegion.IsInside(it.GetIndex()) ? 11 : 0));
+    ASSERT_EQ(written->GetPixel(it.GetIndex()), expected) << "at index " << it.GetIndex();
+  }
+}
+
+
+// An ImageIO which can't stream is written synchronously
+TEST_F(ImageFileWriterWriteBehindFixture, NonStreamableImageIO)
+{
+  const std::string fileName = "itkImageFileWriterWriteBehindGTest_Compressed.mha";
+
+  auto writer = WriterType::New();
+  writer->SetInput(m_Monitor->GetOutput());
+  writer->SetFileName(fileName);
+  writer->SetNumberOfStreamDivisions(5);
+  writer->SetNumberOfWriteBehindBuffers(2);
+  writer->UseCompressionOn();
+  writer->Update();
+
+  this->ExpectWrittenImage(fileName);
+}
+
+
+// An error of the I/O thread is reported by Update()
+TEST_F(ImageFileWriterWriteBehindFixture, WriteError)
+{
+  auto writer = WriterType::New();
+  writer->SetInput(m_Monitor->GetOutput());
+  writer->SetFileName("itkImageFileWriterWriteBehindGTest_MissingDirectory/image.mha");
+  writer->SetNumberOfStreamDivisions(5);
+  writer->SetNumberOfWriteBehindBuffers(1);
+  EXPECT_THROW(writer->Update(), itk::ExceptionObject);
+}
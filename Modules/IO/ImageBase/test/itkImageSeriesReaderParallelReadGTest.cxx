@@ -0,0 +1,250 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageIOFactory.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMetaDataObject.h"
+#include "itkTimeProbe.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredIOFactories.h"
+
+#include <sstream>
+
+#define ITK_STRINGIFY_HELPER(s) #s
+#define ITK_STRINGIFY(s) ITK_STRINGIFY_HELPER(s)
+
+namespace
+{
+
+class ImageSeriesReaderParallelReadFixture : public ::testing::Test
+{
+public:
+  using SliceType = itk::Image<short, 2>;
+  using VolumeType = itk::Image<short, 3>;
+  using ReaderType = itk::ImageSeriesReader<VolumeType>;
+
+protected:
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(ITK_STRINGIFY(ITK_TEST_OUTPUT_DIR));
+  }
+
+  // Write a series of slices with distinct values and return their file names
+  ReaderType::FileNamesContainer
+  WriteSeries(unsigned int numberOfSlices, unsigned int sliceSize)
+  {
+    ReaderType::FileNamesContainer fileNames;
+    for (unsigned int z = 0; z < numberOfSlices; ++z)
+    {
+      auto slice = SliceType::New();
+      slice->SetRegions(SliceType::SizeType{ { sliceSize, sliceSize + 3 } });
+      slice->Allocate();
+      short value = static_cast<short>(z * 7);
+      for (itk::ImageRegionIterator<SliceType> it(slice, slice->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+      {
+        it.Set(value++);
+      }
+
+      std::ostringstream fileName;
+      fileName << "itkImageSeriesReaderParallelReadGTest_" << sliceSize << "_" << z << ".mha";
+      itk::WriteImage(slice, fileName.str());
+      fileNames.push_back(fileName.str());
+    }
+    return fileNames;
+  }
+
+  static void
+  ExpectEqualDictionaries(const itk::MetaDataDictionary & dictionary1, const itk::MetaDataDictionary & dictionary2)
+  {
+    ASSERT_EQ(dictionary1.GetKeys(), dictionary2.GetKeys());
+    for (const auto & key : dictionary1.GetKeys())
+    {
+      std::string value1;
+      std::string value2;
+      EXPECT_EQ(itk::ExposeMetaData(dictionary1, key, value1), itk::ExposeMetaData(dictionary2, key, value2));
+      EXPECT_EQ(value1, value2) << "for key " << key;
+    }
+  }
+
+  // Compare the pixels and the meta data of the outputs of two readers
+  static void
+  ExpectEqualOutputs(ReaderType * reader1, ReaderType * reader2)
+  {
+    ExpectEqualImages(reader1->GetOutput(), reader2->GetOutput());
+    ExpectEqualDictionaries(reader1->GetOutput()->GetMetaDataDictionary(),
+                            reader2->GetOutput()->GetMetaDataDictionary());
+
+    const ReaderType::DictionaryArrayType * array1 = reader1->GetMetaDataDictionaryArray();
+    const ReaderType::DictionaryArrayType * array2 = reader2->GetMetaDataDictionaryArray();
+    ASSERT_EQ(array1->size(), array2->size());
+    for (size_t i = 0; i < array1->size(); ++i)
+    {
+      ExpectEqualDictionaries(*(*array1)[i], *(*array2)[i]);
+    }
+  }
+
+  static void
+  ExpectEqualImages(const VolumeType * image1, const VolumeType * image2)
+  {
+    ASSERT_EQ(image1->GetBufferedRegion(), image2->GetBufferedRegion());
+    EXPECT_EQ(image1->GetLargestPossibleRegion(), image2->GetLargestPossibleRegion());
+    EXPECT_EQ(image1->GetSpacing(), image2->GetSpacing());
+    EXPECT_EQ(image1->GetOrigin(), image2->GetOrigin());
+    EXPECT_EQ(image1->GetDirection(), image2->GetDirection());
+
+    itk::ImageRegionConstIterator<VolumeType> it1(image1, image1->GetBufferedRegion());
+    itk::ImageRegionConstIterator<VolumeType> it2(image2, image2->GetBufferedRegion());
+    for (; !it1.IsAtEnd(); ++it1, ++it2)
+    {
+      ASSERT_EQ(it1.Get(), it2.Get()) << "at index " << it1.GetIndex();
+    }
+  }
+};
+
+} // namespace
+
+
+TEST_F(ImageSeriesReaderParallelReadFixture, MatchesSerialRead)
+{
+  const ReaderType::FileNamesContainer fileNames = this->WriteSeries(23, 16);
+
+  for (bool reverseOrder : { false, true })
+  {
+    auto serialReader = ReaderType::New();
+    serialReader->SetFileNames(fileNames);
+    serialReader->SetReverseOrder(reverseOrder);
+    serialReader->Update();
+
+    auto parallelReader = ReaderType::New();
+    parallelReader->SetFileNames(fileNames);
+    parallelReader->SetReverseOrder(reverseOrder);
+    parallelReader->ParallelReadOn();
+    EXPECT_TRUE(parallelReader->GetParallelRead());
+    parallelReader->Update();
+
+    ExpectEqualOutputs(serialReader, parallelReader);
+    EXPECT_EQ(parallelReader->GetMetaDataDictionaryArray()->size(), fileNames.size());
+  }
+}
+
+
+// Every work unit reads its files with a clone of the ImageIO set by the
+// user, which is not used itself
+TEST_F(ImageSeriesReaderParallelReadFixture, UserImageIO)
+{
+  const ReaderType::FileNamesContainer fileNames = this->WriteSeries(9, 10);
+
+  auto serialReader = ReaderType::New();
+  serialReader->SetFileNames(fileNames);
+  serialReader->Update();
+
+  itk::ImageIOBase::Pointer imageIO =
+    itk::ImageIOFactory::CreateImageIO(fileNames.front().c_str(), itk::ImageIOFactory::IOFileModeEnum::ReadMode);
+  ASSERT_NE(imageIO, nullptr);
+  imageIO->SetUseStreamedReading(!imageIO->GetUseStreamedReading());
+
+  auto parallelReader = ReaderType::New();
+  parallelReader->SetFileNames(fileNames);
+  parallelReader->SetImageIO(imageIO);
+  parallelReader->ParallelReadOn();
+  parallelReader->SetNumberOfWorkUnits(3);
+  parallelReader->UpdateOutputInformation();
+  imageIO->SetFileName("");
+  parallelReader->Update();
+
+  ExpectEqualOutputs(serialReader, parallelReader);
+  EXPECT_STREQ(imageIO->GetFileName(), "");
+
+  // the clones have the settings of the ImageIO
+  itk::ImageIOBase::Pointer clone = dynamic_cast<itk::ImageIOBase *>(imageIO->Clone().GetPointer());
+  ASSERT_NE(clone, nullptr);
+  EXPECT_NE(clone, imageIO);
+  EXPECT_STREQ(clone->GetNameOfClass(), imageIO->GetNameOfClass());
+  EXPECT_EQ(clone->GetUseStreamedReading(), imageIO->GetUseStreamedReading());
+  EXPECT_EQ(clone->GetUseCompression(), imageIO->GetUseCompression());
+  EXPECT_EQ(clone->GetCompressionLevel(), imageIO->GetCompressionLevel());
+}
+
+
+TEST_F(ImageSeriesReaderParallelReadFixture, StreamedRegion)
+{
+  const ReaderType::FileNamesContainer fileNames = this->WriteSeries(17, 12);
+
+  VolumeType::RegionType region({ { 0, 0, 5 } }, { { 12, 15, 6 } });
+
+  auto serialReader = ReaderType::New();
+  serialReader->SetFileNames(fileNames);
+  serialReader->UpdateOutputInformation();
+  serialReader->GetOutput()->SetRequestedRegion(region);
+  serialReader->Update();
+
+  auto parallelReader = ReaderType::New();
+  parallelReader->SetFileNames(fileNames);
+  parallelReader->ParallelReadOn();
+  parallelReader->UpdateOutputInformation();
+  parallelReader->GetOutput()->SetRequestedRegion(region);
+  parallelReader->Update();
+
+  ExpectEqualOutputs(serialReader, parallelReader);
+}
+
+
+TEST_F(ImageSeriesReaderParallelReadFixture, SizeMismatch)
+{
+  ReaderType::FileNamesContainer fileNames = this->WriteSeries(4, 8);
+  fileNames.push_back(this->WriteSeries(1, 9).front());
+
+  auto reader = ReaderType::New();
+  reader->SetFileNames(fileNames);
+  reader->ParallelReadOn();
+  EXPECT_THROW(reader->Update(), itk::ExceptionObject);
+}
+
+
+// Report the throughput of the serial and parallel reads of a larger series
+TEST_F(ImageSeriesReaderParallelReadFixture, Throughput)
+{
+  const ReaderType::FileNamesContainer fileNames = this->WriteSeries(64, 256);
+
+  ReaderType::Pointer readers[2];
+  for (bool parallelRead : { false, true })
+  {
+    auto reader = ReaderType::New();
+    readers[parallelRead] = reader;
+    reader->SetFileNames(fileNames);
+    reader->SetParallelRead(parallelRead);
+
+    itk::TimeProbe probe;
+    probe.Start();
+    reader->Update();
+    probe.Stop();
+
+    const double megabytes = reader->GetOutput()->GetBufferedRegion().GetNumberOfPixels() * sizeof(short) / 1.0e6;
+    std::cout << (parallelRead ? "Parallel" : "Serial") << " read: " << probe.GetTotal() << " s, "
+              << megabytes / probe.GetTotal() << " MB/s" << std::endl;
+  }
+
+  ExpectEqualOutputs(readers[0], readers[1]);
+}
@@ -0,0 +1,249 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMeshFileReader.h"
+#include "itkOBJMeshIOFactory.h"
+#include "itkOFFMeshIOFactory.h"
+#include "itkQuadEdgeMesh.h"
+#include "itkVTKPolyDataMeshIOFactory.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+// Check that ASCII OBJ, OFF and VTK files large enough to be split between
+// threads are read as they were written, in itk::Mesh, whose points are read
+// straight into their container, and in itk::QuadEdgeMesh, whose points are not.
+namespace
+{
+constexpr unsigned int Dimension = 3;
+constexpr unsigned int GridSize = 150;
+
+// A triangulated grid whose coordinates need all the digits of a float
+struct SurfaceType
+{
+  std::vector<float>        Coordinates;
+  std::vector<unsigned int> Triangles;
+  std::vector<float>        PointData;
+};
+
+SurfaceType
+MakeSurface()
+{
+  SurfaceType surface;
+  for (unsigned int y = 0; y < GridSize; ++y)
+  {
+    for (unsigned int x = 0; x < GridSize; ++x)
+    {
+      surface.Coordinates.push_back(x / 7.0f - 3.0f);
+      surface.Coordinates.push_back(y / 3.0f + 0.1f);
+      surface.Coordinates.push_back((x * y % 97) / 13.0f - 1e-3f);
+      surface.PointData.push_back((x + 2 * y) / 9.0f);
+    }
+  }
+  for (unsigned int y = 0; y + 1 < GridSize; ++y)
+  {
+    for (unsigned int x = 0; x + 1 < GridSize; ++x)
+    {
+      const unsigned int corner = y * GridSize + x;
+      const unsigned int next = corner + GridSize;
+      for (unsigned int id : { corner, corner + 1, next, corner + 1, next + 1, next })
+      {
+        surface.Triangles.push_back(id);
+      }
+    }
+  }
+  return surface;
+}
+
+void
+WriteOBJ(const SurfaceType & surface, const std::string & fileName)
+{
+  std::ofstream file(fileName.c_str());
+  file << std::setprecision(9) << "# grid\n";
+  for (size_t ii = 0; ii < surface.Coordinates.size(); ii += Dimension)
+  {
+    file << "v " << surface.Coordinates[ii] << ' ' << surface.Coordinates[ii + 1] << ' '
+         << surface.Coordinates[ii + 2] << '\n';
+    file << "vt 0.5 0.5\n";
+  }
+  for (size_t ii = 0; ii < surface.Triangles.size(); ii += 3)
+  {
+    // faces with and without texture indices
+    file << "f";
+    for (size_t jj = 0; jj < 3; ++jj)
+    {
+      file << ' ' << surface.Triangles[ii + jj] + 1 << (ii % 2 ? "/1" : "");
+    }
+    file << "\r\n";
+  }
+}
+
+void
+WriteOFF(const SurfaceType & surface, const std::string & fileName)
+{
+  std::ofstream file(fileName.c_str());
+  file << std::setprecision(9) << "OFF\n# grid\n";
+  file << surface.Coordinates.size() / Dimension << ' ' << surface.Triangles.size() / 3 << " 0\n";
+  for (size_t ii = 0; ii < surface.Coordinates.size(); ii += Dimension)
+  {
+    file << surface.Coordinates[ii] << ' ' << surface.Coordinates[ii + 1] << ' ' << surface.Coordinates[ii + 2] << '\n';
+  }
+  for (size_t ii = 0; ii < surface.Triangles.size(); ii += 3)
+  {
+    // faces with and without a color
+    file << "3 " << surface.Triangles[ii] << ' ' << surface.Triangles[ii + 1] << ' ' << surface.Triangles[ii + 2]
+         << (ii % 2 ? " 0.1 0.2 0.3" : "") << '\n';
+  }
+}
+
+void
+WriteVTK(const SurfaceType & surface, const std::string & fileName, bool cellsOnOneLine)
+{
+  std::ofstream file(fileName.c_str());
+  file << std::setprecision(9) << "# vtk DataFile Version 2.0\nGrid\nASCII\nDATASET POLYDATA\n";
+  file << "POINTS " << surface.Coordinates.size() / Dimension << " float\n";
+  for (size_t ii = 0; ii < surface.Coordinates.size(); ++ii)
+  {
+    file << surface.Coordinates[ii] << (ii % 9 == 8 ? '\n' : ' ');
+  }
+  const size_t numberOfTriangles = surface.Triangles.size() / 3;
+  file << "\nPOLYGONS " << numberOfTriangles << ' ' << 4 * numberOfTriangles << '\n';
+  for (size_t ii = 0; ii < surface.Triangles.size(); ii += 3)
+  {
+    file << "3 " << surface.Triangles[ii] << ' ' << surface.Triangles[ii + 1]
+         << (cellsOnOneLine || ii % 5 ? ' ' : '\n') << surface.Triangles[ii + 2] << '\n';
+  }
+  file << "\nPOINT_DATA " << surface.PointData.size() << "\nSCALARS values float 1\nLOOKUP_TABLE default\n";
+  for (size_t ii = 0; ii < surface.PointData.size(); ++ii)
+  {
+    file << surface.PointData[ii] << (ii % 9 == 8 ? '\n' : ' ');
+  }
+  file << '\n';
+}
+
+template <typename TMesh>
+int
+CheckMesh(const SurfaceType & surface, const std::string & fileName, bool checkCells, bool checkPointData)
+{
+  auto reader = itk::MeshFileReader<TMesh>::New();
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  const TMesh * mesh = reader->GetOutput();
+
+  const size_t numberOfPoints = surface.Coordinates.size() / Dimension;
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), numberOfPoints);
+
+  for (typename TMesh::PointIdentifier id = 0; id < numberOfPoints; ++id)
+  {
+    const typename TMesh::PointType point = mesh->GetPoint(id);
+    for (unsigned int ii = 0; ii < Dimension; ++ii)
+    {
+      if (point[ii] != surface.Coordinates[id * Dimension + ii])
+      {
+        std::cerr << "Wrong point " << id << " in " << fileName << ": " << point << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (checkCells)
+  {
+    const size_t numberOfCells = surface.Triangles.size() / 3;
+    ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), numberOfCells);
+    for (typename TMesh::CellIdentifier id = 0; id < numberOfCells; ++id)
+    {
+      typename TMesh::CellAutoPointer cell;
+      mesh->GetCell(id, cell);
+      if (cell->GetNumberOfPoints() != 3 ||
+          !std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), surface.Triangles.begin() + 3 * id))
+      {
+        std::cerr << "Wrong cell " << id << " in " << fileName << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (checkPointData)
+  {
+    for (typename TMesh::PointIdentifier id = 0; id < numberOfPoints; ++id)
+    {
+      typename TMesh::PixelType value = 0;
+      if (!mesh->GetPointData(id, &value) || value != surface.PointData[id])
+      {
+        std::cerr << "Wrong point data " << id << " in " << fileName << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename TMesh>
+bool
+CheckFiles(const SurfaceType & surface, const std::string & outputDirectory, bool checkCells)
+{
+  bool success = true;
+  for (const char * fileName : { "/itkMeshFileParallelReadTest.obj", "/itkMeshFileParallelReadTest.off" })
+  {
+    success &= (CheckMesh<TMesh>(surface, outputDirectory + fileName, checkCells, false) == EXIT_SUCCESS);
+  }
+  for (const char * fileName : { "/itkMeshFileParallelReadTest.vtk", "/itkMeshFileParallelReadTestWrapped.vtk" })
+  {
+    success &= (CheckMesh<TMesh>(surface, outputDirectory + fileName, checkCells, true) == EXIT_SUCCESS);
+  }
+  return success;
+}
+} // namespace
+
+int
+itkMeshFileParallelReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itk::OBJMeshIOFactory::RegisterOneFactory();
+  itk::OFFMeshIOFactory::RegisterOneFactory();
+  itk::VTKPolyDataMeshIOFactory::RegisterOneFactory();
+
+  const std::string outputDirectory = argv[1];
+  const SurfaceType surface = MakeSurface();
+  WriteOBJ(surface, outputDirectory + "/itkMeshFileParallelReadTest.obj");
+  WriteOFF(surface, outputDirectory + "/itkMeshFileParallelReadTest.off");
+  WriteVTK(surface, outputDirectory + "/itkMeshFileParallelReadTest.vtk", true);
+  WriteVTK(surface, outputDirectory + "/itkMeshFileParallelReadTestWrapped.vtk", false);
+
+  int result = EXIT_SUCCESS;
+  if (!CheckFiles<itk::Mesh<float, Dimension>>(surface, outputDirectory, true))
+  {
+    std::cerr << "Failure for itk::Mesh" << std::endl;
+    result = EXIT_FAILURE;
+  }
+  if (!CheckFiles<itk::QuadEdgeMesh<float, Dimension>>(surface, outputDirectory, false))
+  {
+    std::cerr << "Failure for itk::QuadEdgeMesh" << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
@@ -20,6 +20,7 @@
 
 #include "itkMeshFileReaderException.h"
 #include "itkMacro.h"
+#include "itkCompactMesh.h"
 #include "itkHexahedronCell.h"
 #include "itkLineCell.h"
 #include "itkMeshIOBase.h"
@@ -30,6 +31,7 @@
 #include "itkQuadraticTriangleCell.h"
 #include "itkTetrahedronCell.h"
 #include "itkTriangleCell.h"
+#include "itkVectorContainer.h"
 #include "itkVertexCell.h"
 
 #include "itkDefaultConvertPixelTraits.h"
@@ -147,6 +149,26 @@ public:
   void
   ReadCells(T * buffer);
 
+  /** Read the points straight into the points container of the output, without
+   * an intermediate buffer. This is only possible when the file stores the
+   * coordinates with the type and the dimension of the points of the mesh, and
+   * the container stores the points contiguously. Return whether the points
+   * were read. */
+  bool
+  ReadPointsIntoContainer();
+
+  /** Read the cells straight into the index buffer of a CompactMesh. An
+   * exception is thrown when a cell is not a simplex of the type of the cells
+   * of the mesh. Return whether the cells were read, which is the case for a
+   * CompactMesh only. */
+  template <typename T>
+  bool
+  ReadCellsIntoIndexBuffer(const T * buffer, std::false_type);
+
+  template <typename T>
+  bool
+  ReadCellsIntoIndexBuffer(const T * buffer, std::true_type);
+
   void
   ReadPointData();
 
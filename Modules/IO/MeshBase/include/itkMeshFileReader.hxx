@@ -29,6 +29,7 @@
 
 #include <itksys/SystemTools.hxx>
 #include <fstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -127,11 +128,39 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
   }
 }
 
+template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
+bool
+MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadPointsIntoContainer()
+{
+  using PointsContainerType = typename TOutputMesh::PointsContainer;
+  using VectorPointsContainerType = VectorContainer<OutputPointIdentifier, OutputPointType>;
+  using CoordinateType = typename OutputPointType::ValueType;
+
+  constexpr bool contiguousPoints = std::is_same<PointsContainerType, VectorPointsContainerType>::value &&
+                                    sizeof(OutputPointType) == OutputPointDimension * sizeof(CoordinateType);
+  if (!contiguousPoints || m_MeshIO->GetNumberOfPoints() == 0 ||
+      m_MeshIO->GetPointComponentType() != MeshIOBase::MapComponentType<CoordinateType>::CType ||
+      m_MeshIO->GetPointDimension() != OutputPointDimension)
+  {
+    return false;
+  }
+
+  PointsContainerType * points = this->GetOutput()->GetPoints();
+  points->Reserve(m_MeshIO->GetNumberOfPoints());
+  m_MeshIO->ReadPoints(static_cast<void *>(points->ElementAt(0).GetDataPointer()));
+  return true;
+}
+
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
 template <typename T>
 void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadCells(T * buffer)
 {
+  if (this->ReadCellsIntoIndexBuffer(buffer, IsCompactMesh<TOutputMesh>()))
+  {
+    return;
+  }
+
   typename TOutputMesh::Pointer output = this->GetOutput();
 
   SizeValueType        index = NumericTraits<SizeValueType>::ZeroValue();
@@ -330,6 +359,59 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
   }
 }
 
+template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
+template <typename T>
+bool
+MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadCellsIntoIndexBuffer(const T *,
+                                                                                                       std::false_type)
+{
+  return false;
+}
+
+template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
+template <typename T>
+bool
+MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadCellsIntoIndexBuffer(const T * buffer,
+                                                                                                       std::true_type)
+{
+  using CellIndexContainerType = typename TOutputMesh::CellIndexContainer;
+  constexpr unsigned int numberOfCellPoints = TOutputMesh::NumberOfCellPoints;
+
+  const SizeValueType numberOfCells = m_MeshIO->GetNumberOfCells();
+  const SizeValueType bufferSize = m_MeshIO->GetCellBufferSize();
+
+  typename CellIndexContainerType::Pointer cellIndices = CellIndexContainerType::New();
+  cellIndices->CastToSTLContainer().resize(numberOfCells * numberOfCellPoints);
+  OutputPointIdentifier * indices = cellIndices->CastToSTLContainer().data();
+
+  SizeValueType index = NumericTraits<SizeValueType>::ZeroValue();
+  for (SizeValueType id = 0; id < numberOfCells; ++id)
+  {
+    if (index + 2 > bufferSize)
+    {
+      itkExceptionMacro(<< "The cell buffer holds fewer than " << numberOfCells << " cells");
+    }
+
+    const auto type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    const auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
+    const bool isSimplex = type == TOutputMesh::CellGeometry ||
+                           (type == CellGeometryEnum::POLYGON_CELL && numberOfCellPoints == 3);
+    if (!isSimplex || numberOfPoints != numberOfCellPoints || index + numberOfPoints > bufferSize)
+    {
+      itkExceptionMacro(<< "Cell " << id << " with " << numberOfPoints
+                        << " points can't be stored in a mesh of cells with " << numberOfCellPoints << " points");
+    }
+
+    for (unsigned int jj = 0; jj < numberOfCellPoints; ++jj)
+    {
+      *indices++ = static_cast<OutputPointIdentifier>(buffer[index++]);
+    }
+  }
+
+  this->GetOutput()->SetCellIndices(cellIndices);
+  return true;
+}
+
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
 void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadPointData()
@@ -546,7 +628,7 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Ge
   m_MeshIO->ReadMeshInformation();
 
   // Read points
-  if (m_MeshIO->GetUpdatePoints())
+  if (m_MeshIO->GetUpdatePoints() && !this->ReadPointsIntoContainer())
   {
     switch (m_MeshIO->GetPointComponentType())
     {
@@ -0,0 +1,212 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMeshFileTextParser_h
+#define itkMeshFileTextParser_h
+#include "ITKIOMeshBaseExport.h"
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include "itkMultiThreaderBase.h"
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+/** \class MeshFileTextParser
+ * \brief Parse the numbers of an ASCII mesh file in parallel.
+ *
+ * The whole file is read into memory at once. The ranges of its text holding
+ * points, cells or pixels are split into chunks which are parsed concurrently:
+ * a first pass counts the tokens or lines of every chunk, so that each chunk
+ * knows where its values go in the output buffer, and a second pass parses them.
+ * Numbers are converted with the double-conversion library, which is much faster
+ * than the extraction operators of the standard streams and does not depend on
+ * the locale.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOMeshBase
+ */
+class ITKIOMeshBase_EXPORT MeshFileTextParser
+{
+public:
+  using SizeValueType = ::itk::SizeValueType;
+
+  /** A range of characters of the text. */
+  struct RangeType
+  {
+    const char * Begin;
+    const char * End;
+  };
+  using RangeListType = std::vector<RangeType>;
+
+  /** Read the whole file into memory. An exception is thrown when it can't be read. */
+  void
+  ReadFile(const std::string & fileName);
+
+  /** Free the memory holding the text. */
+  void
+  Clear();
+
+  const char *
+  GetBegin() const
+  {
+    return m_Text.data();
+  }
+
+  const char *
+  GetEnd() const
+  {
+    return m_Text.data() + m_Text.size();
+  }
+
+  /** Return the number of ranges a text should be split in, so that every thread
+   * gets several ranges while small texts are parsed at once. */
+  static SizeValueType
+  GetNumberOfRanges(const char * begin, const char * end);
+
+  /** Split [begin, end) into at most numberOfRanges ranges made of whole lines. */
+  static RangeListType
+  SplitLines(const char * begin, const char * end, SizeValueType numberOfRanges);
+
+  /** Split [begin, end) into at most numberOfRanges ranges which don't cut any token. */
+  static RangeListType
+  SplitTokens(const char * begin, const char * end, SizeValueType numberOfRanges);
+
+  /** Skip the spaces and tabs, but not the end of the line. */
+  static const char *
+  SkipBlanks(const char * it, const char * end);
+
+  /** Skip all the white spaces, including the ends of lines. */
+  static const char *
+  SkipWhitespace(const char * it, const char * end);
+
+  /** Return the end of the token starting at it. */
+  static const char *
+  SkipToken(const char * it, const char * end);
+
+  /** Return the position of the end of the line, or end. */
+  static const char *
+  FindEndOfLine(const char * it, const char * end);
+
+  /** Return the beginning of the next line, or end. */
+  static const char *
+  NextLine(const char * it, const char * end);
+
+  /** Return the beginning of the first line holding keyword, or end. */
+  static const char *
+  FindLine(const char * begin, const char * end, const char * keyword);
+
+  /** Return the beginning of the first line starting with a word which is not
+   * a number, such as the keyword of the next section of a file, or end. */
+  static const char *
+  FindKeywordLine(const char * begin, const char * end);
+
+  /** Return the number of white space separated tokens in [begin, end). */
+  static SizeValueType
+  CountTokens(const char * begin, const char * end);
+
+  /** Skip the white spaces and parse the number which follows. Return the
+   * position after the number, or nullptr if there is no number. Integers
+   * stop before any character which is not a digit, such as the '/' of the
+   * faces of OBJ files. */
+  static const char *
+  ParseNumber(const char * it, const char * end, double & value);
+  static const char *
+  ParseNumber(const char * it, const char * end, float & value);
+  static const char *
+  ParseNumber(const char * it, const char * end, long long & value);
+
+  /** Parse a number into any arithmetic type. */
+  template <typename T>
+  static const char *
+  ParseValue(const char * it, const char * end, T & value)
+  {
+    using ParseType = typename std::conditional<
+      std::is_integral<T>::value,
+      long long,
+      typename std::conditional<std::is_same<T, float>::value, float, double>::type>::type;
+    ParseType  parsed{};
+    const auto next = ParseNumber(it, end, parsed);
+    if (next != nullptr)
+    {
+      value = static_cast<T>(parsed);
+    }
+    return next;
+  }
+
+  /** Parse the first numberOfValues white space separated numbers of
+   * [begin, end) into buffer, in parallel. An exception is thrown when there
+   * are fewer values, or when a token is not a number. */
+  template <typename T>
+  static void
+  ParseValues(const char * begin, const char * end, T * buffer, SizeValueType numberOfValues)
+  {
+    const RangeListType ranges = SplitTokens(begin, end, GetNumberOfRanges(begin, end));
+
+    std::vector<SizeValueType> offsets(ranges.size() + 1, 0);
+    MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+    multiThreader->ParallelizeArray(
+      0,
+      ranges.size(),
+      [&ranges, &offsets](SizeValueType i) { offsets[i + 1] = CountTokens(ranges[i].Begin, ranges[i].End); },
+      nullptr);
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    if (offsets.back() < numberOfValues)
+    {
+      itkGenericExceptionMacro(<< "Expected " << numberOfValues << " values, but found only " << offsets.back());
+    }
+
+    std::vector<char> valid(ranges.size(), 1);
+    multiThreader->ParallelizeArray(
+      0,
+      ranges.size(),
+      [&](SizeValueType i) {
+        const char *        it = ranges[i].Begin;
+        const SizeValueType last = std::min(offsets[i + 1], numberOfValues);
+        for (SizeValueType n = offsets[i]; n < last; ++n)
+        {
+          it = ParseValue(it, ranges[i].End, buffer[n]);
+          if (it == nullptr || (it != ranges[i].End && !IsWhitespace(*it)))
+          {
+            valid[i] = 0;
+            return;
+          }
+        }
+      },
+      nullptr);
+    if (std::find(valid.begin(), valid.end(), 0) != valid.end())
+    {
+      itkGenericExceptionMacro(<< "Invalid number in the values to read");
+    }
+  }
+
+  static bool
+  IsWhitespace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+private:
+  std::vector<char> m_Text;
+};
+} // end namespace itk
+
+#endif
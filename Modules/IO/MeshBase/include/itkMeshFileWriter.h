@@ -19,6 +19,7 @@
 #define itkMeshFileWriter_h
 
 #include "itkMeshFileWriterException.h"
+#include "itkCompactMesh.h"
 #include "itkProcessObject.h"
 #include "itkMeshIOBase.h"
 
@@ -176,6 +177,18 @@ protected:
   WriteCellData();
 
 private:
+  /** The cells of a CompactMesh are written from its index buffer. */
+  template <typename Output>
+  void
+  CopyCellsToBuffer(Output * data, std::false_type);
+
+  template <typename Output>
+  void
+  CopyCellsToBuffer(Output * data, std::true_type);
+
+  SizeValueType GetCellsBufferSize(std::false_type);
+  SizeValueType GetCellsBufferSize(std::true_type);
+
   std::string         m_FileName;
   MeshIOBase::Pointer m_MeshIO;
   bool                m_UserSpecifiedMeshIO; // track whether the MeshIO is
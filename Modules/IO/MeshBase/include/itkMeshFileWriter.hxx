@@ -167,16 +167,9 @@ MeshFileWriter<TInputMesh>::Write()
   }
 
   // Whether write cells
-  if (input->GetCells() && input->GetNumberOfCells())
+  if (input->GetNumberOfCells())
   {
-    SizeValueType cellsBufferSize = 2 * input->GetNumberOfCells();
-    for (typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
-         ct != input->GetCells()->End();
-         ++ct)
-    {
-      cellsBufferSize += ct->Value()->GetNumberOfPoints();
-    }
-    m_MeshIO->SetCellBufferSize(cellsBufferSize);
+    m_MeshIO->SetCellBufferSize(this->GetCellsBufferSize(IsCompactMesh<TInputMesh>()));
     m_MeshIO->SetUpdateCells(true);
     m_MeshIO->SetNumberOfCells(input->GetNumberOfCells());
     m_MeshIO->SetCellComponentType(MeshIOBase::MapComponentType<typename TInputMesh::PointIdentifier>::CType);
@@ -214,7 +207,7 @@ MeshFileWriter<TInputMesh>::Write()
   }
 
   // Write cells
-  if (input->GetCells() && input->GetNumberOfCells())
+  if (input->GetNumberOfCells())
   {
     WriteCells();
   }
@@ -337,6 +330,14 @@ template <typename TInputMesh>
 template <typename Output>
 void
 MeshFileWriter<TInputMesh>::CopyCellsToBuffer(Output * data)
+{
+  this->CopyCellsToBuffer(data, IsCompactMesh<TInputMesh>());
+}
+
+template <typename TInputMesh>
+template <typename Output>
+void
+MeshFileWriter<TInputMesh>::CopyCellsToBuffer(Output * data, std::false_type)
 {
   // Get input mesh pointer
   const typename InputMeshType::CellsContainer * cells = this->GetInput()->GetCells();
@@ -401,6 +402,50 @@ MeshFileWriter<TInputMesh>::CopyCellsToBuffer(Output * data)
   }
 }
 
+template <typename TInputMesh>
+template <typename Output>
+void
+MeshFileWriter<TInputMesh>::CopyCellsToBuffer(Output * data, std::true_type)
+{
+  const InputMeshType * input = this->GetInput();
+
+  // Each cell is its type, its number of points and its point identifiers
+  const SizeValueType                          numberOfCells = input->GetNumberOfCells();
+  const typename TInputMesh::PointIdentifier * ptIds = input->GetCellIndices()->CastToSTLConstContainer().data();
+  SizeValueType                                index = NumericTraits<SizeValueType>::ZeroValue();
+  for (SizeValueType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    data[index++] = static_cast<Output>(TInputMesh::CellGeometry);
+    data[index++] = static_cast<Output>(TInputMesh::NumberOfCellPoints);
+    for (unsigned int ii = 0; ii < TInputMesh::NumberOfCellPoints; ii++)
+    {
+      data[index++] = static_cast<Output>(*ptIds++);
+    }
+  }
+}
+
+template <typename TInputMesh>
+auto
+MeshFileWriter<TInputMesh>::GetCellsBufferSize(std::false_type) -> SizeValueType
+{
+  const InputMeshType * input = this->GetInput();
+
+  SizeValueType cellsBufferSize = 2 * input->GetNumberOfCells();
+  for (typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin(); ct != input->GetCells()->End();
+       ++ct)
+  {
+    cellsBufferSize += ct->Value()->GetNumberOfPoints();
+  }
+  return cellsBufferSize;
+}
+
+template <typename TInputMesh>
+auto
+MeshFileWriter<TInputMesh>::GetCellsBufferSize(std::true_type) -> SizeValueType
+{
+  return (2 + TInputMesh::NumberOfCellPoints) * static_cast<SizeValueType>(this->GetInput()->GetNumberOfCells());
+}
+
 template <typename TInputMesh>
 template <typename Output>
 void
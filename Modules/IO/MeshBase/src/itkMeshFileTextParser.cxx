@@ -0,0 +1,269 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMeshFileTextParser.h"
+#include "double-conversion/double-conversion.h"
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace itk
+{
+namespace
+{
+// Text smaller than this is not worth splitting between threads
+constexpr SizeValueType MinimumRangeSize = 1 << 16;
+
+const double_conversion::StringToDoubleConverter &
+GetStringToDoubleConverter()
+{
+  static const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::ALLOW_TRAILING_JUNK,
+    0.0,
+    std::numeric_limits<double>::quiet_NaN(),
+    "inf",
+    "nan");
+  return converter;
+}
+
+bool
+StartsWithNoCase(const char * it, const char * end, const char * word)
+{
+  for (; *word != '\0'; ++it, ++word)
+  {
+    if (it == end || std::tolower(static_cast<unsigned char>(*it)) != *word)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+void
+MeshFileTextParser::ReadFile(const std::string & fileName)
+{
+  std::ifstream inputFile(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!inputFile.is_open())
+  {
+    itkGenericExceptionMacro(<< "Unable to open file\n"
+                                "inputFilename= "
+                             << fileName);
+  }
+
+  inputFile.seekg(0, std::ios::end);
+  const std::streamoff size = inputFile.tellg();
+  inputFile.seekg(0, std::ios::beg);
+
+  m_Text.resize(static_cast<size_t>(size));
+  if (!inputFile.read(m_Text.data(), size))
+  {
+    m_Text.clear();
+    itkGenericExceptionMacro(<< "Unable to read file\n"
+                                "inputFilename= "
+                             << fileName);
+  }
+}
+
+void
+MeshFileTextParser::Clear()
+{
+  std::vector<char>().swap(m_Text);
+}
+
+SizeValueType
+MeshFileTextParser::GetNumberOfRanges(const char * begin, const char * end)
+{
+  const auto          size = static_cast<SizeValueType>(end - begin);
+  const SizeValueType maximumNumberOfRanges = 4 * MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  return std::min(size / MinimumRangeSize + 1, maximumNumberOfRanges);
+}
+
+MeshFileTextParser::RangeListType
+MeshFileTextParser::SplitLines(const char * begin, const char * end, SizeValueType numberOfRanges)
+{
+  RangeListType       ranges;
+  const auto          size = static_cast<SizeValueType>(end - begin);
+  const char *        rangeBegin = begin;
+  const SizeValueType n = std::max<SizeValueType>(numberOfRanges, 1);
+  for (SizeValueType k = 1; k <= n && rangeBegin < end; ++k)
+  {
+    const char * target = begin + size * k / n;
+    if (target <= rangeBegin)
+    {
+      continue;
+    }
+    const char * rangeEnd = NextLine(target - 1, end);
+    ranges.push_back(RangeType{ rangeBegin, rangeEnd });
+    rangeBegin = rangeEnd;
+  }
+  return ranges;
+}
+
+MeshFileTextParser::RangeListType
+MeshFileTextParser::SplitTokens(const char * begin, const char * end, SizeValueType numberOfRanges)
+{
+  RangeListType       ranges;
+  const auto          size = static_cast<SizeValueType>(end - begin);
+  const char *        rangeBegin = begin;
+  const SizeValueType n = std::max<SizeValueType>(numberOfRanges, 1);
+  for (SizeValueType k = 1; k <= n && rangeBegin < end; ++k)
+  {
+    const char * target = begin + size * k / n;
+    if (target <= rangeBegin)
+    {
+      continue;
+    }
+    const char * rangeEnd = SkipToken(target, end);
+    ranges.push_back(RangeType{ rangeBegin, rangeEnd });
+    rangeBegin = rangeEnd;
+  }
+  return ranges;
+}
+
+const char *
+MeshFileTextParser::SkipBlanks(const char * it, const char * end)
+{
+  while (it != end && *it != '\n' && IsWhitespace(*it))
+  {
+    ++it;
+  }
+  return it;
+}
+
+const char *
+MeshFileTextParser::SkipWhitespace(const char * it, const char * end)
+{
+  while (it != end && IsWhitespace(*it))
+  {
+    ++it;
+  }
+  return it;
+}
+
+const char *
+MeshFileTextParser::SkipToken(const char * it, const char * end)
+{
+  while (it != end && !IsWhitespace(*it))
+  {
+    ++it;
+  }
+  return it;
+}
+
+const char *
+MeshFileTextParser::FindEndOfLine(const char * it, const char * end)
+{
+  if (it == end)
+  {
+    return end;
+  }
+  const auto * endOfLine = static_cast<const char *>(std::memchr(it, '\n', static_cast<size_t>(end - it)));
+  return endOfLine != nullptr ? endOfLine : end;
+}
+
+const char *
+MeshFileTextParser::NextLine(const char * it, const char * end)
+{
+  const char * endOfLine = FindEndOfLine(it, end);
+  return endOfLine != end ? endOfLine + 1 : end;
+}
+
+const char *
+MeshFileTextParser::FindLine(const char * begin, const char * end, const char * keyword)
+{
+  const char * found = std::search(begin, end, keyword, keyword + std::strlen(keyword));
+  if (found == end)
+  {
+    return end;
+  }
+  while (found != begin && found[-1] != '\n')
+  {
+    --found;
+  }
+  return found;
+}
+
+const char *
+MeshFileTextParser::FindKeywordLine(const char * begin, const char * end)
+{
+  for (const char * line = begin; line != end; line = NextLine(line, end))
+  {
+    const char * it = SkipBlanks(line, end);
+    if (it != end && std::isalpha(static_cast<unsigned char>(*it)) && !StartsWithNoCase(it, end, "nan") &&
+        !StartsWithNoCase(it, end, "inf"))
+    {
+      return line;
+    }
+  }
+  return end;
+}
+
+SizeValueType
+MeshFileTextParser::CountTokens(const char * begin, const char * end)
+{
+  SizeValueType numberOfTokens = 0;
+  for (const char * it = SkipWhitespace(begin, end); it != end; it = SkipWhitespace(SkipToken(it, end), end))
+  {
+    ++numberOfTokens;
+  }
+  return numberOfTokens;
+}
+
+const char *
+MeshFileTextParser::ParseNumber(const char * it, const char * end, double & value)
+{
+  it = SkipWhitespace(it, end);
+  int processed = 0;
+  value = GetStringToDoubleConverter().StringToDouble(it, static_cast<int>(SkipToken(it, end) - it), &processed);
+  return processed > 0 ? it + processed : nullptr;
+}
+
+const char *
+MeshFileTextParser::ParseNumber(const char * it, const char * end, float & value)
+{
+  it = SkipWhitespace(it, end);
+  int processed = 0;
+  value = GetStringToDoubleConverter().StringToFloat(it, static_cast<int>(SkipToken(it, end) - it), &processed);
+  return processed > 0 ? it + processed : nullptr;
+}
+
+const char *
+MeshFileTextParser::ParseNumber(const char * it, const char * end, long long & value)
+{
+  it = SkipWhitespace(it, end);
+  bool negative = false;
+  if (it != end && (*it == '-' || *it == '+'))
+  {
+    negative = (*it == '-');
+    ++it;
+  }
+  if (it == end || !std::isdigit(static_cast<unsigned char>(*it)))
+  {
+    return nullptr;
+  }
+  unsigned long long magnitude = 0;
+  for (; it != end && std::isdigit(static_cast<unsigned char>(*it)); ++it)
+  {
+    magnitude = magnitude * 10 + static_cast<unsigned long long>(*it - '0');
+  }
+  value = negative ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+  return it;
+}
+} // end namespace itk
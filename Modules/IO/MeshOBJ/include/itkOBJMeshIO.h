@@ -23,6 +23,7 @@
 #include "itkMeshIOBase.h"
 #include "itkNumberToString.h"
 #include <fstream>
+#include <memory>
 
 namespace itk
 {
@@ -187,9 +188,22 @@ protected:
   CloseFile();
 
 private:
+  /** Text of the file split into ranges of lines, with the number of points,
+   * cells and normals which precede every range. */
+  struct FileContent;
+
+  /** Return the content read by ReadMeshInformation(). */
+  FileContent &
+  GetFileContent();
+
   std::ifstream  m_InputFile;
   std::streampos m_PointsStartPosition; // file position for points rlative to
                                         // std::ios::beg
+
+  /** Read once by ReadMeshInformation() and kept until the next file is read,
+   * so that the points, cells and normals are parsed without reading or
+   * splitting the file again. */
+  std::unique_ptr<FileContent> m_FileContent;
 };
 } // end namespace itk
 
@@ -17,14 +17,162 @@
  *=========================================================================*/
 
 #include "itkOBJMeshIO.h"
+#include "itkMeshFileTextParser.h"
+#include "itkMultiThreaderBase.h"
 #include "itkNumericTraits.h"
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
 #include <locale>
+#include <memory>
 #include <vector>
 
 
 namespace itk
 {
+namespace
+{
+enum class OBJLineEnum : uint8_t
+{
+  Other,
+  Vertex,
+  Normal,
+  Face
+};
+
+// The number of lines of each type of a range of lines
+struct OBJLineCounts
+{
+  SizeValueType NumberOfPoints{ 0 };
+  SizeValueType NumberOfCells{ 0 };
+  SizeValueType NumberOfCellPoints{ 0 };
+  SizeValueType NumberOfPointPixels{ 0 };
+};
+
+// The text of a file split into ranges of lines, with the offsets of the
+// ranges in the points, cells and point data
+struct OBJFileContent
+{
+  MeshFileTextParser                Text;
+  MeshFileTextParser::RangeListType Ranges;
+  std::vector<OBJLineCounts>        Offsets;
+};
+
+// Call function(type, content, lineEnd) for every line of a range, where
+// content follows the keyword of the line. Stop when function returns false.
+template <typename TFunction>
+bool
+ForEachOBJLine(const MeshFileTextParser::RangeType & range, TFunction function)
+{
+  for (const char * line = range.Begin; line != range.End; line = MeshFileTextParser::NextLine(line, range.End))
+  {
+    const char * lineEnd = MeshFileTextParser::FindEndOfLine(line, range.End);
+    const char * type = MeshFileTextParser::SkipWhitespace(line, lineEnd);
+    const char * content = MeshFileTextParser::SkipToken(type, lineEnd);
+
+    // A keyword without content is ignored
+    if (content == lineEnd)
+    {
+      continue;
+    }
+
+    OBJLineEnum lineType = OBJLineEnum::Other;
+    if (content - type == 1 && *type == 'v')
+    {
+      lineType = OBJLineEnum::Vertex;
+    }
+    else if (content - type == 1 && *type == 'f')
+    {
+      lineType = OBJLineEnum::Face;
+    }
+    else if (content - type == 2 && type[0] == 'v' && type[1] == 'n')
+    {
+      lineType = OBJLineEnum::Normal;
+    }
+
+    if (lineType != OBJLineEnum::Other && !function(lineType, content, lineEnd))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Read a file and count the lines of its ranges
+void
+ReadOBJFileContent(const std::string & fileName, OBJFileContent & content)
+{
+  if (fileName.empty())
+  {
+    itkGenericExceptionMacro("No input FileName");
+  }
+
+  if (!itksys::SystemTools::FileExists(fileName.c_str()))
+  {
+    itkGenericExceptionMacro("File " << fileName << " does not exist");
+  }
+
+  content.Text.ReadFile(fileName);
+  content.Ranges = MeshFileTextParser::SplitLines(
+    content.Text.GetBegin(),
+    content.Text.GetEnd(),
+    MeshFileTextParser::GetNumberOfRanges(content.Text.GetBegin(), content.Text.GetEnd()));
+
+  // Count the lines of every range, then accumulate the counts into the
+  // offsets of the ranges; the last element holds the counts of the file
+  content.Offsets.assign(content.Ranges.size() + 1, OBJLineCounts());
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    content.Ranges.size(),
+    [&content](SizeValueType range) {
+      OBJLineCounts & counts = content.Offsets[range + 1];
+      ForEachOBJLine(content.Ranges[range], [&counts](OBJLineEnum type, const char * it, const char * lineEnd) {
+        switch (type)
+        {
+          case OBJLineEnum::Vertex:
+            ++counts.NumberOfPoints;
+            break;
+          case OBJLineEnum::Normal:
+            ++counts.NumberOfPointPixels;
+            break;
+          case OBJLineEnum::Face:
+            ++counts.NumberOfCells;
+            counts.NumberOfCellPoints += MeshFileTextParser::CountTokens(it, lineEnd);
+            break;
+          default:
+            break;
+        }
+        return true;
+      });
+    },
+    nullptr);
+
+  for (size_t range = 1; range < content.Offsets.size(); ++range)
+  {
+    content.Offsets[range].NumberOfPoints += content.Offsets[range - 1].NumberOfPoints;
+    content.Offsets[range].NumberOfCells += content.Offsets[range - 1].NumberOfCells;
+    content.Offsets[range].NumberOfCellPoints += content.Offsets[range - 1].NumberOfCellPoints;
+    content.Offsets[range].NumberOfPointPixels += content.Offsets[range - 1].NumberOfPointPixels;
+  }
+}
+
+// Run parseRange(range, content) for all the ranges of lines in parallel
+template <typename TFunction>
+bool
+ParseOBJLines(OBJFileContent & content, TFunction parseRange)
+{
+  std::vector<char> valid(content.Ranges.size(), 1);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    content.Ranges.size(),
+    [&](SizeValueType range) { valid[range] = parseRange(range, content); },
+    nullptr);
+  return std::find(valid.begin(), valid.end(), 0) == valid.end();
+}
+} // namespace
+
+struct OBJMeshIO::FileContent : public OBJFileContent
+{};
+
 OBJMeshIO ::OBJMeshIO()
 {
   this->AddSupportedWriteExtension(".obj");
@@ -128,43 +276,19 @@ OBJMeshIO ::SplitLine(const std::string & line, std::string & type, std::string
 void
 OBJMeshIO ::ReadMeshInformation()
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Read and analyze the first line in the file
-  SizeValueType numberOfCellPoints = 0;
-  this->m_NumberOfPoints = 0;
-  this->m_NumberOfCells = 0;
-  this->m_NumberOfPointPixels = 0;
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
-      {
-        this->m_NumberOfPoints++;
-      }
-      else if (type == "f")
-      {
-        this->m_NumberOfCells++;
-
-        std::stringstream ss(inputLine);
-        std::string       item;
-        while (ss >> item)
-        {
-          numberOfCellPoints++;
-        }
-      }
-      else if (type == "vn")
-      {
-        this->m_NumberOfPointPixels++;
-        this->m_UpdatePointData = true;
-      }
-    }
+  // Count the points, faces and normals of the whole file in parallel
+  m_FileContent.reset();
+  std::unique_ptr<FileContent> content(new FileContent);
+  ReadOBJFileContent(this->m_FileName, *content);
+  m_FileContent = std::move(content);
+  const OBJLineCounts & counts = m_FileContent->Offsets.back();
+
+  this->m_NumberOfPoints = counts.NumberOfPoints;
+  this->m_NumberOfCells = counts.NumberOfCells;
+  this->m_NumberOfPointPixels = counts.NumberOfPointPixels;
+  if (this->m_NumberOfPointPixels)
+  {
+    this->m_UpdatePointData = true;
   }
 
   this->m_PointDimension = 3;
@@ -194,7 +318,7 @@ OBJMeshIO ::ReadMeshInformation()
 
   // Set default cell component type
   this->m_CellComponentType = IOComponentEnum::LONG;
-  this->m_CellBufferSize = this->m_NumberOfCells * 2 + numberOfCellPoints;
+  this->m_CellBufferSize = this->m_NumberOfCells * 2 + counts.NumberOfCellPoints;
 
   // Set default point pixel component and point pixel type
   this->m_PointPixelComponentType = IOComponentEnum::FLOAT;
@@ -207,136 +331,116 @@ OBJMeshIO ::ReadMeshInformation()
   this->m_CellPixelType = IOPixelEnum::VECTOR;
   this->m_NumberOfCellPixelComponents = 3;
   this->m_UpdateCellData = false;
-
-  CloseFile();
 }
 
 void
 OBJMeshIO ::ReadPoints(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
-
-  // Read and analyze the first line in the file
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
-      {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
-        {
-          ss >> data[index++];
-        }
-      }
-    }
+  OBJFileContent & content = this->GetFileContent();
+
+  // Every range of lines writes its vertices after those of the previous ranges
+  auto * data = static_cast<float *>(buffer);
+  if (!ParseOBJLines(content, [this, data](SizeValueType range, OBJFileContent & fileContent) {
+        SizeValueType index = fileContent.Offsets[range].NumberOfPoints * this->m_PointDimension;
+        return ForEachOBJLine(
+          fileContent.Ranges[range], [this, data, &index](OBJLineEnum type, const char * it, const char * lineEnd) {
+            if (type == OBJLineEnum::Vertex)
+            {
+              for (unsigned int ii = 0; ii < this->m_PointDimension && it != nullptr; ii++)
+              {
+                it = MeshFileTextParser::ParseNumber(it, lineEnd, data[index++]);
+              }
+            }
+            return it != nullptr;
+          });
+      }))
+  {
+    itkExceptionMacro(<< "Invalid vertex in file " << this->m_FileName);
   }
-
-  CloseFile();
 }
 
 void
 OBJMeshIO ::ReadCells(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Read and analyze the first line in the file
-  auto *        data = new long[this->m_CellBufferSize - this->m_NumberOfCells];
-  SizeValueType index = 0;
-
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "f")
-      {
-        std::stringstream ss(inputLine);
-        std::string       item;
-        std::vector<long> idList;
-        while (ss >> item)
-        {
-          long                   id;
-          std::string::size_type pos = item.find('/');
-          while (pos != std::string::npos)
-          {
-            item.replace(pos, 1, " ");
-            pos = item.find('/', pos);
-          }
-
-          std::stringstream st(item);
-          st >> id;
-
-          idList.push_back(id);
-        }
-
-        data[index++] = static_cast<long>(idList.size());
-        for (long it : idList)
-        {
-          data[index++] = (it - 1);
-        }
-      }
-    }
+  OBJFileContent & content = this->GetFileContent();
+
+  // The faces are written as polygons straight into the cell buffer: every
+  // face takes its cell type, its number of points and its point ids
+  auto * data = static_cast<long *>(buffer);
+  if (!ParseOBJLines(content, [data](SizeValueType range, OBJFileContent & fileContent) {
+        const OBJLineCounts & offsets = fileContent.Offsets[range];
+        SizeValueType         index = offsets.NumberOfCells * 2 + offsets.NumberOfCellPoints;
+        return ForEachOBJLine(
+          fileContent.Ranges[range], [data, &index](OBJLineEnum type, const char * it, const char * lineEnd) {
+            if (type != OBJLineEnum::Face)
+            {
+              return true;
+            }
+
+            data[index++] = static_cast<long>(CellGeometryEnum::POLYGON_CELL);
+            long & numberOfCellPoints = data[index++];
+            numberOfCellPoints = 0;
+
+            // Only the vertex index of the "v/vt/vn" items is kept
+            for (it = MeshFileTextParser::SkipWhitespace(it, lineEnd); it != lineEnd;
+                 it = MeshFileTextParser::SkipWhitespace(MeshFileTextParser::SkipToken(it, lineEnd), lineEnd))
+            {
+              long long id;
+              if (MeshFileTextParser::ParseNumber(it, lineEnd, id) == nullptr)
+              {
+                return false;
+              }
+              data[index++] = static_cast<long>(id - 1);
+              ++numberOfCellPoints;
+            }
+            return true;
+          });
+      }))
+  {
+    itkExceptionMacro(<< "Invalid face in file " << this->m_FileName);
   }
-
-  CloseFile();
-
-  this->WriteCellsBuffer(data, static_cast<long *>(buffer), CellGeometryEnum::POLYGON_CELL, this->m_NumberOfCells);
-  // this->WriteCellsBuffer(data, static_cast<unsigned int *>(buffer),
-  // CellGeometryEnum::TRIANGLE_CELL, 3, this->m_NumberOfCells);
-  delete[] data;
 }
 
 void
 OBJMeshIO ::ReadPointData(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
-
-  // Read and analyze the first line in the file
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "vn")
-      {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
-        {
-          ss >> data[index++];
-        }
-      }
-    }
+  OBJFileContent & content = this->GetFileContent();
+
+  // Every range of lines writes its normals after those of the previous ranges
+  auto * data = static_cast<float *>(buffer);
+  if (!ParseOBJLines(content, [this, data](SizeValueType range, OBJFileContent & fileContent) {
+        SizeValueType index = fileContent.Offsets[range].NumberOfPointPixels * this->m_PointDimension;
+        return ForEachOBJLine(
+          fileContent.Ranges[range], [this, data, &index](OBJLineEnum type, const char * it, const char * lineEnd) {
+            if (type == OBJLineEnum::Normal)
+            {
+              for (unsigned int ii = 0; ii < this->m_PointDimension && it != nullptr; ii++)
+              {
+                it = MeshFileTextParser::ParseNumber(it, lineEnd, data[index++]);
+              }
+            }
+            return it != nullptr;
+          });
+      }))
+  {
+    itkExceptionMacro(<< "Invalid vertex normal in file " << this->m_FileName);
   }
-
-  CloseFile();
 }
 
 void
 OBJMeshIO ::ReadCellData(void * itkNotUsed(buffer))
 {}
 
+OBJMeshIO::FileContent &
+OBJMeshIO ::GetFileContent()
+{
+  if (m_FileContent == nullptr)
+  {
+    itkExceptionMacro(<< "ReadMeshInformation() must be called before reading " << this->m_FileName);
+  }
+  return *m_FileContent;
+}
+
 void
 OBJMeshIO ::WriteMeshInformation()
 {
@@ -20,6 +20,7 @@
 #define itkOFFMeshIO_h
 #include "ITKIOMeshOFFExport.h"
 
+#include "itkMeshFileTextParser.h"
 #include "itkMeshIOBase.h"
 
 #include <fstream>
@@ -203,9 +204,22 @@ protected:
   void
   CloseFile();
 
+  /** Parse the cells of an ASCII file in parallel, straight into the cell buffer. */
+  void
+  ReadCellsAsAscii(unsigned int * buffer);
+
+  /** Return the beginning of the cells in the text of an ASCII file. */
+  const char *
+  GetCellsBegin() const;
+
 private:
   std::ifstream    m_InputFile;
   StreamOffsetType m_PointsStartPosition; // file position for points rlative to std::ios::beg
+  StreamOffsetType m_CellsStartPosition;  // position of the cells in the text of an ASCII file
+  /** Text of an ASCII file, read once by ReadMeshInformation() and kept until
+   * the next file is read, so that the points and cells are parsed without
+   * reading the file again. */
+  MeshFileTextParser m_Text;
   bool             m_TriangleCellType;    // if all cells are trinalge it is true. otherwise, it is false.
 };
 } // end namespace itk
@@ -17,16 +17,92 @@
  *=========================================================================*/
 
 #include "itkOFFMeshIO.h"
+#include "itkMultiThreaderBase.h"
 
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
+#include <numeric>
 
 namespace itk
 {
+namespace
+{
+// The non-empty lines of a part of a file, split into ranges which are
+// parsed in parallel
+struct OFFLineRanges
+{
+  OFFLineRanges(const char * begin, const char * end)
+    : Ranges(MeshFileTextParser::SplitLines(begin, end, MeshFileTextParser::GetNumberOfRanges(begin, end)))
+    , FirstLines(Ranges.size() + 1, 0)
+  {
+    MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      Ranges.size(),
+      [this](SizeValueType range) {
+        this->ForEachLine(range, [this, range](const char *, const char *) {
+          ++FirstLines[range + 1];
+          return true;
+        });
+      },
+      nullptr);
+    std::partial_sum(FirstLines.begin(), FirstLines.end(), FirstLines.begin());
+  }
+
+  SizeValueType
+  GetNumberOfLines() const
+  {
+    return FirstLines.back();
+  }
+
+  // Call function(it, lineEnd) for the non-empty lines of a range
+  template <typename TFunction>
+  bool
+  ForEachLine(SizeValueType range, TFunction function) const
+  {
+    const char * end = Ranges[range].End;
+    for (const char * line = Ranges[range].Begin; line != end; line = MeshFileTextParser::NextLine(line, end))
+    {
+      const char * lineEnd = MeshFileTextParser::FindEndOfLine(line, end);
+      const char * it = MeshFileTextParser::SkipWhitespace(line, lineEnd);
+      if (it != lineEnd && !function(it, lineEnd))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Call function(range, line, it, lineEnd) in parallel for the first
+  // numberOfLines non-empty lines, where line is the index of the line
+  template <typename TFunction>
+  bool
+  ParseLines(SizeValueType numberOfLines, TFunction function) const
+  {
+    std::vector<char> valid(Ranges.size(), 1);
+    MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      Ranges.size(),
+      [&](SizeValueType range) {
+        SizeValueType line = FirstLines[range];
+        valid[range] = this->ForEachLine(range, [&](const char * it, const char * lineEnd) {
+          return line >= numberOfLines || function(range, line++, it, lineEnd);
+        });
+      },
+      nullptr);
+    return std::find(valid.begin(), valid.end(), 0) == valid.end();
+  }
+
+  MeshFileTextParser::RangeListType Ranges;
+  std::vector<SizeValueType>        FirstLines;
+};
+} // namespace
+
 OFFMeshIO ::OFFMeshIO()
 {
   this->AddSupportedWriteExtension(".off");
   this->SetByteOrderToBigEndian();
   m_PointsStartPosition = itk::NumericTraits<StreamOffsetType>::ZeroValue();
+  m_CellsStartPosition = itk::NumericTraits<StreamOffsetType>::ZeroValue();
   m_TriangleCellType = true;
 }
 
@@ -161,31 +237,51 @@ OFFMeshIO ::ReadMeshInformation()
     // Read points start position in the file
     m_PointsStartPosition = m_InputFile.tellg();
 
-    for (SizeValueType id = 0; id < this->m_NumberOfPoints; id++)
-    {
-      std::getline(m_InputFile, line, '\n');
-    }
-
     // Set default cell component type
     this->m_CellBufferSize = this->m_NumberOfCells * 2;
 
-    // Read each ecll's number of points and put them to cell buffer size
-    unsigned int numberOfCellPoints = 0;
-    for (SizeValueType id = 0; id < this->m_NumberOfCells; id++)
+    // Keep the text for ReadPoints() and ReadCells(), and find where the
+    // cells begin, after the lines of the points
+    m_Text.ReadFile(this->m_FileName);
+    const char * cellsBegin = m_Text.GetBegin() + m_PointsStartPosition;
+    for (SizeValueType id = 0; id < this->m_NumberOfPoints; id++)
     {
-      m_InputFile >> numberOfCellPoints;
-      this->m_CellBufferSize += numberOfCellPoints;
-      std::getline(m_InputFile, line, '\n');
-
-      if (numberOfCellPoints != 3)
-      {
-        m_TriangleCellType = false;
-      }
+      cellsBegin = MeshFileTextParser::NextLine(cellsBegin, m_Text.GetEnd());
+    }
+    m_CellsStartPosition = cellsBegin - m_Text.GetBegin();
+
+    // Sum the number of points of the cells, in parallel
+    const OFFLineRanges cellLines(this->GetCellsBegin(), m_Text.GetEnd());
+
+    std::vector<SizeValueType> numberOfCellPoints(cellLines.Ranges.size(), 0);
+    std::vector<char>          triangleCells(cellLines.Ranges.size(), 1);
+    const bool                 valid = cellLines.ParseLines(
+      this->m_NumberOfCells, [&](SizeValueType range, SizeValueType, const char * it, const char * lineEnd) {
+        long long numberOfPoints;
+        if (MeshFileTextParser::ParseNumber(it, lineEnd, numberOfPoints) == nullptr || numberOfPoints < 0)
+        {
+          return false;
+        }
+        numberOfCellPoints[range] += static_cast<SizeValueType>(numberOfPoints);
+        if (numberOfPoints != 3)
+        {
+          triangleCells[range] = 0;
+        }
+        return true;
+      });
+    if (!valid || cellLines.GetNumberOfLines() < this->m_NumberOfCells)
+    {
+      itkExceptionMacro(<< "Invalid cells in file " << this->m_FileName);
     }
+
+    this->m_CellBufferSize += std::accumulate(numberOfCellPoints.begin(), numberOfCellPoints.end(), SizeValueType{ 0 });
+    m_TriangleCellType = std::find(triangleCells.begin(), triangleCells.end(), 0) == triangleCells.end();
   }
   // Read points and cells information from binary mesh
   else if (this->m_FileType == IOFileEnum::BINARY)
   {
+    m_Text.Clear();
+
     // Read the number of points
     itk::uint32_t numberOfPoints;
     this->ReadBufferAsBinary(&numberOfPoints, m_InputFile, 1);
@@ -267,7 +363,24 @@ OFFMeshIO ::ReadPoints(void * buffer)
   // Read file according to ASCII or BINARY
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    this->ReadBufferAsAscii(static_cast<float *>(buffer), m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
+    // Every point takes the first coordinates of its line
+    const char *        pointsBegin = m_Text.GetBegin() + m_PointsStartPosition;
+    const OFFLineRanges pointLines(pointsBegin, this->GetCellsBegin());
+
+    auto *     data = static_cast<float *>(buffer);
+    const bool valid = pointLines.ParseLines(
+      this->m_NumberOfPoints, [this, data](SizeValueType, SizeValueType line, const char * it, const char * lineEnd) {
+        SizeValueType index = line * this->m_PointDimension;
+        for (unsigned int ii = 0; ii < this->m_PointDimension && it != nullptr; ii++)
+        {
+          it = MeshFileTextParser::ParseNumber(it, lineEnd, data[index++]);
+        }
+        return it != nullptr;
+      });
+    if (!valid || pointLines.GetNumberOfLines() < this->m_NumberOfPoints)
+    {
+      itkExceptionMacro(<< "Invalid points in file " << this->m_FileName);
+    }
   }
   else if (this->m_FileType == IOFileEnum::BINARY)
   {
@@ -283,13 +396,16 @@ OFFMeshIO ::ReadPoints(void * buffer)
 void
 OFFMeshIO ::ReadCells(void * buffer)
 {
-  auto * data = new itk::uint32_t[this->m_CellBufferSize - this->m_NumberOfCells];
-
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    this->ReadCellsBufferAsAscii(data, m_InputFile);
+    CloseFile();
+    this->ReadCellsAsAscii(static_cast<unsigned int *>(buffer));
+    return;
   }
-  else if (this->m_FileType == IOFileEnum::BINARY)
+
+  auto * data = new itk::uint32_t[this->m_CellBufferSize - this->m_NumberOfCells];
+
+  if (this->m_FileType == IOFileEnum::BINARY)
   {
     this->ReadBufferAsBinary(data, m_InputFile, this->m_CellBufferSize - this->m_NumberOfCells);
   }
@@ -314,6 +430,61 @@ OFFMeshIO ::ReadCells(void * buffer)
   delete[] data;
 }
 
+void
+OFFMeshIO ::ReadCellsAsAscii(unsigned int * buffer)
+{
+  const OFFLineRanges cellLines(this->GetCellsBegin(), m_Text.GetEnd());
+
+  // First sum the number of points of the cells of every range, to know
+  // where the cells of the range start in the buffer
+  std::vector<SizeValueType> offsets(cellLines.Ranges.size() + 1, 0);
+  bool                       valid = cellLines.ParseLines(
+    this->m_NumberOfCells, [&offsets](SizeValueType range, SizeValueType, const char * it, const char * lineEnd) {
+      long long numberOfPoints;
+      if (MeshFileTextParser::ParseNumber(it, lineEnd, numberOfPoints) == nullptr || numberOfPoints < 0)
+      {
+        return false;
+      }
+      offsets[range + 1] += 2 + static_cast<SizeValueType>(numberOfPoints);
+      return true;
+    });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  if (!valid || offsets.back() != this->m_CellBufferSize)
+  {
+    itkExceptionMacro(<< "Invalid cells in file " << this->m_FileName);
+  }
+
+  // Then write the cells straight into the buffer; the values which follow
+  // the point ids, such as colors, are ignored
+  const auto cellType = static_cast<unsigned int>(m_TriangleCellType ? CellGeometryEnum::TRIANGLE_CELL
+                                                                     : CellGeometryEnum::POLYGON_CELL);
+  std::vector<SizeValueType> indices(offsets.begin(), offsets.end() - 1);
+  valid = cellLines.ParseLines(
+    this->m_NumberOfCells,
+    [buffer, cellType, &indices](SizeValueType range, SizeValueType, const char * it, const char * lineEnd) {
+      SizeValueType & index = indices[range];
+      long long       numberOfPoints;
+      it = MeshFileTextParser::ParseNumber(it, lineEnd, numberOfPoints);
+      buffer[index++] = cellType;
+      buffer[index++] = static_cast<unsigned int>(numberOfPoints);
+      for (long long jj = 0; jj < numberOfPoints && it != nullptr; jj++)
+      {
+        it = MeshFileTextParser::ParseValue(it, lineEnd, buffer[index++]);
+      }
+      return it != nullptr;
+    });
+  if (!valid)
+  {
+    itkExceptionMacro(<< "Invalid cells in file " << this->m_FileName);
+  }
+}
+
+const char *
+OFFMeshIO ::GetCellsBegin() const
+{
+  return m_Text.GetBegin() + m_CellsStartPosition;
+}
+
 void
 OFFMeshIO ::ReadPointData(void * itkNotUsed(buffer))
 {}
@@ -21,6 +21,7 @@
 
 #include "itkByteSwapper.h"
 #include "itkMetaDataObject.h"
+#include "itkMeshFileTextParser.h"
 #include "itkMeshIOBase.h"
 #include "itkVectorContainer.h"
 #include "itkNumberToString.h"
@@ -190,24 +191,15 @@ protected:
 
   template <typename T>
   void
-  ReadPointsBufferAsASCII(std::ifstream & inputFile, T * buffer)
+  ReadPointsBufferAsASCII(const MeshFileTextParser & text, T * buffer)
   {
-    std::string line;
-
-    while (!inputFile.eof())
-    {
-      std::getline(inputFile, line, '\n');
-
-      if (line.find("POINTS") != std::string::npos)
-      {
-        /**  Load the point coordinates into the itk::Mesh */
-        SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        for (SizeValueType ii = 0; ii < numberOfComponents; ii++)
-        {
-          inputFile >> buffer[ii];
-        }
-      }
-    }
+    /**  Load the point coordinates into the itk::Mesh, parsing them in parallel */
+    const char *        end = text.GetEnd();
+    const char *        points = MeshFileTextParser::FindLine(text.GetBegin(), end, "POINTS");
+    const SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
+    points = MeshFileTextParser::NextLine(points, end);
+    const char * pointsEnd = MeshFileTextParser::FindKeywordLine(points, end);
+    MeshFileTextParser::ParseValues(points, pointsEnd, buffer, numberOfComponents);
   }
 
   template <typename T>
@@ -234,56 +226,17 @@ protected:
   }
 
   void
-  ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buffer);
+  ReadCellsBufferAsASCII(const MeshFileTextParser & text, void * buffer);
 
   void
   ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * buffer);
 
   template <typename T>
   void
-  ReadPointDataBufferAsASCII(std::ifstream & inputFile, T * buffer)
+  ReadPointDataBufferAsASCII(const MeshFileTextParser & text, T * buffer)
   {
-    StringType line;
-
-    while (!inputFile.eof())
-    {
-      std::getline(inputFile, line, '\n');
-      if (line.find("POINT_DATA") != std::string::npos)
-      {
-        if (!inputFile.eof())
-        {
-          std::getline(inputFile, line, '\n');
-        }
-        else
-        {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-        }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
-        {
-          if (!inputFile.eof())
-          {
-            std::getline(inputFile, line, '\n');
-            if (line.find("LOOKUP_TABLE") == std::string::npos)
-            {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-          else
-          {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-          }
-        }
-
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents;
-        for (SizeValueType ii = 0; ii < numberOfComponents; ii++)
-        {
-          inputFile >> buffer[ii];
-        }
-      }
-    }
+    this->ReadPixelDataBufferAsASCII(
+      text, "POINT_DATA", buffer, this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents);
   }
 
   template <typename T>
@@ -336,49 +289,48 @@ protected:
 
   template <typename T>
   void
-  ReadCellDataBufferAsASCII(std::ifstream & inputFile, T * buffer)
+  ReadCellDataBufferAsASCII(const MeshFileTextParser & text, T * buffer)
   {
-    StringType line;
+    this->ReadPixelDataBufferAsASCII(
+      text, "CELL_DATA", buffer, this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents);
+  }
 
-    while (!inputFile.eof())
+  /** Read the values of the POINT_DATA or CELL_DATA section, parsing them in parallel */
+  template <typename T>
+  void
+  ReadPixelDataBufferAsASCII(const MeshFileTextParser & text,
+                             const char *               keyword,
+                             T *                        buffer,
+                             SizeValueType              numberOfComponents)
+  {
+    const char * end = text.GetEnd();
+    const char * line = MeshFileTextParser::FindLine(text.GetBegin(), end, keyword);
+    if (line == end)
     {
-      std::getline(inputFile, line, '\n');
-      if (line.find("CELL_DATA") != std::string::npos)
-      {
-        if (!inputFile.eof())
-        {
-          std::getline(inputFile, line, '\n');
-        }
-        else
-        {
-          itkExceptionMacro("UnExpected end of line while trying to read CELL_DATA");
-        }
+      return;
+    }
 
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if (line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos)
-        {
-          if (!inputFile.eof())
-          {
-            std::getline(inputFile, line, '\n');
-            if (line.find("LOOKUP_TABLE") == std::string::npos)
-            {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-          else
-          {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-          }
-        }
+    line = MeshFileTextParser::NextLine(line, end);
+    if (line == end)
+    {
+      itkExceptionMacro("UnExpected end of line while trying to read " << keyword);
+    }
+    const StringType dataHeader(line, MeshFileTextParser::FindEndOfLine(line, end));
+    line = MeshFileTextParser::NextLine(line, end);
 
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents;
-        for (SizeValueType ii = 0; ii < numberOfComponents; ii++)
-        {
-          inputFile >> buffer[ii];
-        }
+    /** For scalars we have to read the next line of LOOKUP_TABLE */
+    if (dataHeader.find("SCALARS") != std::string::npos && dataHeader.find("COLOR_SCALARS") == std::string::npos)
+    {
+      if (line == end || StringType(line, MeshFileTextParser::FindEndOfLine(line, end)).find("LOOKUP_TABLE") ==
+                           std::string::npos)
+      {
+        itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
       }
+      line = MeshFileTextParser::NextLine(line, end);
     }
+
+    /** for VECTORS or NORMALS or TENSORS, we could read them directly */
+    MeshFileTextParser::ParseValues(line, MeshFileTextParser::FindKeywordLine(line, end), buffer, numberOfComponents);
   }
 
   template <typename T>
@@ -1189,6 +1141,12 @@ protected:
   /** Convenience method returns the IOComponentEnum corresponding to a string. */
   IOComponentEnum
   GetComponentTypeFromString(const std::string & pixelType);
+
+private:
+  /** Text of an ASCII file, read once by ReadMeshInformation() and kept until
+   * the next file is read, so that the points, cells and data are parsed
+   * without reading the file again. */
+  MeshFileTextParser m_Text;
 };
 } // end namespace itk
 
@@ -17,12 +17,117 @@
  *=========================================================================*/
 
 #include "itkVTKPolyDataMeshIO.h"
+#include "itkMultiThreaderBase.h"
 
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
 #include <fstream>
+#include <numeric>
 
 namespace itk
 {
+namespace
+{
+// Parse the cells of a section of an ASCII file, each one made of its number of
+// points followed by the point ids, into the cell type, the number of points
+// and the point ids. Cells written one per line are parsed in parallel.
+bool
+ParseCellsAsASCII(const char *   begin,
+                  const char *   end,
+                  unsigned int   cellType,
+                  SizeValueType  numberOfCells,
+                  SizeValueType  numberOfIndices,
+                  unsigned int * data)
+{
+  const MeshFileTextParser::RangeListType ranges =
+    MeshFileTextParser::SplitLines(begin, end, MeshFileTextParser::GetNumberOfRanges(begin, end));
+
+  // Count the lines and the values of every range, to know where its cells go
+  std::vector<SizeValueType> offsets(ranges.size() + 1, 0);
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    ranges.size(),
+    [&ranges, &offsets](SizeValueType i) {
+      for (const char * line = ranges[i].Begin; line != ranges[i].End;
+           line = MeshFileTextParser::NextLine(line, ranges[i].End))
+      {
+        const char * lineEnd = MeshFileTextParser::FindEndOfLine(line, ranges[i].End);
+        if (MeshFileTextParser::SkipWhitespace(line, lineEnd) != lineEnd)
+        {
+          offsets[i + 1] += 1 + MeshFileTextParser::CountTokens(line, lineEnd);
+        }
+      }
+    },
+    nullptr);
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  if (offsets.back() == numberOfCells + numberOfIndices)
+  {
+    std::vector<char> valid(ranges.size(), 1);
+    multiThreader->ParallelizeArray(
+      0,
+      ranges.size(),
+      [&](SizeValueType i) {
+        SizeValueType index = offsets[i];
+        for (const char * line = ranges[i].Begin; line != ranges[i].End;
+             line = MeshFileTextParser::NextLine(line, ranges[i].End))
+        {
+          const char * lineEnd = MeshFileTextParser::FindEndOfLine(line, ranges[i].End);
+          if (MeshFileTextParser::SkipWhitespace(line, lineEnd) == lineEnd)
+          {
+            continue;
+          }
+
+          long long    numberOfPoints = 0;
+          const char * it = MeshFileTextParser::ParseNumber(line, lineEnd, numberOfPoints);
+          data[index++] = cellType;
+          data[index++] = static_cast<unsigned int>(numberOfPoints);
+          for (long long jj = 0; jj < numberOfPoints && it != nullptr; jj++)
+          {
+            it = MeshFileTextParser::ParseValue(it, lineEnd, data[index++]);
+          }
+          if (it == nullptr || numberOfPoints < 0 || MeshFileTextParser::SkipWhitespace(it, lineEnd) != lineEnd)
+          {
+            valid[i] = 0;
+            return;
+          }
+        }
+      },
+      nullptr);
+    if (std::find(valid.begin(), valid.end(), 0) == valid.end())
+    {
+      return true;
+    }
+  }
+
+  // Otherwise the cells are not one per line, and they are parsed serially
+  const char *  it = begin;
+  SizeValueType index = 0;
+  for (SizeValueType ii = 0; ii < numberOfCells; ii++)
+  {
+    long long numberOfPoints = 0;
+    it = MeshFileTextParser::ParseNumber(it, end, numberOfPoints);
+    if (it == nullptr || numberOfPoints < 0 ||
+        index + 2 + static_cast<SizeValueType>(numberOfPoints) > numberOfCells + numberOfIndices)
+    {
+      return false;
+    }
+    data[index++] = cellType;
+    data[index++] = static_cast<unsigned int>(numberOfPoints);
+    for (long long jj = 0; jj < numberOfPoints; jj++)
+    {
+      it = MeshFileTextParser::ParseValue(it, end, data[index++]);
+      if (it == nullptr)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
 // Constructor
 VTKPolyDataMeshIO ::VTKPolyDataMeshIO()
 {
@@ -191,6 +296,8 @@ VTKPolyDataMeshIO::GetComponentTypeFromString(const std::string & pointType)
 void
 VTKPolyDataMeshIO ::ReadMeshInformation()
 {
+  m_Text.Clear();
+
   std::ifstream inputFile;
 
   // Use default filetype
@@ -684,6 +791,12 @@ VTKPolyDataMeshIO ::ReadMeshInformation()
   }
 
   inputFile.close();
+
+  // The text of ASCII files is kept for the Read* methods
+  if (this->m_FileType == IOFileEnum::ASCII)
+  {
+    m_Text.ReadFile(this->m_FileName);
+  }
 }
 
 #define CASE_INVOKE_BY_TYPE(function, param)                                                                           \
@@ -756,13 +869,24 @@ VTKPolyDataMeshIO ::ReadMeshInformation()
 void
 VTKPolyDataMeshIO ::ReadPoints(void * buffer)
 {
-  std::ifstream inputFile;
-
+  // ASCII files are read at once and parsed in parallel
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
+    switch (this->m_PointComponentType)
+    {
+      CASE_INVOKE_BY_TYPE(ReadPointsBufferAsASCII, m_Text)
+
+      default:
+      {
+        itkExceptionMacro(<< "Unknown point component type");
+      }
+    }
+    return;
   }
-  else if (m_FileType == IOFileEnum::BINARY)
+
+  std::ifstream inputFile;
+
+  if (m_FileType == IOFileEnum::BINARY)
   {
     inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
   }
@@ -775,19 +899,7 @@ VTKPolyDataMeshIO ::ReadPoints(void * buffer)
   }
 
 
-  if (this->m_FileType == IOFileEnum::ASCII)
-  {
-    switch (this->m_PointComponentType)
-    {
-      CASE_INVOKE_BY_TYPE(ReadPointsBufferAsASCII, inputFile)
-
-      default:
-      {
-        itkExceptionMacro(<< "Unknown point component type");
-      }
-    }
-  }
-  else if (this->m_FileType == IOFileEnum::BINARY)
+  if (this->m_FileType == IOFileEnum::BINARY)
   {
     switch (this->m_PointComponentType)
     {
@@ -810,13 +922,16 @@ VTKPolyDataMeshIO ::ReadPoints(void * buffer)
 void
 VTKPolyDataMeshIO ::ReadCells(void * buffer)
 {
-  std::ifstream inputFile;
-
+  // ASCII files are read at once and parsed in parallel
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
+    ReadCellsBufferAsASCII(m_Text, buffer);
+    return;
   }
-  else if (m_FileType == IOFileEnum::BINARY)
+
+  std::ifstream inputFile;
+
+  if (m_FileType == IOFileEnum::BINARY)
   {
     inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
   }
@@ -829,11 +944,7 @@ VTKPolyDataMeshIO ::ReadCells(void * buffer)
   }
 
 
-  if (this->m_FileType == IOFileEnum::ASCII)
-  {
-    ReadCellsBufferAsASCII(inputFile, buffer);
-  }
-  else if (this->m_FileType == IOFileEnum::BINARY)
+  if (this->m_FileType == IOFileEnum::BINARY)
   {
     ReadCellsBufferAsBINARY(inputFile, buffer);
   }
@@ -846,68 +957,58 @@ VTKPolyDataMeshIO ::ReadCells(void * buffer)
 }
 
 void
-VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buffer)
+VTKPolyDataMeshIO::ReadCellsBufferAsASCII(const MeshFileTextParser & text, void * buffer)
 {
-  std::string   line;
-  SizeValueType index = 0;
-  unsigned int  numPoints; // number of point in each cell
-
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
   using GeometryIntegerType = unsigned int;
   auto * data = static_cast<GeometryIntegerType *>(buffer);
 
-  while (!inputFile.eof())
-  {
-    std::getline(inputFile, line, '\n');
-    if (line.find("VERTICES") != std::string::npos)
+  // The sections of cells are read in the order of the file
+  struct CellSection
+  {
+    const char *     Keyword;
+    CellGeometryEnum Type;
+    const char *     NumberOfCellsKey;
+    const char *     NumberOfIndicesKey;
+    const char *     Line;
+    unsigned int     NumberOfCells;
+    unsigned int     NumberOfIndices;
+  };
+  std::vector<CellSection> sections;
+  const char *             end = text.GetEnd();
+  const CellSection        cellSections[] = {
+    { "VERTICES", CellGeometryEnum::VERTEX_CELL, "numberOfVertices", "numberOfVertexIndices", nullptr, 0, 0 },
+    { "LINES", CellGeometryEnum::LINE_CELL, "numberOfLines", "numberOfLineIndices", nullptr, 0, 0 },
+    { "POLYGONS", CellGeometryEnum::POLYGON_CELL, "numberOfPolygons", "numberOfPolygonIndices", nullptr, 0, 0 }
+  };
+  for (CellSection section : cellSections)
+  {
+    section.Line = MeshFileTextParser::FindLine(text.GetBegin(), end, section.Keyword);
+    if (section.Line != end)
     {
-      unsigned int numberOfVertices = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfVertices", numberOfVertices);
-
-      for (unsigned int ii = 0; ii < numberOfVertices; ii++)
-      {
-        inputFile >> numPoints;
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::VERTEX_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
+      ExposeMetaData<unsigned int>(metaDic, section.NumberOfCellsKey, section.NumberOfCells);
+      ExposeMetaData<unsigned int>(metaDic, section.NumberOfIndicesKey, section.NumberOfIndices);
+      sections.push_back(section);
     }
-    else if (line.find("LINES") != std::string::npos)
-    {
-      unsigned int numberOfLines = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfLines", numberOfLines);
+  }
+  std::sort(sections.begin(), sections.end(), [](const CellSection & a, const CellSection & b) {
+    return a.Line < b.Line;
+  });
 
-      for (unsigned int ii = 0; ii < numberOfLines; ii++)
-      {
-        inputFile >> numPoints;
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::LINE_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
-    }
-    else if (line.find("POLYGONS") != std::string::npos)
+  SizeValueType index = 0;
+  for (const auto & section : sections)
+  {
+    const char * cells = MeshFileTextParser::NextLine(section.Line, end);
+    if (!ParseCellsAsASCII(cells,
+                           MeshFileTextParser::FindKeywordLine(cells, end),
+                           static_cast<GeometryIntegerType>(section.Type),
+                           section.NumberOfCells,
+                           section.NumberOfIndices,
+                           data + index))
     {
-      unsigned int numberOfPolygons = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfPolygons", numberOfPolygons);
-
-      for (unsigned int ii = 0; ii < numberOfPolygons; ii++)
-      {
-        inputFile >> numPoints;
-
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::POLYGON_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
+      itkExceptionMacro(<< "Invalid cells in file " << this->m_FileName);
     }
+    index += section.NumberOfCells + section.NumberOfIndices;
   }
 }
 
@@ -996,13 +1097,24 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
 void
 VTKPolyDataMeshIO ::ReadPointData(void * buffer)
 {
-  std::ifstream inputFile;
-
+  // ASCII files are read at once and parsed in parallel
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
+    switch (this->m_PointPixelComponentType)
+    {
+      CASE_INVOKE_BY_TYPE(ReadPointDataBufferAsASCII, m_Text)
+
+      default:
+      {
+        itkExceptionMacro(<< "Unknown point pixel component");
+      }
+    }
+    return;
   }
-  else if (m_FileType == IOFileEnum::BINARY)
+
+  std::ifstream inputFile;
+
+  if (m_FileType == IOFileEnum::BINARY)
   {
     inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
   }
@@ -1015,19 +1127,7 @@ VTKPolyDataMeshIO ::ReadPointData(void * buffer)
   }
 
 
-  if (this->m_FileType == IOFileEnum::ASCII)
-  {
-    switch (this->m_PointPixelComponentType)
-    {
-      CASE_INVOKE_BY_TYPE(ReadPointDataBufferAsASCII, inputFile)
-
-      default:
-      {
-        itkExceptionMacro(<< "Unknown point pixel component");
-      }
-    }
-  }
-  else if (this->m_FileType == IOFileEnum::BINARY)
+  if (this->m_FileType == IOFileEnum::BINARY)
   {
     switch (this->m_PointPixelComponentType)
     {
@@ -1050,13 +1150,24 @@ VTKPolyDataMeshIO ::ReadPointData(void * buffer)
 void
 VTKPolyDataMeshIO ::ReadCellData(void * buffer)
 {
-  std::ifstream inputFile;
-
+  // ASCII files are read at once and parsed in parallel
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
+    switch (this->m_CellPixelComponentType)
+    {
+      CASE_INVOKE_BY_TYPE(ReadCellDataBufferAsASCII, m_Text)
+
+      default:
+      {
+        itkExceptionMacro(<< "Unknown cell pixel component");
+      }
+    }
+    return;
   }
-  else if (m_FileType == IOFileEnum::BINARY)
+
+  std::ifstream inputFile;
+
+  if (m_FileType == IOFileEnum::BINARY)
   {
     inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
   }
@@ -1069,19 +1180,7 @@ VTKPolyDataMeshIO ::ReadCellData(void * buffer)
   }
 
 
-  if (this->m_FileType == IOFileEnum::ASCII)
-  {
-    switch (this->m_CellPixelComponentType)
-    {
-      CASE_INVOKE_BY_TYPE(ReadCellDataBufferAsASCII, inputFile)
-
-      default:
-      {
-        itkExceptionMacro(<< "Unknown cell pixel component");
-      }
-    }
-  }
-  else if (this->m_FileType == IOFileEnum::BINARY)
+  if (this->m_FileType == IOFileEnum::BINARY)
   {
     switch (this->m_CellPixelComponentType)
     {
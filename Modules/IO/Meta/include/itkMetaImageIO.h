@@ -37,6 +37,9 @@ namespace itk
  *  For a detailed description of using this format, please see
  *  https://www.itk.org/Wiki/ITK/MetaIO/Documentation
  *
+ *  Large compressed data is deflated in blocks by
+ *  NumberOfCompressionThreads threads.
+ *
  *  \ingroup IOFilters
  * \ingroup ITKIOMeta
  */
@@ -167,6 +170,12 @@ public:
   itkSetMacro(SubSamplingFactor, unsigned int);
   itkGetConstMacro(SubSamplingFactor, unsigned int);
 
+  /** Set/Get the number of threads deflating large compressed data when
+   * writing. It is forwarded to the MetaImage before each write. Defaults to
+   * MultiThreaderBase::GetGlobalDefaultNumberOfThreads() at construction. */
+  itkSetClampMacro(NumberOfCompressionThreads, ThreadIdType, 1, NumericTraits<ThreadIdType>::max());
+  itkGetConstMacro(NumberOfCompressionThreads, ThreadIdType);
+
   /**
    * Set the default precision when writing out the MetaImage header.
    * MetaImage header contains values stored in memory as double,
@@ -199,6 +208,8 @@ private:
 
   unsigned int m_SubSamplingFactor;
 
+  ThreadIdType m_NumberOfCompressionThreads;
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
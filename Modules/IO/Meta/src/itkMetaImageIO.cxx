@@ -22,6 +22,7 @@
 #include "itksys/SystemTools.hxx"
 #include "itkMath.h"
 #include "itkSingleton.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -36,6 +37,7 @@ MetaImageIO::MetaImageIO()
   itkInitGlobalsMacro(DefaultDoublePrecision);
   m_FileType = IOFileEnum::Binary;
   m_SubSamplingFactor = 1;
+  m_NumberOfCompressionThreads = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
   if (MET_SystemByteOrderMSB())
   {
     m_ByteOrder = IOByteOrderEnum::BigEndian;
@@ -66,6 +68,7 @@ MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << "\n";
+  os << indent << "NumberOfCompressionThreads: " << m_NumberOfCompressionThreads << "\n";
 }
 
 void
@@ -1077,6 +1080,7 @@ MetaImageIO ::Write(const void * buffer)
 
   m_MetaImage.CompressedData(m_UseCompression);
   m_MetaImage.CompressionLevel(this->GetCompressionLevel());
+  m_MetaImage.CompressionNumberOfThreads(m_NumberOfCompressionThreads);
 
   // this is a check to see if we are actually streaming
   // we initialize with m_IORegion to match dimensions
@@ -0,0 +1,173 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <fstream>
+#include <iterator>
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTestingMacros.h"
+
+// Write a compressed image large enough to be deflated in several blocks,
+// serially and in parallel, and check that it inflates as a single zlib
+// stream: entirely, by streaming, and with zlib itself.
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+
+bool
+SameRegion(const ImageType * expected, const ImageType * image, const ImageType::RegionType & region)
+{
+  itk::ImageRegionConstIterator<ImageType> expectedIt(expected, region);
+  itk::ImageRegionConstIterator<ImageType> it(image, region);
+  for (; !it.IsAtEnd(); ++it, ++expectedIt)
+  {
+    if (it.Get() != expectedIt.Get())
+    {
+      std::cerr << "Pixel mismatch at " << it.GetIndex() << ": expected " << expectedIt.Get() << ", got " << it.Get()
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<unsigned char>
+ReadFile(const std::string & fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  return std::vector<unsigned char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+} // namespace
+
+int
+itkMetaImageIOParallelCompressionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // 10 MiB of data
+  ImageType::SizeType size;
+  size[0] = 128;
+  size[1] = 128;
+  size[2] = 160;
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(static_cast<float>((index[0] * index[1] + 3 * index[2]) % 1000) / 7.0f);
+  }
+
+  // the number of threads defaults to the global default, and is at least one
+  auto defaultMetaImageIO = itk::MetaImageIO::New();
+  ITK_TEST_EXPECT_EQUAL(defaultMetaImageIO->GetNumberOfCompressionThreads(),
+                        itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  defaultMetaImageIO->SetNumberOfCompressionThreads(0);
+  ITK_TEST_EXPECT_EQUAL(defaultMetaImageIO->GetNumberOfCompressionThreads(), 1u);
+
+  const std::vector<unsigned char> data(reinterpret_cast<const unsigned char *>(image->GetBufferPointer()),
+                                        reinterpret_cast<const unsigned char *>(image->GetBufferPointer()) +
+                                          image->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(float));
+
+  // a region at the end of the data, in the last block
+  ImageType::RegionType region;
+  region.SetIndex(0, 10);
+  region.SetIndex(1, 20);
+  region.SetIndex(2, 150);
+  region.SetSize(0, 100);
+  region.SetSize(1, 90);
+  region.SetSize(2, 10);
+
+  std::vector<std::vector<unsigned char>> compressedData;
+  for (itk::ThreadIdType numberOfThreads : { 1, 4 })
+  {
+    const std::string baseName =
+      outputDirectory + "/itkMetaImageIOParallelCompressionTest_" + std::to_string(numberOfThreads);
+
+    for (const char * extension : { ".mha", ".mhd" })
+    {
+      const std::string fileName = baseName + extension;
+
+      auto metaImageIO = itk::MetaImageIO::New();
+      metaImageIO->SetNumberOfCompressionThreads(numberOfThreads);
+      auto writer = itk::ImageFileWriter<ImageType>::New();
+      writer->SetInput(image);
+      writer->SetImageIO(metaImageIO);
+      writer->SetFileName(fileName);
+      writer->UseCompressionOn();
+      ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+      ITK_TEST_EXPECT_EQUAL(metaImageIO->GetMetaImagePointer()->CompressionNumberOfThreads(), numberOfThreads);
+
+      auto reader = itk::ImageFileReader<ImageType>::New();
+      reader->SetImageIO(itk::MetaImageIO::New());
+      reader->SetFileName(fileName);
+      ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+      if (!SameRegion(image, reader->GetOutput(), image->GetLargestPossibleRegion()))
+      {
+        return EXIT_FAILURE;
+      }
+
+      auto streamingReader = itk::ImageFileReader<ImageType>::New();
+      streamingReader->SetImageIO(itk::MetaImageIO::New());
+      streamingReader->SetFileName(fileName);
+      streamingReader->SetUseStreaming(true);
+      streamingReader->UpdateOutputInformation();
+      streamingReader->GetOutput()->SetRequestedRegion(region);
+      ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+      if (!SameRegion(image, streamingReader->GetOutput(), region))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // the data file of the .mhd is a plain zlib stream
+    const std::vector<unsigned char> compressed = ReadFile(baseName + ".zraw");
+    std::vector<unsigned char>       uncompressed(data.size());
+    uLongf                           uncompressedSize = static_cast<uLongf>(uncompressed.size());
+    ITK_TEST_EXPECT_EQUAL(
+      uncompress(uncompressed.data(), &uncompressedSize, compressed.data(), static_cast<uLong>(compressed.size())),
+      Z_OK);
+    ITK_TEST_EXPECT_EQUAL(uncompressedSize, uncompressed.size());
+    ITK_TEST_EXPECT_TRUE(uncompressed == data);
+    compressedData.push_back(compressed);
+  }
+
+  // one thread deflates the data as a single block, like zlib itself, while
+  // several threads flush the stream at the end of each block
+  std::vector<unsigned char> expected(compressBound(static_cast<uLong>(data.size())));
+  uLongf                     expectedSize = static_cast<uLongf>(expected.size());
+  ITK_TEST_EXPECT_EQUAL(compress2(expected.data(), &expectedSize, data.data(), static_cast<uLong>(data.size()), 2),
+                        Z_OK);
+  expected.resize(expectedSize);
+  ITK_TEST_EXPECT_TRUE(compressedData[0] == expected);
+  ITK_TEST_EXPECT_TRUE(compressedData[1] != expected);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
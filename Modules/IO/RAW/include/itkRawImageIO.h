@@ -166,6 +166,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the header size, file dimensionality and mask with the settings of ImageIOBase. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   // void ComputeInternalFileName(unsigned long slice);
 
 private:
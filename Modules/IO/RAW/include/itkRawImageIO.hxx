@@ -76,6 +76,25 @@ RawImageIO<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent)
   os << indent << "FileDimensionality: " << m_FileDimensionality << std::endl;
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+LightObject::Pointer
+RawImageIO<TPixel, VImageDimension>::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+  auto *               rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+
+  rval->m_FileDimensionality = m_FileDimensionality;
+  rval->m_ManualHeaderSize = m_ManualHeaderSize;
+  rval->m_HeaderSize = m_HeaderSize;
+  rval->m_ImageMask = m_ImageMask;
+
+  return loPtr;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 SizeValueType
 RawImageIO<TPixel, VImageDimension>::GetHeaderSize()
@@ -20,6 +20,7 @@
 #include "ITKIOTIFFExport.h"
 
 #include "itkImageIOBase.h"
+#include "itkMultiThreaderBase.h"
 #include <fstream>
 
 namespace itk
@@ -38,6 +39,21 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * Stripped and tiled images are read natively: the strips or tiles of a page
+ * are decoded in parallel, each work unit using its own handle on the file,
+ * which is kept to read the following pages of a volume.
+ *
+ * \note Tiled images used to be read through TIFFReadRGBAImage, and were
+ * always reported as RGBA images of unsigned char. They are now reported
+ * with the pixel type stored in the file, like stripped images, e.g. a
+ * tiled 16-bit grayscale image is a scalar image of unsigned short. Only
+ * the images which can't be read natively, such as YCbCr or CMYK images,
+ * are still read as RGBA.
+ * Single page images which can be read natively support streaming, only
+ * the strips or tiles intersecting the requested region being decoded.
+ * Images are written in strips by default, or in square tiles if a TileSize
+ * is set.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -83,6 +99,22 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** Determine if the ImageIO can stream reading from the current
+   * settings. Single page images which are not read through
+   * TIFFReadRGBAImage can be streamed. ReadImageInformation must be called
+   * prior to this function. */
+  bool
+  CanStreamRead() override
+  {
+    return m_CanStreamRead;
+  }
+
+  /** Get the region to read for a requested region. When streaming, the
+   * requested region itself is read: the strips or tiles covering it are
+   * decoded and cropped to it. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -172,6 +204,12 @@ public:
   }
 
 
+  /** Set/Get the width and length of the tiles of the written images.
+   * It must be a multiple of 16. The default, 0, writes the images in
+   * strips. Tiled images are faster to read by regions. */
+  itkSetMacro(TileSize, unsigned int);
+  itkGetConstMacro(TileSize, unsigned int);
+
   /** Get a const ref to the palette of the image. In the case of non palette
    * image or ExpandRGBPalette set to true, a vector of size
    * 0 is returned.
@@ -252,12 +290,22 @@ private:
   void
   AllocateTiffPalette(uint16_t bps);
 
+  /** Read a region of the current page, given by its first column and row
+   * and by its size. */
   void
-  ReadCurrentPage(void * out, size_t pixelOffset);
+  ReadCurrentPage(void * out, size_t pixelOffset, uint32_t startX, uint32_t startY, uint32_t width, uint32_t height);
+
+  void
+  ReadGenericImageRegion(void * out, uint32_t startX, uint32_t startY, uint32_t width, uint32_t height);
 
   template <typename TComponent>
   void
-  ReadGenericImage(void * out, unsigned int width, unsigned int height);
+  ReadGenericImage(void * out, uint32_t startX, uint32_t startY, uint32_t width, uint32_t height);
+
+  /** Convert xsize pixels of a decoded strip or tile to the output pixels. */
+  template <typename TComponent>
+  void
+  PutPixels(TComponent * to, void * from, unsigned int xsize);
 
   template <typename TComponent>
   void
@@ -309,6 +357,12 @@ private:
   uint16_t *   m_ColorBlue;
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+
+  bool         m_CanStreamRead{ false };
+  unsigned int m_TileSize{ 0 };
+
+  /** Decodes the strips or tiles of the pages. */
+  MultiThreaderBase::Pointer m_MultiThreader;
 };
 } // end namespace itk
 
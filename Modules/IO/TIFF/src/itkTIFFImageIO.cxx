@@ -20,9 +20,14 @@
 #include "itkTIFFReaderInternal.h"
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itk_tiff.h"
 
+#include <algorithm>
+#include <exception>
+#include <vector>
+
 namespace itk
 {
 
@@ -53,27 +58,33 @@ TIFFImageIO::CanReadFile(const char * file)
 
 void
 TIFFImageIO::ReadGenericImage(void * out, unsigned int width, unsigned int height)
+{
+  this->ReadGenericImageRegion(out, 0, 0, width, height);
+}
+
+void
+TIFFImageIO::ReadGenericImageRegion(void * out, uint32_t startX, uint32_t startY, uint32_t width, uint32_t height)
 {
 
   if (m_ComponentType == IOComponentEnum::UCHAR)
   {
-    this->ReadGenericImage<unsigned char>(out, width, height);
+    this->ReadGenericImage<unsigned char>(out, startX, startY, width, height);
   }
   else if (m_ComponentType == IOComponentEnum::CHAR)
   {
-    this->ReadGenericImage<char>(out, width, height);
+    this->ReadGenericImage<char>(out, startX, startY, width, height);
   }
   else if (m_ComponentType == IOComponentEnum::USHORT)
   {
-    this->ReadGenericImage<unsigned short>(out, width, height);
+    this->ReadGenericImage<unsigned short>(out, startX, startY, width, height);
   }
   else if (m_ComponentType == IOComponentEnum::SHORT)
   {
-    this->ReadGenericImage<short>(out, width, height);
+    this->ReadGenericImage<short>(out, startX, startY, width, height);
   }
   else if (m_ComponentType == IOComponentEnum::FLOAT)
   {
-    this->ReadGenericImage<float>(out, width, height);
+    this->ReadGenericImage<float>(out, startX, startY, width, height);
   }
 }
 
@@ -170,7 +181,7 @@ TIFFImageIO::ReadVolume(void * buffer)
 
     const size_t pixelOffset = width * height * this->GetNumberOfComponents() * page;
 
-    ReadCurrentPage(buffer, pixelOffset);
+    ReadCurrentPage(buffer, pixelOffset, 0, 0, m_InternalImage->m_Width, m_InternalImage->m_Height);
 
     TIFFReadDirectory(m_InternalImage->m_Image);
   }
@@ -191,13 +202,25 @@ TIFFImageIO::Read(void * buffer)
 
   // The IO region should be of dimensions 3 otherwise we read only the first
   // page
-  if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  if (m_InternalImage->m_NumberOfPages > 0 && ioRegion.GetImageDimension() > 2 && m_NumberOfDimensions > 2)
   {
     this->ReadVolume(buffer);
   }
   else
   {
-    this->ReadCurrentPage(buffer, 0);
+    uint32_t startX = 0;
+    uint32_t startY = 0;
+    uint32_t width = m_InternalImage->m_Width;
+    uint32_t height = m_InternalImage->m_Height;
+    if (m_CanStreamRead && ioRegion.GetImageDimension() >= 2)
+    {
+      startX = static_cast<uint32_t>(ioRegion.GetIndex(0));
+      startY = static_cast<uint32_t>(ioRegion.GetIndex(1));
+      width = static_cast<uint32_t>(ioRegion.GetSize(0));
+      height = static_cast<uint32_t>(ioRegion.GetSize(1));
+    }
+    this->ReadCurrentPage(buffer, 0, startX, startY, width, height);
   }
 
   m_InternalImage->Clean();
@@ -220,6 +243,8 @@ TIFFImageIO::TIFFImageIO()
 
   m_InternalImage = new TIFFReaderInternal;
 
+  m_MultiThreader = MultiThreaderBase::New();
+
   m_Spacing[0] = 1.0;
   m_Spacing[1] = 1.0;
 
@@ -248,6 +273,8 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
+  os << indent << "CanStreamRead: " << m_CanStreamRead << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:"
@@ -528,6 +555,20 @@ TIFFImageIO::ReadImageInformation()
     // make sure the palette is empty
     m_ColorPalette.resize(0);
   }
+
+  // the strips or tiles of single page images read natively can be decoded
+  // for any region
+  m_CanStreamRead = (m_NumberOfDimensions == 2 && m_InternalImage->CanRead());
+}
+
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if (!m_UseStreamedReading || !m_CanStreamRead)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
+  return requestedRegion;
 }
 
 bool
@@ -603,6 +644,11 @@ TIFFImageIO::InternalWrite(const void * buffer)
       itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, and float");
   }
 
+  if (m_TileSize % 16 != 0)
+  {
+    itkExceptionMacro(<< "The tile size must be a multiple of 16, got " << m_TileSize);
+  }
+
   uint16_t predictor;
 
   const char * mode = "w";
@@ -762,22 +808,30 @@ TIFFImageIO::InternalWrite(const void * buffer)
     // Using 1 MB per strip leads to 256 rows per strip, which takes only 4 seconds to write over sshfs.
     // Rather than change that value in the third party libtiff library, we instead compute the
     // rowsperstrip here to lead to this same value.
-#ifdef TIFF_INT64_T // detect if libtiff4
-    uint64_t scanlinesize = TIFFScanlineSize64(tif);
-#else
-    tsize_t scanlinesize = TIFFScanlineSize(tif);
-#endif
-    if (scanlinesize == 0)
+    if (m_TileSize > 0)
     {
-      itkExceptionMacro("TIFFScanlineSize returned 0");
+      TIFFSetField(tif, TIFFTAG_TILEWIDTH, static_cast<uint32>(m_TileSize));
+      TIFFSetField(tif, TIFFTAG_TILELENGTH, static_cast<uint32>(m_TileSize));
     }
-    rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
-    if (rowsperstrip < 1)
+    else
     {
-      rowsperstrip = 1;
-    }
+#ifdef TIFF_INT64_T // detect if libtiff4
+      uint64_t scanlinesize = TIFFScanlineSize64(tif);
+#else
+      tsize_t scanlinesize = TIFFScanlineSize(tif);
+#endif
+      if (scanlinesize == 0)
+      {
+        itkExceptionMacro("TIFFScanlineSize returned 0");
+      }
+      rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
+      if (rowsperstrip < 1)
+      {
+        rowsperstrip = 1;
+      }
 
-    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+      TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    }
 
     if (resolution_x > 0 && resolution_y > 0)
     {
@@ -817,17 +871,48 @@ TIFFImageIO::InternalWrite(const void * buffer)
     }
 
     rowLength *= this->GetNumberOfComponents();
+    const SizeValueType pixelLength = rowLength;
     rowLength *= width;
 
-    uint32 row = 0;
-    for (unsigned int idx2 = 0; idx2 < height; idx2++)
+    if (m_TileSize > 0)
+    {
+      // the tiles crossing the right or bottom side of the image are padded
+      // with zeros
+      const SizeValueType tileRowLength = pixelLength * m_TileSize;
+      std::vector<char>   tile(static_cast<size_t>(TIFFTileSize(tif)));
+      for (uint32 y = 0; y < h; y += m_TileSize)
+      {
+        const uint32 tileHeight = std::min(static_cast<uint32>(m_TileSize), h - y);
+        for (uint32 x = 0; x < w; x += m_TileSize)
+        {
+          const uint32 tileWidth = std::min(static_cast<uint32>(m_TileSize), w - x);
+          std::fill(tile.begin(), tile.end(), 0);
+          for (uint32 row = 0; row < tileHeight; ++row)
+          {
+            std::copy_n(outPtr + (y + row) * rowLength + x * pixelLength,
+                        tileWidth * pixelLength,
+                        tile.data() + row * tileRowLength);
+          }
+          if (TIFFWriteEncodedTile(tif, TIFFComputeTile(tif, x, y, 0, 0), tile.data(), tile.size()) < 0)
+          {
+            itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
+          }
+        }
+      }
+      outPtr += rowLength * height;
+    }
+    else
     {
-      if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+      uint32 row = 0;
+      for (unsigned int idx2 = 0; idx2 < height; idx2++)
       {
-        itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
+        if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+        {
+          itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
+        }
+        outPtr += rowLength;
+        ++row;
       }
-      outPtr += rowLength;
-      ++row;
     }
 
     if (m_NumberOfDimensions == 3)
@@ -1279,14 +1364,20 @@ TIFFImageIO::ReadTIFFTags()
 
 
 void
-TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
+TIFFImageIO::ReadCurrentPage(void *   buffer,
+                             size_t   pixelOffset,
+                             uint32_t startX,
+                             uint32_t startY,
+                             uint32_t width,
+                             uint32_t height)
 {
-  const uint32 width = m_InternalImage->m_Width;
-  const uint32 height = m_InternalImage->m_Height;
-
-
   if (!m_InternalImage->CanRead())
   {
+    if (startX != 0 || startY != 0 || width != m_InternalImage->m_Width || height != m_InternalImage->m_Height)
+    {
+      itkExceptionMacro("Logic Error: Unexpected region for a TIFF RGBA image!");
+    }
+
     uint32 * tempImage = nullptr;
 
     if (this->GetNumberOfComponents() == 4 && m_ComponentType == IOComponentEnum::UCHAR)
@@ -1311,58 +1402,20 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
 
     this->InitializeColors();
 
-
-    if (m_ComponentType == IOComponentEnum::USHORT)
-    {
-      auto * volume = static_cast<unsigned short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else if (m_ComponentType == IOComponentEnum::SHORT)
-    {
-      auto * volume = static_cast<short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else if (m_ComponentType == IOComponentEnum::CHAR)
-    {
-      auto * volume = static_cast<char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else if (m_ComponentType == IOComponentEnum::FLOAT)
-    {
-      auto * volume = static_cast<float *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else
-    {
-      auto * volume = static_cast<unsigned char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
+    char * volume = static_cast<char *>(buffer) + pixelOffset * this->GetComponentSize();
+    this->ReadGenericImageRegion(volume, startX, startY, width, height);
   }
 }
 
 template <typename TComponent>
 void
-TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int height)
+TIFFImageIO::ReadGenericImage(void * _out, uint32_t startX, uint32_t startY, uint32_t width, uint32_t height)
 {
   using ComponentType = TComponent;
 
-#ifdef TIFF_INT64_T // detect if libtiff4
-  uint64_t isize = TIFFScanlineSize64(m_InternalImage->m_Image);
-#else
-  tsize_t isize = TIFFScanlineSize(m_InternalImage->m_Image);
-#endif
+  size_t inc;
 
-  size_t  inc;
-  tdata_t buf = _TIFFmalloc(static_cast<tmsize_t>(isize));
-  isize /= sizeof(ComponentType);
-
-  auto *          out = static_cast<ComponentType *>(_out);
-  ComponentType * image;
+  auto * out = static_cast<ComponentType *>(_out);
 
   if (m_InternalImage->m_PlanarConfig != PLANARCONFIG_CONTIG && m_InternalImage->m_SamplesPerPixel != 1)
   {
@@ -1401,87 +1454,194 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       break;
   }
 
-  for (uint32 row = 0; row < height; ++row)
+  if (width == 0 || height == 0)
+  {
+    return;
+  }
+
+  TIFF * const   image = m_InternalImage->m_Image;
+  const uint32_t imageHeight = m_InternalImage->m_Height;
+  const bool     isTiled = (TIFFIsTiled(image) != 0);
+  const bool     isTopLeft = (m_InternalImage->m_Orientation == ORIENTATION_TOPLEFT);
+
+  // The page is made of strips or tiles, which are decoded independently.
+  uint32_t chunkWidth = m_InternalImage->m_Width;
+  uint32_t chunkHeight = imageHeight;
+  if (isTiled)
   {
-    if (TIFFReadScanline(m_InternalImage->m_Image, buf, row, 0) <= 0)
+    chunkWidth = m_InternalImage->m_TileWidth;
+    chunkHeight = m_InternalImage->m_TileHeight;
+  }
+  else
+  {
+    uint32 rowsPerStrip = imageHeight;
+    TIFFGetFieldDefaulted(image, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+    chunkHeight = std::min(std::max(rowsPerStrip, uint32{ 1 }), imageHeight);
+  }
+
+#ifdef TIFF_INT64_T // detect if libtiff4
+  const uint64_t chunkRowSize = isTiled ? TIFFTileRowSize64(image) : TIFFScanlineSize64(image);
+  const uint64_t chunkSize = isTiled ? TIFFTileSize64(image) : TIFFStripSize64(image);
+#else
+  const tsize_t chunkRowSize = isTiled ? TIFFTileRowSize(image) : TIFFScanlineSize(image);
+  const tsize_t chunkSize = isTiled ? TIFFTileSize(image) : TIFFStripSize(image);
+#endif
+  const size_t bytesPerPixel = static_cast<size_t>(m_InternalImage->m_BitsPerSample / 8) *
+                               (m_InternalImage->m_PlanarConfig == PLANARCONFIG_CONTIG
+                                  ? static_cast<size_t>(m_InternalImage->m_SamplesPerPixel)
+                                  : size_t{ 1 });
+
+  // the rows of the file holding the region
+  const uint32_t firstRow = isTopLeft ? startY : imageHeight - startY - height;
+  const uint32_t endRow = firstRow + height;
+
+  // the origins of the strips or tiles intersecting the region
+  std::vector<std::pair<uint32_t, uint32_t>> chunks;
+  for (uint32_t y = firstRow - firstRow % chunkHeight; y < endRow; y += chunkHeight)
+  {
+    for (uint32_t x = startX - startX % chunkWidth; x < startX + width; x += chunkWidth)
     {
-      itkExceptionMacro(<< "Problem reading the row: " << row);
+      chunks.emplace_back(x, y);
     }
+  }
+
+  const auto readChunk = [&](TIFF * tif, const std::pair<uint32_t, uint32_t> & origin, void * buf) {
+    const uint32_t x = origin.first;
+    const uint32_t y = origin.second;
 
-    if (m_InternalImage->m_Orientation == ORIENTATION_TOPLEFT)
+    const tmsize_t decoded = isTiled ? TIFFReadEncodedTile(tif, TIFFComputeTile(tif, x, y, 0, 0), buf, -1)
+                                     : TIFFReadEncodedStrip(tif, TIFFComputeStrip(tif, y, 0), buf, -1);
+    if (decoded < 0)
     {
-      image = out + inc * row * width;
+      itkExceptionMacro(<< "Problem reading the " << (isTiled ? "tile" : "strip") << " at column " << x << ", row "
+                        << y);
     }
-    else // bottom left
+
+    const uint32_t rowBegin = std::max(y, firstRow);
+    const uint32_t rowEnd = std::min(y + chunkHeight, endRow);
+    const uint32_t columnBegin = std::max(x, startX);
+    const uint32_t columnEnd = std::min(x + chunkWidth, startX + width);
+    for (uint32_t row = rowBegin; row < rowEnd; ++row)
     {
-      image = out + inc * width * (height - (row + 1));
+      const uint32_t outRow = isTopLeft ? row - startY : imageHeight - 1 - row - startY;
+      ComponentType * to = out + inc * (static_cast<size_t>(outRow) * width + (columnBegin - startX));
+      char *          from = static_cast<char *>(buf) + static_cast<size_t>(row - y) * chunkRowSize +
+                    static_cast<size_t>(columnBegin - x) * bytesPerPixel;
+      this->PutPixels<ComponentType>(to, from, columnEnd - columnBegin);
     }
+  };
+
+  // The strips or tiles are shared between the work units. A TIFF handle
+  // can not be used by several threads, so each work unit but the first
+  // one reads through its own handle, kept for the following pages.
+  const SizeValueType numberOfChunks = chunks.size();
+  const SizeValueType numberOfWorkUnits =
+    std::min(numberOfChunks, static_cast<SizeValueType>(m_MultiThreader->GetNumberOfWorkUnits()));
+  m_InternalImage->SetNumberOfWorkUnitImages(numberOfWorkUnits);
 
-    switch (this->GetFormat())
+  std::vector<std::exception_ptr> workUnitExceptions(numberOfWorkUnits);
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](SizeValueType workUnit) {
+      try
+      {
+        TIFF * tif = m_InternalImage->GetWorkUnitImage(workUnit);
+        if (tif == nullptr)
+        {
+          itkExceptionMacro(<< "Cannot open file " << m_FileName << " to read page " << TIFFCurrentDirectory(image));
+        }
+
+        std::vector<char>   buf(static_cast<size_t>(chunkSize));
+        const SizeValueType first = workUnit * numberOfChunks / numberOfWorkUnits;
+        const SizeValueType last = (workUnit + 1) * numberOfChunks / numberOfWorkUnits;
+        for (SizeValueType chunk = first; chunk < last; ++chunk)
+        {
+          readChunk(tif, chunks[chunk], buf.data());
+        }
+      }
+      catch (...)
+      {
+        workUnitExceptions[workUnit] = std::current_exception();
+      }
+    },
+    nullptr);
+
+  for (const auto & workUnitException : workUnitExceptions)
+  {
+    if (workUnitException)
     {
-      case TIFFImageIO::GRAYSCALE:
-        // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
-      case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
+      std::rethrow_exception(workUnitException);
+    }
+  }
+}
+
+template <typename TComponent>
+void
+TIFFImageIO::PutPixels(TComponent * to, void * from, unsigned int xsize)
+{
+  using ComponentType = TComponent;
 
-      case TIFFImageIO::PALETTE_GRAYSCALE:
+  switch (this->GetFormat())
+  {
+    case TIFFImageIO::GRAYSCALE:
+      // check inverted
+      PutGrayscale<ComponentType>(to, static_cast<ComponentType *>(from), xsize, 1, 0, 0);
+      break;
+    case TIFFImageIO::RGB_:
+      PutRGB_<ComponentType>(to, static_cast<ComponentType *>(from), xsize, 1, 0, 0);
+      break;
+
+    case TIFFImageIO::PALETTE_GRAYSCALE:
+      switch (m_InternalImage->m_BitsPerSample)
+      {
+        case 8:
+          PutPaletteGrayscale<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), xsize, 1, 0, 0);
+          break;
+        case 16:
+          PutPaletteGrayscale<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), xsize, 1, 0, 0);
+          break;
+        default:
+          itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                            << "-bit samples with palette.");
+      }
+      break;
+    case TIFFImageIO::PALETTE_RGB:
+      if (!this->GetIsReadAsScalarPlusPalette())
+      {
         switch (m_InternalImage->m_BitsPerSample)
         {
           case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), xsize, 1, 0, 0);
             break;
           case 16:
-            PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), xsize, 1, 0, 0);
             break;
           default:
             itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
                               << "-bit samples with palette.");
         }
-        break;
-      case TIFFImageIO::PALETTE_RGB:
-        if (!this->GetIsReadAsScalarPlusPalette())
-        {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
-        }
-        else
+      }
+      else
+      {
+        switch (m_InternalImage->m_BitsPerSample)
         {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
+          case 8:
+            PutPaletteScalar<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), xsize, 1, 0, 0);
+            break;
+          case 16:
+            PutPaletteScalar<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), xsize, 1, 0, 0);
+            break;
+          default:
+            itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                              << "-bit samples with palette.");
         }
-        break;
+      }
+      break;
 
-      default:
-        itkExceptionMacro("Logic Error: Unexpected format!");
-    }
+    default:
+      itkExceptionMacro("Logic Error: Unexpected format!");
   }
-
-  _TIFFfree(buf);
 }
 
 // iso component scalar
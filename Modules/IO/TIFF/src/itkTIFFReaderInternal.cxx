@@ -43,6 +43,7 @@ TIFFReaderInternal::Open(const char * filename)
   }
 
   this->m_Image = TIFFOpen(filename, "r");
+  this->m_FileName = filename;
   if (!this->m_Image)
   {
     this->Clean();
@@ -58,6 +59,39 @@ TIFFReaderInternal::Open(const char * filename)
   return 1;
 }
 
+TIFF *
+TIFFReaderInternal::GetWorkUnitImage(size_t workUnit)
+{
+  if (workUnit == 0)
+  {
+    return this->m_Image;
+  }
+
+  TIFF *& image = this->m_WorkUnitImages[workUnit];
+  if (!image)
+  {
+    image = TIFFOpen(this->m_FileName.c_str(), "r");
+    if (!image)
+    {
+      return nullptr;
+    }
+  }
+  if (!TIFFSetSubDirectory(image, TIFFCurrentDirOffset(this->m_Image)))
+  {
+    return nullptr;
+  }
+  return image;
+}
+
+void
+TIFFReaderInternal::SetNumberOfWorkUnitImages(size_t numberOfWorkUnits)
+{
+  if (this->m_WorkUnitImages.size() < numberOfWorkUnits)
+  {
+    this->m_WorkUnitImages.resize(numberOfWorkUnits, nullptr);
+  }
+}
+
 void
 TIFFReaderInternal::Clean()
 {
@@ -65,6 +99,14 @@ TIFFReaderInternal::Clean()
   {
     TIFFClose(this->m_Image);
   }
+  for (TIFF * image : this->m_WorkUnitImages)
+  {
+    if (image)
+    {
+      TIFFClose(image);
+    }
+  }
+  this->m_WorkUnitImages.clear();
   this->m_Image = nullptr;
   this->m_Width = 0;
   this->m_Height = 0;
@@ -195,9 +237,7 @@ TIFFReaderInternal::CanRead()
 {
   const bool compressionSupported = (TIFFIsCODECConfigured(this->m_Compression) == 1);
   return (this->m_Image && (this->m_Width > 0) && (this->m_Height > 0) && (this->m_SamplesPerPixel > 0) &&
-          compressionSupported && (m_NumberOfTiles == 0) // just use TIFFReadRGBAImage, an
-                                                         // native optimized version would be nice
-          && (this->m_HasValidPhotometricInterpretation) &&
+          compressionSupported && (this->m_HasValidPhotometricInterpretation) &&
           (this->m_Photometrics == PHOTOMETRIC_RGB || this->m_Photometrics == PHOTOMETRIC_MINISWHITE ||
            this->m_Photometrics == PHOTOMETRIC_MINISBLACK ||
            (this->m_Photometrics == PHOTOMETRIC_PALETTE && this->m_BitsPerSample != 32)) &&
@@ -21,6 +21,8 @@
 #include "ITKIOTIFFExport.h"
 #include "itkIntTypes.h"
 #include "itk_tiff.h"
+#include <string>
+#include <vector>
 
 
 namespace itk
@@ -42,6 +44,18 @@ public:
   int
   Open(const char * filename);
 
+  /** Return a handle on the file for the work unit, on the current directory
+   * of m_Image, or nullptr if it can't be opened. The first work unit uses
+   * m_Image. The other handles are opened on the first call and kept until
+   * Clean(), and they jump to the directory by its offset, so that reading
+   * the pages of a volume in turn does not walk the directories again. The
+   * handles must have been allocated with SetNumberOfWorkUnitImages(). */
+  TIFF *
+  GetWorkUnitImage(size_t workUnit);
+
+  void
+  SetNumberOfWorkUnitImages(size_t numberOfWorkUnits);
+
   TIFF *   m_Image;
   bool     m_IsOpen;
   uint32_t m_Width;
@@ -66,6 +80,10 @@ public:
   float    m_XResolution;
   float    m_YResolution;
   uint16_t m_SampleFormat;
+
+private:
+  std::string         m_FileName;
+  std::vector<TIFF *> m_WorkUnitImages;
 };
 
 } // namespace itk
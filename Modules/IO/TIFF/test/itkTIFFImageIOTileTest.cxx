@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkTIFFImageIO.h"
+#include "itkTestingMacros.h"
+
+// Write images in strips and in tiles, and read them back entirely and by
+// streamed regions which are not aligned with the strips or tiles.
+
+namespace
+{
+
+template <typename TPixel>
+TPixel
+MakePixel(unsigned int value)
+{
+  return static_cast<TPixel>(value);
+}
+
+template <>
+itk::RGBPixel<unsigned short>
+MakePixel<itk::RGBPixel<unsigned short>>(unsigned int value)
+{
+  itk::RGBPixel<unsigned short> pixel;
+  pixel[0] = static_cast<unsigned short>(value);
+  pixel[1] = static_cast<unsigned short>(3 * value);
+  pixel[2] = static_cast<unsigned short>(7 * value);
+  return pixel;
+}
+
+template <typename TImage>
+bool
+CompareRegion(const TImage * expected, const TImage * image, const typename TImage::RegionType & region)
+{
+  itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expected->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Pixel mismatch at " << it.GetIndex() << ": expected " << expected->GetPixel(it.GetIndex())
+                << ", got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TPixel>
+int
+itkTIFFImageIOTileTestHelper(const std::string & fileName, unsigned int tileSize, const std::string & compressor)
+{
+  using ImageType = itk::Image<TPixel, 2>;
+
+  std::cout << "Testing " << fileName << " with tile size " << tileSize << " and compressor " << compressor
+            << std::endl;
+
+  // a size which is not a multiple of the tile size
+  typename ImageType::SizeType size;
+  size[0] = 147;
+  size[1] = 93;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(MakePixel<TPixel>((it.GetIndex()[0] * 7 + it.GetIndex()[1] * 13) % 251));
+  }
+
+  auto writerIO = itk::TIFFImageIO::New();
+  writerIO->SetTileSize(tileSize);
+  ITK_TEST_SET_GET_VALUE(tileSize, writerIO->GetTileSize());
+  writerIO->SetCompressor(compressor);
+
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(!compressor.empty());
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // full read
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetImageIO(itk::TIFFImageIO::New());
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  // tiled images are read with their own pixel type, not as RGBA
+  const unsigned int numberOfComponents = itk::NumericTraits<TPixel>::GetLength(TPixel());
+  ITK_TEST_EXPECT_EQUAL(reader->GetImageIO()->GetNumberOfComponents(), numberOfComponents);
+  ITK_TEST_EXPECT_EQUAL(reader->GetImageIO()->GetPixelType(),
+                        numberOfComponents == 1 ? itk::IOPixelEnum::SCALAR : itk::IOPixelEnum::RGB);
+  const itk::IOComponentEnum componentType =
+    itk::ImageIOBase::MapPixelType<typename itk::NumericTraits<TPixel>::ValueType>::CType;
+  ITK_TEST_EXPECT_EQUAL(reader->GetImageIO()->GetComponentType(), componentType);
+  ITK_TEST_EXPECT_TRUE(reader->GetImageIO()->CanStreamRead());
+  if (!CompareRegion(image.GetPointer(), reader->GetOutput(), image->GetLargestPossibleRegion()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // streamed reads of regions crossing several strips or tiles
+  const itk::IndexValueType indices[][2] = { { 0, 0 }, { 17, 35 }, { 100, 60 }, { 146, 92 } };
+  const itk::SizeValueType  sizes[][2] = { { 147, 1 }, { 53, 41 }, { 47, 33 }, { 1, 1 } };
+  for (unsigned int r = 0; r < 4; ++r)
+  {
+    typename ImageType::RegionType region;
+    region.SetIndex(0, indices[r][0]);
+    region.SetIndex(1, indices[r][1]);
+    region.SetSize(0, sizes[r][0]);
+    region.SetSize(1, sizes[r][1]);
+
+    auto streamingReader = ReaderType::New();
+    streamingReader->SetImageIO(itk::TIFFImageIO::New());
+    streamingReader->SetFileName(fileName);
+    streamingReader->SetUseStreaming(true);
+    streamingReader->UpdateOutputInformation();
+    streamingReader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+
+    ITK_TEST_EXPECT_EQUAL(streamingReader->GetOutput()->GetBufferedRegion(), region);
+    if (!CompareRegion(image.GetPointer(), streamingReader->GetOutput(), region))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// Write a volume of many pages and read it back, the pages being read in
+// turn through the same handles
+int
+itkTIFFImageIOTileTestVolume(const std::string & fileName, unsigned int tileSize)
+{
+  using ImageType = itk::Image<unsigned short, 3>;
+
+  std::cout << "Testing " << fileName << " with tile size " << tileSize << std::endl;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 67, 45, 40 } });
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<unsigned short>(it.GetIndex()[0] * 7 + it.GetIndex()[1] * 13 + it.GetIndex()[2] * 1009));
+  }
+
+  auto writerIO = itk::TIFFImageIO::New();
+  writerIO->SetTileSize(tileSize);
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(itk::TIFFImageIO::New());
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+  if (!CompareRegion(image.GetPointer(), reader->GetOutput(), image->GetLargestPossibleRegion()))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkTIFFImageIOTileTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto imageIO = itk::TIFFImageIO::New();
+  ITK_TEST_EXPECT_EQUAL(imageIO->GetTileSize(), 0u);
+  ITK_TEST_EXPECT_TRUE(!imageIO->CanStreamRead());
+
+  // the tile size must be a multiple of 16
+  {
+    using ImageType = itk::Image<unsigned char, 2>;
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 16, 16 } });
+    image->Allocate(true);
+
+    imageIO->SetTileSize(20);
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetImageIO(imageIO);
+    writer->SetFileName(outputDirectory + "/itkTIFFImageIOTileTestInvalid.tif");
+    ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+  }
+
+  int status = EXIT_SUCCESS;
+  for (unsigned int tileSize : { 0u, 16u, 64u })
+  {
+    for (const char * compressor : { "", "Deflate" })
+    {
+      const std::string suffix = std::to_string(tileSize) + (*compressor ? "_Deflate" : "") + ".tif";
+      status |= itkTIFFImageIOTileTestHelper<unsigned char>(outputDirectory + "/itkTIFFImageIOTileTest_uchar_" + suffix,
+                                                            tileSize,
+                                                            compressor);
+      status |= itkTIFFImageIOTileTestHelper<float>(outputDirectory + "/itkTIFFImageIOTileTest_float_" + suffix,
+                                                    tileSize,
+                                                    compressor);
+      status |= itkTIFFImageIOTileTestHelper<itk::RGBPixel<unsigned short>>(
+        outputDirectory + "/itkTIFFImageIOTileTest_rgb_" + suffix, tileSize, compressor);
+    }
+  }
+
+  for (unsigned int tileSize : { 0u, 16u })
+  {
+    status |= itkTIFFImageIOTileTestVolume(
+      outputDirectory + "/itkTIFFImageIOTileTest_volume_" + std::to_string(tileSize) + ".tif", tileSize);
+  }
+
+  return status;
+}
@@ -0,0 +1,249 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIO_h
+#define itkZarrImageIO_h
+#include "ITKIOZarrExport.h"
+
+#include "itkStreamingImageIOBase.h"
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/**
+ *\class ZarrImageIO
+ *
+ * \brief Read and write images as multiscale Zarr stores on the local
+ * filesystem.
+ *
+ * A Zarr store is a directory holding N-D arrays, each one split into
+ * chunks of the same shape which are stored, compressed, in separate
+ * files. The images are written following the multiscales layout of the
+ * OME-NGFF specification: the group at the root of the store describes the
+ * axes and lists the arrays of the levels of a resolution pyramid, the
+ * first one at full resolution, with the spacing and origin of each one.
+ * The direction cosines and the pixel type, which OME-NGFF does not
+ * describe, are kept in the "itk" attributes of the group.
+ *
+ * Both the version 2 layout (.zgroup, .zattrs and .zarray files) and the
+ * version 3 layout (zarr.json files) are supported for reading and writing,
+ * see SetZarrFormat(). Chunks may be stored raw or compressed with zlib or
+ * gzip, see SetCompressor(); stores using other codecs, such as blosc, can
+ * not be read.
+ *
+ * The arrays are in C order, so their axes are the reverse of the image
+ * dimensions. The components of multi-component pixels are stored along a
+ * channel axis, placed before the spatial axes.
+ *
+ * Any region of the image may be read or written: only the chunks which
+ * intersect the region are decoded or encoded, in parallel. Writing a
+ * region updates the chunks it partially covers. Missing chunks are read
+ * as the fill_value of their array, zero in the stores written by this
+ * ImageIO.
+ *
+ * SetNumberOfPyramidLevels() adds reduced resolution levels when writing,
+ * level k keeping one pixel out of 2^k in each dimension so that the levels
+ * can be written from streamed regions. The levels are not low-pass
+ * filtered, so fine details alias in the coarse levels. SetPyramidLevel()
+ * selects the level read, from an ImageFileReader given this ImageIO.
+ *
+ * \sa ImageFileWriter ImageFileReader HDF5ImageIO
+ * \ingroup ITKIOZarr
+ */
+class ITKIOZarr_EXPORT ZarrImageIO : public StreamingImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ZarrImageIO);
+
+  /** Standard class type aliases. */
+  using Self = ZarrImageIO;
+  using Superclass = StreamingImageIOBase;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ZarrImageIO, StreamingImageIOBase);
+
+  /** Set/Get the version of the layout of the written stores, 2 or 3.
+   * The version of a read store is detected. */
+  itkSetClampMacro(ZarrFormat, unsigned int, 2, 3);
+  itkGetConstMacro(ZarrFormat, unsigned int);
+
+  /** Set/Get the shape of the chunks written, in image dimensions. Missing
+   * dimensions get the size of the image, as do the dimensions set to 0. The
+   * default, an empty shape, uses chunks of 64 pixels along the first three
+   * dimensions. */
+  void
+  SetChunkSize(const std::vector<SizeValueType> & chunkSize);
+  itkGetConstReferenceMacro(ChunkSize, std::vector<SizeValueType>);
+
+  /** Set/Get the number of levels written in the resolution pyramid,
+   * including the full resolution image. The number of levels of a read
+   * store is detected. */
+  itkSetClampMacro(NumberOfPyramidLevels, unsigned int, 1, 32);
+  itkGetConstMacro(NumberOfPyramidLevels, unsigned int);
+
+  /** Set/Get the level of the resolution pyramid to read, 0 being the full
+   * resolution image. */
+  itkSetMacro(PyramidLevel, unsigned int);
+  itkGetConstMacro(PyramidLevel, unsigned int);
+
+  /** Set/Get the name of the image, written in the multiscales metadata. */
+  itkSetStringMacro(ImageName);
+  itkGetStringMacro(ImageName);
+
+  /*-------- This part of the interfaces deals with reading data. ----- */
+
+  /** Determine if the file can be read with this ImageIO implementation.
+   * \param FileNameToRead The name of the directory of the store.
+   * \post Sets classes ImageIOBase::m_FileName variable to be FileNameToWrite
+   * \return Returns true if this ImageIO can read the store specified.
+   */
+  bool
+  CanReadFile(const char * FileNameToRead) override;
+
+  /** Set the spacing and dimension information for the set filename. */
+  void
+  ReadImageInformation() override;
+
+  /** Reads the IORegion of the selected level into the memory buffer
+   * provided. */
+  void
+  Read(void * buffer) override;
+
+  /*-------- This part of the interfaces deals with writing data. ----- */
+
+  /** Determine if the file can be written with this ImageIO
+   * implementation: its extension must be ".zarr".
+   * \param FileNameToWrite The name of the directory of the store.
+   * \post Sets classes ImageIOBase::m_FileName variable to be FileNameToWrite
+   * \return Returns true if this ImageIO can write the store specified.
+   */
+  bool
+  CanWriteFile(const char * FileNameToWrite) override;
+
+  /** Writes the metadata of the store, unless it already holds arrays
+   * with the same shape to paste into. */
+  void
+  WriteImageInformation() override;
+
+  /** Writes the IORegion of the image, and of the levels of the pyramid,
+   * from the memory buffer provided. */
+  void
+  Write(const void * buffer) override;
+
+  /** Reimplemented because the chunks of the store must be removed before
+   * being rewritten by streamed regions. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+protected:
+  ZarrImageIO();
+  ~ZarrImageIO() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
+  /** The chunks are separate files without a header, so returns 0. */
+  SizeType
+  GetHeaderSize() const override;
+
+private:
+  /** The properties of one array of the store, a level of the pyramid. */
+  struct ArrayInformation
+  {
+    std::string Path;
+    /** Shape and chunk shape, in C order, the channel axis included. */
+    std::vector<SizeValueType> Shape;
+    std::vector<SizeValueType> ChunkShape;
+    /** The image dimension of each axis, or -1 for the channel axis. */
+    std::vector<int> AxisDimensions;
+    /** The data type, without byte order, as in version 2 (e.g. "f4"). */
+    std::string      DataType;
+    std::string      Codec;
+    int              CompressionLevel{ 1 };
+    bool             SwapBytes{ false };
+    std::string      KeySeparator;
+    std::string      KeyPrefix;
+    /** The value of the chunks never written, as a component in the byte
+     * order of the system. */
+    std::vector<char> FillValue;
+  };
+
+  /** Read the metadata of the store. */
+  void
+  ReadStoreMetadata(std::vector<ArrayInformation> & arrays,
+                    std::vector<std::vector<double>> & spacings,
+                    std::vector<std::vector<double>> & origins);
+
+  /** Read the metadata of an array of the store. */
+  void
+  ReadArrayMetadata(ArrayInformation & array) const;
+
+  /** Remove the metadata and the chunks of the store, leaving the files it
+   * does not know of. An exception is thrown if the existing directory is
+   * not a store. */
+  void
+  RemoveStore();
+
+  /** Fill the properties of the arrays written. */
+  void
+  SetupWrittenArrays();
+
+  /** Copy the chunks of an array intersecting a region of the image from or
+   * to a buffer holding that region. Reading fills the buffer, writing
+   * updates the chunks. */
+  void
+  TransferRegion(const ArrayInformation & array,
+                 const std::vector<IndexValueType> & regionIndex,
+                 const std::vector<SizeValueType> &  regionSize,
+                 char *                              buffer,
+                 bool                                write) const;
+
+  std::string
+  GetChunkFileName(const ArrayInformation & array, const std::vector<SizeValueType> & chunkIndex) const;
+
+  void
+  DecodeChunk(const ArrayInformation & array, const std::string & fileName, std::vector<char> & chunk) const;
+
+  void
+  EncodeChunk(const ArrayInformation & array, const std::string & fileName, const std::vector<char> & chunk) const;
+
+  unsigned int               m_ZarrFormat{ 2 };
+  std::vector<SizeValueType> m_ChunkSize;
+  unsigned int               m_NumberOfPyramidLevels{ 1 };
+  unsigned int               m_PyramidLevel{ 0 };
+  std::string                m_ImageName;
+  std::string                m_Codec{ "zlib" };
+
+  /** The arrays of the levels of the store read or written. */
+  std::vector<ArrayInformation> m_Arrays;
+  bool                          m_ImageInformationWritten{ false };
+  /** Whether the chunks of the store were removed before it is rewritten. */
+  bool m_StoreRemoved{ false };
+};
+} // end namespace itk
+
+#endif // itkZarrImageIO_h
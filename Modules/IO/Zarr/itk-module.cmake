@@ -0,0 +1,19 @@
+set(DOCUMENTATION "This module contains an ImageIO class to read and write
+images as <a href=\"https://zarr.dev\">Zarr</a> stores on the local filesystem:
+chunked N-D arrays with the multiscales metadata of the
+<a href=\"https://ngff.openmicroscopy.org\">OME-NGFF</a> specification, holding
+a resolution pyramid.")
+
+itk_module(ITKIOZarr
+  ENABLE_SHARED
+  DEPENDS
+    ITKIOImageBase
+  PRIVATE_DEPENDS
+    ITKZLIB
+  TEST_DEPENDS
+    ITKTestKernel
+  FACTORY_NAMES
+    ImageIO::Zarr
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
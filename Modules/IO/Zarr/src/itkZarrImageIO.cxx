@@ -0,0 +1,1602 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrImageIO.h"
+#include "itkZarrJSON.h"
+#include "itkByteSwapper.h"
+#include "itkImageIOPyramidHelper.h"
+#include "itkMultiThreaderBase.h"
+#include "itk_zlib.h"
+#include "itksys/Directory.hxx"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+
+namespace itk
+{
+namespace
+{
+const char * const ITKAttributesName = "itk";
+
+std::string
+ReadTextFile(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    itkGenericExceptionMacro(<< "Cannot open " << fileName);
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+void
+WriteTextFile(const std::string & fileName, const std::string & text)
+{
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    itkGenericExceptionMacro(<< "Cannot write " << fileName);
+  }
+  file << text;
+  if (file.fail())
+  {
+    itkGenericExceptionMacro(<< "Failed writing " << fileName);
+  }
+}
+
+std::string
+JoinPath(const std::string & directory, const std::string & name)
+{
+  if (directory.empty())
+  {
+    return name;
+  }
+  if (name.empty())
+  {
+    return directory;
+  }
+  return directory + '/' + name;
+}
+
+const ZarrJSONValue &
+GetMember(const ZarrJSONValue & object, const std::string & key, const std::string & fileName)
+{
+  const ZarrJSONValue * member = object.Find(key);
+  if (member == nullptr)
+  {
+    itkGenericExceptionMacro(<< "Missing \"" << key << "\" in " << fileName);
+  }
+  return *member;
+}
+
+std::vector<SizeValueType>
+GetSizes(const ZarrJSONValue & array, const std::string & fileName)
+{
+  if (!array.IsArray())
+  {
+    itkGenericExceptionMacro(<< "Invalid shape in " << fileName);
+  }
+  std::vector<SizeValueType> sizes;
+  for (const auto & element : array.GetArray())
+  {
+    if (!element.IsNumber() || element.GetNumber() < 0)
+    {
+      itkGenericExceptionMacro(<< "Invalid shape in " << fileName);
+    }
+    sizes.push_back(static_cast<SizeValueType>(element.GetNumber()));
+  }
+  return sizes;
+}
+
+ZarrJSONValue
+MakeNumberArray(const std::vector<double> & numbers)
+{
+  ZarrJSONValue array = ZarrJSONValue::MakeArray();
+  for (const double number : numbers)
+  {
+    array.Append(ZarrJSONValue(number));
+  }
+  return array;
+}
+
+ZarrJSONValue
+MakeNumberArray(const std::vector<SizeValueType> & numbers)
+{
+  ZarrJSONValue array = ZarrJSONValue::MakeArray();
+  for (const SizeValueType number : numbers)
+  {
+    array.Append(ZarrJSONValue(static_cast<double>(number)));
+  }
+  return array;
+}
+
+/** The name of the component type in the data types of the two versions. */
+std::string
+ComponentTypeToDataType(IOComponentEnum componentType, unsigned int componentSize, unsigned int zarrFormat)
+{
+  char kind;
+  switch (componentType)
+  {
+    case IOComponentEnum::FLOAT:
+    case IOComponentEnum::DOUBLE:
+      kind = 'f';
+      break;
+    case IOComponentEnum::UCHAR:
+    case IOComponentEnum::USHORT:
+    case IOComponentEnum::UINT:
+    case IOComponentEnum::ULONG:
+    case IOComponentEnum::ULONGLONG:
+      kind = 'u';
+      break;
+    case IOComponentEnum::CHAR:
+    case IOComponentEnum::SHORT:
+    case IOComponentEnum::INT:
+    case IOComponentEnum::LONG:
+    case IOComponentEnum::LONGLONG:
+      kind = 'i';
+      break;
+    default:
+      itkGenericExceptionMacro(<< "Unsupported component type: "
+                               << ImageIOBase::GetComponentTypeAsString(componentType));
+  }
+
+  if (zarrFormat == 2)
+  {
+    const char byteOrder = componentSize == 1 ? '|' : (ByteSwapper<int>::SystemIsBigEndian() ? '>' : '<');
+    return std::string(1, byteOrder) + kind + std::to_string(componentSize);
+  }
+  const char * name = kind == 'f' ? "float" : (kind == 'u' ? "uint" : "int");
+  return name + std::to_string(8 * componentSize);
+}
+
+/** The data types, as version 2 type strings without the byte order, and
+ * as version 3 data type names. */
+const struct
+{
+  const char *    V2;
+  const char *    V3;
+  IOComponentEnum ComponentType;
+} DataTypes[] = { { "u1", "uint8", IOComponentEnum::UCHAR },      { "i1", "int8", IOComponentEnum::CHAR },
+                  { "u2", "uint16", IOComponentEnum::USHORT },    { "i2", "int16", IOComponentEnum::SHORT },
+                  { "u4", "uint32", IOComponentEnum::UINT },      { "i4", "int32", IOComponentEnum::INT },
+                  { "u8", "uint64", IOComponentEnum::ULONGLONG }, { "i8", "int64", IOComponentEnum::LONGLONG },
+                  { "f4", "float32", IOComponentEnum::FLOAT },    { "f8", "float64", IOComponentEnum::DOUBLE } };
+
+/** The version 2 type string of a data type of either version, or an empty
+ * string if it is not supported. */
+std::string
+NormalizeDataType(const std::string & dataType)
+{
+  for (const auto & type : DataTypes)
+  {
+    if (dataType == type.V2 || dataType == type.V3)
+    {
+      return type.V2;
+    }
+  }
+  return std::string();
+}
+
+IOComponentEnum
+DataTypeToComponentType(const std::string & dataType)
+{
+  for (const auto & type : DataTypes)
+  {
+    if (dataType == type.V2)
+    {
+      return type.ComponentType;
+    }
+  }
+  return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+}
+
+/** A component holding a value, in the byte order of the system. */
+template <typename T>
+std::vector<char>
+ComponentBytes(double value)
+{
+  const auto        component = static_cast<T>(value);
+  std::vector<char> bytes(sizeof(T));
+  std::memcpy(bytes.data(), &component, sizeof(T));
+  return bytes;
+}
+
+/** The fill value of the chunks which were never written, as a component in
+ * the byte order of the system. */
+std::vector<char>
+GetFillValue(const ZarrJSONValue * fillValue, const std::string & dataType, const std::string & fileName)
+{
+  const bool floatingPoint = dataType[0] == 'f';
+  double     value = 0.0;
+  if (fillValue == nullptr || fillValue->GetType() == ZarrJSONValue::Type::Null)
+  {
+    value = 0.0;
+  }
+  else if (fillValue->GetType() == ZarrJSONValue::Type::Boolean)
+  {
+    value = fillValue->GetBoolean() ? 1.0 : 0.0;
+  }
+  else if (fillValue->IsNumber())
+  {
+    value = fillValue->GetNumber();
+  }
+  else if (floatingPoint && fillValue->IsString() && fillValue->GetString() == "NaN")
+  {
+    value = std::numeric_limits<double>::quiet_NaN();
+  }
+  else if (floatingPoint && fillValue->IsString() && fillValue->GetString() == "Infinity")
+  {
+    value = std::numeric_limits<double>::infinity();
+  }
+  else if (floatingPoint && fillValue->IsString() && fillValue->GetString() == "-Infinity")
+  {
+    value = -std::numeric_limits<double>::infinity();
+  }
+  else
+  {
+    itkGenericExceptionMacro(<< "Unsupported fill value in " << fileName);
+  }
+
+  switch (DataTypeToComponentType(dataType))
+  {
+    case IOComponentEnum::UCHAR:
+      return ComponentBytes<uint8_t>(value);
+    case IOComponentEnum::CHAR:
+      return ComponentBytes<int8_t>(value);
+    case IOComponentEnum::USHORT:
+      return ComponentBytes<uint16_t>(value);
+    case IOComponentEnum::SHORT:
+      return ComponentBytes<int16_t>(value);
+    case IOComponentEnum::UINT:
+      return ComponentBytes<uint32_t>(value);
+    case IOComponentEnum::INT:
+      return ComponentBytes<int32_t>(value);
+    case IOComponentEnum::ULONGLONG:
+      return ComponentBytes<uint64_t>(value);
+    case IOComponentEnum::LONGLONG:
+      return ComponentBytes<int64_t>(value);
+    case IOComponentEnum::FLOAT:
+      return ComponentBytes<float>(value);
+    default:
+      return ComponentBytes<double>(value);
+  }
+}
+
+/** Fill a chunk with a component, or with zeros if it is empty. */
+void
+FillChunk(std::vector<char> & chunk, const std::vector<char> & fillValue)
+{
+  if (fillValue.empty() || std::all_of(fillValue.begin(), fillValue.end(), [](char c) { return c == 0; }))
+  {
+    std::fill(chunk.begin(), chunk.end(), 0);
+    return;
+  }
+  for (auto it = chunk.begin(); it != chunk.end(); it += fillValue.size())
+  {
+    std::copy(fillValue.begin(), fillValue.end(), it);
+  }
+}
+
+/** Whether a path relative to the directory of an array is the key of one of
+ * its chunks. */
+bool
+IsChunkKey(const std::string &                key,
+           const std::string &                keyPrefix,
+           const std::string &                keySeparator,
+           const std::vector<SizeValueType> & shape,
+           const std::vector<SizeValueType> & chunkShape)
+{
+  if (key.compare(0, keyPrefix.size(), keyPrefix) != 0)
+  {
+    return false;
+  }
+  std::string::size_type position = keyPrefix.size();
+  for (unsigned int a = 0; a < shape.size(); ++a)
+  {
+    const std::string::size_type end = a + 1 < shape.size() ? key.find(keySeparator, position) : key.size();
+    if (end == std::string::npos || end == position || end - position > 18 ||
+        key.find_first_not_of("0123456789", position) < end)
+    {
+      return false;
+    }
+    const SizeValueType chunk = std::stoull(key.substr(position, end - position));
+    if (chunk >= (shape[a] + chunkShape[a] - 1) / chunkShape[a])
+    {
+      return false;
+    }
+    position = end + keySeparator.size();
+  }
+  return true;
+}
+
+/** The name and type of the axes of the image dimensions, in the order of
+ * the OME-NGFF specification. */
+void
+GetAxis(int dimension, std::string & name, std::string & type)
+{
+  switch (dimension)
+  {
+    case -1:
+      name = "c";
+      type = "channel";
+      break;
+    case 0:
+      name = "x";
+      type = "space";
+      break;
+    case 1:
+      name = "y";
+      type = "space";
+      break;
+    case 2:
+      name = "z";
+      type = "space";
+      break;
+    case 3:
+      name = "t";
+      type = "time";
+      break;
+    default:
+      name = "d" + std::to_string(dimension);
+      type = "space";
+  }
+}
+} // namespace
+
+ZarrImageIO::ZarrImageIO()
+{
+  this->SetNumberOfDimensions(3);
+  this->SetFileTypeToBinary();
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(1);
+  this->Self::SetCompressor("");
+
+  const char * extensions[] = { ".zarr" };
+  for (auto ext : extensions)
+  {
+    this->AddSupportedWriteExtension(ext);
+    this->AddSupportedReadExtension(ext);
+  }
+}
+
+ZarrImageIO::~ZarrImageIO() = default;
+
+void
+ZarrImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ZarrFormat: " << m_ZarrFormat << std::endl;
+  os << indent << "ChunkSize: [";
+  for (SizeValueType i = 0; i < m_ChunkSize.size(); ++i)
+  {
+    os << (i == 0 ? "" : ", ") << m_ChunkSize[i];
+  }
+  os << "]" << std::endl;
+  os << indent << "NumberOfPyramidLevels: " << m_NumberOfPyramidLevels << std::endl;
+  os << indent << "PyramidLevel: " << m_PyramidLevel << std::endl;
+  os << indent << "ImageName: " << m_ImageName << std::endl;
+  os << indent << "Codec: " << m_Codec << std::endl;
+}
+
+void
+ZarrImageIO::SetChunkSize(const std::vector<SizeValueType> & chunkSize)
+{
+  if (m_ChunkSize != chunkSize)
+  {
+    m_ChunkSize = chunkSize;
+    this->Modified();
+  }
+}
+
+void
+ZarrImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "ZLIB")
+  {
+    m_Codec = "zlib";
+  }
+  else if (_compressor == "GZIP")
+  {
+    m_Codec = "gzip";
+  }
+  else
+  {
+    this->Superclass::InternalSetCompressor(_compressor);
+  }
+}
+
+bool
+ZarrImageIO::CanReadFile(const char * FileNameToRead)
+{
+  const std::string fileName = FileNameToRead;
+  if (fileName.empty() || !itksys::SystemTools::FileIsDirectory(fileName))
+  {
+    return false;
+  }
+
+  // a group with multiscales metadata, or a single array
+  try
+  {
+    const std::string v3 = JoinPath(fileName, "zarr.json");
+    if (itksys::SystemTools::FileExists(v3, true))
+    {
+      const ZarrJSONValue metadata = ZarrJSONValue::Parse(ReadTextFile(v3));
+      const ZarrJSONValue * nodeType = metadata.Find("node_type");
+      const ZarrJSONValue * attributes = metadata.Find("attributes");
+      if (nodeType != nullptr && nodeType->IsString() && nodeType->GetString() == "array")
+      {
+        return true;
+      }
+      if (attributes != nullptr)
+      {
+        const ZarrJSONValue * ome = attributes->Find("ome");
+        return attributes->Find("multiscales") != nullptr || (ome != nullptr && ome->Find("multiscales") != nullptr);
+      }
+      return false;
+    }
+    if (itksys::SystemTools::FileExists(JoinPath(fileName, ".zarray"), true))
+    {
+      return true;
+    }
+    const std::string attributes = JoinPath(fileName, ".zattrs");
+    if (itksys::SystemTools::FileExists(attributes, true))
+    {
+      return ZarrJSONValue::Parse(ReadTextFile(attributes)).Find("multiscales") != nullptr;
+    }
+  }
+  catch (ExceptionObject &)
+  {}
+  return false;
+}
+
+bool
+ZarrImageIO::CanWriteFile(const char * FileNameToWrite)
+{
+  const std::string fileName = FileNameToWrite;
+  return !fileName.empty() && this->HasSupportedWriteExtension(FileNameToWrite, false);
+}
+
+void
+ZarrImageIO::ReadArrayMetadata(ArrayInformation & array) const
+{
+  const std::string directory = JoinPath(m_FileName, array.Path);
+  const bool        littleEndian = ByteSwapper<int>::SystemIsLittleEndian();
+
+  std::string   fileName = JoinPath(directory, "zarr.json");
+  ZarrJSONValue metadata;
+  if (itksys::SystemTools::FileExists(fileName, true))
+  {
+    metadata = ZarrJSONValue::Parse(ReadTextFile(fileName));
+    array.Shape = GetSizes(GetMember(metadata, "shape", fileName), fileName);
+
+    const ZarrJSONValue & chunkGrid = GetMember(metadata, "chunk_grid", fileName);
+    const ZarrJSONValue * gridName = chunkGrid.Find("name");
+    if (gridName == nullptr || !gridName->IsString() || gridName->GetString() != "regular")
+    {
+      itkExceptionMacro(<< "Only regular chunk grids are supported in " << fileName);
+    }
+    array.ChunkShape =
+      GetSizes(GetMember(GetMember(chunkGrid, "configuration", fileName), "chunk_shape", fileName), fileName);
+
+    const ZarrJSONValue & dataType = GetMember(metadata, "data_type", fileName);
+    array.DataType = dataType.IsString() ? NormalizeDataType(dataType.GetString()) : "";
+    if (array.DataType.empty())
+    {
+      itkExceptionMacro(<< "Unsupported data type in " << fileName);
+    }
+
+    // the default key encoding is c/i/j/k, the v2 one is i.j.k
+    array.KeyPrefix = "c";
+    array.KeySeparator = "/";
+    if (const ZarrJSONValue * keyEncoding = metadata.Find("chunk_key_encoding"))
+    {
+      const ZarrJSONValue * name = keyEncoding->Find("name");
+      const ZarrJSONValue * configuration = keyEncoding->Find("configuration");
+      const ZarrJSONValue * separator = configuration ? configuration->Find("separator") : nullptr;
+      const bool            v2 = name != nullptr && name->IsString() && name->GetString() == "v2";
+      array.KeyPrefix = v2 ? "" : "c";
+      array.KeySeparator = separator != nullptr && separator->IsString() ? separator->GetString() : (v2 ? "." : "/");
+    }
+    if (!array.KeyPrefix.empty())
+    {
+      array.KeyPrefix += array.KeySeparator;
+    }
+
+    array.FillValue = GetFillValue(metadata.Find("fill_value"), array.DataType, fileName);
+
+    array.Codec = "raw";
+    for (const auto & codec : GetMember(metadata, "codecs", fileName).GetArray())
+    {
+      const ZarrJSONValue * name = codec.Find("name");
+      const ZarrJSONValue * configuration = codec.Find("configuration");
+      const std::string     codecName = name != nullptr && name->IsString() ? name->GetString() : "";
+      if (codecName == "bytes")
+      {
+        const ZarrJSONValue * endian = configuration ? configuration->Find("endian") : nullptr;
+        array.SwapBytes =
+          endian != nullptr && endian->IsString() && (endian->GetString() == "little") != littleEndian;
+      }
+      else if (codecName == "gzip" || codecName == "zlib")
+      {
+        array.Codec = codecName;
+      }
+      else
+      {
+        itkExceptionMacro(<< "Unsupported codec \"" << codecName << "\" in " << fileName);
+      }
+    }
+  }
+  else
+  {
+    fileName = JoinPath(directory, ".zarray");
+    metadata = ZarrJSONValue::Parse(ReadTextFile(fileName));
+    array.Shape = GetSizes(GetMember(metadata, "shape", fileName), fileName);
+    array.ChunkShape = GetSizes(GetMember(metadata, "chunks", fileName), fileName);
+
+    const ZarrJSONValue & dataType = GetMember(metadata, "dtype", fileName);
+    array.DataType = dataType.IsString() && dataType.GetString().size() > 1
+                       ? NormalizeDataType(dataType.GetString().substr(1))
+                       : "";
+    if (array.DataType.empty())
+    {
+      itkExceptionMacro(<< "Unsupported data type in " << fileName);
+    }
+    const char byteOrder = dataType.GetString()[0];
+    array.SwapBytes = (byteOrder == '<' && !littleEndian) || (byteOrder == '>' && littleEndian);
+    array.FillValue = GetFillValue(metadata.Find("fill_value"), array.DataType, fileName);
+
+    const ZarrJSONValue * order = metadata.Find("order");
+    if (order != nullptr && order->IsString() && order->GetString() != "C")
+    {
+      itkExceptionMacro(<< "Only arrays in C order are supported in " << fileName);
+    }
+    const ZarrJSONValue * filters = metadata.Find("filters");
+    if (filters != nullptr && filters->IsArray() && !filters->GetArray().empty())
+    {
+      itkExceptionMacro(<< "Filters are not supported in " << fileName);
+    }
+
+    array.KeyPrefix = "";
+    array.KeySeparator = ".";
+    const ZarrJSONValue * separator = metadata.Find("dimension_separator");
+    if (separator != nullptr && separator->IsString())
+    {
+      array.KeySeparator = separator->GetString();
+    }
+
+    array.Codec = "raw";
+    const ZarrJSONValue & compressor = GetMember(metadata, "compressor", fileName);
+    if (compressor.IsObject())
+    {
+      const ZarrJSONValue & id = GetMember(compressor, "id", fileName);
+      if (!id.IsString() || (id.GetString() != "zlib" && id.GetString() != "gzip"))
+      {
+        itkExceptionMacro(<< "Unsupported compressor \"" << (id.IsString() ? id.GetString() : "") << "\" in "
+                          << fileName);
+      }
+      array.Codec = id.GetString();
+    }
+  }
+
+  if (array.Shape.empty() || array.ChunkShape.size() != array.Shape.size() ||
+      std::find(array.ChunkShape.begin(), array.ChunkShape.end(), 0) != array.ChunkShape.end())
+  {
+    itkExceptionMacro(<< "Invalid chunk shape in " << fileName);
+  }
+}
+
+void
+ZarrImageIO::ReadStoreMetadata(std::vector<ArrayInformation> &    arrays,
+                               std::vector<std::vector<double>> & spacings,
+                               std::vector<std::vector<double>> & origins)
+{
+  arrays.clear();
+  spacings.clear();
+  origins.clear();
+
+  // the attributes of the group at the root of the store
+  ZarrJSONValue attributes;
+  std::string   fileName = JoinPath(m_FileName, "zarr.json");
+  if (itksys::SystemTools::FileExists(fileName, true))
+  {
+    m_ZarrFormat = 3;
+    const ZarrJSONValue metadata = ZarrJSONValue::Parse(ReadTextFile(fileName));
+    const ZarrJSONValue * nodeAttributes = metadata.Find("attributes");
+    if (nodeAttributes != nullptr)
+    {
+      attributes = *nodeAttributes;
+    }
+  }
+  else
+  {
+    m_ZarrFormat = 2;
+    fileName = JoinPath(m_FileName, ".zattrs");
+    if (itksys::SystemTools::FileExists(fileName, true))
+    {
+      attributes = ZarrJSONValue::Parse(ReadTextFile(fileName));
+    }
+  }
+
+  const ZarrJSONValue * multiscales = attributes.Find("multiscales");
+  if (const ZarrJSONValue * ome = attributes.Find("ome"))
+  {
+    multiscales = ome->Find("multiscales");
+  }
+  if (multiscales == nullptr || !multiscales->IsArray() || multiscales->GetArray().empty())
+  {
+    // a single array, without metadata
+    ArrayInformation array;
+    this->ReadArrayMetadata(array);
+    array.AxisDimensions.resize(array.Shape.size());
+    for (unsigned int a = 0; a < array.Shape.size(); ++a)
+    {
+      array.AxisDimensions[a] = static_cast<int>(array.Shape.size() - 1 - a);
+    }
+    spacings.emplace_back(array.Shape.size(), 1.0);
+    origins.emplace_back(array.Shape.size(), 0.0);
+    arrays.push_back(array);
+    return;
+  }
+  const ZarrJSONValue & multiscale = multiscales->GetArray()[0];
+
+  // the image dimension of each axis, the last axis being the first dimension
+  std::vector<int> axisDimensions;
+  if (const ZarrJSONValue * axes = multiscale.Find("axes"))
+  {
+    std::vector<bool> channel;
+    for (const auto & axis : axes->GetArray())
+    {
+      const ZarrJSONValue * name = axis.IsString() ? &axis : axis.Find("name");
+      const ZarrJSONValue * type = axis.IsString() ? nullptr : axis.Find("type");
+      channel.push_back((type != nullptr && type->IsString() && type->GetString() == "channel") ||
+                        (type == nullptr && name != nullptr && name->IsString() && name->GetString() == "c"));
+    }
+    int dimension = static_cast<int>(std::count(channel.begin(), channel.end(), false));
+    for (const bool isChannel : channel)
+    {
+      axisDimensions.push_back(isChannel ? -1 : --dimension);
+    }
+    if (std::count(channel.begin(), channel.end(), true) > 1)
+    {
+      itkExceptionMacro(<< "Only one channel axis is supported in " << fileName);
+    }
+  }
+
+  for (const auto & dataset : GetMember(multiscale, "datasets", fileName).GetArray())
+  {
+    ArrayInformation array;
+    const ZarrJSONValue & path = GetMember(dataset, "path", fileName);
+    array.Path = path.IsString() ? path.GetString() : "";
+    this->ReadArrayMetadata(array);
+
+    if (axisDimensions.empty())
+    {
+      for (unsigned int a = 0; a < array.Shape.size(); ++a)
+      {
+        axisDimensions.push_back(static_cast<int>(array.Shape.size() - 1 - a));
+      }
+    }
+    if (axisDimensions.size() != array.Shape.size())
+    {
+      itkExceptionMacro(<< "The axes do not match the shape of " << array.Path << " in " << fileName);
+    }
+    array.AxisDimensions = axisDimensions;
+
+    // the spacing and origin in image dimensions
+    const auto numberOfDimensions =
+      static_cast<unsigned int>(*std::max_element(axisDimensions.begin(), axisDimensions.end()) + 1);
+    std::vector<double> spacing(numberOfDimensions, 1.0);
+    std::vector<double> origin(numberOfDimensions, 0.0);
+    if (const ZarrJSONValue * transformations = dataset.Find("coordinateTransformations"))
+    {
+      for (const auto & transformation : transformations->GetArray())
+      {
+        const ZarrJSONValue * type = transformation.Find("type");
+        if (type == nullptr || !type->IsString())
+        {
+          continue;
+        }
+        const ZarrJSONValue * values = transformation.Find(type->GetString());
+        if (values == nullptr || !values->IsArray() || values->GetArray().size() != axisDimensions.size())
+        {
+          continue;
+        }
+        for (unsigned int a = 0; a < axisDimensions.size(); ++a)
+        {
+          if (axisDimensions[a] >= 0 && values->GetArray()[a].IsNumber())
+          {
+            if (type->GetString() == "scale")
+            {
+              spacing[axisDimensions[a]] = values->GetArray()[a].GetNumber();
+            }
+            else if (type->GetString() == "translation")
+            {
+              origin[axisDimensions[a]] = values->GetArray()[a].GetNumber();
+            }
+          }
+        }
+      }
+    }
+    spacings.push_back(spacing);
+    origins.push_back(origin);
+    arrays.push_back(array);
+  }
+  if (arrays.empty())
+  {
+    itkExceptionMacro(<< "No dataset in the multiscales of " << fileName);
+  }
+}
+
+void
+ZarrImageIO::ReadImageInformation()
+{
+  std::vector<std::vector<double>> spacings;
+  std::vector<std::vector<double>> origins;
+  this->ReadStoreMetadata(m_Arrays, spacings, origins);
+
+  m_NumberOfPyramidLevels = static_cast<unsigned int>(m_Arrays.size());
+  if (m_PyramidLevel >= m_NumberOfPyramidLevels)
+  {
+    itkExceptionMacro(<< "Pyramid level " << m_PyramidLevel << " does not exist in " << m_FileName << ", which has "
+                      << m_NumberOfPyramidLevels << " levels");
+  }
+  const ArrayInformation & array = m_Arrays[m_PyramidLevel];
+
+  const unsigned int numberOfDimensions = static_cast<unsigned int>(spacings[m_PyramidLevel].size());
+  this->SetNumberOfDimensions(numberOfDimensions);
+  this->SetNumberOfComponents(1);
+  for (unsigned int a = 0; a < array.Shape.size(); ++a)
+  {
+    if (array.AxisDimensions[a] < 0)
+    {
+      this->SetNumberOfComponents(static_cast<unsigned int>(array.Shape[a]));
+    }
+    else
+    {
+      this->SetDimensions(array.AxisDimensions[a], array.Shape[a]);
+    }
+  }
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    this->SetSpacing(d, spacings[m_PyramidLevel][d]);
+    this->SetOrigin(d, origins[m_PyramidLevel][d]);
+    std::vector<double> axis(numberOfDimensions, 0.0);
+    axis[d] = 1.0;
+    this->SetDirection(d, axis);
+  }
+
+  this->SetComponentType(DataTypeToComponentType(array.DataType));
+  this->SetPixelType(this->GetNumberOfComponents() == 1 ? IOPixelEnum::SCALAR : IOPixelEnum::VECTOR);
+
+  // the properties which OME-NGFF does not describe
+  ZarrJSONValue attributes;
+  std::string   fileName = JoinPath(m_FileName, m_ZarrFormat == 3 ? "zarr.json" : ".zattrs");
+  if (itksys::SystemTools::FileExists(fileName, true))
+  {
+    const ZarrJSONValue metadata = ZarrJSONValue::Parse(ReadTextFile(fileName));
+    const ZarrJSONValue * nodeAttributes = m_ZarrFormat == 3 ? metadata.Find("attributes") : &metadata;
+    const ZarrJSONValue * itkAttributes = nodeAttributes ? nodeAttributes->Find(ITKAttributesName) : nullptr;
+    if (itkAttributes != nullptr)
+    {
+      const ZarrJSONValue * direction = itkAttributes->Find("direction");
+      if (direction != nullptr && direction->IsArray() && direction->GetArray().size() == numberOfDimensions)
+      {
+        // the rows of the matrix, the columns being the directions of the axes
+        for (unsigned int d = 0; d < numberOfDimensions; ++d)
+        {
+          std::vector<double> axis(numberOfDimensions);
+          for (unsigned int r = 0; r < numberOfDimensions; ++r)
+          {
+            const ZarrJSONValue & row = direction->GetArray()[r];
+            if (!row.IsArray() || row.GetArray().size() != numberOfDimensions || !row.GetArray()[d].IsNumber())
+            {
+              itkExceptionMacro(<< "Invalid direction in " << fileName);
+            }
+            axis[r] = row.GetArray()[d].GetNumber();
+          }
+          this->SetDirection(d, axis);
+        }
+      }
+      const ZarrJSONValue * pixelType = itkAttributes->Find("pixelType");
+      if (pixelType != nullptr && pixelType->IsString())
+      {
+        const IOPixelEnum type = ImageIOBase::GetPixelTypeFromString(pixelType->GetString());
+        if (type != IOPixelEnum::UNKNOWNPIXELTYPE &&
+            (type == IOPixelEnum::SCALAR) == (this->GetNumberOfComponents() == 1))
+        {
+          this->SetPixelType(type);
+        }
+      }
+    }
+  }
+}
+
+void
+ZarrImageIO::Read(void * buffer)
+{
+  const ImageIORegion &       region = this->GetIORegion();
+  const unsigned int          numberOfDimensions = this->GetNumberOfDimensions();
+  std::vector<IndexValueType> regionIndex(numberOfDimensions, 0);
+  std::vector<SizeValueType>  regionSize(numberOfDimensions, 1);
+  for (unsigned int d = 0; d < numberOfDimensions && d < region.GetImageDimension(); ++d)
+  {
+    regionIndex[d] = region.GetIndex(d);
+    regionSize[d] = region.GetSize(d);
+  }
+  this->TransferRegion(m_Arrays[m_PyramidLevel], regionIndex, regionSize, static_cast<char *>(buffer), false);
+}
+
+void
+ZarrImageIO::RemoveStore()
+{
+  itksys::Directory root;
+  if (!root.Load(m_FileName) || root.GetNumberOfFiles() <= 2)
+  {
+    // an empty directory, besides . and ..
+    return;
+  }
+
+  std::vector<ArrayInformation>    arrays;
+  std::vector<std::vector<double>> spacings;
+  std::vector<std::vector<double>> origins;
+  const unsigned int               zarrFormat = m_ZarrFormat;
+  try
+  {
+    this->ReadStoreMetadata(arrays, spacings, origins);
+  }
+  catch (ExceptionObject & e)
+  {
+    m_ZarrFormat = zarrFormat;
+    itkExceptionMacro(<< "The existing directory " << m_FileName
+                      << " is not a Zarr store, and is not overwritten: " << e.GetDescription());
+  }
+  m_ZarrFormat = zarrFormat;
+
+  const char * const metadataNames[] = { ".zarray", ".zattrs", ".zgroup", "zarr.json" };
+  for (const auto & array : arrays)
+  {
+    // the chunks, in the subdirectories of the array with the default key
+    // encoding of version 3 or the "/" separator
+    const std::string        arrayDirectory = JoinPath(m_FileName, array.Path);
+    std::vector<std::string> directories{ arrayDirectory };
+    std::vector<std::string> keys{ "" };
+    for (unsigned int i = 0; i < directories.size(); ++i)
+    {
+      itksys::Directory directory;
+      if (!directory.Load(directories[i]))
+      {
+        continue;
+      }
+      for (unsigned long f = 0; f < directory.GetNumberOfFiles(); ++f)
+      {
+        const std::string name = directory.GetFile(f);
+        if (name == "." || name == "..")
+        {
+          continue;
+        }
+        const std::string path = JoinPath(directories[i], name);
+        const std::string key = keys[i].empty() ? name : keys[i] + '/' + name;
+        if (itksys::SystemTools::FileIsDirectory(path))
+        {
+          directories.push_back(path);
+          keys.push_back(key);
+        }
+        else if (IsChunkKey(key, array.KeyPrefix, array.KeySeparator, array.Shape, array.ChunkShape) &&
+                 !itksys::SystemTools::RemoveFile(path))
+        {
+          itkExceptionMacro(<< "Unable to remove the chunk " << path);
+        }
+      }
+    }
+    for (const char * metadataName : metadataNames)
+    {
+      itksys::SystemTools::RemoveFile(JoinPath(arrayDirectory, metadataName));
+    }
+
+    // the directories left empty, the deepest first
+    for (unsigned int i = static_cast<unsigned int>(directories.size()); i-- > 0;)
+    {
+      itksys::Directory directory;
+      if (directories[i] != m_FileName && directory.Load(directories[i]) && directory.GetNumberOfFiles() <= 2)
+      {
+        itksys::SystemTools::RemoveADirectory(directories[i]);
+      }
+    }
+  }
+
+  for (const char * metadataName : metadataNames)
+  {
+    itksys::SystemTools::RemoveFile(JoinPath(m_FileName, metadataName));
+  }
+}
+
+void
+ZarrImageIO::SetupWrittenArrays()
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+
+  // time and the extra dimensions, the channel, then space, as OME-NGFF
+  // orders them
+  std::vector<int> axisDimensions;
+  for (int d = static_cast<int>(numberOfDimensions) - 1; d >= 3; --d)
+  {
+    axisDimensions.push_back(d);
+  }
+  if (numberOfComponents > 1)
+  {
+    axisDimensions.push_back(-1);
+  }
+  for (int d = static_cast<int>(std::min(numberOfDimensions, 3u)) - 1; d >= 0; --d)
+  {
+    axisDimensions.push_back(d);
+  }
+
+  m_Arrays.clear();
+  for (unsigned int level = 0; level < m_NumberOfPyramidLevels; ++level)
+  {
+    const std::vector<SizeValueType> dimensions = ImageIOPyramidHelper::GetLevelDimensions(this, level);
+
+    ArrayInformation array;
+    array.Path = std::to_string(level);
+    array.AxisDimensions = axisDimensions;
+    array.DataType = ComponentTypeToDataType(this->GetComponentType(), this->GetComponentSize(), 2).substr(1);
+    array.Codec = m_UseCompression ? m_Codec : "raw";
+    if (m_ZarrFormat == 3 && array.Codec == "zlib")
+    {
+      // version 3 only specifies gzip
+      array.Codec = "gzip";
+    }
+    array.CompressionLevel = this->GetCompressionLevel();
+    array.KeySeparator = "/";
+    array.KeyPrefix = m_ZarrFormat == 3 ? "c/" : "";
+    array.FillValue.assign(this->GetComponentSize(), 0);
+    for (const int d : axisDimensions)
+    {
+      if (d < 0)
+      {
+        array.Shape.push_back(numberOfComponents);
+        array.ChunkShape.push_back(numberOfComponents);
+        continue;
+      }
+      SizeValueType chunkSize = dimensions[d];
+      if (m_ChunkSize.empty())
+      {
+        chunkSize = d < 3 ? 64 : 1;
+      }
+      else if (static_cast<SizeValueType>(d) < m_ChunkSize.size() && m_ChunkSize[d] > 0)
+      {
+        chunkSize = m_ChunkSize[d];
+      }
+      array.Shape.push_back(dimensions[d]);
+      array.ChunkShape.push_back(std::max<SizeValueType>(1, std::min(chunkSize, dimensions[d])));
+    }
+    m_Arrays.push_back(array);
+  }
+}
+
+void
+ZarrImageIO::WriteImageInformation()
+{
+  if (m_ImageInformationWritten)
+  {
+    return;
+  }
+  this->SetupWrittenArrays();
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+
+  // when pasting, the store is kept if it has the same arrays
+  if (!m_StoreRemoved && itksys::SystemTools::FileIsDirectory(m_FileName))
+  {
+    bool                             compatible = false;
+    std::vector<ArrayInformation>    arrays;
+    std::vector<std::vector<double>> spacings;
+    std::vector<std::vector<double>> origins;
+    const unsigned int               zarrFormat = m_ZarrFormat;
+    try
+    {
+      this->ReadStoreMetadata(arrays, spacings, origins);
+      compatible = m_ZarrFormat == zarrFormat && arrays.size() == m_Arrays.size();
+      for (unsigned int level = 0; compatible && level < arrays.size(); ++level)
+      {
+        compatible = arrays[level].Path == m_Arrays[level].Path && arrays[level].Shape == m_Arrays[level].Shape &&
+                     arrays[level].AxisDimensions == m_Arrays[level].AxisDimensions &&
+                     arrays[level].DataType == m_Arrays[level].DataType && !arrays[level].SwapBytes;
+      }
+    }
+    catch (ExceptionObject &)
+    {
+      compatible = false;
+    }
+    m_ZarrFormat = zarrFormat;
+    if (compatible)
+    {
+      m_Arrays = arrays;
+      m_ImageInformationWritten = true;
+      return;
+    }
+    this->RemoveStore();
+  }
+
+  if (!itksys::SystemTools::MakeDirectory(m_FileName))
+  {
+    itkExceptionMacro(<< "Unable to create the store " << m_FileName);
+  }
+
+  // the OME-NGFF multiscales metadata
+  const std::vector<int> & axisDimensions = m_Arrays[0].AxisDimensions;
+  ZarrJSONValue            axes = ZarrJSONValue::MakeArray();
+  ZarrJSONValue            dimensionNames = ZarrJSONValue::MakeArray();
+  for (const int d : axisDimensions)
+  {
+    std::string name;
+    std::string type;
+    GetAxis(d, name, type);
+    ZarrJSONValue & axis = axes.Append(ZarrJSONValue::MakeObject());
+    axis.Set("name", name);
+    axis.Set("type", type);
+    dimensionNames.Append(name);
+  }
+
+  ZarrJSONValue datasets = ZarrJSONValue::MakeArray();
+  for (unsigned int level = 0; level < m_NumberOfPyramidLevels; ++level)
+  {
+    const double        factor = static_cast<double>(SizeValueType{ 1 } << level);
+    std::vector<double> scale;
+    std::vector<double> translation;
+    for (const int d : axisDimensions)
+    {
+      scale.push_back(d < 0 ? 1.0 : this->GetSpacing(d) * factor);
+      translation.push_back(d < 0 ? 0.0 : this->GetOrigin(d));
+    }
+    ZarrJSONValue & dataset = datasets.Append(ZarrJSONValue::MakeObject());
+    dataset.Set("path", m_Arrays[level].Path);
+    ZarrJSONValue & transformations = dataset.Set("coordinateTransformations", ZarrJSONValue::MakeArray());
+    ZarrJSONValue & scaleTransformation = transformations.Append(ZarrJSONValue::MakeObject());
+    scaleTransformation.Set("type", "scale");
+    scaleTransformation.Set("scale", MakeNumberArray(scale));
+    ZarrJSONValue & translationTransformation = transformations.Append(ZarrJSONValue::MakeObject());
+    translationTransformation.Set("type", "translation");
+    translationTransformation.Set("translation", MakeNumberArray(translation));
+  }
+
+  ZarrJSONValue multiscale = ZarrJSONValue::MakeObject();
+  if (m_ZarrFormat == 2)
+  {
+    multiscale.Set("version", "0.4");
+  }
+  multiscale.Set("name", m_ImageName);
+  multiscale.Set("axes", axes);
+  multiscale.Set("datasets", datasets);
+  multiscale.Set("type", "decimation");
+  ZarrJSONValue multiscales = ZarrJSONValue::MakeArray();
+  multiscales.Append(multiscale);
+
+  ZarrJSONValue itkAttributes = ZarrJSONValue::MakeObject();
+  ZarrJSONValue direction = ZarrJSONValue::MakeArray();
+  for (unsigned int r = 0; r < numberOfDimensions; ++r)
+  {
+    std::vector<double> row;
+    for (unsigned int d = 0; d < numberOfDimensions; ++d)
+    {
+      row.push_back(this->GetDirection(d)[r]);
+    }
+    direction.Append(MakeNumberArray(row));
+  }
+  itkAttributes.Set("direction", direction);
+  itkAttributes.Set("pixelType", ImageIOBase::GetPixelTypeAsString(this->GetPixelType()));
+
+  const std::string byteOrder = ByteSwapper<int>::SystemIsBigEndian() ? ">" : "<";
+  if (m_ZarrFormat == 2)
+  {
+    ZarrJSONValue group = ZarrJSONValue::MakeObject();
+    group.Set("zarr_format", 2.0);
+    WriteTextFile(JoinPath(m_FileName, ".zgroup"), group.Dump());
+
+    ZarrJSONValue attributes = ZarrJSONValue::MakeObject();
+    attributes.Set("multiscales", multiscales);
+    attributes.Set(ITKAttributesName, itkAttributes);
+    WriteTextFile(JoinPath(m_FileName, ".zattrs"), attributes.Dump());
+
+    for (const auto & array : m_Arrays)
+    {
+      ZarrJSONValue compressor;
+      if (array.Codec != "raw")
+      {
+        compressor = ZarrJSONValue::MakeObject();
+        compressor.Set("id", array.Codec);
+        compressor.Set("level", static_cast<double>(array.CompressionLevel));
+      }
+      ZarrJSONValue metadata = ZarrJSONValue::MakeObject();
+      metadata.Set("zarr_format", 2.0);
+      metadata.Set("shape", MakeNumberArray(array.Shape));
+      metadata.Set("chunks", MakeNumberArray(array.ChunkShape));
+      metadata.Set("dtype", (this->GetComponentSize() == 1 ? "|" : byteOrder) + array.DataType);
+      metadata.Set("compressor", compressor);
+      metadata.Set("fill_value", 0.0);
+      metadata.Set("order", "C");
+      metadata.Set("filters", ZarrJSONValue());
+      metadata.Set("dimension_separator", array.KeySeparator);
+
+      const std::string directory = JoinPath(m_FileName, array.Path);
+      itksys::SystemTools::MakeDirectory(directory);
+      WriteTextFile(JoinPath(directory, ".zarray"), metadata.Dump());
+    }
+  }
+  else
+  {
+    ZarrJSONValue ome = ZarrJSONValue::MakeObject();
+    ome.Set("version", "0.5");
+    ome.Set("multiscales", multiscales);
+    ZarrJSONValue attributes = ZarrJSONValue::MakeObject();
+    attributes.Set("ome", ome);
+    attributes.Set(ITKAttributesName, itkAttributes);
+    ZarrJSONValue group = ZarrJSONValue::MakeObject();
+    group.Set("zarr_format", 3.0);
+    group.Set("node_type", "group");
+    group.Set("attributes", attributes);
+    WriteTextFile(JoinPath(m_FileName, "zarr.json"), group.Dump());
+
+    for (const auto & array : m_Arrays)
+    {
+      ZarrJSONValue chunkGrid = ZarrJSONValue::MakeObject();
+      chunkGrid.Set("name", "regular");
+      chunkGrid.Set("configuration", ZarrJSONValue::MakeObject()).Set("chunk_shape", MakeNumberArray(array.ChunkShape));
+      ZarrJSONValue keyEncoding = ZarrJSONValue::MakeObject();
+      keyEncoding.Set("name", "default");
+      keyEncoding.Set("configuration", ZarrJSONValue::MakeObject()).Set("separator", array.KeySeparator);
+
+      ZarrJSONValue   codecs = ZarrJSONValue::MakeArray();
+      ZarrJSONValue & bytes = codecs.Append(ZarrJSONValue::MakeObject());
+      bytes.Set("name", "bytes");
+      if (this->GetComponentSize() > 1)
+      {
+        bytes.Set("configuration", ZarrJSONValue::MakeObject())
+          .Set("endian", ByteSwapper<int>::SystemIsBigEndian() ? "big" : "little");
+      }
+      if (array.Codec != "raw")
+      {
+        ZarrJSONValue & codec = codecs.Append(ZarrJSONValue::MakeObject());
+        codec.Set("name", array.Codec);
+        codec.Set("configuration", ZarrJSONValue::MakeObject())
+          .Set("level", static_cast<double>(array.CompressionLevel));
+      }
+
+      ZarrJSONValue metadata = ZarrJSONValue::MakeObject();
+      metadata.Set("zarr_format", 3.0);
+      metadata.Set("node_type", "array");
+      metadata.Set("shape", MakeNumberArray(array.Shape));
+      metadata.Set("data_type", ComponentTypeToDataType(this->GetComponentType(), this->GetComponentSize(), 3));
+      metadata.Set("chunk_grid", chunkGrid);
+      metadata.Set("chunk_key_encoding", keyEncoding);
+      metadata.Set("fill_value", 0.0);
+      metadata.Set("codecs", codecs);
+      metadata.Set("dimension_names", dimensionNames);
+
+      const std::string directory = JoinPath(m_FileName, array.Path);
+      itksys::SystemTools::MakeDirectory(directory);
+      WriteTextFile(JoinPath(directory, "zarr.json"), metadata.Dump());
+    }
+  }
+  m_ImageInformationWritten = true;
+}
+
+unsigned int
+ZarrImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  m_ImageInformationWritten = false;
+  m_StoreRemoved = false;
+  if (pasteRegion == largestPossibleRegion)
+  {
+    // the whole image is written, the store is rewritten
+    if (itksys::SystemTools::FileIsDirectory(m_FileName))
+    {
+      this->RemoveStore();
+      m_StoreRemoved = true;
+    }
+    return this->GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
+  }
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+}
+
+void
+ZarrImageIO::Write(const void * buffer)
+{
+  this->WriteImageInformation();
+
+  const ImageIORegion &       region = this->GetIORegion();
+  const unsigned int          numberOfDimensions = this->GetNumberOfDimensions();
+  std::vector<IndexValueType> regionIndex(numberOfDimensions, 0);
+  std::vector<SizeValueType>  regionSize(numberOfDimensions, 1);
+  for (unsigned int d = 0; d < numberOfDimensions && d < region.GetImageDimension(); ++d)
+  {
+    regionIndex[d] = region.GetIndex(d);
+    regionSize[d] = region.GetSize(d);
+  }
+  const auto * in = static_cast<const char *>(buffer);
+  this->TransferRegion(m_Arrays[0], regionIndex, regionSize, const_cast<char *>(in), true);
+
+  std::vector<char> levelBuffer;
+  for (unsigned int level = 1; level < m_Arrays.size(); ++level)
+  {
+    const ImageIORegion levelRegion = ImageIOPyramidHelper::DecimateLevel(this, buffer, level, levelBuffer);
+    if (levelBuffer.empty())
+    {
+      continue;
+    }
+    this->TransferRegion(m_Arrays[level], levelRegion.GetIndex(), levelRegion.GetSize(), levelBuffer.data(), true);
+  }
+}
+
+ImageIOBase::SizeType
+ZarrImageIO::GetHeaderSize() const
+{
+  return 0;
+}
+
+std::string
+ZarrImageIO::GetChunkFileName(const ArrayInformation & array, const std::vector<SizeValueType> & chunkIndex) const
+{
+  std::string key = array.KeyPrefix;
+  for (unsigned int a = 0; a < chunkIndex.size(); ++a)
+  {
+    key += (a == 0 ? "" : array.KeySeparator) + std::to_string(chunkIndex[a]);
+  }
+  return JoinPath(JoinPath(m_FileName, array.Path), key);
+}
+
+void
+ZarrImageIO::DecodeChunk(const ArrayInformation & array, const std::string & fileName, std::vector<char> & chunk) const
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    // chunks which were never written hold the fill value
+    FillChunk(chunk, array.FillValue);
+    return;
+  }
+
+  if (array.Codec == "raw")
+  {
+    file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    if (file.gcount() != static_cast<std::streamsize>(chunk.size()))
+    {
+      itkExceptionMacro(<< "Chunk " << fileName << " is truncated");
+    }
+  }
+  else
+  {
+    const std::vector<char> encoded((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (encoded.size() > std::numeric_limits<uInt>::max() || chunk.size() > std::numeric_limits<uInt>::max())
+    {
+      itkExceptionMacro(<< "Chunk " << fileName << " is too large");
+    }
+
+    // zlib and gzip headers are both detected
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    {
+      itkExceptionMacro(<< "Cannot initialize the decompression of " << fileName);
+    }
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(encoded.data()));
+    stream.avail_in = static_cast<uInt>(encoded.size());
+    stream.next_out = reinterpret_cast<Bytef *>(chunk.data());
+    stream.avail_out = static_cast<uInt>(chunk.size());
+    const int   result = inflate(&stream, Z_FINISH);
+    const uLong decoded = stream.total_out;
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END || decoded != chunk.size())
+    {
+      itkExceptionMacro(<< "Cannot decompress chunk " << fileName);
+    }
+  }
+
+  if (array.SwapBytes)
+  {
+    const unsigned int componentSize = this->GetComponentSize();
+    for (auto it = chunk.begin(); it != chunk.end(); it += componentSize)
+    {
+      std::reverse(it, it + componentSize);
+    }
+  }
+}
+
+void
+ZarrImageIO::EncodeChunk(const ArrayInformation &  array,
+                         const std::string &       fileName,
+                         const std::vector<char> & chunk) const
+{
+  std::vector<char> swapped;
+  const char *      data = chunk.data();
+  if (array.SwapBytes)
+  {
+    const unsigned int componentSize = this->GetComponentSize();
+    swapped = chunk;
+    for (auto it = swapped.begin(); it != swapped.end(); it += componentSize)
+    {
+      std::reverse(it, it + componentSize);
+    }
+    data = swapped.data();
+  }
+
+  std::vector<char> encoded;
+  SizeValueType     encodedSize = chunk.size();
+  if (array.Codec != "raw")
+  {
+    if (chunk.size() > std::numeric_limits<uInt>::max())
+    {
+      itkExceptionMacro(<< "Chunk " << fileName << " is too large");
+    }
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    const int windowBits = array.Codec == "gzip" ? 15 + 16 : 15;
+    if (deflateInit2(&stream, array.CompressionLevel, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      itkExceptionMacro(<< "Cannot initialize the compression of " << fileName);
+    }
+    encoded.resize(deflateBound(&stream, static_cast<uLong>(chunk.size())) + 32);
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    stream.avail_in = static_cast<uInt>(chunk.size());
+    stream.next_out = reinterpret_cast<Bytef *>(encoded.data());
+    stream.avail_out = static_cast<uInt>(encoded.size());
+    const int result = deflate(&stream, Z_FINISH);
+    encodedSize = stream.total_out;
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END)
+    {
+      itkExceptionMacro(<< "Cannot compress chunk " << fileName);
+    }
+    data = encoded.data();
+  }
+
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    itkExceptionMacro(<< "Cannot write chunk " << fileName);
+  }
+  file.write(data, static_cast<std::streamsize>(encodedSize));
+  if (file.fail())
+  {
+    itkExceptionMacro(<< "Failed writing chunk " << fileName);
+  }
+}
+
+void
+ZarrImageIO::TransferRegion(const ArrayInformation &            array,
+                            const std::vector<IndexValueType> & regionIndex,
+                            const std::vector<SizeValueType> &  regionSize,
+                            char *                              buffer,
+                            bool                                write) const
+{
+  const auto          numberOfAxes = static_cast<unsigned int>(array.Shape.size());
+  const unsigned int  componentSize = this->GetComponentSize();
+  const SizeValueType numberOfComponents = this->GetNumberOfComponents();
+
+  // the region along the axes, and the strides of the axes in the buffer,
+  // counted in components
+  std::vector<SizeValueType> start(numberOfAxes);
+  std::vector<SizeValueType> size(numberOfAxes);
+  std::vector<SizeValueType> bufferStrides(numberOfAxes);
+  for (unsigned int a = 0; a < numberOfAxes; ++a)
+  {
+    const int d = array.AxisDimensions[a];
+    start[a] = d < 0 ? 0 : static_cast<SizeValueType>(regionIndex[d]);
+    size[a] = d < 0 ? numberOfComponents : regionSize[d];
+    if (size[a] == 0)
+    {
+      return;
+    }
+    if (start[a] + size[a] > array.Shape[a])
+    {
+      itkExceptionMacro(<< "The region is outside of the array " << array.Path << " of " << m_FileName);
+    }
+    bufferStrides[a] = d < 0 ? 1 : numberOfComponents;
+    for (int e = 0; e < d; ++e)
+    {
+      bufferStrides[a] *= regionSize[e];
+    }
+  }
+
+  // the strides of the axes in a chunk
+  std::vector<SizeValueType> chunkStrides(numberOfAxes);
+  SizeValueType              chunkElements = 1;
+  for (unsigned int a = numberOfAxes; a-- > 0;)
+  {
+    chunkStrides[a] = chunkElements;
+    chunkElements *= array.ChunkShape[a];
+  }
+
+  // the chunks intersecting the region
+  std::vector<std::vector<SizeValueType>> chunks;
+  std::vector<SizeValueType>              firstChunk(numberOfAxes);
+  std::vector<SizeValueType>              lastChunk(numberOfAxes);
+  for (unsigned int a = 0; a < numberOfAxes; ++a)
+  {
+    firstChunk[a] = start[a] / array.ChunkShape[a];
+    lastChunk[a] = (start[a] + size[a] - 1) / array.ChunkShape[a];
+  }
+  std::vector<SizeValueType> chunkIndex(firstChunk);
+  while (true)
+  {
+    chunks.push_back(chunkIndex);
+    unsigned int a = numberOfAxes;
+    while (a-- > 0)
+    {
+      if (++chunkIndex[a] <= lastChunk[a])
+      {
+        break;
+      }
+      chunkIndex[a] = firstChunk[a];
+    }
+    if (a > numberOfAxes)
+    {
+      break;
+    }
+  }
+
+  if (write)
+  {
+    // directories are created before the chunks are written in parallel
+    std::set<std::string> directories;
+    for (const auto & chunk : chunks)
+    {
+      directories.insert(itksys::SystemTools::GetFilenamePath(this->GetChunkFileName(array, chunk)));
+    }
+    for (const auto & directory : directories)
+    {
+      if (!itksys::SystemTools::MakeDirectory(directory))
+      {
+        itkExceptionMacro(<< "Unable to create the directory " << directory);
+      }
+    }
+  }
+
+  // copy the intersection of the region and a chunk, line by line along the
+  // last axis
+  const auto transferChunk = [&](const std::vector<SizeValueType> & chunk, std::vector<char> & chunkBuffer) {
+    std::vector<SizeValueType> begin(numberOfAxes);
+    std::vector<SizeValueType> end(numberOfAxes);
+    bool                       covered = true;
+    for (unsigned int a = 0; a < numberOfAxes; ++a)
+    {
+      const SizeValueType chunkBegin = chunk[a] * array.ChunkShape[a];
+      const SizeValueType chunkEnd = std::min(chunkBegin + array.ChunkShape[a], array.Shape[a]);
+      begin[a] = std::max(chunkBegin, start[a]);
+      end[a] = std::min(chunkEnd, start[a] + size[a]);
+      covered = covered && begin[a] == chunkBegin && end[a] == chunkEnd;
+    }
+
+    const std::string fileName = this->GetChunkFileName(array, chunk);
+    if (!write || !covered)
+    {
+      this->DecodeChunk(array, fileName, chunkBuffer);
+    }
+    else
+    {
+      FillChunk(chunkBuffer, array.FillValue);
+    }
+
+    const unsigned int         last = numberOfAxes - 1;
+    const SizeValueType        lineLength = end[last] - begin[last];
+    const bool                 contiguous = bufferStrides[last] == 1;
+    std::vector<SizeValueType> position(begin);
+    while (true)
+    {
+      SizeValueType bufferOffset = 0;
+      SizeValueType chunkOffset = 0;
+      for (unsigned int a = 0; a < numberOfAxes; ++a)
+      {
+        bufferOffset += (position[a] - start[a]) * bufferStrides[a];
+        chunkOffset += (position[a] - chunk[a] * array.ChunkShape[a]) * chunkStrides[a];
+      }
+      char * bufferLine = buffer + bufferOffset * componentSize;
+      char * chunkLine = chunkBuffer.data() + chunkOffset * componentSize;
+      if (contiguous)
+      {
+        if (write)
+        {
+          std::memcpy(chunkLine, bufferLine, lineLength * componentSize);
+        }
+        else
+        {
+          std::memcpy(bufferLine, chunkLine, lineLength * componentSize);
+        }
+      }
+      else
+      {
+        const SizeValueType bufferStep = bufferStrides[last] * componentSize;
+        for (SizeValueType i = 0; i < lineLength; ++i, bufferLine += bufferStep, chunkLine += componentSize)
+        {
+          if (write)
+          {
+            std::memcpy(chunkLine, bufferLine, componentSize);
+          }
+          else
+          {
+            std::memcpy(bufferLine, chunkLine, componentSize);
+          }
+        }
+      }
+
+      unsigned int a = last;
+      while (a-- > 0)
+      {
+        if (++position[a] < end[a])
+        {
+          break;
+        }
+        position[a] = begin[a];
+      }
+      if (a > numberOfAxes)
+      {
+        break;
+      }
+    }
+
+    if (write)
+    {
+      this->EncodeChunk(array, fileName, chunkBuffer);
+    }
+  };
+
+  // the chunks are distinct files, decoded or encoded in parallel
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  const SizeValueType        numberOfChunks = chunks.size();
+  const SizeValueType        numberOfWorkUnits =
+    std::min(numberOfChunks, static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()));
+
+  std::vector<std::exception_ptr> workUnitExceptions(numberOfWorkUnits);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](SizeValueType workUnit) {
+      try
+      {
+        std::vector<char>   chunkBuffer(chunkElements * componentSize);
+        const SizeValueType first = workUnit * numberOfChunks / numberOfWorkUnits;
+        const SizeValueType last = (workUnit + 1) * numberOfChunks / numberOfWorkUnits;
+        for (SizeValueType chunk = first; chunk < last; ++chunk)
+        {
+          transferChunk(chunks[chunk], chunkBuffer);
+        }
+      }
+      catch (...)
+      {
+        workUnitExceptions[workUnit] = std::current_exception();
+      }
+    },
+    nullptr);
+
+  for (const auto & workUnitException : workUnitExceptions)
+  {
+    if (workUnitException)
+    {
+      std::rethrow_exception(workUnitException);
+    }
+  }
+}
+} // end namespace itk
@@ -0,0 +1,515 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrJSON.h"
+#include "itkNumberToString.h"
+#include "itkMath.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace itk
+{
+namespace
+{
+class JSONParser
+{
+public:
+  explicit JSONParser(const std::string & text)
+    : m_Text(text)
+  {}
+
+  ZarrJSONValue
+  ParseDocument()
+  {
+    ZarrJSONValue value = this->ParseValue();
+    this->SkipWhitespace();
+    if (m_Position != m_Text.size())
+    {
+      this->Fail("unexpected characters after the document");
+    }
+    return value;
+  }
+
+private:
+  [[noreturn]] void
+  Fail(const char * reason) const
+  {
+    itkGenericExceptionMacro(<< "Invalid JSON at character " << m_Position << ": " << reason);
+  }
+
+  void
+  SkipWhitespace()
+  {
+    while (m_Position < m_Text.size() && (m_Text[m_Position] == ' ' || m_Text[m_Position] == '\t' ||
+                                          m_Text[m_Position] == '\n' || m_Text[m_Position] == '\r'))
+    {
+      ++m_Position;
+    }
+  }
+
+  char
+  Peek()
+  {
+    this->SkipWhitespace();
+    if (m_Position == m_Text.size())
+    {
+      this->Fail("unexpected end of the document");
+    }
+    return m_Text[m_Position];
+  }
+
+  void
+  Expect(char c)
+  {
+    if (this->Peek() != c)
+    {
+      this->Fail("unexpected character");
+    }
+    ++m_Position;
+  }
+
+  bool
+  Consume(const char * word)
+  {
+    const std::string::size_type length = std::char_traits<char>::length(word);
+    if (m_Text.compare(m_Position, length, word) == 0)
+    {
+      m_Position += length;
+      return true;
+    }
+    return false;
+  }
+
+  ZarrJSONValue
+  ParseValue()
+  {
+    const char c = this->Peek();
+    if (c == '{')
+    {
+      ++m_Position;
+      ZarrJSONValue object = ZarrJSONValue::MakeObject();
+      if (this->Peek() == '}')
+      {
+        ++m_Position;
+        return object;
+      }
+      while (true)
+      {
+        if (this->Peek() != '"')
+        {
+          this->Fail("expected the name of a member");
+        }
+        const std::string key = this->ParseString();
+        this->Expect(':');
+        object.Set(key, this->ParseValue());
+        if (this->Peek() == ',')
+        {
+          ++m_Position;
+          continue;
+        }
+        this->Expect('}');
+        return object;
+      }
+    }
+    if (c == '[')
+    {
+      ++m_Position;
+      ZarrJSONValue array = ZarrJSONValue::MakeArray();
+      if (this->Peek() == ']')
+      {
+        ++m_Position;
+        return array;
+      }
+      while (true)
+      {
+        array.Append(this->ParseValue());
+        if (this->Peek() == ',')
+        {
+          ++m_Position;
+          continue;
+        }
+        this->Expect(']');
+        return array;
+      }
+    }
+    if (c == '"')
+    {
+      return ZarrJSONValue(this->ParseString());
+    }
+    if (this->Consume("true"))
+    {
+      return ZarrJSONValue(true);
+    }
+    if (this->Consume("false"))
+    {
+      return ZarrJSONValue(false);
+    }
+    if (this->Consume("null"))
+    {
+      return ZarrJSONValue();
+    }
+    // Zarr uses these strings for the special floating point fill values
+    if (this->Consume("NaN"))
+    {
+      return ZarrJSONValue(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    const char * begin = m_Text.c_str() + m_Position;
+    char *       end = nullptr;
+    const double number = std::strtod(begin, &end);
+    if (end == begin)
+    {
+      this->Fail("unexpected character");
+    }
+    m_Position += static_cast<std::string::size_type>(end - begin);
+    return ZarrJSONValue(number);
+  }
+
+  std::string
+  ParseString()
+  {
+    ++m_Position;
+    std::string value;
+    while (true)
+    {
+      if (m_Position >= m_Text.size())
+      {
+        this->Fail("unterminated string");
+      }
+      const char c = m_Text[m_Position++];
+      if (c == '"')
+      {
+        return value;
+      }
+      if (c != '\\')
+      {
+        value += c;
+        continue;
+      }
+      if (m_Position >= m_Text.size())
+      {
+        this->Fail("unterminated string");
+      }
+      const char escaped = m_Text[m_Position++];
+      switch (escaped)
+      {
+        case 'b':
+          value += '\b';
+          break;
+        case 'f':
+          value += '\f';
+          break;
+        case 'n':
+          value += '\n';
+          break;
+        case 'r':
+          value += '\r';
+          break;
+        case 't':
+          value += '\t';
+          break;
+        case 'u':
+          this->AppendCodePoint(value, this->ParseCodePoint());
+          break;
+        default:
+          value += escaped;
+      }
+    }
+  }
+
+  unsigned long
+  ParseHex4()
+  {
+    if (m_Position + 4 > m_Text.size())
+    {
+      this->Fail("truncated unicode escape");
+    }
+    unsigned long code = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      const char    c = m_Text[m_Position++];
+      unsigned long digit;
+      if (c >= '0' && c <= '9')
+      {
+        digit = static_cast<unsigned long>(c - '0');
+      }
+      else if (c >= 'a' && c <= 'f')
+      {
+        digit = static_cast<unsigned long>(c - 'a' + 10);
+      }
+      else if (c >= 'A' && c <= 'F')
+      {
+        digit = static_cast<unsigned long>(c - 'A' + 10);
+      }
+      else
+      {
+        this->Fail("invalid unicode escape");
+      }
+      code = code * 16 + digit;
+    }
+    return code;
+  }
+
+  unsigned long
+  ParseCodePoint()
+  {
+    unsigned long code = this->ParseHex4();
+    if (code >= 0xD800 && code < 0xDC00 && this->Consume("\\u"))
+    {
+      const unsigned long low = this->ParseHex4();
+      code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return code;
+  }
+
+  static void
+  AppendCodePoint(std::string & value, unsigned long code)
+  {
+    if (code < 0x80)
+    {
+      value += static_cast<char>(code);
+    }
+    else if (code < 0x800)
+    {
+      value += static_cast<char>(0xC0 | (code >> 6));
+      value += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+      value += static_cast<char>(0xE0 | (code >> 12));
+      value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      value += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else
+    {
+      value += static_cast<char>(0xF0 | (code >> 18));
+      value += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+      value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      value += static_cast<char>(0x80 | (code & 0x3F));
+    }
+  }
+
+  const std::string &    m_Text;
+  std::string::size_type m_Position{ 0 };
+};
+
+void
+DumpString(std::string & out, const std::string & value)
+{
+  out += '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          static const char digits[] = "0123456789abcdef";
+          out += "\\u00";
+          out += digits[(c >> 4) & 0xF];
+          out += digits[c & 0xF];
+        }
+        else
+        {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+} // namespace
+
+ZarrJSONValue::ZarrJSONValue(bool value)
+  : m_Type(Type::Boolean)
+  , m_Boolean(value)
+{}
+
+ZarrJSONValue::ZarrJSONValue(double value)
+  : m_Type(Type::Number)
+  , m_Number(value)
+{}
+
+ZarrJSONValue::ZarrJSONValue(const std::string & value)
+  : m_Type(Type::String)
+  , m_String(value)
+{}
+
+ZarrJSONValue::ZarrJSONValue(const char * value)
+  : m_Type(Type::String)
+  , m_String(value)
+{}
+
+ZarrJSONValue
+ZarrJSONValue::MakeArray()
+{
+  ZarrJSONValue value;
+  value.m_Type = Type::Array;
+  return value;
+}
+
+ZarrJSONValue
+ZarrJSONValue::MakeObject()
+{
+  ZarrJSONValue value;
+  value.m_Type = Type::Object;
+  return value;
+}
+
+ZarrJSONValue
+ZarrJSONValue::Parse(const std::string & text)
+{
+  JSONParser parser(text);
+  return parser.ParseDocument();
+}
+
+ZarrJSONValue &
+ZarrJSONValue::Append(const ZarrJSONValue & value)
+{
+  m_Array.push_back(value);
+  return m_Array.back();
+}
+
+ZarrJSONValue &
+ZarrJSONValue::Set(const std::string & key, const ZarrJSONValue & value)
+{
+  for (auto & member : m_Object)
+  {
+    if (member.first == key)
+    {
+      member.second = value;
+      return member.second;
+    }
+  }
+  m_Object.emplace_back(key, value);
+  return m_Object.back().second;
+}
+
+const ZarrJSONValue *
+ZarrJSONValue::Find(const std::string & key) const
+{
+  for (const auto & member : m_Object)
+  {
+    if (member.first == key)
+    {
+      return &member.second;
+    }
+  }
+  return nullptr;
+}
+
+std::string
+ZarrJSONValue::Dump() const
+{
+  std::string out;
+  this->Dump(out, 0);
+  out += '\n';
+  return out;
+}
+
+void
+ZarrJSONValue::Dump(std::string & out, unsigned int indent) const
+{
+  switch (m_Type)
+  {
+    case Type::Null:
+      out += "null";
+      break;
+    case Type::Boolean:
+      out += m_Boolean ? "true" : "false";
+      break;
+    case Type::Number:
+      if (Math::isnan(m_Number))
+      {
+        out += "\"NaN\"";
+      }
+      else if (std::abs(m_Number) < 9007199254740992.0 && m_Number == std::floor(m_Number))
+      {
+        out += std::to_string(static_cast<long long>(m_Number));
+      }
+      else
+      {
+        out += NumberToString<double>()(m_Number);
+      }
+      break;
+    case Type::String:
+      DumpString(out, m_String);
+      break;
+    case Type::Array:
+    {
+      // arrays of numbers, such as shapes, are kept on one line
+      bool numbers = true;
+      for (const auto & element : m_Array)
+      {
+        numbers = numbers && element.IsNumber();
+      }
+      out += '[';
+      for (ArrayType::size_type i = 0; i < m_Array.size(); ++i)
+      {
+        out += i == 0 ? "" : ",";
+        if (numbers)
+        {
+          out += i == 0 ? "" : " ";
+        }
+        else
+        {
+          out += '\n' + std::string(2 * (indent + 1), ' ');
+        }
+        m_Array[i].Dump(out, indent + 1);
+      }
+      if (!numbers && !m_Array.empty())
+      {
+        out += '\n' + std::string(2 * indent, ' ');
+      }
+      out += ']';
+      break;
+    }
+    case Type::Object:
+      out += '{';
+      for (ObjectType::size_type i = 0; i < m_Object.size(); ++i)
+      {
+        out += i == 0 ? "\n" : ",\n";
+        out += std::string(2 * (indent + 1), ' ');
+        DumpString(out, m_Object[i].first);
+        out += ": ";
+        m_Object[i].second.Dump(out, indent + 1);
+      }
+      if (!m_Object.empty())
+      {
+        out += '\n' + std::string(2 * indent, ' ');
+      }
+      out += '}';
+      break;
+  }
+}
+} // end namespace itk
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrJSON_h
+#define itkZarrJSON_h
+
+#include "itkMacro.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class ZarrJSONValue
+ * \brief Minimal JSON document used for the metadata of Zarr stores.
+ *
+ * Only what ZarrImageIO needs is provided: parsing a document, building one
+ * and writing it back. The members of objects keep their order.
+ *
+ * \ingroup ITKIOZarr
+ */
+class ZarrJSONValue
+{
+public:
+  enum class Type
+  {
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  using ArrayType = std::vector<ZarrJSONValue>;
+  using ObjectType = std::vector<std::pair<std::string, ZarrJSONValue>>;
+
+  ZarrJSONValue() = default;
+  ZarrJSONValue(bool value);
+  ZarrJSONValue(double value);
+  ZarrJSONValue(const std::string & value);
+  ZarrJSONValue(const char * value);
+
+  static ZarrJSONValue
+  MakeArray();
+
+  static ZarrJSONValue
+  MakeObject();
+
+  /** Parse a document. An exception is thrown on syntax errors. */
+  static ZarrJSONValue
+  Parse(const std::string & text);
+
+  /** Write the value, indented by two spaces per level. */
+  std::string
+  Dump() const;
+
+  Type
+  GetType() const
+  {
+    return m_Type;
+  }
+
+  bool
+  IsNumber() const
+  {
+    return m_Type == Type::Number;
+  }
+
+  bool
+  IsString() const
+  {
+    return m_Type == Type::String;
+  }
+
+  bool
+  IsArray() const
+  {
+    return m_Type == Type::Array;
+  }
+
+  bool
+  IsObject() const
+  {
+    return m_Type == Type::Object;
+  }
+
+  bool
+  GetBoolean() const
+  {
+    return m_Boolean;
+  }
+
+  double
+  GetNumber() const
+  {
+    return m_Number;
+  }
+
+  const std::string &
+  GetString() const
+  {
+    return m_String;
+  }
+
+  const ArrayType &
+  GetArray() const
+  {
+    return m_Array;
+  }
+
+  const ObjectType &
+  GetObject() const
+  {
+    return m_Object;
+  }
+
+  /** Append an element to an array. */
+  ZarrJSONValue &
+  Append(const ZarrJSONValue & value);
+
+  /** Set a member of an object, replacing an existing member of that name. */
+  ZarrJSONValue &
+  Set(const std::string & key, const ZarrJSONValue & value);
+
+  /** Get a member of an object, or nullptr if there is none, or if this is
+   * not an object. */
+  const ZarrJSONValue *
+  Find(const std::string & key) const;
+
+private:
+  void
+  Dump(std::string & out, unsigned int indent) const;
+
+  Type        m_Type{ Type::Null };
+  bool        m_Boolean{ false };
+  double      m_Number{ 0.0 };
+  std::string m_String;
+  ArrayType   m_Array;
+  ObjectType  m_Object;
+};
+} // end namespace itk
+
+#endif
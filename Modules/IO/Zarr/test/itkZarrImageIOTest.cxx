@@ -0,0 +1,450 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkZarrImageIO.h"
+#include "itkZarrImageIOFactory.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+
+// Write images as Zarr stores of both versions, with and without
+// compression, by streamed regions and with a pyramid, then read them back
+// entirely, by regions, and level by level, and paste a region into them.
+// Rewrite a store, which keeps the files which are not chunks, and read the
+// fill value of missing chunks.
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using ReaderType = itk::ImageFileReader<ImageType>;
+using WriterType = itk::ImageFileWriter<ImageType>;
+
+short
+PixelValue(const ImageType::IndexType & index)
+{
+  return static_cast<short>(index[2] * 1000 + index[1] * 37 + index[0] - 500);
+}
+
+// Check the pixels of a region, which are those of the full resolution image
+// at the indices multiplied by the factor, unless they are in the pasted
+// region, where they are negated.
+bool
+CheckImage(const ImageType *             image,
+           const ImageType::RegionType & region,
+           itk::IndexValueType           factor,
+           const ImageType::RegionType & pasted)
+{
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    ImageType::IndexType index = it.GetIndex();
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      index[d] *= factor;
+    }
+    const short expected = pasted.IsInside(index) ? static_cast<short>(-PixelValue(index)) : PixelValue(index);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Pixel mismatch at " << it.GetIndex() << " with factor " << factor << ": expected " << expected
+                << ", got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int
+TestScalarStore(const std::string & fileName, unsigned int zarrFormat, bool useCompression)
+{
+  std::cout << "Testing " << fileName << std::endl;
+
+  ImageType::SizeType size;
+  size[0] = 45;
+  size[1] = 38;
+  size[2] = 21;
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.75;
+  spacing[2] = 2.0;
+  ImageType::PointType origin;
+  origin[0] = -10.0;
+  origin[1] = 3.5;
+  origin[2] = 100.0;
+  ImageType::DirectionType direction;
+  direction.Fill(0.0);
+  direction[0][1] = 1.0;
+  direction[1][0] = -1.0;
+  direction[2][2] = 1.0;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetDirection(direction);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(PixelValue(it.GetIndex()));
+  }
+
+  // the streamed regions are not aligned with the chunks
+  auto writerIO = itk::ZarrImageIO::New();
+  writerIO->SetZarrFormat(zarrFormat);
+  writerIO->SetChunkSize({ 16, 16, 8 });
+  writerIO->SetNumberOfPyramidLevels(3);
+  writerIO->SetImageName("test");
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(useCompression);
+  writer->SetNumberOfStreamDivisions(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  const std::string metadataFile = fileName + (zarrFormat == 3 ? "/zarr.json" : "/.zattrs");
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(metadataFile, true));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + (zarrFormat == 3 ? "/2/c/0/0/0" : "/2/0/0/0"), true));
+
+  // full resolution, with the ImageIO found by the factory
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  auto * readerIO = dynamic_cast<itk::ZarrImageIO *>(reader->GetImageIO());
+  ITK_TEST_EXPECT_TRUE(readerIO != nullptr);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetZarrFormat(), zarrFormat);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetNumberOfPyramidLevels(), 3u);
+  const ImageType * readImage = reader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(readImage->GetLargestPossibleRegion().GetSize(), size);
+  ITK_TEST_EXPECT_EQUAL(readImage->GetSpacing(), spacing);
+  ITK_TEST_EXPECT_EQUAL(readImage->GetOrigin(), origin);
+  ITK_TEST_EXPECT_EQUAL(readImage->GetDirection(), direction);
+  const ImageType::RegionType nothingPasted;
+  if (!CheckImage(readImage, readImage->GetLargestPossibleRegion(), 1, nothingPasted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // a streamed region crossing several chunks
+  ImageType::RegionType region;
+  region.SetIndex(0, 5);
+  region.SetIndex(1, 13);
+  region.SetIndex(2, 7);
+  region.SetSize(0, 30);
+  region.SetSize(1, 11);
+  region.SetSize(2, 9);
+  auto streamingReader = ReaderType::New();
+  streamingReader->SetImageIO(itk::ZarrImageIO::New());
+  streamingReader->SetFileName(fileName);
+  streamingReader->SetUseStreaming(true);
+  streamingReader->UpdateOutputInformation();
+  streamingReader->GetOutput()->SetRequestedRegion(region);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+  ITK_TEST_EXPECT_EQUAL(streamingReader->GetOutput()->GetBufferedRegion(), region);
+  if (!CheckImage(streamingReader->GetOutput(), region, 1, nothingPasted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the levels of the pyramid
+  for (unsigned int level = 1; level < 3; ++level)
+  {
+    const itk::IndexValueType factor = itk::IndexValueType{ 1 } << level;
+
+    auto levelIO = itk::ZarrImageIO::New();
+    levelIO->SetPyramidLevel(level);
+    auto levelReader = ReaderType::New();
+    levelReader->SetImageIO(levelIO);
+    levelReader->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(levelReader->Update());
+
+    const ImageType * levelImage = levelReader->GetOutput();
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      ITK_TEST_EXPECT_EQUAL(levelImage->GetLargestPossibleRegion().GetSize(d),
+                            (size[d] + factor - 1) / static_cast<itk::SizeValueType>(factor));
+      ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(levelImage->GetSpacing()[d], spacing[d] * factor));
+    }
+    ITK_TEST_EXPECT_EQUAL(levelImage->GetOrigin(), origin);
+    if (!CheckImage(levelImage, levelImage->GetLargestPossibleRegion(), factor, nothingPasted))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a level which does not exist
+  auto missingLevelIO = itk::ZarrImageIO::New();
+  missingLevelIO->SetPyramidLevel(3);
+  missingLevelIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_EXCEPTION(missingLevelIO->ReadImageInformation());
+
+  // paste a region, which updates the chunks it partially covers
+  ImageType::RegionType pasted;
+  pasted.SetIndex(0, 10);
+  pasted.SetIndex(1, 3);
+  pasted.SetIndex(2, 4);
+  pasted.SetSize(0, 20);
+  pasted.SetSize(1, 25);
+  pasted.SetSize(2, 6);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, pasted); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(-it.Get()));
+  }
+  image->Modified();
+  itk::ImageIORegion ioRegion(3);
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    ioRegion.SetIndex(d, pasted.GetIndex(d));
+    ioRegion.SetSize(d, pasted.GetSize(d));
+  }
+  auto pasteIO = itk::ZarrImageIO::New();
+  pasteIO->SetZarrFormat(zarrFormat);
+  pasteIO->SetChunkSize({ 16, 16, 8 });
+  pasteIO->SetNumberOfPyramidLevels(3);
+  writer->SetImageIO(pasteIO);
+  writer->SetIORegion(ioRegion);
+  writer->SetNumberOfStreamDivisions(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto pastedReader = ReaderType::New();
+  pastedReader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(pastedReader->Update());
+  if (!CheckImage(pastedReader->GetOutput(), pastedReader->GetOutput()->GetLargestPossibleRegion(), 1, pasted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  auto pastedLevelIO = itk::ZarrImageIO::New();
+  pastedLevelIO->SetPyramidLevel(1);
+  pastedReader = ReaderType::New();
+  pastedReader->SetImageIO(pastedLevelIO);
+  pastedReader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(pastedReader->Update());
+  if (!CheckImage(pastedReader->GetOutput(), pastedReader->GetOutput()->GetLargestPossibleRegion(), 2, pasted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int
+TestRGBStore(const std::string & fileName, unsigned int zarrFormat)
+{
+  std::cout << "Testing " << fileName << std::endl;
+
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 2>;
+  RGBImageType::SizeType size;
+  size[0] = 70;
+  size[1] = 33;
+  auto image = RGBImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<RGBImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    RGBImageType::PixelType pixel;
+    pixel[0] = static_cast<unsigned char>(it.GetIndex()[0]);
+    pixel[1] = static_cast<unsigned char>(it.GetIndex()[1]);
+    pixel[2] = static_cast<unsigned char>(it.GetIndex()[0] + it.GetIndex()[1]);
+    it.Set(pixel);
+  }
+
+  auto writerIO = itk::ZarrImageIO::New();
+  writerIO->SetZarrFormat(zarrFormat);
+  writerIO->SetChunkSize({ 32, 16 });
+  auto writer = itk::ImageFileWriter<RGBImageType>::New();
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetFileName(fileName);
+  writer->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto reader = itk::ImageFileReader<RGBImageType>::New();
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(reader->GetImageIO()->GetPixelType(), itk::IOPixelEnum::RGB);
+  ITK_TEST_EXPECT_EQUAL(reader->GetImageIO()->GetNumberOfComponents(), 3u);
+
+  itk::ImageRegionConstIteratorWithIndex<RGBImageType> it(reader->GetOutput(),
+                                                          reader->GetOutput()->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != image->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Pixel mismatch at " << it.GetIndex() << ": expected " << image->GetPixel(it.GetIndex())
+                << ", got " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int
+TestOverwriteAndFillValue(const std::string & fileName, unsigned int zarrFormat)
+{
+  std::cout << "Testing " << fileName << std::endl;
+  itksys::SystemTools::RemoveADirectory(fileName);
+
+  ImageType::SizeType size;
+  size[0] = 20;
+  size[1] = 10;
+  size[2] = 3;
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(PixelValue(it.GetIndex()));
+  }
+
+  auto writerIO = itk::ZarrImageIO::New();
+  writerIO->SetZarrFormat(zarrFormat);
+  writerIO->SetChunkSize({ 8, 8, 1 });
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // rewriting a smaller image removes the chunks of the store, but not the
+  // other files of its directories
+  const std::string chunkPrefix = fileName + (zarrFormat == 3 ? "/0/c/" : "/0/");
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(chunkPrefix + "0/0/2", true));
+  const std::string otherFiles[] = { fileName + "/notes.txt", fileName + "/0/notes.txt" };
+  for (const auto & otherFile : otherFiles)
+  {
+    std::ofstream(otherFile.c_str()) << "not a chunk";
+  }
+  ImageType::RegionType smaller = image->GetLargestPossibleRegion();
+  smaller.SetSize(0, 12);
+  auto smallerImage = ImageType::New();
+  smallerImage->SetRegions(smaller);
+  smallerImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(smallerImage, smaller); !it.IsAtEnd(); ++it)
+  {
+    it.Set(image->GetPixel(it.GetIndex()));
+  }
+  writer->SetInput(smallerImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(!itksys::SystemTools::FileExists(chunkPrefix + "0/0/2", true));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(chunkPrefix + "0/0/1", true));
+  for (const auto & otherFile : otherFiles)
+  {
+    ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(otherFile, true));
+  }
+
+  // the chunks which are missing hold the fill value of the metadata
+  const std::string arrayMetadataFile = fileName + (zarrFormat == 3 ? "/0/zarr.json" : "/0/.zarray");
+  std::ifstream     metadataStream(arrayMetadataFile.c_str());
+  std::string       metadata((std::istreambuf_iterator<char>(metadataStream)), std::istreambuf_iterator<char>());
+  metadataStream.close();
+  const std::string::size_type fillValuePosition = metadata.find("\"fill_value\": 0");
+  ITK_TEST_EXPECT_TRUE(fillValuePosition != std::string::npos);
+  metadata.replace(fillValuePosition, 15, "\"fill_value\": 7");
+  std::ofstream(arrayMetadataFile.c_str()) << metadata;
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::RemoveFile(chunkPrefix + "0/0/0"));
+
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(reader->GetOutput(), smaller); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const short                expected = index[0] < 8 && index[1] < 8 && index[2] == 0 ? 7 : PixelValue(index);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Pixel mismatch at " << index << ": expected " << expected << ", got " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a directory which is not a store is not overwritten
+  const std::string notAStore = fileName.substr(0, fileName.size() - 5) + "_not_a_store.zarr";
+  itksys::SystemTools::RemoveADirectory(notAStore);
+  itksys::SystemTools::MakeDirectory(notAStore);
+  std::ofstream((notAStore + "/data.txt").c_str()) << "not a store";
+  writer->SetFileName(notAStore);
+  ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(notAStore + "/data.txt", true));
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkZarrImageIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  itk::ZarrImageIOFactory::RegisterOneFactory();
+
+  auto imageIO = itk::ZarrImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(imageIO, ZarrImageIO, StreamingImageIOBase);
+
+  ITK_TEST_SET_GET_VALUE(2u, imageIO->GetZarrFormat());
+  imageIO->SetZarrFormat(3);
+  ITK_TEST_SET_GET_VALUE(3u, imageIO->GetZarrFormat());
+  imageIO->SetNumberOfPyramidLevels(4);
+  ITK_TEST_SET_GET_VALUE(4u, imageIO->GetNumberOfPyramidLevels());
+  const std::vector<itk::SizeValueType> chunkSize{ 32, 32, 1 };
+  imageIO->SetChunkSize(chunkSize);
+  ITK_TEST_EXPECT_TRUE(imageIO->GetChunkSize() == chunkSize);
+  ITK_TEST_EXPECT_TRUE(imageIO->CanWriteFile("image.zarr"));
+  ITK_TEST_EXPECT_TRUE(imageIO->CanWriteFile("image.ome.zarr"));
+  ITK_TEST_EXPECT_TRUE(!imageIO->CanWriteFile("image.mha"));
+  ITK_TEST_EXPECT_TRUE(!imageIO->CanReadFile(outputDirectory.c_str()));
+
+  int status = EXIT_SUCCESS;
+  for (unsigned int zarrFormat = 2; zarrFormat <= 3; ++zarrFormat)
+  {
+    for (const bool useCompression : { false, true })
+    {
+      const std::string fileName = outputDirectory + "/itkZarrImageIOTest_v" + std::to_string(zarrFormat) +
+                                   (useCompression ? "_compressed" : "") + ".zarr";
+      if (TestScalarStore(fileName, zarrFormat, useCompression) != EXIT_SUCCESS)
+      {
+        status = EXIT_FAILURE;
+      }
+    }
+    const std::string fileName = outputDirectory + "/itkZarrImageIOTest_rgb_v" + std::to_string(zarrFormat) + ".zarr";
+    if (TestRGBStore(fileName, zarrFormat) != EXIT_SUCCESS)
+    {
+      status = EXIT_FAILURE;
+    }
+    const std::string overwrittenFileName =
+      outputDirectory + "/itkZarrImageIOTest_overwrite_v" + std::to_string(zarrFormat) + ".zarr";
+    if (TestOverwriteAndFillValue(overwrittenFileName, zarrFormat) != EXIT_SUCCESS)
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
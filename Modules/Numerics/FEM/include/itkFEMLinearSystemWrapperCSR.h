@@ -0,0 +1,339 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFEMLinearSystemWrapperCSR_h
+#define itkFEMLinearSystemWrapperCSR_h
+
+#include "itkFEMLinearSystemWrapper.h"
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ITKFEMExport.h"
+
+namespace itk
+{
+namespace fem
+{
+/**
+ * \class LinearSystemWrapperCSR
+ * \brief LinearSystemWrapper class storing the matrices in compressed sparse
+ *        row (CSR) form, and solving the system with a multithreaded
+ *        preconditioned conjugate gradient method.
+ *
+ * While the system is assembled, each row of a matrix is kept as a vector of
+ * (column, value) pairs sorted by column. Before the matrix is multiplied or
+ * the system is solved, the rows are compressed into the three arrays of the
+ * CSR format: the offsets of the rows, the columns and the values of the
+ * entries. Changing the value of an existing entry of a compressed matrix,
+ * as applying the boundary conditions does, does not expand it again.
+ *
+ * Solve() runs a conjugate gradient method with a Jacobi (diagonal)
+ * preconditioner, in which the matrix-vector products, the dot products and
+ * the vector updates are done in parallel with the MultiThreaderBase. The
+ * conjugate gradient method requires the matrix to be symmetric and positive
+ * definite, which is the case of the stiffness matrices once the essential
+ * boundary conditions are applied. The systems of equations containing
+ * multi freedom constraints, which the Lagrange multipliers make
+ * indefinite, should be solved with another wrapper.
+ *
+ * \sa LinearSystemWrapper
+ * \ingroup ITKFEM
+ */
+class ITKFEM_EXPORT LinearSystemWrapperCSR : public LinearSystemWrapper
+{
+public:
+  /** Standard "Self" type alias. */
+  using Self = LinearSystemWrapperCSR;
+
+  /** Standard "Superclass" type alias. */
+  using Superclass = LinearSystemWrapper;
+
+  /** values stored in matrices & vectors */
+  using Float = LinearSystemWrapper::Float;
+
+  /** vector representation type alias */
+  using VectorRepresentation = std::vector<Float>;
+
+  /** Sparse matrix stored in compressed sparse row form. */
+  class ITKFEM_EXPORT CSRMatrix
+  {
+  public:
+    /** Type of a row which is being assembled. */
+    using RowType = std::vector<std::pair<unsigned int, Float>>;
+
+    explicit CSRMatrix(unsigned int order);
+
+    unsigned int
+    GetOrder() const
+    {
+      return static_cast<unsigned int>(m_RowOffsets.size()) - 1;
+    }
+
+    bool
+    IsCompressed() const
+    {
+      return m_Compressed;
+    }
+
+    /** Returns the value of an entry, zero if the entry is not stored. */
+    Float
+    GetValue(unsigned int i, unsigned int j) const;
+
+    /** Sets the value of an entry. A zero value is not stored unless the
+     * entry already exists. */
+    void
+    SetValue(unsigned int i, unsigned int j, Float value);
+
+    /** Adds to the value of an entry. */
+    void
+    AddValue(unsigned int i, unsigned int j, Float value);
+
+    /** Converts the rows into the CSR arrays. */
+    void
+    Compress();
+
+    /** Converts the CSR arrays back into rows, so that entries can be added. */
+    void
+    Expand();
+
+    /** Returns the number of entries stored. */
+    size_t
+    GetNumberOfNonZeros() const;
+
+    /** CSR arrays, valid once the matrix is compressed. */
+    const std::vector<size_t> &
+    GetRowOffsets() const
+    {
+      return m_RowOffsets;
+    }
+    const std::vector<unsigned int> &
+    GetColumns() const
+    {
+      return m_Columns;
+    }
+    std::vector<Float> &
+    GetValues()
+    {
+      return m_Values;
+    }
+    const std::vector<Float> &
+    GetValues() const
+    {
+      return m_Values;
+    }
+
+    /** Columns of the entries stored in a row. */
+    void
+    GetColumnsInRow(unsigned int i, ColumnArray & cols) const;
+
+    /** Computes result = this * x in parallel. The matrix must be compressed. */
+    void
+    Multiply(const VectorRepresentation & x, VectorRepresentation & result) const;
+
+  private:
+    /** Returns a pointer to the value of an entry, or nullptr. */
+    const Float *
+    FindValue(unsigned int i, unsigned int j) const;
+    Float *
+    FindValue(unsigned int i, unsigned int j);
+
+    std::vector<RowType>      m_Rows;
+    std::vector<size_t>       m_RowOffsets;
+    std::vector<unsigned int> m_Columns;
+    std::vector<Float>        m_Values;
+    bool                      m_Compressed{ false };
+  };
+
+  /** matrix representation type alias */
+  using MatrixRepresentation = CSRMatrix;
+
+  LinearSystemWrapperCSR() = default;
+  ~LinearSystemWrapperCSR() override;
+
+  /** Set/Get the maximum number of iterations of the conjugate gradient
+   * method. If zero, which is the default, the order of the system is used. */
+  void
+  SetMaximumNumberOfIterations(unsigned int i)
+  {
+    m_MaximumNumberOfIterations = i;
+  }
+  unsigned int
+  GetMaximumNumberOfIterations() const
+  {
+    return m_MaximumNumberOfIterations;
+  }
+
+  /** Set/Get the tolerance on the norm of the residual relative to the norm
+   * of the right-hand side, at which the iterations stop. Default is 1e-10. */
+  void
+  SetTolerance(Float tolerance)
+  {
+    m_Tolerance = tolerance;
+  }
+  Float
+  GetTolerance() const
+  {
+    return m_Tolerance;
+  }
+
+  /** Get the number of iterations performed by the last call to Solve(). */
+  unsigned int
+  GetNumberOfIterationsPerformed() const
+  {
+    return m_NumberOfIterationsPerformed;
+  }
+
+  /** Get the relative norm of the residual after the last call to Solve(). */
+  Float
+  GetRelativeResidual() const
+  {
+    return m_RelativeResidual;
+  }
+
+  /** Get the matrix representation, e.g. to read its CSR arrays. */
+  const MatrixRepresentation *
+  GetMatrix(unsigned int matrixIndex = 0) const;
+
+  /* memory management routines */
+  void
+  InitializeMatrix(unsigned int matrixIndex) override;
+
+  bool
+  IsMatrixInitialized(unsigned int matrixIndex) override;
+
+  void
+  DestroyMatrix(unsigned int matrixIndex) override;
+
+  void
+  InitializeVector(unsigned int vectorIndex) override;
+
+  bool
+  IsVectorInitialized(unsigned int vectorIndex) override;
+
+  void
+  DestroyVector(unsigned int vectorIndex) override;
+
+  void
+  InitializeSolution(unsigned int solutionIndex) override;
+
+  bool
+  IsSolutionInitialized(unsigned int solutionIndex) override;
+
+  void
+  DestroySolution(unsigned int solutionIndex) override;
+
+  /* assembly & solving routines */
+  Float
+  GetMatrixValue(unsigned int i, unsigned int j, unsigned int matrixIndex) const override
+  {
+    return m_Matrices[matrixIndex]->GetValue(i, j);
+  }
+  void
+  SetMatrixValue(unsigned int i, unsigned int j, Float value, unsigned int matrixIndex) override
+  {
+    m_Matrices[matrixIndex]->SetValue(i, j, value);
+  }
+  void
+  AddMatrixValue(unsigned int i, unsigned int j, Float value, unsigned int matrixIndex) override
+  {
+    m_Matrices[matrixIndex]->AddValue(i, j, value);
+  }
+  void
+  GetColumnsOfNonZeroMatrixElementsInRow(unsigned int row, ColumnArray & cols, unsigned int matrixIndex) override
+  {
+    m_Matrices[matrixIndex]->GetColumnsInRow(row, cols);
+  }
+  Float
+  GetVectorValue(unsigned int i, unsigned int vectorIndex) const override
+  {
+    return (*m_Vectors[vectorIndex])[i];
+  }
+  void
+  SetVectorValue(unsigned int i, Float value, unsigned int vectorIndex) override
+  {
+    (*m_Vectors[vectorIndex])[i] = value;
+  }
+  void
+  AddVectorValue(unsigned int i, Float value, unsigned int vectorIndex) override
+  {
+    (*m_Vectors[vectorIndex])[i] += value;
+  }
+  Float
+  GetSolutionValue(unsigned int i, unsigned int solutionIndex) const override;
+
+  void
+  SetSolutionValue(unsigned int i, Float value, unsigned int solutionIndex) override
+  {
+    (*m_Solutions[solutionIndex])[i] = value;
+  }
+  void
+  AddSolutionValue(unsigned int i, Float value, unsigned int solutionIndex) override
+  {
+    (*m_Solutions[solutionIndex])[i] += value;
+  }
+  void
+  Solve() override;
+
+  /* matrix & vector manipulation routines */
+  void
+  ScaleMatrix(Float scale, unsigned int matrixIndex) override;
+
+  void
+  SwapMatrices(unsigned int matrixIndex1, unsigned int matrixIndex2) override;
+
+  void
+  SwapVectors(unsigned int vectorIndex1, unsigned int vectorIndex2) override;
+
+  void
+  SwapSolutions(unsigned int solutionIndex1, unsigned int solutionIndex2) override;
+
+  void
+  CopySolution2Vector(unsigned int solutionIndex, unsigned int vectorIndex) override;
+
+  void
+  CopyVector2Solution(unsigned int vectorIndex, unsigned int solutionIndex) override;
+
+  void
+  MultiplyMatrixMatrix(unsigned int resultMatrixIndex,
+                       unsigned int leftMatrixIndex,
+                       unsigned int rightMatrixIndex) override;
+
+  void
+  MultiplyMatrixVector(unsigned int resultVectorIndex, unsigned int matrixIndex, unsigned int vectorIndex) override;
+
+  void
+  MultiplyMatrixSolution(unsigned int resultVectorIndex, unsigned int matrixIndex, unsigned int solutionIndex) override;
+
+private:
+  /** Allocates the holders of the matrices, vectors and solutions. */
+  void
+  AllocateHolders();
+
+  std::vector<std::unique_ptr<MatrixRepresentation>> m_Matrices;
+  std::vector<std::unique_ptr<VectorRepresentation>> m_Vectors;
+  std::vector<std::unique_ptr<VectorRepresentation>> m_Solutions;
+
+  unsigned int m_MaximumNumberOfIterations{ 0 };
+  Float        m_Tolerance{ 1e-10 };
+  unsigned int m_NumberOfIterationsPerformed{ 0 };
+  Float        m_RelativeResidual{ 0.0 };
+};
+} // end namespace fem
+} // end namespace itk
+
+#endif // itkFEMLinearSystemWrapperCSR_h
@@ -25,6 +25,7 @@
  */
 
 #include "itkFEMLinearSystemWrapper.h"
+#include "itkFEMLinearSystemWrapperCSR.h"
 #include "itkFEMLinearSystemWrapperItpack.h"
 #include "itkFEMLinearSystemWrapperVNL.h"
 #include "itkFEMLinearSystemWrapperDenseVNL.h"
@@ -131,6 +131,22 @@ public:
   itkSetMacro(Direction, InterpolationGridDirectionType);
   itkGetMacro(Direction, InterpolationGridDirectionType);
 
+  /**
+   * Set/Get whether the element matrices are computed in parallel during
+   * the assembly of the master matrices. The elements are processed in
+   * blocks: the matrices of the elements of a block are computed by the
+   * threads of the multithreader, and are then added to the master matrices
+   * in the order of the elements, so that the result does not depend on the
+   * number of threads. Default is off.
+   *
+   * \note A derived solver which only overrides AssembleElementMatrix(),
+   *       and not ComputeElementMatrices() and AddElementMatrices(), must
+   *       keep this option off.
+   */
+  itkSetMacro(ParallelAssembly, bool);
+  itkGetConstMacro(ParallelAssembly, bool);
+  itkBooleanMacro(ParallelAssembly);
+
   /** Returns the time step used for dynamic problems. */
   virtual Float
   GetTimeStep() const;
@@ -342,10 +358,33 @@ protected:
    * master stiffness matrix. Since more complex Solver classes may need to
    * assemble many matrices and may also do some funky stuff to them, this
    * function is and can be overriden in a derived solver class.
+   *
+   * The default implementation calls ComputeElementMatrices() and
+   * AddElementMatrices().
    */
   virtual void
   AssembleElementMatrix(Element::Pointer e);
 
+  /** Array of the element matrices which are assembled for an element. */
+  using ElementMatrixArrayType = std::vector<Element::MatrixType>;
+
+  /**
+   * Compute the matrices of an element which are assembled into the master
+   * matrices. The default implementation computes the stiffness matrix.
+   * When ParallelAssembly is on, this function is called concurrently for
+   * different elements, so that it must not modify the solver.
+   */
+  virtual void
+  ComputeElementMatrices(const Element * e, ElementMatrixArrayType & matrices) const;
+
+  /**
+   * Add the matrices computed by ComputeElementMatrices() into the master
+   * matrices. The default implementation adds the stiffness matrix to the
+   * master stiffness matrix.
+   */
+  virtual void
+  AddElementMatrices(const Element * e, const ElementMatrixArrayType & matrices);
+
   /**
    * Add the contribution of the landmark-containing elements to the
    * correct position in the master stiffness matrix. Since more
@@ -434,6 +473,9 @@ protected:
   FEMObjectPointer m_FEMObject;
 
 private:
+  /** Compute the element matrices in parallel during the assembly. */
+  bool m_ParallelAssembly{ false };
+
   /** Properties of the interpolation grid. */
   InterpolationGridRegionType    m_Region;
   InterpolationGridPointType     m_Origin;
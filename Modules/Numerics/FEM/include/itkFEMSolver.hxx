@@ -28,6 +28,7 @@
 #include "itkFEMLoadLandmark.h"
 #include "itkTimeProbe.h"
 #include "itkImageRegionIterator.h"
+#include "itkMultiThreaderBase.h"
 
 #include <algorithm>
 #include "itkMath.h"
@@ -169,6 +170,7 @@ Solver<VDimension>::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Global degrees of freedom: " << m_NGFN << std::endl;
   os << indent << "Multi freedom constraints: " << m_NMFC << std::endl;
   os << indent << "FEM Object: " << m_FEMObject << std::endl;
+  os << indent << "Parallel Assembly: " << (m_ParallelAssembly ? "On" : "Off") << std::endl;
 }
 
 template <unsigned int VDimension>
@@ -233,12 +235,38 @@ Solver<VDimension>::AssembleK()
 
   // Step over all elements
   unsigned int numberOfElements = m_FEMObject->GetNumberOfElements();
-  for (unsigned int i = 0; i < numberOfElements; i++)
+  if (m_ParallelAssembly)
   {
-    // Call the function that actually moves the element matrix
-    // to the master matrix.
-    Element::Pointer e = m_FEMObject->GetElement(i);
-    this->AssembleElementMatrix(e);
+    // The element matrices of a block of elements are computed in parallel,
+    // and then added to the master matrices in the order of the elements.
+    constexpr unsigned int              elementsPerBlock = 1024;
+    std::vector<ElementMatrixArrayType> blockMatrices(std::min(elementsPerBlock, numberOfElements));
+    const FEMObjectType *               femObject = m_FEMObject;
+    for (unsigned int first = 0; first < numberOfElements; first += elementsPerBlock)
+    {
+      const unsigned int count = std::min(elementsPerBlock, numberOfElements - first);
+      this->GetMultiThreader()->ParallelizeArray(
+        0,
+        count,
+        [this, femObject, first, &blockMatrices](SizeValueType k) {
+          this->ComputeElementMatrices(femObject->GetElement(first + k).GetPointer(), blockMatrices[k]);
+        },
+        nullptr);
+      for (unsigned int k = 0; k < count; k++)
+      {
+        this->AddElementMatrices(femObject->GetElement(first + k).GetPointer(), blockMatrices[k]);
+      }
+    }
+  }
+  else
+  {
+    for (unsigned int i = 0; i < numberOfElements; i++)
+    {
+      // Call the function that actually moves the element matrix
+      // to the master matrix.
+      Element::Pointer e = m_FEMObject->GetElement(i);
+      this->AssembleElementMatrix(e);
+    }
   }
 
   // Step over all the loads again to add the landmark contributions
@@ -306,10 +334,25 @@ template <unsigned int VDimension>
 void
 Solver<VDimension>::AssembleElementMatrix(Element::Pointer e)
 {
-  // Copy the element stiffness matrix for faster access.
-  Element::MatrixType Ke;
+  ElementMatrixArrayType matrices;
+  this->ComputeElementMatrices(e, matrices);
+  this->AddElementMatrices(e, matrices);
+}
 
-  e->GetStiffnessMatrix(Ke);
+template <unsigned int VDimension>
+void
+Solver<VDimension>::ComputeElementMatrices(const Element * e, ElementMatrixArrayType & matrices) const
+{
+  matrices.resize(1);
+  e->GetStiffnessMatrix(matrices[0]);
+}
+
+template <unsigned int VDimension>
+void
+Solver<VDimension>::AddElementMatrices(const Element * e, const ElementMatrixArrayType & matrices)
+{
+  // Element stiffness matrix
+  const Element::MatrixType & Ke = matrices[0];
 
   // Same for number of DOF
   int Ne = e->GetNumberOfDegreesOfFreedom();
@@ -52,6 +52,7 @@ public:
   itkTypeMacro(SolverHyperbolic, Solver<TDimension>);
 
   using Float = Element::Float;
+  using ElementMatrixArrayType = typename Superclass::ElementMatrixArrayType;
 
   /** Get/Set Gamma. */
   itkSetMacro(Gamma, Float);
@@ -98,7 +99,10 @@ protected:
    * need to assemble the mass matrix too.
    */
   void
-  AssembleElementMatrix(Element::Pointer e) override;
+  ComputeElementMatrices(const Element * e, ElementMatrixArrayType & matrices) const override;
+
+  void
+  AddElementMatrices(const Element * e, const ElementMatrixArrayType & matrices) override;
 
   /** Initialize the storage for all master matrices. */
   void
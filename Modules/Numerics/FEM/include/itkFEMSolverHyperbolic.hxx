@@ -51,13 +51,20 @@ SolverHyperbolic<VDimension>::InitializeLinearSystemWrapper()
 
 template <unsigned int VDimension>
 void
-SolverHyperbolic<VDimension>::AssembleElementMatrix(Element::Pointer e)
+SolverHyperbolic<VDimension>::ComputeElementMatrices(const Element * e, ElementMatrixArrayType & matrices) const
 {
-  // Copy the element stiffness matrix for faster access.
-  Element::MatrixType Ke;
-  e->GetStiffnessMatrix(Ke);
-  Element::MatrixType Me;
-  e->GetMassMatrix(Me);
+  matrices.resize(2);
+  e->GetStiffnessMatrix(matrices[0]);
+  e->GetMassMatrix(matrices[1]);
+}
+
+template <unsigned int VDimension>
+void
+SolverHyperbolic<VDimension>::AddElementMatrices(const Element * e, const ElementMatrixArrayType & matrices)
+{
+  // Element stiffness and mass matrices
+  const Element::MatrixType & Ke = matrices[0];
+  const Element::MatrixType & Me = matrices[1];
 
   // ... same for number of DOF
   int Ne = e->GetNumberOfDegreesOfFreedom();
@@ -0,0 +1,623 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFEMLinearSystemWrapperCSR.h"
+#include "itkMultiThreaderBase.h"
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+namespace fem
+{
+namespace
+{
+// Number of rows processed by a work unit. The partial sums of the dot
+// products are computed per block, so that their result does not depend on
+// the number of threads.
+constexpr size_t BlockSize = 4096;
+
+// Calls function(begin, end) for consecutive blocks of [0, size) in parallel.
+template <typename TFunction>
+void
+ParallelForBlocks(size_t size, TFunction function)
+{
+  const size_t numberOfBlocks = (size + BlockSize - 1) / BlockSize;
+  if (numberOfBlocks <= 1)
+  {
+    function(0, size);
+    return;
+  }
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) { function(block * BlockSize, std::min(size, (block + 1) * BlockSize)); },
+    nullptr);
+}
+
+// Computes the sum of function(begin, end) over the blocks of [0, size).
+template <typename TFunction>
+double
+ParallelSumBlocks(size_t size, TFunction function)
+{
+  const size_t        numberOfBlocks = (size + BlockSize - 1) / BlockSize;
+  std::vector<double> partialSums(numberOfBlocks, 0.0);
+  ParallelForBlocks(size, [&](size_t begin, size_t end) { partialSums[begin / BlockSize] = function(begin, end); });
+
+  double sum = 0.0;
+  for (const double partialSum : partialSums)
+  {
+    sum += partialSum;
+  }
+  return sum;
+}
+
+bool
+CompareColumn(const LinearSystemWrapperCSR::CSRMatrix::RowType::value_type & entry, unsigned int column)
+{
+  return entry.first < column;
+}
+} // namespace
+
+LinearSystemWrapperCSR::CSRMatrix::CSRMatrix(unsigned int order)
+  : m_Rows(order)
+  , m_RowOffsets(order + 1, 0)
+{}
+
+const LinearSystemWrapperCSR::Float *
+LinearSystemWrapperCSR::CSRMatrix::FindValue(unsigned int i, unsigned int j) const
+{
+  if (m_Compressed)
+  {
+    const auto begin = m_Columns.begin() + m_RowOffsets[i];
+    const auto end = m_Columns.begin() + m_RowOffsets[i + 1];
+    const auto it = std::lower_bound(begin, end, j);
+    if (it != end && *it == j)
+    {
+      return &m_Values[it - m_Columns.begin()];
+    }
+    return nullptr;
+  }
+
+  const RowType & row = m_Rows[i];
+  const auto      it = std::lower_bound(row.begin(), row.end(), j, CompareColumn);
+  if (it != row.end() && it->first == j)
+  {
+    return &it->second;
+  }
+  return nullptr;
+}
+
+LinearSystemWrapperCSR::Float *
+LinearSystemWrapperCSR::CSRMatrix::FindValue(unsigned int i, unsigned int j)
+{
+  return const_cast<Float *>(static_cast<const CSRMatrix *>(this)->FindValue(i, j));
+}
+
+LinearSystemWrapperCSR::Float
+LinearSystemWrapperCSR::CSRMatrix::GetValue(unsigned int i, unsigned int j) const
+{
+  const Float * value = this->FindValue(i, j);
+  return value ? *value : 0.0;
+}
+
+void
+LinearSystemWrapperCSR::CSRMatrix::SetValue(unsigned int i, unsigned int j, Float value)
+{
+  if (Float * existingValue = this->FindValue(i, j))
+  {
+    *existingValue = value;
+  }
+  else if (value != 0.0)
+  {
+    this->AddValue(i, j, value);
+  }
+}
+
+void
+LinearSystemWrapperCSR::CSRMatrix::AddValue(unsigned int i, unsigned int j, Float value)
+{
+  if (m_Compressed)
+  {
+    if (Float * existingValue = this->FindValue(i, j))
+    {
+      *existingValue += value;
+      return;
+    }
+    this->Expand();
+  }
+
+  RowType &  row = m_Rows[i];
+  const auto it = std::lower_bound(row.begin(), row.end(), j, CompareColumn);
+  if (it != row.end() && it->first == j)
+  {
+    it->second += value;
+  }
+  else
+  {
+    row.insert(it, std::make_pair(j, value));
+  }
+}
+
+void
+LinearSystemWrapperCSR::CSRMatrix::Compress()
+{
+  if (m_Compressed)
+  {
+    return;
+  }
+
+  const unsigned int order = this->GetOrder();
+  m_RowOffsets[0] = 0;
+  for (unsigned int i = 0; i < order; ++i)
+  {
+    m_RowOffsets[i + 1] = m_RowOffsets[i] + m_Rows[i].size();
+  }
+  m_Columns.resize(m_RowOffsets[order]);
+  m_Values.resize(m_RowOffsets[order]);
+
+  ParallelForBlocks(order, [this](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      size_t offset = m_RowOffsets[i];
+      for (const auto & entry : m_Rows[i])
+      {
+        m_Columns[offset] = entry.first;
+        m_Values[offset] = entry.second;
+        ++offset;
+      }
+      RowType().swap(m_Rows[i]);
+    }
+  });
+  m_Compressed = true;
+}
+
+void
+LinearSystemWrapperCSR::CSRMatrix::Expand()
+{
+  if (!m_Compressed)
+  {
+    return;
+  }
+
+  const unsigned int order = this->GetOrder();
+  for (unsigned int i = 0; i < order; ++i)
+  {
+    m_Rows[i].resize(m_RowOffsets[i + 1] - m_RowOffsets[i]);
+    for (size_t k = m_RowOffsets[i]; k < m_RowOffsets[i + 1]; ++k)
+    {
+      m_Rows[i][k - m_RowOffsets[i]] = std::make_pair(m_Columns[k], m_Values[k]);
+    }
+  }
+  std::vector<unsigned int>().swap(m_Columns);
+  std::vector<Float>().swap(m_Values);
+  m_Compressed = false;
+}
+
+size_t
+LinearSystemWrapperCSR::CSRMatrix::GetNumberOfNonZeros() const
+{
+  if (m_Compressed)
+  {
+    return m_Values.size();
+  }
+  size_t numberOfNonZeros = 0;
+  for (const auto & row : m_Rows)
+  {
+    numberOfNonZeros += row.size();
+  }
+  return numberOfNonZeros;
+}
+
+void
+LinearSystemWrapperCSR::CSRMatrix::GetColumnsInRow(unsigned int i, ColumnArray & cols) const
+{
+  cols.clear();
+  if (m_Compressed)
+  {
+    cols.assign(m_Columns.begin() + m_RowOffsets[i], m_Columns.begin() + m_RowOffsets[i + 1]);
+  }
+  else
+  {
+    for (const auto & entry : m_Rows[i])
+    {
+      cols.push_back(entry.first);
+    }
+  }
+}
+
+void
+LinearSystemWrapperCSR::CSRMatrix::Multiply(const VectorRepresentation & x, VectorRepresentation & result) const
+{
+  result.resize(this->GetOrder());
+  ParallelForBlocks(this->GetOrder(), [this, &x, &result](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      Float sum = 0.0;
+      for (size_t k = m_RowOffsets[i]; k < m_RowOffsets[i + 1]; ++k)
+      {
+        sum += m_Values[k] * x[m_Columns[k]];
+      }
+      result[i] = sum;
+    }
+  });
+}
+
+LinearSystemWrapperCSR::~LinearSystemWrapperCSR() = default;
+
+void
+LinearSystemWrapperCSR::AllocateHolders()
+{
+  if (m_Matrices.size() < m_NumberOfMatrices)
+  {
+    m_Matrices.resize(m_NumberOfMatrices);
+  }
+  if (m_Vectors.size() < m_NumberOfVectors)
+  {
+    m_Vectors.resize(m_NumberOfVectors);
+  }
+  if (m_Solutions.size() < m_NumberOfSolutions)
+  {
+    m_Solutions.resize(m_NumberOfSolutions);
+  }
+}
+
+const LinearSystemWrapperCSR::MatrixRepresentation *
+LinearSystemWrapperCSR::GetMatrix(unsigned int matrixIndex) const
+{
+  if (matrixIndex >= m_Matrices.size())
+  {
+    return nullptr;
+  }
+  return m_Matrices[matrixIndex].get();
+}
+
+void
+LinearSystemWrapperCSR::InitializeMatrix(unsigned int matrixIndex)
+{
+  this->AllocateHolders();
+  if (matrixIndex >= m_Matrices.size())
+  {
+    throw FEMExceptionLinearSystemBounds(
+      __FILE__, __LINE__, "LinearSystemWrapperCSR::InitializeMatrix", "m_Matrices", matrixIndex);
+  }
+  m_Matrices[matrixIndex].reset(new MatrixRepresentation(this->GetSystemOrder()));
+}
+
+bool
+LinearSystemWrapperCSR::IsMatrixInitialized(unsigned int matrixIndex)
+{
+  return matrixIndex < m_Matrices.size() && m_Matrices[matrixIndex] != nullptr;
+}
+
+void
+LinearSystemWrapperCSR::DestroyMatrix(unsigned int matrixIndex)
+{
+  if (matrixIndex < m_Matrices.size())
+  {
+    m_Matrices[matrixIndex].reset();
+  }
+}
+
+void
+LinearSystemWrapperCSR::InitializeVector(unsigned int vectorIndex)
+{
+  this->AllocateHolders();
+  if (vectorIndex >= m_Vectors.size())
+  {
+    throw FEMExceptionLinearSystemBounds(
+      __FILE__, __LINE__, "LinearSystemWrapperCSR::InitializeVector", "m_Vectors", vectorIndex);
+  }
+  m_Vectors[vectorIndex].reset(new VectorRepresentation(this->GetSystemOrder(), 0.0));
+}
+
+bool
+LinearSystemWrapperCSR::IsVectorInitialized(unsigned int vectorIndex)
+{
+  return vectorIndex < m_Vectors.size() && m_Vectors[vectorIndex] != nullptr;
+}
+
+void
+LinearSystemWrapperCSR::DestroyVector(unsigned int vectorIndex)
+{
+  if (vectorIndex < m_Vectors.size())
+  {
+    m_Vectors[vectorIndex].reset();
+  }
+}
+
+void
+LinearSystemWrapperCSR::InitializeSolution(unsigned int solutionIndex)
+{
+  this->AllocateHolders();
+  if (solutionIndex >= m_Solutions.size())
+  {
+    throw FEMExceptionLinearSystemBounds(
+      __FILE__, __LINE__, "LinearSystemWrapperCSR::InitializeSolution", "m_Solutions", solutionIndex);
+  }
+  m_Solutions[solutionIndex].reset(new VectorRepresentation(this->GetSystemOrder(), 0.0));
+}
+
+bool
+LinearSystemWrapperCSR::IsSolutionInitialized(unsigned int solutionIndex)
+{
+  return solutionIndex < m_Solutions.size() && m_Solutions[solutionIndex] != nullptr;
+}
+
+void
+LinearSystemWrapperCSR::DestroySolution(unsigned int solutionIndex)
+{
+  if (solutionIndex < m_Solutions.size())
+  {
+    m_Solutions[solutionIndex].reset();
+  }
+}
+
+LinearSystemWrapperCSR::Float
+LinearSystemWrapperCSR::GetSolutionValue(unsigned int i, unsigned int solutionIndex) const
+{
+  if (solutionIndex >= m_Solutions.size() || !m_Solutions[solutionIndex] || m_Solutions[solutionIndex]->size() <= i)
+  {
+    return 0.0;
+  }
+  return (*m_Solutions[solutionIndex])[i];
+}
+
+void
+LinearSystemWrapperCSR::Solve()
+{
+  if (!this->IsMatrixInitialized(0) || !this->IsVectorInitialized(0) || !this->IsSolutionInitialized(0))
+  {
+    throw FEMExceptionLinearSystem(__FILE__,
+                                   __LINE__,
+                                   "LinearSystemWrapperCSR::Solve",
+                                   "The matrix, the vector and the solution must be initialized");
+  }
+
+  MatrixRepresentation &       A = *m_Matrices[0];
+  const VectorRepresentation & b = *m_Vectors[0];
+  VectorRepresentation &       x = *m_Solutions[0];
+  const size_t                 n = A.GetOrder();
+
+  A.Compress();
+
+  // Inverse of the diagonal, used as preconditioner
+  VectorRepresentation inverseDiagonal(n);
+  ParallelForBlocks(n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      const Float d = A.GetValue(static_cast<unsigned int>(i), static_cast<unsigned int>(i));
+      inverseDiagonal[i] = (d != 0.0) ? 1.0 / d : 1.0;
+    }
+  });
+
+  m_NumberOfIterationsPerformed = 0;
+  m_RelativeResidual = 0.0;
+
+  const double bNorm = std::sqrt(ParallelSumBlocks(n, [&](size_t begin, size_t end) {
+    double sum = 0.0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      sum += b[i] * b[i];
+    }
+    return sum;
+  }));
+  if (bNorm == 0.0)
+  {
+    std::fill(x.begin(), x.end(), 0.0);
+    return;
+  }
+
+  // r = b - A x, z = M^-1 r, p = z
+  VectorRepresentation r(n);
+  VectorRepresentation z(n);
+  VectorRepresentation p(n);
+  VectorRepresentation q(n);
+  A.Multiply(x, q);
+  double rz = ParallelSumBlocks(n, [&](size_t begin, size_t end) {
+    double sum = 0.0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      r[i] = b[i] - q[i];
+      z[i] = inverseDiagonal[i] * r[i];
+      p[i] = z[i];
+      sum += r[i] * z[i];
+    }
+    return sum;
+  });
+
+  const unsigned int maximumNumberOfIterations =
+    m_MaximumNumberOfIterations > 0 ? m_MaximumNumberOfIterations : static_cast<unsigned int>(n);
+  for (unsigned int iteration = 0; iteration < maximumNumberOfIterations; ++iteration)
+  {
+    A.Multiply(p, q);
+    const double pq = ParallelSumBlocks(n, [&](size_t begin, size_t end) {
+      double sum = 0.0;
+      for (size_t i = begin; i < end; ++i)
+      {
+        sum += p[i] * q[i];
+      }
+      return sum;
+    });
+    if (pq == 0.0)
+    {
+      break;
+    }
+    const double alpha = rz / pq;
+
+    // x += alpha p, r -= alpha q
+    const double rNorm = std::sqrt(ParallelSumBlocks(n, [&](size_t begin, size_t end) {
+      double sum = 0.0;
+      for (size_t i = begin; i < end; ++i)
+      {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+        sum += r[i] * r[i];
+      }
+      return sum;
+    }));
+    m_NumberOfIterationsPerformed = iteration + 1;
+    m_RelativeResidual = rNorm / bNorm;
+    if (m_RelativeResidual <= m_Tolerance)
+    {
+      break;
+    }
+
+    // z = M^-1 r
+    const double rzNew = ParallelSumBlocks(n, [&](size_t begin, size_t end) {
+      double sum = 0.0;
+      for (size_t i = begin; i < end; ++i)
+      {
+        z[i] = inverseDiagonal[i] * r[i];
+        sum += r[i] * z[i];
+      }
+      return sum;
+    });
+    const double beta = rzNew / rz;
+    rz = rzNew;
+
+    // p = z + beta p
+    ParallelForBlocks(n, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i)
+      {
+        p[i] = z[i] + beta * p[i];
+      }
+    });
+  }
+}
+
+void
+LinearSystemWrapperCSR::ScaleMatrix(Float scale, unsigned int matrixIndex)
+{
+  MatrixRepresentation & matrix = *m_Matrices[matrixIndex];
+  matrix.Compress();
+  for (auto & value : matrix.GetValues())
+  {
+    value *= scale;
+  }
+}
+
+void
+LinearSystemWrapperCSR::SwapMatrices(unsigned int matrixIndex1, unsigned int matrixIndex2)
+{
+  std::swap(m_Matrices[matrixIndex1], m_Matrices[matrixIndex2]);
+}
+
+void
+LinearSystemWrapperCSR::SwapVectors(unsigned int vectorIndex1, unsigned int vectorIndex2)
+{
+  std::swap(m_Vectors[vectorIndex1], m_Vectors[vectorIndex2]);
+}
+
+void
+LinearSystemWrapperCSR::SwapSolutions(unsigned int solutionIndex1, unsigned int solutionIndex2)
+{
+  std::swap(m_Solutions[solutionIndex1], m_Solutions[solutionIndex2]);
+}
+
+void
+LinearSystemWrapperCSR::CopySolution2Vector(unsigned int solutionIndex, unsigned int vectorIndex)
+{
+  this->AllocateHolders();
+  m_Vectors[vectorIndex].reset(new VectorRepresentation(*m_Solutions[solutionIndex]));
+}
+
+void
+LinearSystemWrapperCSR::CopyVector2Solution(unsigned int vectorIndex, unsigned int solutionIndex)
+{
+  this->AllocateHolders();
+  m_Solutions[solutionIndex].reset(new VectorRepresentation(*m_Vectors[vectorIndex]));
+}
+
+void
+LinearSystemWrapperCSR::MultiplyMatrixMatrix(unsigned int resultMatrixIndex,
+                                             unsigned int leftMatrixIndex,
+                                             unsigned int rightMatrixIndex)
+{
+  MatrixRepresentation & left = *m_Matrices[leftMatrixIndex];
+  MatrixRepresentation & right = *m_Matrices[rightMatrixIndex];
+  left.Compress();
+  right.Compress();
+
+  const unsigned int order = this->GetSystemOrder();
+  auto               result = std::unique_ptr<MatrixRepresentation>(new MatrixRepresentation(order));
+
+  // Each row of the product is accumulated in a dense row, whose nonzero
+  // columns are tracked.
+  std::vector<Float>        accumulator(order, 0.0);
+  std::vector<bool>         used(order, false);
+  std::vector<unsigned int> usedColumns;
+  for (unsigned int i = 0; i < order; ++i)
+  {
+    for (size_t k = left.GetRowOffsets()[i]; k < left.GetRowOffsets()[i + 1]; ++k)
+    {
+      const unsigned int j = left.GetColumns()[k];
+      const Float        leftValue = left.GetValues()[k];
+      for (size_t l = right.GetRowOffsets()[j]; l < right.GetRowOffsets()[j + 1]; ++l)
+      {
+        const unsigned int column = right.GetColumns()[l];
+        if (!used[column])
+        {
+          used[column] = true;
+          usedColumns.push_back(column);
+        }
+        accumulator[column] += leftValue * right.GetValues()[l];
+      }
+    }
+    std::sort(usedColumns.begin(), usedColumns.end());
+    for (const unsigned int column : usedColumns)
+    {
+      result->AddValue(i, column, accumulator[column]);
+      accumulator[column] = 0.0;
+      used[column] = false;
+    }
+    usedColumns.clear();
+  }
+
+  m_Matrices[resultMatrixIndex] = std::move(result);
+}
+
+void
+LinearSystemWrapperCSR::MultiplyMatrixVector(unsigned int resultVectorIndex,
+                                             unsigned int matrixIndex,
+                                             unsigned int vectorIndex)
+{
+  this->AllocateHolders();
+  m_Matrices[matrixIndex]->Compress();
+
+  VectorRepresentation result;
+  m_Matrices[matrixIndex]->Multiply(*m_Vectors[vectorIndex], result);
+  m_Vectors[resultVectorIndex].reset(new VectorRepresentation(std::move(result)));
+}
+
+void
+LinearSystemWrapperCSR::MultiplyMatrixSolution(unsigned int resultVectorIndex,
+                                               unsigned int matrixIndex,
+                                               unsigned int solutionIndex)
+{
+  this->AllocateHolders();
+  m_Matrices[matrixIndex]->Compress();
+
+  VectorRepresentation result;
+  m_Matrices[matrixIndex]->Multiply(*m_Solutions[solutionIndex], result);
+  m_Vectors[resultVectorIndex].reset(new VectorRepresentation(std::move(result)));
+}
+
+} // end namespace fem
+} // end namespace itk
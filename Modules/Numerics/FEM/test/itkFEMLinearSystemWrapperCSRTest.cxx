@@ -0,0 +1,238 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFEMLinearSystemWrapperCSR.h"
+#include "itkFEMLinearSystemWrapperDenseVNL.h"
+#include "itkFEMLinearSystemWrapperVNL.h"
+#include "itkFEMElement2DC0LinearQuadrilateralStrain.h"
+#include "itkFEMLoadBC.h"
+#include "itkFEMLoadNode.h"
+#include "itkFEMObject.h"
+#include "itkFEMSolver.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <iostream>
+
+/* Testing for the CSR linear system wrapper and the parallel assembly */
+int
+itkFEMLinearSystemWrapperCSRTest(int, char *[])
+{
+  constexpr double tolerance = 1e-6;
+
+  /* Compare with the dense wrapper on a small system */
+  const unsigned int N = 5;
+
+  itk::fem::LinearSystemWrapperCSR      csr;
+  itk::fem::LinearSystemWrapperDenseVNL dense;
+  itk::fem::LinearSystemWrapper *       wrappers[2] = { &csr, &dense };
+  for (itk::fem::LinearSystemWrapper * it : wrappers)
+  {
+    it->SetSystemOrder(N);
+    it->SetNumberOfMatrices(2);
+    it->SetNumberOfVectors(2);
+    it->SetNumberOfSolutions(1);
+    it->InitializeMatrix(0);
+    it->InitializeMatrix(1);
+    it->InitializeVector(0);
+    it->InitializeVector(1);
+    it->InitializeSolution(0);
+
+    /*     matrix 0
+     * |11  0  0 14 15|
+     * | 0 22  0  0  0|
+     * | 0  0 33  0  0|
+     * |14  0  0 44 45|
+     * |15  0  0 45 55|
+     */
+    it->SetMatrixValue(4, 4, 55, 0);
+    it->SetMatrixValue(0, 0, 11, 0);
+    it->SetMatrixValue(0, 3, 14, 0);
+    it->SetMatrixValue(0, 4, 15, 0);
+    it->SetMatrixValue(1, 1, 22, 0);
+    it->SetMatrixValue(2, 2, 30, 0);
+    it->AddMatrixValue(2, 2, 3, 0);
+    it->SetMatrixValue(3, 0, 14, 0);
+    it->SetMatrixValue(3, 3, 44, 0);
+    it->SetMatrixValue(3, 4, 45, 0);
+    it->SetMatrixValue(4, 0, 15, 0);
+    it->SetMatrixValue(4, 3, 45, 0);
+    it->SetMatrixValue(1, 2, 0.0, 0);
+    for (unsigned int i = 0; i < N; ++i)
+    {
+      it->SetVectorValue(i, i + 1.0, 0);
+    }
+    it->Solve();
+    it->MultiplyMatrixVector(1, 0, 0);
+    it->MultiplyMatrixMatrix(1, 0, 0);
+  }
+
+  const itk::fem::LinearSystemWrapperCSR::CSRMatrix * matrix = csr.GetMatrix(0);
+  ITK_TEST_EXPECT_TRUE(matrix->IsCompressed());
+  ITK_TEST_EXPECT_EQUAL(matrix->GetNumberOfNonZeros(), 11);
+  ITK_TEST_EXPECT_EQUAL(matrix->GetRowOffsets()[N], 11);
+
+  itk::fem::LinearSystemWrapper::ColumnArray cols;
+  csr.GetColumnsOfNonZeroMatrixElementsInRow(3, cols, 0);
+  ITK_TEST_EXPECT_EQUAL(cols.size(), 3);
+  ITK_TEST_EXPECT_EQUAL(cols[0], 0);
+  ITK_TEST_EXPECT_EQUAL(cols[2], 4);
+
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    ITK_TEST_EXPECT_TRUE(
+      itk::Math::FloatAlmostEqual(csr.GetSolutionValue(i, 0), dense.GetSolutionValue(i, 0), 4, tolerance));
+    ITK_TEST_EXPECT_TRUE(
+      itk::Math::FloatAlmostEqual(csr.GetVectorValue(i, 1), dense.GetVectorValue(i, 1), 4, tolerance));
+    for (unsigned int j = 0; j < N; ++j)
+    {
+      ITK_TEST_EXPECT_TRUE(
+        itk::Math::FloatAlmostEqual(csr.GetMatrixValue(i, j, 0), dense.GetMatrixValue(i, j, 0), 4, tolerance));
+      ITK_TEST_EXPECT_TRUE(
+        itk::Math::FloatAlmostEqual(csr.GetMatrixValue(i, j, 1), dense.GetMatrixValue(i, j, 1), 4, tolerance));
+    }
+  }
+  std::cout << "Conjugate gradient iterations: " << csr.GetNumberOfIterationsPerformed()
+            << " relative residual: " << csr.GetRelativeResidual() << std::endl;
+  ITK_TEST_EXPECT_TRUE(csr.GetRelativeResidual() <= csr.GetTolerance());
+
+  /* Adding an entry to a compressed matrix expands it */
+  csr.AddMatrixValue(1, 2, 1.0, 0);
+  ITK_TEST_EXPECT_TRUE(!csr.GetMatrix(0)->IsCompressed());
+  ITK_TEST_EXPECT_EQUAL(csr.GetMatrixValue(1, 2, 0), 1.0);
+  ITK_TEST_EXPECT_EQUAL(csr.GetMatrixValue(3, 4, 0), 45.0);
+
+  ITK_TRY_EXPECT_EXCEPTION(csr.InitializeMatrix(2));
+
+  /* Solve a plane strain problem on a mesh of quadrilaterals, with the
+   * element matrices assembled serially and in parallel */
+  itk::FEMFactoryBase::GetFactory()->RegisterDefaultTypes();
+
+  using FEMObjectType = itk::fem::FEMObject<2>;
+  FEMObjectType::Pointer femObject = FEMObjectType::New();
+
+  const unsigned int nx = 40;
+  const unsigned int ny = 26;
+  for (unsigned int y = 0; y <= ny; ++y)
+  {
+    for (unsigned int x = 0; x <= nx; ++x)
+    {
+      itk::fem::Element::Node::Pointer n = itk::fem::Element::Node::New();
+      itk::fem::Element::VectorType    pt(2);
+      pt[0] = x;
+      pt[1] = y;
+      n->SetGlobalNumber(y * (nx + 1) + x);
+      n->SetCoordinates(pt);
+      femObject->AddNextNode(n);
+    }
+  }
+  femObject->RenumberNodeContainer();
+
+  itk::fem::MaterialLinearElasticity::Pointer m = itk::fem::MaterialLinearElasticity::New();
+  m->SetGlobalNumber(0);
+  m->SetYoungsModulus(200.0);
+  m->SetPoissonsRatio(0.3);
+  m->SetThickness(1.0);
+  femObject->AddNextMaterial(m);
+
+  for (unsigned int y = 0; y < ny; ++y)
+  {
+    for (unsigned int x = 0; x < nx; ++x)
+    {
+      itk::fem::Element2DC0LinearQuadrilateralStrain::Pointer e =
+        itk::fem::Element2DC0LinearQuadrilateralStrain::New();
+      const unsigned int n0 = y * (nx + 1) + x;
+      e->SetGlobalNumber(y * nx + x);
+      e->SetNode(0, femObject->GetNode(n0));
+      e->SetNode(1, femObject->GetNode(n0 + 1));
+      e->SetNode(2, femObject->GetNode(n0 + nx + 2));
+      e->SetNode(3, femObject->GetNode(n0 + nx + 1));
+      e->SetMaterial(femObject->GetMaterial(0).GetPointer());
+      femObject->AddNextElement(e);
+    }
+  }
+
+  // Fix the left side, and pull the right side.
+  for (unsigned int y = 0; y < ny; ++y)
+  {
+    itk::fem::Element::Pointer left = femObject->GetElement(y * nx);
+    for (unsigned int dof = 0; dof < 2; ++dof)
+    {
+      itk::fem::LoadBC::Pointer bc = itk::fem::LoadBC::New();
+      bc->SetElement(left);
+      bc->SetDegreeOfFreedom(dof);
+      bc->SetValue(vnl_vector<double>(1, 0.0));
+      femObject->AddNextLoad(bc);
+      if (y == ny - 1)
+      {
+        bc = itk::fem::LoadBC::New();
+        bc->SetElement(left);
+        bc->SetDegreeOfFreedom(6 + dof);
+        bc->SetValue(vnl_vector<double>(1, 0.0));
+        femObject->AddNextLoad(bc);
+      }
+    }
+
+    itk::fem::LoadNode::Pointer load = itk::fem::LoadNode::New();
+    load->SetElement(femObject->GetElement(y * nx + nx - 1));
+    load->SetNode(2);
+    vnl_vector<double> force(2);
+    force[0] = 1.0;
+    force[1] = 0.5;
+    load->SetForce(force);
+    femObject->AddNextLoad(load);
+  }
+  femObject->FinalizeMesh();
+
+  using SolverType = itk::fem::Solver<2>;
+  itk::fem::LinearSystemWrapperVNL vnlWrapper;
+  SolverType::Pointer              serialSolver = SolverType::New();
+  serialSolver->SetInput(femObject);
+  serialSolver->SetLinearSystemWrapper(&vnlWrapper);
+  serialSolver->Update();
+
+  itk::fem::LinearSystemWrapperCSR csrWrapper;
+  csrWrapper.SetTolerance(1e-12);
+  SolverType::Pointer parallelSolver = SolverType::New();
+  ITK_TEST_SET_GET_BOOLEAN(parallelSolver, ParallelAssembly, true);
+  parallelSolver->SetInput(femObject);
+  parallelSolver->SetLinearSystemWrapper(&csrWrapper);
+  parallelSolver->Update();
+
+  std::cout << "Conjugate gradient iterations: " << csrWrapper.GetNumberOfIterationsPerformed()
+            << " relative residual: " << csrWrapper.GetRelativeResidual() << std::endl;
+
+  const unsigned int numberOfDegreesOfFreedom = femObject->GetNumberOfDegreesOfFreedom();
+  ITK_TEST_EXPECT_EQUAL(csrWrapper.GetSystemOrder(), numberOfDegreesOfFreedom);
+  double maximumDisplacement = 0.0;
+  for (unsigned int i = 0; i < numberOfDegreesOfFreedom; ++i)
+  {
+    maximumDisplacement = std::max(maximumDisplacement, std::abs(serialSolver->GetSolution(i)));
+  }
+  for (unsigned int i = 0; i < numberOfDegreesOfFreedom; ++i)
+  {
+    if (std::abs(parallelSolver->GetSolution(i) - serialSolver->GetSolution(i)) > tolerance * maximumDisplacement)
+    {
+      std::cerr << "Solution " << i << " is " << parallelSolver->GetSolution(i) << " instead of "
+                << serialSolver->GetSolution(i) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
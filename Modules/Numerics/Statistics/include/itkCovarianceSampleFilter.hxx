@@ -20,6 +20,7 @@
 
 #include "itkCovarianceSampleFilter.h"
 #include "itkMeanSampleFilter.h"
+#include "itkSampleMomentsCalculator.h"
 
 namespace itk
 {
@@ -120,66 +121,31 @@ CovarianceSampleFilter<TSample>::GenerateData()
 
   auto * decoratedOutput = itkDynamicCastInDebugMode<MatrixDecoratedType *>(this->ProcessObject::GetOutput(0));
 
-  MatrixType output = decoratedOutput->Get();
-  output.SetSize(measurementVectorSize, measurementVectorSize);
-  output.Fill(NumericTraits<typename MatrixType::ValueType>::ZeroValue());
-
   auto * decoratedMeanOutput =
     itkDynamicCastInDebugMode<MeasurementVectorDecoratedType *>(this->ProcessObject::GetOutput(1));
 
-  // calculate mean
-  using MeanFilterType = MeanSampleFilter<SampleType>;
-  typename MeanFilterType::Pointer meanFilter = MeanFilterType::New();
-
-  meanFilter->SetInput(input);
-  meanFilter->Update();
-
-  const typename MeanFilterType::MeasurementVectorRealType mean = meanFilter->GetMean();
-  decoratedMeanOutput->Set(mean);
-
-  // covariance algorithm
-  MeasurementVectorRealType diff;
-  NumericTraits<MeasurementVectorRealType>::SetLength(diff, measurementVectorSize);
+  // calculate the mean and the scatter matrix in a single pass
+  using MomentsCalculatorType = SampleMomentsCalculator<SampleType>;
+  typename MomentsCalculatorType::Pointer momentsCalculator = MomentsCalculatorType::New();
+  momentsCalculator->SetSample(input);
+  momentsCalculator->ComputeCovarianceOn();
+  momentsCalculator->Compute();
 
-  using TotalFrequencyType = typename SampleType::TotalAbsoluteFrequencyType;
-  TotalFrequencyType totalFrequency = NumericTraits<TotalFrequencyType>::ZeroValue();
-
-  typename SampleType::ConstIterator       iter = input->Begin();
-  const typename SampleType::ConstIterator end = input->End();
-
-  // fills the lower triangle and the diagonal cells in the covariance matrix
-  for (; iter != end; ++iter)
+  const typename MomentsCalculatorType::WeightValueType totalFrequency = momentsCalculator->GetTotalWeight();
+  if (totalFrequency <= itk::Math::eps)
   {
-    const MeasurementVectorType & measurement = iter.GetMeasurementVector();
-
-    const typename SampleType::AbsoluteFrequencyType frequency = iter.GetFrequency();
-    totalFrequency += frequency;
-
-    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
-    {
-      const auto component = static_cast<MeasurementRealType>(measurement[dim]);
-
-      diff[dim] = (component - mean[dim]);
-    }
-
-    // updates the covariance matrix
-    for (unsigned int row = 0; row < measurementVectorSize; ++row)
-    {
-      for (unsigned int col = 0; col < row + 1; ++col)
-      {
-        output(row, col) += (static_cast<MeasurementRealType>(frequency) * diff[row] * diff[col]);
-      }
-    }
+    itkExceptionMacro("Total frequency was too close to zero: " << totalFrequency);
   }
 
-  // fills the upper triangle using the lower triangle
-  for (unsigned int row = 1; row < measurementVectorSize; ++row)
+  MeasurementVectorRealType mean;
+  NumericTraits<MeasurementVectorRealType>::SetLength(mean, measurementVectorSize);
+  for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
   {
-    for (unsigned int col = 0; col < row; ++col)
-    {
-      output(col, row) = output(row, col);
-    }
+    mean[dim] = momentsCalculator->GetMean()[dim];
   }
+  decoratedMeanOutput->Set(mean);
+
+  MatrixType output = momentsCalculator->GetScatterMatrix();
 
   const double normalizationFactor = (static_cast<MeasurementRealType>(totalFrequency) - 1.0);
 
@@ -22,6 +22,7 @@
 #include "itkMixtureModelComponentBase.h"
 #include "itkGaussianMembershipFunction.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -71,6 +72,18 @@ extern ITKStatistics_EXPORT std::ostream &
  * sample set as input. Please use the function
  * GetMeasurementVectorSize() to get the length.
  *
+ * At the start of the estimation, the measurement vectors of the sample are
+ * copied into one contiguous array per component of the measurement vectors,
+ * together with their frequencies. The expectation step, which evaluates
+ * every component for every measurement vector, and the update of the
+ * proportions, are then computed in parallel over blocks of measurement
+ * vectors, from this copy. The expectation step calls
+ * MixtureModelComponentBase::Evaluate(), and so the Evaluate() method of the
+ * membership functions, from several threads at once. The membership
+ * functions of ITK support it, since their Evaluate() is const and has no
+ * side effect; set NumberOfWorkUnits to 1 for a membership function which
+ * does not.
+ *
  * \sa MixtureModelComponentBase, GaussianMixtureModelComponent
  * \ingroup ITKStatistics
  *
@@ -177,6 +190,13 @@ public:
   unsigned int
   GetNumberOfComponents() const;
 
+  /** Set/Get the number of work units of the expectation step and of the
+   * update of the proportions. With one work unit, the membership functions
+   * are evaluated serially. Defaults to the global default number of
+   * threads. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
   /** Runs the optimization process. */
   void
   Update();
@@ -238,6 +258,23 @@ private:
 
   MembershipFunctionVectorObjectPointer  m_MembershipFunctionsObject;
   MembershipFunctionsWeightsArrayPointer m_MembershipFunctionsWeightArrayObject;
+
+  /** Copies the measurement vectors and the frequencies of the sample. */
+  void
+  CacheSample();
+
+  /** Calls blockFunction for the blocks of measurement vectors, in parallel
+   * unless NumberOfWorkUnits is 1. */
+  void
+  ProcessBlocks(SizeValueType numberOfBlocks, const MultiThreaderBase::ArrayThreadingFunctorType & blockFunction);
+
+  ThreadIdType               m_NumberOfWorkUnits;
+  MultiThreaderBase::Pointer m_MultiThreader;
+
+  /** Measurements of the sample, stored component by component: the d-th
+   * component of the i-th measurement vector is at d * size + i. */
+  std::vector<MeasurementType> m_CachedMeasurements;
+  std::vector<double>          m_CachedFrequencies;
 }; // end of class
 } // end of namespace Statistics
 } // end of namespace itk
@@ -31,6 +31,8 @@ ExpectationMaximizationMixtureModelEstimator<TSample>::ExpectationMaximizationMi
   : m_Sample(nullptr)
   , m_MembershipFunctionsObject(MembershipFunctionVectorObjectType::New())
   , m_MembershipFunctionsWeightArrayObject(MembershipFunctionsWeightsArrayObjectType::New())
+  , m_NumberOfWorkUnits(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+  , m_MultiThreader(MultiThreaderBase::New())
 {}
 
 template <typename TSample>
@@ -50,6 +52,7 @@ ExpectationMaximizationMixtureModelEstimator<TSample>::PrintSelf(std::ostream &
   os << indent << "Initial Proportions: " << this->GetInitialProportions() << std::endl;
   os << indent << "Proportions: " << this->GetProportions() << std::endl;
   os << indent << "Calculated Expectation: " << this->CalculateExpectation() << std::endl;
+  os << indent << "Number Of Work Units: " << this->GetNumberOfWorkUnits() << std::endl;
 }
 
 template <typename TSample>
@@ -150,65 +153,64 @@ ExpectationMaximizationMixtureModelEstimator<TSample>::CalculateDensities()
     return false;
   }
 
-  double              temp;
-  size_t              numberOfComponents = m_ComponentVector.size();
-  std::vector<double> tempWeights(numberOfComponents, 0.);
-
-  typename TSample::ConstIterator iter = m_Sample->Begin();
-  typename TSample::ConstIterator last = m_Sample->End();
-  // Note: The data type of componentIndex shoub be unsigned int
-  //       because itk::Array only supports 'unsigned int' number of elements.
-  unsigned int componentIndex;
-
-  using FrequencyType = typename TSample::AbsoluteFrequencyType;
-  FrequencyType                           frequency;
-  FrequencyType                           zeroFrequency = NumericTraits<FrequencyType>::ZeroValue();
-  typename TSample::MeasurementVectorType mvector;
-  double                                  density;
-  double                                  densitySum;
-  double                                  minDouble = NumericTraits<double>::epsilon();
-
-  SizeValueType measurementVectorIndex = 0;
-
-  while (iter != last)
-  {
-    mvector = iter.GetMeasurementVector();
-    frequency = iter.GetFrequency();
-    densitySum = 0.0;
-    if (frequency > zeroFrequency)
-    {
-      for (componentIndex = 0; componentIndex < numberOfComponents; ++componentIndex)
-      {
-        double t_prop = m_Proportions[componentIndex];
-        double t_value = m_ComponentVector[componentIndex]->Evaluate(mvector);
-        density = t_prop * t_value;
-        tempWeights[componentIndex] = density;
-        densitySum += density;
-      }
-
-      for (componentIndex = 0; componentIndex < numberOfComponents; ++componentIndex)
+  const unsigned int  numberOfComponents = static_cast<unsigned int>(m_ComponentVector.size());
+  const SizeValueType size = m_CachedFrequencies.size();
+  const unsigned int  measurementVectorSize = m_Sample->GetMeasurementVectorSize();
+  const double        minDouble = NumericTraits<double>::epsilon();
+
+  // The measurement vectors are processed by blocks, each by one work unit.
+  constexpr SizeValueType blockSize = 1024;
+  const SizeValueType     numberOfBlocks = (size + blockSize - 1) / blockSize;
+  this->ProcessBlocks(
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      MeasurementVectorType mvector;
+      NumericTraits<MeasurementVectorType>::SetLength(mvector, measurementVectorSize);
+      std::vector<double> tempWeights(numberOfComponents, 0.);
+
+      const SizeValueType last = std::min(size, (block + 1) * blockSize);
+      for (SizeValueType measurementVectorIndex = block * blockSize; measurementVectorIndex < last;
+           ++measurementVectorIndex)
       {
-        temp = tempWeights[static_cast<unsigned int>(componentIndex)];
-
-        // just to make sure temp does not blow up!
-        if (densitySum > NumericTraits<double>::epsilon())
+        // Note: The data type of componentIndex should be unsigned int
+        //       because itk::Array only supports 'unsigned int' number of elements.
+        unsigned int componentIndex;
+        if (m_CachedFrequencies[measurementVectorIndex] > 0.0)
         {
-          temp /= densitySum;
+          for (unsigned int d = 0; d < measurementVectorSize; ++d)
+          {
+            mvector[d] = m_CachedMeasurements[d * size + measurementVectorIndex];
+          }
+
+          double densitySum = 0.0;
+          for (componentIndex = 0; componentIndex < numberOfComponents; ++componentIndex)
+          {
+            const double density = m_Proportions[componentIndex] * m_ComponentVector[componentIndex]->Evaluate(mvector);
+            tempWeights[componentIndex] = density;
+            densitySum += density;
+          }
+
+          for (componentIndex = 0; componentIndex < numberOfComponents; ++componentIndex)
+          {
+            double temp = tempWeights[componentIndex];
+
+            // just to make sure temp does not blow up!
+            if (densitySum > NumericTraits<double>::epsilon())
+            {
+              temp /= densitySum;
+            }
+            m_ComponentVector[componentIndex]->SetWeight(measurementVectorIndex, temp);
+          }
+        }
+        else
+        {
+          for (componentIndex = 0; componentIndex < numberOfComponents; ++componentIndex)
+          {
+            m_ComponentVector[componentIndex]->SetWeight(measurementVectorIndex, minDouble);
+          }
         }
-        m_ComponentVector[static_cast<unsigned int>(componentIndex)]->SetWeight(measurementVectorIndex, temp);
-      }
-    }
-    else
-    {
-      for (componentIndex = 0; componentIndex < numberOfComponents; ++componentIndex)
-      {
-        m_ComponentVector[componentIndex]->SetWeight(measurementVectorIndex, minDouble);
       }
-    }
-
-    ++iter;
-    ++measurementVectorIndex;
-  }
+    });
 
   return true;
 }
@@ -282,31 +284,52 @@ template <typename TSample>
 bool
 ExpectationMaximizationMixtureModelEstimator<TSample>::UpdateProportions()
 {
-  size_t numberOfComponents = m_ComponentVector.size();
-  size_t sampleSize = m_Sample->Size();
-  auto   totalFrequency = static_cast<double>(m_Sample->GetTotalFrequency());
-  size_t i, j;
-  double tempSum;
-  bool   updated = false;
-
-  for (i = 0; i < numberOfComponents; ++i)
+  const unsigned int  numberOfComponents = static_cast<unsigned int>(m_ComponentVector.size());
+  const SizeValueType sampleSize = m_CachedFrequencies.size();
+  auto                totalFrequency = static_cast<double>(m_Sample->GetTotalFrequency());
+  bool                updated = false;
+
+  // The weighted frequencies are summed by blocks in parallel, then the
+  // sums of the blocks are added in order.
+  constexpr SizeValueType blockSize = 1024;
+  const SizeValueType     numberOfBlocks = (sampleSize + blockSize - 1) / blockSize;
+  std::vector<double>     blockSums(numberOfBlocks * numberOfComponents, 0.);
+  if (totalFrequency > NumericTraits<double>::epsilon())
   {
-    tempSum = 0.;
+    this->ProcessBlocks(
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        const SizeValueType last = std::min(sampleSize, (block + 1) * blockSize);
+        for (unsigned int i = 0; i < numberOfComponents; ++i)
+        {
+          const ComponentType * component = m_ComponentVector[i];
+          double                tempSum = 0.;
+          for (SizeValueType j = block * blockSize; j < last; ++j)
+          {
+            tempSum += component->GetWeight(j) * m_CachedFrequencies[j];
+          }
+          blockSums[block * numberOfComponents + i] = tempSum;
+        }
+      });
+  }
+
+  for (unsigned int i = 0; i < numberOfComponents; ++i)
+  {
+    double tempSum = 0.;
 
     if (totalFrequency > NumericTraits<double>::epsilon())
     {
-      for (j = 0; j < sampleSize; ++j)
+      for (SizeValueType block = 0; block < numberOfBlocks; ++block)
       {
-        tempSum += (m_ComponentVector[static_cast<unsigned int>(i)]->GetWeight(static_cast<unsigned int>(j)) *
-                    m_Sample->GetFrequency(static_cast<unsigned int>(j)));
+        tempSum += blockSums[block * numberOfComponents + i];
       }
 
       tempSum /= totalFrequency;
     }
 
-    if (Math::NotAlmostEquals(tempSum, m_Proportions[static_cast<unsigned int>(i)]))
+    if (Math::NotAlmostEquals(tempSum, m_Proportions[i]))
     {
-      m_Proportions[static_cast<unsigned int>(i)] = tempSum;
+      m_Proportions[i] = tempSum;
       updated = true;
     }
   }
@@ -314,12 +337,56 @@ ExpectationMaximizationMixtureModelEstimator<TSample>::UpdateProportions()
   return updated;
 }
 
+template <typename TSample>
+void
+ExpectationMaximizationMixtureModelEstimator<TSample>::ProcessBlocks(
+  SizeValueType                                        numberOfBlocks,
+  const MultiThreaderBase::ArrayThreadingFunctorType & blockFunction)
+{
+  if (m_NumberOfWorkUnits == 1)
+  {
+    for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+    {
+      blockFunction(block);
+    }
+    return;
+  }
+
+  m_MultiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  m_MultiThreader->ParallelizeArray(0, numberOfBlocks, blockFunction, nullptr);
+}
+
+template <typename TSample>
+void
+ExpectationMaximizationMixtureModelEstimator<TSample>::CacheSample()
+{
+  const SizeValueType size = m_Sample->Size();
+  const unsigned int  measurementVectorSize = m_Sample->GetMeasurementVectorSize();
+
+  m_CachedMeasurements.resize(size * measurementVectorSize);
+  m_CachedFrequencies.resize(size);
+
+  typename TSample::ConstIterator iter = m_Sample->Begin();
+  typename TSample::ConstIterator last = m_Sample->End();
+  for (SizeValueType i = 0; iter != last; ++iter, ++i)
+  {
+    const MeasurementVectorType & mvector = iter.GetMeasurementVector();
+    for (unsigned int d = 0; d < measurementVectorSize; ++d)
+    {
+      m_CachedMeasurements[d * size + i] = mvector[d];
+    }
+    m_CachedFrequencies[i] = static_cast<double>(iter.GetFrequency());
+  }
+}
+
 template <typename TSample>
 void
 ExpectationMaximizationMixtureModelEstimator<TSample>::GenerateData()
 {
   m_Proportions = m_InitialProportions;
 
+  this->CacheSample();
+
   int iteration = 0;
   m_CurrentIteration = 0;
   while (iteration < m_MaxIteration)
@@ -339,6 +406,9 @@ ExpectationMaximizationMixtureModelEstimator<TSample>::GenerateData()
   }
 
   m_TerminationCode = TERMINATION_CODE_ENUM::NOT_CONVERGED;
+
+  std::vector<MeasurementType>().swap(m_CachedMeasurements);
+  std::vector<double>().swap(m_CachedFrequencies);
 }
 
 template <typename TSample>
@@ -36,6 +36,12 @@ namespace Statistics
  * On every iteration of EM estimation, this class's GenerateData
  * method is called to compute the new distribution parameters.
  *
+ * The weighted mean and covariance matrix are computed in one pass over
+ * the sample. The measurement vectors are read in chunks, whose weighted
+ * sums are accumulated in parallel by blocks, relative to the previous
+ * mean. The sums of the blocks are then added in order, so that the result
+ * does not depend on the number of threads.
+ *
  * <b>Recent API changes:</b>
  * The static const macro to get the length of a measurement vector,
  * \c MeasurementVectorSize  has been removed to allow the length of a measurement
@@ -106,6 +112,11 @@ protected:
   GenerateData() override;
 
 private:
+  /** Computes the weighted mean and covariance matrix of the sample. */
+  void
+  ComputeWeightedMeanAndCovariance(typename MeanEstimatorType::MeasurementVectorType & mean,
+                                   typename CovarianceEstimatorType::MatrixType &      covariance) const;
+
   typename NativeMembershipFunctionType::Pointer m_GaussianMembershipFunction;
 
   typename MeanEstimatorType::MeasurementVectorType m_Mean;
@@ -22,6 +22,7 @@
 
 #include "itkGaussianMixtureModelComponent.h"
 #include "itkMath.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -170,28 +171,129 @@ GaussianMixtureModelComponent<TSample>::CalculateParametersChange()
 
 template <typename TSample>
 void
-GaussianMixtureModelComponent<TSample>::GenerateData()
+GaussianMixtureModelComponent<TSample>::ComputeWeightedMeanAndCovariance(
+  typename MeanEstimatorType::MeasurementVectorType & mean,
+  typename CovarianceEstimatorType::MatrixType &      covariance) const
 {
-  MeasurementVectorSizeType measurementVectorSize = this->GetSample()->GetMeasurementVectorSize();
+  const TSample *                 sample = this->GetSample();
+  const WeightArrayType &         weights = this->GetWeights();
+  const MeasurementVectorSizeType measurementVectorSize = sample->GetMeasurementVectorSize();
+
+  // Each accumulator holds the sum of the weights, the sum of the squared
+  // weights, the weighted sums of the measurements minus the previous mean,
+  // and the weighted sums of their products (lower triangle).
+  const SizeValueType numberOfProducts = measurementVectorSize * (measurementVectorSize + 1) / 2;
+  const SizeValueType accumulatorSize = 2 + measurementVectorSize + numberOfProducts;
+  std::vector<double> total(accumulatorSize, 0.0);
+
+  std::vector<double> shift(measurementVectorSize);
+  for (unsigned int d = 0; d < measurementVectorSize; ++d)
+  {
+    shift[d] = m_Mean[d];
+  }
 
-  this->AreParametersModified(false);
+  constexpr SizeValueType blockSize = 1024;
+  constexpr SizeValueType chunkSize = 64 * blockSize;
+  std::vector<double>     chunkMeasurements(chunkSize * measurementVectorSize);
+  std::vector<double>     chunkWeights(chunkSize);
+  std::vector<double>     blockAccumulators;
 
-  const WeightArrayType & weights = this->GetWeights();
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
 
-  typename TSample::ConstIterator iter = this->GetSample()->Begin();
-  typename TSample::ConstIterator end = this->GetSample()->End();
+  typename TSample::ConstIterator iter = sample->Begin();
+  typename TSample::ConstIterator end = sample->End();
+  SizeValueType                   sampleVectorIndex = 0;
+  while (iter != end)
+  {
+    // Copy a chunk of the measurement vectors, relative to the previous mean.
+    SizeValueType count = 0;
+    for (; iter != end && count < chunkSize; ++iter, ++count, ++sampleVectorIndex)
+    {
+      const typename TSample::MeasurementVectorType & measurements = iter.GetMeasurementVector();
+      for (unsigned int d = 0; d < measurementVectorSize; ++d)
+      {
+        chunkMeasurements[count * measurementVectorSize + d] = static_cast<double>(measurements[d]) - shift[d];
+      }
+      chunkWeights[count] = weights[sampleVectorIndex] * static_cast<double>(iter.GetFrequency());
+    }
 
-  typename TSample::MeasurementVectorType measurements;
+    const SizeValueType numberOfBlocks = (count + blockSize - 1) / blockSize;
+    blockAccumulators.assign(numberOfBlocks * accumulatorSize, 0.0);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        double *            accumulator = &blockAccumulators[block * accumulatorSize];
+        const SizeValueType last = std::min(count, (block + 1) * blockSize);
+        for (SizeValueType n = block * blockSize; n < last; ++n)
+        {
+          const double   weight = chunkWeights[n];
+          const double * x = &chunkMeasurements[n * measurementVectorSize];
+          accumulator[0] += weight;
+          accumulator[1] += weight * weight;
+          double * sums = accumulator + 2;
+          double * products = sums + measurementVectorSize;
+          for (unsigned int row = 0; row < measurementVectorSize; ++row)
+          {
+            const double weightedValue = weight * x[row];
+            sums[row] += weightedValue;
+            for (unsigned int col = 0; col <= row; ++col)
+            {
+              *products++ += weightedValue * x[col];
+            }
+          }
+        }
+      },
+      nullptr);
 
-  // why these lines???
-  while (iter != end)
+    for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+    {
+      for (SizeValueType k = 0; k < accumulatorSize; ++k)
+      {
+        total[k] += blockAccumulators[block * accumulatorSize + k];
+      }
+    }
+  }
+
+  const double totalWeight = total[0];
+  if (totalWeight <= itk::Math::eps)
+  {
+    itkExceptionMacro("Total weight was too close to zero. Value = " << totalWeight);
+  }
+  const double normalizationFactor = totalWeight - total[1] / totalWeight;
+  if (normalizationFactor <= itk::Math::eps)
   {
-    measurements = iter.GetMeasurementVector();
-    ++iter;
+    itkExceptionMacro("Normalization factor was too close to zero. Value = " << normalizationFactor);
   }
 
-  m_MeanEstimator->SetWeights(weights);
-  m_MeanEstimator->Update();
+  const double * sums = &total[2];
+  const double * products = sums + measurementVectorSize;
+  NumericTraits<typename MeanEstimatorType::MeasurementVectorType>::SetLength(mean, measurementVectorSize);
+  covariance.SetSize(measurementVectorSize, measurementVectorSize);
+  for (unsigned int row = 0; row < measurementVectorSize; ++row)
+  {
+    mean[row] = shift[row] + sums[row] / totalWeight;
+    for (unsigned int col = 0; col <= row; ++col)
+    {
+      // sum of w (x - mean)(x - mean)^T, from the sums relative to the shift
+      const double value = (*products++ - sums[row] * sums[col] / totalWeight) / normalizationFactor;
+      covariance(row, col) = value;
+      covariance(col, row) = value;
+    }
+  }
+}
+
+template <typename TSample>
+void
+GaussianMixtureModelComponent<TSample>::GenerateData()
+{
+  MeasurementVectorSizeType measurementVectorSize = this->GetSample()->GetMeasurementVectorSize();
+
+  this->AreParametersModified(false);
+
+  typename MeanEstimatorType::MeasurementVectorType meanEstimate;
+  typename CovarianceEstimatorType::MatrixType      covEstimate;
+  this->ComputeWeightedMeanAndCovariance(meanEstimate, covEstimate);
 
   MeasurementVectorSizeType i, j;
   double                    temp;
@@ -200,7 +302,6 @@ GaussianMixtureModelComponent<TSample>::GenerateData()
   ParametersType            parameters = this->GetFullParameters();
   MeasurementVectorSizeType paramIndex = 0;
 
-  typename MeanEstimatorType::MeasurementVectorType meanEstimate = m_MeanEstimator->GetMean();
   for (i = 0; i < measurementVectorSize; i++)
   {
     changes = itk::Math::abs(m_Mean[i] - meanEstimate[i]);
@@ -226,10 +327,6 @@ GaussianMixtureModelComponent<TSample>::GenerateData()
     paramIndex = measurementVectorSize;
   }
 
-  m_CovarianceEstimator->SetWeights(weights);
-  m_CovarianceEstimator->Update();
-  typename CovarianceEstimatorType::MatrixType covEstimate = m_CovarianceEstimator->GetCovarianceMatrix();
-
   changed = false;
   for (i = 0; i < measurementVectorSize; i++)
   {
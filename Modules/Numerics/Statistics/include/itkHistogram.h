@@ -150,6 +150,15 @@ public:
   bool
   GetIndex(const MeasurementVectorType & measurement, IndexType & index) const;
 
+  /** Get the index of the bin along the specified dimension corresponding
+   *  to the specified measurement value. Returns true if index is valid and
+   *  false if the measurement is outside the histogram. The index is
+   *  computed in constant time when the bins along the dimension are the
+   *  equal size bins created by Initialize(), and with a binary search
+   *  otherwise. */
+  bool
+  GetIndex(unsigned int dimension, MeasurementType measurement, IndexValueType & index) const;
+
   /** Get the index that is uniquely labelled by an instance identifier
    * The corresponding id is the offset of the index
    * This method uses ImageBase::ComputeIndex() method */
@@ -525,6 +534,10 @@ private:
   // upper bound of each bin
   std::vector<std::vector<MeasurementType>> m_Max;
 
+  // inverse of the width of the bins along each dimension, or zero when the
+  // bins are not contiguous bins of equal size
+  std::vector<double> m_InverseBinWidths;
+
   mutable MeasurementVectorType m_TempMeasurementVector;
   mutable IndexType             m_TempIndex;
 
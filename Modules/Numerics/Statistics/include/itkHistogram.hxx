@@ -90,6 +90,7 @@ Histogram<TMeasurement, TFrequencyContainer>::SetBinMin(unsigned int       dimen
                                                         MeasurementType    min)
 {
   m_Min[dimension][nbin] = min;
+  m_InverseBinWidths[dimension] = 0.0;
 }
 
 template <typename TMeasurement, typename TFrequencyContainer>
@@ -99,6 +100,7 @@ Histogram<TMeasurement, TFrequencyContainer>::SetBinMax(unsigned int       dimen
                                                         MeasurementType    max)
 {
   m_Max[dimension][nbin] = max;
+  m_InverseBinWidths[dimension] = 0.0;
 }
 
 template <typename TMeasurement, typename TFrequencyContainer>
@@ -192,6 +194,8 @@ Histogram<TMeasurement, TFrequencyContainer>::Initialize(const SizeType & size)
     m_Max[dim].resize(m_Size[dim]);
   }
 
+  m_InverseBinWidths.assign(this->GetMeasurementVectorSize(), 0.0);
+
   // initialize auxiliary variables
   this->m_TempIndex.SetSize(this->GetMeasurementVectorSize());
   this->m_TempMeasurementVector.SetSize(this->GetMeasurementVectorSize());
@@ -231,6 +235,23 @@ Histogram<TMeasurement, TFrequencyContainer>::Initialize(const SizeType &
       }
       this->SetBinMin(i, size[i] - 1, (MeasurementType)(lowerBound[i] + (((float)size[i] - 1) * interval)));
       this->SetBinMax(i, size[i] - 1, (MeasurementType)(upperBound[i]));
+
+      // The index is computed in constant time only if the bins are still
+      // contiguous and not empty once rounded to the measurement type
+      bool contiguous = true;
+      for (SizeValueType j = 0; j < size[i]; j++)
+      {
+        if (!(m_Min[i][j] < m_Max[i][j]) || (j + 1 < size[i] && Math::NotExactlyEquals(m_Max[i][j], m_Min[i][j + 1])))
+        {
+          contiguous = false;
+          break;
+        }
+      }
+      if (contiguous)
+      {
+        m_InverseBinWidths[i] = static_cast<double>(size[i]) /
+                                (static_cast<double>(m_Max[i][size[i] - 1]) - static_cast<double>(m_Min[i][0]));
+      }
     }
   }
 }
@@ -241,91 +262,114 @@ bool
 Histogram<TMeasurement, TFrequencyContainer>::GetIndex(const MeasurementVectorType & measurement,
                                                        IndexType &                   index) const
 {
-  // now using something similar to binary search to find
-  // index.
-  unsigned int       dim;
   const unsigned int measurementVectorSize = this->GetMeasurementVectorSize();
   if (index.Size() != measurementVectorSize)
   {
     index.SetSize(measurementVectorSize);
   }
 
-  IndexValueType begin;
-  IndexValueType mid;
-  IndexValueType end;
+  for (unsigned int dim = 0; dim < measurementVectorSize; dim++)
+  {
+    if (!this->GetIndex(dim, measurement[dim], index[dim]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
-  MeasurementType median;
-  MeasurementType tempMeasurement;
+template <typename TMeasurement, typename TFrequencyContainer>
+bool
+Histogram<TMeasurement, TFrequencyContainer>::GetIndex(unsigned int     dimension,
+                                                       MeasurementType  measurement,
+                                                       IndexValueType & index) const
+{
+  IndexValueType begin = 0;
+  if (measurement < m_Min[dimension][begin])
+  {
+    // one of measurement is below the minimum
+    // its ok if we extend the bins to infinity.. not ok if we don't
+    if (!m_ClipBinsAtEnds)
+    {
+      index = (IndexValueType)0;
+      return true;
+    }
+    else
+    { // set an illegal value and return 0
+      index = (IndexValueType)m_Size[dimension];
+      return false;
+    }
+  }
 
-  for (dim = 0; dim < measurementVectorSize; dim++)
+  IndexValueType end = static_cast<IndexValueType>(m_Min[dimension].size()) - 1;
+  if (measurement >= m_Max[dimension][end])
   {
-    tempMeasurement = measurement[dim];
-    begin = 0;
-    if (tempMeasurement < m_Min[dim][begin])
+    // one of measurement is above the maximum
+    // its ok if we extend the bins to infinity.. not ok if we don't
+    // Need to include the last endpoint in the last bin.
+    if (!m_ClipBinsAtEnds || Math::AlmostEquals(measurement, m_Max[dimension][end]))
     {
-      // one of measurement is below the minimum
-      // its ok if we extend the bins to infinity.. not ok if we don't
-      if (!m_ClipBinsAtEnds)
-      {
-        index[dim] = (IndexValueType)0;
-        continue;
-      }
-      else
-      { // set an illegal value and return 0
-        index[dim] = (IndexValueType)m_Size[dim];
-        return false;
-      }
+      index = (IndexValueType)m_Size[dimension] - 1;
+      return true;
+    }
+    else
+    { // set an illegal value and return 0
+      index = (IndexValueType)m_Size[dimension];
+      return false;
     }
+  }
 
-    end = static_cast<IndexValueType>(m_Min[dim].size()) - 1;
-    if (tempMeasurement >= m_Max[dim][end])
+  // Equal size bins: the bin is computed from the measurement, and then
+  // moved to the neighbor bin if the rounding of the bounds of the bins
+  // disagrees. A NaN measurement falls back to the binary search.
+  const double inverseBinWidth = m_InverseBinWidths[dimension];
+  if (inverseBinWidth > 0.0 && measurement >= m_Min[dimension][0])
+  {
+    IndexValueType bin = static_cast<IndexValueType>(
+      (static_cast<double>(measurement) - static_cast<double>(m_Min[dimension][0])) * inverseBinWidth);
+    bin = std::min(bin, end);
+    while (measurement < m_Min[dimension][bin])
     {
-      // one of measurement is above the maximum
-      // its ok if we extend the bins to infinity.. not ok if we don't
-      // Need to include the last endpoint in the last bin.
-      if (!m_ClipBinsAtEnds || Math::AlmostEquals(tempMeasurement, m_Max[dim][end]))
-      {
-        index[dim] = (IndexValueType)m_Size[dim] - 1;
-        continue;
-      }
-      else
-      { // set an illegal value and return 0
-        index[dim] = (IndexValueType)m_Size[dim];
-        return false;
-      }
+      --bin;
+    }
+    while (measurement >= m_Max[dimension][bin])
+    {
+      ++bin;
     }
+    index = bin;
+    return true;
+  }
 
-    // Binary search for the bin where this measurement could be
-    mid = (end + 1) / 2;
-    median = m_Min[dim][mid];
+  // Binary search for the bin where this measurement could be
+  IndexValueType  mid = (end + 1) / 2;
+  MeasurementType median = m_Min[dimension][mid];
 
-    while (true)
+  while (true)
+  {
+    if (measurement < median)
     {
-      if (tempMeasurement < median)
-      {
-        end = mid - 1;
-      }
-      else if (tempMeasurement > median)
-      {
-        // test whether it is inside the current bin by comparing to the max of
-        // this bin.
-        if (tempMeasurement < m_Max[dim][mid] && tempMeasurement >= m_Min[dim][mid])
-        {
-          index[dim] = mid;
-          break;
-        }
-        // otherwise, continue binary search
-        begin = mid + 1;
-      }
-      else
+      end = mid - 1;
+    }
+    else if (measurement > median)
+    {
+      // test whether it is inside the current bin by comparing to the max of
+      // this bin.
+      if (measurement < m_Max[dimension][mid] && measurement >= m_Min[dimension][mid])
       {
-        index[dim] = mid;
+        index = mid;
         break;
       }
-      mid = begin + (end - begin) / 2;
-      median = m_Min[dim][mid];
-    } // end of while
-  }   // end of for()
+      // otherwise, continue binary search
+      begin = mid + 1;
+    }
+    else
+    {
+      index = mid;
+      break;
+    }
+    mid = begin + (end - begin) / 2;
+    median = m_Min[dimension][mid];
+  } // end of while
   return true;
 }
 
@@ -707,6 +751,7 @@ Histogram<TMeasurement, TFrequencyContainer>::Graft(const DataObject * thatObjec
     this->m_NumberOfInstances = that->m_NumberOfInstances;
     this->m_Min = that->m_Min;
     this->m_Max = that->m_Max;
+    this->m_InverseBinWidths = that->m_InverseBinWidths;
     this->m_TempMeasurementVector = that->m_TempMeasurementVector;
     this->m_TempIndex = that->m_TempIndex;
     this->m_ClipBinsAtEnds = that->m_ClipBinsAtEnds;
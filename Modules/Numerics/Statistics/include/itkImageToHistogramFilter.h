@@ -18,7 +18,9 @@
 #ifndef itkImageToHistogramFilter_h
 #define itkImageToHistogramFilter_h
 
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 #include "itkHistogram.h"
 #include "itkImageSink.h"
@@ -41,7 +43,14 @@ namespace Statistics
  * AutoMinimumMaximum is off and the NumberOfStreamDivisions is set to more than
  * one, then this filter streams its input in a series of requested
  * regions. A histogram is computed for each streamed and threaded
- * region then merged.
+ * region then merged. The histograms of the threads which have the bins of
+ * the output histogram are merged bin by bin with atomic additions, without
+ * locking; the others are merged into m_MergeHistogram under m_Mutex.
+ *
+ * When the components of the pixels are 8 or 16 bits integers, the
+ * contribution of each value of each component to the bin of a pixel is
+ * computed once in a lookup table, and the pixels are binned with table
+ * lookups instead of searches in the bins of the histogram.
  *
  * \ingroup ITKStatistics
  */
@@ -169,22 +178,44 @@ protected:
   virtual void
   ThreadedComputeMinimumAndMaximum(const RegionType & inputRegionForThread);
 
-
+  /** Merges the histogram of a thread into the output histogram. Every
+   * thread histogram, including those of the lookup table binning, goes
+   * through this method. A histogram with the bins of the output histogram is
+   * added to m_MergeFrequencies, any other histogram is merged into
+   * m_MergeHistogram, which is grafted to the output by
+   * AfterStreamedGenerateData(). */
   virtual void
   ThreadedMergeHistogram(HistogramPointer && histogram);
 
+  using HistogramInstanceIdentifier = typename HistogramType::InstanceIdentifier;
+  using HistogramFrequencyType = typename HistogramType::AbsoluteFrequencyType;
+
   std::mutex m_Mutex;
 
   HistogramPointer m_MergeHistogram;
 
+  /** Frequencies of the merged histograms, indexed by the instance
+   * identifiers of the output histogram */
+  std::vector<std::atomic<HistogramFrequencyType>> m_MergeFrequencies;
+
   HistogramMeasurementVectorType m_Minimum;
   HistogramMeasurementVectorType m_Maximum;
 
 private:
+  /** Computes the lookup table of the offsets of the instance identifiers of
+   * the bins of the values of the components */
+  void
+  InitializeBinOffsets();
+
   void
   ApplyMarginalScale(HistogramMeasurementVectorType & min,
                      HistogramMeasurementVectorType & max,
                      HistogramSizeType &              size);
+
+  /** Offset of the instance identifier of the bin of each value of each
+   * component, or the maximum instance identifier for the values outside the
+   * histogram. Empty when the pixels are binned with the histogram. */
+  std::vector<HistogramInstanceIdentifier> m_BinOffsets;
 };
 } // end of namespace Statistics
 } // end of namespace itk
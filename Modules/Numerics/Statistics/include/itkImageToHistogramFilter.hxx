@@ -179,6 +179,60 @@ ImageToHistogramFilter<TImage>::InitializeOutputHistogram()
 
   outputHistogram->SetMeasurementVectorSize(nbOfComponents);
   outputHistogram->Initialize(size, m_Minimum, m_Maximum);
+
+  m_MergeFrequencies = std::vector<std::atomic<HistogramFrequencyType>>(outputHistogram->Size());
+  for (auto & frequency : m_MergeFrequencies)
+  {
+    frequency.store(0, std::memory_order_relaxed);
+  }
+
+  this->InitializeBinOffsets();
+}
+
+
+template <typename TImage>
+void
+ImageToHistogramFilter<TImage>::InitializeBinOffsets()
+{
+  m_BinOffsets.clear();
+  if (!std::is_integral<ValueType>::value || sizeof(ValueType) > 2)
+  {
+    return;
+  }
+
+  // The table is only worth computing if there are more pixels than values
+  const auto          minimumValue = static_cast<int64_t>(NumericTraits<ValueType>::NonpositiveMin());
+  const SizeValueType numberOfValues =
+    static_cast<SizeValueType>(static_cast<int64_t>(NumericTraits<ValueType>::max()) - minimumValue + 1);
+  if (this->GetInput()->GetLargestPossibleRegion().GetNumberOfPixels() < numberOfValues)
+  {
+    return;
+  }
+
+  const HistogramType * outputHistogram = this->GetOutput();
+  const unsigned int    nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  m_BinOffsets.resize(nbOfComponents * numberOfValues);
+
+  typename HistogramType::IndexType index(nbOfComponents);
+  for (unsigned int i = 0; i < nbOfComponents; i++)
+  {
+    index.Fill(0);
+    index[i] = 1;
+    const HistogramInstanceIdentifier stride = outputHistogram->GetInstanceIdentifier(index);
+    for (SizeValueType v = 0; v < numberOfValues; v++)
+    {
+      const auto value = static_cast<HistogramMeasurementType>(static_cast<ValueType>(minimumValue + v));
+      IndexValueType binIndex;
+      if (outputHistogram->GetIndex(i, value, binIndex))
+      {
+        m_BinOffsets[i * numberOfValues + v] = static_cast<HistogramInstanceIdentifier>(binIndex) * stride;
+      }
+      else
+      {
+        m_BinOffsets[i * numberOfValues + v] = NumericTraits<HistogramInstanceIdentifier>::max();
+      }
+    }
+  }
 }
 
 
@@ -189,8 +243,31 @@ ImageToHistogramFilter<TImage>::AfterStreamedGenerateData()
   Superclass::AfterStreamedGenerateData();
 
   HistogramType * outputHistogram = this->GetOutput();
-  outputHistogram->Graft(m_MergeHistogram);
+  if (m_MergeHistogram.IsNull())
+  {
+    for (HistogramInstanceIdentifier id = 0; id < m_MergeFrequencies.size(); id++)
+    {
+      outputHistogram->SetFrequency(id, m_MergeFrequencies[id].load(std::memory_order_relaxed));
+    }
+  }
+  else
+  {
+    // some histograms did not have the bins of the output histogram: add the
+    // frequencies merged bin by bin to their merged histogram
+    typename HistogramType::IndexType index;
+    for (HistogramInstanceIdentifier id = 0; id < m_MergeFrequencies.size(); id++)
+    {
+      const HistogramFrequencyType frequency = m_MergeFrequencies[id].load(std::memory_order_relaxed);
+      if (frequency != 0 && m_MergeHistogram->GetIndex(outputHistogram->GetMeasurementVector(id), index))
+      {
+        m_MergeHistogram->IncreaseFrequencyOfIndex(index, frequency);
+      }
+    }
+    outputHistogram->Graft(m_MergeHistogram);
+  }
   m_MergeHistogram = nullptr;
+  m_MergeFrequencies = std::vector<std::atomic<HistogramFrequencyType>>();
+  m_BinOffsets = std::vector<HistogramInstanceIdentifier>();
 }
 
 
@@ -235,6 +312,56 @@ ImageToHistogramFilter<TImage>::ThreadedStreamedGenerateData(const RegionType &
   const unsigned int    nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
   const HistogramType * outputHistogram = this->GetOutput();
 
+  if (!m_BinOffsets.empty())
+  {
+    // The instance identifier of the bin of a pixel is the sum of the offsets
+    // of the values of its components
+    const auto          minimumValue = static_cast<int64_t>(NumericTraits<ValueType>::NonpositiveMin());
+    const SizeValueType numberOfValues = m_BinOffsets.size() / nbOfComponents;
+    std::vector<HistogramFrequencyType> frequencies(outputHistogram->Size(), 0);
+    std::vector<ValueType>              values(nbOfComponents);
+
+    ImageRegionConstIterator<TImage> inputIt(this->GetInput(), inputRegionForThread);
+    inputIt.GoToBegin();
+    while (!inputIt.IsAtEnd())
+    {
+      const PixelType & p = inputIt.Get();
+      NumericTraits<PixelType>::AssignToArray(p, values);
+      HistogramInstanceIdentifier id = 0;
+      unsigned int                i = 0;
+      for (; i < nbOfComponents; i++)
+      {
+        const HistogramInstanceIdentifier offset =
+          m_BinOffsets[i * numberOfValues + static_cast<SizeValueType>(static_cast<int64_t>(values[i]) - minimumValue)];
+        if (offset == NumericTraits<HistogramInstanceIdentifier>::max())
+        {
+          break;
+        }
+        id += offset;
+      }
+      if (i == nbOfComponents)
+      {
+        ++frequencies[id];
+      }
+      ++inputIt;
+    }
+
+    HistogramPointer histogram = HistogramType::New();
+    histogram->SetClipBinsAtEnds(outputHistogram->GetClipBinsAtEnds());
+    histogram->SetMeasurementVectorSize(nbOfComponents);
+    histogram->Initialize(outputHistogram->GetSize(), m_Minimum, m_Maximum);
+    for (HistogramInstanceIdentifier id = 0; id < frequencies.size(); id++)
+    {
+      if (frequencies[id] != 0)
+      {
+        histogram->SetFrequency(id, frequencies[id]);
+      }
+    }
+
+    this->ThreadedMergeHistogram(std::move(histogram));
+    return;
+  }
+
   HistogramPointer histogram = HistogramType::New();
   histogram->SetClipBinsAtEnds(outputHistogram->GetClipBinsAtEnds());
   histogram->SetMeasurementVectorSize(nbOfComponents);
@@ -250,8 +377,10 @@ ImageToHistogramFilter<TImage>::ThreadedStreamedGenerateData(const RegionType &
   {
     const PixelType & p = inputIt.Get();
     NumericTraits<PixelType>::AssignToArray(p, m);
-    histogram->GetIndex(m, index);
-    histogram->IncreaseFrequencyOfIndex(index, 1);
+    if (histogram->GetIndex(m, index))
+    {
+      histogram->IncreaseFrequencyOfIndex(index, 1);
+    }
     ++inputIt;
   }
 
@@ -262,6 +391,24 @@ template <typename TImage>
 void
 ImageToHistogramFilter<TImage>::ThreadedMergeHistogram(HistogramPointer && histogram)
 {
+  const HistogramType * outputHistogram = this->GetOutput();
+  if (histogram->GetSize() == outputHistogram->GetSize() && histogram->GetMins() == outputHistogram->GetMins() &&
+      histogram->GetMaxs() == outputHistogram->GetMaxs())
+  {
+    // the bins are those of the output histogram: add the frequencies bin by
+    // bin, without locking
+    const HistogramInstanceIdentifier size = histogram->Size();
+    for (HistogramInstanceIdentifier id = 0; id < size; id++)
+    {
+      const HistogramFrequencyType frequency = histogram->GetFrequency(id);
+      if (frequency != 0)
+      {
+        m_MergeFrequencies[id].fetch_add(frequency, std::memory_order_relaxed);
+      }
+    }
+    return;
+  }
+
   while (true)
   {
 
@@ -18,6 +18,7 @@
 #ifndef itkKdTree_h
 #define itkKdTree_h
 
+#include <mutex>
 #include <queue>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include "itkSize.h"
 #include "itkObject.h"
 #include "itkArray.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itkSubsample.h"
 
@@ -511,6 +513,15 @@ private:
  * GetSearchResult method returns a pointer to a NearestNeighbors object
  * with k-nearest neighbors.
  *
+ * When the root is set, the tree is also stored in a compact layout: an
+ * array of nodes in depth first order, whose instance identifiers and
+ * measurement vectors are copied contiguously. The Search methods taking a
+ * std::vector of query points search it for many queries in parallel, each
+ * work unit with its own bounds and neighbor buffers. They return the same
+ * neighbors as the Search methods of a single query point, and don't read
+ * the sample, so that they may be used with any sample. The measurement
+ * vectors copied are those of the sample when the root is set.
+ *
  * <b>Recent API changes:</b>
  * The static const macro to get the length of a measurement vector,
  * 'MeasurementVectorSize'  has been removed to allow the length of a measurement
@@ -700,6 +711,7 @@ public:
       this->DeleteNode(this->m_Root);
     }
     this->m_Root = root;
+    this->Modified();
   }
 
   /** Returns the pointer to the root node. */
@@ -746,6 +758,25 @@ public:
   void
   Search(const MeasurementVectorType &, double, InstanceIdentifierVectorType &) const;
 
+  /** Searches the k-nearest neighbors of each query point, in parallel.
+   * The neighbors of queries[i] are returned in result[i]. */
+  void
+  Search(const std::vector<MeasurementVectorType> &, unsigned int, std::vector<InstanceIdentifierVectorType> &) const;
+
+  /** Searches the k-nearest neighbors of each query point, in parallel,
+   * and returns the distances to the neighbors of queries[i] in
+   * distances[i]. */
+  void
+  Search(const std::vector<MeasurementVectorType> &,
+         unsigned int,
+         std::vector<InstanceIdentifierVectorType> &,
+         std::vector<std::vector<double>> &) const;
+
+  /** Searches the neighbors fallen into a hypersphere around each query
+   * point, in parallel. */
+  void
+  Search(const std::vector<MeasurementVectorType> &, double, std::vector<InstanceIdentifierVectorType> &) const;
+
   /** Returns true if the intermediate k-nearest neighbors exist within
    * the the bounding box defined by the lowerBound and the
    * upperBound. Otherwise returns false. Returns false if the ball
@@ -811,7 +842,79 @@ protected:
              MeasurementVectorType &,
              InstanceIdentifierVectorType &) const;
 
+  /** search loop of the compact layout */
+  int
+  CompactNearestNeighborSearchLoop(InstanceIdentifier,
+                                   const MeasurementVectorType &,
+                                   MeasurementVectorType &,
+                                   MeasurementVectorType &,
+                                   NearestNeighbors &) const;
+
+  /** search loop of the compact layout */
+  int
+  CompactSearchLoop(InstanceIdentifier,
+                    const MeasurementVectorType &,
+                    double,
+                    MeasurementVectorType &,
+                    MeasurementVectorType &,
+                    InstanceIdentifierVectorType &) const;
+
 private:
+  /** Node of the compact layout. The left child of a nonterminal node
+   * follows it, and m_Right is the index of its right child, or 0 for a
+   * terminal node. [m_BeginIndex, m_EndIndex) is the range of the instance
+   * identifiers of the node: those of the bucket of a terminal node, or the
+   * one of the median of a nonterminal node. */
+  struct CompactNodeType
+  {
+    MeasurementType m_PartitionValue;
+    unsigned int       m_PartitionDimension;
+    InstanceIdentifier m_Right;
+    InstanceIdentifier m_BeginIndex;
+    InstanceIdentifier m_EndIndex;
+  };
+
+  /** Builds the compact layout of the tree from the root node, if it is
+   * missing or older than the last modification of the tree. Called by the
+   * batch searches, the searches of a single query use the nodes. */
+  void
+  UpdateCompactTree() const;
+
+  /** Builds the compact layout of the tree from the root node. */
+  void
+  BuildCompactTree() const;
+
+  /** Appends the node and its descendants to the compact layout. */
+  void
+  AppendCompactNode(const KdTreeNodeType *) const;
+
+  /** Searches the k-nearest neighbors of the queries, and their distances
+   * if distances isn't null. */
+  void
+  BatchNearestNeighborSearch(const std::vector<MeasurementVectorType> &,
+                             unsigned int,
+                             std::vector<InstanceIdentifierVectorType> &,
+                             std::vector<std::vector<double>> *) const;
+
+  /** Sets the bounds of a search to the whole space. */
+  void
+  InitializeSearchBounds(MeasurementVectorType &, MeasurementVectorType &) const;
+
+  /** Returns the distance between the query and the index-th measurement
+   * vector of the compact layout. */
+  double
+  CompactDistance(const MeasurementVectorType & query, InstanceIdentifier index) const
+  {
+    const MeasurementType * measurement = &m_CompactMeasurements[SizeValueType{ index } * m_MeasurementVectorSize];
+    double                  sumOfSquares = NumericTraits<double>::ZeroValue();
+    for (unsigned int d = 0; d < m_MeasurementVectorSize; ++d)
+    {
+      const double temp = query[d] - measurement[d];
+      sumOfSquares += temp * temp;
+    }
+    return std::sqrt(sumOfSquares);
+  }
+
   /** Pointer to the input sample */
   const TSample * m_Sample;
 
@@ -829,6 +932,21 @@ private:
 
   /** Measurement vector size */
   MeasurementVectorSizeType m_MeasurementVectorSize;
+
+  /** Nodes of the compact layout, in depth first order. */
+  mutable std::vector<CompactNodeType> m_CompactNodes;
+
+  /** Instance identifiers of the nodes of the compact layout. */
+  mutable InstanceIdentifierVectorType m_CompactInstanceIdentifiers;
+
+  /** Measurement vectors of m_CompactInstanceIdentifiers, one after the
+   * other. */
+  mutable std::vector<MeasurementType> m_CompactMeasurements;
+
+  /** Root and time of the last build of the compact layout. */
+  mutable const KdTreeNodeType * m_CompactRoot{ nullptr };
+  mutable TimeStamp              m_CompactTreeBuildTime;
+  mutable std::mutex             m_CompactTreeMutex;
 }; // end of class
 } // end of namespace Statistics
 } // end of namespace itk
@@ -454,6 +454,384 @@ KdTree<TSample>::SearchLoop(const KdTreeNodeType *         node,
   return 0;
 }
 
+template <typename TSample>
+void
+KdTree<TSample>::UpdateCompactTree() const
+{
+  const std::lock_guard<std::mutex> lock(this->m_CompactTreeMutex);
+  if (this->m_CompactRoot != this->m_Root || this->m_CompactTreeBuildTime < this->GetMTime())
+  {
+    this->BuildCompactTree();
+    this->m_CompactRoot = this->m_Root;
+    this->m_CompactTreeBuildTime.Modified();
+  }
+}
+
+template <typename TSample>
+void
+KdTree<TSample>::BuildCompactTree() const
+{
+  this->m_CompactNodes.clear();
+  this->m_CompactInstanceIdentifiers.clear();
+  this->m_CompactMeasurements.clear();
+  if (this->m_Root == nullptr || this->m_Sample == nullptr)
+  {
+    return;
+  }
+
+  this->AppendCompactNode(this->m_Root);
+
+  this->m_CompactMeasurements.resize(this->m_CompactInstanceIdentifiers.size() * this->m_MeasurementVectorSize);
+  auto measurement = this->m_CompactMeasurements.begin();
+  for (const InstanceIdentifier id : this->m_CompactInstanceIdentifiers)
+  {
+    const MeasurementVectorType & measurementVector = this->m_Sample->GetMeasurementVector(id);
+    for (unsigned int d = 0; d < this->m_MeasurementVectorSize; ++d)
+    {
+      *measurement++ = measurementVector[d];
+    }
+  }
+}
+
+template <typename TSample>
+void
+KdTree<TSample>::AppendCompactNode(const KdTreeNodeType * node) const
+{
+  const InstanceIdentifier nodeIndex = this->m_CompactNodes.size();
+  CompactNodeType          compactNode{};
+  compactNode.m_BeginIndex = this->m_CompactInstanceIdentifiers.size();
+
+  if (node->IsTerminal())
+  {
+    if (node != this->m_EmptyTerminalNode)
+    {
+      for (unsigned int i = 0; i < node->Size(); ++i)
+      {
+        this->m_CompactInstanceIdentifiers.push_back(node->GetInstanceIdentifier(i));
+      }
+    }
+    compactNode.m_EndIndex = this->m_CompactInstanceIdentifiers.size();
+    this->m_CompactNodes.push_back(compactNode);
+    return;
+  }
+
+  node->GetParameters(compactNode.m_PartitionDimension, compactNode.m_PartitionValue);
+  this->m_CompactInstanceIdentifiers.push_back(node->GetInstanceIdentifier(0));
+  compactNode.m_EndIndex = compactNode.m_BeginIndex + 1;
+  this->m_CompactNodes.push_back(compactNode);
+
+  this->AppendCompactNode(node->Left());
+  this->m_CompactNodes[nodeIndex].m_Right = this->m_CompactNodes.size();
+  this->AppendCompactNode(node->Right());
+}
+
+template <typename TSample>
+void
+KdTree<TSample>::InitializeSearchBounds(MeasurementVectorType & lowerBound, MeasurementVectorType & upperBound) const
+{
+  NumericTraits<MeasurementVectorType>::SetLength(lowerBound, this->m_MeasurementVectorSize);
+  NumericTraits<MeasurementVectorType>::SetLength(upperBound, this->m_MeasurementVectorSize);
+
+  for (unsigned int d = 0; d < this->m_MeasurementVectorSize; ++d)
+  {
+    lowerBound[d] = static_cast<MeasurementType>(
+      -std::sqrt(-static_cast<double>(NumericTraits<MeasurementType>::NonpositiveMin())) / 2.0);
+    upperBound[d] =
+      static_cast<MeasurementType>(std::sqrt(static_cast<double>(NumericTraits<MeasurementType>::max()) / 2.0));
+  }
+}
+
+template <typename TSample>
+void
+KdTree<TSample>::Search(const std::vector<MeasurementVectorType> &  queries,
+                        unsigned int                                numberOfNeighborsRequested,
+                        std::vector<InstanceIdentifierVectorType> & results) const
+{
+  this->BatchNearestNeighborSearch(queries, numberOfNeighborsRequested, results, nullptr);
+}
+
+template <typename TSample>
+void
+KdTree<TSample>::Search(const std::vector<MeasurementVectorType> &  queries,
+                        unsigned int                                numberOfNeighborsRequested,
+                        std::vector<InstanceIdentifierVectorType> & results,
+                        std::vector<std::vector<double>> &          distances) const
+{
+  this->BatchNearestNeighborSearch(queries, numberOfNeighborsRequested, results, &distances);
+}
+
+template <typename TSample>
+void
+KdTree<TSample>::BatchNearestNeighborSearch(const std::vector<MeasurementVectorType> &  queries,
+                                            unsigned int                                numberOfNeighborsRequested,
+                                            std::vector<InstanceIdentifierVectorType> & results,
+                                            std::vector<std::vector<double>> *          distances) const
+{
+  this->UpdateCompactTree();
+  if (this->m_CompactNodes.empty())
+  {
+    itkExceptionMacro("The root of the tree has not been set.");
+  }
+  if (numberOfNeighborsRequested > this->m_CompactInstanceIdentifiers.size())
+  {
+    itkExceptionMacro("The numberOfNeighborsRequested for the nearest "
+                      << "neighbor search should be less than or equal to the number of "
+                      << "the measurement vectors.");
+  }
+
+  results.resize(queries.size());
+  if (distances != nullptr)
+  {
+    distances->resize(queries.size());
+  }
+
+  // The queries are searched by blocks, each with its own bounds and
+  // neighbors, which are reused by the queries of the block.
+  constexpr SizeValueType blockSize = 64;
+  const SizeValueType     numberOfBlocks = (queries.size() + blockSize - 1) / blockSize;
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      MeasurementVectorType lowerBound;
+      MeasurementVectorType upperBound;
+      std::vector<double>   neighborDistances;
+      NearestNeighbors      nearestNeighbors(neighborDistances);
+
+      const SizeValueType last = std::min<SizeValueType>((block + 1) * blockSize, queries.size());
+      for (SizeValueType q = block * blockSize; q < last; ++q)
+      {
+        nearestNeighbors.resize(numberOfNeighborsRequested);
+        this->InitializeSearchBounds(lowerBound, upperBound);
+        this->CompactNearestNeighborSearchLoop(0, queries[q], lowerBound, upperBound, nearestNeighbors);
+        results[q] = nearestNeighbors.GetNeighbors();
+        if (distances != nullptr)
+        {
+          (*distances)[q] = neighborDistances;
+        }
+      }
+    },
+    nullptr);
+}
+
+template <typename TSample>
+inline int
+KdTree<TSample>::CompactNearestNeighborSearchLoop(InstanceIdentifier            nodeIndex,
+                                                  const MeasurementVectorType & query,
+                                                  MeasurementVectorType &       lowerBound,
+                                                  MeasurementVectorType &       upperBound,
+                                                  NearestNeighbors &            nearestNeighbors) const
+{
+  const CompactNodeType & node = this->m_CompactNodes[nodeIndex];
+
+  // the bucket of a terminal node, or the median of a nonterminal node
+  for (InstanceIdentifier i = node.m_BeginIndex; i < node.m_EndIndex; ++i)
+  {
+    const double tempDistance = this->CompactDistance(query, i);
+    if (tempDistance < nearestNeighbors.GetLargestDistance())
+    {
+      nearestNeighbors.ReplaceFarthestNeighbor(this->m_CompactInstanceIdentifiers[i], tempDistance);
+    }
+  }
+
+  if (node.m_Right == 0)
+  {
+    // empty terminal node
+    if (node.m_BeginIndex == node.m_EndIndex)
+    {
+      return 0;
+    }
+
+    if (this->BallWithinBounds(query, lowerBound, upperBound, nearestNeighbors.GetLargestDistance()))
+    {
+      return 1;
+    }
+
+    return 0;
+  }
+
+  const unsigned int    partitionDimension = node.m_PartitionDimension;
+  const MeasurementType partitionValue = node.m_PartitionValue;
+  MeasurementType       tempValue;
+
+  if (query[partitionDimension] <= partitionValue)
+  {
+    // search the closer child node
+    tempValue = upperBound[partitionDimension];
+    upperBound[partitionDimension] = partitionValue;
+    if (this->CompactNearestNeighborSearchLoop(nodeIndex + 1, query, lowerBound, upperBound, nearestNeighbors))
+    {
+      return 1;
+    }
+    upperBound[partitionDimension] = tempValue;
+
+    // search the other node, if necessary
+    tempValue = lowerBound[partitionDimension];
+    lowerBound[partitionDimension] = partitionValue;
+    if (this->BoundsOverlapBall(query, lowerBound, upperBound, nearestNeighbors.GetLargestDistance()))
+    {
+      this->CompactNearestNeighborSearchLoop(node.m_Right, query, lowerBound, upperBound, nearestNeighbors);
+    }
+    lowerBound[partitionDimension] = tempValue;
+  }
+  else
+  {
+    // search the closer child node
+    tempValue = lowerBound[partitionDimension];
+    lowerBound[partitionDimension] = partitionValue;
+    if (this->CompactNearestNeighborSearchLoop(node.m_Right, query, lowerBound, upperBound, nearestNeighbors))
+    {
+      return 1;
+    }
+    lowerBound[partitionDimension] = tempValue;
+
+    // search the other node, if necessary
+    tempValue = upperBound[partitionDimension];
+    upperBound[partitionDimension] = partitionValue;
+    if (this->BoundsOverlapBall(query, lowerBound, upperBound, nearestNeighbors.GetLargestDistance()))
+    {
+      this->CompactNearestNeighborSearchLoop(nodeIndex + 1, query, lowerBound, upperBound, nearestNeighbors);
+    }
+    upperBound[partitionDimension] = tempValue;
+  }
+
+  // stop or continue search
+  if (this->BallWithinBounds(query, lowerBound, upperBound, nearestNeighbors.GetLargestDistance()))
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+template <typename TSample>
+void
+KdTree<TSample>::Search(const std::vector<MeasurementVectorType> &  queries,
+                        double                                      radius,
+                        std::vector<InstanceIdentifierVectorType> & results) const
+{
+  this->UpdateCompactTree();
+  if (this->m_CompactNodes.empty())
+  {
+    itkExceptionMacro("The root of the tree has not been set.");
+  }
+
+  results.resize(queries.size());
+
+  constexpr SizeValueType blockSize = 64;
+  const SizeValueType     numberOfBlocks = (queries.size() + blockSize - 1) / blockSize;
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      MeasurementVectorType lowerBound;
+      MeasurementVectorType upperBound;
+
+      const SizeValueType last = std::min<SizeValueType>((block + 1) * blockSize, queries.size());
+      for (SizeValueType q = block * blockSize; q < last; ++q)
+      {
+        this->InitializeSearchBounds(lowerBound, upperBound);
+        results[q].clear();
+        this->CompactSearchLoop(0, queries[q], radius, lowerBound, upperBound, results[q]);
+      }
+    },
+    nullptr);
+}
+
+template <typename TSample>
+inline int
+KdTree<TSample>::CompactSearchLoop(InstanceIdentifier             nodeIndex,
+                                   const MeasurementVectorType &  query,
+                                   double                         radius,
+                                   MeasurementVectorType &        lowerBound,
+                                   MeasurementVectorType &        upperBound,
+                                   InstanceIdentifierVectorType & neighbors) const
+{
+  const CompactNodeType & node = this->m_CompactNodes[nodeIndex];
+
+  // the bucket of a terminal node, or the median of a nonterminal node
+  for (InstanceIdentifier i = node.m_BeginIndex; i < node.m_EndIndex; ++i)
+  {
+    if (this->CompactDistance(query, i) <= radius)
+    {
+      neighbors.push_back(this->m_CompactInstanceIdentifiers[i]);
+    }
+  }
+
+  if (node.m_Right == 0)
+  {
+    // empty terminal node
+    if (node.m_BeginIndex == node.m_EndIndex)
+    {
+      return 0;
+    }
+
+    if (this->BallWithinBounds(query, lowerBound, upperBound, radius))
+    {
+      return 1;
+    }
+
+    return 0;
+  }
+
+  const unsigned int    partitionDimension = node.m_PartitionDimension;
+  const MeasurementType partitionValue = node.m_PartitionValue;
+  MeasurementType       tempValue;
+
+  if (query[partitionDimension] <= partitionValue)
+  {
+    // search the closer child node
+    tempValue = upperBound[partitionDimension];
+    upperBound[partitionDimension] = partitionValue;
+    if (this->CompactSearchLoop(nodeIndex + 1, query, radius, lowerBound, upperBound, neighbors))
+    {
+      return 1;
+    }
+    upperBound[partitionDimension] = tempValue;
+
+    // search the other node, if necessary
+    tempValue = lowerBound[partitionDimension];
+    lowerBound[partitionDimension] = partitionValue;
+    if (this->BoundsOverlapBall(query, lowerBound, upperBound, radius))
+    {
+      this->CompactSearchLoop(node.m_Right, query, radius, lowerBound, upperBound, neighbors);
+    }
+    lowerBound[partitionDimension] = tempValue;
+  }
+  else
+  {
+    // search the closer child node
+    tempValue = lowerBound[partitionDimension];
+    lowerBound[partitionDimension] = partitionValue;
+    if (this->CompactSearchLoop(node.m_Right, query, radius, lowerBound, upperBound, neighbors))
+    {
+      return 1;
+    }
+    lowerBound[partitionDimension] = tempValue;
+
+    // search the other node, if necessary
+    tempValue = upperBound[partitionDimension];
+    upperBound[partitionDimension] = partitionValue;
+    if (this->BoundsOverlapBall(query, lowerBound, upperBound, radius))
+    {
+      this->CompactSearchLoop(nodeIndex + 1, query, radius, lowerBound, upperBound, neighbors);
+    }
+    upperBound[partitionDimension] = tempValue;
+  }
+
+  // stop or continue search
+  if (this->BallWithinBounds(query, lowerBound, upperBound, radius))
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
 template <typename TSample>
 inline bool
 KdTree<TSample>::BallWithinBounds(const MeasurementVectorType & query,
@@ -65,6 +65,14 @@ namespace Statistics
  * vector to be specified at run time. It is now obtained from the KdTree set
  * as input. You may query this length using the function GetMeasurementVectorSize().
  *
+ * The filtering of the tree at each iteration is done in parallel: the top
+ * levels of the tree are filtered first, down to the subtrees that are then
+ * filtered by the work units, each with its own sums of the measurement
+ * vectors assigned to the candidates. The sums of the subtrees are added in
+ * order. The measurement vectors of the terminal nodes are copied
+ * contiguously when the optimization starts, so that the sample isn't read
+ * concurrently.
+ *
  * \sa ImageKmeansModelEstimator
  * \sa WeightedCentroidKdTreeGenerator, KdTree
  * \ingroup ITKStatistics
@@ -245,6 +253,7 @@ protected:
 
     /** gets the index-th candidates */
     Candidate & operator[](int index) { return m_Candidates[index]; }
+    const Candidate & operator[](int index) const { return m_Candidates[index]; }
 
   private:
     /** internal storage for the candidates */
@@ -275,7 +284,8 @@ protected:
             MeasurementVectorType & upperBound);
 
   /** recursive pruning algorithm. the validIndexes vector contains
-   * only the indexes of the surviving candidates for the node */
+   * only the indexes of the surviving candidates for the node. The subtrees
+   * below the top levels of the node are filtered in parallel. */
   void
   Filter(KdTreeNodeType *        node,
          std::vector<int>        validIndexes,
@@ -302,6 +312,82 @@ protected:
   PrintPoint(ParameterType & point);
 
 private:
+  /** Subtree to be filtered by a work unit, with its surviving candidates
+   * and its bounds. */
+  struct FilterTask
+  {
+    KdTreeNodeType *      Node;
+    std::vector<int>      ValidIndexes;
+    MeasurementVectorType LowerBound;
+    MeasurementVectorType UpperBound;
+  };
+
+  /** Sums of the measurement vectors assigned to the candidates by the
+   * filtering of a subtree, and the cluster labels assigned. */
+  struct FilterResult
+  {
+    CandidateVector                                 Candidates;
+    std::vector<std::pair<InstanceIdentifier, int>> Labels;
+  };
+
+  /** Filters the top levels of the tree, and collects the subtrees below
+   * them, or whose candidates are already reduced to one. */
+  void
+  CollectFilterTasks(KdTreeNodeType *          node,
+                     std::vector<int>          validIndexes,
+                     MeasurementVectorType &   lowerBound,
+                     MeasurementVectorType &   upperBound,
+                     unsigned int              depth,
+                     unsigned int              maximumDepth,
+                     std::vector<FilterTask> & tasks) const;
+
+  /** Filters a subtree, accumulating into result. */
+  void
+  FilterSubtree(KdTreeNodeType *        node,
+                std::vector<int>        validIndexes,
+                MeasurementVectorType & lowerBound,
+                MeasurementVectorType & upperBound,
+                FilterResult &          result,
+                ParameterType &         vertex) const;
+
+  /** Prunes validIndexes at a nonterminal node, and returns the closest
+   * candidate to the centroid of the node. */
+  int
+  PruneCandidates(const CandidateVector & candidates,
+                  KdTreeNodeType *        node,
+                  std::vector<int> &      validIndexes,
+                  MeasurementVectorType & lowerBound,
+                  MeasurementVectorType & upperBound,
+                  ParameterType &         vertex) const;
+
+  /** Returns the index of the closest candidate to the point. */
+  int
+  GetClosestCandidate(const CandidateVector &  candidates,
+                      const ParameterType &    point,
+                      const std::vector<int> & validIndexes) const;
+
+  /** Returns true if pointA is farther than pointB to the vertex of the
+   * cell, which is computed in vertex. */
+  bool
+  IsFarther(const ParameterType &         pointA,
+            const ParameterType &         pointB,
+            const MeasurementVectorType & lowerBound,
+            const MeasurementVectorType & upperBound,
+            ParameterType &               vertex) const;
+
+  /** Appends the labels of the measurement vectors of a node. */
+  void
+  AppendClusterLabels(KdTreeNodeType * node, int closestIndex, FilterResult & result) const;
+
+  /** Copies the measurement vectors of the terminal nodes below node. */
+  void
+  CacheTerminalNodeMeasurements(KdTreeNodeType * node);
+
+  /** Measurement vectors of the terminal nodes, copied contiguously, and the
+   * offset of the first measurement of each terminal node. */
+  std::vector<double>                                       m_TerminalNodeMeasurements;
+  std::unordered_map<const KdTreeNodeType *, SizeValueType> m_TerminalNodeOffsets;
+
   /** current number of iteration */
   int m_CurrentIteration{ 0 };
   /** maximum number of iteration. termination criterion */
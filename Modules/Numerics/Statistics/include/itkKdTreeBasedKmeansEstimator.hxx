@@ -20,6 +20,7 @@
 
 #include "itkKdTreeBasedKmeansEstimator.h"
 #include "itkStatisticsAlgorithm.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -82,6 +83,15 @@ KdTreeBasedKmeansEstimator<TKdTree>::GetSumOfSquaredPositionChanges(InternalPara
 template <typename TKdTree>
 inline int
 KdTreeBasedKmeansEstimator<TKdTree>::GetClosestCandidate(ParameterType & measurements, std::vector<int> & validIndexes)
+{
+  return this->GetClosestCandidate(m_CandidateVector, measurements, validIndexes);
+}
+
+template <typename TKdTree>
+inline int
+KdTreeBasedKmeansEstimator<TKdTree>::GetClosestCandidate(const CandidateVector &  candidates,
+                                                         const ParameterType &    point,
+                                                         const std::vector<int> & validIndexes) const
 {
   int    closest = 0;
   double closestDistance = NumericTraits<double>::max();
@@ -90,7 +100,7 @@ KdTreeBasedKmeansEstimator<TKdTree>::GetClosestCandidate(ParameterType & measure
   auto iter = validIndexes.begin();
   while (iter != validIndexes.end())
   {
-    tempDistance = m_DistanceMetric->Evaluate(m_CandidateVector[*iter].Centroid, measurements);
+    tempDistance = m_DistanceMetric->Evaluate(candidates[*iter].Centroid, point);
     if (tempDistance < closestDistance)
     {
       closest = *iter;
@@ -107,6 +117,17 @@ KdTreeBasedKmeansEstimator<TKdTree>::IsFarther(ParameterType &         pointA,
                                                ParameterType &         pointB,
                                                MeasurementVectorType & lowerBound,
                                                MeasurementVectorType & upperBound)
+{
+  return this->IsFarther(pointA, pointB, lowerBound, upperBound, m_TempVertex);
+}
+
+template <typename TKdTree>
+inline bool
+KdTreeBasedKmeansEstimator<TKdTree>::IsFarther(const ParameterType &         pointA,
+                                               const ParameterType &         pointB,
+                                               const MeasurementVectorType & lowerBound,
+                                               const MeasurementVectorType & upperBound,
+                                               ParameterType &               vertex) const
 {
   // calculates the vertex of the Cell bounded by the lowerBound
   // and the upperBound
@@ -114,15 +135,15 @@ KdTreeBasedKmeansEstimator<TKdTree>::IsFarther(ParameterType &         pointA,
   {
     if ((pointA[i] - pointB[i]) < 0.0)
     {
-      m_TempVertex[i] = lowerBound[i];
+      vertex[i] = lowerBound[i];
     }
     else
     {
-      m_TempVertex[i] = upperBound[i];
+      vertex[i] = upperBound[i];
     }
   }
 
-  if (m_DistanceMetric->Evaluate(pointA, m_TempVertex) >= m_DistanceMetric->Evaluate(pointB, m_TempVertex))
+  if (m_DistanceMetric->Evaluate(pointA, vertex) >= m_DistanceMetric->Evaluate(pointB, vertex))
   {
     return true;
   }
@@ -137,12 +158,135 @@ KdTreeBasedKmeansEstimator<TKdTree>::Filter(KdTreeNodeType *        node,
                                             MeasurementVectorType & lowerBound,
                                             MeasurementVectorType & upperBound)
 {
-  unsigned int i, j;
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
 
-  typename TKdTree::InstanceIdentifier tempId;
-  int                                  closest;
-  ParameterType                        individualPoint;
-  NumericTraits<ParameterType>::SetLength(individualPoint, this->m_MeasurementVectorSize);
+  // Collect enough subtrees to balance the work units.
+  unsigned int maximumDepth = 0;
+  while ((1u << maximumDepth) < 4 * multiThreader->GetNumberOfWorkUnits() && maximumDepth < 16)
+  {
+    ++maximumDepth;
+  }
+  std::vector<FilterTask> tasks;
+  this->CollectFilterTasks(node, validIndexes, lowerBound, upperBound, 0, maximumDepth, tasks);
+
+  std::vector<FilterResult> results(tasks.size());
+  multiThreader->ParallelizeArray(
+    0,
+    tasks.size(),
+    [this, &tasks, &results](SizeValueType taskIndex) {
+      FilterResult & result = results[taskIndex];
+      result.Candidates = m_CandidateVector;
+      for (int i = 0; i < result.Candidates.Size(); i++)
+      {
+        result.Candidates[i].WeightedCentroid.Fill(0.0);
+        result.Candidates[i].Size = 0;
+      }
+
+      ParameterType vertex;
+      NumericTraits<ParameterType>::SetLength(vertex, m_MeasurementVectorSize);
+      FilterTask & task = tasks[taskIndex];
+      this->FilterSubtree(task.Node, task.ValidIndexes, task.LowerBound, task.UpperBound, result, vertex);
+    },
+    nullptr);
+
+  for (const FilterResult & result : results)
+  {
+    for (int i = 0; i < m_CandidateVector.Size(); i++)
+    {
+      for (unsigned int j = 0; j < m_MeasurementVectorSize; j++)
+      {
+        m_CandidateVector[i].WeightedCentroid[j] += result.Candidates[i].WeightedCentroid[j];
+      }
+      m_CandidateVector[i].Size += result.Candidates[i].Size;
+    }
+    for (const auto & label : result.Labels)
+    {
+      m_ClusterLabels[label.first] = label.second;
+    }
+  }
+}
+
+template <typename TKdTree>
+int
+KdTreeBasedKmeansEstimator<TKdTree>::PruneCandidates(const CandidateVector & candidates,
+                                                     KdTreeNodeType *        node,
+                                                     std::vector<int> &      validIndexes,
+                                                     MeasurementVectorType & lowerBound,
+                                                     MeasurementVectorType & upperBound,
+                                                     ParameterType &         vertex) const
+{
+  CentroidType centroid;
+  node->GetCentroid(centroid);
+
+  const int             closest = this->GetClosestCandidate(candidates, centroid, validIndexes);
+  const ParameterType & closestPosition = candidates[closest].Centroid;
+
+  auto iter = validIndexes.begin();
+  while (iter != validIndexes.end())
+  {
+    if (*iter != closest &&
+        this->IsFarther(candidates[*iter].Centroid, closestPosition, lowerBound, upperBound, vertex))
+    {
+      iter = validIndexes.erase(iter);
+      continue;
+    }
+    ++iter;
+  }
+  return closest;
+}
+
+template <typename TKdTree>
+void
+KdTreeBasedKmeansEstimator<TKdTree>::CollectFilterTasks(KdTreeNodeType *          node,
+                                                        std::vector<int>          validIndexes,
+                                                        MeasurementVectorType &   lowerBound,
+                                                        MeasurementVectorType &   upperBound,
+                                                        unsigned int              depth,
+                                                        unsigned int              maximumDepth,
+                                                        std::vector<FilterTask> & tasks) const
+{
+  if (node->IsTerminal() || depth >= maximumDepth)
+  {
+    tasks.push_back(FilterTask{ node, validIndexes, lowerBound, upperBound });
+    return;
+  }
+
+  ParameterType vertex;
+  NumericTraits<ParameterType>::SetLength(vertex, m_MeasurementVectorSize);
+  this->PruneCandidates(m_CandidateVector, node, validIndexes, lowerBound, upperBound, vertex);
+  if (validIndexes.size() == 1)
+  {
+    tasks.push_back(FilterTask{ node, validIndexes, lowerBound, upperBound });
+    return;
+  }
+
+  unsigned int    partitionDimension;
+  MeasurementType partitionValue;
+  MeasurementType tempValue;
+  node->GetParameters(partitionDimension, partitionValue);
+
+  tempValue = upperBound[partitionDimension];
+  upperBound[partitionDimension] = partitionValue;
+  this->CollectFilterTasks(node->Left(), validIndexes, lowerBound, upperBound, depth + 1, maximumDepth, tasks);
+  upperBound[partitionDimension] = tempValue;
+
+  tempValue = lowerBound[partitionDimension];
+  lowerBound[partitionDimension] = partitionValue;
+  this->CollectFilterTasks(node->Right(), validIndexes, lowerBound, upperBound, depth + 1, maximumDepth, tasks);
+  lowerBound[partitionDimension] = tempValue;
+}
+
+template <typename TKdTree>
+void
+KdTreeBasedKmeansEstimator<TKdTree>::FilterSubtree(KdTreeNodeType *        node,
+                                                   std::vector<int>        validIndexes,
+                                                   MeasurementVectorType & lowerBound,
+                                                   MeasurementVectorType & upperBound,
+                                                   FilterResult &          result,
+                                                   ParameterType &         vertex) const
+{
+  unsigned int j;
+  int          closest;
 
   if (node->IsTerminal())
   {
@@ -153,79 +297,116 @@ KdTreeBasedKmeansEstimator<TKdTree>::Filter(KdTreeNodeType *        node,
       return;
     }
 
-    for (i = 0; i < (unsigned int)node->Size(); i++)
+    const double * measurements = &m_TerminalNodeMeasurements[m_TerminalNodeOffsets.at(node)];
+    ParameterType  individualPoint;
+    NumericTraits<ParameterType>::SetLength(individualPoint, m_MeasurementVectorSize);
+    for (unsigned int i = 0; i < static_cast<unsigned int>(node->Size()); i++)
     {
-      tempId = node->GetInstanceIdentifier(i);
-      this->GetPoint(individualPoint, m_KdTree->GetMeasurementVector(tempId));
-      closest = this->GetClosestCandidate(individualPoint, validIndexes);
       for (j = 0; j < m_MeasurementVectorSize; j++)
       {
-        m_CandidateVector[closest].WeightedCentroid[j] += individualPoint[j];
+        individualPoint[j] = *measurements++;
+      }
+      closest = this->GetClosestCandidate(result.Candidates, individualPoint, validIndexes);
+      for (j = 0; j < m_MeasurementVectorSize; j++)
+      {
+        result.Candidates[closest].WeightedCentroid[j] += individualPoint[j];
       }
-      m_CandidateVector[closest].Size += 1;
+      result.Candidates[closest].Size += 1;
       if (m_GenerateClusterLabels)
       {
-        m_ClusterLabels[tempId] = closest;
+        result.Labels.emplace_back(node->GetInstanceIdentifier(i), closest);
       }
     }
+    return;
   }
-  else
+
+  closest = this->PruneCandidates(result.Candidates, node, validIndexes, lowerBound, upperBound, vertex);
+  if (validIndexes.size() == 1)
   {
-    CentroidType  centroid;
-    CentroidType  weightedCentroid;
-    ParameterType closestPosition;
+    CentroidType weightedCentroid;
     node->GetWeightedCentroid(weightedCentroid);
-    node->GetCentroid(centroid);
+    for (j = 0; j < m_MeasurementVectorSize; j++)
+    {
+      result.Candidates[closest].WeightedCentroid[j] += weightedCentroid[j];
+    }
+    result.Candidates[closest].Size += node->Size();
+    if (m_GenerateClusterLabels)
+    {
+      this->AppendClusterLabels(node, closest, result);
+    }
+  }
+  else
+  {
+    unsigned int    partitionDimension;
+    MeasurementType partitionValue;
+    MeasurementType tempValue;
+    node->GetParameters(partitionDimension, partitionValue);
+
+    tempValue = upperBound[partitionDimension];
+    upperBound[partitionDimension] = partitionValue;
+    this->FilterSubtree(node->Left(), validIndexes, lowerBound, upperBound, result, vertex);
+    upperBound[partitionDimension] = tempValue;
+
+    tempValue = lowerBound[partitionDimension];
+    lowerBound[partitionDimension] = partitionValue;
+    this->FilterSubtree(node->Right(), validIndexes, lowerBound, upperBound, result, vertex);
+    lowerBound[partitionDimension] = tempValue;
+  }
+}
 
-    closest = this->GetClosestCandidate(centroid, validIndexes);
-    closestPosition = m_CandidateVector[closest].Centroid;
-    auto iter = validIndexes.begin();
+template <typename TKdTree>
+void
+KdTreeBasedKmeansEstimator<TKdTree>::AppendClusterLabels(KdTreeNodeType * node,
+                                                         int              closestIndex,
+                                                         FilterResult &   result) const
+{
+  if (node->IsTerminal())
+  {
+    // terminal node
+    if (node == m_KdTree->GetEmptyTerminalNode())
+    {
+      // empty node
+      return;
+    }
 
-    while (iter != validIndexes.end())
+    for (unsigned int i = 0; i < static_cast<unsigned int>(node->Size()); i++)
     {
-      if (*iter != closest &&
-          this->IsFarther(m_CandidateVector[*iter].Centroid, closestPosition, lowerBound, upperBound))
-      {
-        iter = validIndexes.erase(iter);
-        continue;
-      }
+      result.Labels.emplace_back(node->GetInstanceIdentifier(i), closestIndex);
+    }
+  }
+  else
+  {
+    this->AppendClusterLabels(node->Left(), closestIndex, result);
+    this->AppendClusterLabels(node->Right(), closestIndex, result);
+  }
+}
 
-      if (iter != validIndexes.end())
-      {
-        ++iter;
-      }
+template <typename TKdTree>
+void
+KdTreeBasedKmeansEstimator<TKdTree>::CacheTerminalNodeMeasurements(KdTreeNodeType * node)
+{
+  if (node->IsTerminal())
+  {
+    if (node == m_KdTree->GetEmptyTerminalNode())
+    {
+      return;
     }
 
-    if (validIndexes.size() == 1)
+    m_TerminalNodeOffsets[node] = m_TerminalNodeMeasurements.size();
+    for (unsigned int i = 0; i < static_cast<unsigned int>(node->Size()); i++)
     {
-      for (j = 0; j < m_MeasurementVectorSize; j++)
+      const MeasurementVectorType & measurements = m_KdTree->GetMeasurementVector(node->GetInstanceIdentifier(i));
+      for (unsigned int j = 0; j < m_MeasurementVectorSize; j++)
       {
-        m_CandidateVector[closest].WeightedCentroid[j] += weightedCentroid[j];
+        m_TerminalNodeMeasurements.push_back(measurements[j]);
       }
-      m_CandidateVector[closest].Size += node->Size();
-      if (m_GenerateClusterLabels)
-      {
-        this->FillClusterLabels(node, closest);
-      }
-    }
-    else
-    {
-      unsigned int    partitionDimension;
-      MeasurementType partitionValue;
-      MeasurementType tempValue;
-      node->GetParameters(partitionDimension, partitionValue);
-
-      tempValue = upperBound[partitionDimension];
-      upperBound[partitionDimension] = partitionValue;
-      this->Filter(node->Left(), validIndexes, lowerBound, upperBound);
-      upperBound[partitionDimension] = tempValue;
-
-      tempValue = lowerBound[partitionDimension];
-      lowerBound[partitionDimension] = partitionValue;
-      this->Filter(node->Right(), validIndexes, lowerBound, upperBound);
-      lowerBound[partitionDimension] = tempValue;
     }
   }
+  else
+  {
+    this->CacheTerminalNodeMeasurements(node->Left());
+    this->CacheTerminalNodeMeasurements(node->Right());
+  }
 }
 
 template <typename TKdTree>
@@ -333,6 +514,10 @@ KdTreeBasedKmeansEstimator<TKdTree>::StartOptimization()
     currentPosition.push_back(m1);
   }
 
+  m_TerminalNodeMeasurements.clear();
+  m_TerminalNodeOffsets.clear();
+  this->CacheTerminalNodeMeasurements(m_KdTree->GetRoot());
+
   this->CopyParameters(m_Parameters, currentPosition);
   m_CurrentIteration = 0;
   std::vector<int> validIndexes;
@@ -380,6 +565,9 @@ KdTreeBasedKmeansEstimator<TKdTree>::StartOptimization()
   }
 
   this->CopyParameters(currentPosition, m_Parameters);
+
+  std::vector<double>().swap(m_TerminalNodeMeasurements);
+  m_TerminalNodeOffsets.clear();
 }
 
 template <typename TKdTree>
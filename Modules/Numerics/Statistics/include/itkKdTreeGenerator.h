@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "itkKdTree.h"
+#include "itkMultiThreaderBase.h"
 #include "itkStatisticsAlgorithm.h"
 
 namespace itk
@@ -52,6 +53,17 @@ namespace Statistics
  * Update method will run this generator. To get the resulting KdTree
  * object, call the GetOutput method.
  *
+ * When ParallelBuild is on, the top levels of the tree are partitioned one
+ * level at a time, the ranges of the same level in parallel, and the
+ * subtrees below them are then generated in parallel, since they partition
+ * disjoint ranges of the subsample. The tree generated is identical to the
+ * one generated serially. The measurement vectors of the sample are then
+ * read concurrently, so ParallelBuild should only be turned on for the
+ * samples whose GetMeasurementVector() method is thread safe, such as
+ * ListSample and VectorContainerToListSampleAdaptor, but not the adaptors
+ * which copy the measurement vector into an internal buffer, such as
+ * ImageToListSampleAdaptor and PointSetToListSampleAdaptor.
+ *
  * <b>Recent API changes:</b>
  * The static const macro to get the length of a measurement vector,
  * 'MeasurementVectorSize'  has been removed to allow the length of a measurement
@@ -141,6 +153,12 @@ public:
    * held in the 'sample' that is passed to this class */
   itkGetConstMacro(MeasurementVectorSize, unsigned int);
 
+  /** Set/Get whether the tree is generated in parallel. The default is
+   * false. */
+  itkSetMacro(ParallelBuild, bool);
+  itkGetConstMacro(ParallelBuild, bool);
+  itkBooleanMacro(ParallelBuild);
+
 protected:
   /** Constructor */
   KdTreeGenerator();
@@ -166,6 +184,29 @@ protected:
                           MeasurementVectorType & upperBound,
                           unsigned int            level);
 
+  /** Creates the nonterminal node of the range [beginIndex, endIndex) of the
+   * subsample, once the range is partitioned at medianIndex and its children
+   * are generated. This method may be called concurrently for disjoint
+   * ranges. */
+  virtual KdTreeNodeType *
+  CreateNonterminalNode(unsigned int     beginIndex,
+                        unsigned int     endIndex,
+                        unsigned int     medianIndex,
+                        unsigned int     partitionDimension,
+                        MeasurementType  partitionValue,
+                        KdTreeNodeType * left,
+                        KdTreeNodeType * right);
+
+  /** Partitions the range [beginIndex, endIndex) of the subsample at the
+   * median of its most widely spread dimension. The index of the median is
+   * returned in medianIndex. */
+  void
+  PartitionSubsample(unsigned int      beginIndex,
+                     unsigned int      endIndex,
+                     unsigned int &    medianIndex,
+                     unsigned int &    partitionDimension,
+                     MeasurementType & partitionValue);
+
   /** Tree generation loop */
   KdTreeNodeType *
   GenerateTreeLoop(unsigned int            beginIndex,
@@ -174,6 +215,10 @@ protected:
                    MeasurementVectorType & upperBound,
                    unsigned int            level);
 
+  /** Generates the tree in parallel, see SetParallelBuild(). */
+  KdTreeNodeType *
+  GenerateTreeInParallel(MeasurementVectorType & lowerBound, MeasurementVectorType & upperBound);
+
 private:
   /** Pointer to the input (source) sample */
   TSample * m_SourceSample;
@@ -190,17 +235,11 @@ private:
   /** Pointer to the resulting k-d tree. */
   OutputPointer m_Tree;
 
-  /** Temporary lower bound for the TreeGenerationLoop */
-  MeasurementVectorType m_TempLowerBound;
-
-  /** Temporary upper bound for the TreeGenerationLoop */
-  MeasurementVectorType m_TempUpperBound;
-
-  /** Temporary mean for the TreeGenerationLoop */
-  MeasurementVectorType m_TempMean;
-
   /** Length of a measurement vector */
   MeasurementVectorSizeType m_MeasurementVectorSize;
+
+  /** Whether the tree is generated in parallel. */
+  bool m_ParallelBuild{ false };
 }; // end of class
 } // end of namespace Statistics
 } // end of namespace itk
@@ -51,6 +51,7 @@ KdTreeGenerator<TSample>::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Bucket Size: " << m_BucketSize << std::endl;
   os << indent << "MeasurementVectorSize: " << m_MeasurementVectorSize << std::endl;
+  os << indent << "ParallelBuild: " << (m_ParallelBuild ? "On" : "Off") << std::endl;
 }
 
 template <typename TSample>
@@ -61,9 +62,6 @@ KdTreeGenerator<TSample>::SetSample(TSample * sample)
   m_Subsample->SetSample(sample);
   m_Subsample->InitializeWithAllInstances();
   m_MeasurementVectorSize = sample->GetMeasurementVectorSize();
-  NumericTraits<MeasurementVectorType>::SetLength(m_TempLowerBound, m_MeasurementVectorSize);
-  NumericTraits<MeasurementVectorType>::SetLength(m_TempUpperBound, m_MeasurementVectorSize);
-  NumericTraits<MeasurementVectorType>::SetLength(m_TempMean, m_MeasurementVectorSize);
 }
 
 template <typename TSample>
@@ -109,38 +107,150 @@ KdTreeGenerator<TSample>::GenerateData()
     upperBound[d] = NumericTraits<MeasurementType>::max();
   }
 
-  KdTreeNodeType * root = this->GenerateTreeLoop(0, m_Subsample->Size(), lowerBound, upperBound, 0);
+  KdTreeNodeType * root = m_ParallelBuild ? this->GenerateTreeInParallel(lowerBound, upperBound)
+                                          : this->GenerateTreeLoop(0, m_Subsample->Size(), lowerBound, upperBound, 0);
   m_Tree->SetRoot(root);
 }
 
 template <typename TSample>
-inline typename KdTreeGenerator<TSample>::KdTreeNodeType *
-KdTreeGenerator<TSample>::GenerateNonterminalNode(unsigned int            beginIndex,
-                                                  unsigned int            endIndex,
-                                                  MeasurementVectorType & lowerBound,
-                                                  MeasurementVectorType & upperBound,
-                                                  unsigned int            level)
+typename KdTreeGenerator<TSample>::KdTreeNodeType *
+KdTreeGenerator<TSample>::GenerateTreeInParallel(MeasurementVectorType & lowerBound,
+                                                 MeasurementVectorType & upperBound)
 {
-  using NodeType = typename KdTreeType::KdTreeNodeType;
-  MeasurementType dimensionLowerBound;
-  MeasurementType dimensionUpperBound;
-  MeasurementType partitionValue;
-  unsigned int    partitionDimension = 0;
-  unsigned int    i;
-  MeasurementType spread;
-  MeasurementType maxSpread;
-  unsigned int    medianIndex;
+  // The nodes of the top levels in breadth first order. The children of a
+  // partitioned node are at m_Left and m_Left + 1; the nodes which are not
+  // partitioned are the roots of the subtrees generated in parallel.
+  struct TopNodeType
+  {
+    unsigned int          m_BeginIndex;
+    unsigned int          m_EndIndex;
+    unsigned int          m_Level;
+    MeasurementVectorType m_LowerBound;
+    MeasurementVectorType m_UpperBound;
+    unsigned int          m_MedianIndex{ 0 };
+    unsigned int          m_PartitionDimension{ 0 };
+    MeasurementType       m_PartitionValue{};
+    size_t                m_Left{ 0 };
+    KdTreeNodeType *      m_Node{ nullptr };
+  };
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+
+  // Partition enough levels to have a few subtrees per work unit.
+  unsigned int numberOfLevels = 0;
+  while ((SizeValueType{ 1 } << numberOfLevels) < 4 * SizeValueType{ multiThreader->GetNumberOfWorkUnits() })
+  {
+    ++numberOfLevels;
+  }
 
-  SubsamplePointer subsample = this->GetSubsample();
+  std::vector<TopNodeType> nodes(1);
+  nodes[0].m_BeginIndex = 0;
+  nodes[0].m_EndIndex = m_Subsample->Size();
+  nodes[0].m_Level = 0;
+  nodes[0].m_LowerBound = lowerBound;
+  nodes[0].m_UpperBound = upperBound;
+
+  size_t levelBegin = 0;
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    const size_t levelEnd = nodes.size();
+    multiThreader->ParallelizeArray(
+      levelBegin,
+      levelEnd,
+      [this, &nodes](SizeValueType i) {
+        TopNodeType & node = nodes[i];
+        if (node.m_EndIndex - node.m_BeginIndex > m_BucketSize)
+        {
+          this->PartitionSubsample(
+            node.m_BeginIndex, node.m_EndIndex, node.m_MedianIndex, node.m_PartitionDimension, node.m_PartitionValue);
+        }
+      },
+      nullptr);
+
+    for (size_t i = levelBegin; i < levelEnd; ++i)
+    {
+      if (nodes[i].m_EndIndex - nodes[i].m_BeginIndex <= m_BucketSize)
+      {
+        continue;
+      }
+      nodes[i].m_Left = nodes.size();
+
+      TopNodeType left;
+      left.m_BeginIndex = nodes[i].m_BeginIndex;
+      left.m_EndIndex = nodes[i].m_MedianIndex;
+      left.m_Level = nodes[i].m_Level + 2;
+      left.m_LowerBound = nodes[i].m_LowerBound;
+      left.m_UpperBound = nodes[i].m_UpperBound;
+      left.m_UpperBound[nodes[i].m_PartitionDimension] = nodes[i].m_PartitionValue;
+
+      TopNodeType right;
+      right.m_BeginIndex = nodes[i].m_MedianIndex + 1;
+      right.m_EndIndex = nodes[i].m_EndIndex;
+      right.m_Level = nodes[i].m_Level + 2;
+      right.m_LowerBound = nodes[i].m_LowerBound;
+      right.m_UpperBound = nodes[i].m_UpperBound;
+      right.m_LowerBound[nodes[i].m_PartitionDimension] = nodes[i].m_PartitionValue;
+
+      nodes.push_back(left);
+      nodes.push_back(right);
+    }
+    levelBegin = levelEnd;
+  }
+
+  // The subtrees partition disjoint ranges of the subsample.
+  multiThreader->ParallelizeArray(
+    0,
+    nodes.size(),
+    [this, &nodes](SizeValueType i) {
+      TopNodeType & node = nodes[i];
+      if (node.m_Left == 0)
+      {
+        node.m_Node = this->GenerateTreeLoop(
+          node.m_BeginIndex, node.m_EndIndex, node.m_LowerBound, node.m_UpperBound, node.m_Level);
+      }
+    },
+    nullptr);
+
+  // The children of a node are after it in breadth first order.
+  for (size_t i = nodes.size(); i-- > 0;)
+  {
+    TopNodeType & node = nodes[i];
+    if (node.m_Left != 0)
+    {
+      node.m_Node = this->CreateNonterminalNode(node.m_BeginIndex,
+                                                node.m_EndIndex,
+                                                node.m_MedianIndex,
+                                                node.m_PartitionDimension,
+                                                node.m_PartitionValue,
+                                                nodes[node.m_Left].m_Node,
+                                                nodes[node.m_Left + 1].m_Node);
+    }
+  }
+  return nodes[0].m_Node;
+}
+
+template <typename TSample>
+void
+KdTreeGenerator<TSample>::PartitionSubsample(unsigned int      beginIndex,
+                                             unsigned int      endIndex,
+                                             unsigned int &    medianIndex,
+                                             unsigned int &    partitionDimension,
+                                             MeasurementType & partitionValue)
+{
+  // The bounds are local, so that disjoint ranges may be partitioned
+  // concurrently.
+  MeasurementVectorType lowerBound;
+  MeasurementVectorType upperBound;
+  MeasurementVectorType mean;
 
   // find most widely spread dimension
-  Algorithm::FindSampleBoundAndMean<SubsampleType>(
-    subsample, beginIndex, endIndex, m_TempLowerBound, m_TempUpperBound, m_TempMean);
+  Algorithm::FindSampleBoundAndMean<SubsampleType>(m_Subsample, beginIndex, endIndex, lowerBound, upperBound, mean);
 
-  maxSpread = NumericTraits<MeasurementType>::NonpositiveMin();
-  for (i = 0; i < m_MeasurementVectorSize; i++)
+  MeasurementType maxSpread = NumericTraits<MeasurementType>::NonpositiveMin();
+  partitionDimension = 0;
+  for (unsigned int i = 0; i < m_MeasurementVectorSize; i++)
   {
-    spread = m_TempUpperBound[i] - m_TempLowerBound[i];
+    const MeasurementType spread = upperBound[i] - lowerBound[i];
     if (spread >= maxSpread)
     {
       maxSpread = spread;
@@ -158,6 +268,24 @@ KdTreeGenerator<TSample>::GenerateNonterminalNode(unsigned int            beginI
     Algorithm::NthElement<SubsampleType>(m_Subsample, partitionDimension, beginIndex, endIndex, medianIndex);
 
   medianIndex += beginIndex;
+}
+
+template <typename TSample>
+inline typename KdTreeGenerator<TSample>::KdTreeNodeType *
+KdTreeGenerator<TSample>::GenerateNonterminalNode(unsigned int            beginIndex,
+                                                  unsigned int            endIndex,
+                                                  MeasurementVectorType & lowerBound,
+                                                  MeasurementVectorType & upperBound,
+                                                  unsigned int            level)
+{
+  using NodeType = typename KdTreeType::KdTreeNodeType;
+  MeasurementType dimensionLowerBound;
+  MeasurementType dimensionUpperBound;
+  MeasurementType partitionValue;
+  unsigned int    partitionDimension;
+  unsigned int    medianIndex;
+
+  this->PartitionSubsample(beginIndex, endIndex, medianIndex, partitionDimension, partitionValue);
 
   // save bounds for cutting dimension
   dimensionLowerBound = lowerBound[partitionDimension];
@@ -175,11 +303,25 @@ KdTreeGenerator<TSample>::GenerateNonterminalNode(unsigned int            beginI
   NodeType *         right = GenerateTreeLoop(beginRightIndex, endRightIndex, lowerBound, upperBound, level + 1);
   lowerBound[partitionDimension] = dimensionLowerBound;
 
+  return this->CreateNonterminalNode(
+    beginIndex, endIndex, medianIndex, partitionDimension, partitionValue, left, right);
+}
+
+template <typename TSample>
+typename KdTreeGenerator<TSample>::KdTreeNodeType *
+KdTreeGenerator<TSample>::CreateNonterminalNode(unsigned int     itkNotUsed(beginIndex),
+                                                unsigned int     itkNotUsed(endIndex),
+                                                unsigned int     medianIndex,
+                                                unsigned int     partitionDimension,
+                                                MeasurementType  partitionValue,
+                                                KdTreeNodeType * left,
+                                                KdTreeNodeType * right)
+{
   using KdTreeNonterminalNodeType = KdTreeNonterminalNode<TSample>;
 
   auto * nonTerminalNode = new KdTreeNonterminalNodeType(partitionDimension, partitionValue, left, right);
 
-  nonTerminalNode->AddInstanceIdentifier(subsample->GetInstanceIdentifier(medianIndex));
+  nonTerminalNode->AddInstanceIdentifier(m_Subsample->GetInstanceIdentifier(medianIndex));
 
   return nonTerminalNode;
 }
@@ -206,7 +348,7 @@ KdTreeGenerator<TSample>::GenerateTreeLoop(unsigned int            beginIndex,
 
       for (unsigned int j = beginIndex; j < endIndex; j++)
       {
-        ptr->AddInstanceIdentifier(this->GetSubsample()->GetInstanceIdentifier(j));
+        ptr->AddInstanceIdentifier(m_Subsample->GetInstanceIdentifier(j));
       }
 
       // return a terminal node
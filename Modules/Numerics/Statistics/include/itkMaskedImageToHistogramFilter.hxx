@@ -101,8 +101,10 @@ MaskedImageToHistogramFilter<TImage, TMaskImage>::ThreadedStreamedGenerateData(c
     {
       const PixelType & p = inputIt.Get();
       NumericTraits<PixelType>::AssignToArray(p, m);
-      histogram->GetIndex(m, index);
-      histogram->IncreaseFrequencyOfIndex(index, 1);
+      if (histogram->GetIndex(m, index))
+      {
+        histogram->IncreaseFrequencyOfIndex(index, 1);
+      }
     }
     ++inputIt;
     ++maskIt;
@@ -20,8 +20,7 @@
 
 #include "itkMeanSampleFilter.h"
 
-#include <vector>
-#include "itkCompensatedSummation.h"
+#include "itkSampleMomentsCalculator.h"
 #include "itkMeasurementVectorTraits.h"
 
 namespace itk
@@ -129,36 +128,20 @@ MeanSampleFilter<TSample>::GenerateData()
   NumericTraits<MeasurementVectorRealType>::SetLength(output, this->GetMeasurementVectorSize());
 
   // algorithm start
-  using MeasurementRealAccumulateType = CompensatedSummation<MeasurementRealType>;
-  std::vector<MeasurementRealAccumulateType> sum(measurementVectorSize);
+  using MomentsCalculatorType = SampleMomentsCalculator<SampleType>;
+  typename MomentsCalculatorType::Pointer momentsCalculator = MomentsCalculatorType::New();
+  momentsCalculator->SetSample(input);
+  momentsCalculator->Compute();
 
-  using TotalFrequencyType = typename SampleType::TotalAbsoluteFrequencyType;
-  TotalFrequencyType totalFrequency = NumericTraits<TotalFrequencyType>::ZeroValue();
-
-  typename SampleType::ConstIterator       iter = input->Begin();
-  const typename SampleType::ConstIterator end = input->End();
-
-  for (; iter != end; ++iter)
-  {
-    const MeasurementVectorType & measurement = iter.GetMeasurementVector();
-
-    const typename SampleType::AbsoluteFrequencyType frequency = iter.GetFrequency();
-    totalFrequency += frequency;
-
-    for (unsigned int dim = 0; dim < measurementVectorSize; dim++)
-    {
-      const auto component = static_cast<MeasurementRealType>(measurement[dim]);
-
-      sum[dim] += (component * static_cast<MeasurementRealType>(frequency));
-    }
-  }
+  const typename MomentsCalculatorType::WeightValueType totalFrequency = momentsCalculator->GetTotalWeight();
 
   // compute the mean if the total frequency is different from zero
   if (totalFrequency > itk::Math::eps)
   {
+    const typename MomentsCalculatorType::MeanType & mean = momentsCalculator->GetMean();
     for (unsigned int dim = 0; dim < measurementVectorSize; dim++)
     {
-      output[dim] = (sum[dim].GetSum() / static_cast<MeasurementRealType>(totalFrequency));
+      output[dim] = mean[dim];
     }
   }
   else
@@ -0,0 +1,253 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSampleMomentsCalculator_h
+#define itkSampleMomentsCalculator_h
+
+#include <vector>
+
+#include "itkObject.h"
+#include "itkArray.h"
+#include "itkVariableSizeMatrix.h"
+#include "itkFunctionBase.h"
+#include "itkImageToListSampleAdaptor.h"
+
+namespace itk
+{
+namespace Statistics
+{
+/**
+ *\class SampleMomentsCalculator
+ * \brief Computes the total weight, the mean, the sums of squared deviations
+ * from the mean and the bounds of the measurement vectors of a sample in a
+ * single parallel pass.
+ *
+ * The weight of a measurement vector is its frequency, multiplied by the
+ * value of the weight array or of the weighting function if one is set.
+ * Measurement vectors whose weight is zero are ignored.
+ *
+ * The sample is split into at most 1024 contiguous blocks, which are
+ * processed in parallel. The moments of a block are updated measurement
+ * vector by measurement vector, in the form of Welford, and the moments of
+ * the blocks are merged in order, in the form of Chan et al., so that the
+ * result doesn't depend on the number of threads.
+ *
+ * The measurement vectors of a ListSample and of an ImageToListSampleAdaptor
+ * are read directly from their container and from their image by each block.
+ * The measurement vectors of the other samples are read with the iterator of
+ * the sample, and copied in chunks which are then processed in parallel. The
+ * weighting function is evaluated concurrently.
+ *
+ * \sa MeanSampleFilter, CovarianceSampleFilter
+ * \ingroup ITKStatistics
+ */
+template <typename TSample>
+class ITK_TEMPLATE_EXPORT SampleMomentsCalculator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SampleMomentsCalculator);
+
+  /** Standard type alias */
+  using Self = SampleMomentsCalculator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SampleMomentsCalculator, Object);
+
+  /** standard New() method support */
+  itkNewMacro(Self);
+
+  using SampleType = TSample;
+  using MeasurementVectorType = typename SampleType::MeasurementVectorType;
+  using MeasurementVectorSizeType = typename SampleType::MeasurementVectorSizeType;
+  using MeasurementType = typename SampleType::MeasurementType;
+  using MeasurementRealType = typename NumericTraits<MeasurementType>::RealType;
+
+  /** Type of the mean and of the sums of squared deviations */
+  using MeanType = Array<MeasurementRealType>;
+
+  /** Type of the scatter matrix */
+  using MatrixType = VariableSizeMatrix<MeasurementRealType>;
+
+  /** Type of weight values */
+  using WeightValueType = double;
+
+  /** Array type for weights */
+  using WeightArrayType = Array<WeightValueType>;
+
+  /** Weight calculation function type */
+  using WeightingFunctionType = FunctionBase<MeasurementVectorType, WeightValueType>;
+
+  /** Set/Get the sample */
+  itkSetConstObjectMacro(Sample, SampleType);
+  itkGetConstObjectMacro(Sample, SampleType);
+
+  /** Set/Get the weights of the measurement vectors, in the order of the
+   * iterator of the sample. The array isn't copied, and must remain valid
+   * until Compute() returns. */
+  void
+  SetWeights(const WeightArrayType * weights)
+  {
+    if (m_Weights != weights)
+    {
+      m_Weights = weights;
+      this->Modified();
+    }
+  }
+  const WeightArrayType *
+  GetWeights() const
+  {
+    return m_Weights;
+  }
+
+  /** Set/Get the weighting function, which is ignored if weights are set */
+  itkSetConstObjectMacro(WeightingFunction, WeightingFunctionType);
+  itkGetConstObjectMacro(WeightingFunction, WeightingFunctionType);
+
+  /** Set/Get whether the sums of squared deviations from the mean of the
+   * components are computed. Default is off. */
+  itkSetMacro(ComputeVariance, bool);
+  itkGetConstMacro(ComputeVariance, bool);
+  itkBooleanMacro(ComputeVariance);
+
+  /** Set/Get whether the scatter matrix is computed, along with the sums of
+   * squared deviations which are its diagonal. Default is off. */
+  itkSetMacro(ComputeCovariance, bool);
+  itkGetConstMacro(ComputeCovariance, bool);
+  itkBooleanMacro(ComputeCovariance);
+
+  /** Set/Get whether the minimum and the maximum of the components are
+   * computed. Default is off. */
+  itkSetMacro(ComputeBounds, bool);
+  itkGetConstMacro(ComputeBounds, bool);
+  itkBooleanMacro(ComputeBounds);
+
+  /** Computes the moments of the sample */
+  void
+  Compute();
+
+  /** Get the sum of the weights, which is the total frequency of the
+   * sample if no weights are set */
+  itkGetConstMacro(TotalWeight, WeightValueType);
+
+  /** Get the weighted mean. It is zero if the total weight is zero. */
+  itkGetConstReferenceMacro(Mean, MeanType);
+
+  /** Get the weighted sums of squared deviations from the mean of the
+   * components. Valid if ComputeVariance or ComputeCovariance is on. */
+  itkGetConstReferenceMacro(SumOfSquaredDeviations, MeanType);
+
+  /** Get the weighted sum of the outer products of the deviations from the
+   * mean. Valid if ComputeCovariance is on. */
+  itkGetConstReferenceMacro(ScatterMatrix, MatrixType);
+
+  /** Get the bounds of the components. Valid if ComputeBounds is on and the
+   * total weight isn't zero. */
+  itkGetConstReferenceMacro(Minimum, MeasurementVectorType);
+  itkGetConstReferenceMacro(Maximum, MeasurementVectorType);
+
+protected:
+  SampleMomentsCalculator() = default;
+  ~SampleMomentsCalculator() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Moments of a block of measurement vectors */
+  struct Moments
+  {
+    SizeValueType                    Size{ 0 };
+    WeightValueType                  Weight{ 0.0 };
+    std::vector<MeasurementRealType> Mean;
+    std::vector<MeasurementRealType> Scatter;
+    std::vector<MeasurementType>     Minimum;
+    std::vector<MeasurementType>     Maximum;
+  };
+
+  /** Adds a measurement vector to the moments */
+  void
+  AddMeasurementVector(Moments & moments, const MeasurementVectorType & measurements, WeightValueType weight) const;
+
+  /** Merges the moments of a block into the moments of the previous blocks */
+  void
+  MergeMoments(Moments & moments, const Moments & blockMoments) const;
+
+  /** Initializes the moments of a block */
+  void
+  InitializeMoments(Moments & moments) const;
+
+  /** Returns the weight of the measurement vector at position id */
+  WeightValueType
+  GetWeight(SizeValueType id, const MeasurementVectorType & measurements, WeightValueType frequency) const
+  {
+    if (m_Weights != nullptr)
+    {
+      return (*m_Weights)[id] * frequency;
+    }
+    if (m_WeightingFunction)
+    {
+      return m_WeightingFunction->Evaluate(measurements) * frequency;
+    }
+    return frequency;
+  }
+
+  /** Processes the measurement vectors [firstId, firstId + size) in
+   * parallel blocks, and merges the moments of the blocks into moments. The
+   * block function adds the measurement vectors [begin, end) to the moments
+   * of a block. */
+  template <typename TBlockFunction>
+  void
+  ComputeBlocks(SizeValueType firstId, SizeValueType size, const TBlockFunction & blockFunction, Moments & moments);
+
+  /** Computes the moments of the measurement vectors of an image */
+  template <typename TImage>
+  void
+  ComputeSample(const ImageToListSampleAdaptor<TImage> * sample, Moments & moments);
+
+  /** Computes the moments of a list sample, or of any other sample through
+   * its iterator */
+  void
+  ComputeSample(const Sample<MeasurementVectorType> * sample, Moments & moments);
+
+  typename SampleType::ConstPointer            m_Sample;
+  const WeightArrayType *                      m_Weights{ nullptr };
+  typename WeightingFunctionType::ConstPointer m_WeightingFunction;
+
+  bool m_ComputeVariance{ false };
+  bool m_ComputeCovariance{ false };
+  bool m_ComputeBounds{ false };
+
+  MeasurementVectorSizeType m_MeasurementVectorSize{ 0 };
+  SizeValueType             m_ScatterSize{ 0 };
+
+  WeightValueType       m_TotalWeight{ 0.0 };
+  MeanType              m_Mean;
+  MeanType              m_SumOfSquaredDeviations;
+  MatrixType            m_ScatterMatrix;
+  MeasurementVectorType m_Minimum;
+  MeasurementVectorType m_Maximum;
+};
+} // end of namespace Statistics
+} // end of namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSampleMomentsCalculator.hxx"
+#endif
+
+#endif
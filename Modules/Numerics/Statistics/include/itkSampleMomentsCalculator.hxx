@@ -0,0 +1,407 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSampleMomentsCalculator_hxx
+#define itkSampleMomentsCalculator_hxx
+
+#include <typeinfo>
+
+#include "itkSampleMomentsCalculator.h"
+#include "itkMultiThreaderBase.h"
+#include "itkMeasurementVectorTraits.h"
+
+namespace itk
+{
+namespace Statistics
+{
+template <typename TSample>
+void
+SampleMomentsCalculator<TSample>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Sample);
+  os << indent << "Weights: " << m_Weights << std::endl;
+  itkPrintSelfObjectMacro(WeightingFunction);
+  os << indent << "ComputeVariance: " << m_ComputeVariance << std::endl;
+  os << indent << "ComputeCovariance: " << m_ComputeCovariance << std::endl;
+  os << indent << "ComputeBounds: " << m_ComputeBounds << std::endl;
+  os << indent << "TotalWeight: " << m_TotalWeight << std::endl;
+  os << indent << "Mean: " << m_Mean << std::endl;
+  os << indent << "SumOfSquaredDeviations: " << m_SumOfSquaredDeviations << std::endl;
+  os << indent << "ScatterMatrix: " << m_ScatterMatrix << std::endl;
+  os << indent << "Minimum: " << m_Minimum << std::endl;
+  os << indent << "Maximum: " << m_Maximum << std::endl;
+}
+
+template <typename TSample>
+void
+SampleMomentsCalculator<TSample>::Compute()
+{
+  if (m_Sample.IsNull())
+  {
+    itkExceptionMacro("Sample is not set");
+  }
+
+  m_MeasurementVectorSize = m_Sample->GetMeasurementVectorSize();
+  const MeasurementVectorSizeType measurementVectorSize = m_MeasurementVectorSize;
+
+  // the scatter of a block holds the lower triangle of the scatter matrix,
+  // or its diagonal
+  m_ScatterSize = 0;
+  if (m_ComputeCovariance)
+  {
+    m_ScatterSize = measurementVectorSize * (measurementVectorSize + 1) / 2;
+  }
+  else if (m_ComputeVariance)
+  {
+    m_ScatterSize = measurementVectorSize;
+  }
+
+  if (m_Weights != nullptr && m_Weights->Size() < m_Sample->Size())
+  {
+    itkExceptionMacro("The number of weights " << m_Weights->Size() << " is smaller than the size of the sample "
+                                               << m_Sample->Size());
+  }
+
+  Moments moments;
+  this->InitializeMoments(moments);
+  this->ComputeSample(m_Sample.GetPointer(), moments);
+
+  m_TotalWeight = moments.Weight;
+
+  m_Mean.SetSize(measurementVectorSize);
+  m_SumOfSquaredDeviations.SetSize(measurementVectorSize);
+  m_SumOfSquaredDeviations.Fill(NumericTraits<MeasurementRealType>::ZeroValue());
+  m_ScatterMatrix.SetSize(measurementVectorSize, measurementVectorSize);
+  m_ScatterMatrix.Fill(NumericTraits<MeasurementRealType>::ZeroValue());
+  for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+  {
+    m_Mean[dim] = moments.Mean[dim];
+  }
+
+  if (m_ComputeCovariance)
+  {
+    SizeValueType k = 0;
+    for (unsigned int row = 0; row < measurementVectorSize; ++row)
+    {
+      for (unsigned int col = 0; col <= row; ++col, ++k)
+      {
+        m_ScatterMatrix(row, col) = moments.Scatter[k];
+        m_ScatterMatrix(col, row) = moments.Scatter[k];
+      }
+      m_SumOfSquaredDeviations[row] = m_ScatterMatrix(row, row);
+    }
+  }
+  else if (m_ComputeVariance)
+  {
+    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+    {
+      m_SumOfSquaredDeviations[dim] = moments.Scatter[dim];
+    }
+  }
+
+  NumericTraits<MeasurementVectorType>::SetLength(m_Minimum, measurementVectorSize);
+  NumericTraits<MeasurementVectorType>::SetLength(m_Maximum, measurementVectorSize);
+  if (m_ComputeBounds && moments.Size > 0)
+  {
+    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+    {
+      m_Minimum[dim] = moments.Minimum[dim];
+      m_Maximum[dim] = moments.Maximum[dim];
+    }
+  }
+}
+
+template <typename TSample>
+void
+SampleMomentsCalculator<TSample>::InitializeMoments(Moments & moments) const
+{
+  moments.Size = 0;
+  moments.Weight = 0.0;
+  moments.Mean.assign(m_MeasurementVectorSize, NumericTraits<MeasurementRealType>::ZeroValue());
+  moments.Scatter.assign(m_ScatterSize, NumericTraits<MeasurementRealType>::ZeroValue());
+  if (m_ComputeBounds)
+  {
+    moments.Minimum.resize(m_MeasurementVectorSize);
+    moments.Maximum.resize(m_MeasurementVectorSize);
+  }
+}
+
+template <typename TSample>
+void
+SampleMomentsCalculator<TSample>::AddMeasurementVector(Moments &                     moments,
+                                                       const MeasurementVectorType & measurements,
+                                                       WeightValueType               weight) const
+{
+  if (Math::ExactlyEquals(weight, 0.0))
+  {
+    return;
+  }
+
+  const MeasurementVectorSizeType measurementVectorSize = m_MeasurementVectorSize;
+
+  if (m_ComputeBounds)
+  {
+    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+    {
+      const MeasurementType component = measurements[dim];
+      if (moments.Size == 0 || component < moments.Minimum[dim])
+      {
+        moments.Minimum[dim] = component;
+      }
+      if (moments.Size == 0 || component > moments.Maximum[dim])
+      {
+        moments.Maximum[dim] = component;
+      }
+    }
+  }
+
+  ++moments.Size;
+  moments.Weight += weight;
+
+  // update of Welford: the deviation from the previous mean, multiplied by
+  // the deviation from the new mean, is added to the scatter
+  const auto ratio = static_cast<MeasurementRealType>(weight / moments.Weight);
+  const auto factor = static_cast<MeasurementRealType>(weight) * (1.0 - ratio);
+
+  if (m_ComputeCovariance)
+  {
+    MeasurementRealType * scatter = moments.Scatter.data();
+    for (unsigned int row = 0; row < measurementVectorSize; ++row)
+    {
+      const MeasurementRealType rowDelta = static_cast<MeasurementRealType>(measurements[row]) - moments.Mean[row];
+      for (unsigned int col = 0; col <= row; ++col)
+      {
+        const MeasurementRealType colDelta = static_cast<MeasurementRealType>(measurements[col]) - moments.Mean[col];
+        *scatter++ += factor * rowDelta * colDelta;
+      }
+    }
+  }
+  else if (m_ComputeVariance)
+  {
+    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+    {
+      const MeasurementRealType delta = static_cast<MeasurementRealType>(measurements[dim]) - moments.Mean[dim];
+      moments.Scatter[dim] += factor * delta * delta;
+    }
+  }
+
+  for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+  {
+    moments.Mean[dim] += (static_cast<MeasurementRealType>(measurements[dim]) - moments.Mean[dim]) * ratio;
+  }
+}
+
+template <typename TSample>
+void
+SampleMomentsCalculator<TSample>::MergeMoments(Moments & moments, const Moments & blockMoments) const
+{
+  if (blockMoments.Size == 0)
+  {
+    return;
+  }
+  if (moments.Size == 0)
+  {
+    moments = blockMoments;
+    return;
+  }
+
+  const MeasurementVectorSizeType measurementVectorSize = m_MeasurementVectorSize;
+
+  if (m_ComputeBounds)
+  {
+    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+    {
+      if (blockMoments.Minimum[dim] < moments.Minimum[dim])
+      {
+        moments.Minimum[dim] = blockMoments.Minimum[dim];
+      }
+      if (blockMoments.Maximum[dim] > moments.Maximum[dim])
+      {
+        moments.Maximum[dim] = blockMoments.Maximum[dim];
+      }
+    }
+  }
+
+  // merge of Chan et al.: the outer product of the difference of the means,
+  // multiplied by the product of the weights over their sum, is added to the
+  // sum of the scatters
+  const WeightValueType weight = moments.Weight + blockMoments.Weight;
+  const auto            ratio = static_cast<MeasurementRealType>(blockMoments.Weight / weight);
+  const auto            factor = static_cast<MeasurementRealType>(moments.Weight) * ratio;
+
+  if (m_ComputeCovariance)
+  {
+    SizeValueType k = 0;
+    for (unsigned int row = 0; row < measurementVectorSize; ++row)
+    {
+      const MeasurementRealType rowDelta = blockMoments.Mean[row] - moments.Mean[row];
+      for (unsigned int col = 0; col <= row; ++col, ++k)
+      {
+        const MeasurementRealType colDelta = blockMoments.Mean[col] - moments.Mean[col];
+        moments.Scatter[k] += blockMoments.Scatter[k] + factor * rowDelta * colDelta;
+      }
+    }
+  }
+  else if (m_ComputeVariance)
+  {
+    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+    {
+      const MeasurementRealType delta = blockMoments.Mean[dim] - moments.Mean[dim];
+      moments.Scatter[dim] += blockMoments.Scatter[dim] + factor * delta * delta;
+    }
+  }
+
+  for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+  {
+    moments.Mean[dim] += (blockMoments.Mean[dim] - moments.Mean[dim]) * ratio;
+  }
+
+  moments.Size += blockMoments.Size;
+  moments.Weight = weight;
+}
+
+template <typename TSample>
+template <typename TBlockFunction>
+void
+SampleMomentsCalculator<TSample>::ComputeBlocks(SizeValueType          firstId,
+                                                SizeValueType          size,
+                                                const TBlockFunction & blockFunction,
+                                                Moments &              moments)
+{
+  if (size == 0)
+  {
+    return;
+  }
+
+  // the blocks don't depend on the number of threads, so that neither does
+  // the order in which their moments are merged
+  constexpr SizeValueType maximumNumberOfBlocks = 1024;
+  constexpr SizeValueType minimumBlockSize = 1024;
+  const SizeValueType     blockSize =
+    std::max(minimumBlockSize, (size + maximumNumberOfBlocks - 1) / maximumNumberOfBlocks);
+  const SizeValueType numberOfBlocks = (size + blockSize - 1) / blockSize;
+
+  std::vector<Moments> blockMoments(numberOfBlocks);
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [this, firstId, size, blockSize, &blockFunction, &blockMoments](SizeValueType block) {
+      Moments & currentMoments = blockMoments[block];
+      this->InitializeMoments(currentMoments);
+      const SizeValueType begin = firstId + block * blockSize;
+      const SizeValueType end = std::min(begin + blockSize, firstId + size);
+      blockFunction(begin, end, currentMoments);
+    },
+    nullptr);
+
+  for (const Moments & currentMoments : blockMoments)
+  {
+    this->MergeMoments(moments, currentMoments);
+  }
+}
+
+template <typename TSample>
+template <typename TImage>
+void
+SampleMomentsCalculator<TSample>::ComputeSample(const ImageToListSampleAdaptor<TImage> * sample, Moments & moments)
+{
+  // each block iterates over its own pixels of the image, since the adaptor
+  // returns its measurement vectors in a member
+  const TImage * image = sample->GetImage();
+
+  auto blockFunction = [this, image](SizeValueType begin, SizeValueType end, Moments & blockMoments) {
+    ImageRegionConstIterator<TImage> it(image, image->GetBufferedRegion());
+    it.SetIndex(image->ComputeIndex(static_cast<OffsetValueType>(begin)));
+
+    MeasurementVectorType measurements;
+    NumericTraits<MeasurementVectorType>::SetLength(measurements, m_MeasurementVectorSize);
+    for (SizeValueType id = begin; id < end; ++id, ++it)
+    {
+      MeasurementVectorTraits::Assign(measurements, it.Get());
+      this->AddMeasurementVector(blockMoments, measurements, this->GetWeight(id, measurements, 1.0));
+    }
+  };
+  this->ComputeBlocks(0, sample->Size(), blockFunction, moments);
+}
+
+template <typename TSample>
+void
+SampleMomentsCalculator<TSample>::ComputeSample(const Sample<MeasurementVectorType> * sample, Moments & moments)
+{
+  using ListSampleType = ListSample<MeasurementVectorType>;
+
+  if (typeid(*sample) == typeid(ListSampleType))
+  {
+    // the measurement vectors of a list sample are stored contiguously
+    const auto *        listSample = static_cast<const ListSampleType *>(sample);
+    const SizeValueType size = listSample->Size();
+    if (size == 0)
+    {
+      return;
+    }
+    const MeasurementVectorType * measurements = &(listSample->GetMeasurementVector(0));
+
+    auto blockFunction = [this, measurements](SizeValueType begin, SizeValueType end, Moments & blockMoments) {
+      for (SizeValueType id = begin; id < end; ++id)
+      {
+        this->AddMeasurementVector(blockMoments, measurements[id], this->GetWeight(id, measurements[id], 1.0));
+      }
+    };
+    this->ComputeBlocks(0, size, blockFunction, moments);
+    return;
+  }
+
+  // the other samples are read with their iterator, in chunks which are
+  // copied before being processed in parallel
+  constexpr SizeValueType            chunkSize = 64 * 1024;
+  std::vector<MeasurementVectorType> measurements(chunkSize);
+  std::vector<WeightValueType>       frequencies(chunkSize);
+
+  typename SampleType::ConstIterator       iter = m_Sample->Begin();
+  const typename SampleType::ConstIterator end = m_Sample->End();
+
+  SizeValueType firstId = 0;
+  while (iter != end)
+  {
+    SizeValueType count = 0;
+    for (; iter != end && count < chunkSize; ++iter, ++count)
+    {
+      measurements[count] = iter.GetMeasurementVector();
+      frequencies[count] = static_cast<WeightValueType>(iter.GetFrequency());
+    }
+
+    auto blockFunction = [this, firstId, &measurements, &frequencies](
+                           SizeValueType begin, SizeValueType blockEnd, Moments & blockMoments) {
+      for (SizeValueType id = begin; id < blockEnd; ++id)
+      {
+        const MeasurementVectorType & measurement = measurements[id - firstId];
+        this->AddMeasurementVector(
+          blockMoments, measurement, this->GetWeight(id, measurement, frequencies[id - firstId]));
+      }
+    };
+    this->ComputeBlocks(firstId, count, blockFunction, moments);
+    firstId += count;
+  }
+}
+} // end of namespace Statistics
+} // end of namespace itk
+
+#endif
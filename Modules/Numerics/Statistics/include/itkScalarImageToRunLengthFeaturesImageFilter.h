@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkScalarImageToRunLengthFeaturesImageFilter_h
+#define itkScalarImageToRunLengthFeaturesImageFilter_h
+
+#include <vector>
+
+#include "itkBoxImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkVectorContainer.h"
+#include "itkHistogramToRunLengthFeaturesFilter.h"
+
+namespace itk
+{
+namespace Statistics
+{
+/** \class ScalarImageToRunLengthFeaturesImageFilter
+ *  \brief This class computes an image of texture features from the grey
+ * level run-length matrix of the neighborhood of each pixel.
+ *
+ * For each pixel of the output, the run-length matrix of the box of the given
+ * radius centered on the pixel is computed as by
+ * ScalarImageToRunLengthMatrixFilter, for the given offsets, and the requested
+ * features are computed from it as by HistogramToRunLengthFeaturesFilter. The
+ * features are the components of the output pixel, in the order of the
+ * requested features. The box is cropped at the largest possible region of
+ * the input. A run is a maximal sequence of pixels of the box, along an
+ * offset, whose intensities are in the same bin, in the intensity range and,
+ * if a mask is set, inside the mask. Its length is the physical distance
+ * between its first and its last pixel. The features of a box without any
+ * run are zero.
+ *
+ * The intensities are quantized once before the matrices are computed. The
+ * matrix of the first box of each line of the output is filled from scratch,
+ * and then updated as the box moves along the line, in the way of
+ * MovingHistogramImageFilter: for an offset along the line, only the runs
+ * which lose their first pixel or gain a last pixel are updated, and for the
+ * other offsets, only the runs of the slices leaving and entering the box are
+ * removed and added. The lines are processed in parallel.
+ *
+ * \sa ScalarImageToRunLengthMatrixFilter
+ * \sa ScalarImageToRunLengthFeaturesFilter
+ * \sa HistogramToRunLengthFeaturesFilter
+ * \sa ScalarImageToTextureFeaturesImageFilter
+ *
+ * \ingroup ITKStatistics
+ */
+template <typename TInputImage, typename TOutputImage = VectorImage<float, TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT ScalarImageToRunLengthFeaturesImageFilter : public BoxImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ScalarImageToRunLengthFeaturesImageFilter);
+
+  /** Standard type alias */
+  using Self = ScalarImageToRunLengthFeaturesImageFilter;
+  using Superclass = BoxImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ScalarImageToRunLengthFeaturesImageFilter, BoxImageFilter);
+
+  /** standard New() method support */
+  itkNewMacro(Self);
+
+  using InputImageType = TInputImage;
+  using MaskImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using PixelType = typename InputImageType::PixelType;
+  using RegionType = typename InputImageType::RegionType;
+  using IndexType = typename InputImageType::IndexType;
+  using OffsetType = typename InputImageType::OffsetType;
+  using RadiusType = typename Superclass::RadiusType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  static constexpr unsigned int ImageDimension = InputImageType::ImageDimension;
+
+  using OffsetVector = VectorContainer<unsigned char, OffsetType>;
+  using OffsetVectorPointer = typename OffsetVector::Pointer;
+  using OffsetVectorConstPointer = typename OffsetVector::ConstPointer;
+
+  using MeasurementType = typename NumericTraits<PixelType>::RealType;
+  using RealType = typename NumericTraits<PixelType>::RealType;
+
+  using RunLengthFeatureEnum = HistogramToRunLengthFeaturesFilterEnums::RunLengthFeature;
+  using RunLengthFeatureName = uint8_t;
+  using FeatureNameVector = VectorContainer<unsigned char, RunLengthFeatureName>;
+  using FeatureNameVectorPointer = typename FeatureNameVector::Pointer;
+  using FeatureNameVectorConstPointer = typename FeatureNameVector::ConstPointer;
+
+  /** Image of the intensity bins of the pixels, where the pixels which are
+   * ignored have the bin -1 */
+  using BinImageType = Image<int, ImageDimension>;
+
+  static constexpr unsigned int DefaultBinsPerAxis = 256;
+
+  /** Set/Get the offsets along which the runs are computed. Defaults to half
+   * of the offsets to the neighbors of a pixel. */
+  itkSetConstObjectMacro(Offsets, OffsetVector);
+  itkGetConstObjectMacro(Offsets, OffsetVector);
+
+  /** Set the features to compute, which are the components of the output
+   * pixels. Defaults to all the run-length features. */
+  itkSetConstObjectMacro(RequestedFeatures, FeatureNameVector);
+  itkGetConstObjectMacro(RequestedFeatures, FeatureNameVector);
+
+  /** Set/Get the number of histogram bins along each axis */
+  itkSetMacro(NumberOfBinsPerAxis, unsigned int);
+  itkGetConstMacro(NumberOfBinsPerAxis, unsigned int);
+
+  /** Set the min and max (inclusive) pixel value that will be placed in the
+   * run-length matrices */
+  void
+  SetPixelValueMinMax(PixelType min, PixelType max);
+
+  itkGetConstMacro(Min, PixelType);
+  itkGetConstMacro(Max, PixelType);
+
+  /** Set the min and max (inclusive) run length that will be placed in the
+   * run-length matrices */
+  void
+  SetDistanceValueMinMax(RealType min, RealType max);
+
+  itkGetConstMacro(MinDistance, RealType);
+  itkGetConstMacro(MaxDistance, RealType);
+
+  /** Set/Get the mask image. Only the pixels whose mask value is the inside
+   * pixel value are part of runs. */
+  itkSetInputMacro(MaskImage, MaskImageType);
+  itkGetInputMacro(MaskImage, MaskImageType);
+
+  /** Set/Get the pixel value of the mask that should be considered "inside"
+   * the object. Defaults to one. */
+  itkSetMacro(InsidePixelValue, PixelType);
+  itkGetConstMacro(InsidePixelValue, PixelType);
+
+protected:
+  ScalarImageToRunLengthFeaturesImageFilter();
+  ~ScalarImageToRunLengthFeaturesImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The number of components of the output is the number of requested
+   * features */
+  void
+  GenerateOutputInformation() override;
+
+  /** The mask requested region is the padded input requested region */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Quantizes the intensities of the input requested region, and the
+   * lengths of the runs along each offset */
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void
+  AfterThreadedGenerateData() override;
+
+private:
+  /** Run-length matrix of a box, with the sums of its rows and columns */
+  struct RunLengthMatrix
+  {
+    std::vector<OffsetValueType> Frequencies;
+    std::vector<OffsetValueType> GreyLevelFrequencies;
+    std::vector<OffsetValueType> RunLengthFrequencies;
+    OffsetValueType              TotalFrequency{ 0 };
+  };
+
+  /** Adds increment to the frequency of the runs of numberOfPixels pixels of
+   * the given bin along the offset offsetId */
+  void
+  AddRun(int               bin,
+         SizeValueType     numberOfPixels,
+         unsigned int      offsetId,
+         OffsetValueType   increment,
+         RunLengthMatrix & matrix) const;
+
+  /** Returns the number of consecutive pixels of the given bin in the region,
+   * starting at index and moving by step */
+  SizeValueType
+  GetRunLength(IndexType index, const OffsetType & step, int bin, const RegionType & region) const;
+
+  /** Adds increment to the frequencies of all the runs of the slice along the
+   * offset offsetId */
+  void
+  UpdateRunsOfSlice(const RegionType & slice,
+                    unsigned int       offsetId,
+                    OffsetValueType    increment,
+                    RunLengthMatrix &  matrix) const;
+
+  /** Moves the runs along the offset offsetId from window to nextWindow,
+   * which is window moved by one pixel along the first axis */
+  void
+  MoveRuns(const RegionType & window,
+           const RegionType & nextWindow,
+           unsigned int       offsetId,
+           RunLengthMatrix &  matrix) const;
+
+  /** Computes all the run-length features of a run-length matrix, indexed by
+   * RunLengthFeatureEnum */
+  void
+  ComputeFeatures(const RunLengthMatrix & matrix, double * features) const;
+
+  OffsetVectorConstPointer      m_Offsets;
+  FeatureNameVectorConstPointer m_RequestedFeatures;
+  unsigned int                  m_NumberOfBinsPerAxis{ DefaultBinsPerAxis };
+  PixelType                     m_Min;
+  PixelType                     m_Max;
+  RealType                      m_MinDistance;
+  RealType                      m_MaxDistance;
+  PixelType                     m_InsidePixelValue;
+
+  typename BinImageType::Pointer m_BinImage;
+
+  /** Bin of the length of a run of n pixels along each offset, or -1 if it
+   * is out of the distance range */
+  std::vector<std::vector<int>> m_RunLengthBins;
+};
+} // end of namespace Statistics
+} // end of namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkScalarImageToRunLengthFeaturesImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,585 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkScalarImageToRunLengthFeaturesImageFilter_hxx
+#define itkScalarImageToRunLengthFeaturesImageFilter_hxx
+
+#include "itkScalarImageToRunLengthFeaturesImageFilter.h"
+
+#include <algorithm>
+
+#include "itkNeighborhood.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageLinearIteratorWithIndex.h"
+#include "itkTotalProgressReporter.h"
+#include "itkMath.h"
+
+namespace itk
+{
+namespace Statistics
+{
+template <typename TInputImage, typename TOutputImage>
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::ScalarImageToRunLengthFeaturesImageFilter()
+  : m_Min(NumericTraits<PixelType>::NonpositiveMin())
+  , m_Max(NumericTraits<PixelType>::max())
+  , m_MinDistance(NumericTraits<RealType>::ZeroValue())
+  , m_MaxDistance(NumericTraits<RealType>::max())
+  , m_InsidePixelValue(NumericTraits<PixelType>::OneValue())
+{
+  // #1 "MaskImage" optional
+  Self::AddOptionalInputName("MaskImage", 1);
+
+  // Set the requested features to all the run-length features
+  FeatureNameVectorPointer requestedFeatures = FeatureNameVector::New();
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::ShortRunEmphasis));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::LongRunEmphasis));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::GreyLevelNonuniformity));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::RunLengthNonuniformity));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::LowGreyLevelRunEmphasis));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::HighGreyLevelRunEmphasis));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::ShortRunLowGreyLevelEmphasis));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::ShortRunHighGreyLevelEmphasis));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::LongRunLowGreyLevelEmphasis));
+  requestedFeatures->push_back(static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::LongRunHighGreyLevelEmphasis));
+  this->SetRequestedFeatures(requestedFeatures);
+
+  // Set the offsets to all the "previous" neighbors that are
+  // face+edge+vertex connected to the current pixel.
+  Neighborhood<PixelType, ImageDimension> hood;
+  hood.SetRadius(1);
+  const unsigned int  centerIndex = hood.GetCenterNeighborhoodIndex();
+  OffsetVectorPointer offsets = OffsetVector::New();
+  for (unsigned int d = 0; d < centerIndex; ++d)
+  {
+    offsets->push_back(hood.GetOffset(d));
+  }
+  this->SetOffsets(offsets);
+
+  this->DynamicMultiThreadingOn();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::SetPixelValueMinMax(PixelType min, PixelType max)
+{
+  if (m_Min != min || m_Max != max)
+  {
+    itkDebugMacro("setting Min to " << min << "and Max to " << max);
+    m_Min = min;
+    m_Max = max;
+    this->Modified();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::SetDistanceValueMinMax(RealType min,
+                                                                                             RealType max)
+{
+  if (Math::NotExactlyEquals(m_MinDistance, min) || Math::NotExactlyEquals(m_MaxDistance, max))
+  {
+    itkDebugMacro("setting MinDistance to " << min << "and MaxDistance to " << max);
+    m_MinDistance = min;
+    m_MaxDistance = max;
+    this->Modified();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  this->GetOutput()->SetNumberOfComponentsPerPixel(m_RequestedFeatures->Size());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * maskImage = const_cast<MaskImageType *>(this->GetMaskImage());
+  if (maskImage)
+  {
+    maskImage->SetRequestedRegion(this->GetInput()->GetRequestedRegion());
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  if (m_NumberOfBinsPerAxis == 0)
+  {
+    itkExceptionMacro("NumberOfBinsPerAxis must be greater than zero");
+  }
+  for (const RunLengthFeatureName feature : m_RequestedFeatures->CastToSTLConstContainer())
+  {
+    if (feature > static_cast<RunLengthFeatureName>(RunLengthFeatureEnum::LongRunHighGreyLevelEmphasis))
+    {
+      itkExceptionMacro("Invalid run-length feature " << static_cast<unsigned int>(feature));
+    }
+  }
+
+  const InputImageType * input = this->GetInput();
+  const MaskImageType *  maskImage = this->GetMaskImage();
+  const RegionType &     region = input->GetRequestedRegion();
+
+  // The bins are the ones of the histogram of ScalarImageToRunLengthMatrixFilter
+  using HistogramType = Histogram<MeasurementType>;
+  typename HistogramType::SizeType size(1);
+  size.Fill(m_NumberOfBinsPerAxis);
+  typename HistogramType::MeasurementVectorType measurement(1);
+  typename HistogramType::MeasurementVectorType lowerBound(1);
+  typename HistogramType::MeasurementVectorType upperBound(1);
+  typename HistogramType::IndexType             index(1);
+
+  // Quantize the lengths of the runs which fit in a box
+  typename HistogramType::Pointer distanceHistogram = HistogramType::New();
+  distanceHistogram->SetMeasurementVectorSize(1);
+  lowerBound.Fill(m_MinDistance);
+  upperBound.Fill(m_MaxDistance);
+  distanceHistogram->Initialize(size, lowerBound, upperBound);
+
+  const RadiusType radius = this->GetRadius();
+  const auto &     spacing = input->GetSpacing();
+  m_RunLengthBins.clear();
+  for (const OffsetType & offset : m_Offsets->CastToSTLConstContainer())
+  {
+    SizeValueType maximumNumberOfPixels = NumericTraits<SizeValueType>::max();
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      if (offset[i] != 0)
+      {
+        const SizeValueType step = Math::abs(offset[i]);
+        maximumNumberOfPixels = std::min(maximumNumberOfPixels, 2 * radius[i] / step + 1);
+      }
+    }
+    if (maximumNumberOfPixels == NumericTraits<SizeValueType>::max())
+    {
+      itkExceptionMacro("Offsets must not be zero");
+    }
+
+    std::vector<int> runLengthBins(maximumNumberOfPixels + 1, -1);
+    for (SizeValueType n = 1; n <= maximumNumberOfPixels; ++n)
+    {
+      // The length of the run is the distance between its first and its last pixel
+      double squaredDistance = 0.0;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        const double component = static_cast<double>(n - 1) * offset[i] * spacing[i];
+        squaredDistance += component * component;
+      }
+      measurement[0] = std::sqrt(squaredDistance);
+      if (measurement[0] >= m_MinDistance && measurement[0] <= m_MaxDistance)
+      {
+        distanceHistogram->GetIndex(measurement, index);
+        runLengthBins[n] = static_cast<int>(index[0]);
+      }
+    }
+    m_RunLengthBins.push_back(runLengthBins);
+  }
+
+  // Quantize the intensities
+  typename HistogramType::Pointer histogram = HistogramType::New();
+  histogram->SetMeasurementVectorSize(1);
+  lowerBound.Fill(m_Min);
+  upperBound.Fill(m_Max);
+  histogram->Initialize(size, lowerBound, upperBound);
+
+  m_BinImage = BinImageType::New();
+  m_BinImage->SetRegions(region);
+  m_BinImage->Allocate();
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this, input, maskImage, histogram](const RegionType & subRegion) {
+      typename HistogramType::MeasurementVectorType pixelMeasurement(1);
+      typename HistogramType::IndexType             pixelIndex(1);
+
+      ImageRegionConstIterator<MaskImageType> maskIt;
+      if (maskImage)
+      {
+        maskIt = ImageRegionConstIterator<MaskImageType>(maskImage, subRegion);
+      }
+      ImageRegionConstIterator<InputImageType> inputIt(input, subRegion);
+      ImageRegionIterator<BinImageType>        binIt(m_BinImage, subRegion);
+      for (; !inputIt.IsAtEnd(); ++inputIt, ++binIt)
+      {
+        const PixelType value = inputIt.Get();
+        bool            inside = value >= m_Min && value <= m_Max;
+        if (maskImage)
+        {
+          inside = inside && maskIt.Get() == m_InsidePixelValue;
+          ++maskIt;
+        }
+        int bin = -1;
+        if (inside)
+        {
+          pixelMeasurement[0] = value;
+          histogram->GetIndex(pixelMeasurement, pixelIndex);
+          bin = static_cast<int>(pixelIndex[0]);
+        }
+        binIt.Set(bin);
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  constexpr auto numberOfRunLengthFeatures =
+    static_cast<unsigned int>(RunLengthFeatureEnum::LongRunHighGreyLevelEmphasis) + 1;
+  using OutputValueType = typename NumericTraits<OutputPixelType>::ValueType;
+
+  OutputImageType *  output = this->GetOutput();
+  const RegionType   largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  const RadiusType   radius = this->GetRadius();
+  const unsigned int numberOfBins = m_NumberOfBinsPerAxis;
+  const unsigned int numberOfFeatures = m_RequestedFeatures->Size();
+  const auto         numberOfOffsets = static_cast<unsigned int>(m_Offsets->Size());
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  RunLengthMatrix matrix;
+  matrix.Frequencies.resize(static_cast<size_t>(numberOfBins) * numberOfBins);
+  matrix.GreyLevelFrequencies.resize(numberOfBins);
+  matrix.RunLengthFrequencies.resize(numberOfBins);
+
+  double features[numberOfRunLengthFeatures];
+
+  OutputPixelType outputPixel;
+  NumericTraits<OutputPixelType>::SetLength(outputPixel, numberOfFeatures);
+
+  // The box centered on a pixel, cropped at the largest possible region
+  auto boxAt = [&radius, &largestRegion](const IndexType & center) {
+    RegionType box(center, RadiusType::Filled(1));
+    box.PadByRadius(radius);
+    box.Crop(largestRegion);
+    return box;
+  };
+
+  ImageLinearIteratorWithIndex<OutputImageType> outputIt(output, outputRegionForThread);
+  outputIt.SetDirection(0);
+  for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); outputIt.NextLine())
+  {
+    // Fill the matrix of the first box of the line from scratch
+    std::fill(matrix.Frequencies.begin(), matrix.Frequencies.end(), 0);
+    std::fill(matrix.GreyLevelFrequencies.begin(), matrix.GreyLevelFrequencies.end(), 0);
+    std::fill(matrix.RunLengthFrequencies.begin(), matrix.RunLengthFrequencies.end(), 0);
+    matrix.TotalFrequency = 0;
+
+    IndexType  index = outputIt.GetIndex();
+    RegionType window = boxAt(index);
+    for (unsigned int offsetId = 0; offsetId < numberOfOffsets; ++offsetId)
+    {
+      this->UpdateRunsOfSlice(window, offsetId, 1, matrix);
+    }
+
+    while (true)
+    {
+      this->ComputeFeatures(matrix, features);
+      for (unsigned int i = 0; i < numberOfFeatures; ++i)
+      {
+        outputPixel[i] = static_cast<OutputValueType>(features[m_RequestedFeatures->ElementAt(i)]);
+      }
+      outputIt.Set(outputPixel);
+
+      ++outputIt;
+      if (outputIt.IsAtEndOfLine())
+      {
+        break;
+      }
+
+      // Move the box by one pixel along the line
+      ++index[0];
+      const RegionType nextWindow = boxAt(index);
+      for (unsigned int offsetId = 0; offsetId < numberOfOffsets; ++offsetId)
+      {
+        this->MoveRuns(window, nextWindow, offsetId, matrix);
+      }
+      window = nextWindow;
+    }
+    progress.Completed(outputRegionForThread.GetSize(0));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
+{
+  m_BinImage = nullptr;
+  m_RunLengthBins.clear();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::AddRun(int               bin,
+                                                                             SizeValueType     numberOfPixels,
+                                                                             unsigned int      offsetId,
+                                                                             OffsetValueType   increment,
+                                                                             RunLengthMatrix & matrix) const
+{
+  const int runLengthBin = m_RunLengthBins[offsetId][numberOfPixels];
+  if (runLengthBin < 0)
+  {
+    return;
+  }
+  matrix.Frequencies[static_cast<size_t>(bin) * m_NumberOfBinsPerAxis + runLengthBin] += increment;
+  matrix.GreyLevelFrequencies[bin] += increment;
+  matrix.RunLengthFrequencies[runLengthBin] += increment;
+  matrix.TotalFrequency += increment;
+}
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::GetRunLength(IndexType          index,
+                                                                                   const OffsetType & step,
+                                                                                   int                bin,
+                                                                                   const RegionType & region) const
+{
+  SizeValueType numberOfPixels = 0;
+  while (region.IsInside(index) && m_BinImage->GetPixel(index) == bin)
+  {
+    ++numberOfPixels;
+    index += step;
+  }
+  return numberOfPixels;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::UpdateRunsOfSlice(const RegionType & slice,
+                                                                                        unsigned int       offsetId,
+                                                                                        OffsetValueType    increment,
+                                                                                        RunLengthMatrix &  matrix) const
+{
+  const OffsetType & offset = m_Offsets->ElementAt(offsetId);
+
+  for (ImageRegionConstIteratorWithIndex<BinImageType> it(m_BinImage, slice); !it.IsAtEnd(); ++it)
+  {
+    const int bin = it.Get();
+    if (bin < 0)
+    {
+      continue;
+    }
+
+    // Count each run from its first pixel
+    const IndexType & index = it.GetIndex();
+    const IndexType   previous = index - offset;
+    if (slice.IsInside(previous) && m_BinImage->GetPixel(previous) == bin)
+    {
+      continue;
+    }
+    this->AddRun(bin, this->GetRunLength(index, offset, bin, slice), offsetId, increment, matrix);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::MoveRuns(const RegionType & window,
+                                                                               const RegionType & nextWindow,
+                                                                               unsigned int       offsetId,
+                                                                               RunLengthMatrix &  matrix) const
+{
+  const IndexValueType windowEnd = window.GetIndex(0) + static_cast<IndexValueType>(window.GetSize(0));
+  const IndexValueType nextWindowEnd = nextWindow.GetIndex(0) + static_cast<IndexValueType>(nextWindow.GetSize(0));
+
+  const bool           hasRemovedSlice = nextWindow.GetIndex(0) > window.GetIndex(0);
+  const bool           hasAddedSlice = nextWindowEnd > windowEnd;
+
+  RegionType removedSlice = window;
+  removedSlice.SetSize(0, 1);
+  RegionType addedSlice = nextWindow;
+  addedSlice.SetIndex(0, windowEnd);
+  addedSlice.SetSize(0, 1);
+
+  OffsetType step = m_Offsets->ElementAt(offsetId);
+  if (step[0] == 0)
+  {
+    // The runs are either in a slice or unchanged
+    if (hasRemovedSlice)
+    {
+      this->UpdateRunsOfSlice(removedSlice, offsetId, -1, matrix);
+    }
+    if (hasAddedSlice)
+    {
+      this->UpdateRunsOfSlice(addedSlice, offsetId, 1, matrix);
+    }
+    return;
+  }
+
+  // Each line along the offset has at most one pixel in a slice, which is
+  // one of its ends in the box. The first pixels are removed from the runs
+  // which start in the removed slice, and then the last pixels are added to
+  // the runs which end in the added slice.
+  if (step[0] < 0)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      step[d] = -step[d];
+    }
+  }
+  OffsetType backStep;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    backStep[d] = -step[d];
+  }
+  if (hasRemovedSlice)
+  {
+    for (ImageRegionConstIteratorWithIndex<BinImageType> it(m_BinImage, removedSlice); !it.IsAtEnd(); ++it)
+    {
+      const int bin = it.Get();
+      if (bin < 0)
+      {
+        continue;
+      }
+      const SizeValueType numberOfPixels = this->GetRunLength(it.GetIndex(), step, bin, window);
+      this->AddRun(bin, numberOfPixels, offsetId, -1, matrix);
+      if (numberOfPixels > 1)
+      {
+        this->AddRun(bin, numberOfPixels - 1, offsetId, 1, matrix);
+      }
+    }
+  }
+  if (hasAddedSlice)
+  {
+    RegionType remainingWindow = window;
+    remainingWindow.SetIndex(0, nextWindow.GetIndex(0));
+    remainingWindow.SetSize(0, static_cast<SizeValueType>(windowEnd - nextWindow.GetIndex(0)));
+    for (ImageRegionConstIteratorWithIndex<BinImageType> it(m_BinImage, addedSlice); !it.IsAtEnd(); ++it)
+    {
+      const int bin = it.Get();
+      if (bin < 0)
+      {
+        continue;
+      }
+      const SizeValueType numberOfPixels = this->GetRunLength(it.GetIndex() + backStep, backStep, bin, remainingWindow);
+      if (numberOfPixels > 0)
+      {
+        this->AddRun(bin, numberOfPixels, offsetId, -1, matrix);
+      }
+      this->AddRun(bin, numberOfPixels + 1, offsetId, 1, matrix);
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::ComputeFeatures(const RunLengthMatrix & matrix,
+                                                                                      double * features) const
+{
+  constexpr auto numberOfRunLengthFeatures =
+    static_cast<unsigned int>(RunLengthFeatureEnum::LongRunHighGreyLevelEmphasis) + 1;
+  std::fill(features, features + numberOfRunLengthFeatures, 0.0);
+  if (matrix.TotalFrequency == 0)
+  {
+    return;
+  }
+
+  // As in HistogramToRunLengthFeaturesFilter
+  const unsigned int numberOfBins = m_NumberOfBinsPerAxis;
+  double             shortRunEmphasis = 0.0;
+  double             longRunEmphasis = 0.0;
+  double             greyLevelNonuniformity = 0.0;
+  double             runLengthNonuniformity = 0.0;
+  double             lowGreyLevelRunEmphasis = 0.0;
+  double             highGreyLevelRunEmphasis = 0.0;
+  double             shortRunLowGreyLevelEmphasis = 0.0;
+  double             shortRunHighGreyLevelEmphasis = 0.0;
+  double             longRunLowGreyLevelEmphasis = 0.0;
+  double             longRunHighGreyLevelEmphasis = 0.0;
+  for (unsigned int i = 0; i < numberOfBins; ++i)
+  {
+    const auto greyLevelFrequency = static_cast<double>(matrix.GreyLevelFrequencies[i]);
+    const auto runLengthFrequency = static_cast<double>(matrix.RunLengthFrequencies[i]);
+    greyLevelNonuniformity += greyLevelFrequency * greyLevelFrequency;
+    runLengthNonuniformity += runLengthFrequency * runLengthFrequency;
+    if (matrix.GreyLevelFrequencies[i] == 0)
+    {
+      continue;
+    }
+
+    const OffsetValueType * row = &matrix.Frequencies[static_cast<size_t>(i) * numberOfBins];
+    const double            i2 = static_cast<double>(i + 1) * static_cast<double>(i + 1);
+    for (unsigned int j = 0; j < numberOfBins; ++j)
+    {
+      if (row[j] == 0)
+      {
+        continue;
+      }
+      const auto   frequency = static_cast<double>(row[j]);
+      const double j2 = static_cast<double>(j + 1) * static_cast<double>(j + 1);
+      shortRunEmphasis += frequency / j2;
+      longRunEmphasis += frequency * j2;
+      lowGreyLevelRunEmphasis += frequency / i2;
+      highGreyLevelRunEmphasis += frequency * i2;
+      shortRunLowGreyLevelEmphasis += frequency / (i2 * j2);
+      shortRunHighGreyLevelEmphasis += frequency * i2 / j2;
+      longRunLowGreyLevelEmphasis += frequency * j2 / i2;
+      longRunHighGreyLevelEmphasis += frequency * i2 * j2;
+    }
+  }
+
+  // Normalize all measures by the total number of runs
+  const auto totalNumberOfRuns = static_cast<double>(matrix.TotalFrequency);
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::ShortRunEmphasis)] = shortRunEmphasis / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::LongRunEmphasis)] = longRunEmphasis / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::GreyLevelNonuniformity)] =
+    greyLevelNonuniformity / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::RunLengthNonuniformity)] =
+    runLengthNonuniformity / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::LowGreyLevelRunEmphasis)] =
+    lowGreyLevelRunEmphasis / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::HighGreyLevelRunEmphasis)] =
+    highGreyLevelRunEmphasis / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::ShortRunLowGreyLevelEmphasis)] =
+    shortRunLowGreyLevelEmphasis / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::ShortRunHighGreyLevelEmphasis)] =
+    shortRunHighGreyLevelEmphasis / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::LongRunLowGreyLevelEmphasis)] =
+    longRunLowGreyLevelEmphasis / totalNumberOfRuns;
+  features[static_cast<unsigned int>(RunLengthFeatureEnum::LongRunHighGreyLevelEmphasis)] =
+    longRunHighGreyLevelEmphasis / totalNumberOfRuns;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToRunLengthFeaturesImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os,
+                                                                                Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Offsets: " << this->GetOffsets() << std::endl;
+  os << indent << "RequestedFeatures: " << this->GetRequestedFeatures() << std::endl;
+  os << indent << "NumberOfBinsPerAxis: " << m_NumberOfBinsPerAxis << std::endl;
+  os << indent << "Min: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_Min) << std::endl;
+  os << indent << "Max: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_Max) << std::endl;
+  os << indent << "MinDistance: " << m_MinDistance << std::endl;
+  os << indent << "MaxDistance: " << m_MaxDistance << std::endl;
+  os << indent << "InsidePixelValue: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_InsidePixelValue)
+     << std::endl;
+}
+} // end of namespace Statistics
+} // end of namespace itk
+
+#endif
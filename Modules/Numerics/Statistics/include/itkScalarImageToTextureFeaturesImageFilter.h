@@ -0,0 +1,211 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkScalarImageToTextureFeaturesImageFilter_h
+#define itkScalarImageToTextureFeaturesImageFilter_h
+
+#include <vector>
+
+#include "itkBoxImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkVectorContainer.h"
+#include "itkHistogramToTextureFeaturesFilter.h"
+
+namespace itk
+{
+namespace Statistics
+{
+/** \class ScalarImageToTextureFeaturesImageFilter
+ *  \brief This class computes an image of texture features from the grey
+ * level co-occurrence matrix of the neighborhood of each pixel.
+ *
+ * For each pixel of the output, the co-occurrence matrix of the box of the
+ * given radius centered on the pixel is computed as by
+ * ScalarImageToCooccurrenceMatrixFilter, for the given offsets, and the
+ * requested features are computed from it as by
+ * HistogramToTextureFeaturesFilter. The features are the components of the
+ * output pixel, in the order of the requested features. The box is cropped at
+ * the largest possible region of the input, and a co-occurrence pair is only
+ * counted when both of its pixels are in the box, in the intensity range and,
+ * if a mask is set, inside the mask. The features of a box without any pair
+ * are zero.
+ *
+ * The intensities are quantized once before the matrices are computed. The
+ * matrix of the first box of each line of the output is filled from scratch,
+ * and then updated as the box moves along the line: only the pairs with a
+ * pixel in the slice leaving the box are removed, and only the pairs with a
+ * pixel in the slice entering the box are added, in the way of
+ * MovingHistogramImageFilter. The features are computed from the occupied
+ * bins of the matrix only, so that a large number of bins doesn't slow down
+ * the computation of small boxes. The lines are processed in parallel.
+ *
+ * \sa ScalarImageToCooccurrenceMatrixFilter
+ * \sa ScalarImageToTextureFeaturesFilter
+ * \sa HistogramToTextureFeaturesFilter
+ * \sa ScalarImageToRunLengthFeaturesImageFilter
+ *
+ * \ingroup ITKStatistics
+ */
+template <typename TInputImage, typename TOutputImage = VectorImage<float, TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT ScalarImageToTextureFeaturesImageFilter : public BoxImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ScalarImageToTextureFeaturesImageFilter);
+
+  /** Standard type alias */
+  using Self = ScalarImageToTextureFeaturesImageFilter;
+  using Superclass = BoxImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ScalarImageToTextureFeaturesImageFilter, BoxImageFilter);
+
+  /** standard New() method support */
+  itkNewMacro(Self);
+
+  using InputImageType = TInputImage;
+  using MaskImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using PixelType = typename InputImageType::PixelType;
+  using RegionType = typename InputImageType::RegionType;
+  using IndexType = typename InputImageType::IndexType;
+  using OffsetType = typename InputImageType::OffsetType;
+  using RadiusType = typename Superclass::RadiusType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  static constexpr unsigned int ImageDimension = InputImageType::ImageDimension;
+
+  using OffsetVector = VectorContainer<unsigned char, OffsetType>;
+  using OffsetVectorPointer = typename OffsetVector::Pointer;
+  using OffsetVectorConstPointer = typename OffsetVector::ConstPointer;
+
+  using MeasurementType = typename NumericTraits<PixelType>::RealType;
+
+  using TextureFeatureEnum = HistogramToTextureFeaturesFilterEnums::TextureFeature;
+  using TextureFeatureName = uint8_t;
+  using FeatureNameVector = VectorContainer<unsigned char, TextureFeatureName>;
+  using FeatureNameVectorPointer = typename FeatureNameVector::Pointer;
+  using FeatureNameVectorConstPointer = typename FeatureNameVector::ConstPointer;
+
+  /** Image of the intensity bins of the pixels, where the pixels which are
+   * ignored have the bin -1 */
+  using BinImageType = Image<int, ImageDimension>;
+
+  static constexpr unsigned int DefaultBinsPerAxis = 256;
+
+  /** Set/Get the offsets over which the co-occurrence pairs are counted.
+   * Defaults to half of the offsets to the neighbors of a pixel, the other
+   * half being included by symmetry. */
+  itkSetConstObjectMacro(Offsets, OffsetVector);
+  itkGetConstObjectMacro(Offsets, OffsetVector);
+
+  /** Set the features to compute, which are the components of the output
+   * pixels. Defaults to {Energy, Entropy, InverseDifferenceMoment, Inertia,
+   * ClusterShade, ClusterProminence}, as in
+   * ScalarImageToTextureFeaturesFilter. */
+  itkSetConstObjectMacro(RequestedFeatures, FeatureNameVector);
+  itkGetConstObjectMacro(RequestedFeatures, FeatureNameVector);
+
+  /** Set/Get the number of histogram bins along each axis */
+  itkSetMacro(NumberOfBinsPerAxis, unsigned int);
+  itkGetConstMacro(NumberOfBinsPerAxis, unsigned int);
+
+  /** Set the min and max (inclusive) pixel value that will be placed in the
+   * co-occurrence matrices */
+  void
+  SetPixelValueMinMax(PixelType min, PixelType max);
+
+  itkGetConstMacro(Min, PixelType);
+  itkGetConstMacro(Max, PixelType);
+
+  /** Set/Get the mask image. Only the pixels whose mask value is the inside
+   * pixel value are counted. */
+  itkSetInputMacro(MaskImage, MaskImageType);
+  itkGetInputMacro(MaskImage, MaskImageType);
+
+  /** Set/Get the pixel value of the mask that should be considered "inside"
+   * the object. Defaults to one. */
+  itkSetMacro(InsidePixelValue, PixelType);
+  itkGetConstMacro(InsidePixelValue, PixelType);
+
+protected:
+  ScalarImageToTextureFeaturesImageFilter();
+  ~ScalarImageToTextureFeaturesImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The number of components of the output is the number of requested
+   * features */
+  void
+  GenerateOutputInformation() override;
+
+  /** The mask requested region is the padded input requested region */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Quantizes the intensities of the input requested region */
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void
+  AfterThreadedGenerateData() override;
+
+private:
+  /** Symmetric co-occurrence matrix of a box, with the sums of its rows */
+  struct CooccurrenceMatrix
+  {
+    std::vector<OffsetValueType> Frequencies;
+    std::vector<OffsetValueType> MarginalFrequencies;
+    OffsetValueType              TotalFrequency{ 0 };
+  };
+
+  /** Adds increment to the frequencies of the pairs of pixels of the box
+   * window which have at least one pixel in the slice, which is a part of
+   * the window. */
+  void
+  UpdateCooccurrenceMatrix(const RegionType &   slice,
+                           const RegionType &   window,
+                           OffsetValueType      increment,
+                           CooccurrenceMatrix & matrix) const;
+
+  /** Computes all the texture features of a co-occurrence matrix, indexed by
+   * TextureFeatureEnum */
+  void
+  ComputeFeatures(const CooccurrenceMatrix & matrix, std::vector<unsigned int> & bins, double * features) const;
+
+  OffsetVectorConstPointer      m_Offsets;
+  FeatureNameVectorConstPointer m_RequestedFeatures;
+  unsigned int                  m_NumberOfBinsPerAxis{ DefaultBinsPerAxis };
+  PixelType                     m_Min;
+  PixelType                     m_Max;
+  PixelType                     m_InsidePixelValue;
+
+  typename BinImageType::Pointer m_BinImage;
+};
+} // end of namespace Statistics
+} // end of namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkScalarImageToTextureFeaturesImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,436 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkScalarImageToTextureFeaturesImageFilter_hxx
+#define itkScalarImageToTextureFeaturesImageFilter_hxx
+
+#include "itkScalarImageToTextureFeaturesImageFilter.h"
+
+#include <algorithm>
+
+#include "itkNeighborhood.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageLinearIteratorWithIndex.h"
+#include "itkTotalProgressReporter.h"
+#include "itkMath.h"
+
+namespace itk
+{
+namespace Statistics
+{
+template <typename TInputImage, typename TOutputImage>
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::ScalarImageToTextureFeaturesImageFilter()
+  : m_Min(NumericTraits<PixelType>::NonpositiveMin())
+  , m_Max(NumericTraits<PixelType>::max())
+  , m_InsidePixelValue(NumericTraits<PixelType>::OneValue())
+{
+  // #1 "MaskImage" optional
+  Self::AddOptionalInputName("MaskImage", 1);
+
+  // Set the requested features to the default value:
+  // {Energy, Entropy, InverseDifferenceMoment, Inertia, ClusterShade,
+  // ClusterProminence}
+  FeatureNameVectorPointer requestedFeatures = FeatureNameVector::New();
+  requestedFeatures->push_back(static_cast<TextureFeatureName>(TextureFeatureEnum::Energy));
+  requestedFeatures->push_back(static_cast<TextureFeatureName>(TextureFeatureEnum::Entropy));
+  requestedFeatures->push_back(static_cast<TextureFeatureName>(TextureFeatureEnum::InverseDifferenceMoment));
+  requestedFeatures->push_back(static_cast<TextureFeatureName>(TextureFeatureEnum::Inertia));
+  requestedFeatures->push_back(static_cast<TextureFeatureName>(TextureFeatureEnum::ClusterShade));
+  requestedFeatures->push_back(static_cast<TextureFeatureName>(TextureFeatureEnum::ClusterProminence));
+  this->SetRequestedFeatures(requestedFeatures);
+
+  // Set the offsets to all the "previous" neighbors that are
+  // face+edge+vertex connected to the current pixel.
+  Neighborhood<PixelType, ImageDimension> hood;
+  hood.SetRadius(1);
+  const unsigned int  centerIndex = hood.GetCenterNeighborhoodIndex();
+  OffsetVectorPointer offsets = OffsetVector::New();
+  for (unsigned int d = 0; d < centerIndex; ++d)
+  {
+    offsets->push_back(hood.GetOffset(d));
+  }
+  this->SetOffsets(offsets);
+
+  this->DynamicMultiThreadingOn();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::SetPixelValueMinMax(PixelType min, PixelType max)
+{
+  if (m_Min != min || m_Max != max)
+  {
+    itkDebugMacro("setting Min to " << min << "and Max to " << max);
+    m_Min = min;
+    m_Max = max;
+    this->Modified();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  this->GetOutput()->SetNumberOfComponentsPerPixel(m_RequestedFeatures->Size());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * maskImage = const_cast<MaskImageType *>(this->GetMaskImage());
+  if (maskImage)
+  {
+    maskImage->SetRequestedRegion(this->GetInput()->GetRequestedRegion());
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  if (m_NumberOfBinsPerAxis == 0)
+  {
+    itkExceptionMacro("NumberOfBinsPerAxis must be greater than zero");
+  }
+  for (const TextureFeatureName feature : m_RequestedFeatures->CastToSTLConstContainer())
+  {
+    if (feature >= static_cast<TextureFeatureName>(TextureFeatureEnum::InvalidFeatureName))
+    {
+      itkExceptionMacro("Invalid texture feature " << static_cast<unsigned int>(feature));
+    }
+  }
+
+  const InputImageType * input = this->GetInput();
+  const MaskImageType *  maskImage = this->GetMaskImage();
+  const RegionType &     region = input->GetRequestedRegion();
+
+  m_BinImage = BinImageType::New();
+  m_BinImage->SetRegions(region);
+  m_BinImage->Allocate();
+
+  // The bins are the ones of the histogram of ScalarImageToCooccurrenceMatrixFilter
+  using HistogramType = Histogram<MeasurementType>;
+  typename HistogramType::Pointer histogram = HistogramType::New();
+  histogram->SetMeasurementVectorSize(1);
+  typename HistogramType::SizeType size(1);
+  size.Fill(m_NumberOfBinsPerAxis);
+  typename HistogramType::MeasurementVectorType lowerBound(1);
+  typename HistogramType::MeasurementVectorType upperBound(1);
+  lowerBound.Fill(m_Min);
+  upperBound.Fill(m_Max + 1);
+  histogram->Initialize(size, lowerBound, upperBound);
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this, input, maskImage, histogram](const RegionType & subRegion) {
+      typename HistogramType::MeasurementVectorType measurement(1);
+      typename HistogramType::IndexType             index(1);
+
+      ImageRegionConstIterator<MaskImageType> maskIt;
+      if (maskImage)
+      {
+        maskIt = ImageRegionConstIterator<MaskImageType>(maskImage, subRegion);
+      }
+      ImageRegionConstIterator<InputImageType> inputIt(input, subRegion);
+      ImageRegionIterator<BinImageType>        binIt(m_BinImage, subRegion);
+      for (; !inputIt.IsAtEnd(); ++inputIt, ++binIt)
+      {
+        const PixelType value = inputIt.Get();
+        bool            inside = value >= m_Min && value <= m_Max;
+        if (maskImage)
+        {
+          inside = inside && maskIt.Get() == m_InsidePixelValue;
+          ++maskIt;
+        }
+        int bin = -1;
+        if (inside)
+        {
+          measurement[0] = value;
+          histogram->GetIndex(measurement, index);
+          bin = static_cast<int>(index[0]);
+        }
+        binIt.Set(bin);
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  constexpr auto numberOfTextureFeatures = static_cast<unsigned int>(TextureFeatureEnum::InvalidFeatureName);
+  using OutputValueType = typename NumericTraits<OutputPixelType>::ValueType;
+
+  OutputImageType *  output = this->GetOutput();
+  const RegionType   largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  const RadiusType   radius = this->GetRadius();
+  const unsigned int numberOfBins = m_NumberOfBinsPerAxis;
+  const unsigned int numberOfFeatures = m_RequestedFeatures->Size();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  CooccurrenceMatrix matrix;
+  matrix.Frequencies.resize(static_cast<size_t>(numberOfBins) * numberOfBins);
+  matrix.MarginalFrequencies.resize(numberOfBins);
+
+  std::vector<unsigned int> bins;
+  bins.reserve(numberOfBins);
+  double features[numberOfTextureFeatures];
+
+  OutputPixelType outputPixel;
+  NumericTraits<OutputPixelType>::SetLength(outputPixel, numberOfFeatures);
+
+  // The box centered on a pixel, cropped at the largest possible region
+  auto boxAt = [&radius, &largestRegion](const IndexType & center) {
+    RegionType box(center, RadiusType::Filled(1));
+    box.PadByRadius(radius);
+    box.Crop(largestRegion);
+    return box;
+  };
+
+  ImageLinearIteratorWithIndex<OutputImageType> outputIt(output, outputRegionForThread);
+  outputIt.SetDirection(0);
+  for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); outputIt.NextLine())
+  {
+    // Fill the matrix of the first box of the line from scratch
+    std::fill(matrix.Frequencies.begin(), matrix.Frequencies.end(), 0);
+    std::fill(matrix.MarginalFrequencies.begin(), matrix.MarginalFrequencies.end(), 0);
+    matrix.TotalFrequency = 0;
+
+    IndexType  index = outputIt.GetIndex();
+    RegionType window = boxAt(index);
+    this->UpdateCooccurrenceMatrix(window, window, 1, matrix);
+
+    while (true)
+    {
+      this->ComputeFeatures(matrix, bins, features);
+      for (unsigned int i = 0; i < numberOfFeatures; ++i)
+      {
+        outputPixel[i] = static_cast<OutputValueType>(features[m_RequestedFeatures->ElementAt(i)]);
+      }
+      outputIt.Set(outputPixel);
+
+      ++outputIt;
+      if (outputIt.IsAtEndOfLine())
+      {
+        break;
+      }
+
+      // Move the box by one pixel along the line
+      ++index[0];
+      const RegionType     nextWindow = boxAt(index);
+      const IndexValueType windowEnd = window.GetIndex(0) + static_cast<IndexValueType>(window.GetSize(0));
+      const IndexValueType nextWindowEnd = nextWindow.GetIndex(0) + static_cast<IndexValueType>(nextWindow.GetSize(0));
+      if (nextWindow.GetIndex(0) > window.GetIndex(0))
+      {
+        RegionType removedSlice = window;
+        removedSlice.SetSize(0, 1);
+        this->UpdateCooccurrenceMatrix(removedSlice, window, -1, matrix);
+      }
+      if (nextWindowEnd > windowEnd)
+      {
+        RegionType addedSlice = nextWindow;
+        addedSlice.SetIndex(0, nextWindowEnd - 1);
+        addedSlice.SetSize(0, 1);
+        this->UpdateCooccurrenceMatrix(addedSlice, nextWindow, 1, matrix);
+      }
+      window = nextWindow;
+    }
+    progress.Completed(outputRegionForThread.GetSize(0));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
+{
+  m_BinImage = nullptr;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::UpdateCooccurrenceMatrix(
+  const RegionType &   slice,
+  const RegionType &   window,
+  OffsetValueType      increment,
+  CooccurrenceMatrix & matrix) const
+{
+  const BinImageType *  binImage = m_BinImage;
+  const OffsetValueType numberOfBins = m_NumberOfBinsPerAxis;
+
+  // Both possible co-occurrence combinations are counted
+  auto addPair = [&matrix, numberOfBins, increment](OffsetValueType bin, OffsetValueType neighborBin) {
+    if (neighborBin < 0)
+    {
+      return;
+    }
+    matrix.Frequencies[bin * numberOfBins + neighborBin] += increment;
+    matrix.Frequencies[neighborBin * numberOfBins + bin] += increment;
+    matrix.MarginalFrequencies[bin] += increment;
+    matrix.MarginalFrequencies[neighborBin] += increment;
+    matrix.TotalFrequency += 2 * increment;
+  };
+
+  for (ImageRegionConstIteratorWithIndex<BinImageType> it(binImage, slice); !it.IsAtEnd(); ++it)
+  {
+    const int bin = it.Get();
+    if (bin < 0)
+    {
+      continue;
+    }
+    const IndexType & index = it.GetIndex();
+    for (const OffsetType & offset : m_Offsets->CastToSTLConstContainer())
+    {
+      // The pair is counted from its first pixel in the slice
+      const IndexType next = index + offset;
+      if (window.IsInside(next))
+      {
+        addPair(bin, binImage->GetPixel(next));
+      }
+      const IndexType previous = index - offset;
+      if (window.IsInside(previous) && !slice.IsInside(previous))
+      {
+        addPair(bin, binImage->GetPixel(previous));
+      }
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::ComputeFeatures(const CooccurrenceMatrix & matrix,
+                                                                                    std::vector<unsigned int> & bins,
+                                                                                    double * features) const
+{
+  constexpr auto numberOfTextureFeatures = static_cast<unsigned int>(TextureFeatureEnum::InvalidFeatureName);
+  std::fill(features, features + numberOfTextureFeatures, 0.0);
+  if (matrix.TotalFrequency == 0)
+  {
+    return;
+  }
+
+  const unsigned int numberOfBins = m_NumberOfBinsPerAxis;
+  const double       totalFrequency = static_cast<double>(matrix.TotalFrequency);
+
+  // Only the rows and columns of the occupied bins have nonzero frequencies
+  bins.clear();
+  double pixelMean = 0.0;
+  double marginalSumOfSquares = 0.0;
+  for (unsigned int i = 0; i < numberOfBins; ++i)
+  {
+    if (matrix.MarginalFrequencies[i] != 0)
+    {
+      bins.push_back(i);
+      const double marginalFrequency = matrix.MarginalFrequencies[i] / totalFrequency;
+      pixelMean += i * marginalFrequency;
+      marginalSumOfSquares += marginalFrequency * marginalFrequency;
+    }
+  }
+  double pixelVariance = 0.0;
+  for (const unsigned int i : bins)
+  {
+    pixelVariance += (i - pixelMean) * (i - pixelMean) * (matrix.MarginalFrequencies[i] / totalFrequency);
+  }
+
+  // The marginal sums add up to one over all the bins
+  const double marginalMean = 1.0 / numberOfBins;
+  const double marginalDevSquared = marginalSumOfSquares / numberOfBins - marginalMean * marginalMean;
+
+  // As in HistogramToTextureFeaturesFilter
+  double pixelVarianceSquared = pixelVariance * pixelVariance;
+  if (Math::FloatAlmostEqual(pixelVarianceSquared, 0.0, 4, 2 * NumericTraits<double>::epsilon()))
+  {
+    pixelVarianceSquared = 1.;
+  }
+  const double log2 = std::log(2.0);
+
+  double energy = 0.0;
+  double entropy = 0.0;
+  double correlation = 0.0;
+  double inverseDifferenceMoment = 0.0;
+  double inertia = 0.0;
+  double clusterShade = 0.0;
+  double clusterProminence = 0.0;
+  double haralickCorrelation = 0.0;
+  for (const unsigned int i : bins)
+  {
+    const OffsetValueType * row = &matrix.Frequencies[static_cast<size_t>(i) * numberOfBins];
+    const double            x = i;
+    for (const unsigned int j : bins)
+    {
+      if (row[j] == 0)
+      {
+        continue;
+      }
+      const double frequency = row[j] / totalFrequency;
+      const double y = j;
+      const double sum = (x - pixelMean) + (y - pixelMean);
+      energy += frequency * frequency;
+      entropy -= (frequency > 0.0001) ? frequency * std::log(frequency) / log2 : 0;
+      correlation += ((x - pixelMean) * (y - pixelMean) * frequency) / pixelVarianceSquared;
+      inverseDifferenceMoment += frequency / (1.0 + (x - y) * (x - y));
+      inertia += (x - y) * (x - y) * frequency;
+      clusterShade += sum * sum * sum * frequency;
+      clusterProminence += sum * sum * sum * sum * frequency;
+      haralickCorrelation += x * y * frequency;
+    }
+  }
+  if (marginalDevSquared > 0.0)
+  {
+    haralickCorrelation = (haralickCorrelation - marginalMean * marginalMean) / marginalDevSquared;
+  }
+  else
+  {
+    haralickCorrelation = 0.0;
+  }
+
+  features[static_cast<unsigned int>(TextureFeatureEnum::Energy)] = energy;
+  features[static_cast<unsigned int>(TextureFeatureEnum::Entropy)] = entropy;
+  features[static_cast<unsigned int>(TextureFeatureEnum::Correlation)] = correlation;
+  features[static_cast<unsigned int>(TextureFeatureEnum::InverseDifferenceMoment)] = inverseDifferenceMoment;
+  features[static_cast<unsigned int>(TextureFeatureEnum::Inertia)] = inertia;
+  features[static_cast<unsigned int>(TextureFeatureEnum::ClusterShade)] = clusterShade;
+  features[static_cast<unsigned int>(TextureFeatureEnum::ClusterProminence)] = clusterProminence;
+  features[static_cast<unsigned int>(TextureFeatureEnum::HaralickCorrelation)] = haralickCorrelation;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageToTextureFeaturesImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os,
+                                                                              Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Offsets: " << this->GetOffsets() << std::endl;
+  os << indent << "RequestedFeatures: " << this->GetRequestedFeatures() << std::endl;
+  os << indent << "NumberOfBinsPerAxis: " << m_NumberOfBinsPerAxis << std::endl;
+  os << indent << "Min: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_Min) << std::endl;
+  os << indent << "Max: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_Max) << std::endl;
+  os << indent << "InsidePixelValue: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_InsidePixelValue)
+     << std::endl;
+}
+} // end of namespace Statistics
+} // end of namespace itk
+
+#endif
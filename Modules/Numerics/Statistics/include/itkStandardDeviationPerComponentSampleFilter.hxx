@@ -19,6 +19,7 @@
 #define itkStandardDeviationPerComponentSampleFilter_hxx
 
 #include "itkStandardDeviationPerComponentSampleFilter.h"
+#include "itkSampleMomentsCalculator.h"
 #include "itkMeasurementVectorTraits.h"
 #include "itkMath.h"
 
@@ -127,56 +128,25 @@ StandardDeviationPerComponentSampleFilter<TSample>::GenerateData()
   auto * decoratedMean =
     itkDynamicCastInDebugMode<MeasurementVectorRealDecoratedType *>(this->ProcessObject::GetOutput(1));
 
-  MeasurementVectorRealType sum;
-  MeasurementVectorRealType sumOfSquares;
   MeasurementVectorRealType mean;
   MeasurementVectorRealType standardDeviation;
 
-  NumericTraits<MeasurementVectorRealType>::SetLength(sum, measurementVectorSize);
   NumericTraits<MeasurementVectorRealType>::SetLength(mean, measurementVectorSize);
-  NumericTraits<MeasurementVectorRealType>::SetLength(sumOfSquares, measurementVectorSize);
   NumericTraits<MeasurementVectorRealType>::SetLength(standardDeviation, measurementVectorSize);
 
-  sum.Fill(0.0);
-  mean.Fill(0.0);
-  sumOfSquares.Fill(0.0);
-  standardDeviation.Fill(0.0);
+  // compute the mean and the sums of squared deviations in a single pass
+  using MomentsCalculatorType = SampleMomentsCalculator<TSample>;
+  typename MomentsCalculatorType::Pointer momentsCalculator = MomentsCalculatorType::New();
+  momentsCalculator->SetSample(input);
+  momentsCalculator->ComputeVarianceOn();
+  momentsCalculator->Compute();
 
-  typename TSample::AbsoluteFrequencyType frequency;
-
-  using TotalAbsoluteFrequencyType = typename TSample::TotalAbsoluteFrequencyType;
-  TotalAbsoluteFrequencyType totalFrequency = itk::NumericTraits<TotalAbsoluteFrequencyType>::ZeroValue();
-
-  typename TSample::ConstIterator iter = input->Begin();
-  typename TSample::ConstIterator end = input->End();
-
-  MeasurementVectorType diff;
-  MeasurementVectorType measurements;
-
-  NumericTraits<MeasurementVectorType>::SetLength(diff, measurementVectorSize);
-  NumericTraits<MeasurementVectorType>::SetLength(measurements, measurementVectorSize);
-
-  // Compute the mean first
-  while (iter != end)
-  {
-    frequency = iter.GetFrequency();
-    totalFrequency += frequency;
-    measurements = iter.GetMeasurementVector();
-
-    for (unsigned int i = 0; i < measurementVectorSize; ++i)
-    {
-      double value = measurements[i];
-      sum[i] += frequency * value;
-      sumOfSquares[i] += frequency * value * value;
-    }
-    ++iter;
-  }
+  const double totalFrequency = momentsCalculator->GetTotalWeight();
 
   for (unsigned int i = 0; i < measurementVectorSize; ++i)
   {
-    const double meanValue = sum[i] / totalFrequency;
-    mean[i] = meanValue;
-    const double variance = (sumOfSquares[i] - meanValue * meanValue * totalFrequency) / (totalFrequency - 1.0);
+    mean[i] = momentsCalculator->GetMean()[i];
+    const double variance = momentsCalculator->GetSumOfSquaredDeviations()[i] / (totalFrequency - 1.0);
     standardDeviation[i] = std::sqrt(variance);
   }
 
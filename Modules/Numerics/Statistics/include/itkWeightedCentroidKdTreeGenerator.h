@@ -99,18 +99,16 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Nonterminal node generation routine */
+  /** Creates a KdTreeWeightedCentroidNonterminalNode, whose weighted
+   * centroid is the sum of the measurement vectors of the range. */
   KdTreeNodeType *
-  GenerateNonterminalNode(unsigned int            beginIndex,
-                          unsigned int            endIndex,
-                          MeasurementVectorType & lowerBound,
-                          MeasurementVectorType & upperBound,
-                          unsigned int            level) override;
-
-private:
-  MeasurementVectorType m_TempLowerBound;
-  MeasurementVectorType m_TempUpperBound;
-  MeasurementVectorType m_TempMean;
+  CreateNonterminalNode(unsigned int     beginIndex,
+                        unsigned int     endIndex,
+                        unsigned int     medianIndex,
+                        unsigned int     partitionDimension,
+                        MeasurementType  partitionValue,
+                        KdTreeNodeType * left,
+                        KdTreeNodeType * right) override;
 }; // end of class
 } // end of namespace Statistics
 } // end of namespace itk
@@ -20,8 +20,7 @@
 
 #include "itkWeightedMeanSampleFilter.h"
 
-#include <vector>
-#include "itkCompensatedSummation.h"
+#include "itkSampleMomentsCalculator.h"
 #include "itkMeasurementVectorTraits.h"
 
 namespace itk
@@ -88,40 +87,20 @@ WeightedMeanSampleFilter<TSample>::ComputeMeanWithWeights()
   NumericTraits<MeasurementVectorRealType>::SetLength(output, this->GetMeasurementVectorSize());
 
   // algorithm start
-  using MeasurementRealAccumulateType = CompensatedSummation<MeasurementRealType>;
-  std::vector<MeasurementRealAccumulateType> sum(measurementVectorSize);
+  using MomentsCalculatorType = SampleMomentsCalculator<SampleType>;
+  typename MomentsCalculatorType::Pointer momentsCalculator = MomentsCalculatorType::New();
+  momentsCalculator->SetSample(input);
+  momentsCalculator->SetWeights(&(this->GetWeights()));
+  momentsCalculator->Compute();
 
-  const WeightArrayType & weightsArray = this->GetWeights();
-
-  WeightValueType totalWeight = NumericTraits<WeightValueType>::ZeroValue();
-
-  typename SampleType::ConstIterator iter = input->Begin();
-  typename SampleType::ConstIterator end = input->End();
-
-  for (unsigned int sampleVectorIndex = 0; iter != end; ++iter, ++sampleVectorIndex)
-  {
-    const MeasurementVectorType & measurement = iter.GetMeasurementVector();
-
-    const typename SampleType::AbsoluteFrequencyType frequency = iter.GetFrequency();
-
-    const WeightValueType rawWeight = weightsArray[sampleVectorIndex];
-
-    const WeightValueType weight = (rawWeight * static_cast<WeightValueType>(frequency));
-    totalWeight += weight;
-
-    for (unsigned int dim = 0; dim < measurementVectorSize; dim++)
-    {
-      const auto component = static_cast<MeasurementRealType>(measurement[dim]);
-
-      sum[dim] += (component * weight);
-    }
-  }
+  const WeightValueType totalWeight = momentsCalculator->GetTotalWeight();
 
   if (totalWeight > itk::Math::eps)
   {
+    const typename MomentsCalculatorType::MeanType & mean = momentsCalculator->GetMean();
     for (unsigned int dim = 0; dim < measurementVectorSize; dim++)
     {
-      output[dim] = (sum[dim].GetSum() / static_cast<MeasurementRealType>(totalWeight));
+      output[dim] = mean[dim];
     }
   }
   else
@@ -149,40 +128,20 @@ WeightedMeanSampleFilter<TSample>::ComputeMeanWithWeightingFunction()
   NumericTraits<MeasurementVectorRealType>::SetLength(output, this->GetMeasurementVectorSize());
 
   // algorithm start
-  using MeasurementRealAccumulateType = CompensatedSummation<MeasurementRealType>;
-  std::vector<MeasurementRealAccumulateType> sum(measurementVectorSize);
+  using MomentsCalculatorType = SampleMomentsCalculator<SampleType>;
+  typename MomentsCalculatorType::Pointer momentsCalculator = MomentsCalculatorType::New();
+  momentsCalculator->SetSample(input);
+  momentsCalculator->SetWeightingFunction(this->GetWeightingFunction());
+  momentsCalculator->Compute();
 
-  const WeightingFunctionType * const weightFunction = this->GetWeightingFunction();
-
-  WeightValueType totalWeight = NumericTraits<WeightValueType>::ZeroValue();
-
-  typename SampleType::ConstIterator       iter = input->Begin();
-  const typename SampleType::ConstIterator end = input->End();
-
-  for (; iter != end; ++iter)
-  {
-    const MeasurementVectorType & measurement = iter.GetMeasurementVector();
-
-    const typename SampleType::AbsoluteFrequencyType frequency = iter.GetFrequency();
-
-    const WeightValueType rawWeight = weightFunction->Evaluate(measurement);
-
-    const WeightValueType weight = (rawWeight * static_cast<WeightValueType>(frequency));
-    totalWeight += weight;
-
-    for (unsigned int dim = 0; dim < measurementVectorSize; dim++)
-    {
-      const auto component = static_cast<MeasurementRealType>(measurement[dim]);
-
-      sum[dim] += (component * weight);
-    }
-  }
+  const WeightValueType totalWeight = momentsCalculator->GetTotalWeight();
 
   if (totalWeight > itk::Math::eps)
   {
+    const typename MomentsCalculatorType::MeanType & mean = momentsCalculator->GetMean();
     for (unsigned int dim = 0; dim < measurementVectorSize; dim++)
     {
-      output[dim] = (sum[dim].GetSum() / static_cast<MeasurementRealType>(totalWeight));
+      output[dim] = mean[dim];
     }
   }
   else
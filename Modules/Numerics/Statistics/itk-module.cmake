@@ -10,6 +10,8 @@ itk_module(ITKStatistics
   DEPENDS
     ITKCommon
     ITKNetlib
+  COMPILE_DEPENDS
+    ITKImageFilterBase
   TEST_DEPENDS
     ITKTestKernel
     ITKImageIntensity
@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkListSample.h"
+#include "itkGaussianMixtureModelComponent.h"
+#include "itkExpectationMaximizationMixtureModelEstimator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+#include "itkMath.h"
+
+/*
+ * Estimate a mixture of three gaussians from a sample larger than the blocks
+ * processed in parallel, and compare the parameters of the components with
+ * the weighted means and covariances of the sample computed by brute force.
+ */
+
+int
+itkExpectationMaximizationMixtureModelEstimatorTest2(int, char *[])
+{
+  namespace stat = itk::Statistics;
+
+  constexpr unsigned int Dimension = 2;
+  constexpr unsigned int numberOfClasses = 3;
+  constexpr unsigned int numberOfSamplesPerClass = 5000;
+
+  using MeasurementVectorType = itk::Vector<double, Dimension>;
+  using SampleType = stat::ListSample<MeasurementVectorType>;
+  SampleType::Pointer sample = SampleType::New();
+  sample->SetMeasurementVectorSize(Dimension);
+
+  using NumberGeneratorType = stat::MersenneTwisterRandomVariateGenerator;
+  NumberGeneratorType::Pointer randomNumberGenerator = NumberGeneratorType::GetInstance();
+  randomNumberGenerator->Initialize(1234);
+
+  const double trueMeans[numberOfClasses][Dimension] = { { 100.0, 100.0 }, { 200.0, 120.0 }, { 150.0, 200.0 } };
+
+  MeasurementVectorType mv;
+  for (unsigned int i = 0; i < numberOfSamplesPerClass; ++i)
+  {
+    for (const auto & trueMean : trueMeans)
+    {
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        mv[d] = randomNumberGenerator->GetNormalVariate(trueMean[d], 400.0);
+      }
+      sample->PushBack(mv);
+    }
+  }
+
+  using ComponentType = stat::GaussianMixtureModelComponent<SampleType>;
+  using EstimatorType = stat::ExpectationMaximizationMixtureModelEstimator<SampleType>;
+
+  EstimatorType::Pointer estimator = EstimatorType::New();
+  estimator->SetSample(sample);
+  estimator->SetMaximumIteration(100);
+
+  itk::Array<double> initialProportions(numberOfClasses);
+  initialProportions.Fill(1.0 / numberOfClasses);
+  estimator->SetInitialProportions(initialProportions);
+
+  std::vector<ComponentType::Pointer>         components;
+  std::vector<ComponentType::ParametersType> initialParameters;
+  for (unsigned int c = 0; c < numberOfClasses; ++c)
+  {
+    ComponentType::ParametersType parameters(Dimension + Dimension * Dimension);
+    parameters.Fill(0.0);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      parameters[d] = trueMeans[c][d] + 15.0;
+      parameters[Dimension + d * Dimension + d] = 900.0;
+    }
+    initialParameters.push_back(parameters);
+    components.push_back(ComponentType::New());
+    components[c]->SetSample(sample);
+    components[c]->SetParameters(parameters);
+    estimator->AddComponent(components[c]);
+  }
+
+  ITK_TEST_EXPECT_EQUAL(estimator->GetNumberOfWorkUnits(), itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  estimator->Update();
+
+  std::cout << "Iterations: " << estimator->GetCurrentIteration() << std::endl;
+
+  for (unsigned int c = 0; c < numberOfClasses; ++c)
+  {
+    const ComponentType::ParametersType & parameters = components[c]->GetFullParameters();
+    std::cout << "Component " << c << ": " << parameters << " proportion: " << estimator->GetProportions()[c]
+              << std::endl;
+
+    // The parameters are estimated with the weights of the last expectation.
+    double sumOfWeights = 0.0;
+    double sumOfSquaredWeights = 0.0;
+    double mean[Dimension] = { 0.0, 0.0 };
+    for (unsigned int i = 0; i < sample->Size(); ++i)
+    {
+      const double weight = components[c]->GetWeight(i);
+      sumOfWeights += weight;
+      sumOfSquaredWeights += weight * weight;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        mean[d] += weight * sample->GetMeasurementVector(i)[d];
+      }
+    }
+    double covariance[Dimension][Dimension] = { { 0.0, 0.0 }, { 0.0, 0.0 } };
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      mean[d] /= sumOfWeights;
+    }
+    for (unsigned int i = 0; i < sample->Size(); ++i)
+    {
+      const double                  weight = components[c]->GetWeight(i);
+      const MeasurementVectorType & measurements = sample->GetMeasurementVector(i);
+      for (unsigned int r = 0; r < Dimension; ++r)
+      {
+        for (unsigned int s = 0; s < Dimension; ++s)
+        {
+          covariance[r][s] += weight * (measurements[r] - mean[r]) * (measurements[s] - mean[s]);
+        }
+      }
+    }
+
+    for (unsigned int r = 0; r < Dimension; ++r)
+    {
+      ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(parameters[r], mean[r], 4, 1e-6));
+      ITK_TEST_EXPECT_TRUE(std::abs(parameters[r] - trueMeans[c][r]) < 2.0);
+      for (unsigned int s = 0; s < Dimension; ++s)
+      {
+        const double expected = covariance[r][s] / (sumOfWeights - sumOfSquaredWeights / sumOfWeights);
+        ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(parameters[Dimension + r * Dimension + s], expected, 4, 1e-6));
+      }
+    }
+    ITK_TEST_EXPECT_TRUE(std::abs(estimator->GetProportions()[c] - 1.0 / numberOfClasses) < 0.02);
+  }
+
+  // With one work unit, the membership functions are evaluated serially, and
+  // the estimation is the same.
+  std::vector<ComponentType::ParametersType> parameters;
+  for (unsigned int c = 0; c < numberOfClasses; ++c)
+  {
+    parameters.push_back(components[c]->GetFullParameters());
+    components[c]->SetParameters(initialParameters[c]);
+  }
+  const EstimatorType::ProportionVectorType proportions = estimator->GetProportions();
+
+  estimator->SetNumberOfWorkUnits(1);
+  ITK_TEST_EXPECT_EQUAL(estimator->GetNumberOfWorkUnits(), 1);
+  estimator->Update();
+
+  for (unsigned int c = 0; c < numberOfClasses; ++c)
+  {
+    ITK_TEST_EXPECT_TRUE(components[c]->GetFullParameters() == parameters[c]);
+  }
+  ITK_TEST_EXPECT_TRUE(estimator->GetProportions() == proportions);
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageToHistogramFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+#include <cmath>
+
+// The purpose of this test is to verify that the histograms computed with
+// the constant time bin search and the lookup tables of the pixel values
+// are the same as the ones computed with the binary search of the bins.
+
+namespace
+{
+/* Returns a histogram with the bins of the given histogram, set one by one
+ * so that its indices are computed with the binary search */
+template <typename THistogram>
+typename THistogram::Pointer
+CopyBins(const THistogram * histogram)
+{
+  typename THistogram::Pointer copy = THistogram::New();
+  copy->SetMeasurementVectorSize(histogram->GetMeasurementVectorSize());
+  copy->SetClipBinsAtEnds(histogram->GetClipBinsAtEnds());
+  copy->Initialize(histogram->GetSize());
+  for (unsigned int i = 0; i < histogram->GetMeasurementVectorSize(); i++)
+  {
+    for (unsigned int j = 0; j < histogram->GetSize(i); j++)
+    {
+      copy->SetBinMin(i, j, histogram->GetBinMin(i, j));
+      copy->SetBinMax(i, j, histogram->GetBinMax(i, j));
+    }
+  }
+  return copy;
+}
+
+/* Computes the histogram of the image with the binary search of the bins,
+ * and compares it with the output of the filter */
+template <typename TFilter>
+int
+CheckHistogram(TFilter * filter)
+{
+  using ImageType = typename TFilter::ImageType;
+  using HistogramType = typename TFilter::HistogramType;
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const HistogramType *                            histogram = filter->GetOutput();
+  typename HistogramType::Pointer                  expected = CopyBins(histogram);
+  typename HistogramType::IndexType                index;
+  typename TFilter::HistogramMeasurementVectorType m(histogram->GetMeasurementVectorSize());
+
+  for (itk::ImageRegionConstIterator<ImageType> it(filter->GetInput(), filter->GetInput()->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    itk::NumericTraits<typename ImageType::PixelType>::AssignToArray(it.Get(), m);
+    if (expected->GetIndex(m, index))
+    {
+      expected->IncreaseFrequencyOfIndex(index, 1);
+    }
+  }
+
+  if (histogram->GetTotalFrequency() != expected->GetTotalFrequency())
+  {
+    std::cerr << "Total frequency is " << histogram->GetTotalFrequency() << " instead of "
+              << expected->GetTotalFrequency() << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int id = 0; id < histogram->Size(); id++)
+  {
+    if (histogram->GetFrequency(id) != expected->GetFrequency(id))
+    {
+      std::cerr << "Frequency of bin " << id << " is " << histogram->GetFrequency(id) << " instead of "
+                << expected->GetFrequency(id) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkImageToHistogramFilterTest4(int, char *[])
+{
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize(2021);
+
+  // The index of a measurement is the same with the constant time search and
+  // with the binary search, including at the bounds of the bins and outside
+  // of the histogram
+  using HistogramType = itk::Statistics::Histogram<float>;
+  HistogramType::Pointer histogram = HistogramType::New();
+  histogram->SetMeasurementVectorSize(2);
+  HistogramType::SizeType size(2);
+  size[0] = 7;
+  size[1] = 100;
+  HistogramType::MeasurementVectorType lowerBound(2);
+  HistogramType::MeasurementVectorType upperBound(2);
+  lowerBound[0] = -3.1f;
+  upperBound[0] = 11.3f;
+  lowerBound[1] = 0.0f;
+  upperBound[1] = 1.0f;
+  histogram->Initialize(size, lowerBound, upperBound);
+
+  for (bool clipBinsAtEnds : { true, false })
+  {
+    histogram->SetClipBinsAtEnds(clipBinsAtEnds);
+    HistogramType::Pointer expected = CopyBins(histogram.GetPointer());
+    for (unsigned int i = 0; i < 2; i++)
+    {
+      std::vector<float> measurements;
+      for (unsigned int j = 0; j < size[i]; j++)
+      {
+        measurements.push_back(histogram->GetBinMin(i, j));
+        measurements.push_back(histogram->GetBinMax(i, j));
+        measurements.push_back(std::nextafter(histogram->GetBinMin(i, j), -1000.0f));
+        measurements.push_back(std::nextafter(histogram->GetBinMax(i, j), -1000.0f));
+      }
+      for (unsigned int j = 0; j < 1000; j++)
+      {
+        measurements.push_back(static_cast<float>(generator->GetUniformVariate(-20.0, 20.0)));
+      }
+      for (float measurement : measurements)
+      {
+        HistogramType::IndexValueType index = -1;
+        HistogramType::IndexValueType expectedIndex = -1;
+        const bool                    valid = histogram->GetIndex(i, measurement, index);
+        const bool                    expectedValid = expected->GetIndex(i, measurement, expectedIndex);
+        if (valid != expectedValid || index != expectedIndex)
+        {
+          std::cerr << "Index of " << measurement << " along dimension " << i << " is " << index << " (" << valid
+                    << ") instead of " << expectedIndex << " (" << expectedValid << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // A 2D image of 16 bits integers, binned with a lookup table
+  using ShortImageType = itk::Image<short, 2>;
+  using ShortFilterType = itk::Statistics::ImageToHistogramFilter<ShortImageType>;
+
+  ShortImageType::Pointer shortImage = ShortImageType::New();
+  shortImage->SetRegions(ShortImageType::SizeType{ { 300, 250 } });
+  shortImage->Allocate();
+  for (itk::ImageRegionIterator<ShortImageType> it(shortImage, shortImage->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(generator->GetIntegerVariate(3000)) - 1500);
+  }
+
+  ShortFilterType::Pointer shortFilter = ShortFilterType::New();
+  shortFilter->SetInput(shortImage);
+  ShortFilterType::HistogramSizeType shortSize(1);
+  shortSize[0] = 77;
+  shortFilter->SetHistogramSize(shortSize);
+  if (CheckHistogram(shortFilter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // With bins which don't cover all the values, and streaming
+  shortFilter->SetAutoMinimumMaximum(false);
+  ShortFilterType::HistogramMeasurementVectorType binMinimum(1);
+  ShortFilterType::HistogramMeasurementVectorType binMaximum(1);
+  binMinimum[0] = -1000.5;
+  binMaximum[0] = 999.5;
+  shortFilter->SetHistogramBinMinimum(binMinimum);
+  shortFilter->SetHistogramBinMaximum(binMaximum);
+  shortFilter->SetNumberOfStreamDivisions(3);
+  if (CheckHistogram(shortFilter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A 2D image of pairs of 8 bits integers, for a 2D histogram
+  using VectorImageType = itk::Image<itk::Vector<unsigned char, 2>, 2>;
+  using VectorFilterType = itk::Statistics::ImageToHistogramFilter<VectorImageType>;
+
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(VectorImageType::SizeType{ { 97, 31 } });
+  vectorImage->Allocate();
+  for (itk::ImageRegionIterator<VectorImageType> it(vectorImage, vectorImage->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    VectorImageType::PixelType p;
+    p[0] = static_cast<unsigned char>(generator->GetIntegerVariate(255));
+    p[1] = static_cast<unsigned char>(generator->GetIntegerVariate(100));
+    it.Set(p);
+  }
+
+  VectorFilterType::Pointer vectorFilter = VectorFilterType::New();
+  vectorFilter->SetInput(vectorImage);
+  VectorFilterType::HistogramSizeType vectorSize(2);
+  vectorSize[0] = 16;
+  vectorSize[1] = 9;
+  vectorFilter->SetHistogramSize(vectorSize);
+  VectorFilterType::HistogramMeasurementVectorType vectorMinimum(2);
+  VectorFilterType::HistogramMeasurementVectorType vectorMaximum(2);
+  vectorMinimum[0] = 10;
+  vectorMaximum[0] = 250;
+  vectorMinimum[1] = 0;
+  vectorMaximum[1] = 90;
+  vectorFilter->SetHistogramBinMinimum(vectorMinimum);
+  vectorFilter->SetHistogramBinMaximum(vectorMaximum);
+  if (CheckHistogram(vectorFilter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  vectorFilter->SetNumberOfWorkUnits(1);
+  if (CheckHistogram(vectorFilter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A floating point image, binned with the histogram
+  using FloatImageType = itk::Image<float, 3>;
+  using FloatFilterType = itk::Statistics::ImageToHistogramFilter<FloatImageType>;
+
+  FloatImageType::Pointer floatImage = FloatImageType::New();
+  floatImage->SetRegions(FloatImageType::SizeType{ { 20, 30, 40 } });
+  floatImage->Allocate();
+  for (itk::ImageRegionIterator<FloatImageType> it(floatImage, floatImage->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(generator->GetNormalVariate(0.0, 4.0)));
+  }
+
+  FloatFilterType::Pointer floatFilter = FloatFilterType::New();
+  floatFilter->SetInput(floatImage);
+  FloatFilterType::HistogramSizeType floatSize(1);
+  floatSize[0] = 50;
+  floatFilter->SetHistogramSize(floatSize);
+  if (CheckHistogram(floatFilter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkListSample.h"
+#include "itkWeightedCentroidKdTreeGenerator.h"
+#include "itkKdTreeBasedKmeansEstimator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+#include "itkMath.h"
+
+/*
+ * Compare the means estimated with the subtrees of the k-d tree filtered in
+ * parallel, with the true means and the means of brute force Lloyd iterations
+ * started from the same initial means.
+ */
+
+int
+itkKdTreeBasedKmeansEstimatorTest2(int, char *[])
+{
+  namespace stat = itk::Statistics;
+
+  constexpr unsigned int Dimension = 2;
+  constexpr unsigned int numberOfClasses = 3;
+  constexpr unsigned int numberOfSamplesPerClass = 10000;
+
+  using MeasurementVectorType = itk::Vector<double, Dimension>;
+  using SampleType = stat::ListSample<MeasurementVectorType>;
+  SampleType::Pointer sample = SampleType::New();
+  sample->SetMeasurementVectorSize(Dimension);
+
+  using NumberGeneratorType = stat::MersenneTwisterRandomVariateGenerator;
+  NumberGeneratorType::Pointer randomNumberGenerator = NumberGeneratorType::GetInstance();
+  randomNumberGenerator->Initialize(1234);
+
+  const double trueMeans[numberOfClasses][Dimension] = { { 100.0, 100.0 }, { 200.0, 120.0 }, { 150.0, 200.0 } };
+
+  MeasurementVectorType mv;
+  for (unsigned int i = 0; i < numberOfSamplesPerClass; ++i)
+  {
+    for (const auto & trueMean : trueMeans)
+    {
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        mv[d] = randomNumberGenerator->GetNormalVariate(trueMean[d], 900.0);
+      }
+      sample->PushBack(mv);
+    }
+  }
+
+  itk::Array<double> initialMeans(numberOfClasses * Dimension);
+  initialMeans[0] = 80.0;
+  initialMeans[1] = 80.0;
+  initialMeans[2] = 180.0;
+  initialMeans[3] = 180.0;
+  initialMeans[4] = 140.0;
+  initialMeans[5] = 240.0;
+
+  using GeneratorType = stat::WeightedCentroidKdTreeGenerator<SampleType>;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSample(sample);
+  generator->SetBucketSize(16);
+  generator->Update();
+
+  using EstimatorType = stat::KdTreeBasedKmeansEstimator<GeneratorType::KdTreeType>;
+  EstimatorType::Pointer estimator = EstimatorType::New();
+  estimator->SetParameters(initialMeans);
+  estimator->SetMaximumIteration(200);
+  estimator->SetCentroidPositionChangesThreshold(0.0);
+  estimator->SetUseClusterLabels(true);
+  estimator->SetKdTree(generator->GetOutput());
+  estimator->StartOptimization();
+  EstimatorType::ParametersType estimatedMeans = estimator->GetParameters();
+
+  // Brute force Lloyd iterations
+  itk::Array<double> expectedMeans = initialMeans;
+  for (unsigned int iteration = 0; iteration < 200; ++iteration)
+  {
+    itk::Array<double>  sums(numberOfClasses * Dimension);
+    std::vector<double>  sizes(numberOfClasses, 0.0);
+    sums.Fill(0.0);
+    for (unsigned int i = 0; i < sample->Size(); ++i)
+    {
+      const MeasurementVectorType & measurements = sample->GetMeasurementVector(i);
+      unsigned int                  closest = 0;
+      double                        closestDistance = itk::NumericTraits<double>::max();
+      for (unsigned int c = 0; c < numberOfClasses; ++c)
+      {
+        double distance = 0.0;
+        for (unsigned int d = 0; d < Dimension; ++d)
+        {
+          distance += itk::Math::sqr(measurements[d] - expectedMeans[c * Dimension + d]);
+        }
+        if (distance < closestDistance)
+        {
+          closest = c;
+          closestDistance = distance;
+        }
+      }
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        sums[closest * Dimension + d] += measurements[d];
+      }
+      sizes[closest] += 1.0;
+    }
+
+    double changes = 0.0;
+    for (unsigned int c = 0; c < numberOfClasses; ++c)
+    {
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        const double mean = sums[c * Dimension + d] / sizes[c];
+        changes += std::abs(mean - expectedMeans[c * Dimension + d]);
+        expectedMeans[c * Dimension + d] = mean;
+      }
+    }
+    if (changes == 0.0)
+    {
+      break;
+    }
+  }
+
+  std::cout << "Estimated means: " << estimatedMeans << std::endl;
+  std::cout << "Expected means: " << expectedMeans << std::endl;
+
+  ITK_TEST_EXPECT_EQUAL(estimatedMeans.size(), numberOfClasses * Dimension);
+  for (unsigned int i = 0; i < numberOfClasses * Dimension; ++i)
+  {
+    ITK_TEST_EXPECT_TRUE(std::abs(estimatedMeans[i] - expectedMeans[i]) < 0.5);
+    ITK_TEST_EXPECT_TRUE(std::abs(estimatedMeans[i] - trueMeans[i / Dimension][i % Dimension]) < 2.0);
+  }
+
+  // The estimation is deterministic.
+  estimator->SetParameters(initialMeans);
+  estimator->StartOptimization();
+  ITK_TEST_EXPECT_EQUAL(estimator->GetParameters(), estimatedMeans);
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkListSample.h"
+#include "itkKdTreeGenerator.h"
+#include "itkWeightedCentroidKdTreeGenerator.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Returns true when the two trees have the same nodes.
+template <typename TNode>
+bool
+SameNodes(const TNode * node1, const TNode * node2)
+{
+  if (node1->IsTerminal() != node2->IsTerminal() || node1->Size() != node2->Size())
+  {
+    return false;
+  }
+  if (node1->IsTerminal())
+  {
+    for (unsigned int i = 0; i < node1->Size(); ++i)
+    {
+      if (node1->GetInstanceIdentifier(i) != node2->GetInstanceIdentifier(i))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  unsigned int                    partitionDimension1;
+  unsigned int                    partitionDimension2;
+  typename TNode::MeasurementType partitionValue1;
+  typename TNode::MeasurementType partitionValue2;
+  typename TNode::CentroidType    centroid1;
+  typename TNode::CentroidType    centroid2;
+  node1->GetParameters(partitionDimension1, partitionValue1);
+  node2->GetParameters(partitionDimension2, partitionValue2);
+  const_cast<TNode *>(node1)->GetWeightedCentroid(centroid1);
+  const_cast<TNode *>(node2)->GetWeightedCentroid(centroid2);
+  return partitionDimension1 == partitionDimension2 && partitionValue1 == partitionValue2 &&
+         centroid1 == centroid2 && node1->GetInstanceIdentifier(0) == node2->GetInstanceIdentifier(0) &&
+         SameNodes(node1->Left(), node2->Left()) && SameNodes(node1->Right(), node2->Right());
+}
+} // namespace
+
+int
+itkKdTreeBatchSearchTest(int argc, char * argv[])
+{
+  if (argc < 5)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << std::endl;
+    std::cerr << itkNameOfTestExecutableMacro(argv) << " numberOfDataPoints numberOfQueries "
+              << "numberOfNeighbors bucketSize" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const unsigned int numberOfDataPoints = std::stoi(argv[1]);
+  const unsigned int numberOfQueries = std::stoi(argv[2]);
+  const unsigned int numberOfNeighbors = std::stoi(argv[3]);
+  const unsigned int bucketSize = std::stoi(argv[4]);
+
+  using NumberGeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  NumberGeneratorType::Pointer randomNumberGenerator = NumberGeneratorType::GetInstance();
+  randomNumberGenerator->Initialize(1234);
+
+  using MeasurementVectorType = itk::Vector<float, 3>;
+  using SampleType = itk::Statistics::ListSample<MeasurementVectorType>;
+
+  SampleType::Pointer sample = SampleType::New();
+  sample->SetMeasurementVectorSize(3);
+  sample->Resize(numberOfDataPoints);
+  for (unsigned int i = 0; i < numberOfDataPoints; ++i)
+  {
+    MeasurementVectorType mv;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      mv[d] = randomNumberGenerator->GetUniformVariate(0.0, 100.0);
+    }
+    sample->SetMeasurementVector(i, mv);
+  }
+
+  std::vector<MeasurementVectorType> queries(numberOfQueries);
+  for (auto & query : queries)
+  {
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      query[d] = randomNumberGenerator->GetUniformVariate(0.0, 100.0);
+    }
+  }
+
+  //
+  // Generate the tree serially and in parallel
+  //
+  using TreeGeneratorType = itk::Statistics::KdTreeGenerator<SampleType>;
+  using TreeType = TreeGeneratorType::KdTreeType;
+
+  TreeGeneratorType::Pointer serialGenerator = TreeGeneratorType::New();
+
+  ITK_TEST_SET_GET_BOOLEAN(serialGenerator, ParallelBuild, false);
+
+  serialGenerator->SetSample(sample);
+  serialGenerator->SetBucketSize(bucketSize);
+
+  itk::TimeProbe serialBuildProbe;
+  serialBuildProbe.Start();
+  serialGenerator->Update();
+  serialBuildProbe.Stop();
+
+  TreeGeneratorType::Pointer parallelGenerator = TreeGeneratorType::New();
+  parallelGenerator->SetSample(sample);
+  parallelGenerator->SetBucketSize(bucketSize);
+  parallelGenerator->ParallelBuildOn();
+
+  itk::TimeProbe parallelBuildProbe;
+  parallelBuildProbe.Start();
+  parallelGenerator->Update();
+  parallelBuildProbe.Stop();
+
+  std::cout << "Serial build: " << serialBuildProbe.GetTotal() << " s" << std::endl;
+  std::cout << "Parallel build: " << parallelBuildProbe.GetTotal() << " s" << std::endl;
+
+  TreeType::Pointer serialTree = serialGenerator->GetOutput();
+  TreeType::Pointer tree = parallelGenerator->GetOutput();
+
+  ITK_TEST_EXPECT_TRUE(SameNodes(serialTree->GetRoot(), tree->GetRoot()));
+
+  using WeightedCentroidGeneratorType = itk::Statistics::WeightedCentroidKdTreeGenerator<SampleType>;
+  WeightedCentroidGeneratorType::Pointer serialWeightedGenerator = WeightedCentroidGeneratorType::New();
+  serialWeightedGenerator->SetSample(sample);
+  serialWeightedGenerator->SetBucketSize(bucketSize);
+  serialWeightedGenerator->Update();
+
+  WeightedCentroidGeneratorType::Pointer parallelWeightedGenerator = WeightedCentroidGeneratorType::New();
+  parallelWeightedGenerator->SetSample(sample);
+  parallelWeightedGenerator->SetBucketSize(bucketSize);
+  parallelWeightedGenerator->ParallelBuildOn();
+  parallelWeightedGenerator->Update();
+
+  ITK_TEST_EXPECT_TRUE(
+    SameNodes(serialWeightedGenerator->GetOutput()->GetRoot(), parallelWeightedGenerator->GetOutput()->GetRoot()));
+
+  //
+  // Search the k-nearest neighbors one query at a time and in a batch
+  //
+  std::vector<TreeType::InstanceIdentifierVectorType> neighbors(numberOfQueries);
+  std::vector<std::vector<double>>                    distances(numberOfQueries);
+
+  itk::TimeProbe searchProbe;
+  searchProbe.Start();
+  for (unsigned int q = 0; q < numberOfQueries; ++q)
+  {
+    tree->Search(queries[q], numberOfNeighbors, neighbors[q], distances[q]);
+  }
+  searchProbe.Stop();
+
+  std::vector<TreeType::InstanceIdentifierVectorType> batchNeighbors;
+  std::vector<std::vector<double>>                    batchDistances;
+
+  itk::TimeProbe batchSearchProbe;
+  batchSearchProbe.Start();
+  tree->Search(queries, numberOfNeighbors, batchNeighbors, batchDistances);
+  batchSearchProbe.Stop();
+
+  std::cout << "k-NN search, one query at a time: " << searchProbe.GetTotal() << " s" << std::endl;
+  std::cout << "k-NN search, batch: " << batchSearchProbe.GetTotal() << " s" << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(batchNeighbors == neighbors);
+  ITK_TEST_EXPECT_TRUE(batchDistances == distances);
+
+  std::vector<TreeType::InstanceIdentifierVectorType> batchNeighborsWithoutDistances;
+  tree->Search(queries, numberOfNeighbors, batchNeighborsWithoutDistances);
+  ITK_TEST_EXPECT_TRUE(batchNeighborsWithoutDistances == neighbors);
+
+  //
+  // Search the neighbors within a radius one query at a time and in a batch
+  //
+  const double radius = 2.0;
+  for (unsigned int q = 0; q < numberOfQueries; ++q)
+  {
+    tree->Search(queries[q], radius, neighbors[q]);
+  }
+  tree->Search(queries, radius, batchNeighbors);
+  ITK_TEST_EXPECT_TRUE(batchNeighbors == neighbors);
+
+  //
+  // The measurement vectors are searched in a batch too
+  //
+  std::vector<MeasurementVectorType> samplePoints(sample->Size());
+  for (unsigned int i = 0; i < sample->Size(); ++i)
+  {
+    samplePoints[i] = sample->GetMeasurementVector(i);
+  }
+  tree->Search(samplePoints, 1u, batchNeighbors, batchDistances);
+  for (unsigned int i = 0; i < sample->Size(); ++i)
+  {
+    if (batchDistances[i][0] != 0.0)
+    {
+      std::cerr << "The nearest neighbor of the point " << i << " is at distance " << batchDistances[i][0]
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //
+  // The batch searches follow a new root of the tree
+  //
+  for (unsigned int i = 0; i < sample->Size(); ++i)
+  {
+    MeasurementVectorType mv = sample->GetMeasurementVector(i);
+    mv[0] = 100.0 - mv[0];
+    sample->SetMeasurementVector(i, mv);
+  }
+  parallelGenerator->Modified();
+  parallelGenerator->Update();
+  ITK_TEST_EXPECT_TRUE(parallelGenerator->GetOutput() == tree);
+
+  for (unsigned int q = 0; q < numberOfQueries; ++q)
+  {
+    tree->Search(queries[q], numberOfNeighbors, neighbors[q], distances[q]);
+  }
+  tree->Search(queries, numberOfNeighbors, batchNeighbors, batchDistances);
+  ITK_TEST_EXPECT_TRUE(batchNeighbors == neighbors);
+  ITK_TEST_EXPECT_TRUE(batchDistances == distances);
+
+  ITK_TRY_EXPECT_EXCEPTION(tree->Search(queries, numberOfDataPoints + 1, batchNeighbors));
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,281 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSampleMomentsCalculator.h"
+#include "itkGaussianMembershipFunction.h"
+#include "itkHistogram.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+bool
+AlmostEqual(double value, double expected)
+{
+  return std::abs(value - expected) <= 1e-8 * (1.0 + std::abs(expected));
+}
+
+/* Compares the moments computed by the calculator with the moments computed
+ * in two passes over the sample. */
+template <typename TSample>
+int
+CheckMoments(const TSample *                                                            sample,
+             const itk::Array<double> *                                                 weights,
+             const itk::FunctionBase<typename TSample::MeasurementVectorType, double> * function,
+             const char *                                                               name)
+{
+  using CalculatorType = itk::Statistics::SampleMomentsCalculator<TSample>;
+  typename CalculatorType::Pointer calculator = CalculatorType::New();
+  calculator->SetSample(sample);
+  calculator->SetWeights(weights);
+  calculator->SetWeightingFunction(function);
+  ITK_TEST_SET_GET_BOOLEAN(calculator, ComputeCovariance, true);
+  ITK_TEST_SET_GET_BOOLEAN(calculator, ComputeBounds, true);
+  calculator->Compute();
+
+  const unsigned int  measurementVectorSize = sample->GetMeasurementVectorSize();
+  double              totalWeight = 0.0;
+  std::vector<double> mean(measurementVectorSize, 0.0);
+  std::vector<double> minimum(measurementVectorSize, itk::NumericTraits<double>::max());
+  std::vector<double> maximum(measurementVectorSize, itk::NumericTraits<double>::NonpositiveMin());
+
+  auto getWeight = [weights, function](unsigned int id, const typename TSample::ConstIterator & iter) {
+    double weight = iter.GetFrequency();
+    if (weights != nullptr)
+    {
+      weight *= (*weights)[id];
+    }
+    else if (function != nullptr)
+    {
+      weight *= function->Evaluate(iter.GetMeasurementVector());
+    }
+    return weight;
+  };
+
+  unsigned int id = 0;
+  for (typename TSample::ConstIterator iter = sample->Begin(); iter != sample->End(); ++iter, ++id)
+  {
+    const double weight = getWeight(id, iter);
+    if (weight == 0.0)
+    {
+      continue;
+    }
+    totalWeight += weight;
+    for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+    {
+      const double component = iter.GetMeasurementVector()[dim];
+      mean[dim] += weight * component;
+      minimum[dim] = std::min(minimum[dim], component);
+      maximum[dim] = std::max(maximum[dim], component);
+    }
+  }
+  for (unsigned int dim = 0; dim < measurementVectorSize; ++dim)
+  {
+    mean[dim] /= totalWeight;
+  }
+
+  std::vector<double> scatter(measurementVectorSize * measurementVectorSize, 0.0);
+  id = 0;
+  for (typename TSample::ConstIterator iter = sample->Begin(); iter != sample->End(); ++iter, ++id)
+  {
+    const double weight = getWeight(id, iter);
+    for (unsigned int row = 0; row < measurementVectorSize; ++row)
+    {
+      for (unsigned int col = 0; col < measurementVectorSize; ++col)
+      {
+        scatter[row * measurementVectorSize + col] += weight * (iter.GetMeasurementVector()[row] - mean[row]) *
+                                                      (iter.GetMeasurementVector()[col] - mean[col]);
+      }
+    }
+  }
+
+  std::cout << name << ": total weight " << calculator->GetTotalWeight() << " mean " << calculator->GetMean()
+            << std::endl;
+
+  bool passed = AlmostEqual(calculator->GetTotalWeight(), totalWeight);
+  for (unsigned int row = 0; row < measurementVectorSize; ++row)
+  {
+    passed &= AlmostEqual(calculator->GetMean()[row], mean[row]);
+    passed &= AlmostEqual(calculator->GetMinimum()[row], minimum[row]);
+    passed &= AlmostEqual(calculator->GetMaximum()[row], maximum[row]);
+    passed &= AlmostEqual(calculator->GetSumOfSquaredDeviations()[row], scatter[row * measurementVectorSize + row]);
+    for (unsigned int col = 0; col < measurementVectorSize; ++col)
+    {
+      passed &= AlmostEqual(calculator->GetScatterMatrix()(row, col), scatter[row * measurementVectorSize + col]);
+    }
+  }
+  if (!passed)
+  {
+    std::cerr << name << ": the moments differ from the expected ones" << std::endl;
+    std::cerr << "  expected total weight " << totalWeight << " mean";
+    for (double value : mean)
+    {
+      std::cerr << ' ' << value;
+    }
+    std::cerr << std::endl << "  scatter matrix " << calculator->GetScatterMatrix() << " expected";
+    for (double value : scatter)
+    {
+      std::cerr << ' ' << value;
+    }
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The variances alone are the diagonal of the scatter matrix.
+  calculator->ComputeCovarianceOff();
+  calculator->ComputeBoundsOff();
+  ITK_TEST_SET_GET_BOOLEAN(calculator, ComputeVariance, true);
+  calculator->Compute();
+  for (unsigned int row = 0; row < measurementVectorSize; ++row)
+  {
+    if (!AlmostEqual(calculator->GetSumOfSquaredDeviations()[row], scatter[row * measurementVectorSize + row]))
+    {
+      std::cerr << name << ": the sum of squared deviations " << row << " is "
+                << calculator->GetSumOfSquaredDeviations()[row] << " instead of "
+                << scatter[row * measurementVectorSize + row] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkSampleMomentsCalculatorTest(int, char *[])
+{
+  namespace stat = itk::Statistics;
+
+  using NumberGeneratorType = stat::MersenneTwisterRandomVariateGenerator;
+  NumberGeneratorType::Pointer randomNumberGenerator = NumberGeneratorType::GetInstance();
+  randomNumberGenerator->Initialize(1234);
+
+  int result = EXIT_SUCCESS;
+
+  // List sample, split into several blocks
+  using MeasurementVectorType = itk::Vector<float, 3>;
+  using ListSampleType = stat::ListSample<MeasurementVectorType>;
+  ListSampleType::Pointer listSample = ListSampleType::New();
+  listSample->SetMeasurementVectorSize(3);
+
+  constexpr unsigned int numberOfMeasurementVectors = 5000;
+  MeasurementVectorType  mv;
+  for (unsigned int i = 0; i < numberOfMeasurementVectors; ++i)
+  {
+    mv[0] = randomNumberGenerator->GetNormalVariate(1000.0, 4.0);
+    mv[1] = randomNumberGenerator->GetUniformVariate(-10.0, 10.0) + 0.5 * mv[0];
+    mv[2] = randomNumberGenerator->GetNormalVariate(-5.0, 100.0);
+    listSample->PushBack(mv);
+  }
+
+  using CalculatorType = stat::SampleMomentsCalculator<ListSampleType>;
+  CalculatorType::Pointer calculator = CalculatorType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(calculator, SampleMomentsCalculator, Object);
+  ITK_TRY_EXPECT_EXCEPTION(calculator->Compute());
+
+  result |= CheckMoments(listSample.GetPointer(), nullptr, nullptr, "ListSample");
+
+  CalculatorType::WeightArrayType weights(numberOfMeasurementVectors);
+  for (unsigned int i = 0; i < numberOfMeasurementVectors; ++i)
+  {
+    weights[i] = (i % 7 == 0) ? 0.0 : randomNumberGenerator->GetUniformVariate(0.0, 2.0);
+  }
+  result |= CheckMoments(listSample.GetPointer(), &weights, nullptr, "ListSample with weights");
+
+  using WeightingFunctionType = stat::GaussianMembershipFunction<MeasurementVectorType>;
+  WeightingFunctionType::Pointer weightingFunction = WeightingFunctionType::New();
+  WeightingFunctionType::MeanVectorType functionMean;
+  functionMean[0] = 1000.0;
+  functionMean[1] = 500.0;
+  functionMean[2] = 0.0;
+  weightingFunction->SetMean(functionMean);
+  WeightingFunctionType::CovarianceMatrixType covariance(3, 3);
+  covariance.SetIdentity();
+  covariance *= 100.0;
+  weightingFunction->SetCovariance(covariance);
+  result |= CheckMoments(listSample.GetPointer(), nullptr, weightingFunction.GetPointer(), "ListSample with function");
+
+  CalculatorType::WeightArrayType shortWeights(10);
+  calculator->SetSample(listSample);
+  calculator->SetWeights(&shortWeights);
+  ITK_TRY_EXPECT_EXCEPTION(calculator->Compute());
+
+  // Adaptors of a scalar image and of a vector image
+  using ImageType = itk::Image<short, 2>;
+  ImageType::Pointer    image = ImageType::New();
+  ImageType::RegionType region;
+  ImageType::SizeType   size;
+  size[0] = 70;
+  size[1] = 50;
+  region.SetSize(size);
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(randomNumberGenerator->GetIntegerVariate(2000)) - 1000);
+  }
+  using ImageAdaptorType = stat::ImageToListSampleAdaptor<ImageType>;
+  ImageAdaptorType::Pointer imageAdaptor = ImageAdaptorType::New();
+  imageAdaptor->SetImage(image);
+  result |= CheckMoments(imageAdaptor.GetPointer(), nullptr, nullptr, "ImageToListSampleAdaptor");
+
+  using VectorImageType = itk::VectorImage<float, 2>;
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(region);
+  vectorImage->SetNumberOfComponentsPerPixel(2);
+  vectorImage->Allocate();
+  VectorImageType::PixelType pixel(2);
+  for (itk::ImageRegionIterator<VectorImageType> it(vectorImage, region); !it.IsAtEnd(); ++it)
+  {
+    pixel[0] = randomNumberGenerator->GetNormalVariate(10.0, 1.0);
+    pixel[1] = randomNumberGenerator->GetNormalVariate(-20.0, 9.0) + pixel[0];
+    it.Set(pixel);
+  }
+  using VectorImageAdaptorType = stat::ImageToListSampleAdaptor<VectorImageType>;
+  VectorImageAdaptorType::Pointer vectorImageAdaptor = VectorImageAdaptorType::New();
+  vectorImageAdaptor->SetImage(vectorImage);
+  result |= CheckMoments(vectorImageAdaptor.GetPointer(), nullptr, nullptr, "VectorImage ImageToListSampleAdaptor");
+
+  // Histogram, read through its iterator
+  using HistogramType = stat::Histogram<double>;
+  HistogramType::Pointer histogram = HistogramType::New();
+  histogram->SetMeasurementVectorSize(2);
+  HistogramType::SizeType              histogramSize(2);
+  HistogramType::MeasurementVectorType lowerBound(2);
+  HistogramType::MeasurementVectorType upperBound(2);
+  histogramSize[0] = 300;
+  histogramSize[1] = 400;
+  lowerBound.Fill(0.0);
+  upperBound[0] = 300.0;
+  upperBound[1] = 200.0;
+  histogram->Initialize(histogramSize, lowerBound, upperBound);
+  for (HistogramType::Iterator iter = histogram->Begin(); iter != histogram->End(); ++iter)
+  {
+    iter.SetFrequency(randomNumberGenerator->GetIntegerVariate(3));
+  }
+  result |= CheckMoments(histogram.GetPointer(), nullptr, nullptr, "Histogram");
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cerr << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
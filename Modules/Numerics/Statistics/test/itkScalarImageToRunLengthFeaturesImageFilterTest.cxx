@@ -0,0 +1,254 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkScalarImageToRunLengthFeaturesImageFilter.h"
+#include "itkScalarImageToRunLengthMatrixFilter.h"
+#include "itkHistogramToRunLengthFeaturesFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+CropImage(const TImage * image, const typename TImage::RegionType & region)
+{
+  typename TImage::Pointer crop = TImage::New();
+  crop->CopyInformation(image);
+  crop->SetRegions(region);
+  crop->Allocate();
+  itk::ImageAlgorithm::Copy(image, crop.GetPointer(), region, region);
+  return crop;
+}
+
+/* Compares the features of each pixel with the features of the run-length
+ * matrix of the cropped box around it */
+template <typename TImage, typename TFilter>
+int
+CheckFeatures(const TImage * image, const TFilter * filter)
+{
+  using MatrixFilterType = itk::Statistics::ScalarImageToRunLengthMatrixFilter<TImage>;
+  using HistogramType = typename MatrixFilterType::HistogramType;
+  using FeaturesFilterType = itk::Statistics::HistogramToRunLengthFeaturesFilter<HistogramType>;
+  using FeatureEnum = itk::Statistics::HistogramToRunLengthFeaturesFilterEnums::RunLengthFeature;
+  using OutputImageType = typename TFilter::OutputImageType;
+
+  const OutputImageType * output = filter->GetOutput();
+  const auto &            requestedFeatures = filter->GetRequestedFeatures()->CastToSTLConstContainer();
+  if (output->GetNumberOfComponentsPerPixel() != requestedFeatures.size())
+  {
+    std::cerr << "Output has " << output->GetNumberOfComponentsPerPixel() << " components instead of "
+              << requestedFeatures.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    typename TImage::RegionType window(it.GetIndex(), TImage::SizeType::Filled(1));
+    window.PadByRadius(filter->GetRadius());
+    window.Crop(image->GetLargestPossibleRegion());
+
+    typename MatrixFilterType::Pointer matrixFilter = MatrixFilterType::New();
+    matrixFilter->SetInput(CropImage(image, window));
+    typename MatrixFilterType::OffsetVector::Pointer offsets = MatrixFilterType::OffsetVector::New();
+    offsets->CastToSTLContainer() = filter->GetOffsets()->CastToSTLConstContainer();
+    matrixFilter->SetOffsets(offsets);
+    matrixFilter->SetNumberOfBinsPerAxis(filter->GetNumberOfBinsPerAxis());
+    matrixFilter->SetPixelValueMinMax(filter->GetMin(), filter->GetMax());
+    matrixFilter->SetDistanceValueMinMax(filter->GetMinDistance(), filter->GetMaxDistance());
+    matrixFilter->Update();
+
+    const bool                           empty = matrixFilter->GetOutput()->GetTotalFrequency() == 0;
+    typename FeaturesFilterType::Pointer featuresFilter = FeaturesFilterType::New();
+    featuresFilter->SetInput(matrixFilter->GetOutput());
+    if (!empty)
+    {
+      featuresFilter->Update();
+    }
+
+    const typename OutputImageType::PixelType features = it.Get();
+    for (unsigned int i = 0; i < requestedFeatures.size(); ++i)
+    {
+      double expected = 0.0;
+      if (!empty)
+      {
+        expected = featuresFilter->GetFeature(static_cast<FeatureEnum>(requestedFeatures[i]));
+      }
+      if (std::abs(features[i] - expected) > 1e-4 * std::max(1.0, std::abs(expected)))
+      {
+        std::cerr << "Feature " << static_cast<unsigned int>(requestedFeatures[i]) << " at " << it.GetIndex() << " is "
+                  << features[i] << " instead of " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkScalarImageToRunLengthFeaturesImageFilterTest(int, char *[])
+{
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize(2021);
+
+  // A 2D image of blocks with noise, so that there are long runs
+  using ImageType = itk::Image<short, 2>;
+  using FilterType = itk::Statistics::ScalarImageToRunLengthFeaturesImageFilter<ImageType>;
+
+  ImageType::RegionType region;
+  region.SetIndex(0, 3);
+  region.SetIndex(1, -2);
+  region.SetSize(0, 23);
+  region.SetSize(1, 17);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    short                      value = static_cast<short>((((index[0] + 9) / 4) * 5 + ((index[1] + 8) / 3) * 3) % 16);
+    if (generator->GetUniformVariate(0.0, 1.0) < 0.1)
+    {
+      value = static_cast<short>(generator->GetIntegerVariate(15));
+    }
+    it.Set(value);
+  }
+
+  FilterType::Pointer filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, ScalarImageToRunLengthFeaturesImageFilter, BoxImageFilter);
+
+  FilterType::RadiusType radius;
+  radius[0] = 3;
+  radius[1] = 2;
+  filter->SetRadius(radius);
+  filter->SetInput(image);
+  filter->SetNumberOfBinsPerAxis(8);
+  ITK_TEST_SET_GET_VALUE(8, filter->GetNumberOfBinsPerAxis());
+  filter->SetPixelValueMinMax(0, 15);
+  ITK_TEST_SET_GET_VALUE(0, filter->GetMin());
+  ITK_TEST_SET_GET_VALUE(15, filter->GetMax());
+  filter->SetDistanceValueMinMax(0, 6);
+  ITK_TEST_SET_GET_VALUE(0, filter->GetMinDistance());
+  ITK_TEST_SET_GET_VALUE(6, filter->GetMaxDistance());
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  if (CheckFeatures<ImageType>(image, filter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The result doesn't depend on the number of work units
+  FilterType::OutputImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  filter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  itk::ImageRegionConstIterator<FilterType::OutputImageType> outputIt(output, region);
+  itk::ImageRegionConstIterator<FilterType::OutputImageType> serialIt(filter->GetOutput(), region);
+  for (; !outputIt.IsAtEnd(); ++outputIt, ++serialIt)
+  {
+    if (outputIt.Get() != serialIt.Get())
+    {
+      std::cerr << "Features differ with one work unit: " << outputIt.Get() << " != " << serialIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Offsets longer than one pixel, and a subset of the features
+  FilterType::OffsetVectorPointer offsets = FilterType::OffsetVector::New();
+  offsets->push_back(FilterType::OffsetType{ { 2, 0 } });
+  offsets->push_back(FilterType::OffsetType{ { -1, 2 } });
+  offsets->push_back(FilterType::OffsetType{ { 0, -1 } });
+  filter->SetOffsets(offsets);
+  FilterType::FeatureNameVectorPointer requestedFeatures = FilterType::FeatureNameVector::New();
+  requestedFeatures->push_back(
+    static_cast<FilterType::RunLengthFeatureName>(FilterType::RunLengthFeatureEnum::RunLengthNonuniformity));
+  requestedFeatures->push_back(
+    static_cast<FilterType::RunLengthFeatureName>(FilterType::RunLengthFeatureEnum::ShortRunEmphasis));
+  filter->SetRequestedFeatures(requestedFeatures);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  if (CheckFeatures<ImageType>(image, filter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A mask without any inside pixel
+  ImageType::Pointer mask = ImageType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+  mask->FillBuffer(0);
+  filter->SetMaskImage(mask);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  for (itk::ImageRegionConstIterator<FilterType::OutputImageType> it(filter->GetOutput(), region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get()[0] != 0.0f || it.Get()[1] != 0.0f)
+    {
+      std::cerr << "Features of a box outside the mask are " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A zero offset
+  FilterType::OffsetVectorPointer zeroOffsets = FilterType::OffsetVector::New();
+  zeroOffsets->push_back(FilterType::OffsetType{ { 0, 0 } });
+  filter->SetOffsets(zeroOffsets);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  // A 3D image, with the default offsets and spacing
+  using Image3DType = itk::Image<unsigned char, 3>;
+  using Filter3DType = itk::Statistics::ScalarImageToRunLengthFeaturesImageFilter<Image3DType>;
+
+  Image3DType::Pointer image3D = Image3DType::New();
+  image3D->SetRegions(Image3DType::SizeType{ { 9, 8, 7 } });
+  image3D->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<Image3DType> it(image3D, image3D->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const Image3DType::IndexType index = it.GetIndex();
+    auto value = static_cast<unsigned char>(((index[0] / 3 + index[1] / 2 + index[2]) % 3) * 60);
+    if (generator->GetUniformVariate(0.0, 1.0) < 0.1)
+    {
+      value = static_cast<unsigned char>(generator->GetIntegerVariate(3) * 60);
+    }
+    it.Set(value);
+  }
+  Image3DType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 1.0;
+  spacing[2] = 2.0;
+  image3D->SetSpacing(spacing);
+
+  Filter3DType::Pointer filter3D = Filter3DType::New();
+  filter3D->SetInput(image3D);
+  filter3D->SetRadius(2);
+  filter3D->SetNumberOfBinsPerAxis(4);
+  filter3D->SetPixelValueMinMax(0, 179);
+  filter3D->SetDistanceValueMinMax(0, 10);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter3D->Update());
+  ITK_TEST_EXPECT_EQUAL(filter3D->GetOffsets()->Size(), 13);
+  if (CheckFeatures<Image3DType>(image3D, filter3D.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkScalarImageToTextureFeaturesImageFilter.h"
+#include "itkScalarImageToCooccurrenceMatrixFilter.h"
+#include "itkHistogramToTextureFeaturesFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+CropImage(const TImage * image, const typename TImage::RegionType & region)
+{
+  typename TImage::Pointer crop = TImage::New();
+  crop->CopyInformation(image);
+  crop->SetRegions(region);
+  crop->Allocate();
+  itk::ImageAlgorithm::Copy(image, crop.GetPointer(), region, region);
+  return crop;
+}
+
+/* Compares the features of each pixel with the features of the
+ * co-occurrence matrix of the cropped box around it */
+template <typename TImage, typename TFilter>
+int
+CheckFeatures(const TImage * image, const TImage * mask, const TFilter * filter)
+{
+  using MatrixFilterType = itk::Statistics::ScalarImageToCooccurrenceMatrixFilter<TImage>;
+  using HistogramType = typename MatrixFilterType::HistogramType;
+  using FeaturesFilterType = itk::Statistics::HistogramToTextureFeaturesFilter<HistogramType>;
+  using OutputImageType = typename TFilter::OutputImageType;
+
+  const OutputImageType * output = filter->GetOutput();
+  const auto &            requestedFeatures = filter->GetRequestedFeatures()->CastToSTLConstContainer();
+  if (output->GetNumberOfComponentsPerPixel() != requestedFeatures.size())
+  {
+    std::cerr << "Output has " << output->GetNumberOfComponentsPerPixel() << " components instead of "
+              << requestedFeatures.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    typename TImage::RegionType window(it.GetIndex(), TImage::SizeType::Filled(1));
+    window.PadByRadius(filter->GetRadius());
+    window.Crop(image->GetLargestPossibleRegion());
+
+    typename MatrixFilterType::Pointer matrixFilter = MatrixFilterType::New();
+    matrixFilter->SetInput(CropImage(image, window));
+    if (mask)
+    {
+      matrixFilter->SetMaskImage(CropImage(mask, window));
+    }
+    matrixFilter->SetOffsets(filter->GetOffsets());
+    matrixFilter->SetNumberOfBinsPerAxis(filter->GetNumberOfBinsPerAxis());
+    matrixFilter->SetPixelValueMinMax(filter->GetMin(), filter->GetMax());
+    matrixFilter->Update();
+
+    const bool                          empty = matrixFilter->GetOutput()->GetTotalFrequency() == 0;
+    typename FeaturesFilterType::Pointer featuresFilter = FeaturesFilterType::New();
+    featuresFilter->SetInput(matrixFilter->GetOutput());
+    if (!empty)
+    {
+      featuresFilter->Update();
+    }
+
+    const typename OutputImageType::PixelType features = it.Get();
+    for (unsigned int i = 0; i < requestedFeatures.size(); ++i)
+    {
+      double expected = 0.0;
+      if (!empty)
+      {
+        expected = featuresFilter->GetFeature(static_cast<typename FeaturesFilterType::TextureFeatureEnum>(
+          requestedFeatures[i]));
+      }
+      if (std::isnan(expected))
+      {
+        continue;
+      }
+      if (std::abs(features[i] - expected) > 1e-4 * std::max(1.0, std::abs(expected)))
+      {
+        std::cerr << "Feature " << static_cast<unsigned int>(requestedFeatures[i]) << " at " << it.GetIndex() << " is "
+                  << features[i] << " instead of " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkScalarImageToTextureFeaturesImageFilterTest(int, char *[])
+{
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize(2021);
+
+  // A 2D image of blocks with noise, and a mask with a hole
+  using ImageType = itk::Image<short, 2>;
+  using FilterType = itk::Statistics::ScalarImageToTextureFeaturesImageFilter<ImageType>;
+
+  ImageType::RegionType region;
+  region.SetIndex(0, 3);
+  region.SetIndex(1, -2);
+  region.SetSize(0, 23);
+  region.SetSize(1, 17);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  ImageType::Pointer mask = ImageType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    short                      value = static_cast<short>((((index[0] + 9) / 3) * 5 + ((index[1] + 8) / 2) * 3) % 16);
+    if (generator->GetUniformVariate(0.0, 1.0) < 0.2)
+    {
+      value = static_cast<short>(generator->GetIntegerVariate(17)) - 1;
+    }
+    it.Set(value);
+    mask->SetPixel(index, (index[0] > 10 && index[0] < 16 && index[1] > 2 && index[1] < 8) ? 0 : 1);
+  }
+
+  FilterType::Pointer filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, ScalarImageToTextureFeaturesImageFilter, BoxImageFilter);
+
+  FilterType::RadiusType radius;
+  radius[0] = 3;
+  radius[1] = 2;
+  filter->SetRadius(radius);
+  filter->SetInput(image);
+  filter->SetNumberOfBinsPerAxis(8);
+  ITK_TEST_SET_GET_VALUE(8, filter->GetNumberOfBinsPerAxis());
+  filter->SetPixelValueMinMax(0, 15);
+  ITK_TEST_SET_GET_VALUE(0, filter->GetMin());
+  ITK_TEST_SET_GET_VALUE(15, filter->GetMax());
+
+  FilterType::FeatureNameVectorPointer requestedFeatures = FilterType::FeatureNameVector::New();
+  for (unsigned int i = 0; i < static_cast<unsigned int>(FilterType::TextureFeatureEnum::InvalidFeatureName); ++i)
+  {
+    requestedFeatures->push_back(static_cast<FilterType::TextureFeatureName>(i));
+  }
+  filter->SetRequestedFeatures(requestedFeatures);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  if (CheckFeatures<ImageType>(image, nullptr, filter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The result doesn't depend on the number of work units
+  FilterType::OutputImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  filter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  itk::ImageRegionConstIterator<FilterType::OutputImageType> outputIt(output, region);
+  itk::ImageRegionConstIterator<FilterType::OutputImageType> serialIt(filter->GetOutput(), region);
+  for (; !outputIt.IsAtEnd(); ++outputIt, ++serialIt)
+  {
+    if (outputIt.Get() != serialIt.Get())
+    {
+      std::cerr << "Features differ with one work unit: " << outputIt.Get() << " != " << serialIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  filter->SetNumberOfWorkUnits(filter->GetMultiThreader()->GetGlobalDefaultNumberOfThreads());
+
+  // With a mask, and the default features
+  filter->SetMaskImage(mask);
+  filter->SetRequestedFeatures(FilterType::New()->GetRequestedFeatures());
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetOutput()->GetNumberOfComponentsPerPixel(), 6);
+  if (CheckFeatures<ImageType>(image, mask, filter.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // An invalid feature
+  requestedFeatures->push_back(
+    static_cast<FilterType::TextureFeatureName>(FilterType::TextureFeatureEnum::InvalidFeatureName));
+  filter->SetRequestedFeatures(requestedFeatures);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  // A 3D image, with the default offsets and a fixed length output
+  using Image3DType = itk::Image<unsigned char, 3>;
+  using Filter3DType =
+    itk::Statistics::ScalarImageToTextureFeaturesImageFilter<Image3DType, itk::Image<itk::Vector<double, 6>, 3>>;
+
+  Image3DType::Pointer image3D = Image3DType::New();
+  image3D->SetRegions(Image3DType::SizeType{ { 9, 8, 7 } });
+  image3D->Allocate();
+  for (itk::ImageRegionIterator<Image3DType> it(image3D, image3D->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<unsigned char>(generator->GetIntegerVariate(3) * 60));
+  }
+
+  Filter3DType::Pointer filter3D = Filter3DType::New();
+  filter3D->SetInput(image3D);
+  filter3D->SetNumberOfBinsPerAxis(4);
+  filter3D->SetPixelValueMinMax(0, 179);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter3D->Update());
+  ITK_TEST_EXPECT_EQUAL(filter3D->GetOffsets()->Size(), 13);
+  if (CheckFeatures<Image3DType>(image3D, nullptr, filter3D.GetPointer()) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
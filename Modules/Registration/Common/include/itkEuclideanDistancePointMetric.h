@@ -22,6 +22,7 @@
 #include "itkCovariantVector.h"
 #include "itkPointSet.h"
 #include "itkImage.h"
+#include "itkPointsLocator.h"
 
 namespace itk
 {
@@ -34,6 +35,10 @@ namespace itk
  *  should be used as the moving point-set.
  *  If the number of points is high, the possibility of setting a distance map
  *  should improve the speed of the closest point computation.
+ *  The closest points which the distance map does not provide are found by
+ *  searching a k-d tree of the fixed points, which is built once for the
+ *  fixed point set and reused until the fixed points change. The moving
+ *  points are searched in parallel.
  *
  *  Reference: "A Method for Registration of 3-D Shapes",
  *             IEEE PAMI, Vol 14, No. 2, February 1992
@@ -85,6 +90,11 @@ public:
   using DistanceMapType = TDistanceMap;
   using DistanceMapPointer = typename DistanceMapType::ConstPointer;
 
+  /** Type of the locator searching the closest fixed points. */
+  using FixedPointType = Point<typename FixedPointSetType::CoordRepType, FixedPointSetType::PointDimension>;
+  using FixedPointsContainer = VectorContainer<IdentifierType, FixedPointType>;
+  using FixedPointsLocatorType = PointsLocator<FixedPointsContainer>;
+
   /** Get the number of values, i.e. the number of points in the moving set. */
   unsigned int
   GetNumberOfValues() const override;
@@ -123,8 +133,19 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Builds the locator of the fixed points, unless it is up to date. */
+  void
+  InitializeFixedPointsLocator() const;
+
   DistanceMapPointer m_DistanceMap;
   bool               m_ComputeSquaredDistance{ false };
+
+  /** The fixed points copied into a vector container, so that the locator
+   * supports any point set, such as a QuadEdgeMesh. */
+  mutable typename FixedPointsContainer::Pointer              m_FixedPoints;
+  mutable typename FixedPointsLocatorType::Pointer            m_FixedPointsLocator;
+  mutable TimeStamp                                           m_FixedPointsLocatorTime;
+  mutable const typename FixedPointSetType::PointsContainer * m_LocatedFixedPoints{ nullptr };
 };
 } // end namespace itk
 
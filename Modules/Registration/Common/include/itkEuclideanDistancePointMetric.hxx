@@ -70,6 +70,12 @@ EuclideanDistancePointMetric<TFixedPointSet, TMovingPointSet, TDistanceMap>::Get
 
   this->SetTransformParameters(parameters);
 
+  // The closest points which the distance map does not provide are searched
+  // afterwards, all at once.
+  std::vector<FixedPointType>                       queries;
+  std::vector<typename Superclass::OutputPointType> transformedPoints;
+  std::vector<unsigned int>                         queryIdentifiers;
+
   unsigned int identifier = 0;
   while (pointItr != pointEnd)
   {
@@ -98,37 +104,79 @@ EuclideanDistancePointMetric<TFixedPointSet, TMovingPointSet, TDistanceMap>::Get
       }
     }
 
-    // If the closestPoint has not been found, go through the list of fixed
-    // points and find the closest distance
+    // If the closestPoint has not been found, search it among the fixed points
     if (!closestPoint)
     {
-      FixedPointIterator pointItr2 = fixedPointSet->GetPoints()->Begin();
-      FixedPointIterator pointEnd2 = fixedPointSet->GetPoints()->End();
+      FixedPointType query;
+      query.CastFrom(transformedPoint);
+      queries.push_back(query);
+      transformedPoints.push_back(transformedPoint);
+      queryIdentifiers.push_back(identifier);
+    }
 
-      while (pointItr2 != pointEnd2)
-      {
-        double dist = pointItr2.Value().SquaredEuclideanDistanceTo(transformedPoint);
+    measure.put(identifier, minimumDistance);
 
-        if (!m_ComputeSquaredDistance)
-        {
-          dist = std::sqrt(dist);
-        }
+    ++pointItr;
+    ++identifier;
+  }
 
-        if (dist < minimumDistance)
-        {
-          minimumDistance = dist;
-        }
-        ++pointItr2;
+  if (!queries.empty() && fixedPointSet->GetNumberOfPoints() > 0)
+  {
+    this->InitializeFixedPointsLocator();
+
+    typename FixedPointsLocatorType::NeighborsIdentifierType closestPointIdentifiers;
+    m_FixedPointsLocator->FindClosestPoints(queries, closestPointIdentifiers);
+
+    for (unsigned int i = 0; i < queries.size(); ++i)
+    {
+      double dist =
+        m_FixedPoints->ElementAt(closestPointIdentifiers[i]).SquaredEuclideanDistanceTo(transformedPoints[i]);
+
+      if (!m_ComputeSquaredDistance)
+      {
+        dist = std::sqrt(dist);
       }
+      measure.put(queryIdentifiers[i], dist);
     }
+  }
 
-    measure.put(identifier, minimumDistance);
+  return measure;
+}
 
+template <typename TFixedPointSet, typename TMovingPointSet, typename TDistanceMap>
+void
+EuclideanDistancePointMetric<TFixedPointSet, TMovingPointSet, TDistanceMap>::InitializeFixedPointsLocator() const
+{
+  const typename FixedPointSetType::PointsContainer * fixedPoints = this->GetFixedPointSet()->GetPoints();
+
+  if (m_FixedPointsLocator && fixedPoints == m_LocatedFixedPoints &&
+      fixedPoints->GetMTime() < m_FixedPointsLocatorTime.GetMTime())
+  {
+    return;
+  }
+
+  m_FixedPoints = FixedPointsContainer::New();
+  m_FixedPoints->Reserve(fixedPoints->Size());
+
+  FixedPointIterator pointItr = fixedPoints->Begin();
+  FixedPointIterator pointEnd = fixedPoints->End();
+  unsigned int       identifier = 0;
+  while (pointItr != pointEnd)
+  {
+    m_FixedPoints->SetElement(identifier, pointItr.Value());
     ++pointItr;
     ++identifier;
   }
 
-  return measure;
+  if (!m_FixedPointsLocator)
+  {
+    m_FixedPointsLocator = FixedPointsLocatorType::New();
+  }
+  m_FixedPointsLocator->SetPoints(m_FixedPoints);
+  m_FixedPointsLocator->Initialize();
+
+  m_LocatedFixedPoints = fixedPoints;
+  m_FixedPointsLocatorTime.Modified();
 }
 
 template <typename TFixedPointSet, typename TMovingPointSet, typename TDistanceMap>
@@ -95,6 +95,11 @@ public:
   PointIdentifier
   FindClosestPoint(const PointType & query) const;
 
+  /** Find the closest point of each query point, searching the queries in
+   * parallel. The closest point of queries[i] is returned in identifiers[i]. */
+  void
+  FindClosestPoints(const std::vector<PointType> & queries, NeighborsIdentifierType & identifiers) const;
+
   /** Find the k-nearest neighbors.  Returns the point ids. */
   void
   Search(const PointType &, unsigned int, NeighborsIdentifierType &) const;
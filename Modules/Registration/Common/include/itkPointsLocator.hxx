@@ -52,6 +52,8 @@ PointsLocator<TPointsContainer>::Initialize()
 
   this->m_KdTreeGenerator->SetSample(this->m_SampleAdaptor);
   this->m_KdTreeGenerator->SetBucketSize(16);
+  // The points of the container may be read concurrently.
+  this->m_KdTreeGenerator->ParallelBuildOn();
 
   this->m_KdTreeGenerator->Update();
 
@@ -68,6 +70,21 @@ PointsLocator<TPointsContainer>::FindClosestPoint(const PointType & query) const
   return identifiers[0];
 }
 
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::FindClosestPoints(const std::vector<PointType> & queries,
+                                                   NeighborsIdentifierType &      identifiers) const
+{
+  std::vector<NeighborsIdentifierType> neighbors;
+  this->m_Tree->Search(queries, 1u, neighbors);
+
+  identifiers.resize(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    identifiers[i] = neighbors[i][0];
+  }
+}
+
 template <typename TPointsContainer>
 void
 PointsLocator<TPointsContainer>::Search(const PointType &         query,
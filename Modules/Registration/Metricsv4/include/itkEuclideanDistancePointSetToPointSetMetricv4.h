@@ -82,10 +82,45 @@ public:
                                          LocalDerivativeType &,
                                          const PixelType & pixel = 0) const override;
 
+  /**
+   * Calculates the local metric value for the point of the given index in the
+   * fixed transformed point set, using the closest moving points found for
+   * all the fixed points at once in InitializeForIteration().
+   */
+  MeasureType
+  GetLocalNeighborhoodValueWithIndex(const PointIdentifier &,
+                                     const PointType &,
+                                     const PixelType & pixel = 0) const override;
+
+  /**
+   * Calculates the local value and derivative for the point of the given
+   * index in the fixed transformed point set.
+   */
+  void
+  GetLocalNeighborhoodValueAndDerivativeWithIndex(const PointIdentifier &,
+                                                  const PointType &,
+                                                  MeasureType &,
+                                                  LocalDerivativeType &,
+                                                  const PixelType & pixel = 0) const override;
+
+  /**
+   * Calculates the local derivative for the point of the given index in the
+   * fixed transformed point set.
+   */
+  LocalDerivativeType
+  GetLocalNeighborhoodDerivativeWithIndex(const PointIdentifier &,
+                                          const PointType &,
+                                          const PixelType & pixel = 0) const override;
+
 protected:
   EuclideanDistancePointSetToPointSetMetricv4() = default;
   ~EuclideanDistancePointSetToPointSetMetricv4() override = default;
 
+  /** Finds the closest moving point of every fixed point, searching them in
+   * parallel. */
+  void
+  InitializeForIteration() const override;
+
   bool
   RequiresFixedPointsLocator() const override
   {
@@ -95,6 +130,12 @@ protected:
   /** PrintSelf function */
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using NeighborsIdentifierType = typename Superclass::NeighborsIdentifierType;
+
+  /** Closest moving point of each fixed transformed point. */
+  mutable NeighborsIdentifierType m_ClosestPointIdentifiers;
 };
 } // end namespace itk
 
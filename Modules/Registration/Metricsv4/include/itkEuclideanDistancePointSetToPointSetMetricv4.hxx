@@ -57,6 +57,73 @@ EuclideanDistancePointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TIn
   localDerivative = closestPoint - point;
 }
 
+template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
+typename EuclideanDistancePointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
+  MeasureType
+  EuclideanDistancePointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
+    GetLocalNeighborhoodValueWithIndex(const PointIdentifier & index,
+                                       const PointType &       point,
+                                       const PixelType &       pixel) const
+{
+  if (index >= this->m_ClosestPointIdentifiers.size())
+  {
+    return this->GetLocalNeighborhoodValue(point, pixel);
+  }
+
+  const PointType closestPoint = this->m_MovingTransformedPointSet->GetPoint(this->m_ClosestPointIdentifiers[index]);
+
+  const MeasureType distance = point.EuclideanDistanceTo(closestPoint);
+  return distance;
+}
+
+template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
+void
+EuclideanDistancePointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
+  GetLocalNeighborhoodValueAndDerivativeWithIndex(const PointIdentifier & index,
+                                                  const PointType &       point,
+                                                  MeasureType &           measure,
+                                                  LocalDerivativeType &   localDerivative,
+                                                  const PixelType &       pixel) const
+{
+  if (index >= this->m_ClosestPointIdentifiers.size())
+  {
+    this->GetLocalNeighborhoodValueAndDerivative(point, measure, localDerivative, pixel);
+    return;
+  }
+
+  const PointType closestPoint = this->m_MovingTransformedPointSet->GetPoint(this->m_ClosestPointIdentifiers[index]);
+
+  measure = point.EuclideanDistanceTo(closestPoint);
+  localDerivative = closestPoint - point;
+}
+
+template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
+typename EuclideanDistancePointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
+  LocalDerivativeType
+  EuclideanDistancePointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
+    GetLocalNeighborhoodDerivativeWithIndex(const PointIdentifier & index,
+                                            const PointType &       point,
+                                            const PixelType &       pixel) const
+{
+  MeasureType         measure;
+  LocalDerivativeType localDerivative;
+  this->GetLocalNeighborhoodValueAndDerivativeWithIndex(index, point, measure, localDerivative, pixel);
+  return localDerivative;
+}
+
+template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
+void
+EuclideanDistancePointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
+  InitializeForIteration() const
+{
+  Superclass::InitializeForIteration();
+
+  // The correspondences of all the fixed points are searched at once, which
+  // the locator does in parallel.
+  this->m_MovingTransformedPointsLocator->FindClosestPoints(
+    this->m_FixedTransformedPointSet->GetPoints()->CastToSTLConstContainer(), this->m_ClosestPointIdentifiers);
+}
+
 /** PrintSelf method */
 template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
 void
@@ -160,6 +160,7 @@ public:
 
   using FixedTransformedPointSetType = PointSet<FixedPixelType, Self::PointDimension>;
   using MovingTransformedPointSetType = PointSet<MovingPixelType, Self::PointDimension>;
+  using MovingTransformedPointsContainer = typename MovingTransformedPointSetType::PointsContainer;
 
   using DerivativeValueType = typename DerivativeType::ValueType;
   using LocalDerivativeType = FixedArray<DerivativeValueType, Self::PointDimension>;
@@ -293,6 +294,47 @@ public:
                                          LocalDerivativeType &,
                                          const PixelType & pixel) const = 0;
 
+  /**
+   * Calculates the local metric value for the point of the given index in the
+   * fixed transformed point set, which is the point passed. The metric
+   * evaluation calls this method, so that derived classes may use results
+   * computed for all the points at once in InitializeForIteration(). By
+   * default, GetLocalNeighborhoodValue() is called.
+   */
+  virtual MeasureType
+  GetLocalNeighborhoodValueWithIndex(const PointIdentifier &, const PointType & point, const PixelType & pixel) const
+  {
+    return this->GetLocalNeighborhoodValue(point, pixel);
+  }
+
+  /**
+   * Calculates the local value and derivative for the point of the given
+   * index in the fixed transformed point set. By default,
+   * GetLocalNeighborhoodValueAndDerivative() is called.
+   */
+  virtual void
+  GetLocalNeighborhoodValueAndDerivativeWithIndex(const PointIdentifier &,
+                                                  const PointType &     point,
+                                                  MeasureType &         measure,
+                                                  LocalDerivativeType & localDerivative,
+                                                  const PixelType &     pixel) const
+  {
+    this->GetLocalNeighborhoodValueAndDerivative(point, measure, localDerivative, pixel);
+  }
+
+  /**
+   * Calculates the local derivative for the point of the given index in the
+   * fixed transformed point set. By default, GetLocalNeighborhoodDerivative()
+   * is called.
+   */
+  virtual LocalDerivativeType
+  GetLocalNeighborhoodDerivativeWithIndex(const PointIdentifier &,
+                                          const PointType & point,
+                                          const PixelType & pixel) const
+  {
+    return this->GetLocalNeighborhoodDerivative(point, pixel);
+  }
+
   /**
    * Get the virtual point set, derived from the fixed point set.
    * If the virtual point set has not yet been derived, it will be
@@ -414,6 +456,11 @@ protected:
   void
   TransformMovingPointSet() const;
 
+  /** Returns true if the two containers hold the same points with the same
+   * identifiers. */
+  bool
+  SamePoints(const MovingTransformedPointsContainer * points1, const MovingTransformedPointsContainer * points2) const;
+
   /**
    * Build point locators for the fixed and moving point sets to speed up
    * derivative and value calculations.
@@ -202,7 +202,7 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
               itkExceptionMacro("The corresponding data for point (pointId = " << index << ") does not exist.");
             }
           }
-          threadValue += this->GetLocalNeighborhoodValue(fixedTransformedPointSet[index], pixel);
+          threadValue += this->GetLocalNeighborhoodValueWithIndex(index, fixedTransformedPointSet[index], pixel);
         }
       }
       threadValues[rangeIndex] = threadValue;
@@ -328,13 +328,14 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
 
         if (calculateValue)
         {
-          this->GetLocalNeighborhoodValueAndDerivative(
-            fixedTransformedPointSet[index], pointValue, pointDerivative, pixel);
+          this->GetLocalNeighborhoodValueAndDerivativeWithIndex(
+            index, fixedTransformedPointSet[index], pointValue, pointDerivative, pixel);
           threadValue += pointValue;
         }
         else
         {
-          pointDerivative = this->GetLocalNeighborhoodDerivative(fixedTransformedPointSet[index], pixel);
+          pointDerivative =
+            this->GetLocalNeighborhoodDerivativeWithIndex(index, fixedTransformedPointSet[index], pixel);
         }
 
         // Map into parameter space
@@ -497,9 +498,8 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
                       (this->m_MovingTransform->GetMTime() > this->m_MovingTransformedPointSetTime));
   if (update)
   {
-    this->m_MovingTransformPointLocatorsNeedInitialization = true;
-    this->m_MovingTransformedPointSet = MovingTransformedPointSetType::New();
-    this->m_MovingTransformedPointSet->Initialize();
+    typename MovingTransformedPointSetType::Pointer movingTransformedPointSet = MovingTransformedPointSetType::New();
+    movingTransformedPointSet->Initialize();
 
     typename MovingTransformType::InverseTransformBasePointer inverseTransform =
       this->m_MovingTransform->GetInverseTransform();
@@ -510,15 +510,24 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
       if (this->m_CalculateValueAndDerivativeInTangentSpace)
       {
         PointType point = inverseTransform->TransformPoint(It.Value());
-        this->m_MovingTransformedPointSet->SetPoint(It.Index(), point);
+        movingTransformedPointSet->SetPoint(It.Index(), point);
       }
       else
       {
         // evaluation is performed in moving space, so just copy
-        this->m_MovingTransformedPointSet->SetPoint(It.Index(), It.Value());
+        movingTransformedPointSet->SetPoint(It.Index(), It.Value());
       }
       ++It;
     }
+
+    // The moving points locator is rebuilt only if the transformed points
+    // moved, since building its tree costs much more than comparing them.
+    if (!this->m_MovingTransformedPointSet ||
+        !this->SamePoints(this->m_MovingTransformedPointSet->GetPoints(), movingTransformedPointSet->GetPoints()))
+    {
+      this->m_MovingTransformedPointSet = movingTransformedPointSet;
+      this->m_MovingTransformPointLocatorsNeedInitialization = true;
+    }
     this->m_MovingTransformedPointSetTime = this->GetMTime();
     if (!this->m_CalculateValueAndDerivativeInTangentSpace)
     {
@@ -528,6 +537,30 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
   }
 }
 
+template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
+bool
+PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::SamePoints(
+  const MovingTransformedPointsContainer * points1,
+  const MovingTransformedPointsContainer * points2) const
+{
+  if (points1->Size() != points2->Size())
+  {
+    return false;
+  }
+  typename MovingTransformedPointsContainer::ConstIterator It1 = points1->Begin();
+  typename MovingTransformedPointsContainer::ConstIterator It2 = points2->Begin();
+  while (It1 != points1->End())
+  {
+    if (It1.Index() != It2.Index() || It1.Value() != It2.Value())
+    {
+      return false;
+    }
+    ++It1;
+    ++It2;
+  }
+  return true;
+}
+
 template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
 void
 PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
@@ -610,6 +643,7 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
     }
     this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
     this->m_FixedTransformedPointsLocator->Initialize();
+    this->m_FixedTransformPointLocatorsNeedInitialization = false;
   }
 
   if (this->RequiresMovingPointsLocator() && this->m_MovingTransformPointLocatorsNeedInitialization)
@@ -624,6 +658,7 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
     }
     this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
     this->m_MovingTransformedPointsLocator->Initialize();
+    this->m_MovingTransformPointLocatorsNeedInitialization = false;
   }
 }
 
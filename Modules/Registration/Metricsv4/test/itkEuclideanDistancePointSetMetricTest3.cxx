@@ -0,0 +1,191 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkEuclideanDistancePointSetToPointSetMetricv4.h"
+#include "itkEuclideanDistancePointMetric.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+#include "itkMath.h"
+
+/*
+ * Compare the metric values and derivatives, for which the closest points
+ * are searched in a batch, with a brute force search over several transforms.
+ */
+
+int
+itkEuclideanDistancePointSetMetricTest3(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using PointSetType = itk::PointSet<unsigned char, Dimension>;
+  using PointType = PointSetType::PointType;
+
+  using NumberGeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  NumberGeneratorType::Pointer randomNumberGenerator = NumberGeneratorType::GetInstance();
+  randomNumberGenerator->Initialize(1234);
+
+  PointSetType::Pointer fixedPoints = PointSetType::New();
+  PointSetType::Pointer movingPoints = PointSetType::New();
+
+  constexpr unsigned int numberOfFixedPoints = 1000;
+  constexpr unsigned int numberOfMovingPoints = 3000;
+
+  PointType point;
+  for (unsigned int n = 0; n < numberOfFixedPoints; ++n)
+  {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      point[d] = randomNumberGenerator->GetUniformVariate(0.0, 100.0);
+    }
+    fixedPoints->SetPoint(n, point);
+  }
+  for (unsigned int n = 0; n < numberOfMovingPoints; ++n)
+  {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      point[d] = randomNumberGenerator->GetUniformVariate(0.0, 100.0);
+    }
+    movingPoints->SetPoint(n, point);
+  }
+
+  using TranslationTransformType = itk::TranslationTransform<double, Dimension>;
+  TranslationTransformType::Pointer translationTransform = TranslationTransformType::New();
+  translationTransform->SetIdentity();
+
+  using PointSetMetricType = itk::EuclideanDistancePointSetToPointSetMetricv4<PointSetType>;
+  PointSetMetricType::Pointer metric = PointSetMetricType::New();
+  metric->SetFixedPointSet(fixedPoints);
+  metric->SetMovingPointSet(movingPoints);
+  metric->SetMovingTransform(translationTransform);
+  metric->Initialize();
+
+  using PointMetricType = itk::EuclideanDistancePointMetric<PointSetType, PointSetType>;
+  PointMetricType::Pointer pointMetric = PointMetricType::New();
+  pointMetric->SetFixedPointSet(fixedPoints);
+  pointMetric->SetMovingPointSet(movingPoints);
+  pointMetric->SetTransform(translationTransform);
+  pointMetric->Initialize();
+
+  constexpr double tolerance = 1e-6;
+
+  for (unsigned int iteration = 0; iteration < 5; ++iteration)
+  {
+    TranslationTransformType::ParametersType parameters(Dimension);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      parameters[d] = 2.0 * iteration - 0.5 * d;
+    }
+    translationTransform->SetParameters(parameters);
+
+    PointSetMetricType::MeasureType    value = metric->GetValue();
+    PointSetMetricType::MeasureType    value2;
+    PointSetMetricType::DerivativeType derivative;
+    PointSetMetricType::DerivativeType derivative2;
+    metric->GetDerivative(derivative);
+    metric->GetValueAndDerivative(value2, derivative2);
+
+    // Brute force search of the closest moving point of each fixed point
+    double                             expectedValue = 0.0;
+    PointSetMetricType::DerivativeType expectedDerivative(Dimension);
+    expectedDerivative.Fill(0.0);
+    for (unsigned int n = 0; n < numberOfFixedPoints; ++n)
+    {
+      const PointType transformedPoint = translationTransform->TransformPoint(fixedPoints->GetPoint(n));
+
+      PointType closestPoint = movingPoints->GetPoint(0);
+      for (unsigned int m = 1; m < numberOfMovingPoints; ++m)
+      {
+        if (movingPoints->GetPoint(m).SquaredEuclideanDistanceTo(transformedPoint) <
+            closestPoint.SquaredEuclideanDistanceTo(transformedPoint))
+        {
+          closestPoint = movingPoints->GetPoint(m);
+        }
+      }
+      expectedValue += transformedPoint.EuclideanDistanceTo(closestPoint);
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        expectedDerivative[d] += closestPoint[d] - transformedPoint[d];
+      }
+    }
+    expectedValue /= numberOfFixedPoints;
+    expectedDerivative /= numberOfFixedPoints;
+
+    std::cout << "Parameters: " << parameters << " value: " << value << " derivative: " << derivative << std::endl;
+
+    ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(value, expectedValue, 4, tolerance));
+    ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(value2, expectedValue, 4, tolerance));
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(derivative[d], expectedDerivative[d], 4, tolerance));
+      ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(derivative2[d], expectedDerivative[d], 4, tolerance));
+    }
+
+    // The point metric measures the distance of each transformed moving point
+    // to the closest fixed point.
+    PointMetricType::MeasureType pointValues = pointMetric->GetValue(parameters);
+    ITK_TEST_EXPECT_EQUAL(pointValues.size(), numberOfMovingPoints);
+    for (unsigned int m = 0; m < numberOfMovingPoints; ++m)
+    {
+      const TranslationTransformType::OutputPointType transformedPoint =
+        translationTransform->TransformPoint(movingPoints->GetPoint(m));
+
+      double minimumDistance = itk::NumericTraits<double>::max();
+      for (unsigned int n = 0; n < numberOfFixedPoints; ++n)
+      {
+        minimumDistance = std::min(minimumDistance, fixedPoints->GetPoint(n).EuclideanDistanceTo(transformedPoint));
+      }
+      if (!itk::Math::FloatAlmostEqual(pointValues[m], minimumDistance, 4, tolerance))
+      {
+        std::cerr << "The distance of the moving point " << m << " is " << pointValues[m] << " instead of "
+                  << minimumDistance << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The closest points follow a change of the moving points.
+  PointSetType::Pointer newMovingPoints = PointSetType::New();
+  newMovingPoints->SetPoint(0, fixedPoints->GetPoint(0));
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    point[d] = -1000.0;
+  }
+  for (unsigned int n = 1; n < numberOfMovingPoints; ++n)
+  {
+    newMovingPoints->SetPoint(n, point);
+  }
+  metric->SetMovingPointSet(newMovingPoints);
+  translationTransform->SetIdentity();
+  metric->Initialize();
+
+  PointSetMetricType::MeasureType    value;
+  PointSetMetricType::DerivativeType derivative;
+  metric->GetValueAndDerivative(value, derivative);
+
+  double expectedValue = 0.0;
+  for (unsigned int n = 0; n < numberOfFixedPoints; ++n)
+  {
+    expectedValue += fixedPoints->GetPoint(n).EuclideanDistanceTo(fixedPoints->GetPoint(0));
+  }
+  expectedValue /= numberOfFixedPoints;
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(value, expectedValue, 4, tolerance));
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -138,6 +138,9 @@ public:
 
   using LevelSetImageType = typename LevelSetType::ImageType;
   using LevelSetImagePointer = typename LevelSetImageType::Pointer;
+  using LevelSetImageRegionType = typename LevelSetImageType::RegionType;
+
+  using LevelSetBufferedRegionMapType = std::map<LevelSetIdentifierType, LevelSetImageRegionType>;
 
   /** Compute information from data object and/or allocate new level set image */
   void
@@ -179,6 +182,50 @@ public:
     this->SetContainer(newContainer);
   }
 
+  /** Compute information from data object and allocate new level set images
+   *  whose buffer only covers the given region (expressed in the index space
+   *  of each level set). Level sets missing from iBufferedRegions get an
+   *  empty buffer. */
+  void
+  CopyInformationAndAllocate(const Self * iOther, const LevelSetBufferedRegionMapType & iBufferedRegions)
+  {
+    LevelSetContainerType              internalContainer = iOther->GetContainer();
+    LevelSetContainerConstIteratorType it = internalContainer.begin();
+
+    LevelSetContainerType newContainer;
+
+    while (it != internalContainer.end())
+    {
+      LevelSetPointer temp_ls = LevelSetType::New();
+
+      LevelSetImagePointer      image = LevelSetImageType::New();
+      const LevelSetImageType * otherImage = (it->second)->GetImage();
+
+      LevelSetImageRegionType bufferedRegion;
+      bufferedRegion.SetIndex(otherImage->GetLargestPossibleRegion().GetIndex());
+
+      auto regionIt = iBufferedRegions.find(it->first);
+      if (regionIt != iBufferedRegions.end())
+      {
+        bufferedRegion = regionIt->second;
+      }
+
+      image->CopyInformation(otherImage);
+      image->SetLargestPossibleRegion(otherImage->GetLargestPossibleRegion());
+      image->SetBufferedRegion(bufferedRegion);
+      image->SetRequestedRegion(bufferedRegion);
+      image->Allocate();
+      image->FillBuffer(NumericTraits<OutputPixelType>::ZeroValue());
+
+      temp_ls->SetImage(image);
+      newContainer[it->first] = temp_ls;
+      newContainer[it->first]->SetDomainOffset((it->second)->GetDomainOffset());
+      ++it;
+    }
+
+    this->SetContainer(newContainer);
+  }
+
 protected:
   LevelSetContainer() = default;
   ~LevelSetContainer() override = default;
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace itk
 {
@@ -77,6 +78,9 @@ public:
   using TermType = LevelSetEquationTermBase<InputImageType, LevelSetContainerType>;
   using TermPointer = typename TermType::Pointer;
 
+  /** Maxima of the absolute values of the terms, in the order of their ids */
+  using TermContributionType = std::vector<LevelSetOutputRealType>;
+
   /** Set/Get the input image to be segmented. */
   itkSetObjectMacro(Input, InputImageType);
   itkGetModifiableObjectMacro(Input, InputImageType);
@@ -124,6 +128,20 @@ public:
   LevelSetOutputRealType
   Evaluate(const LevelSetInputIndexType & iP, const LevelSetDataType & iData);
 
+  /** Evaluate the term at a given pixel location, and accumulate the
+   * contributions of the terms in ioContribution instead of the container.
+   * Several threads can then evaluate the terms at once, each one with its
+   * own contributions, which are merged by MergeTermContribution(). */
+  LevelSetOutputRealType
+  Evaluate(const LevelSetInputIndexType & iP, TermContributionType & ioContribution);
+
+  LevelSetOutputRealType
+  Evaluate(const LevelSetInputIndexType & iP, const LevelSetDataType & iData, TermContributionType & ioContribution);
+
+  /** Merge the contributions accumulated by Evaluate(iP, ioContribution) */
+  void
+  MergeTermContribution(const TermContributionType & iContribution);
+
   /** Update the term parameters at end of iteration */
   void
   Update();
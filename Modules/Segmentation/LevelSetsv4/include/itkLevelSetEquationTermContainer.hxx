@@ -308,6 +308,82 @@ LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::Evaluate(const L
   return oValue;
 }
 
+// ----------------------------------------------------------------------------
+template <typename TInputImage, typename TLevelSetContainer>
+typename LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::LevelSetOutputRealType
+LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::Evaluate(const LevelSetInputIndexType & iP,
+                                                                         TermContributionType &         ioContribution)
+{
+  ioContribution.resize(m_Container.size(), NumericTraits<LevelSetOutputRealType>::ZeroValue());
+
+  auto term_it = m_Container.begin();
+  auto term_end = m_Container.end();
+
+  auto cfl_it = ioContribution.begin();
+
+  LevelSetOutputRealType oValue = NumericTraits<LevelSetOutputRealType>::ZeroValue();
+
+  while (term_it != term_end)
+  {
+    LevelSetOutputRealType temp_val = (term_it->second)->Evaluate(iP);
+
+    *cfl_it = std::max(itk::Math::abs(temp_val), *cfl_it);
+
+    oValue += temp_val;
+    ++term_it;
+    ++cfl_it;
+  }
+
+  return oValue;
+}
+
+// ----------------------------------------------------------------------------
+template <typename TInputImage, typename TLevelSetContainer>
+typename LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::LevelSetOutputRealType
+LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::Evaluate(const LevelSetInputIndexType & iP,
+                                                                         const LevelSetDataType &       iData,
+                                                                         TermContributionType &         ioContribution)
+{
+  ioContribution.resize(m_Container.size(), NumericTraits<LevelSetOutputRealType>::ZeroValue());
+
+  auto term_it = m_Container.begin();
+  auto term_end = m_Container.end();
+
+  auto cfl_it = ioContribution.begin();
+
+  LevelSetOutputRealType oValue = NumericTraits<LevelSetOutputRealType>::ZeroValue();
+
+  while (term_it != term_end)
+  {
+    LevelSetOutputRealType temp_val = (term_it->second)->Evaluate(iP, iData);
+
+    *cfl_it = std::max(itk::Math::abs(temp_val), *cfl_it);
+
+    oValue += temp_val;
+    ++term_it;
+    ++cfl_it;
+  }
+
+  return oValue;
+}
+
+// ----------------------------------------------------------------------------
+template <typename TInputImage, typename TLevelSetContainer>
+void
+LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::MergeTermContribution(
+  const TermContributionType & iContribution)
+{
+  auto cfl_it = m_TermContribution.begin();
+  auto contribution_it = iContribution.begin();
+
+  while (cfl_it != m_TermContribution.end() && contribution_it != iContribution.end())
+  {
+    cfl_it->second = std::max(*contribution_it, cfl_it->second);
+    ++cfl_it;
+    ++contribution_it;
+  }
+}
+
 // ----------------------------------------------------------------------------
 template <typename TInputImage, typename TLevelSetContainer>
 void
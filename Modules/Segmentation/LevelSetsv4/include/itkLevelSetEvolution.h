@@ -89,6 +89,8 @@ public:
   using LevelSetIdentifierType = typename Superclass::LevelSetIdentifierType;
 
   using LevelSetImageType = typename LevelSetType::ImageType;
+  using LevelSetImageRegionType = typename LevelSetImageType::RegionType;
+  using LevelSetImageIndexType = typename LevelSetImageType::IndexType;
 
   using LevelSetOutputType = typename Superclass::LevelSetOutputType;
   using LevelSetOutputRealType = typename Superclass::LevelSetOutputRealType;
@@ -360,10 +362,17 @@ public:
   using UpdateLevelSetFilterType = UpdateShiSparseLevelSet<ImageDimension, EquationContainerType>;
   using UpdateLevelSetFilterPointer = typename UpdateLevelSetFilterType::Pointer;
 
+  /** Set/Get the number of work units updating the level sets. The output
+   * does not depend on it. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
   LevelSetEvolution() = default;
   ~LevelSetEvolution() override = default;
 
 protected:
+  ThreadIdType m_NumberOfWorkUnits{ MultiThreaderBase::GetGlobalDefaultNumberOfThreads() };
+
   /** Update the levelset by 1 iteration from the computed updates */
   void
   UpdateLevelSets() override;
@@ -439,10 +448,17 @@ public:
   using UpdateLevelSetFilterType = UpdateMalcolmSparseLevelSet<ImageDimension, EquationContainerType>;
   using UpdateLevelSetFilterPointer = typename UpdateLevelSetFilterType::Pointer;
 
+  /** Set/Get the number of work units updating the level sets. The output
+   * does not depend on it. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
   LevelSetEvolution() = default;
   ~LevelSetEvolution() override = default;
 
 protected:
+  ThreadIdType m_NumberOfWorkUnits{ MultiThreaderBase::GetGlobalDefaultNumberOfThreads() };
+
   void
   UpdateLevelSets() override;
   void
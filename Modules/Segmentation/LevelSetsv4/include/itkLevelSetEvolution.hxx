@@ -39,7 +39,62 @@ void
 LevelSetEvolution<TEquationContainer, LevelSetDenseImage<TImage>>::AllocateUpdateBuffer()
 {
   this->m_UpdateBuffer = LevelSetContainerType::New();
-  this->m_UpdateBuffer->CopyInformationAndAllocate(this->m_LevelSetContainer, true);
+
+  if (!this->m_LevelSetContainer->HasDomainMap())
+  {
+    this->m_UpdateBuffer->CopyInformationAndAllocate(this->m_LevelSetContainer, true);
+    return;
+  }
+
+  // The update of a level set is only computed in the domains listing its
+  // identifier, so its buffer is restricted to the bounding region of these
+  // domains: memory then scales with the support of each level set instead
+  // of with the image size times the number of level sets.
+  using BufferedRegionMapType = typename LevelSetContainerType::LevelSetBufferedRegionMapType;
+  using DomainMapType = typename DomainMapImageFilterType::DomainMapType;
+
+  BufferedRegionMapType bufferedRegions;
+
+  const DomainMapType & domainMap = this->m_LevelSetContainer->GetDomainMapFilter()->GetDomainMap();
+  for (auto mapIt = domainMap.begin(); mapIt != domainMap.end(); ++mapIt)
+  {
+    const IdListType * idList = mapIt->second.GetIdList();
+    for (auto idListIt = idList->begin(); idListIt != idList->end(); ++idListIt)
+    {
+      //! \todo Fix me for string identifiers
+      const LevelSetIdentifierType   levelSetId = *idListIt - 1;
+      typename LevelSetType::Pointer levelSet = this->m_LevelSetContainer->GetLevelSet(levelSetId);
+
+      LevelSetImageRegionType region;
+      region.SetSize(mapIt->second.GetRegion()->GetSize());
+      region.SetIndex(mapIt->second.GetRegion()->GetIndex() - levelSet->GetDomainOffset());
+      if (!region.Crop(levelSet->GetImage()->GetLargestPossibleRegion()))
+      {
+        continue;
+      }
+
+      auto regionIt = bufferedRegions.find(levelSetId);
+      if (regionIt == bufferedRegions.end())
+      {
+        bufferedRegions[levelSetId] = region;
+        continue;
+      }
+
+      // Grow the bounding region
+      LevelSetImageRegionType & bufferedRegion = regionIt->second;
+      LevelSetImageIndexType    lower = bufferedRegion.GetIndex();
+      LevelSetImageIndexType    upper = bufferedRegion.GetUpperIndex();
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        lower[dim] = std::min(lower[dim], region.GetIndex()[dim]);
+        upper[dim] = std::max(upper[dim], region.GetUpperIndex()[dim]);
+      }
+      bufferedRegion.SetIndex(lower);
+      bufferedRegion.SetUpperIndex(upper);
+    }
+  }
+
+  this->m_UpdateBuffer->CopyInformationAndAllocate(this->m_LevelSetContainer, bufferedRegions);
 }
 
 template <typename TEquationContainer, typename TImage>
@@ -155,7 +210,15 @@ LevelSetEvolution<TEquationContainer, LevelSetDenseImage<TImage>>::UpdateLevelSe
   {
     typename LevelSetType::Pointer levelSet = this->m_LevelSetContainerIteratorToProcessWhenThreading->GetLevelSet();
     typename LevelSetImageType::ConstPointer levelSetImage = levelSet->GetImage();
-    this->m_SplitLevelSetUpdateLevelSetsThreader->Execute(this, levelSetImage->GetRequestedRegion());
+
+    // Only the buffered part of the update carries non-zero values
+    const LevelSetImageType * levelSetUpdateImage =
+      this->m_LevelSetUpdateContainerIteratorToProcessWhenThreading->GetLevelSet()->GetImage();
+    LevelSetImageRegionType region = levelSetImage->GetRequestedRegion();
+    if (region.Crop(levelSetUpdateImage->GetBufferedRegion()))
+    {
+      this->m_SplitLevelSetUpdateLevelSetsThreader->Execute(this, region);
+    }
 
     ++(this->m_LevelSetContainerIteratorToProcessWhenThreading);
     ++(this->m_LevelSetUpdateContainerIteratorToProcessWhenThreading);
@@ -275,7 +338,7 @@ LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDime
   {
     typename LevelSetType::ConstPointer levelSet =
       this->m_LevelSetContainerIteratorToProcessWhenThreading->GetLevelSet();
-    const LevelSetLayerType                           zeroLayer = levelSet->GetLayer(0);
+    const LevelSetLayerType &                         zeroLayer = levelSet->GetLayer(0);
     auto                                              layerBegin = zeroLayer.begin();
     auto                                              layerEnd = zeroLayer.end();
     typename SplitLevelSetPartitionerType::DomainType completeDomain(layerBegin, layerEnd);
@@ -369,6 +432,7 @@ LevelSetEvolution<TEquationContainer, ShiSparseLevelSetImage<VDimension>>::Updat
     updateLevelSet->SetInputLevelSet(levelSet);
     updateLevelSet->SetCurrentLevelSetId(it->GetIdentifier());
     updateLevelSet->SetEquationContainer(this->m_EquationContainer);
+    updateLevelSet->SetNumberOfWorkUnits(this->m_NumberOfWorkUnits);
     updateLevelSet->Update();
 
     levelSet->Graft(updateLevelSet->GetOutputLevelSet());
@@ -403,6 +467,7 @@ LevelSetEvolution<TEquationContainer, MalcolmSparseLevelSetImage<VDimension>>::U
     updateLevelSet->SetInputLevelSet(levelSet);
     updateLevelSet->SetCurrentLevelSetId(levelSetId);
     updateLevelSet->SetEquationContainer(this->m_EquationContainer);
+    updateLevelSet->SetNumberOfWorkUnits(this->m_NumberOfWorkUnits);
     updateLevelSet->Update();
 
     levelSet->Graft(updateLevelSet->GetOutputLevelSet());
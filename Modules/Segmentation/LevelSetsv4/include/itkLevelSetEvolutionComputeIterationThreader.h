@@ -192,6 +192,7 @@ public:
   using LevelSetOutputType = typename LevelSetEvolutionType::LevelSetOutputType;
   using LevelSetDataType = typename LevelSetEvolutionType::LevelSetDataType;
   using TermContainerType = typename LevelSetEvolutionType::TermContainerType;
+  using TermContributionType = typename TermContainerType::TermContributionType;
   using NodePairType = typename LevelSetEvolutionType::NodePairType;
 
 protected:
@@ -208,6 +209,8 @@ protected:
 
   using NodePairsPerThreadType = std::vector<std::vector<NodePairType>>;
   NodePairsPerThreadType m_NodePairsPerThread;
+
+  std::vector<TermContributionType> m_TermContributionsPerThread;
 };
 
 } // namespace itk
@@ -54,6 +54,7 @@ LevelSetEvolutionComputeIterationThreader<LevelSetDenseImage<TImage>,
     // Avoid repeated map lookups.
     const size_t                     numberOfLevelSets = idList->size();
     std::vector<LevelSetImageType *> levelSetUpdateImages(numberOfLevelSets);
+    std::vector<OffsetType>          levelSetUpdateOffsets(numberOfLevelSets);
     std::vector<TermContainerType *> termContainers(numberOfLevelSets);
     auto                             idListIt = idList->begin();
     unsigned int                     idListIdx = 0;
@@ -62,6 +63,7 @@ LevelSetEvolutionComputeIterationThreader<LevelSetDenseImage<TImage>,
       //! \todo Fix me for string identifiers
       LevelSetType * levelSetUpdate = this->m_Associate->m_UpdateBuffer->GetLevelSet(*idListIt - 1);
       levelSetUpdateImages[idListIdx] = levelSetUpdate->GetModifiableImage();
+      levelSetUpdateOffsets[idListIdx] = levelSetUpdate->GetDomainOffset();
       termContainers[idListIdx] = this->m_Associate->m_EquationContainer->GetEquation(*idListIt - 1);
       ++idListIt;
       ++idListIdx;
@@ -69,14 +71,13 @@ LevelSetEvolutionComputeIterationThreader<LevelSetDenseImage<TImage>,
 
     while (!imageIt.IsAtEnd())
     {
-      const IndexType levelSetIndex = imageIt.GetIndex();
       const IndexType inputIndex = imageIt.GetIndex() + offset;
       for (idListIdx = 0; idListIdx < numberOfLevelSets; ++idListIdx)
       {
         LevelSetDataType characteristics;
         termContainers[idListIdx]->ComputeRequiredData(inputIndex, characteristics);
         LevelSetOutputRealType temp_update = termContainers[idListIdx]->Evaluate(inputIndex, characteristics);
-        levelSetUpdateImages[idListIdx]->SetPixel(levelSetIndex, temp_update);
+        levelSetUpdateImages[idListIdx]->SetPixel(inputIndex - levelSetUpdateOffsets[idListIdx], temp_update);
       }
       ++imageIt;
     }
@@ -160,10 +161,12 @@ LevelSetEvolutionComputeIterationThreader<
 {
   const ThreadIdType numberOfThreads = this->GetNumberOfWorkUnitsUsed();
   this->m_NodePairsPerThread.resize(numberOfThreads);
+  this->m_TermContributionsPerThread.resize(numberOfThreads);
 
   for (ThreadIdType ii = 0; ii < numberOfThreads; ++ii)
   {
     this->m_NodePairsPerThread[ii].clear();
+    this->m_TermContributionsPerThread[ii].clear();
   }
 }
 
@@ -193,7 +196,8 @@ LevelSetEvolutionComputeIterationThreader<
 
     termContainer->ComputeRequiredData(inputIndex, characteristics);
 
-    const auto temp_update = static_cast<LevelSetOutputType>(termContainer->Evaluate(inputIndex, characteristics));
+    const auto temp_update = static_cast<LevelSetOutputType>(
+      termContainer->Evaluate(inputIndex, characteristics, this->m_TermContributionsPerThread[threadId]));
 
     this->m_NodePairsPerThread[threadId].push_back(NodePairType(levelsetIndex, temp_update));
 
@@ -213,13 +217,19 @@ LevelSetEvolutionComputeIterationThreader<
   typename LevelSetEvolutionType::LevelSetLayerType * levelSetLayerUpdateBuffer =
     this->m_Associate->m_UpdateBuffer[levelSetId];
 
+  typename TermContainerType::Pointer termContainer = this->m_Associate->m_EquationContainer->GetEquation(levelSetId);
+
+  // The work units process consecutive sub-ranges of the sorted zero layer,
+  // so appending their results in order only needs the end() insertion hint.
   const ThreadIdType numberOfThreads = this->GetNumberOfWorkUnitsUsed();
   for (ThreadIdType ii = 0; ii < numberOfThreads; ++ii)
   {
+    termContainer->MergeTermContribution(this->m_TermContributionsPerThread[ii]);
+
     typename std::vector<NodePairType>::const_iterator pairIt = this->m_NodePairsPerThread[ii].begin();
     while (pairIt != this->m_NodePairsPerThread[ii].end())
     {
-      levelSetLayerUpdateBuffer->insert(*pairIt);
+      levelSetLayerUpdateBuffer->insert(levelSetLayerUpdateBuffer->end(), *pairIt);
       ++pairIt;
     }
   }
@@ -27,6 +27,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkLabelMapToLabelImageFilter.h"
 #include "itkLabelImageToLabelMapFilter.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -83,6 +84,7 @@ public:
   using EquationContainerType = TEquationContainer;
   using EquationContainerPointer = typename EquationContainerType::Pointer;
   using TermContainerPointer = typename EquationContainerType::TermContainerPointer;
+  using TermContributionType = typename EquationContainerType::TermContainerType::TermContributionType;
 
   itkGetModifiableObjectMacro(OutputLevelSet, LevelSetType);
 
@@ -105,6 +107,11 @@ public:
   itkSetMacro(CurrentLevelSetId, IdentifierType);
   itkGetMacro(CurrentLevelSetId, IdentifierType);
 
+  /** Set/Get the number of work units evaluating in parallel the updates of
+   * the points of the 0 layer. The output does not depend on it. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
 protected:
   UpdateMalcolmSparseLevelSet();
   ~UpdateMalcolmSparseLevelSet() override = default;
@@ -117,6 +124,7 @@ protected:
   IdentifierType           m_CurrentLevelSetId;
   LevelSetOutputRealType   m_RMSChangeAccumulator;
   EquationContainerPointer m_EquationContainer;
+  ThreadIdType             m_NumberOfWorkUnits;
 
   using LabelImageType = Image<int8_t, ImageDimension>;
   using LabelImagePointer = typename LabelImageType::Pointer;
@@ -127,7 +135,7 @@ protected:
 
   bool m_IsUsingUnPhasedPropagation{ true };
 
-  /** Compute the updates for all points in the 0 layer and store in UpdateContainer */
+  /** Compute the updates for all points in the 0 layer, in parallel, and store in UpdateContainer */
   void
   FillUpdateContainer();
 
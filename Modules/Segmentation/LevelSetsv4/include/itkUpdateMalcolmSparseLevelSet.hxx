@@ -31,6 +31,7 @@ template <unsigned int VDimension, typename TEquationContainer>
 UpdateMalcolmSparseLevelSet<VDimension, TEquationContainer>::UpdateMalcolmSparseLevelSet()
   : m_CurrentLevelSetId(NumericTraits<IdentifierType>::ZeroValue())
   , m_RMSChangeAccumulator(NumericTraits<LevelSetOutputRealType>::ZeroValue())
+  , m_NumberOfWorkUnits(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
 
 {
   this->m_Offset.Fill(0);
@@ -92,13 +93,13 @@ UpdateMalcolmSparseLevelSet<VDimension, TEquationContainer>::Update()
 
       if (update > 0)
       {
-        listPos.insert(NodePairType(currentIdx, LevelSetType::ZeroLayer()));
-        updatePos.insert(NodePairType(currentIdx, LevelSetType::PlusOneLayer()));
+        listPos.insert(listPos.end(), NodePairType(currentIdx, LevelSetType::ZeroLayer()));
+        updatePos.insert(updatePos.end(), NodePairType(currentIdx, LevelSetType::PlusOneLayer()));
       }
       else
       {
-        listNeg.insert(NodePairType(currentIdx, LevelSetType::ZeroLayer()));
-        updateNeg.insert(NodePairType(currentIdx, LevelSetType::MinusOneLayer()));
+        listNeg.insert(listNeg.end(), NodePairType(currentIdx, LevelSetType::ZeroLayer()));
+        updateNeg.insert(updateNeg.end(), NodePairType(currentIdx, LevelSetType::MinusOneLayer()));
       }
       ++nodeIt;
       ++upIt;
@@ -127,35 +128,67 @@ template <unsigned int VDimension, typename TEquationContainer>
 void
 UpdateMalcolmSparseLevelSet<VDimension, TEquationContainer>::FillUpdateContainer()
 {
-  LevelSetLayerType levelZero = this->m_OutputLevelSet->GetLayer(LevelSetType::ZeroLayer());
+  const LevelSetLayerType & levelZero = this->m_OutputLevelSet->GetLayer(LevelSetType::ZeroLayer());
 
-  auto nodeIt = levelZero.begin();
-  auto nodeEnd = levelZero.end();
-
-  TermContainerPointer termContainer = this->m_EquationContainer->GetEquation(this->m_CurrentLevelSetId);
+  std::vector<LevelSetLayerConstIterator> nodes;
+  nodes.reserve(levelZero.size());
+  for (auto nodeIt = levelZero.begin(); nodeIt != levelZero.end(); ++nodeIt)
+  {
+    nodes.push_back(nodeIt);
+  }
 
-  LevelSetInputType inputIndex;
-  while (nodeIt != nodeEnd)
+  if (nodes.empty())
   {
-    const LevelSetInputType currentIndex = nodeIt->first;
-    inputIndex = currentIndex + this->m_Offset;
+    return;
+  }
 
-    const LevelSetOutputRealType update = termContainer->Evaluate(inputIndex);
+  TermContainerPointer termContainer = this->m_EquationContainer->GetEquation(this->m_CurrentLevelSetId);
 
-    LevelSetOutputType value = NumericTraits<LevelSetOutputType>::ZeroValue();
+  // The points are split in consecutive ranges, each one with its own
+  // contributions of the terms, and the updates are stored in the order of
+  // the layer, so that they do not depend on the number of work units.
+  const auto numberOfNodes = static_cast<SizeValueType>(nodes.size());
+  const auto numberOfRanges = std::min(numberOfNodes, static_cast<SizeValueType>(m_NumberOfWorkUnits));
+
+  std::vector<LevelSetOutputType>   values(nodes.size());
+  std::vector<TermContributionType> contributions(numberOfRanges);
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfRanges,
+    [&](SizeValueType range) {
+      const SizeValueType first = range * numberOfNodes / numberOfRanges;
+      const SizeValueType last = (range + 1) * numberOfNodes / numberOfRanges;
+      for (SizeValueType i = first; i < last; ++i)
+      {
+        const LevelSetInputType      inputIndex = nodes[i]->first + this->m_Offset;
+        const LevelSetOutputRealType update = termContainer->Evaluate(inputIndex, contributions[range]);
 
-    if (update > NumericTraits<LevelSetOutputRealType>::ZeroValue())
-    {
-      value = NumericTraits<LevelSetOutputType>::OneValue();
-    }
-    if (update < NumericTraits<LevelSetOutputRealType>::ZeroValue())
-    {
-      value = -NumericTraits<LevelSetOutputType>::OneValue();
-    }
+        LevelSetOutputType value = NumericTraits<LevelSetOutputType>::ZeroValue();
+
+        if (update > NumericTraits<LevelSetOutputRealType>::ZeroValue())
+        {
+          value = NumericTraits<LevelSetOutputType>::OneValue();
+        }
+        if (update < NumericTraits<LevelSetOutputRealType>::ZeroValue())
+        {
+          value = -NumericTraits<LevelSetOutputType>::OneValue();
+        }
+        values[i] = value;
+      }
+    },
+    nullptr);
 
-    this->m_Update.insert(NodePairType(currentIndex, value));
+  for (const TermContributionType & contribution : contributions)
+  {
+    termContainer->MergeTermContribution(contribution);
+  }
 
-    ++nodeIt;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    this->m_Update.insert(this->m_Update.end(), NodePairType(nodes[i]->first, values[i]));
   }
 }
 
@@ -27,6 +27,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkLabelMapToLabelImageFilter.h"
 #include "itkLabelImageToLabelMapFilter.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -83,6 +84,7 @@ public:
   using EquationContainerType = TEquationContainer;
   using EquationContainerPointer = typename EquationContainerType::Pointer;
   using TermContainerPointer = typename EquationContainerType::TermContainerPointer;
+  using TermContributionType = typename EquationContainerType::TermContainerType::TermContributionType;
 
   itkGetModifiableObjectMacro(OutputLevelSet, LevelSetType);
 
@@ -105,6 +107,11 @@ public:
   itkSetMacro(CurrentLevelSetId, IdentifierType);
   itkGetMacro(CurrentLevelSetId, IdentifierType);
 
+  /** Set/Get the number of work units checking in parallel which points move
+   * to the opposite layer. The output does not depend on it. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
 protected:
   UpdateShiSparseLevelSet();
   ~UpdateShiSparseLevelSet() override = default;
@@ -115,6 +122,7 @@ protected:
   IdentifierType           m_CurrentLevelSetId;
   LevelSetOutputRealType   m_RMSChangeAccumulator;
   EquationContainerPointer m_EquationContainer;
+  ThreadIdType             m_NumberOfWorkUnits;
 
   using LabelImageType = Image<int8_t, ImageDimension>;
   using LabelImagePointer = typename LabelImageType::Pointer;
@@ -134,11 +142,19 @@ protected:
   void
   UpdateLayerMinusOne();
 
+  /** Return, for each point of the +1 or -1 layer in order, if it moves to
+   * the opposite layer. The layers, the internal image and the terms are only
+   * modified once all the points are checked, so they are checked in
+   * parallel. */
+  std::vector<char>
+  ComputeMovingNodes(const LevelSetLayerType & iLayer);
+
   /** Return true if there is a pixel from the opposite layer (+1 or -1) moving in the same direction */
   bool
   Con(const LevelSetInputType &      idx,
       const LevelSetOutputType &     currentStatus,
-      const LevelSetOutputRealType & currentUpdate) const;
+      const LevelSetOutputRealType & currentUpdate,
+      TermContributionType &         ioContribution) const;
 
 private:
   // input
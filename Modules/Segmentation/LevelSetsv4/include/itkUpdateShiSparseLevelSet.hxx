@@ -29,6 +29,7 @@ template <unsigned int VDimension, typename TEquationContainer>
 UpdateShiSparseLevelSet<VDimension, TEquationContainer>::UpdateShiSparseLevelSet()
   : m_CurrentLevelSetId(NumericTraits<IdentifierType>::ZeroValue())
   , m_RMSChangeAccumulator(NumericTraits<LevelSetOutputRealType>::ZeroValue())
+  , m_NumberOfWorkUnits(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
 {
   this->m_Offset.Fill(0);
   this->m_OutputLevelSet = LevelSetType::New();
@@ -197,50 +198,41 @@ UpdateShiSparseLevelSet<VDimension, TEquationContainer>::UpdateLayerPlusOne()
   LevelSetLayerType insertListIn;
   LevelSetLayerType insertListOut;
 
+  const std::vector<char> moving = this->ComputeMovingNodes(listOut);
+
   auto nodeIt = listOut.begin();
   auto nodeEnd = listOut.end();
-
-  LevelSetInputType inputIndex;
+  auto movingIt = moving.begin();
 
   // for each point in Lz
   while (nodeIt != nodeEnd)
   {
-    bool                     erased = false;
-    const LevelSetInputType  currentIndex = nodeIt->first;
-    const LevelSetOutputType currentValue = nodeIt->second;
-    inputIndex = currentIndex + this->m_Offset;
-
-    // update the level set
-    LevelSetOutputRealType update = termContainer->Evaluate(inputIndex);
+    const LevelSetInputType currentIndex = nodeIt->first;
 
-    if (update < NumericTraits<LevelSetOutputRealType>::ZeroValue())
+    if (*movingIt++)
     {
-      if (Con(currentIndex, currentValue, update))
-      {
-        // CheckIn
-        insertListIn.insert(NodePairType(currentIndex, LevelSetType::MinusOneLayer()));
+      // CheckIn
+      insertListIn.insert(NodePairType(currentIndex, LevelSetType::MinusOneLayer()));
 
-        auto tempIt = nodeIt;
-        ++nodeIt;
-        listOut.erase(tempIt);
-        erased = true;
+      auto tempIt = nodeIt;
+      ++nodeIt;
+      listOut.erase(tempIt);
 
-        neighIt.SetLocation(currentIndex);
+      neighIt.SetLocation(currentIndex);
 
-        for (typename NeighborhoodIteratorType::Iterator i = neighIt.Begin(); !i.IsAtEnd(); ++i)
-        {
-          LevelSetOutputType tempValue = i.Get();
+      for (typename NeighborhoodIteratorType::Iterator i = neighIt.Begin(); !i.IsAtEnd(); ++i)
+      {
+        LevelSetOutputType tempValue = i.Get();
 
-          if (tempValue == LevelSetType::PlusThreeLayer())
-          {
-            LevelSetInputType tempIndex = neighIt.GetIndex(i.GetNeighborhoodOffset());
+        if (tempValue == LevelSetType::PlusThreeLayer())
+        {
+          LevelSetInputType tempIndex = neighIt.GetIndex(i.GetNeighborhoodOffset());
 
-            insertListOut.insert(NodePairType(tempIndex, LevelSetType::PlusOneLayer()));
-          }
+          insertListOut.insert(NodePairType(tempIndex, LevelSetType::PlusOneLayer()));
         }
       }
     }
-    if (!erased)
+    else
     {
       ++nodeIt;
     }
@@ -297,49 +289,41 @@ UpdateShiSparseLevelSet<VDimension, TEquationContainer>::UpdateLayerMinusOne()
   LevelSetLayerType insertListIn;
   LevelSetLayerType insertListOut;
 
+  const std::vector<char> moving = this->ComputeMovingNodes(listIn);
+
   auto nodeIt = listIn.begin();
   auto nodeEnd = listIn.end();
+  auto movingIt = moving.begin();
 
   // for each point in Lz
   while (nodeIt != nodeEnd)
   {
-    bool                     erased = false;
-    const LevelSetInputType  currentIndex = nodeIt->first;
-    const LevelSetOutputType currentValue = nodeIt->second;
-    const LevelSetInputType  inputIndex = currentIndex + this->m_Offset;
-
-    // update for the current level set
-    LevelSetOutputRealType update = termContainer->Evaluate(inputIndex);
+    const LevelSetInputType currentIndex = nodeIt->first;
 
-    if (update > NumericTraits<LevelSetOutputRealType>::ZeroValue())
+    if (*movingIt++)
     {
-      if (Con(currentIndex, currentValue, update))
-      {
-        // CheckOut
-        insertListOut.insert(NodePairType(currentIndex, LevelSetType::PlusOneLayer()));
+      // CheckOut
+      insertListOut.insert(NodePairType(currentIndex, LevelSetType::PlusOneLayer()));
 
-        auto tempIt = nodeIt;
-        ++nodeIt;
-        listIn.erase(tempIt);
+      auto tempIt = nodeIt;
+      ++nodeIt;
+      listIn.erase(tempIt);
 
-        erased = true;
+      neighIt.SetLocation(currentIndex);
 
-        neighIt.SetLocation(currentIndex);
+      for (typename NeighborhoodIteratorType::Iterator i = neighIt.Begin(); !i.IsAtEnd(); ++i)
+      {
+        LevelSetOutputType tempValue = i.Get();
 
-        for (typename NeighborhoodIteratorType::Iterator i = neighIt.Begin(); !i.IsAtEnd(); ++i)
+        if (tempValue == LevelSetType::MinusThreeLayer())
         {
-          LevelSetOutputType tempValue = i.Get();
-
-          if (tempValue == LevelSetType::MinusThreeLayer())
-          {
-            LevelSetInputType tempIndex = neighIt.GetIndex(i.GetNeighborhoodOffset());
+          LevelSetInputType tempIndex = neighIt.GetIndex(i.GetNeighborhoodOffset());
 
-            insertListIn.insert(NodePairType(tempIndex, LevelSetType::MinusOneLayer()));
-          }
+          insertListIn.insert(NodePairType(tempIndex, LevelSetType::MinusOneLayer()));
         }
       }
     }
-    if (!erased)
+    else
     {
       ++nodeIt;
     }
@@ -373,11 +357,74 @@ UpdateShiSparseLevelSet<VDimension, TEquationContainer>::UpdateLayerMinusOne()
 }
 
 
+template <unsigned int VDimension, typename TEquationContainer>
+std::vector<char>
+UpdateShiSparseLevelSet<VDimension, TEquationContainer>::ComputeMovingNodes(const LevelSetLayerType & iLayer)
+{
+  TermContainerPointer termContainer = this->m_EquationContainer->GetEquation(this->m_CurrentLevelSetId);
+
+  std::vector<LevelSetLayerConstIterator> nodes;
+  nodes.reserve(iLayer.size());
+  for (auto nodeIt = iLayer.begin(); nodeIt != iLayer.end(); ++nodeIt)
+  {
+    nodes.push_back(nodeIt);
+  }
+
+  std::vector<char> moving(nodes.size(), false);
+  if (nodes.empty())
+  {
+    return moving;
+  }
+
+  // The points are split in consecutive ranges, each one with its own
+  // contributions of the terms, so that the moves and the contributions do
+  // not depend on the number of work units.
+  const auto numberOfNodes = static_cast<SizeValueType>(nodes.size());
+  const auto numberOfRanges = std::min(numberOfNodes, static_cast<SizeValueType>(m_NumberOfWorkUnits));
+
+  std::vector<TermContributionType> contributions(numberOfRanges);
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfRanges,
+    [&](SizeValueType range) {
+      const SizeValueType first = range * numberOfNodes / numberOfRanges;
+      const SizeValueType last = (range + 1) * numberOfNodes / numberOfRanges;
+      for (SizeValueType i = first; i < last; ++i)
+      {
+        const LevelSetInputType  currentIndex = nodes[i]->first;
+        const LevelSetOutputType currentValue = nodes[i]->second;
+
+        // update the level set
+        const LevelSetOutputRealType update =
+          termContainer->Evaluate(currentIndex + this->m_Offset, contributions[range]);
+
+        // the points of the +1 layer move in, the ones of the -1 layer move out
+        const bool towardsOpposite = (currentValue == LevelSetType::PlusOneLayer())
+                                       ? (update < NumericTraits<LevelSetOutputRealType>::ZeroValue())
+                                       : (update > NumericTraits<LevelSetOutputRealType>::ZeroValue());
+
+        moving[i] = towardsOpposite && this->Con(currentIndex, currentValue, update, contributions[range]);
+      }
+    },
+    nullptr);
+
+  for (const TermContributionType & contribution : contributions)
+  {
+    termContainer->MergeTermContribution(contribution);
+  }
+
+  return moving;
+}
+
 template <unsigned int VDimension, typename TEquationContainer>
 bool
 UpdateShiSparseLevelSet<VDimension, TEquationContainer>::Con(const LevelSetInputType &      idx,
                                                              const LevelSetOutputType &     currentStatus,
-                                                             const LevelSetOutputRealType & currentUpdate) const
+                                                             const LevelSetOutputRealType & currentUpdate,
+                                                             TermContributionType &         ioContribution) const
 {
   TermContainerPointer termContainer = this->m_EquationContainer->GetEquation(this->m_CurrentLevelSetId);
 
@@ -403,7 +450,7 @@ UpdateShiSparseLevelSet<VDimension, TEquationContainer>::Con(const LevelSetInput
     {
       LevelSetInputType tempIdx = neighIt.GetIndex(i.GetNeighborhoodOffset());
 
-      LevelSetOutputRealType neighborUpdate = termContainer->Evaluate(tempIdx + this->m_Offset);
+      LevelSetOutputRealType neighborUpdate = termContainer->Evaluate(tempIdx + this->m_Offset, ioContribution);
 
       if (neighborUpdate * currentUpdate > NumericTraits<LevelSetOutputType>::ZeroValue())
       {
@@ -92,7 +92,7 @@ UpdateWhitakerSparseLevelSet<VDimension, TLevelSetValueType, TEquationContainer>
   // Here, we are adding all pairs of indices and levelset values to a map
   for (LevelSetLayerIdType status = LevelSetType::MinusOneLayer(); status < LevelSetType::PlusTwoLayer(); ++status)
   {
-    const LevelSetLayerType layer = this->m_InputLevelSet->GetLayer(status);
+    const LevelSetLayerType & layer = this->m_InputLevelSet->GetLayer(status);
 
     auto it = layer.begin();
     while (it != layer.end())
@@ -134,7 +134,7 @@ UpdateWhitakerSparseLevelSet<VDimension, TLevelSetValueType, TEquationContainer>
     ++it;
   }
 
-  LevelSetLayerType layerPlus2 = this->m_InputLevelSet->GetLayer(LevelSetType::PlusTwoLayer());
+  const LevelSetLayerType & layerPlus2 = this->m_InputLevelSet->GetLayer(LevelSetType::PlusTwoLayer());
 
   it = layerPlus2.begin();
   while (it != layerPlus2.end())
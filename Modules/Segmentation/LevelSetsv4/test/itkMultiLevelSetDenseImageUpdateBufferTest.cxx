@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationCurvatureTerm.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkLevelSetEvolution.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkAtanRegularizedHeavisideStepFunction.h"
+#include "itkLevelSetDomainMapImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Evolve two dense level sets, each of them listed in a sub-region of the
+// image only, with the update buffers restricted to these sub-regions and
+// with update buffers of the size of the image. The level set images have
+// the size of the image in both cases, and must be the same.
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using InputPixelType = unsigned short;
+using InputImageType = itk::Image<InputPixelType, Dimension>;
+
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+using LevelSetType = itk::LevelSetDenseImage<ImageType>;
+using LevelSetOutputRealType = LevelSetType::OutputRealType;
+
+using IdentifierType = itk::IdentifierType;
+using LevelSetContainerType = itk::LevelSetContainer<IdentifierType, LevelSetType>;
+
+using ChanAndVeseInternalTermType = itk::LevelSetEquationChanAndVeseInternalTerm<InputImageType, LevelSetContainerType>;
+using ChanAndVeseExternalTermType = itk::LevelSetEquationChanAndVeseExternalTerm<InputImageType, LevelSetContainerType>;
+using CurvatureTermType = itk::LevelSetEquationCurvatureTerm<InputImageType, LevelSetContainerType>;
+using TermContainerType = itk::LevelSetEquationTermContainer<InputImageType, LevelSetContainerType>;
+
+using EquationContainerType = itk::LevelSetEquationContainer<TermContainerType>;
+using LevelSetEvolutionType = itk::LevelSetEvolution<EquationContainerType, LevelSetType>;
+
+using HeavisideFunctionBaseType =
+  itk::AtanRegularizedHeavisideStepFunction<LevelSetOutputRealType, LevelSetOutputRealType>;
+
+using BinaryImageToLevelSetType = itk::BinaryImageToLevelSetImageAdaptor<InputImageType, LevelSetType>;
+
+using IdListType = std::list<IdentifierType>;
+using IdListImageType = itk::Image<IdListType, Dimension>;
+using CacheImageType = itk::Image<short, Dimension>;
+using DomainMapImageFilterType = itk::LevelSetDomainMapImageFilter<IdListImageType, CacheImageType>;
+
+/** The evolution with update buffers of the size of the level set images,
+ * whatever the domains where the level sets are listed. */
+class FullUpdateBufferEvolution : public LevelSetEvolutionType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FullUpdateBufferEvolution);
+
+  using Self = FullUpdateBufferEvolution;
+  using Superclass = LevelSetEvolutionType;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkTypeMacro(FullUpdateBufferEvolution, LevelSetEvolution);
+
+  itkNewMacro(Self);
+
+protected:
+  FullUpdateBufferEvolution() = default;
+  ~FullUpdateBufferEvolution() override = default;
+
+  void
+  AllocateUpdateBuffer() override
+  {
+    this->m_UpdateBuffer = LevelSetContainerType::New();
+    this->m_UpdateBuffer->CopyInformationAndAllocate(this->m_LevelSetContainer, true);
+  }
+};
+
+void
+FillRegion(InputImageType * image, const InputImageType::IndexType & index, itk::SizeValueType size)
+{
+  InputImageType::RegionType region(index, InputImageType::SizeType::Filled(size));
+  for (itk::ImageRegionIterator<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(100);
+  }
+}
+
+template <typename TEvolution>
+std::vector<ImageType::Pointer>
+Evolve(InputImageType * input, DomainMapImageFilterType * domainMapFilter)
+{
+  HeavisideFunctionBaseType::Pointer heaviside = HeavisideFunctionBaseType::New();
+  heaviside->SetEpsilon(1.0);
+
+  LevelSetContainerType::Pointer lscontainer = LevelSetContainerType::New();
+  lscontainer->SetHeaviside(heaviside);
+  lscontainer->SetDomainMapFilter(domainMapFilter);
+
+  EquationContainerType::Pointer equationContainer = EquationContainerType::New();
+  equationContainer->SetLevelSetContainer(lscontainer);
+
+  // each level set starts from a square in its own domain
+  const InputImageType::IndexType seeds[] = { { { 12, 14 } }, { { 44, 24 } } };
+  for (IdentifierType id = 0; id < 2; ++id)
+  {
+    InputImageType::Pointer binary = InputImageType::New();
+    binary->SetRegions(input->GetLargestPossibleRegion());
+    binary->Allocate();
+    binary->FillBuffer(0);
+    FillRegion(binary, seeds[id], 8);
+
+    BinaryImageToLevelSetType::Pointer adaptor = BinaryImageToLevelSetType::New();
+    adaptor->SetInputImage(binary);
+    adaptor->Initialize();
+    lscontainer->AddLevelSet(id, adaptor->GetModifiableLevelSet(), false);
+  }
+
+  for (IdentifierType id = 0; id < 2; ++id)
+  {
+    ChanAndVeseInternalTermType::Pointer internalTerm = ChanAndVeseInternalTermType::New();
+    internalTerm->SetInput(input);
+    internalTerm->SetCoefficient(1.0);
+
+    ChanAndVeseExternalTermType::Pointer externalTerm = ChanAndVeseExternalTermType::New();
+    externalTerm->SetInput(input);
+    externalTerm->SetCoefficient(1.0);
+
+    CurvatureTermType::Pointer curvatureTerm = CurvatureTermType::New();
+    curvatureTerm->SetInput(input);
+    curvatureTerm->SetCoefficient(0.5);
+
+    TermContainerType::Pointer termContainer = TermContainerType::New();
+    termContainer->SetInput(input);
+    termContainer->SetCurrentLevelSetId(id);
+    termContainer->SetLevelSetContainer(lscontainer);
+    termContainer->AddTerm(0, internalTerm);
+    termContainer->AddTerm(1, externalTerm);
+    termContainer->AddTerm(2, curvatureTerm);
+    equationContainer->AddEquation(id, termContainer);
+  }
+
+  using StoppingCriterionType = itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion<LevelSetContainerType>;
+  StoppingCriterionType::Pointer criterion = StoppingCriterionType::New();
+  criterion->SetNumberOfIterations(5);
+
+  typename TEvolution::Pointer evolution = TEvolution::New();
+  evolution->SetEquationContainer(equationContainer);
+  evolution->SetStoppingCriterion(criterion);
+  evolution->SetLevelSetContainer(lscontainer);
+  evolution->SetNumberOfWorkUnits(1);
+  evolution->Update();
+
+  std::vector<ImageType::Pointer> images;
+  for (IdentifierType id = 0; id < 2; ++id)
+  {
+    images.push_back(lscontainer->GetLevelSet(id)->GetModifiableImage());
+  }
+  return images;
+}
+} // namespace
+
+int
+itkMultiLevelSetDenseImageUpdateBufferTest(int, char *[])
+{
+  InputImageType::Pointer input = InputImageType::New();
+  input->SetRegions(InputImageType::SizeType{ { 64, 48 } });
+  input->Allocate();
+  input->FillBuffer(0);
+  FillRegion(input, InputImageType::IndexType{ { 8, 10 } }, 16);
+  FillRegion(input, InputImageType::IndexType{ { 40, 20 } }, 16);
+
+  // the first level set is listed left of x = 36, the second one right of
+  // x = 28, and both of them in between
+  IdListImageType::Pointer idImage = IdListImageType::New();
+  idImage->SetRegions(input->GetLargestPossibleRegion());
+  idImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<IdListImageType> it(idImage, idImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    IdListType listIds;
+    if (it.GetIndex()[0] < 36)
+    {
+      listIds.push_back(1);
+    }
+    if (it.GetIndex()[0] >= 28)
+    {
+      listIds.push_back(2);
+    }
+    it.Set(listIds);
+  }
+
+  DomainMapImageFilterType::Pointer domainMapFilter = DomainMapImageFilterType::New();
+  domainMapFilter->SetInput(idImage);
+  domainMapFilter->Update();
+
+  std::vector<ImageType::Pointer> restricted;
+  std::vector<ImageType::Pointer> full;
+  ITK_TRY_EXPECT_NO_EXCEPTION(restricted = Evolve<LevelSetEvolutionType>(input, domainMapFilter));
+  ITK_TRY_EXPECT_NO_EXCEPTION(full = Evolve<FullUpdateBufferEvolution>(input, domainMapFilter));
+
+  for (unsigned int id = 0; id < 2; ++id)
+  {
+    ITK_TEST_EXPECT_EQUAL(restricted[id]->GetBufferedRegion(), input->GetLargestPossibleRegion());
+
+    itk::ImageRegionConstIteratorWithIndex<ImageType> rIt(restricted[id], restricted[id]->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType>          fIt(full[id], full[id]->GetBufferedRegion());
+    for (; !rIt.IsAtEnd(); ++rIt, ++fIt)
+    {
+      if (rIt.Get() != fIt.Get())
+      {
+        std::cerr << "Level set " << id << " differs at " << rIt.GetIndex() << ": " << rIt.Get()
+                  << " != " << fIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkSinRegularizedHeavisideStepFunction.h"
+#include "itkLevelSetEvolution.h"
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+// Evolve the Whitaker, Shi and Malcolm sparse level sets with one and with
+// several work units. The updates of the points of the layers are evaluated
+// in parallel, and the level sets and the contributions of the terms must be
+// the same whatever the number of work units.
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using InputPixelType = unsigned short;
+using InputImageType = itk::Image<InputPixelType, Dimension>;
+
+template <typename TLevelSet>
+int
+CheckWorkUnits(InputImageType * input, const char * name, typename TLevelSet::LayerIdType layerId)
+{
+  using LevelSetType = TLevelSet;
+  using BinaryToSparseAdaptorType = itk::BinaryImageToLevelSetImageAdaptor<InputImageType, LevelSetType>;
+  using LevelSetContainerType = itk::LevelSetContainer<itk::IdentifierType, LevelSetType>;
+
+  using ChanAndVeseInternalTermType =
+    itk::LevelSetEquationChanAndVeseInternalTerm<InputImageType, LevelSetContainerType>;
+  using ChanAndVeseExternalTermType =
+    itk::LevelSetEquationChanAndVeseExternalTerm<InputImageType, LevelSetContainerType>;
+  using TermContainerType = itk::LevelSetEquationTermContainer<InputImageType, LevelSetContainerType>;
+  using EquationContainerType = itk::LevelSetEquationContainer<TermContainerType>;
+  using LevelSetEvolutionType = itk::LevelSetEvolution<EquationContainerType, LevelSetType>;
+
+  using LevelSetOutputRealType = typename LevelSetType::OutputRealType;
+  using HeavisideFunctionBaseType =
+    itk::SinRegularizedHeavisideStepFunction<LevelSetOutputRealType, LevelSetOutputRealType>;
+  using StoppingCriterionType = itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion<LevelSetContainerType>;
+
+  const auto evolve = [input](itk::ThreadIdType numberOfWorkUnits, LevelSetOutputRealType & cflContribution) {
+    typename InputImageType::Pointer binary = InputImageType::New();
+    binary->SetRegions(input->GetLargestPossibleRegion());
+    binary->Allocate();
+    binary->FillBuffer(0);
+
+    const typename InputImageType::RegionType region({ { 20, 25 } }, { { 40, 30 } });
+    for (itk::ImageRegionIterator<InputImageType> it(binary, region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(1);
+    }
+
+    typename BinaryToSparseAdaptorType::Pointer adaptor = BinaryToSparseAdaptorType::New();
+    adaptor->SetInputImage(binary);
+    adaptor->Initialize();
+    typename LevelSetType::Pointer levelSet = adaptor->GetModifiableLevelSet();
+
+    typename HeavisideFunctionBaseType::Pointer heaviside = HeavisideFunctionBaseType::New();
+    heaviside->SetEpsilon(2.0);
+
+    typename LevelSetContainerType::Pointer lscontainer = LevelSetContainerType::New();
+    lscontainer->SetHeaviside(heaviside);
+    lscontainer->AddLevelSet(0, levelSet, false);
+
+    typename ChanAndVeseInternalTermType::Pointer internalTerm = ChanAndVeseInternalTermType::New();
+    internalTerm->SetInput(input);
+    internalTerm->SetCoefficient(1.0);
+
+    typename ChanAndVeseExternalTermType::Pointer externalTerm = ChanAndVeseExternalTermType::New();
+    externalTerm->SetInput(input);
+    externalTerm->SetCoefficient(1.0);
+
+    typename TermContainerType::Pointer termContainer = TermContainerType::New();
+    termContainer->SetInput(input);
+    termContainer->SetCurrentLevelSetId(0);
+    termContainer->SetLevelSetContainer(lscontainer);
+    termContainer->AddTerm(0, internalTerm);
+    termContainer->AddTerm(1, externalTerm);
+
+    typename EquationContainerType::Pointer equationContainer = EquationContainerType::New();
+    equationContainer->SetLevelSetContainer(lscontainer);
+    equationContainer->AddEquation(0, termContainer);
+
+    typename StoppingCriterionType::Pointer criterion = StoppingCriterionType::New();
+    criterion->SetNumberOfIterations(10);
+
+    typename LevelSetEvolutionType::Pointer evolution = LevelSetEvolutionType::New();
+    evolution->SetEquationContainer(equationContainer);
+    evolution->SetStoppingCriterion(criterion);
+    evolution->SetLevelSetContainer(lscontainer);
+    evolution->SetNumberOfWorkUnits(numberOfWorkUnits);
+    evolution->Update();
+
+    cflContribution = termContainer->ComputeCFLContribution();
+    return levelSet;
+  };
+
+  LevelSetOutputRealType         serialContribution = 0.;
+  LevelSetOutputRealType         parallelContribution = 0.;
+  typename LevelSetType::Pointer serial;
+  typename LevelSetType::Pointer parallel;
+  ITK_TRY_EXPECT_NO_EXCEPTION(serial = evolve(1, serialContribution));
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallel = evolve(4, parallelContribution));
+
+  if (serialContribution != parallelContribution)
+  {
+    std::cerr << name << ": CFL contribution is " << parallelContribution << " instead of " << serialContribution
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (itk::ImageRegionConstIteratorWithIndex<InputImageType> it(input, input->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    if (serial->Evaluate(it.GetIndex()) != parallel->Evaluate(it.GetIndex()))
+    {
+      std::cerr << name << ": level set differs at " << it.GetIndex() << ": " << parallel->Evaluate(it.GetIndex())
+                << " instead of " << serial->Evaluate(it.GetIndex()) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (serial->GetLayer(layerId) != parallel->GetLayer(layerId))
+  {
+    std::cerr << name << ": layer " << static_cast<int>(layerId) << " differs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << name << ": " << serial->GetLayer(layerId).size() << " points in layer " << static_cast<int>(layerId)
+            << std::endl;
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkSingleLevelSetSparseWorkUnitsTest(int, char *[])
+{
+  // a bright square in noise, which the level sets grow towards
+  InputImageType::Pointer input = InputImageType::New();
+  input->SetRegions(InputImageType::SizeType{ { 96, 80 } });
+  input->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize(2021);
+
+  const InputImageType::RegionType square({ { 15, 10 } }, { { 60, 55 } });
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(input, input->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const InputPixelType value = square.IsInside(it.GetIndex()) ? 100 : 20;
+    it.Set(value + static_cast<InputPixelType>(generator->GetIntegerVariate(30)));
+  }
+
+  int testStatus = EXIT_SUCCESS;
+
+  using WhitakerType = itk::WhitakerSparseLevelSetImage<float, Dimension>;
+  using ShiType = itk::ShiSparseLevelSetImage<Dimension>;
+  using MalcolmType = itk::MalcolmSparseLevelSetImage<Dimension>;
+
+  if (CheckWorkUnits<WhitakerType>(input, "Whitaker", WhitakerType::ZeroLayer()) != EXIT_SUCCESS)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+  if (CheckWorkUnits<ShiType>(input, "Shi", ShiType::MinusOneLayer()) != EXIT_SUCCESS)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+  if (CheckWorkUnits<MalcolmType>(input, "Malcolm", MalcolmType::ZeroLayer()) != EXIT_SUCCESS)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
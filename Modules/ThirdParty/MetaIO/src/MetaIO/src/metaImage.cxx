@@ -368,6 +368,8 @@ MetaImage::PrintInfo() const
   std::cout << "ElementData = " << ((m_ElementData == nullptr) ? "NULL" : "Valid") << std::endl;
 
   std::cout << "ElementDataFileName = " << m_ElementDataFileName << std::endl;
+
+  std::cout << "CompressionNumberOfThreads = " << m_CompressionNumberOfThreads << std::endl;
 }
 
 void
@@ -453,6 +455,8 @@ MetaImage::Clear()
 
   m_ElementDataFileName = "";
 
+  m_CompressionNumberOfThreads = 1;
+
   MetaObject::Clear();
 
   strcpy(m_ObjectTypeName, "Image");
@@ -904,6 +908,18 @@ MetaImage::ElementDataFileName(const char * _elementDataFileName)
   m_ElementDataFileName = _elementDataFileName;
 }
 
+unsigned int
+MetaImage::CompressionNumberOfThreads() const
+{
+  return m_CompressionNumberOfThreads;
+}
+
+void
+MetaImage::CompressionNumberOfThreads(unsigned int _compressionNumberOfThreads)
+{
+  m_CompressionNumberOfThreads = (_compressionNumberOfThreads > 0) ? _compressionNumberOfThreads : 1;
+}
+
 void *
 MetaImage::ElementData()
 {
@@ -1590,14 +1606,16 @@ MetaImage::WriteStream(std::ofstream * _stream, bool _writeElements, const void
       compressedElementData = MET_PerformCompression((const unsigned char *)m_ElementData,
                                                      m_Quantity * elementNumberOfBytes,
                                                      &m_CompressedDataSize,
-                                                     m_CompressionLevel);
+                                                     m_CompressionLevel,
+                                                     m_CompressionNumberOfThreads);
     }
     else
     {
       compressedElementData = MET_PerformCompression((const unsigned char *)_constElementData,
                                                      m_Quantity * elementNumberOfBytes,
                                                      &m_CompressedDataSize,
-                                                     m_CompressionLevel);
+                                                     m_CompressionLevel,
+                                                     m_CompressionNumberOfThreads);
     }
   }
 
@@ -2479,7 +2497,8 @@ MetaImage::M_WriteElements(std::ofstream * _fstream, const void * _data, std::st
           compressedData = MET_PerformCompression(&(((const unsigned char *)_data)[(i - 1) * sliceNumberOfBytes]),
                                                   sliceNumberOfBytes,
                                                   &compressedDataSize,
-                                                  m_CompressionLevel);
+                                                  m_CompressionLevel,
+                                                  m_CompressionNumberOfThreads);
 
           // Write the compressed data
           MetaImage::M_WriteElementData(writeStreamTemp, compressedData, compressedDataSize);
@@ -262,6 +262,14 @@ public:
   void
   ElementDataFileName(const char * _elementDataFileName);
 
+  //    CompressionNumberOfThreads(...)
+  //       Number of threads deflating the blocks of large compressed
+  //       element data.  One, the default, deflates them serially.
+  unsigned int
+  CompressionNumberOfThreads(void) const;
+  void
+  CompressionNumberOfThreads(unsigned int _compressionNumberOfThreads);
+
   void *
   ElementData(void);
   double
@@ -372,6 +380,8 @@ protected:
 
   std::string m_ElementDataFileName;
 
+  unsigned int m_CompressionNumberOfThreads;
+
 
   void
   M_Destroy(void) override;
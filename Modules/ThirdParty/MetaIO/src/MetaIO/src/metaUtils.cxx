@@ -51,6 +51,8 @@ IsBlank(int c)
 #include <cstring>
 #include <limits>
 #include <string>
+#include <thread>
+#include <vector>
 
 #if defined(__BORLANDC__) && (__BORLANDC__ >= 0x0580)
 #  include <mem.h>
@@ -67,6 +69,129 @@ static char MET_SeperatorChar = '=';
 
 static const std::streamoff MET_MaxChunkSize = 1024 * 1024 * 1024;
 
+// Data larger than a block is deflated by several threads, one block at a
+// time. Each block is deflated independently and, except for the last one,
+// ends with a full flush, on a byte boundary. The blocks are then
+// concatenated into a single zlib stream, which any zlib reader can inflate.
+static const std::streamoff MET_CompressionBlockSize = 4 * 1024 * 1024;
+
+// Deflate a block as raw deflate data, without zlib header nor trailer
+static bool
+MET_DeflateBlock(const unsigned char *        source,
+                 std::streamoff               sourceSize,
+                 int                          compressionLevel,
+                 bool                         lastBlock,
+                 std::vector<unsigned char> & compressed)
+{
+  z_stream z;
+  z.zalloc = (alloc_func) nullptr;
+  z.zfree = (free_func) nullptr;
+  z.opaque = (voidpf) nullptr;
+
+  if (deflateInit2(&z, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+
+  // deflateBound does not account for the empty stored block of the flush
+  compressed.resize(deflateBound(&z, static_cast<uLong>(sourceSize)) + 16);
+  z.next_in = const_cast<unsigned char *>(source);
+  z.avail_in = static_cast<uInt>(sourceSize);
+
+  const int flush = lastBlock ? Z_FINISH : Z_FULL_FLUSH;
+  int       ret;
+  do
+  {
+    if (z.total_out == compressed.size())
+    {
+      compressed.resize(2 * compressed.size());
+    }
+    z.next_out = compressed.data() + z.total_out;
+    z.avail_out = static_cast<uInt>(compressed.size() - z.total_out);
+    ret = deflate(&z, flush);
+  } while (ret == Z_OK && (z.avail_out == 0 || (lastBlock && ret != Z_STREAM_END)));
+
+  compressed.resize(z.total_out);
+  deflateEnd(&z);
+  return lastBlock ? (ret == Z_STREAM_END) : (ret == Z_OK && z.avail_in == 0);
+}
+
+// Deflate the blocks of the data in parallel and assemble the zlib stream.
+// Returns nullptr if a block could not be deflated.
+static unsigned char *
+MET_PerformParallelCompression(const unsigned char * source,
+                               std::streamoff        sourceSize,
+                               std::streamoff *      compressedDataSize,
+                               int                   compressionLevel,
+                               unsigned int          numberOfThreads)
+{
+  const std::streamoff numberOfBlocks = (sourceSize + MET_CompressionBlockSize - 1) / MET_CompressionBlockSize;
+
+  std::vector<std::vector<unsigned char>> compressedBlocks(static_cast<size_t>(numberOfBlocks));
+  std::vector<uLong>                      blockChecksums(static_cast<size_t>(numberOfBlocks));
+  std::vector<char>                       blockDeflated(static_cast<size_t>(numberOfBlocks), 0);
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < numberOfThreads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      for (std::streamoff block = t; block < numberOfBlocks; block += numberOfThreads)
+      {
+        const std::streamoff start = block * MET_CompressionBlockSize;
+        const std::streamoff size = std::min(MET_CompressionBlockSize, sourceSize - start);
+        const auto           b = static_cast<size_t>(block);
+        blockChecksums[b] = adler32(adler32(0L, nullptr, 0), source + start, static_cast<uInt>(size));
+        blockDeflated[b] =
+          MET_DeflateBlock(source + start, size, compressionLevel, block == numberOfBlocks - 1, compressedBlocks[b]);
+      }
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+
+  std::streamoff totalSize = 2 + 4;
+  uLong          checksum = adler32(0L, nullptr, 0);
+  for (std::streamoff block = 0; block < numberOfBlocks; ++block)
+  {
+    const auto b = static_cast<size_t>(block);
+    if (!blockDeflated[b])
+    {
+      return nullptr;
+    }
+    const std::streamoff size = std::min(MET_CompressionBlockSize, sourceSize - block * MET_CompressionBlockSize);
+    checksum = adler32_combine(checksum, blockChecksums[b], static_cast<z_off_t>(size));
+    totalSize += static_cast<std::streamoff>(compressedBlocks[b].size());
+  }
+
+  auto * compressed_data = new unsigned char[static_cast<size_t>(totalSize)];
+
+  // zlib header: deflate with a 32K window, and the level hint
+  const int      level = (compressionLevel == Z_DEFAULT_COMPRESSION) ? 6 : compressionLevel;
+  const unsigned levelFlag = (level < 2) ? 0 : (level < 6) ? 1 : (level == 6) ? 2 : 3;
+  const unsigned header = (0x78u << 8) | (levelFlag << 6);
+  compressed_data[0] = static_cast<unsigned char>(header >> 8);
+  compressed_data[1] = static_cast<unsigned char>((header + 31 - header % 31) & 0xff);
+
+  std::streamoff pos = 2;
+  for (auto & compressedBlock : compressedBlocks)
+  {
+    memcpy(compressed_data + pos, compressedBlock.data(), compressedBlock.size());
+    pos += static_cast<std::streamoff>(compressedBlock.size());
+    std::vector<unsigned char>().swap(compressedBlock);
+  }
+
+  // zlib trailer: the Adler-32 checksum of the data, most significant byte first
+  compressed_data[pos] = static_cast<unsigned char>((checksum >> 24) & 0xff);
+  compressed_data[pos + 1] = static_cast<unsigned char>((checksum >> 16) & 0xff);
+  compressed_data[pos + 2] = static_cast<unsigned char>((checksum >> 8) & 0xff);
+  compressed_data[pos + 3] = static_cast<unsigned char>(checksum & 0xff);
+
+  *compressedDataSize = totalSize;
+  return compressed_data;
+}
+
 MET_FieldRecordType *
 MET_GetFieldRecord(const char * _fieldName, std::vector<MET_FieldRecordType *> * _fields)
 {
@@ -696,8 +821,23 @@ unsigned char *
 MET_PerformCompression(const unsigned char * source,
                        std::streamoff        sourceSize,
                        std::streamoff *      compressedDataSize,
-                       int                   compressionLevel)
+                       int                   compressionLevel,
+                       unsigned int          numberOfThreads)
 {
+  if (numberOfThreads > 1 && sourceSize > MET_CompressionBlockSize)
+  {
+    const std::streamoff numberOfBlocks = (sourceSize + MET_CompressionBlockSize - 1) / MET_CompressionBlockSize;
+    unsigned char *      compressed_data =
+      MET_PerformParallelCompression(source,
+                                     sourceSize,
+                                     compressedDataSize,
+                                     compressionLevel,
+                                     static_cast<unsigned int>(std::min<std::streamoff>(numberOfThreads, numberOfBlocks)));
+    if (compressed_data != nullptr)
+    {
+      return compressed_data;
+    }
+  }
 
   z_stream z;
   z.zalloc = (alloc_func) nullptr;
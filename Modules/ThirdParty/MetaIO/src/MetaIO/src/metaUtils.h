@@ -312,7 +312,8 @@ unsigned char *
 MET_PerformCompression(const unsigned char * source,
                        std::streamoff        sourceSize,
                        std::streamoff *      compressedDataSize,
-                       int                   compressionLevel);
+                       int                   compressionLevel,
+                       unsigned int          numberOfThreads = 1);
 
 METAIO_EXPORT
 bool